@@ -111,6 +111,10 @@ typedef enum fbe_job_service_control_code_e
     FBE_JOB_CONTROL_CODE_UPDATE_PROVISION_DRIVE_BLOCK_SIZE,
     FBE_JOB_CONTROL_CODE_DESTROY_EXTENT_POOL,
     FBE_JOB_CONTROL_CODE_DESTROY_EXTENT_POOL_LUN,
+    FBE_JOB_CONTROL_CODE_SET_PIPELINE_MODE,
+    FBE_JOB_CONTROL_CODE_GET_PIPELINE_INFO,
+    FBE_JOB_CONTROL_CODE_SET_SPARE_INDEX_VERIFY,
+    FBE_JOB_CONTROL_CODE_GET_SPARE_INDEX_INFO,
 
     /* !!!!!!!!!!!!!!!!! add new job type here !!!!!!!!!!!!!!!!!!!!!
      * When adding new recovery job, please remember to add set_default_value function
@@ -1200,6 +1204,65 @@ typedef struct fbe_job_service_destroy_ext_pool_lun_s
     fbe_u64_t                               job_number;
 }fbe_job_service_destroy_ext_pool_lun_t;
 
+/*!*******************************************************************
+ * @struct fbe_job_service_set_pipeline_mode_t
+ *********************************************************************
+ * @brief
+ *  It defines job service request for FBE_JOB_CONTROL_CODE_SET_PIPELINE_MODE
+ *  control code.
+ *********************************************************************/
+typedef struct fbe_job_service_set_pipeline_mode_s
+{
+    fbe_bool_t      b_enabled;  /*!< FBE_FALSE runs every job to completion before the next one */
+}fbe_job_service_set_pipeline_mode_t;
+
+/*!*******************************************************************
+ * @struct fbe_job_service_pipeline_info_t
+ *********************************************************************
+ * @brief
+ *  It defines job service request for FBE_JOB_CONTROL_CODE_GET_PIPELINE_INFO
+ *  control code.
+ *********************************************************************/
+typedef struct fbe_job_service_pipeline_info_s
+{
+    fbe_bool_t      b_enabled;
+    fbe_u32_t       max_in_flight;      /*!< number of commit slots */
+    fbe_u32_t       in_flight;          /*!< jobs committing right now */
+    fbe_u64_t       pipelined_jobs;     /*!< jobs whose commit overlapped the next job */
+    fbe_u64_t       serialized_jobs;    /*!< jobs run start to end on the job thread */
+    fbe_u64_t       conflict_waits;     /*!< times a job waited for a job on the same object */
+    fbe_u64_t       barrier_drains;     /*!< times the pipeline was drained for a job */
+}fbe_job_service_pipeline_info_t;
+
+/*!*******************************************************************
+ * @struct fbe_job_service_set_spare_index_verify_t
+ *********************************************************************
+ * @brief
+ *  It defines job service request for FBE_JOB_CONTROL_CODE_SET_SPARE_INDEX_VERIFY
+ *  control code.
+ *********************************************************************/
+typedef struct fbe_job_service_set_spare_index_verify_s
+{
+    fbe_bool_t      b_enabled;  /*!< FBE_TRUE checks the spare index against the pvds */
+}fbe_job_service_set_spare_index_verify_t;
+
+/*!*******************************************************************
+ * @struct fbe_job_service_spare_index_info_t
+ *********************************************************************
+ * @brief
+ *  It defines job service request for FBE_JOB_CONTROL_CODE_GET_SPARE_INDEX_INFO
+ *  control code.
+ *********************************************************************/
+typedef struct fbe_job_service_spare_index_info_s
+{
+    fbe_bool_t      b_verify;               /*!< spare index is checked against the pvds */
+    fbe_u32_t       hits;                   /*!< spare info taken from the index */
+    fbe_u32_t       misses;                 /*!< spare info fetched from the pvd */
+    fbe_u32_t       lookup_mismatches;      /*!< index hits that differ from the pvd */
+    fbe_u32_t       verified_selections;    /*!< selections repeated without the index */
+    fbe_u32_t       selection_mismatches;   /*!< selections that picked another spare without the index */
+}fbe_job_service_spare_index_info_t;
+
 #endif /* FBE_JOB_SERVICE_H */
 
 
@@ -107,7 +107,8 @@ typedef struct fbe_metadata_element_s{
     fbe_u64_t			stripe_lock_count;
     fbe_u64_t			local_collision_count;
     fbe_u64_t			peer_collision_count;
-    fbe_u64_t			cmi_message_count;
+    fbe_atomic_t		cmi_message_count;  /* Nonpaged messages sent to the peer. */
+    fbe_atomic_t		nonpaged_write_count;  /* Nonpaged changes made locally. */
 
     fbe_spinlock_t      stripe_lock_spinlock;    /*  Lock to protect the stripe lock queues + stats. */	
 
@@ -798,6 +798,13 @@ static __forceinline void fbe_raid_iots_set_host_start_offset(fbe_raid_iots_t *c
     return;
 }
 
+static __forceinline void fbe_raid_iots_clear_host_sg_fragments(fbe_raid_iots_t *const iots_p)
+{
+    iots_p->host_sg_fragments = 0;
+    iots_p->host_sg_fragments_sg_p = NULL;
+    return;
+}
+
 static __forceinline void fbe_raid_iots_set_extent(fbe_raid_iots_t *const iots_p,
                                                    void *extent_p,
                                                    void *extent_context_p)
@@ -316,6 +316,13 @@ fbe_status_t fbe_spare_lib_selection_get_drive_performance_tier_group(fbe_drive_
                                                                       fbe_performance_tier_number_t *performance_tier_group);
 
 
+/*************************** 
+ * fbe_spare_index.c
+ ***************************/
+void fbe_spare_lib_index_destroy(void);
+fbe_status_t fbe_spare_lib_index_set_verify(fbe_packet_t *packet_p);
+fbe_status_t fbe_spare_lib_index_get_info(fbe_packet_t *packet_p);
+
 /*!***************************************************************************
  * @typedef fbe_spare_selection_priority_bitmask_t
  *****************************************************************************
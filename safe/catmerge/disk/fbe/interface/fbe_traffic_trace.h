@@ -43,12 +43,27 @@ void fbe_traffic_trace_get_data_crc(fbe_sg_element_t *sg_p,
 fbe_u8_t fbe_traffic_trace_get_priority_from_cdb(fbe_payload_cdb_priority_t cdb_priority);
 fbe_u8_t fbe_traffic_trace_get_priority(fbe_packet_t *packet_p);
 
+/* KTRC flags of the classes that have an RBA trace filter. */
+extern fbe_u32_t fbe_traffic_trace_filter_flags;
+
+fbe_bool_t fbe_traffic_trace_filter_record(fbe_traffic_trace_rba_set_class_t trace_class,
+                                           fbe_u32_t target,
+                                           fbe_lba_t lba,
+                                           fbe_block_count_t blocks,
+                                           fbe_u16_t op_code,
+                                           fbe_u64_t info);
+#if defined(UMODE_ENV) || defined(SIMMODE_ENV)
+fbe_bool_t fbe_traffic_trace_is_enabled_sim(KTRC_tflag_T component_flag);
+#endif
+
 /*!****************************************************************************
  * fbe_traffic_trace_is_enabled()
  ******************************************************************************
  * @brief
  *  This is the function for checking if RBA is enabled.
  *  This is inlined for performance.
+ *  The classes that have a filter are always traced, the filter
+ *  decides which records are kept.
  *
  * @param component_flag - traffic flag.
  *
@@ -57,8 +72,11 @@ fbe_u8_t fbe_traffic_trace_get_priority(fbe_packet_t *packet_p);
  *****************************************************************************/
 static __forceinline fbe_bool_t fbe_traffic_trace_is_enabled (KTRC_tflag_T component_flag)
 {
+    if (fbe_traffic_trace_filter_flags & component_flag)
+    {
+        return FBE_TRUE;
+    }
 #if defined(UMODE_ENV) || defined(SIMMODE_ENV)
-    fbe_bool_t fbe_traffic_trace_is_enabled_sim(KTRC_tflag_T component_flag);
     return fbe_traffic_trace_is_enabled_sim(component_flag);
 #else
     return fbe_ktrace_is_rba_logging_enabled((fbe_u64_t)component_flag);
@@ -47,6 +47,7 @@ Commands:\n\
 -disable_pp_gp         -   Disable run queue group priority queuing\n\
 -set_rq_method {0 | 1 | 2} -   0 - same core, 1 - next core, 2 - round robin\n\
 -set_alert_time seconds -  sets the alert time in seconds\n\
+-set_rq_batch {0 | 1}   -  run queue batching: 0 - fixed, 1 - adaptive\n\
 -shutdown               -  Sends a shutdown command to the BVD to simulate a reboot.\n\
 \n"
 
@@ -43,6 +43,7 @@ rdgen [switches] <operation> <LUN # | *> <threads> [max I/O block size in hex]\n
                                       If memory size not provided, a default size is selected.\n\
                                       With this option rdgen tries to get memory from SP Cache.\n\
      -init_dps_cmm (size in mb)		- Initialize the DPS memory in RDGEN by using CMM.\n\
+     -latency [tag | *]      - Display read and write latency percentiles (p50, p90, p99, p99.9, max).\n\
      -reset_stats                   - Reset the rdgen statistics.  Also resets all per thread statistics.\n\
      -default_timeout_msec (milliseconds) - Set the default time to timeout and abort I/Os.\n\
      -h                      - display this help text\n\
@@ -111,6 +112,16 @@ Switches for starting I/O generation:\n\
                                repeatable lba/block count I/O loads.\n\
      -delay_msec (msec)      - Insert a fixed delay on each I/O of msec.\n\
      -random_delay (msec)    - Insert a random delay on each I/O up to msec.\n\
+     -open_loop (iops)       - Issue I/Os at a fixed rate of iops for the object, split across the threads,\n\
+                               whether or not earlier I/Os have completed.  Only for r and w.\n\
+                               Response times are measured from when each I/O was scheduled.\n\
+     -poisson (iops)         - Like -open_loop, but with random (poisson) arrivals averaging iops.\n\
+     -playback (file)        - Replay the I/O sequence in this file.\n\
+     -trace (blkparse | csv) (object id) (threads) - The -playback file is a blkparse or SNIA csv text\n\
+                               trace, replayed to this sep object with up to this many I/Os outstanding.\n\
+     -time_scale (percent)   - Replay a -trace at this percent of its recorded time.  50 is twice as fast.\n\
+     -scale_lba              - Scale the lbas of a -trace onto the object instead of wrapping them.\n\
+     -no_timing              - Ignore the times of a -trace and issue I/Os as fast as the threads allow.\n\
      -sp                     - Only available for writes.  Does a sequential write\n\
                                through all blocks on the LUN, writing all the blocks\n\
                                with the rdgen pattern. This only does one pass and exits.\n\
@@ -154,6 +165,11 @@ Examples:\n\
              rdgen -random_delay 5000 r 0 1 1\n\
   Insert a random delay of up to 500 milliseconds on each I/O. Single threaded read test of 1 block.\n\
              rdgen -delay_msec 500 r 0 1 1\n\
+  Open loop 8 block reads arriving at random at 2000 IOPS, with up to 32 outstanding, then show latency:\n\
+             rdgen -poisson 2000 -constant r 0 32 8\n\
+             rdgen -latency 0\n\
+  Replay a blkparse trace to object 0x10a with 8 threads at twice its recorded speed, spreading it over the object:\n\
+             rdgen -playback c:\\traces\\oltp.blk -trace blkparse 0x10a 8 -time_scale 50 -scale_lba\n\
   performance 1kb read test to device CLARiiONdisk0 using the IRP DCA interface:\n\
              rdgen -clar_lun 0 -affine 1 -constant -perf -align r 0 1 2\n\
   performance 1 kb read to the LUN exported by sep using the IRP SGL interface:\n\
@@ -97,6 +97,18 @@ static void fbe_cli_print_perf_stat(void)
 															bvd_perf_stats.core_stat[current_core].runq_stats.transport_run_queue_max_depth);
 	}
 
+	for (current_core = 0; current_core < core_count; current_core++) {
+		fbe_transport_run_queue_stats_t * runq_stats = &bvd_perf_stats.core_stat[current_core].runq_stats;
+
+		fbe_cli_printf("RunQ Core %d: batch %d watermark %d callback %d ns wait avg %lld us max %d us\n",  current_core,
+															runq_stats->transport_run_queue_batch_size,
+															runq_stats->transport_run_queue_batch_watermark,
+															runq_stats->transport_run_queue_callback_cost_ns,
+															(long long)((runq_stats->transport_run_queue_wait_count != 0) ? 
+																(runq_stats->transport_run_queue_wait_time_us / runq_stats->transport_run_queue_wait_count) : 0),
+															runq_stats->transport_run_queue_max_wait_us);
+	}
+
 	for (current_core = 0; current_core < core_count; current_core++) {
 		fbe_cli_printf("\nRunQ HIST Core %d: ",  current_core);
 
@@ -171,6 +183,16 @@ static void fbe_cli_set_alert_time(fbe_u32_t alert_time)
 	}
 }
 
+static void fbe_cli_set_run_queue_batch_mode(fbe_u32_t batch_mode)
+{
+	fbe_status_t status = fbe_api_bvd_interface_set_run_queue_batch_mode(batch_mode);
+	if (status != FBE_STATUS_OK) {
+		fbe_cli_error("%s: Failed \n", __FUNCTION__);
+	}else{
+		fbe_cli_printf("run queue batch mode set to %s\n", (batch_mode == FBE_TRANSPORT_RUN_QUEUE_BATCH_MODE_ADAPTIVE) ? "adaptive" : "fixed");
+	}
+}
+
 static void fbe_cli_enable_group_priority(void)
 {
 	fbe_status_t status = fbe_api_bvd_interface_enable_group_priority(FALSE);
@@ -322,6 +344,19 @@ void fbe_cli_bvd_commands(int argc, char** argv)
 		return;
 	}
 
+	if ((strcmp(*argv, "-set_rq_batch") == 0)){
+		fbe_u32_t batch_mode = 0;
+		argv++;
+		argc--;
+		if(argc > 0){
+			batch_mode = atoi(*argv);
+			fbe_cli_set_run_queue_batch_mode(batch_mode);
+			return;
+		}
+		fbe_cli_printf("%s", FBE_CLI_BVD_USAGE);
+		return;
+	}
+
     if ((strcmp(*argv, "-shutdown") == 0)) {
         fbe_cli_shutdown();
         return;
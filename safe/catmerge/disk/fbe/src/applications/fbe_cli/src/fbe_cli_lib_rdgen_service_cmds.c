@@ -56,6 +56,7 @@ static fbe_status_t fbe_cli_rdgen_display(fbe_u32_t argc, char** argv, fbe_rdgen
 static fbe_status_t fbe_cli_rdgen_stop(fbe_u32_t argc, char** argv, fbe_bool_t b_sync);
 static fbe_status_t fbe_cli_rdgen_start(fbe_u32_t argc, char** argv);
 static fbe_status_t fbe_cli_rdgen_cmi_perf_test(fbe_u32_t argc, char** argv, fbe_bool_t with_mask);
+static fbe_status_t fbe_cli_rdgen_display_latency(fbe_u32_t argc, char** argv);
 static fbe_status_t fbe_cli_rdgen_get_filter(fbe_u32_t argc, char** argv,
                                              fbe_rdgen_filter_t *filter_p,
                                              fbe_u32_t *args_processed_p);
@@ -239,6 +240,13 @@ void fbe_cli_cmd_rdgen_service(int argc , char ** argv)
             status = fbe_cli_rdgen_display(argc, argv, FBE_RDGEN_DISPLAY_MODE_SUMMARY);
             return;
         }		
+        else if (strcmp(*argv, "-latency") == 0)
+        {
+            argc--;
+            argv++;
+            status = fbe_cli_rdgen_display_latency(argc, argv);
+            return;
+        }
         else if (strcmp(*argv, "-dq") == 0)
         {
 			be_quiet = FBE_TRUE;
@@ -788,6 +796,91 @@ fbe_status_t fbe_cli_rdgen_display_object_stats(fbe_api_rdgen_object_info_t *obj
     }
     return FBE_STATUS_OK;
 }
+/*!**************************************************************
+ * fbe_cli_rdgen_display_latency_percentiles()
+ ****************************************************************
+ * @brief
+ *  Display one line of percentiles for a latency histogram.
+ *
+ * @param name_p - Name to display for the histogram.
+ * @param histogram_p - Histogram to display.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void fbe_cli_rdgen_display_latency_percentiles(const fbe_char_t *name_p,
+                                                      fbe_rdgen_latency_histogram_t *histogram_p)
+{
+    fbe_api_rdgen_latency_percentiles_t percentiles;
+
+    fbe_api_rdgen_latency_histogram_get_percentiles(histogram_p, &percentiles);
+    fbe_cli_printf("%-16s %12llu %10.3f %10.3f %10.3f %10.3f %10.3f\n",
+                   name_p, (unsigned long long)percentiles.count,
+                   fbe_time_us_to_ms(percentiles.p50_usec),
+                   fbe_time_us_to_ms(percentiles.p90_usec),
+                   fbe_time_us_to_ms(percentiles.p99_usec),
+                   fbe_time_us_to_ms(percentiles.p99_9_usec),
+                   fbe_time_us_to_ms(percentiles.max_usec));
+    return;
+}
+/*!**************************************************************
+ * fbe_cli_rdgen_display_latency()
+ ****************************************************************
+ * @brief
+ *  Display latency percentiles in milliseconds for reads and
+ *  writes of the active threads and of all finished threads.
+ *
+ * @param argc - argument count
+ * @param argv - optional tag, all threads by default.
+ *
+ * @return fbe_status_t
+ *
+ ****************************************************************/
+static fbe_status_t fbe_cli_rdgen_display_latency(fbe_u32_t argc, char** argv)
+{
+    fbe_status_t status;
+    fbe_rdgen_filter_t filter;
+    fbe_u32_t args_processed;
+    fbe_rdgen_control_get_latency_histogram_t *histogram_p = NULL;
+
+    fbe_zero_memory(&filter, sizeof(fbe_rdgen_filter_t));
+    filter.filter_type = FBE_RDGEN_FILTER_TYPE_INVALID;
+    if (argc > 0)
+    {
+        status = fbe_cli_rdgen_get_filter(argc, argv, &filter, &args_processed);
+        if (status != FBE_STATUS_OK)
+        {
+            fbe_cli_error("rdgen: unable to parse filter for -latency\n");
+            return status;
+        }
+    }
+
+    histogram_p = (fbe_rdgen_control_get_latency_histogram_t *)malloc(sizeof(fbe_rdgen_control_get_latency_histogram_t));
+    if (histogram_p == NULL)
+    {
+        fbe_cli_error("rdgen: unable to allocate memory for latency histogram\n");
+        return FBE_STATUS_INSUFFICIENT_RESOURCES;
+    }
+    status = fbe_api_rdgen_get_latency_histogram(histogram_p, &filter);
+    if (status != FBE_STATUS_OK)
+    {
+        fbe_cli_error("rdgen: status %d getting latency histogram\n", status);
+        free(histogram_p);
+        return status;
+    }
+    fbe_cli_printf("rdgen latency (msec) active threads: %d\n", histogram_p->threads);
+    fbe_cli_printf("%-16s %12s %10s %10s %10s %10s %10s\n",
+                   "", "count", "p50", "p90", "p99", "p99.9", "max");
+    fbe_cli_rdgen_display_latency_percentiles("active read", &histogram_p->in_process[FBE_RDGEN_LATENCY_TYPE_READ]);
+    fbe_cli_rdgen_display_latency_percentiles("active write", &histogram_p->in_process[FBE_RDGEN_LATENCY_TYPE_WRITE]);
+    fbe_cli_rdgen_display_latency_percentiles("historical read", &histogram_p->historical[FBE_RDGEN_LATENCY_TYPE_READ]);
+    fbe_cli_rdgen_display_latency_percentiles("historical write", &histogram_p->historical[FBE_RDGEN_LATENCY_TYPE_WRITE]);
+    free(histogram_p);
+    return FBE_STATUS_OK;
+}
+/******************************************
+ * end fbe_cli_rdgen_display_latency()
+ ******************************************/
 void fbe_cli_rdgen_display_cumulative_info(fbe_api_rdgen_get_stats_t *stats_p,
                                            fbe_api_rdgen_get_object_info_t *object_info_p,
                                            fbe_api_rdgen_get_request_info_t *request_info_p,
@@ -1694,6 +1787,12 @@ static fbe_status_t fbe_cli_rdgen_start(fbe_u32_t argc, char** argv)
     fbe_rdgen_options_t options = FBE_RDGEN_OPTIONS_INVALID;
     fbe_rdgen_extra_options_t extra_options = FBE_RDGEN_EXTRA_OPTIONS_INVALID;
     fbe_u32_t msec_delay = 0;
+    fbe_rdgen_arrival_mode_t arrival_mode = FBE_RDGEN_ARRIVAL_MODE_CLOSED_LOOP;
+    fbe_u32_t arrival_iops = 0;
+    fbe_rdgen_playback_format_t playback_format = FBE_RDGEN_PLAYBACK_FORMAT_RDGEN;
+    fbe_object_id_t trace_object_id = FBE_OBJECT_ID_INVALID;
+    fbe_u32_t trace_threads = 1;
+    fbe_u32_t time_scale_percent = 0;
     fbe_rdgen_data_pattern_flags_t data_pattern_flags = FBE_RDGEN_DATA_PATTERN_FLAGS_INVALID;
     fbe_rdgen_pattern_t pattern = FBE_RDGEN_PATTERN_LBA_PASS;
     fbe_u32_t args_processed = 0;
@@ -2060,6 +2159,34 @@ static fbe_status_t fbe_cli_rdgen_start(fbe_u32_t argc, char** argv)
                 return FBE_STATUS_ATTRIBUTE_NOT_FOUND;
             }
         }  
+        else if (!strcmp(*argv, "-open_loop") || !strcmp(*argv, "-poisson"))
+        {
+            /* Issue I/Os on a schedule at this rate instead of back to back.
+             */
+            arrival_mode = (!strcmp(*argv, "-poisson")) ? FBE_RDGEN_ARRIVAL_MODE_POISSON : FBE_RDGEN_ARRIVAL_MODE_FIXED_RATE;
+            argc--;
+            argv++;
+            if (argc)
+            {
+                arrival_iops = (fbe_u32_t)strtoul(*argv, 0, 0);
+
+                if (arrival_iops == 0)
+                {
+                    fbe_api_free_contiguous_memory(context_p);
+                    fbe_cli_error("unexpected argument found for -open_loop/-poisson argument. \n");
+                    fbe_cli_error("Enter a non-zero rate in I/Os per second, either decimal or 0x(hex number) \n");
+                    return FBE_STATUS_GENERIC_FAILURE;
+                }
+                argc--;
+                argv++;
+            }
+            else
+            {
+                fbe_api_free_contiguous_memory(context_p);
+                fbe_cli_error("%s no argument found for -open_loop/-poisson argument\n", __FUNCTION__);
+                return FBE_STATUS_ATTRIBUTE_NOT_FOUND;
+            }
+        }
         else if (!strcmp(*argv, "-fixed_random_seed"))
         {
             /* Generate fixed random numbers that can be repeated run to run.
@@ -2451,6 +2578,77 @@ static fbe_status_t fbe_cli_rdgen_start(fbe_u32_t argc, char** argv)
                 return FBE_STATUS_GENERIC_FAILURE;
             }
         }
+        else if (!strcmp(*argv, "-trace"))
+        {
+            /* -trace (blkparse | csv) (object id) (threads)
+             * The -playback file is a text trace to replay to this object.
+             */
+            if (argc < 4)
+            {
+                fbe_api_free_contiguous_memory(context_p);
+                fbe_cli_error("%s -trace needs a format, object id and thread count\n", __FUNCTION__);
+                return FBE_STATUS_GENERIC_FAILURE;
+            }
+            argc--;
+            argv++;
+            if (!strcmp(*argv, "blkparse"))
+            {
+                playback_format = FBE_RDGEN_PLAYBACK_FORMAT_BLKPARSE;
+            }
+            else if (!strcmp(*argv, "csv"))
+            {
+                playback_format = FBE_RDGEN_PLAYBACK_FORMAT_SNIA_CSV;
+            }
+            else
+            {
+                fbe_api_free_contiguous_memory(context_p);
+                fbe_cli_error("%s -trace format %s is not blkparse or csv\n", __FUNCTION__, *argv);
+                return FBE_STATUS_GENERIC_FAILURE;
+            }
+            argc--;
+            argv++;
+            trace_object_id = (fbe_object_id_t)strtoul(*argv, 0, 0);
+            argc--;
+            argv++;
+            trace_threads = (fbe_u32_t)strtoul(*argv, 0, 0);
+            if ((trace_object_id == 0) || (trace_threads == 0))
+            {
+                fbe_api_free_contiguous_memory(context_p);
+                fbe_cli_error("%s -trace object id and thread count must be non-zero\n", __FUNCTION__);
+                return FBE_STATUS_GENERIC_FAILURE;
+            }
+            argc--;
+            argv++;
+        }
+        else if (!strcmp(*argv, "-time_scale"))
+        {
+            argc--;
+            argv++;
+            if (argc)
+            {
+                time_scale_percent = (fbe_u32_t)strtoul(*argv, 0, 0);
+                argc--;
+                argv++;
+            }
+            else
+            {
+                fbe_api_free_contiguous_memory(context_p);
+                fbe_cli_error("%s no argument found for -time_scale argument\n", __FUNCTION__);
+                return FBE_STATUS_GENERIC_FAILURE;
+            }
+        }
+        else if (!strcmp(*argv, "-scale_lba"))
+        {
+            extra_options |= FBE_RDGEN_EXTRA_OPTIONS_PLAYBACK_SCALE_LBA;
+            argc--;
+            argv++;
+        }
+        else if (!strcmp(*argv, "-no_timing"))
+        {
+            extra_options |= FBE_RDGEN_EXTRA_OPTIONS_PLAYBACK_NO_TIMING;
+            argc--;
+            argv++;
+        }
         else if (!strcmp(*argv, "-options"))
         {
             argc--;
@@ -2483,6 +2681,14 @@ static fbe_status_t fbe_cli_rdgen_start(fbe_u32_t argc, char** argv)
         /* Always want to read from a file when there is a playback.
          */
         options |= FBE_RDGEN_OPTIONS_PERFORMANCE | FBE_RDGEN_OPTIONS_FILE;
+
+        /* A text trace says nothing about the target, so it runs to the object we were given.
+         */
+        if (playback_format != FBE_RDGEN_PLAYBACK_FORMAT_RDGEN)
+        {
+            filter.object_id = trace_object_id;
+            filter.package_id = FBE_PACKAGE_ID_SEP_0;
+        }
         /* Initialize and send out the context.
          */ 
         status = fbe_api_rdgen_test_context_init(&context_p->context, 
@@ -2494,7 +2700,7 @@ static fbe_status_t fbe_cli_rdgen_start(fbe_u32_t argc, char** argv)
                                                  pass_count,    //0, /* Pass count means run until stopped. */
                                                  num_ios,
                                                  num_msec,
-                                                 1,
+                                                 trace_threads,
                                                  FBE_RDGEN_LBA_SPEC_FIXED,
                                                  start_lba,
                                                  min_lba,
@@ -2516,6 +2722,17 @@ static fbe_status_t fbe_cli_rdgen_start(fbe_u32_t argc, char** argv)
             fbe_cli_error("%s unable to set the options flags.  status: 0x%x\n", __FUNCTION__, status);
             return status; 
         }
+        status = fbe_api_rdgen_io_specification_set_playback_trace(&context_p->context.start_io.specification,
+                                                                   playback_format, time_scale_percent);
+        if (status == FBE_STATUS_OK)
+        {
+            status = fbe_api_rdgen_io_specification_set_extra_options(&context_p->context.start_io.specification, extra_options);
+        }
+        if (status != FBE_STATUS_OK) { 
+            fbe_api_free_contiguous_memory(context_p);
+            fbe_cli_error("%s unable to set the playback trace options.  status: 0x%x\n", __FUNCTION__, status);
+            return status; 
+        }
         fbe_api_rdgen_set_context(&context_p->context, fbe_cli_rdgen_test_io_completion, context_p);
         if (!b_sync){
             fbe_cli_rdgen_info_enqueue(context_p);
@@ -2830,6 +3047,15 @@ static fbe_status_t fbe_cli_rdgen_start(fbe_u32_t argc, char** argv)
             return status; 
         }
     }
+    if (arrival_mode != FBE_RDGEN_ARRIVAL_MODE_CLOSED_LOOP) {
+        status = fbe_api_rdgen_io_specification_set_arrival_rate(&context_p->context.start_io.specification,
+                                                                 arrival_mode, arrival_iops);
+        if (status != FBE_STATUS_OK) { 
+            fbe_api_free_contiguous_memory(context_p);
+            fbe_cli_error("%s unable to set arrival rate.  status: 0x%x\n", __FUNCTION__, status);
+            return status; 
+        }
+    }
     if (extra_options != FBE_RDGEN_EXTRA_OPTIONS_INVALID) {
         status = fbe_api_rdgen_io_specification_set_extra_options(&context_p->context.start_io.specification, extra_options);
 
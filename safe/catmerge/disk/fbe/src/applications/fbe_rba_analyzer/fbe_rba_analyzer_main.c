@@ -0,0 +1,563 @@
+/***************************************************************************
+* Copyright (C) EMC Corporation 2014
+* All rights reserved.
+* Licensed material -- property of EMC Corporation
+***************************************************************************/
+
+/*!*************************************************************************
+*                 @file fbe_rba_analyzer_main.c
+****************************************************************************
+*
+* @brief
+*  This file contains the main function for fbe_rba_analyzer.
+*
+*  The dump command sets an RBA trace filter that saves binary records and
+*  copies the records to a file until the given time runs out.
+*
+*  The analyze command reads one or more dump files, for example one of
+*  the SEP and one of the physical package, and joins the LUN, RAID, VD,
+*  PVD and PD records into a latency breakdown of every I/O, see
+*  fbe_rba_analyzer_join.c.
+*
+* @ingroup fbe_rba_analyzer
+*
+***************************************************************************/
+
+/*************************
+*   INCLUDE FILES
+*************************/
+#include "fbe/fbe_types.h"
+#include "fbe/fbe_api_common.h"
+#include "fbe/fbe_package.h"
+#include "fbe/fbe_api_sim_transport.h"
+#include "fbe/fbe_api_sim_transport_packet_interface.h"
+#include "fbe/fbe_api_common_transport.h"
+#include "fbe/fbe_traffic_trace_interface.h"
+#include "fbe_trace.h"
+#include "fbe/fbe_winddk.h"
+#include "fbe/fbe_emcutil_shell_include.h"
+#include "ktrace_structs.h"
+#include "fbe_rba_analyzer_join.h"
+
+/*!************************
+*   LOCAL DEFINITIONS
+**************************/
+
+/*!*******************************************************************
+ * @def FBE_RBA_ANALYZER_FILE_MAGIC
+ *********************************************************************
+ * @brief First word of a dump file, followed by the record size.
+ *
+ *********************************************************************/
+#define FBE_RBA_ANALYZER_FILE_MAGIC     0x31414252 /* "RBA1" */
+
+/*!*******************************************************************
+ * @def FBE_RBA_ANALYZER_POLL_MSEC
+ *********************************************************************
+ * @brief Time between two reads of the records when the ring is empty.
+ *
+ *********************************************************************/
+#define FBE_RBA_ANALYZER_POLL_MSEC      100
+
+/*!************************
+*   LOCAL VARIABLES
+**************************/
+static fbe_bool_t   simulation_mode = FBE_FALSE;
+static fbe_bool_t   fbe_api_initialized = FBE_FALSE;
+static fbe_sim_transport_connection_target_t sp_to_connect = FBE_SIM_SP_A;
+static fbe_package_id_t filter_package = FBE_PACKAGE_ID_SEP_0;
+static fbe_traffic_trace_filter_t trace_filter;
+static const fbe_char_t *class_names[FBE_TRAFFIC_TRACE_CLASS_LAST] = {"", "LUN", "RG", "FRU", "VD", "PVD", "PD"};
+static const fbe_char_t *class_options[FBE_TRAFFIC_TRACE_CLASS_LAST] = {"", "lun", "rg", "fru", "vd", "pvd", "pd"};
+
+/*!************************
+*   LOCAL FUNCTIONS
+**************************/
+static fbe_status_t fbe_rba_analyzer_initialize_fbe_api(fbe_char_t driverType, fbe_char_t spId);
+static void fbe_rba_analyzer_destroy_fbe_api(void);
+static void CSX_GX_RT_DEFCC fbe_rba_analyzer_csx_cleanup_handler(csx_rt_proc_cleanup_context_t context);
+static int fbe_rba_analyzer_dump(int argc, char *argv[]);
+static int fbe_rba_analyzer_analyze(int argc, char *argv[]);
+static fbe_status_t fbe_rba_analyzer_parse_filter(int argc, char *argv[], fbe_traffic_trace_filter_t *filter_p);
+static fbe_traffic_trace_rba_set_class_t fbe_rba_analyzer_get_class(const fbe_char_t *name);
+static void printUsage(void);
+
+int __cdecl main (int argc , char *argv[])
+{
+#include "fbe/fbe_emcutil_shell_maincode.h"
+
+    if (argc < 2)
+    {
+        printUsage();
+        return 1;
+    }
+    if (strcmp(argv[1], "dump") == 0)
+    {
+        return fbe_rba_analyzer_dump(argc - 2, &argv[2]);
+    }
+    if (strcmp(argv[1], "analyze") == 0)
+    {
+        return fbe_rba_analyzer_analyze(argc - 2, &argv[2]);
+    }
+    printUsage();
+    return 1;
+}
+
+/*!**************************************************************
+ * fbe_rba_analyzer_dump()
+ ****************************************************************
+ * @brief
+ *  Set the filter and copy the binary records to a file.
+ *
+ * @param argc - Arguments after "dump".
+ * @param argv - <k|s> <a|b> <sep|pp> <file> <seconds> [filter options]
+ *
+ * @return 0 on success.
+ *
+ ****************************************************************/
+static int fbe_rba_analyzer_dump(int argc, char *argv[])
+{
+    fbe_status_t status;
+    fbe_traffic_trace_get_records_t *get_records_p = NULL;
+    FILE *fp = NULL;
+    fbe_u32_t header[2] = {FBE_RBA_ANALYZER_FILE_MAGIC, sizeof(fbe_traffic_trace_record_t)};
+    fbe_u32_t seconds;
+    fbe_u32_t elapsed_msec = 0;
+    fbe_u64_t total_records = 0;
+    fbe_u64_t lost_records = 0;
+    fbe_u32_t index;
+
+    if (argc < 5)
+    {
+        printUsage();
+        return 1;
+    }
+    if (strcmp(argv[2], "pp") == 0)
+    {
+        filter_package = FBE_PACKAGE_ID_PHYSICAL;
+    }
+    else if (strcmp(argv[2], "sep") != 0)
+    {
+        printUsage();
+        return 1;
+    }
+    seconds = (fbe_u32_t)strtoul(argv[4], NULL, 0);
+
+    fbe_zero_memory(&trace_filter, sizeof(trace_filter));
+    trace_filter.b_enabled = FBE_TRUE;
+    trace_filter.b_binary = FBE_TRUE;
+    trace_filter.target = FBE_U32_MAX;
+    trace_filter.end_lba = FBE_LBA_INVALID;
+    status = fbe_rba_analyzer_parse_filter(argc - 5, &argv[5], &trace_filter);
+    if (status != FBE_STATUS_OK)
+    {
+        printUsage();
+        return 1;
+    }
+
+    fp = fopen(argv[3], "wb");
+    if (fp == NULL)
+    {
+        printf("Can not open %s\n", argv[3]);
+        return 1;
+    }
+    fwrite(header, sizeof(header), 1, fp);
+
+    get_records_p = (fbe_traffic_trace_get_records_t *)malloc(sizeof(fbe_traffic_trace_get_records_t));
+    if (get_records_p == NULL)
+    {
+        fclose(fp);
+        return 1;
+    }
+
+    fbe_trace_init();
+    fbe_trace_set_default_trace_level(FBE_TRACE_LEVEL_CRITICAL_ERROR);
+    csx_rt_proc_cleanup_handler_register(fbe_rba_analyzer_csx_cleanup_handler, fbe_rba_analyzer_csx_cleanup_handler, NULL);
+
+    status = fbe_rba_analyzer_initialize_fbe_api(argv[0][0], argv[1][0]);
+    if (status != FBE_STATUS_OK)
+    {
+        printf("Failed to init FBE API\n");
+        free(get_records_p);
+        fclose(fp);
+        return 1;
+    }
+
+    status = fbe_api_traffic_trace_set_filter(&trace_filter, filter_package);
+    if (status != FBE_STATUS_OK)
+    {
+        printf("Failed to set the %s filter, status: 0x%x\n", class_names[trace_filter.trace_class], status);
+        fbe_rba_analyzer_destroy_fbe_api();
+        free(get_records_p);
+        fclose(fp);
+        return 1;
+    }
+    printf("Saving %s records to %s for %d seconds...\n", class_names[trace_filter.trace_class], argv[3], seconds);
+
+    /* Start after the records left by a previous dump.
+     */
+    get_records_p->next_sequence = FBE_U64_MAX;
+    while (elapsed_msec < seconds * 1000)
+    {
+        status = fbe_api_traffic_trace_get_records(get_records_p, filter_package);
+        if (status != FBE_STATUS_OK)
+        {
+            printf("Failed to get the records, status: 0x%x\n", status);
+            break;
+        }
+        /* The ring is shared by the filters of all the classes, so only
+         * keep the records of ours.
+         */
+        for (index = 0; index < get_records_p->num_records; index++)
+        {
+            if (get_records_p->records[index].trace_class == trace_filter.trace_class)
+            {
+                fwrite(&get_records_p->records[index], sizeof(fbe_traffic_trace_record_t), 1, fp);
+                total_records++;
+            }
+        }
+        lost_records += get_records_p->lost_records;
+
+        /* Keep reading while the service returns full buffers.
+         */
+        if (get_records_p->num_records < FBE_TRAFFIC_TRACE_GET_RECORDS_MAX)
+        {
+            EmcutilSleep(FBE_RBA_ANALYZER_POLL_MSEC);
+            elapsed_msec += FBE_RBA_ANALYZER_POLL_MSEC;
+        }
+    }
+
+    printf("Saved %llu records, %llu records lost\n",
+           (unsigned long long)total_records, (unsigned long long)lost_records);
+
+    csx_rt_proc_cleanup_handler_deregister(fbe_rba_analyzer_csx_cleanup_handler);
+    fbe_rba_analyzer_destroy_fbe_api();
+    free(get_records_p);
+    fclose(fp);
+    return 0;
+}
+
+/*!**************************************************************
+ * fbe_rba_analyzer_parse_filter()
+ ****************************************************************
+ * @brief
+ *  Parse the filter options of the dump command.
+ *
+ * @param argc - Number of options.
+ * @param argv - The options.
+ * @param filter_p - The filter to fill in.
+ *
+ * @return fbe_status_t
+ *
+ ****************************************************************/
+static fbe_status_t fbe_rba_analyzer_parse_filter(int argc, char *argv[], fbe_traffic_trace_filter_t *filter_p)
+{
+    int index;
+    fbe_char_t *op_p = NULL;
+
+    for (index = 0; index < argc; index++)
+    {
+        if ((strcmp(argv[index], "-class") == 0) && (index + 1 < argc))
+        {
+            filter_p->trace_class = fbe_rba_analyzer_get_class(argv[++index]);
+        }
+        else if ((strcmp(argv[index], "-target") == 0) && (index + 1 < argc))
+        {
+            filter_p->target = (fbe_u32_t)strtoul(argv[++index], NULL, 0);
+        }
+        else if ((strcmp(argv[index], "-lba") == 0) && (index + 2 < argc))
+        {
+            filter_p->start_lba = (fbe_lba_t)_strtoui64(argv[++index], NULL, 0);
+            filter_p->end_lba = (fbe_lba_t)_strtoui64(argv[++index], NULL, 0);
+        }
+        else if ((strcmp(argv[index], "-ops") == 0) && (index + 1 < argc))
+        {
+            for (op_p = argv[++index]; *op_p != '\0'; op_p++)
+            {
+                switch (*op_p)
+                {
+                    case 'r': filter_p->op_mask |= FBE_TRAFFIC_TRACE_FILTER_OP_READ; break;
+                    case 'w': filter_p->op_mask |= FBE_TRAFFIC_TRACE_FILTER_OP_WRITE; break;
+                    case 'z': filter_p->op_mask |= FBE_TRAFFIC_TRACE_FILTER_OP_ZERO; break;
+                    case 'o': filter_p->op_mask |= FBE_TRAFFIC_TRACE_FILTER_OP_OTHER; break;
+                    default: return FBE_STATUS_GENERIC_FAILURE;
+                }
+            }
+        }
+        else if ((strcmp(argv[index], "-latency") == 0) && (index + 1 < argc))
+        {
+            filter_p->latency_threshold_us = (fbe_u32_t)strtoul(argv[++index], NULL, 0);
+        }
+        else if ((strcmp(argv[index], "-sample") == 0) && (index + 1 < argc))
+        {
+            filter_p->sample_rate = (fbe_u32_t)strtoul(argv[++index], NULL, 0);
+        }
+        else
+        {
+            return FBE_STATUS_GENERIC_FAILURE;
+        }
+    }
+    if (filter_p->trace_class == FBE_TRAFFIC_TRACE_CLASS_INAVLID)
+    {
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+    return FBE_STATUS_OK;
+}
+
+/*!**************************************************************
+ * fbe_rba_analyzer_get_class()
+ ****************************************************************
+ * @brief
+ *  Convert a class name of the command line to a trace class.
+ *
+ * @param name - lun, rg, fru, vd, pvd or pd.
+ *
+ * @return The class, FBE_TRAFFIC_TRACE_CLASS_INAVLID if unknown.
+ *
+ ****************************************************************/
+static fbe_traffic_trace_rba_set_class_t fbe_rba_analyzer_get_class(const fbe_char_t *name)
+{
+    fbe_u32_t trace_class;
+
+    for (trace_class = FBE_TRAFFIC_TRACE_CLASS_LUN; trace_class < FBE_TRAFFIC_TRACE_CLASS_LAST; trace_class++)
+    {
+        if (strcmp(name, class_options[trace_class]) == 0)
+        {
+            return (fbe_traffic_trace_rba_set_class_t)trace_class;
+        }
+    }
+    return FBE_TRAFFIC_TRACE_CLASS_INAVLID;
+}
+
+/*!**************************************************************
+ * fbe_rba_analyzer_analyze()
+ ****************************************************************
+ * @brief
+ *  Read the dump files and print the latency of every I/O that
+ *  has no upper layer I/O, with the slowest I/O of each layer
+ *  below it, followed by the averages.
+ *
+ *  Only the completion records that have a latency are used.
+ *
+ * @param argc - Number of files.
+ * @param argv - The dump files.
+ *
+ * @return 0 on success.
+ *
+ ****************************************************************/
+static int fbe_rba_analyzer_analyze(int argc, char *argv[])
+{
+    fbe_rba_analyzer_io_t *ios_p = NULL;
+    fbe_rba_analyzer_io_t *io_p = NULL;
+    fbe_u32_t num_ios = 0;
+    fbe_u32_t max_ios = 0;
+    fbe_u32_t num_roots = 0;
+    fbe_u32_t header[2];
+    fbe_traffic_trace_record_t record;
+    fbe_u64_t layer_total_us[FBE_TRAFFIC_TRACE_CLASS_LAST] = {0};
+    fbe_u32_t layer_count[FBE_TRAFFIC_TRACE_CLASS_LAST] = {0};
+    fbe_u32_t index;
+    fbe_u32_t trace_class;
+    int file_index;
+    FILE *fp = NULL;
+
+    if (argc < 1)
+    {
+        printUsage();
+        return 1;
+    }
+
+    for (file_index = 0; file_index < argc; file_index++)
+    {
+        fp = fopen(argv[file_index], "rb");
+        if (fp == NULL)
+        {
+            printf("Can not open %s\n", argv[file_index]);
+            return 1;
+        }
+        if ((fread(header, sizeof(header), 1, fp) != 1) ||
+            (header[0] != FBE_RBA_ANALYZER_FILE_MAGIC) ||
+            (header[1] != sizeof(fbe_traffic_trace_record_t)))
+        {
+            printf("%s is not an rba dump\n", argv[file_index]);
+            fclose(fp);
+            return 1;
+        }
+        while (fread(&record, sizeof(record), 1, fp) == 1)
+        {
+            /* Starts and completions without a latency can not be placed.
+             */
+            if (((record.op_code & KT_DONE) == 0) ||
+                (record.latency_us == 0) ||
+                (record.trace_class >= FBE_TRAFFIC_TRACE_CLASS_LAST))
+            {
+                continue;
+            }
+            if (num_ios == max_ios)
+            {
+                max_ios = (max_ios == 0) ? 4096 : (max_ios * 2);
+                io_p = (fbe_rba_analyzer_io_t *)realloc(ios_p, sizeof(fbe_rba_analyzer_io_t) * max_ios);
+                if (io_p == NULL)
+                {
+                    printf("Out of memory after %d I/Os\n", num_ios);
+                    free(ios_p);
+                    fclose(fp);
+                    return 1;
+                }
+                ios_p = io_p;
+            }
+            fbe_rba_analyzer_io_init(&ios_p[num_ios++], &record);
+        }
+        fclose(fp);
+    }
+    if (num_ios == 0)
+    {
+        printf("No completed I/Os with a latency found\n");
+        return 0;
+    }
+
+    if (fbe_rba_analyzer_join(ios_p, num_ios) != FBE_STATUS_OK)
+    {
+        printf("Out of memory joining %d I/Os\n", num_ios);
+        free(ios_p);
+        return 1;
+    }
+
+    printf("%-4s %-8s %-16s %-8s %-10s", "type", "target", "lba", "blocks", "total_us");
+    for (trace_class = FBE_TRAFFIC_TRACE_CLASS_LUN; trace_class < FBE_TRAFFIC_TRACE_CLASS_LAST; trace_class++)
+    {
+        printf(" %8s_us", class_names[trace_class]);
+    }
+    printf("\n");
+    for (index = 0; index < num_ios; index++)
+    {
+        io_p = &ios_p[index];
+        if (io_p->parent != -1)
+        {
+            continue;
+        }
+        num_roots++;
+        printf("%-4s 0x%-6x 0x%-14llx 0x%-6x %-10d",
+               class_names[io_p->record.trace_class], io_p->record.target,
+               (unsigned long long)io_p->record.lba, io_p->record.blocks, io_p->record.latency_us);
+        for (trace_class = FBE_TRAFFIC_TRACE_CLASS_LUN; trace_class < FBE_TRAFFIC_TRACE_CLASS_LAST; trace_class++)
+        {
+            printf(" %11d", io_p->layer_us[trace_class]);
+            if (io_p->layer_us[trace_class] != 0)
+            {
+                layer_total_us[trace_class] += io_p->layer_us[trace_class];
+                layer_count[trace_class]++;
+            }
+        }
+        printf("\n");
+    }
+
+    printf("\n%d I/Os, %d without an upper layer I/O\n", num_ios, num_roots);
+    for (trace_class = FBE_TRAFFIC_TRACE_CLASS_LUN; trace_class < FBE_TRAFFIC_TRACE_CLASS_LAST; trace_class++)
+    {
+        if (layer_count[trace_class] != 0)
+        {
+            printf("  %-4s average of the slowest I/O: %llu us over %d I/Os\n",
+                   class_names[trace_class],
+                   (unsigned long long)(layer_total_us[trace_class] / layer_count[trace_class]),
+                   layer_count[trace_class]);
+        }
+    }
+    free(ios_p);
+    return 0;
+}
+
+static fbe_status_t fbe_rba_analyzer_initialize_fbe_api(fbe_char_t driverType, fbe_char_t spId)
+{
+    fbe_status_t status = FBE_STATUS_GENERIC_FAILURE;
+
+    /*'s' means simulation*/
+    if ((driverType == 's') || (driverType == 'S')) {
+
+        simulation_mode = FBE_TRUE;
+
+        /*initialize the simulation side of fbe api*/
+        fbe_api_common_init_sim();
+
+        fbe_api_set_simulation_io_and_control_entries (FBE_PACKAGE_ID_PHYSICAL,
+                                                       fbe_api_sim_transport_send_io_packet,
+                                                       fbe_api_sim_transport_send_client_control_packet);
+        fbe_api_set_simulation_io_and_control_entries (FBE_PACKAGE_ID_SEP_0,
+                                                       fbe_api_sim_transport_send_io_packet,
+                                                       fbe_api_sim_transport_send_client_control_packet);
+
+        /*need to initialize the client to connect to the server*/
+        sp_to_connect = ((spId == 'b') || (spId == 'B')) ? FBE_SIM_SP_B : FBE_SIM_SP_A;
+        fbe_api_sim_transport_reset_client(FBE_CLIENT_MODE_DEV_PC);
+        fbe_api_sim_transport_set_target_server(sp_to_connect);
+        status = fbe_api_sim_transport_init_client(sp_to_connect, FBE_TRUE);/*connect w/o any notifications enabled*/
+        if (status != FBE_STATUS_OK) {
+            printf("\nCan't connect to FBE Server, make sure FBE is running !!!\n");
+            return status;
+        }
+
+    }else if ((driverType == 'k') || (driverType == 'K')) {
+        status  = fbe_api_common_init_user(FBE_TRUE);
+        if (status != FBE_STATUS_OK) {
+            fbe_api_trace (FBE_TRACE_LEVEL_ERROR, "%s failed to init fbe api user\n", __FUNCTION__);
+        }
+    }
+    fbe_api_initialized = (status == FBE_STATUS_OK);
+    return status;
+}
+
+static void fbe_rba_analyzer_destroy_fbe_api(void)
+{
+    if (!fbe_api_initialized) {
+        return;
+    }
+    fbe_api_initialized = FBE_FALSE;
+
+    /* Do not leave the filter tracing after we are gone.
+     */
+    if (trace_filter.b_enabled) {
+        trace_filter.b_enabled = FBE_FALSE;
+        fbe_api_traffic_trace_set_filter(&trace_filter, filter_package);
+    }
+
+    if (simulation_mode) {
+        fbe_api_sim_transport_destroy_client(sp_to_connect);
+        fbe_api_common_destroy_sim();
+    }else{
+        fbe_api_common_destroy_user();
+    }
+    fflush(stdout);
+}
+
+static void CSX_GX_RT_DEFCC fbe_rba_analyzer_csx_cleanup_handler(csx_rt_proc_cleanup_context_t context)
+{
+    CSX_UNREFERENCED_PARAMETER(context);
+    if (CSX_IS_FALSE(csx_rt_assert_get_is_panic_in_progress())) {
+        fbe_rba_analyzer_destroy_fbe_api();
+    }
+}
+
+static void printUsage(void)
+{
+    printf("Usage: fbe_rba_analyzer dump <driver_type> <SP> <package> <file> <seconds> -class <class> [options]\n");
+    printf("       Where driver_type = k[kernel] | s[simulator]\n");
+    printf("             SP = a | b\n");
+    printf("             package = sep | pp (pp for the pd class)\n");
+    printf("             class = lun | rg | fru | vd | pvd | pd\n");
+    printf("       Options: -target <lun number | rg number | object id>\n");
+    printf("                -lba <start> <end>\n");
+    printf("                -ops <r|w|z|o...>\n");
+    printf("                -latency <min us of the completions>\n");
+    printf("                -sample <trace 1 of N I/Os>\n");
+    printf("Usage: fbe_rba_analyzer analyze <file> [<file>...]\n");
+    printf("Examples:\n");
+    printf("  'fbe_rba_analyzer dump s a sep lun.rba 30 -class lun -target 5 -latency 20000'\n");
+    printf("  'fbe_rba_analyzer dump s a pp pd.rba 30 -class pd -latency 20000'\n");
+    printf("  'fbe_rba_analyzer analyze lun.rba pd.rba'\n");
+    printf("  A dump sets the filter of one class, run one dump per class to join.\n");
+    return;
+}
+
+/*************************
+ * end file fbe_rba_analyzer_main.c
+ *************************/
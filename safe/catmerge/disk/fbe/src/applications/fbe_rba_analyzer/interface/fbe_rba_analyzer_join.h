@@ -0,0 +1,44 @@
+#ifndef __FBE_RBA_ANALYZER_JOIN_H__
+#define __FBE_RBA_ANALYZER_JOIN_H__
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2014
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!*************************************************************************
+ * @file fbe_rba_analyzer_join.h
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains the definitions used to join the binary RBA records
+ *  of the different layers into a latency breakdown of every I/O.
+ *
+ ***************************************************************************/
+#include "fbe/fbe_types.h"
+#include "fbe/fbe_winddk.h"
+#include "fbe/fbe_traffic_trace_interface.h"
+
+/*!*******************************************************************
+ * @struct fbe_rba_analyzer_io_t
+ *********************************************************************
+ * @brief One completed I/O of one layer.
+ *
+ *********************************************************************/
+typedef struct fbe_rba_analyzer_io_s
+{
+    fbe_traffic_trace_record_t record;
+    fbe_u64_t start_us;
+    fbe_u64_t end_us;
+    fbe_s32_t parent;       /*!< Index of the containing I/O, -1 for none. */
+    fbe_u32_t layer_us[FBE_TRAFFIC_TRACE_CLASS_LAST]; /*!< Slowest I/O of each layer below a root. */
+}
+fbe_rba_analyzer_io_t;
+
+void fbe_rba_analyzer_io_init(fbe_rba_analyzer_io_t *io_p, fbe_traffic_trace_record_t *record_p);
+fbe_status_t fbe_rba_analyzer_join(fbe_rba_analyzer_io_t *ios_p, fbe_u32_t num_ios);
+
+#endif /* __FBE_RBA_ANALYZER_JOIN_H__ */
+/**************************************************
+ * end file fbe_rba_analyzer_join.h
+ **************************************************/
@@ -0,0 +1,167 @@
+/***************************************************************************
+* Copyright (C) EMC Corporation 2014
+* All rights reserved.
+* Licensed material -- property of EMC Corporation
+***************************************************************************/
+
+/*!*************************************************************************
+*                 @file fbe_rba_analyzer_join.c
+****************************************************************************
+*
+* @brief
+*  This file joins the completed I/Os of the LUN, RAID, VD, PVD and PD
+*  records.  The records do not carry a common I/O tag, so the join is by
+*  time: each completed I/O is attached to the innermost I/O of an upper
+*  layer that was outstanding for its whole duration.
+*
+* @ingroup fbe_rba_analyzer
+*
+***************************************************************************/
+
+/*************************
+*   INCLUDE FILES
+*************************/
+#include "fbe_rba_analyzer_join.h"
+
+/*!************************
+*   LOCAL FUNCTIONS
+**************************/
+static int __cdecl fbe_rba_analyzer_compare_start(const void *left_p, const void *right_p);
+
+/*!**************************************************************
+ * fbe_rba_analyzer_io_init()
+ ****************************************************************
+ * @brief
+ *  Fill in an I/O from its completion record.
+ *
+ * @param io_p - The I/O.
+ * @param record_p - Completion record with a latency.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void fbe_rba_analyzer_io_init(fbe_rba_analyzer_io_t *io_p, fbe_traffic_trace_record_t *record_p)
+{
+    fbe_zero_memory(io_p, sizeof(*io_p));
+    io_p->record = *record_p;
+    io_p->end_us = record_p->time_us;
+    io_p->start_us = record_p->time_us - record_p->latency_us;
+    io_p->parent = -1;
+    return;
+}
+/******************************************
+ * end fbe_rba_analyzer_io_init()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_rba_analyzer_compare_start()
+ ****************************************************************
+ * @brief
+ *  Sort the I/Os by start time, and the longer I/O first when two
+ *  start together so that a parent comes before its children.
+ *
+ ****************************************************************/
+static int __cdecl fbe_rba_analyzer_compare_start(const void *left_p, const void *right_p)
+{
+    const fbe_rba_analyzer_io_t *left_io_p = (const fbe_rba_analyzer_io_t *)left_p;
+    const fbe_rba_analyzer_io_t *right_io_p = (const fbe_rba_analyzer_io_t *)right_p;
+
+    if (left_io_p->start_us != right_io_p->start_us)
+    {
+        return (left_io_p->start_us < right_io_p->start_us) ? -1 : 1;
+    }
+    if (left_io_p->end_us != right_io_p->end_us)
+    {
+        return (left_io_p->end_us > right_io_p->end_us) ? -1 : 1;
+    }
+    return (fbe_s32_t)left_io_p->record.trace_class - (fbe_s32_t)right_io_p->record.trace_class;
+}
+/******************************************
+ * end fbe_rba_analyzer_compare_start()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_rba_analyzer_join()
+ ****************************************************************
+ * @brief
+ *  Sort the I/Os by start time, find the parent of every I/O and
+ *  charge each I/O to its root.  After the join an I/O without a
+ *  parent has the slowest I/O of each layer below it in layer_us.
+ *
+ * @param ios_p - The I/Os, sorted in place.
+ * @param num_ios - Number of I/Os.
+ *
+ * @return fbe_status_t
+ *
+ ****************************************************************/
+fbe_status_t fbe_rba_analyzer_join(fbe_rba_analyzer_io_t *ios_p, fbe_u32_t num_ios)
+{
+    fbe_rba_analyzer_io_t *io_p = NULL;
+    fbe_rba_analyzer_io_t *parent_p = NULL;
+    fbe_s32_t *open_p = NULL;
+    fbe_u32_t num_open = 0;
+    fbe_u32_t index;
+    fbe_u32_t open_index;
+    fbe_u32_t trace_class;
+    fbe_s32_t parent;
+
+    if (num_ios == 0)
+    {
+        return FBE_STATUS_OK;
+    }
+
+    qsort(ios_p, num_ios, sizeof(fbe_rba_analyzer_io_t), fbe_rba_analyzer_compare_start);
+
+    /* Walk the I/Os in start order keeping the ones still outstanding.
+     * The parent of an I/O is the latest started outstanding I/O of an
+     * upper layer that completes after it.
+     */
+    open_p = (fbe_s32_t *)malloc(sizeof(fbe_s32_t) * num_ios);
+    if (open_p == NULL)
+    {
+        return FBE_STATUS_INSUFFICIENT_RESOURCES;
+    }
+    for (index = 0; index < num_ios; index++)
+    {
+        io_p = &ios_p[index];
+
+        open_index = 0;
+        while (open_index < num_open)
+        {
+            if (ios_p[open_p[open_index]].end_us < io_p->start_us)
+            {
+                open_p[open_index] = open_p[--num_open];
+                continue;
+            }
+            parent_p = &ios_p[open_p[open_index]];
+            if ((parent_p->record.trace_class < io_p->record.trace_class) &&
+                (parent_p->end_us >= io_p->end_us) &&
+                ((io_p->parent == -1) || (parent_p->start_us >= ios_p[io_p->parent].start_us)))
+            {
+                io_p->parent = open_p[open_index];
+            }
+            open_index++;
+        }
+        open_p[num_open++] = index;
+
+        /* Charge the I/O to its root.
+         */
+        parent = (fbe_s32_t)index;
+        while (ios_p[parent].parent != -1)
+        {
+            parent = ios_p[parent].parent;
+        }
+        parent_p = &ios_p[parent];
+        trace_class = io_p->record.trace_class;
+        parent_p->layer_us[trace_class] = FBE_MAX(parent_p->layer_us[trace_class], io_p->record.latency_us);
+    }
+    free(open_p);
+    return FBE_STATUS_OK;
+}
+/******************************************
+ * end fbe_rba_analyzer_join()
+ ******************************************/
+
+/*************************
+ * end file fbe_rba_analyzer_join.c
+ *************************/
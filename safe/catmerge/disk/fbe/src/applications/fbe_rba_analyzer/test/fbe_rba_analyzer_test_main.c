@@ -0,0 +1,205 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2014
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!*************************************************************************
+ * @file fbe_rba_analyzer_test_main.c
+ ***************************************************************************
+ *
+ * @brief
+ *  Unit tests of the join of the binary RBA records of fbe_rba_analyzer.
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "fbe/fbe_winddk.h"
+#include "fbe/fbe_types.h"
+#include "mut.h"
+#include "ktrace_structs.h"
+#include "fbe_rba_analyzer_join.h"
+#include "fbe/fbe_emcutil_shell_include.h"
+
+/*!**************************************************************
+ * rba_analyzer_test_add_io()
+ ****************************************************************
+ * @brief
+ *  Add the completion of one I/O.
+ *
+ * @param io_p - The I/O to fill in.
+ * @param trace_class - Layer of the I/O.
+ * @param start_us - Start time.
+ * @param end_us - Completion time.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void rba_analyzer_test_add_io(fbe_rba_analyzer_io_t *io_p,
+                                     fbe_traffic_trace_rba_set_class_t trace_class,
+                                     fbe_u64_t start_us,
+                                     fbe_u64_t end_us)
+{
+    fbe_traffic_trace_record_t record;
+
+    fbe_zero_memory(&record, sizeof(record));
+    record.trace_class = (fbe_u8_t)trace_class;
+    record.op_code = KT_READ | KT_DONE;
+    record.time_us = end_us;
+    record.latency_us = (fbe_u32_t)(end_us - start_us);
+    fbe_rba_analyzer_io_init(io_p, &record);
+    return;
+}
+
+/*!**************************************************************
+ * rba_analyzer_test_find()
+ ****************************************************************
+ * @brief
+ *  Find an I/O after the join sorted them.
+ *
+ * @return Index of the I/O, -1 if not found.
+ *
+ ****************************************************************/
+static fbe_s32_t rba_analyzer_test_find(fbe_rba_analyzer_io_t *ios_p,
+                                        fbe_u32_t num_ios,
+                                        fbe_traffic_trace_rba_set_class_t trace_class,
+                                        fbe_u64_t start_us)
+{
+    fbe_u32_t index;
+
+    for (index = 0; index < num_ios; index++)
+    {
+        if ((ios_p[index].record.trace_class == trace_class) &&
+            (ios_p[index].start_us == start_us))
+        {
+            return (fbe_s32_t)index;
+        }
+    }
+    return -1;
+}
+
+/*!**************************************************************
+ * rba_analyzer_test_join_nested()
+ ****************************************************************
+ * @brief
+ *  A LUN I/O containing a RAID I/O containing a PD I/O is one
+ *  root charged with the latency of each layer.
+ *
+ ****************************************************************/
+static void rba_analyzer_test_join_nested(void)
+{
+    fbe_rba_analyzer_io_t ios[3];
+    fbe_s32_t lun;
+    fbe_s32_t rg;
+    fbe_s32_t pd;
+
+    /* Add them out of order, the join sorts them.
+     */
+    rba_analyzer_test_add_io(&ios[0], FBE_TRAFFIC_TRACE_CLASS_PD, 20, 60);
+    rba_analyzer_test_add_io(&ios[1], FBE_TRAFFIC_TRACE_CLASS_LUN, 0, 100);
+    rba_analyzer_test_add_io(&ios[2], FBE_TRAFFIC_TRACE_CLASS_RG, 10, 90);
+
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, fbe_rba_analyzer_join(ios, 3));
+
+    lun = rba_analyzer_test_find(ios, 3, FBE_TRAFFIC_TRACE_CLASS_LUN, 0);
+    rg = rba_analyzer_test_find(ios, 3, FBE_TRAFFIC_TRACE_CLASS_RG, 10);
+    pd = rba_analyzer_test_find(ios, 3, FBE_TRAFFIC_TRACE_CLASS_PD, 20);
+    MUT_ASSERT_INT_NOT_EQUAL(-1, lun);
+    MUT_ASSERT_INT_NOT_EQUAL(-1, rg);
+    MUT_ASSERT_INT_NOT_EQUAL(-1, pd);
+
+    MUT_ASSERT_INT_EQUAL(-1, ios[lun].parent);
+    MUT_ASSERT_INT_EQUAL(lun, ios[rg].parent);
+    MUT_ASSERT_INT_EQUAL(rg, ios[pd].parent);
+
+    MUT_ASSERT_INT_EQUAL(100, ios[lun].layer_us[FBE_TRAFFIC_TRACE_CLASS_LUN]);
+    MUT_ASSERT_INT_EQUAL(80, ios[lun].layer_us[FBE_TRAFFIC_TRACE_CLASS_RG]);
+    MUT_ASSERT_INT_EQUAL(40, ios[lun].layer_us[FBE_TRAFFIC_TRACE_CLASS_PD]);
+    return;
+}
+
+/*!**************************************************************
+ * rba_analyzer_test_join_slowest()
+ ****************************************************************
+ * @brief
+ *  A root keeps the slowest I/O of a layer when it has several.
+ *
+ ****************************************************************/
+static void rba_analyzer_test_join_slowest(void)
+{
+    fbe_rba_analyzer_io_t ios[3];
+    fbe_s32_t lun;
+
+    rba_analyzer_test_add_io(&ios[0], FBE_TRAFFIC_TRACE_CLASS_LUN, 0, 100);
+    rba_analyzer_test_add_io(&ios[1], FBE_TRAFFIC_TRACE_CLASS_PD, 10, 30);
+    rba_analyzer_test_add_io(&ios[2], FBE_TRAFFIC_TRACE_CLASS_PD, 40, 95);
+
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, fbe_rba_analyzer_join(ios, 3));
+
+    lun = rba_analyzer_test_find(ios, 3, FBE_TRAFFIC_TRACE_CLASS_LUN, 0);
+    MUT_ASSERT_INT_NOT_EQUAL(-1, lun);
+    MUT_ASSERT_INT_EQUAL(55, ios[lun].layer_us[FBE_TRAFFIC_TRACE_CLASS_PD]);
+    return;
+}
+
+/*!**************************************************************
+ * rba_analyzer_test_join_not_contained()
+ ****************************************************************
+ * @brief
+ *  An I/O that completes after the upper layer I/O, or that is of
+ *  the same layer, is not attached to it.
+ *
+ ****************************************************************/
+static void rba_analyzer_test_join_not_contained(void)
+{
+    fbe_rba_analyzer_io_t ios[4];
+    fbe_s32_t lun;
+    fbe_s32_t pd;
+    fbe_s32_t other_lun;
+    fbe_s32_t late_pd;
+
+    rba_analyzer_test_add_io(&ios[0], FBE_TRAFFIC_TRACE_CLASS_LUN, 0, 100);
+    rba_analyzer_test_add_io(&ios[1], FBE_TRAFFIC_TRACE_CLASS_PD, 50, 150);
+    rba_analyzer_test_add_io(&ios[2], FBE_TRAFFIC_TRACE_CLASS_LUN, 10, 20);
+    rba_analyzer_test_add_io(&ios[3], FBE_TRAFFIC_TRACE_CLASS_PD, 200, 210);
+
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, fbe_rba_analyzer_join(ios, 4));
+
+    lun = rba_analyzer_test_find(ios, 4, FBE_TRAFFIC_TRACE_CLASS_LUN, 0);
+    other_lun = rba_analyzer_test_find(ios, 4, FBE_TRAFFIC_TRACE_CLASS_LUN, 10);
+    pd = rba_analyzer_test_find(ios, 4, FBE_TRAFFIC_TRACE_CLASS_PD, 50);
+    late_pd = rba_analyzer_test_find(ios, 4, FBE_TRAFFIC_TRACE_CLASS_PD, 200);
+
+    MUT_ASSERT_INT_EQUAL(-1, ios[lun].parent);
+    MUT_ASSERT_INT_EQUAL(-1, ios[other_lun].parent);
+    MUT_ASSERT_INT_EQUAL(-1, ios[pd].parent);
+    MUT_ASSERT_INT_EQUAL(-1, ios[late_pd].parent);
+    MUT_ASSERT_INT_EQUAL(0, ios[lun].layer_us[FBE_TRAFFIC_TRACE_CLASS_PD]);
+    MUT_ASSERT_INT_EQUAL(100, ios[pd].layer_us[FBE_TRAFFIC_TRACE_CLASS_PD]);
+    MUT_ASSERT_INT_EQUAL(10, ios[late_pd].layer_us[FBE_TRAFFIC_TRACE_CLASS_PD]);
+    return;
+}
+
+int __cdecl main (int argc , char ** argv)
+{
+    mut_testsuite_t *rbaAnalyzerSuite;
+
+#include "fbe/fbe_emcutil_shell_maincode.h"
+
+    mut_init(argc, argv);
+
+    rbaAnalyzerSuite = MUT_CREATE_TESTSUITE("rbaAnalyzerSuite")
+    MUT_ADD_TEST(rbaAnalyzerSuite, rba_analyzer_test_join_nested, NULL, NULL);
+    MUT_ADD_TEST(rbaAnalyzerSuite, rba_analyzer_test_join_slowest, NULL, NULL);
+    MUT_ADD_TEST(rbaAnalyzerSuite, rba_analyzer_test_join_not_contained, NULL, NULL);
+
+    MUT_RUN_TESTSUITE(rbaAnalyzerSuite);
+
+    exit(0);
+}
+
+/*************************
+ * end file fbe_rba_analyzer_test_main.c
+ *************************/
@@ -193,6 +193,11 @@ fbe_status_t hand_of_vecna_load_and_verify(void);
 extern char * hand_of_vecna_short_desc;
 extern char * hand_of_vecna_long_desc;
 
+void skellig_michael(void);
+fbe_status_t skellig_michael_load_and_verify(void);
+extern char * skellig_michael_short_desc;
+extern char * skellig_michael_long_desc;
+
 extern char * serengeti_short_desc;
 extern char * serengeti_long_desc;
 void serengeti_test_setup(void);
@@ -174,6 +174,12 @@ void squidward_setup(void);
 void squidward_test(void);
 void squidward_cleanup(void);
 
+extern char * sandy_cheeks_short_desc;
+extern char * sandy_cheeks_long_desc;
+void sandy_cheeks_setup(void);
+void sandy_cheeks_test(void);
+void sandy_cheeks_cleanup(void);
+
 extern char * super_hv_short_desc;
 extern char * super_hv_long_desc;
 void super_hv_setup(void);
@@ -231,6 +237,66 @@ void rick_test(void);
 void rick_setup(void);
 void rick_cleanup(void);
 
+extern char * count_von_count_short_desc;
+extern char * count_von_count_long_desc;
+void count_von_count_test(void);
+void count_von_count_setup(void);
+void count_von_count_cleanup(void);
+
+extern char * forgetful_jones_short_desc;
+extern char * forgetful_jones_long_desc;
+void forgetful_jones_test(void);
+void forgetful_jones_setup(void);
+void forgetful_jones_cleanup(void);
+
+extern char * two_headed_monster_short_desc;
+extern char * two_headed_monster_long_desc;
+void two_headed_monster_test(void);
+void two_headed_monster_setup(void);
+void two_headed_monster_cleanup(void);
+
+extern char * pinky_short_desc;
+extern char * pinky_long_desc;
+void pinky_test(void);
+void pinky_setup(void);
+void pinky_cleanup(void);
+
+extern char * brain_short_desc;
+extern char * brain_long_desc;
+void brain_test(void);
+void brain_setup(void);
+void brain_cleanup(void);
+
+extern char * hoots_the_owl_short_desc;
+extern char * hoots_the_owl_long_desc;
+void hoots_the_owl_test(void);
+void hoots_the_owl_setup(void);
+void hoots_the_owl_cleanup(void);
+
+extern char * roosevelt_franklin_short_desc;
+extern char * roosevelt_franklin_long_desc;
+void roosevelt_franklin_test(void);
+void roosevelt_franklin_setup(void);
+void roosevelt_franklin_cleanup(void);
+
+extern char * scrappy_doo_short_desc;
+extern char * scrappy_doo_long_desc;
+void scrappy_doo_test(void);
+void scrappy_doo_setup(void);
+void scrappy_doo_cleanup(void);
+
+extern char * mr_noodle_short_desc;
+extern char * mr_noodle_long_desc;
+void mr_noodle_dualsp_test(void);
+void mr_noodle_dualsp_setup(void);
+void mr_noodle_dualsp_cleanup(void);
+
+extern char * baby_natasha_short_desc;
+extern char * baby_natasha_long_desc;
+void baby_natasha_test(void);
+void baby_natasha_setup(void);
+void baby_natasha_cleanup(void);
+
 extern char * telly_short_desc;
 extern char * telly_long_desc;
 void telly_test(void);
@@ -1241,6 +1307,12 @@ void hiro_hamada_test(void);
 void hiro_hamada_setup(void);
 void hiro_hamada_cleanup(void);
 
+extern char * wile_e_coyote_short_desc;
+extern char * wile_e_coyote_long_desc;
+void wile_e_coyote_test(void);
+void wile_e_coyote_setup(void);
+void wile_e_coyote_cleanup(void);
+
 extern char * barnyard_dawg_short_desc;
 extern char * barnyard_dawg_long_desc;
 void barnyard_dawg_dualsp_test(void);
@@ -1494,6 +1566,12 @@ void ponyo_test(void);
 void ponyo_setup(void);
 void ponyo_destroy(void);
 
+extern char * candace_short_desc;
+extern char * candace_long_desc;
+void candace_test(void);
+void candace_setup(void);
+void candace_cleanup(void);
+
 extern char * kungfu_panda_short_desc;
 extern char * kungfu_panda_long_desc;
 void kungfu_panda_test(void);
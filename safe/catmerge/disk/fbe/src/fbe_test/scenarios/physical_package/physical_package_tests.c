@@ -109,6 +109,9 @@ mut_testsuite_t * fbe_test_create_physical_package_test_suite(mut_function_t sta
     MUT_ADD_TEST_WITH_DESCRIPTION(physical_package_test_suite, hand_of_vecna_test, hand_of_vecna_load_and_verify,  fbe_test_physical_package_tests_config_unload,
                                   hand_of_vecna_short_desc, hand_of_vecna_long_desc)
 
+    MUT_ADD_TEST_WITH_DESCRIPTION(physical_package_test_suite, skellig_michael, skellig_michael_load_and_verify, fbe_test_physical_package_tests_config_unload,
+                                  skellig_michael_short_desc, skellig_michael_long_desc)
+
     return physical_package_test_suite;
 }
 
@@ -0,0 +1,269 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2014
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!**************************************************************************
+ * @file skellig_michael.c
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains the incremental ESES status page processing test.
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "physical_package_tests.h"
+#include "fbe_test_configurations.h"
+#include "fbe/fbe_api_enclosure_interface.h"
+#include "fbe/fbe_api_discovery_interface.h"
+#include "fbe/fbe_api_utils.h"
+#include "fbe/fbe_api_common.h"
+#include "pp_utils.h"
+
+char * skellig_michael_short_desc = "Incremental ESES status page processing.";
+char * skellig_michael_long_desc =
+    "\n"
+    "\n"
+    "The Skellig Michael scenario measures the status page processing of the ESES enclosures\n"
+    "with the full decode of every page and with the incremental decode of the changed element groups.\n"
+    "\n"
+    "Starting Config:\n"
+    "    [PP] armada board\n"
+    "    [PP] SAS PMC port\n"
+    "    [PP] a full chain of viper enclosures\n"
+    "    [PP] SAS drives (PDO) in every enclosure\n"
+    "\n"
+    "STEP 1: Bring up the initial topology.\n"
+    "    - Create the initial physical package config.\n"
+    "    - Verify that all configured objects are in the READY state.\n"
+    "\n"
+    "STEP 2: Turn off the incremental status page processing of every enclosure.\n"
+    "    - Wait for the enclosures to poll the status page.\n"
+    "    - Report the processing time per status page.\n"
+    "\n"
+    "STEP 3: Turn on the incremental status page processing of every enclosure.\n"
+    "    - Wait for the enclosures to poll the status page.\n"
+    "    - Report the processing time per status page.\n"
+    "    - Verify that unchanged element groups were skipped.\n"
+    "\n"
+    "STEP 4: Shutdown the Terminator/Physical package.\n"
+    ;
+
+/*!*******************************************************************
+ * @def SKELLIG_MICHAEL_PAGES_TO_PROCESS
+ *********************************************************************
+ * @brief Number of status pages each enclosure processes per pass.
+ *
+ *********************************************************************/
+#define SKELLIG_MICHAEL_PAGES_TO_PROCESS        20
+
+/*!*******************************************************************
+ * @def SKELLIG_MICHAEL_POLL_WAIT_MS
+ *********************************************************************
+ * @brief Maximum time we wait for the enclosures to process the pages.
+ *
+ *********************************************************************/
+#define SKELLIG_MICHAEL_POLL_WAIT_MS            120000
+
+/*!*******************************************************************
+ * @var skellig_michael_test
+ *********************************************************************
+ * @brief Configuration loaded by the setup and used by the test.
+ *
+ *********************************************************************/
+static fbe_test_params_t skellig_michael_test;
+
+/*!**************************************************************
+ * skellig_michael_set_incremental()
+ ****************************************************************
+ * @brief
+ *  Turn the incremental status page processing of all the
+ *  enclosures on or off and clear their statistics.
+ *
+ * @param test - the configuration.
+ * @param b_incremental - FBE_TRUE to turn it on.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void skellig_michael_set_incremental(fbe_test_params_t *test,
+                                            fbe_bool_t b_incremental)
+{
+    fbe_status_t                            status;
+    fbe_u32_t                               encl;
+    fbe_object_id_t                         object_id;
+    fbe_enclosure_mgmt_status_page_stats_t  stats;
+
+    for (encl = 0; encl < test->max_enclosures; encl++)
+    {
+        status = fbe_api_get_enclosure_object_id_by_location(test->backend_number, encl, &object_id);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+        MUT_ASSERT_TRUE(object_id != FBE_OBJECT_ID_INVALID);
+
+        fbe_zero_memory(&stats, sizeof(stats));
+        stats.setIncremental = FBE_TRUE;
+        stats.incremental = b_incremental;
+        stats.clearStats = FBE_TRUE;
+        status = fbe_api_enclosure_status_page_stats(object_id, &stats);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+        MUT_ASSERT_INT_EQUAL(b_incremental, stats.incremental);
+    }
+    return;
+}
+/**************************************
+ * end skellig_michael_set_incremental()
+ **************************************/
+
+/*!**************************************************************
+ * skellig_michael_collect_stats()
+ ****************************************************************
+ * @brief
+ *  Wait for all the enclosures to process the number of status
+ *  pages we want and add up their statistics.
+ *
+ * @param test - the configuration.
+ * @param total_p - the sum of the enclosure statistics.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void skellig_michael_collect_stats(fbe_test_params_t *test,
+                                          fbe_enclosure_mgmt_status_page_stats_t *total_p)
+{
+    fbe_status_t                            status;
+    fbe_u32_t                               encl;
+    fbe_u32_t                               wait_ms = 0;
+    fbe_object_id_t                         object_id;
+    fbe_enclosure_mgmt_status_page_stats_t  stats;
+
+    fbe_zero_memory(total_p, sizeof(*total_p));
+    for (encl = 0; encl < test->max_enclosures; encl++)
+    {
+        status = fbe_api_get_enclosure_object_id_by_location(test->backend_number, encl, &object_id);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+        while (FBE_TRUE)
+        {
+            fbe_zero_memory(&stats, sizeof(stats));
+            status = fbe_api_enclosure_status_page_stats(object_id, &stats);
+            MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+            if (stats.pagesProcessed >= SKELLIG_MICHAEL_PAGES_TO_PROCESS)
+            {
+                break;
+            }
+            MUT_ASSERT_TRUE_MSG(wait_ms < SKELLIG_MICHAEL_POLL_WAIT_MS, "Timed out waiting for status pages");
+            fbe_api_sleep(500);
+            wait_ms += 500;
+        }
+
+        total_p->pagesProcessed += stats.pagesProcessed;
+        total_p->fullDecodes += stats.fullDecodes;
+        total_p->groupsDecoded += stats.groupsDecoded;
+        total_p->groupsSkipped += stats.groupsSkipped;
+        total_p->processTimeUs += stats.processTimeUs;
+    }
+
+    mut_printf(MUT_LOG_LOW, "%d enclosures, pages:%d full decodes:%d groups decoded:%llu skipped:%llu",
+               test->max_enclosures, total_p->pagesProcessed, total_p->fullDecodes,
+               (unsigned long long)total_p->groupsDecoded, (unsigned long long)total_p->groupsSkipped);
+    mut_printf(MUT_LOG_LOW, "status page processing time:%llu us, %llu us per page",
+               (unsigned long long)total_p->processTimeUs,
+               (unsigned long long)(total_p->processTimeUs / total_p->pagesProcessed));
+    return;
+}
+/**************************************
+ * end skellig_michael_collect_stats()
+ **************************************/
+
+/*!**************************************************************
+ * skellig_michael_run()
+ ****************************************************************
+ * @brief
+ *  Measure the status page processing with and without the
+ *  incremental decode.
+ *
+ * @param test - the configuration.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void skellig_michael_run(fbe_test_params_t *test)
+{
+    fbe_enclosure_mgmt_status_page_stats_t  full_stats;
+    fbe_enclosure_mgmt_status_page_stats_t  incremental_stats;
+
+    mut_printf(MUT_LOG_LOW, "=== Full status page decode ===");
+    skellig_michael_set_incremental(test, FBE_FALSE);
+    skellig_michael_collect_stats(test, &full_stats);
+    MUT_ASSERT_TRUE(full_stats.groupsSkipped == 0);
+    MUT_ASSERT_INT_EQUAL(full_stats.pagesProcessed, full_stats.fullDecodes);
+
+    mut_printf(MUT_LOG_LOW, "=== Incremental status page decode ===");
+    skellig_michael_set_incremental(test, FBE_TRUE);
+    skellig_michael_collect_stats(test, &incremental_stats);
+    MUT_ASSERT_TRUE(incremental_stats.groupsSkipped > 0);
+    MUT_ASSERT_TRUE(incremental_stats.fullDecodes > 0);
+    MUT_ASSERT_TRUE(incremental_stats.fullDecodes < incremental_stats.pagesProcessed);
+
+    return;
+}
+/**************************************
+ * end skellig_michael_run()
+ **************************************/
+
+/*!**************************************************************
+ * skellig_michael_load_and_verify()
+ ****************************************************************
+ * @brief
+ *  Load a full chain of enclosures and verify the topology.
+ *
+ * @param None.
+ *
+ * @return fbe_status_t
+ *
+ ****************************************************************/
+fbe_status_t skellig_michael_load_and_verify(void)
+{
+    fbe_status_t status;
+
+    /* Start from the naxos viper config and extend it to a full chain. */
+    skellig_michael_test = *fbe_test_get_naxos_test_table(0);
+    skellig_michael_test.title = "VIPER chain";
+    skellig_michael_test.max_enclosures = FBE_TEST_ENCLOSURES_PER_BUS;
+
+    status = naxos_load_and_verify_table_driven(&skellig_michael_test);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    return status;
+}
+/**************************************
+ * end skellig_michael_load_and_verify()
+ **************************************/
+
+/*!**************************************************************
+ * skellig_michael()
+ ****************************************************************
+ * @brief
+ *  Run the test on the chain loaded by
+ *  skellig_michael_load_and_verify().
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void skellig_michael(void)
+{
+    skellig_michael_run(&skellig_michael_test);
+    return;
+}
+/**************************************
+ * end skellig_michael()
+ **************************************/
+
+/*************************
+ * end file skellig_michael.c
+ *************************/
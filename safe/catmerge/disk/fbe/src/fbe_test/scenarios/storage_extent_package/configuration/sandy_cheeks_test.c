@@ -0,0 +1,452 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2009
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!**************************************************************************
+ * @file sandy_cheeks_test.c
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains a test of the job service pipeline.  It creates and
+ *  destroys many LUNs across several raid groups, once with every job run
+ *  to completion before the next one and once with the commit of independent
+ *  jobs overlapping the next job, and reports the wall time of both.
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "mut.h"
+#include "sep_tests.h"
+#include "sep_utils.h"
+#include "fbe/fbe_winddk.h"
+#include "fbe/fbe_api_common.h"
+#include "fbe/fbe_api_utils.h"
+#include "fbe/fbe_api_lun_interface.h"
+#include "fbe/fbe_api_database_interface.h"
+#include "fbe/fbe_api_job_service_interface.h"
+#include "fbe/fbe_api_common_job_notification.h"
+#include "fbe/fbe_api_sim_server.h"
+#include "fbe/fbe_random.h"
+#include "fbe_test_package_config.h"
+#include "fbe_test_configurations.h"
+#include "fbe_test_common_utils.h"
+#include "pp_utils.h"
+
+/*************************
+ *   FUNCTION DEFINITIONS
+ *************************/
+
+char * sandy_cheeks_short_desc = "job service pipelined LUN create/destroy";
+char * sandy_cheeks_long_desc ="\
+The Sandy Cheeks scenario measures the job service pipeline with many LUN jobs.\n\
+\n\
+STEP 1: configure three raid 5 raid groups.\n\
+\n\
+STEP 2: with the job service pipeline disabled and then enabled\n\
+        - queue LUN create jobs round robin over the raid groups, each job waits for its LUN to be ready.\n\
+        - wait for every job and validate every LUN is ready.\n\
+        - queue LUN destroy jobs for all of them and wait for every job.\n\
+        - report the wall time of the creates and the destroys.\n\
+\n\
+STEP 3: make sure the pipelined run overlapped jobs and restore the pipeline.\n\
+\n"
+"Description last updated: 10/19/2026.\n";
+
+/*!*******************************************************************
+ * @def SANDY_CHEEKS_LUNS_PER_RAID_GROUP
+ *********************************************************************
+ * @brief Number of LUNs the test infrastructure creates in each raid group.
+ *
+ *********************************************************************/
+#define SANDY_CHEEKS_LUNS_PER_RAID_GROUP 1
+
+/*!*******************************************************************
+ * @def SANDY_CHEEKS_CHUNKS_PER_LUN
+ *********************************************************************
+ * @brief Number of chunks each LUN will occupy.
+ *
+ *********************************************************************/
+#define SANDY_CHEEKS_CHUNKS_PER_LUN 2
+
+/*!*******************************************************************
+ * @def SANDY_CHEEKS_JOB_LUNS_PER_RAID_GROUP
+ *********************************************************************
+ * @brief Number of LUNs the jobs create in each raid group.
+ *
+ *********************************************************************/
+#define SANDY_CHEEKS_JOB_LUNS_PER_RAID_GROUP 8
+
+/*!*******************************************************************
+ * @def SANDY_CHEEKS_RAID_GROUP_COUNT
+ *********************************************************************
+ * @brief Number of raid groups the LUNs are spread over.
+ *
+ *********************************************************************/
+#define SANDY_CHEEKS_RAID_GROUP_COUNT 3
+
+#define SANDY_CHEEKS_MAX_LUNS (SANDY_CHEEKS_RAID_GROUP_COUNT * SANDY_CHEEKS_JOB_LUNS_PER_RAID_GROUP)
+
+/*!*******************************************************************
+ * @def SANDY_CHEEKS_LUN_CAPACITY
+ *********************************************************************
+ * @brief Capacity of the LUNs the jobs create.
+ *
+ *********************************************************************/
+#define SANDY_CHEEKS_LUN_CAPACITY 0x1000
+
+/*!*******************************************************************
+ * @def SANDY_CHEEKS_FIRST_LUN_NUMBER
+ *********************************************************************
+ * @brief LUN numbers of the jobs start here, clear of the infrastructure
+ *        LUNs.
+ *
+ *********************************************************************/
+#define SANDY_CHEEKS_FIRST_LUN_NUMBER 200
+
+#define SANDY_CHEEKS_JOB_TIMEOUT_MS 120000
+
+/*!*******************************************************************
+ * @var sandy_cheeks_raid_group_config
+ *********************************************************************
+ * @brief Raid groups we create the LUNs in.
+ *
+ *********************************************************************/
+static fbe_test_rg_configuration_t sandy_cheeks_raid_group_config[SANDY_CHEEKS_RAID_GROUP_COUNT + 1] =
+{
+    /* width,   capacity    raid type,                  class,                  block size      RAID-id.    bandwidth.*/
+    {3,       0x20000,    FBE_RAID_GROUP_TYPE_RAID5,  FBE_CLASS_ID_PARITY,      520,            0,          0},
+    {3,       0x20000,    FBE_RAID_GROUP_TYPE_RAID5,  FBE_CLASS_ID_PARITY,      520,            1,          0},
+    {3,       0x20000,    FBE_RAID_GROUP_TYPE_RAID5,  FBE_CLASS_ID_PARITY,      520,            2,          0},
+    {FBE_U32_MAX, FBE_U32_MAX, FBE_U32_MAX, /* Terminator. */},
+};
+
+/*!**************************************************************
+ * sandy_cheeks_create_luns()
+ ****************************************************************
+ * @brief
+ *  Queue all the LUN create jobs and then wait for all of them.
+ *
+ * @param rg_config_p - raid groups to create the LUNs in
+ * @param lun_object_ids - object ids of the new LUNs
+ *
+ * @return fbe_u32_t - milliseconds from the first job to the last
+ *                     completion.
+ *
+ ****************************************************************/
+static fbe_u32_t sandy_cheeks_create_luns(fbe_test_rg_configuration_t *rg_config_p,
+                                          fbe_object_id_t *lun_object_ids)
+{
+    fbe_status_t                        status;
+    fbe_status_t                        job_status;
+    fbe_job_service_error_type_t        job_error_type;
+    fbe_api_job_service_lun_create_t    lun_create_job;
+    fbe_u64_t                           job_numbers[SANDY_CHEEKS_MAX_LUNS];
+    fbe_u32_t                           lun_index;
+    fbe_u32_t                           rg_index;
+    fbe_time_t                          start_time;
+
+    start_time = fbe_get_time();
+    for (lun_index = 0; lun_index < SANDY_CHEEKS_MAX_LUNS; lun_index++)
+    {
+        rg_index = lun_index % SANDY_CHEEKS_RAID_GROUP_COUNT;
+
+        fbe_zero_memory(&lun_create_job, sizeof(fbe_api_job_service_lun_create_t));
+        lun_create_job.raid_type = rg_config_p[rg_index].raid_type;
+        lun_create_job.raid_group_id = rg_config_p[rg_index].raid_group_id;
+        lun_create_job.lun_number = SANDY_CHEEKS_FIRST_LUN_NUMBER + lun_index;
+        lun_create_job.capacity = SANDY_CHEEKS_LUN_CAPACITY;
+        lun_create_job.placement = FBE_BLOCK_TRANSPORT_BEST_FIT;
+        lun_create_job.ndb_b = FBE_FALSE;
+        lun_create_job.noinitialverify_b = FBE_FALSE;
+        lun_create_job.addroffset = FBE_LBA_INVALID;
+        lun_create_job.bind_time = fbe_get_time();
+        lun_create_job.wait_ready = FBE_TRUE;
+        lun_create_job.ready_timeout_msec = SANDY_CHEEKS_JOB_TIMEOUT_MS;
+        lun_create_job.world_wide_name.bytes[0] = fbe_random() & 0xf;
+        lun_create_job.world_wide_name.bytes[1] = fbe_random() & 0xf;
+        lun_create_job.world_wide_name.bytes[2] = (fbe_u8_t)lun_index;
+
+        status = fbe_api_job_service_lun_create(&lun_create_job);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+        job_numbers[lun_index] = lun_create_job.job_number;
+    }
+
+    for (lun_index = 0; lun_index < SANDY_CHEEKS_MAX_LUNS; lun_index++)
+    {
+        status = fbe_api_common_wait_for_job(job_numbers[lun_index],
+                                             SANDY_CHEEKS_JOB_TIMEOUT_MS,
+                                             &job_error_type,
+                                             &job_status,
+                                             &lun_object_ids[lun_index]);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, job_status);
+        MUT_ASSERT_INT_EQUAL(FBE_JOB_SERVICE_ERROR_NO_ERROR, job_error_type);
+    }
+    return fbe_get_elapsed_milliseconds(start_time);
+}
+/******************************************
+ * end sandy_cheeks_create_luns()
+ ******************************************/
+
+/*!**************************************************************
+ * sandy_cheeks_destroy_luns()
+ ****************************************************************
+ * @brief
+ *  Queue all the LUN destroy jobs and then wait for all of them.
+ *
+ * @param None.
+ *
+ * @return fbe_u32_t - milliseconds from the first job to the last
+ *                     completion.
+ *
+ ****************************************************************/
+static fbe_u32_t sandy_cheeks_destroy_luns(void)
+{
+    fbe_status_t                        status;
+    fbe_status_t                        job_status;
+    fbe_job_service_error_type_t        job_error_type;
+    fbe_api_job_service_lun_destroy_t   lun_destroy_job;
+    fbe_u64_t                           job_numbers[SANDY_CHEEKS_MAX_LUNS];
+    fbe_u32_t                           lun_index;
+    fbe_time_t                          start_time;
+
+    start_time = fbe_get_time();
+    for (lun_index = 0; lun_index < SANDY_CHEEKS_MAX_LUNS; lun_index++)
+    {
+        fbe_zero_memory(&lun_destroy_job, sizeof(fbe_api_job_service_lun_destroy_t));
+        lun_destroy_job.lun_number = SANDY_CHEEKS_FIRST_LUN_NUMBER + lun_index;
+        lun_destroy_job.wait_destroy = FBE_TRUE;
+        lun_destroy_job.destroy_timeout_msec = SANDY_CHEEKS_JOB_TIMEOUT_MS;
+
+        status = fbe_api_job_service_lun_destroy(&lun_destroy_job);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+        job_numbers[lun_index] = lun_destroy_job.job_number;
+    }
+
+    for (lun_index = 0; lun_index < SANDY_CHEEKS_MAX_LUNS; lun_index++)
+    {
+        status = fbe_api_common_wait_for_job(job_numbers[lun_index],
+                                             SANDY_CHEEKS_JOB_TIMEOUT_MS,
+                                             &job_error_type,
+                                             &job_status,
+                                             NULL);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, job_status);
+        MUT_ASSERT_INT_EQUAL(FBE_JOB_SERVICE_ERROR_NO_ERROR, job_error_type);
+    }
+    return fbe_get_elapsed_milliseconds(start_time);
+}
+/******************************************
+ * end sandy_cheeks_destroy_luns()
+ ******************************************/
+
+/*!**************************************************************
+ * sandy_cheeks_run_jobs()
+ ****************************************************************
+ * @brief
+ *  Create and destroy all the LUNs with one pipeline mode.
+ *
+ * @param rg_config_p - raid groups to create the LUNs in
+ * @param b_pipelined - pipeline mode to use
+ * @param create_ms_p - wall time of the creates
+ * @param destroy_ms_p - wall time of the destroys
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void sandy_cheeks_run_jobs(fbe_test_rg_configuration_t *rg_config_p,
+                                  fbe_bool_t b_pipelined,
+                                  fbe_u32_t *create_ms_p,
+                                  fbe_u32_t *destroy_ms_p)
+{
+    fbe_status_t    status;
+    fbe_object_id_t lun_object_ids[SANDY_CHEEKS_MAX_LUNS];
+    fbe_u32_t       lun_index;
+
+    mut_printf(MUT_LOG_TEST_STATUS, "== %s pipeline %s, %d LUNs over %d raid groups ==",
+               __FUNCTION__, b_pipelined ? "enabled" : "disabled",
+               SANDY_CHEEKS_MAX_LUNS, SANDY_CHEEKS_RAID_GROUP_COUNT);
+
+    status = fbe_api_job_service_set_pipeline_mode(b_pipelined);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    *create_ms_p = sandy_cheeks_create_luns(rg_config_p, &lun_object_ids[0]);
+
+    /* Every job waited for its LUN, so all of them must be ready now.
+     */
+    for (lun_index = 0; lun_index < SANDY_CHEEKS_MAX_LUNS; lun_index++)
+    {
+        status = fbe_api_wait_for_object_lifecycle_state(lun_object_ids[lun_index],
+                                                         FBE_LIFECYCLE_STATE_READY, 1000,
+                                                         FBE_PACKAGE_ID_SEP_0);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    }
+
+    *destroy_ms_p = sandy_cheeks_destroy_luns();
+
+    for (lun_index = 0; lun_index < SANDY_CHEEKS_MAX_LUNS; lun_index++)
+    {
+        status = fbe_api_wait_for_object_lifecycle_state(lun_object_ids[lun_index],
+                                                         FBE_LIFECYCLE_STATE_NOT_EXIST, 1000,
+                                                         FBE_PACKAGE_ID_SEP_0);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    }
+
+    mut_printf(MUT_LOG_TEST_STATUS, "== pipeline %s: create %d ms destroy %d ms ==",
+               b_pipelined ? "enabled" : "disabled", *create_ms_p, *destroy_ms_p);
+    return;
+}
+/******************************************
+ * end sandy_cheeks_run_jobs()
+ ******************************************/
+
+/*!**************************************************************
+ * sandy_cheeks_test_rg_config()
+ ****************************************************************
+ * @brief
+ *  Run the LUN jobs with the pipeline disabled and enabled.
+ *
+ * @param rg_config_p - raid groups under test
+ * @param context_p - unused
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void sandy_cheeks_test_rg_config(fbe_test_rg_configuration_t *rg_config_p, void *context_p)
+{
+    fbe_status_t                    status;
+    fbe_job_service_pipeline_info_t before_info;
+    fbe_job_service_pipeline_info_t after_info;
+    fbe_u32_t                       serial_create_ms;
+    fbe_u32_t                       serial_destroy_ms;
+    fbe_u32_t                       pipelined_create_ms;
+    fbe_u32_t                       pipelined_destroy_ms;
+
+    FBE_UNREFERENCED_PARAMETER(context_p);
+
+    sandy_cheeks_run_jobs(rg_config_p, FBE_FALSE, &serial_create_ms, &serial_destroy_ms);
+
+    status = fbe_api_job_service_get_pipeline_info(&before_info);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    sandy_cheeks_run_jobs(rg_config_p, FBE_TRUE, &pipelined_create_ms, &pipelined_destroy_ms);
+
+    status = fbe_api_job_service_get_pipeline_info(&after_info);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    mut_printf(MUT_LOG_TEST_STATUS, "== %d LUNs over %d raid groups ==",
+               SANDY_CHEEKS_MAX_LUNS, SANDY_CHEEKS_RAID_GROUP_COUNT);
+    mut_printf(MUT_LOG_TEST_STATUS, "   pipeline   create ms   destroy ms");
+    mut_printf(MUT_LOG_TEST_STATUS, "   disabled   %9d   %10d", serial_create_ms, serial_destroy_ms);
+    mut_printf(MUT_LOG_TEST_STATUS, "   enabled    %9d   %10d", pipelined_create_ms, pipelined_destroy_ms);
+    mut_printf(MUT_LOG_TEST_STATUS, "   slots: %d pipelined: %lld conflict waits: %lld drains: %lld",
+               after_info.max_in_flight,
+               (long long)(after_info.pipelined_jobs - before_info.pipelined_jobs),
+               (long long)(after_info.conflict_waits - before_info.conflict_waits),
+               (long long)(after_info.barrier_drains - before_info.barrier_drains));
+
+    /* Every job of the pipelined run is a LUN job, so all of them must have
+     * been handed to a commit slot.
+     */
+    MUT_ASSERT_INT_EQUAL(after_info.b_enabled, FBE_TRUE);
+    MUT_ASSERT_INT_EQUAL(0, after_info.in_flight);
+    MUT_ASSERT_TRUE((after_info.pipelined_jobs - before_info.pipelined_jobs) == (2 * SANDY_CHEEKS_MAX_LUNS));
+    return;
+}
+/******************************************
+ * end sandy_cheeks_test_rg_config()
+ ******************************************/
+
+/*!**************************************************************
+ * sandy_cheeks_test()
+ ****************************************************************
+ * @brief
+ *  Run the job service pipeline test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void sandy_cheeks_test(void)
+{
+    fbe_test_run_test_on_rg_config(&sandy_cheeks_raid_group_config[0], NULL, sandy_cheeks_test_rg_config,
+                                   SANDY_CHEEKS_LUNS_PER_RAID_GROUP,
+                                   SANDY_CHEEKS_CHUNKS_PER_LUN);
+    return;
+}
+/******************************************
+ * end sandy_cheeks_test()
+ ******************************************/
+
+/*!**************************************************************
+ * sandy_cheeks_setup()
+ ****************************************************************
+ * @brief
+ *  Setup for the job service pipeline test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void sandy_cheeks_setup(void)
+{
+    mut_printf(MUT_LOG_HIGH, "%s entry", __FUNCTION__);
+
+    /* Only load the physical config in simulation.
+     */
+    if (fbe_test_util_is_simulation())
+    {
+        fbe_test_rg_configuration_t *rg_config_p = &sandy_cheeks_raid_group_config[0];
+
+        fbe_test_sep_util_init_rg_configuration_array(rg_config_p);
+        elmo_load_config(rg_config_p,
+                         SANDY_CHEEKS_LUNS_PER_RAID_GROUP,
+                         SANDY_CHEEKS_CHUNKS_PER_LUN);
+    }
+
+    /* Initialize any required fields
+     */
+    fbe_test_common_util_test_setup_init();
+    return;
+}
+/**************************************
+ * end sandy_cheeks_setup()
+ **************************************/
+
+/*!**************************************************************
+ * sandy_cheeks_cleanup()
+ ****************************************************************
+ * @brief
+ *  Cleanup the job service pipeline test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void sandy_cheeks_cleanup(void)
+{
+    mut_printf(MUT_LOG_HIGH, "%s entry", __FUNCTION__);
+
+    /* Always leave the pipeline enabled */
+    fbe_api_job_service_set_pipeline_mode(FBE_TRUE);
+
+    if (fbe_test_util_is_simulation())
+    {
+        fbe_test_sep_util_destroy_neit_sep_physical();
+    }
+    return;
+}
+/******************************************
+ * end sandy_cheeks_cleanup()
+ ******************************************/
+
+/*************************
+ * end file sandy_cheeks_test.c
+ *************************/
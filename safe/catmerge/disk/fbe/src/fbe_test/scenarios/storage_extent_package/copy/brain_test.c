@@ -0,0 +1,393 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2009
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!**************************************************************************
+ * @file brain_test.c
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains a copy throughput test.  We copy the same position
+ *  of a raid group one region at a time and with concurrent regions, with
+ *  host I/O running, and report the copy rate and the host response time
+ *  of both.
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "mut.h"
+#include "sep_tests.h"
+#include "sep_test_io.h"
+#include "fbe/fbe_api_rdgen_interface.h"
+#include "fbe/fbe_api_common.h"
+#include "fbe/fbe_api_raid_group_interface.h"
+#include "fbe/fbe_api_virtual_drive_interface.h"
+#include "fbe/fbe_api_terminator_interface.h"
+#include "fbe/fbe_api_database_interface.h"
+#include "fbe/fbe_api_utils.h"
+#include "fbe_test_package_config.h"
+#include "fbe_test_configurations.h"
+#include "fbe_test_common_utils.h"
+#include "sep_utils.h"
+#include "pp_utils.h"
+#include "sep_rebuild_utils.h"
+#include "sep_test_background_ops.h"
+
+/*************************
+ *   FUNCTION DEFINITIONS
+ *************************/
+
+char * brain_short_desc = "concurrent multi-region copy throughput";
+char * brain_long_desc ="\
+The Brain scenario measures the virtual drive copy rate with concurrent copy regions.\n\
+\n\
+STEP 1: configure a raid 5 raid group with spare drives and slow down every drive I/O\n\
+        in the terminator.\n\
+\n\
+STEP 2: with one copy region at a time and then with the default concurrent regions\n\
+        - start random host reads and a user copy of the first position.\n\
+        - wait for the copy to complete and the source drive to swap out.\n\
+        - report the copy MB/s and the average host response time.\n\
+        - read back and check the data.\n\
+        - make sure one region never issued concurrent copy I/Os and the\n\
+          default regions did.\n\
+\n\
+STEP 3: destroy the configuration.\n\
+\n"
+"Description last updated: 10/19/2026.\n";
+
+/*!*******************************************************************
+ * @def BRAIN_LUNS_PER_RAID_GROUP
+ *********************************************************************
+ * @brief Number of LUNs in each raid group.
+ *
+ *********************************************************************/
+#define BRAIN_LUNS_PER_RAID_GROUP 1
+
+/*!*******************************************************************
+ * @def BRAIN_CHUNKS_PER_LUN
+ *********************************************************************
+ * @brief Number of chunks each LUN will occupy.
+ *
+ *********************************************************************/
+#define BRAIN_CHUNKS_PER_LUN 40
+
+/*!*******************************************************************
+ * @def BRAIN_DRIVE_DELAY_MS
+ *********************************************************************
+ * @brief Milliseconds the terminator delays the completion of every
+ *        drive I/O, so that drive latency dominates the copy.
+ *
+ *********************************************************************/
+#define BRAIN_DRIVE_DELAY_MS 2
+
+/*!*******************************************************************
+ * @def BRAIN_HOST_THREADS
+ *********************************************************************
+ * @brief Number of rdgen threads of host reads during the copy.
+ *
+ *********************************************************************/
+#define BRAIN_HOST_THREADS 2
+
+/*!*******************************************************************
+ * @def BRAIN_HOST_BLOCKS
+ *********************************************************************
+ * @brief Size of each host read (8K of 520 byte blocks).
+ *
+ *********************************************************************/
+#define BRAIN_HOST_BLOCKS 16
+
+/*!*******************************************************************
+ * @def BRAIN_DEFAULT_COPY_REGIONS
+ *********************************************************************
+ * @brief Default number of regions a virtual drive copies at once.
+ *
+ *********************************************************************/
+#define BRAIN_DEFAULT_COPY_REGIONS 4
+
+/*!*******************************************************************
+ * @def BRAIN_COPY_POSITION
+ *********************************************************************
+ * @brief Position of the drive we copy.
+ *
+ *********************************************************************/
+#define BRAIN_COPY_POSITION 0
+
+/*!*******************************************************************
+ * @var brain_raid_group_config
+ *********************************************************************
+ * @brief Raid group we copy.
+ *
+ *********************************************************************/
+static fbe_test_rg_configuration_t brain_raid_group_config[] =
+{
+    /* width,   capacity    raid type,                  class,                  block size      RAID-id.    bandwidth.*/
+    {5,       0x32000,    FBE_RAID_GROUP_TYPE_RAID5,  FBE_CLASS_ID_PARITY,      520,            0,          0},
+    {FBE_U32_MAX, FBE_U32_MAX, FBE_U32_MAX, /* Terminator. */},
+};
+
+/*!*******************************************************************
+ * @var brain_test_context_g
+ *********************************************************************
+ * @brief Context for the background pattern of the LUN.
+ *
+ *********************************************************************/
+static fbe_api_rdgen_context_t brain_test_context_g[BRAIN_LUNS_PER_RAID_GROUP];
+
+/*!**************************************************************
+ * brain_copy_one_drive()
+ ****************************************************************
+ * @brief
+ *  Copy the first position of the raid group with host reads
+ *  running, report the copy rate and host response time and check
+ *  the data.
+ *
+ * @param rg_config_p - raid group to copy.
+ * @param lun_object_id - LUN to run host I/O to.
+ * @param concurrent_regions - copy regions in flight per request.
+ *
+ * @return fbe_u32_t - Copy requests issued as concurrent I/Os.
+ *
+ ****************************************************************/
+static fbe_u32_t brain_copy_one_drive(fbe_test_rg_configuration_t *rg_config_p,
+                                      fbe_object_id_t lun_object_id,
+                                      fbe_u32_t concurrent_regions)
+{
+    fbe_status_t                        status;
+    fbe_object_id_t                     rg_object_id;
+    fbe_object_id_t                     vd_object_id;
+    fbe_api_raid_group_get_info_t       rg_info;
+    fbe_api_raid_group_get_info_t       vd_info;
+    fbe_api_rdgen_context_t             rdgen_context;
+    fbe_time_t                          start_time;
+    fbe_u32_t                           elapsed_msec;
+    fbe_u64_t                           io_count;
+    fbe_u64_t                           kb_per_second;
+    fbe_u32_t                           avg_response_us;
+    fbe_u32_t                           concurrent_requests;
+
+    status = fbe_api_virtual_drive_class_set_copy_concurrent_regions(concurrent_regions);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    status = fbe_api_database_lookup_raid_group_by_number(rg_config_p->raid_group_id, &rg_object_id);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    /* The virtual drive counts the copy requests it split into region I/Os.
+     */
+    status = fbe_test_sep_util_get_virtual_drive_object_id_by_position(rg_object_id, BRAIN_COPY_POSITION, &vd_object_id);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    status = fbe_api_raid_group_get_info(vd_object_id, &vd_info, FBE_PACKET_FLAG_NO_ATTRIB);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    concurrent_requests = vd_info.rebuild_concurrent_request_count;
+
+    status = fbe_api_rdgen_test_context_init(&rdgen_context,
+                                             lun_object_id,
+                                             FBE_CLASS_ID_INVALID,
+                                             FBE_PACKAGE_ID_SEP_0,
+                                             FBE_RDGEN_OPERATION_READ_ONLY,
+                                             FBE_RDGEN_PATTERN_LBA_PASS,
+                                             0,    /* passes (manual stop) */
+                                             0,    /* io count not used */
+                                             0,    /* time not used */
+                                             BRAIN_HOST_THREADS,
+                                             FBE_RDGEN_LBA_SPEC_RANDOM,
+                                             0,    /* start lba */
+                                             0,    /* min lba */
+                                             FBE_LBA_INVALID, /* use capacity */
+                                             FBE_RDGEN_BLOCK_SPEC_CONSTANT,
+                                             BRAIN_HOST_BLOCKS,
+                                             BRAIN_HOST_BLOCKS);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    status = fbe_api_rdgen_start_tests(&rdgen_context, FBE_PACKAGE_ID_NEIT, 1);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    start_time = fbe_get_time();
+    status = fbe_test_sep_background_ops_start_copy_operation(rg_config_p,
+                                                              1, /* Num RGs */
+                                                              BRAIN_COPY_POSITION,
+                                                              FBE_SPARE_INITIATE_USER_COPY_COMMAND,
+                                                              NULL /* The spare is selected */);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    status = fbe_test_sep_background_ops_wait_for_copy_operation_complete(rg_config_p,
+                                                                          1, /* Num RGs */
+                                                                          BRAIN_COPY_POSITION,
+                                                                          FBE_SPARE_INITIATE_USER_COPY_COMMAND,
+                                                                          FBE_TRUE, /* Wait for swap out */
+                                                                          FBE_FALSE /* Do not skip cleanup */);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    elapsed_msec = FBE_MAX(fbe_get_elapsed_milliseconds(start_time), 1);
+
+    status = fbe_api_rdgen_stop_tests(&rdgen_context, 1);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    MUT_ASSERT_INT_EQUAL(rdgen_context.start_io.statistics.error_count, 0);
+    io_count = FBE_MAX(rdgen_context.start_io.statistics.io_count, 1);
+
+    /* Each host thread has one read outstanding at a time.
+     */
+    avg_response_us = (fbe_u32_t)(((fbe_u64_t)elapsed_msec * 1000 * BRAIN_HOST_THREADS) / io_count);
+
+    status = fbe_api_raid_group_get_info(rg_object_id, &rg_info, FBE_PACKET_FLAG_NO_ATTRIB);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    status = fbe_api_raid_group_get_info(vd_object_id, &vd_info, FBE_PACKET_FLAG_NO_ATTRIB);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    concurrent_requests = vd_info.rebuild_concurrent_request_count - concurrent_requests;
+    kb_per_second = (rg_info.imported_blocks_per_disk * FBE_BE_BYTES_PER_BLOCK) / elapsed_msec;
+    mut_printf(MUT_LOG_TEST_STATUS, "   %d copy regions: copied 0x%llx blocks in %d ms %4lld.%03lld MB/s host response %d us concurrent requests %d",
+               concurrent_regions, (unsigned long long)rg_info.imported_blocks_per_disk, elapsed_msec,
+               (long long)(kb_per_second / 1000), (long long)(kb_per_second % 1000), avg_response_us,
+               concurrent_requests);
+
+    status = fbe_api_rdgen_test_context_destroy(&rdgen_context);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    /* The copy must not lose any data written before it started.
+     */
+    sep_rebuild_utils_read_bg_pattern(&brain_test_context_g[0], SEP_REBUILD_UTILS_ELEMENT_SIZE);
+    return concurrent_requests;
+}
+/******************************************
+ * end brain_copy_one_drive()
+ ******************************************/
+
+/*!**************************************************************
+ * brain_test_rg_config()
+ ****************************************************************
+ * @brief
+ *  Copy the raid group position with one and with concurrent
+ *  copy regions.
+ *
+ * @param rg_config_p - config to run test against.
+ * @param context_p - not used.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void brain_test_rg_config(fbe_test_rg_configuration_t *rg_config_p, void * context_p)
+{
+    fbe_status_t    status;
+    fbe_object_id_t lun_object_id;
+    fbe_u32_t       concurrent_requests;
+
+    status = fbe_api_database_lookup_lun_by_number(rg_config_p->logical_unit_configuration_list[0].lun_number,
+                                                   &lun_object_id);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    fbe_test_sep_util_wait_for_initial_verify(rg_config_p);
+    sep_rebuild_utils_write_bg_pattern(&brain_test_context_g[0], SEP_REBUILD_UTILS_ELEMENT_SIZE);
+
+    status = fbe_api_terminator_set_io_global_completion_delay(BRAIN_DRIVE_DELAY_MS);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    mut_printf(MUT_LOG_TEST_STATUS, "== %s copy with %d ms drive latency ==", __FUNCTION__, BRAIN_DRIVE_DELAY_MS);
+    concurrent_requests = brain_copy_one_drive(rg_config_p, lun_object_id, 1);
+    MUT_ASSERT_INT_EQUAL(0, concurrent_requests);
+    concurrent_requests = brain_copy_one_drive(rg_config_p, lun_object_id, BRAIN_DEFAULT_COPY_REGIONS);
+    MUT_ASSERT_TRUE(concurrent_requests > 0);
+
+    status = fbe_api_terminator_set_io_global_completion_delay(0);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    return;
+}
+/******************************************
+ * end brain_test_rg_config()
+ ******************************************/
+
+/*!**************************************************************
+ * brain_test()
+ ****************************************************************
+ * @brief
+ *  Run the copy throughput test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void brain_test(void)
+{
+    fbe_test_sep_util_set_dualsp_test_mode(FBE_FALSE);
+    fbe_test_run_test_on_rg_config(&brain_raid_group_config[0], NULL, brain_test_rg_config,
+                                   BRAIN_LUNS_PER_RAID_GROUP,
+                                   BRAIN_CHUNKS_PER_LUN);
+    return;
+}
+/******************************************
+ * end brain_test()
+ ******************************************/
+
+/*!**************************************************************
+ * brain_setup()
+ ****************************************************************
+ * @brief
+ *  Setup for the copy throughput test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void brain_setup(void)
+{
+    mut_printf(MUT_LOG_HIGH, "%s entry", __FUNCTION__);
+
+    /* Only load the physical config in simulation.
+     */
+    if (fbe_test_util_is_simulation())
+    {
+        fbe_test_rg_configuration_t *rg_config_p = &brain_raid_group_config[0];
+        fbe_u32_t                    num_raid_groups;
+
+        fbe_test_sep_util_init_rg_configuration_array(rg_config_p);
+        num_raid_groups = fbe_test_get_rg_array_length(rg_config_p);
+
+        /* The extra drives are the copy destinations.
+         */
+        fbe_test_sep_util_populate_rg_num_extra_drives(rg_config_p);
+        fbe_test_create_physical_config_for_rg(rg_config_p, num_raid_groups);
+        sep_config_load_sep_and_neit();
+    }
+
+    /* Initialize any required fields
+     */
+    fbe_test_common_util_test_setup_init();
+    return;
+}
+/**************************************
+ * end brain_setup()
+ **************************************/
+
+/*!**************************************************************
+ * brain_cleanup()
+ ****************************************************************
+ * @brief
+ *  Cleanup the brain test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void brain_cleanup(void)
+{
+    mut_printf(MUT_LOG_HIGH, "%s entry", __FUNCTION__);
+
+    /* Restore the default for the tests that follow.
+     */
+    fbe_api_virtual_drive_class_set_copy_concurrent_regions(BRAIN_DEFAULT_COPY_REGIONS);
+
+    if (fbe_test_util_is_simulation())
+    {
+        fbe_test_sep_util_destroy_neit_sep_physical();
+    }
+    return;
+}
+/******************************************
+ * end brain_cleanup()
+ ******************************************/
+
+/*************************
+ * end file brain_test.c
+ *************************/
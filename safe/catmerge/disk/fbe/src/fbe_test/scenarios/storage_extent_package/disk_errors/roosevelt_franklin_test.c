@@ -0,0 +1,482 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2014
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!**************************************************************************
+ * @file roosevelt_franklin_test.c
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains a test that measures what protocol error injection
+ *  costs the I/O path.  It runs rdgen reads to a wide raid 0 with no
+ *  records, with a record armed on one drive and with a record armed on
+ *  every drive, and reports the IOPS of each run.  It then checks that a
+ *  record which matches the reads is hit exactly as often as it asked for.
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "mut.h"
+#include "fbe/fbe_api_rdgen_interface.h"
+#include "sep_tests.h"
+#include "fbe/fbe_winddk.h"
+#include "fbe/fbe_api_common.h"
+#include "fbe/fbe_api_utils.h"
+#include "fbe/fbe_api_database_interface.h"
+#include "fbe/fbe_api_physical_drive_interface.h"
+#include "fbe/fbe_api_protocol_error_injection_interface.h"
+#include "fbe/fbe_scsi_interface.h"
+#include "fbe_test_package_config.h"
+#include "fbe_test_configurations.h"
+#include "sep_utils.h"
+#include "neit_utils.h"
+#include "pp_utils.h"
+#include "fbe_test_common_utils.h"
+
+/*************************
+ *   FUNCTION DEFINITIONS
+ *************************/
+
+char * roosevelt_franklin_short_desc = "cost of armed protocol error injection on I/O throughput";
+char * roosevelt_franklin_long_desc ="\
+The Roosevelt Franklin scenario measures how much armed protocol error injection slows down I/O.\n\
+\n\
+STEP 1: configure a 16 drive raid 0 raid group with one LUN.\n\
+\n\
+STEP 2: run random reads for a fixed amount of time\n\
+        - with no error records.\n\
+        - with a record armed on one drive.\n\
+        - with a record armed on every drive.\n\
+        - the records are for a command the reads never send, so nothing is injected.\n\
+        - report the IOPS of every run relative to the run without records.\n\
+        - make sure none of the records was hit.\n\
+\n\
+STEP 3: add a record for reads of the last drive that injects a recovered error a few times.\n\
+        - run random reads again.\n\
+        - make sure the record was hit exactly that many times and no other record was hit.\n\
+        - make sure no read failed.\n\
+\n\
+STEP 4: remove the records and destroy the configuration.\n\
+\n"
+"Description last updated: 10/19/2026.\n";
+
+/*!*******************************************************************
+ * @def ROOSEVELT_FRANKLIN_LUNS_PER_RAID_GROUP
+ *********************************************************************
+ * @brief Number of LUNs in the raid group.
+ *
+ *********************************************************************/
+#define ROOSEVELT_FRANKLIN_LUNS_PER_RAID_GROUP 1
+
+/*!*******************************************************************
+ * @def ROOSEVELT_FRANKLIN_CHUNKS_PER_LUN
+ *********************************************************************
+ * @brief Number of chunks each LUN will occupy.
+ *
+ *********************************************************************/
+#define ROOSEVELT_FRANKLIN_CHUNKS_PER_LUN 16
+
+/*!*******************************************************************
+ * @def ROOSEVELT_FRANKLIN_WIDTH
+ *********************************************************************
+ * @brief Number of drives in the raid group.
+ *
+ *********************************************************************/
+#define ROOSEVELT_FRANKLIN_WIDTH 16
+
+/*!*******************************************************************
+ * @def ROOSEVELT_FRANKLIN_THREADS
+ *********************************************************************
+ * @brief Number of rdgen threads, enough to keep every drive busy.
+ *
+ *********************************************************************/
+#define ROOSEVELT_FRANKLIN_THREADS 32
+
+/*!*******************************************************************
+ * @def ROOSEVELT_FRANKLIN_BLOCKS
+ *********************************************************************
+ * @brief Size of each read, small so the run is bound by per I/O cost.
+ *
+ *********************************************************************/
+#define ROOSEVELT_FRANKLIN_BLOCKS 8
+
+/*!*******************************************************************
+ * @def ROOSEVELT_FRANKLIN_RUN_SECONDS
+ *********************************************************************
+ * @brief How long we run I/O for each measurement.
+ *
+ *********************************************************************/
+#define ROOSEVELT_FRANKLIN_RUN_SECONDS 10
+
+/*!*******************************************************************
+ * @def ROOSEVELT_FRANKLIN_INJECT_COUNT
+ *********************************************************************
+ * @brief Number of recovered errors the matching record injects.
+ *        Small enough not to trip the drive error handling.
+ *
+ *********************************************************************/
+#define ROOSEVELT_FRANKLIN_INJECT_COUNT 5
+
+/*!*******************************************************************
+ * @var roosevelt_franklin_raid_group_config
+ *********************************************************************
+ * @brief Raid group we run I/O to.
+ *
+ *********************************************************************/
+static fbe_test_rg_configuration_t roosevelt_franklin_raid_group_config[] =
+{
+    /* width,                   capacity    raid type,                  class,                  block size      RAID-id.    bandwidth.*/
+    {ROOSEVELT_FRANKLIN_WIDTH, 0xE000,     FBE_RAID_GROUP_TYPE_RAID0,  FBE_CLASS_ID_STRIPER,     520,            0,          0},
+    {FBE_U32_MAX, FBE_U32_MAX, FBE_U32_MAX, /* Terminator. */},
+};
+
+/*!**************************************************************
+ * roosevelt_franklin_run_io()
+ ****************************************************************
+ * @brief
+ *  Run random reads for a fixed time and return the IOPS.
+ *
+ * @param lun_object_id - LUN to run I/O to.
+ *
+ * @return fbe_u32_t - IOPS of the run.
+ *
+ ****************************************************************/
+static fbe_u32_t roosevelt_franklin_run_io(fbe_object_id_t lun_object_id)
+{
+    fbe_status_t                    status;
+    fbe_api_rdgen_context_t         rdgen_context;
+    fbe_time_t                      start_time;
+    fbe_u32_t                       elapsed_msec;
+    fbe_u64_t                       io_count;
+
+    status = fbe_api_rdgen_test_context_init(&rdgen_context,
+                                             lun_object_id,
+                                             FBE_CLASS_ID_INVALID,
+                                             FBE_PACKAGE_ID_SEP_0,
+                                             FBE_RDGEN_OPERATION_READ_ONLY,
+                                             FBE_RDGEN_PATTERN_LBA_PASS,
+                                             0,    /* passes (manual stop) */
+                                             0,    /* io count not used */
+                                             0,    /* time not used */
+                                             ROOSEVELT_FRANKLIN_THREADS,
+                                             FBE_RDGEN_LBA_SPEC_RANDOM,
+                                             0,    /* start lba */
+                                             0,    /* min lba */
+                                             FBE_LBA_INVALID, /* use capacity */
+                                             FBE_RDGEN_BLOCK_SPEC_CONSTANT,
+                                             ROOSEVELT_FRANKLIN_BLOCKS,
+                                             ROOSEVELT_FRANKLIN_BLOCKS);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    start_time = fbe_get_time();
+    status = fbe_api_rdgen_start_tests(&rdgen_context, FBE_PACKAGE_ID_NEIT, 1);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    fbe_api_sleep(ROOSEVELT_FRANKLIN_RUN_SECONDS * FBE_TIME_MILLISECONDS_PER_SECOND);
+
+    status = fbe_api_rdgen_stop_tests(&rdgen_context, 1);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    elapsed_msec = fbe_get_elapsed_milliseconds(start_time);
+
+    /* Nothing should have been injected.
+     */
+    MUT_ASSERT_INT_EQUAL(rdgen_context.start_io.statistics.error_count, 0);
+    io_count = rdgen_context.start_io.statistics.io_count;
+    MUT_ASSERT_TRUE(io_count > 0);
+
+    status = fbe_api_rdgen_test_context_destroy(&rdgen_context);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    return (fbe_u32_t)((io_count * FBE_TIME_MILLISECONDS_PER_SECOND) / FBE_MAX(elapsed_msec, 1));
+}
+/******************************************
+ * end roosevelt_franklin_run_io()
+ ******************************************/
+
+/*!**************************************************************
+ * roosevelt_franklin_arm_drive()
+ ****************************************************************
+ * @brief
+ *  Add a record to one drive that the reads will never match.
+ *  This is the worst case for the edge hook, since every I/O
+ *  looks at the record without injecting anything.
+ *
+ * @param disk_p - Drive to arm.
+ * @param record_handle_p - Returns the handle of the record.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void roosevelt_franklin_arm_drive(fbe_test_raid_group_disk_set_t *disk_p,
+                                         fbe_protocol_error_injection_record_handle_t *record_handle_p)
+{
+    fbe_status_t                                    status;
+    fbe_protocol_error_injection_error_record_t     record;
+    fbe_object_id_t                                 pdo_object_id;
+
+    status = fbe_api_get_physical_drive_object_id_by_location(disk_p->bus, disk_p->enclosure, disk_p->slot,
+                                                              &pdo_object_id);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    fbe_test_neit_utils_init_error_injection_record(&record);
+    record.object_id = pdo_object_id;
+    record.lba_start = 0;
+    record.lba_end = 0;
+    record.num_of_times_to_insert = FBE_U32_MAX;
+    record.protocol_error_injection_error_type = FBE_PROTOCOL_ERROR_INJECTION_ERROR_TYPE_SCSI;
+    record.protocol_error_injection_error.protocol_error_injection_scsi_error.scsi_command[0] = FBE_SCSI_REASSIGN_BLOCKS;
+    fbe_test_sep_util_set_scsi_error_from_error_type(&record.protocol_error_injection_error.protocol_error_injection_scsi_error,
+                                                     FBE_TEST_PROTOCOL_ERROR_TYPE_HARD_MEDIA_ERROR);
+
+    status = fbe_api_protocol_error_injection_add_record(&record, record_handle_p);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    return;
+}
+/******************************************
+ * end roosevelt_franklin_arm_drive()
+ ******************************************/
+
+/*!**************************************************************
+ * roosevelt_franklin_inject_drive()
+ ****************************************************************
+ * @brief
+ *  Add a record to one drive that injects a recovered error into
+ *  the reads a few times.  The reads still succeed.
+ *
+ * @param disk_p - Drive to inject on.
+ * @param record_handle_p - Returns the handle of the record.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void roosevelt_franklin_inject_drive(fbe_test_raid_group_disk_set_t *disk_p,
+                                            fbe_protocol_error_injection_record_handle_t *record_handle_p)
+{
+    fbe_status_t                                    status;
+    fbe_protocol_error_injection_error_record_t     record;
+    fbe_object_id_t                                 pdo_object_id;
+
+    status = fbe_api_get_physical_drive_object_id_by_location(disk_p->bus, disk_p->enclosure, disk_p->slot,
+                                                              &pdo_object_id);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    fbe_test_neit_utils_init_error_injection_record(&record);
+    record.object_id = pdo_object_id;
+    record.lba_start = 0;
+    record.lba_end = FBE_U32_MAX;
+    record.num_of_times_to_insert = ROOSEVELT_FRANKLIN_INJECT_COUNT;
+    record.protocol_error_injection_error_type = FBE_PROTOCOL_ERROR_INJECTION_ERROR_TYPE_SCSI;
+    record.protocol_error_injection_error.protocol_error_injection_scsi_error.scsi_command[0] = FBE_SCSI_READ_6;
+    record.protocol_error_injection_error.protocol_error_injection_scsi_error.scsi_command[1] = FBE_SCSI_READ_10;
+    record.protocol_error_injection_error.protocol_error_injection_scsi_error.scsi_command[2] = FBE_SCSI_READ_12;
+    record.protocol_error_injection_error.protocol_error_injection_scsi_error.scsi_command[3] = FBE_SCSI_READ_16;
+    fbe_test_sep_util_set_scsi_error_from_error_type(&record.protocol_error_injection_error.protocol_error_injection_scsi_error,
+                                                     FBE_TEST_PROTOCOL_ERROR_TYPE_SOFT_MEDIA_ERROR);
+
+    status = fbe_api_protocol_error_injection_add_record(&record, record_handle_p);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    return;
+}
+/******************************************
+ * end roosevelt_franklin_inject_drive()
+ ******************************************/
+
+/*!**************************************************************
+ * roosevelt_franklin_check_times_inserted()
+ ****************************************************************
+ * @brief
+ *  Make sure a record was hit the expected number of times.
+ *
+ * @param record_handle - Record to check.
+ * @param expected_times_inserted - Number of hits expected.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void roosevelt_franklin_check_times_inserted(fbe_protocol_error_injection_record_handle_t record_handle,
+                                                    fbe_u32_t expected_times_inserted)
+{
+    fbe_status_t                                    status;
+    fbe_protocol_error_injection_error_record_t     record;
+
+    status = fbe_api_protocol_error_injection_get_record(record_handle, &record);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    if (record.times_inserted != expected_times_inserted)
+    {
+        mut_printf(MUT_LOG_TEST_STATUS, "record of obj 0x%x inserted %d times expected %d",
+                   record.object_id, record.times_inserted, expected_times_inserted);
+        MUT_FAIL();
+    }
+    return;
+}
+/******************************************
+ * end roosevelt_franklin_check_times_inserted()
+ ******************************************/
+
+/*!**************************************************************
+ * roosevelt_franklin_test_rg_config()
+ ****************************************************************
+ * @brief
+ *  Measure the IOPS without records, with one armed drive and
+ *  with every drive armed, then inject errors on one drive and
+ *  count the hits of every record.
+ *
+ * @param rg_config_p - config to run test against.
+ * @param context_p - not used.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void roosevelt_franklin_test_rg_config(fbe_test_rg_configuration_t *rg_config_p, void * context_p)
+{
+    fbe_status_t                            status;
+    fbe_object_id_t                         lun_object_id;
+    fbe_u32_t                               position;
+    fbe_u32_t                               baseline_iops;
+    fbe_u32_t                               one_drive_iops;
+    fbe_u32_t                               all_drives_iops;
+    fbe_protocol_error_injection_record_handle_t armed_handle[ROOSEVELT_FRANKLIN_WIDTH];
+    fbe_protocol_error_injection_record_handle_t inject_handle;
+
+    status = fbe_api_database_lookup_lun_by_number(rg_config_p->logical_unit_configuration_list[0].lun_number, &lun_object_id);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    mut_printf(MUT_LOG_TEST_STATUS, "== %s no records ==", __FUNCTION__);
+    baseline_iops = roosevelt_franklin_run_io(lun_object_id);
+
+    mut_printf(MUT_LOG_TEST_STATUS, "== %s one of %d drives armed ==", __FUNCTION__, rg_config_p->width);
+    roosevelt_franklin_arm_drive(&rg_config_p->rg_disk_set[0], &armed_handle[0]);
+    status = fbe_api_protocol_error_injection_start();
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    one_drive_iops = roosevelt_franklin_run_io(lun_object_id);
+
+    mut_printf(MUT_LOG_TEST_STATUS, "== %s all %d drives armed ==", __FUNCTION__, rg_config_p->width);
+    for (position = 1; position < rg_config_p->width; position++)
+    {
+        roosevelt_franklin_arm_drive(&rg_config_p->rg_disk_set[position], &armed_handle[position]);
+    }
+    all_drives_iops = roosevelt_franklin_run_io(lun_object_id);
+    for (position = 0; position < rg_config_p->width; position++)
+    {
+        roosevelt_franklin_check_times_inserted(armed_handle[position], 0);
+    }
+
+    /* A record that matches the reads is hit as many times as it asks for,
+     * and only its own drive's I/O can hit it.
+     */
+    mut_printf(MUT_LOG_TEST_STATUS, "== %s inject %d recovered errors on position %d ==",
+               __FUNCTION__, ROOSEVELT_FRANKLIN_INJECT_COUNT, rg_config_p->width - 1);
+    roosevelt_franklin_inject_drive(&rg_config_p->rg_disk_set[rg_config_p->width - 1], &inject_handle);
+    roosevelt_franklin_run_io(lun_object_id);
+    roosevelt_franklin_check_times_inserted(inject_handle, ROOSEVELT_FRANKLIN_INJECT_COUNT);
+    for (position = 0; position < rg_config_p->width; position++)
+    {
+        roosevelt_franklin_check_times_inserted(armed_handle[position], 0);
+    }
+
+    status = fbe_api_protocol_error_injection_stop();
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    status = fbe_api_protocol_error_injection_remove_all_records();
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    mut_printf(MUT_LOG_TEST_STATUS, "   no records:  %6d IOPS", baseline_iops);
+    mut_printf(MUT_LOG_TEST_STATUS, "   one armed:   %6d IOPS (%3d%%)", one_drive_iops,
+               (fbe_u32_t)(((fbe_u64_t)one_drive_iops * 100) / FBE_MAX(baseline_iops, 1)));
+    mut_printf(MUT_LOG_TEST_STATUS, "   all armed:   %6d IOPS (%3d%%)", all_drives_iops,
+               (fbe_u32_t)(((fbe_u64_t)all_drives_iops * 100) / FBE_MAX(baseline_iops, 1)));
+    return;
+}
+/******************************************
+ * end roosevelt_franklin_test_rg_config()
+ ******************************************/
+
+/*!**************************************************************
+ * roosevelt_franklin_test()
+ ****************************************************************
+ * @brief
+ *  Run the error injection throughput test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void roosevelt_franklin_test(void)
+{
+    fbe_test_run_test_on_rg_config(&roosevelt_franklin_raid_group_config[0], NULL, roosevelt_franklin_test_rg_config,
+                                   ROOSEVELT_FRANKLIN_LUNS_PER_RAID_GROUP,
+                                   ROOSEVELT_FRANKLIN_CHUNKS_PER_LUN);
+    return;
+}
+/******************************************
+ * end roosevelt_franklin_test()
+ ******************************************/
+
+/*!**************************************************************
+ * roosevelt_franklin_setup()
+ ****************************************************************
+ * @brief
+ *  Setup for the error injection throughput test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void roosevelt_franklin_setup(void)
+{
+    mut_printf(MUT_LOG_HIGH, "%s entry", __FUNCTION__);
+
+    /* Only load the physical config in simulation.
+     */
+    if (fbe_test_util_is_simulation())
+    {
+        fbe_test_rg_configuration_t *rg_config_p = &roosevelt_franklin_raid_group_config[0];
+
+        fbe_test_sep_util_init_rg_configuration_array(rg_config_p);
+        elmo_load_config(rg_config_p,
+                         ROOSEVELT_FRANKLIN_LUNS_PER_RAID_GROUP,
+                         ROOSEVELT_FRANKLIN_CHUNKS_PER_LUN);
+    }
+
+    /* Initialize any required fields
+     */
+    fbe_test_common_util_test_setup_init();
+    return;
+}
+/**************************************
+ * end roosevelt_franklin_setup()
+ **************************************/
+
+/*!**************************************************************
+ * roosevelt_franklin_cleanup()
+ ****************************************************************
+ * @brief
+ *  Cleanup the roosevelt franklin test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void roosevelt_franklin_cleanup(void)
+{
+    mut_printf(MUT_LOG_HIGH, "%s entry", __FUNCTION__);
+
+    if (fbe_test_util_is_simulation())
+    {
+        fbe_test_sep_util_destroy_neit_sep_physical();
+    }
+    return;
+}
+/******************************************
+ * end roosevelt_franklin_cleanup()
+ ******************************************/
+
+/*************************
+ * end file roosevelt_franklin_test.c
+ *************************/
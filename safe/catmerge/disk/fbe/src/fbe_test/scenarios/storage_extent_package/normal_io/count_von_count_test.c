@@ -0,0 +1,464 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2009
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!**************************************************************************
+ * @file count_von_count_test.c
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains a comparison of fixed and adaptive batching of the
+ *  transport run queues.  It drives rdgen I/O at a range of queue depths,
+ *  checks the batch sizes each mode uses and reports IOPS, latency and
+ *  the run queue wait time for both modes.
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "mut.h"
+#include "fbe/fbe_api_rdgen_interface.h"
+#include "sep_tests.h"
+#include "fbe/fbe_winddk.h"
+#include "fbe/fbe_transport.h"
+#include "fbe/fbe_api_common.h"
+#include "fbe_test_package_config.h"
+#include "fbe_test_configurations.h"
+#include "sep_utils.h"
+#include "fbe/fbe_api_utils.h"
+#include "fbe/fbe_api_sim_server.h"
+#include "fbe/fbe_api_database_interface.h"
+#include "fbe/fbe_api_bvd_interface.h"
+#include "fbe/fbe_sep_shim.h"
+#include "pp_utils.h"
+#include "fbe_test_common_utils.h"
+
+/*************************
+ *   FUNCTION DEFINITIONS
+ *************************/
+
+char * count_von_count_short_desc = "transport run queue fixed vs. adaptive batching";
+char * count_von_count_long_desc ="\
+The Count Von Count scenario compares fixed and adaptive batching of the transport run queues.\n\
+\n\
+STEP 1: configure a raid 5 raid group with one LUN.\n\
+\n\
+STEP 2: for the fixed and then for the adaptive batch mode\n\
+        - run random 4K reads at queue depths 1, 4, 16, 64 and 256.\n\
+        - each depth runs for a fixed amount of time.\n\
+        - validate the run queue wait time was sampled.\n\
+        - validate fixed batching uses the same batch size on every core and no pass takes more.\n\
+        - validate adaptive batching keeps every core's batch between the minimum and the maximum.\n\
+        - report the IOPS, the average latency and the run queue wait time of every depth.\n\
+\n\
+STEP 3: restore the adaptive batch mode and destroy the configuration.\n\
+\n"
+"Description last updated: 10/19/2026.\n";
+
+/*!*******************************************************************
+ * @def COUNT_VON_COUNT_LUNS_PER_RAID_GROUP
+ *********************************************************************
+ * @brief Number of LUNs in the raid group.
+ *
+ *********************************************************************/
+#define COUNT_VON_COUNT_LUNS_PER_RAID_GROUP 1
+
+/*!*******************************************************************
+ * @def COUNT_VON_COUNT_CHUNKS_PER_LUN
+ *********************************************************************
+ * @brief Number of chunks each LUN will occupy.
+ *
+ *********************************************************************/
+#define COUNT_VON_COUNT_CHUNKS_PER_LUN 6
+
+/*!*******************************************************************
+ * @def COUNT_VON_COUNT_RUN_SECONDS
+ *********************************************************************
+ * @brief How long we run I/O at each queue depth.
+ *
+ *********************************************************************/
+#define COUNT_VON_COUNT_RUN_SECONDS 5
+
+/*!*******************************************************************
+ * @def COUNT_VON_COUNT_BLOCKS
+ *********************************************************************
+ * @brief Size of each I/O.
+ *
+ *********************************************************************/
+#define COUNT_VON_COUNT_BLOCKS 8
+
+/*!*******************************************************************
+ * @def COUNT_VON_COUNT_MAX_CONTEXTS
+ *********************************************************************
+ * @brief rdgen limits the threads of one specification,
+ *        the deepest queue is split over this many contexts.
+ *
+ *********************************************************************/
+#define COUNT_VON_COUNT_MAX_CONTEXTS 2
+
+/*!*******************************************************************
+ * @def COUNT_VON_COUNT_MIN_BATCH_SIZE
+ *********************************************************************
+ * @brief Smallest batch the adaptive mode uses.
+ *
+ *********************************************************************/
+#define COUNT_VON_COUNT_MIN_BATCH_SIZE 4
+
+/*!*******************************************************************
+ * @def COUNT_VON_COUNT_MAX_BATCH_SIZE
+ *********************************************************************
+ * @brief Largest batch the adaptive mode uses.
+ *
+ *********************************************************************/
+#define COUNT_VON_COUNT_MAX_BATCH_SIZE (FBE_TRANSPORT_RUN_QUEUE_HIST_DEPTH_SIZE - 1)
+
+/*!*******************************************************************
+ * @var count_von_count_queue_depths
+ *********************************************************************
+ * @brief Queue depths we measure.
+ *
+ *********************************************************************/
+static fbe_u32_t count_von_count_queue_depths[] = {1, 4, 16, 64, 256};
+
+#define COUNT_VON_COUNT_DEPTH_COUNT (sizeof(count_von_count_queue_depths) / sizeof(count_von_count_queue_depths[0]))
+
+/*!*******************************************************************
+ * @struct count_von_count_result_t
+ *********************************************************************
+ * @brief Result of one queue depth.
+ *
+ *********************************************************************/
+typedef struct count_von_count_result_s{
+    fbe_u32_t iops;
+    fbe_u32_t latency_us;       /* queue depth / IOPS */
+    fbe_u32_t runq_wait_us;     /* average over all cores */
+    fbe_u32_t runq_max_wait_us; /* max over all cores */
+}count_von_count_result_t;
+
+static count_von_count_result_t count_von_count_results[2][COUNT_VON_COUNT_DEPTH_COUNT];
+
+/*!*******************************************************************
+ * @var count_von_count_raid_group_config
+ *********************************************************************
+ * @brief Raid group we run I/O to.
+ *
+ *********************************************************************/
+static fbe_test_rg_configuration_t count_von_count_raid_group_config[] =
+{
+    /* width,   capacity    raid type,                  class,                  block size      RAID-id.    bandwidth.*/
+    {5,       0xE000,     FBE_RAID_GROUP_TYPE_RAID5,  FBE_CLASS_ID_PARITY,      520,            0,          0},
+    {FBE_U32_MAX, FBE_U32_MAX, FBE_U32_MAX, /* Terminator. */},
+};
+
+/*!**************************************************************
+ * count_von_count_check_batches()
+ ****************************************************************
+ * @brief
+ *  Check the batches every core used while we ran I/O.
+ *  Fixed batching uses one batch size on all cores and never
+ *  takes more than it off the queue in one pass.  Adaptive
+ *  batching sizes each core between the minimum and the maximum.
+ *
+ * @param perf_stats_p - stats collected after the run.
+ * @param batch_mode - batch mode we ran with.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void count_von_count_check_batches(fbe_sep_shim_get_perf_stat_t *perf_stats_p,
+                                          fbe_transport_run_queue_batch_mode_t batch_mode)
+{
+    fbe_transport_run_queue_stats_t    *runq_stats_p;
+    fbe_cpu_id_t                        core_count = fbe_get_cpu_count();
+    fbe_cpu_id_t                        core;
+    fbe_u32_t                           fixed_batch_size = perf_stats_p->core_stat[0].runq_stats.transport_run_queue_batch_size;
+    fbe_u64_t                           wait_count = 0;
+
+    for (core = 0; core < core_count; core++)
+    {
+        runq_stats_p = &perf_stats_p->core_stat[core].runq_stats;
+        wait_count += runq_stats_p->transport_run_queue_wait_count;
+
+        if (batch_mode == FBE_TRANSPORT_RUN_QUEUE_BATCH_MODE_FIXED)
+        {
+            MUT_ASSERT_INT_EQUAL(fixed_batch_size, runq_stats_p->transport_run_queue_batch_size);
+            MUT_ASSERT_TRUE(runq_stats_p->transport_run_queue_max_depth <= fixed_batch_size);
+        }
+        else
+        {
+            MUT_ASSERT_TRUE(runq_stats_p->transport_run_queue_batch_size >= COUNT_VON_COUNT_MIN_BATCH_SIZE);
+            MUT_ASSERT_TRUE(runq_stats_p->transport_run_queue_batch_size <= COUNT_VON_COUNT_MAX_BATCH_SIZE);
+            MUT_ASSERT_TRUE(runq_stats_p->transport_run_queue_max_depth <= COUNT_VON_COUNT_MAX_BATCH_SIZE);
+        }
+    }
+
+    /* Every I/O completes through the run queues, so the wait time was sampled.
+     */
+    MUT_ASSERT_TRUE(wait_count > 0);
+    return;
+}
+/******************************************
+ * end count_von_count_check_batches()
+ ******************************************/
+
+/*!**************************************************************
+ * count_von_count_run_depth()
+ ****************************************************************
+ * @brief
+ *  Run random reads at one queue depth and collect the results.
+ *
+ * @param lun_object_id - LUN to run I/O to.
+ * @param queue_depth - number of outstanding I/Os.
+ * @param batch_mode - batch mode we run with.
+ * @param result_p - where to put the results.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void count_von_count_run_depth(fbe_object_id_t lun_object_id,
+                                      fbe_u32_t queue_depth,
+                                      fbe_transport_run_queue_batch_mode_t batch_mode,
+                                      count_von_count_result_t *result_p)
+{
+    fbe_status_t                    status;
+    fbe_api_rdgen_context_t         rdgen_context[COUNT_VON_COUNT_MAX_CONTEXTS];
+    fbe_sep_shim_get_perf_stat_t    perf_stats;
+    fbe_u32_t                       context_count;
+    fbe_u32_t                       context_index;
+    fbe_u64_t                       io_count = 0;
+    fbe_u64_t                       wait_time = 0;
+    fbe_u64_t                       wait_count = 0;
+    fbe_u32_t                       max_wait = 0;
+    fbe_time_t                      start_time;
+    fbe_u32_t                       elapsed_msec;
+    fbe_cpu_id_t                    core_count = fbe_get_cpu_count();
+    fbe_cpu_id_t                    core;
+
+    context_count = (queue_depth + FBE_RDGEN_MAX_THREADS_PER_IO_SPECIFICATION - 1) / FBE_RDGEN_MAX_THREADS_PER_IO_SPECIFICATION;
+    MUT_ASSERT_TRUE(context_count <= COUNT_VON_COUNT_MAX_CONTEXTS);
+
+    for (context_index = 0; context_index < context_count; context_index++)
+    {
+        status = fbe_api_rdgen_test_context_init(&rdgen_context[context_index],
+                                                 lun_object_id,
+                                                 FBE_CLASS_ID_INVALID,
+                                                 FBE_PACKAGE_ID_SEP_0,
+                                                 FBE_RDGEN_OPERATION_READ_ONLY,
+                                                 FBE_RDGEN_PATTERN_LBA_PASS,
+                                                 0,    /* passes (manual stop) */
+                                                 0,    /* io count not used */
+                                                 0,    /* time not used */
+                                                 queue_depth / context_count, /* threads */
+                                                 FBE_RDGEN_LBA_SPEC_RANDOM,
+                                                 0,    /* start lba */
+                                                 0,    /* min lba */
+                                                 FBE_LBA_INVALID, /* use capacity */
+                                                 FBE_RDGEN_BLOCK_SPEC_CONSTANT,
+                                                 COUNT_VON_COUNT_BLOCKS,
+                                                 COUNT_VON_COUNT_BLOCKS);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    }
+
+    status = fbe_api_bvd_interface_clear_peformance_statistics();
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    start_time = fbe_get_time();
+    status = fbe_api_rdgen_start_tests(&rdgen_context[0], FBE_PACKAGE_ID_NEIT, context_count);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    fbe_api_sleep(COUNT_VON_COUNT_RUN_SECONDS * FBE_TIME_MILLISECONDS_PER_SECOND);
+
+    status = fbe_api_bvd_interface_get_peformance_statistics(&perf_stats);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    status = fbe_api_rdgen_stop_tests(&rdgen_context[0], context_count);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    elapsed_msec = fbe_get_elapsed_milliseconds(start_time);
+
+    for (context_index = 0; context_index < context_count; context_index++)
+    {
+        MUT_ASSERT_INT_EQUAL(rdgen_context[context_index].start_io.statistics.error_count, 0);
+        io_count += rdgen_context[context_index].start_io.statistics.io_count;
+        status = fbe_api_rdgen_test_context_destroy(&rdgen_context[context_index]);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    }
+    MUT_ASSERT_TRUE(io_count > 0);
+
+    count_von_count_check_batches(&perf_stats, batch_mode);
+
+    for (core = 0; core < core_count; core++)
+    {
+        wait_time += perf_stats.core_stat[core].runq_stats.transport_run_queue_wait_time_us;
+        wait_count += perf_stats.core_stat[core].runq_stats.transport_run_queue_wait_count;
+        max_wait = FBE_MAX(max_wait, perf_stats.core_stat[core].runq_stats.transport_run_queue_max_wait_us);
+    }
+
+    result_p->iops = (fbe_u32_t)((io_count * FBE_TIME_MILLISECONDS_PER_SECOND) / FBE_MAX(elapsed_msec, 1));
+    result_p->latency_us = (result_p->iops != 0) ? (fbe_u32_t)(((fbe_u64_t)queue_depth * 1000000) / result_p->iops) : 0;
+    result_p->runq_wait_us = (wait_count != 0) ? (fbe_u32_t)(wait_time / wait_count) : 0;
+    result_p->runq_max_wait_us = max_wait;
+
+    mut_printf(MUT_LOG_TEST_STATUS, "   depth %3d: %6d IOPS latency %6d us runq wait avg %4d us max %6d us",
+               queue_depth, result_p->iops, result_p->latency_us, result_p->runq_wait_us, result_p->runq_max_wait_us);
+    return;
+}
+/******************************************
+ * end count_von_count_run_depth()
+ ******************************************/
+
+/*!**************************************************************
+ * count_von_count_test_rg_config()
+ ****************************************************************
+ * @brief
+ *  Measure every queue depth with fixed and with adaptive batching.
+ *
+ * @param rg_config_p - config to run test against.
+ * @param context_p - not used.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void count_von_count_test_rg_config(fbe_test_rg_configuration_t *rg_config_p, void * context_p)
+{
+    fbe_status_t                            status;
+    fbe_object_id_t                         lun_object_id;
+    fbe_u32_t                               depth_index;
+    fbe_transport_run_queue_batch_mode_t    batch_mode;
+    count_von_count_result_t *              fixed_p;
+    count_von_count_result_t *              adaptive_p;
+
+    status = fbe_api_database_lookup_lun_by_number(rg_config_p->logical_unit_configuration_list[0].lun_number, &lun_object_id);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    status = fbe_api_bvd_interface_enable_peformance_statistics();
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    for (batch_mode = FBE_TRANSPORT_RUN_QUEUE_BATCH_MODE_FIXED; batch_mode <= FBE_TRANSPORT_RUN_QUEUE_BATCH_MODE_ADAPTIVE; batch_mode++)
+    {
+        mut_printf(MUT_LOG_TEST_STATUS, "== %s %s batching ==", __FUNCTION__,
+                   (batch_mode == FBE_TRANSPORT_RUN_QUEUE_BATCH_MODE_ADAPTIVE) ? "adaptive" : "fixed");
+
+        status = fbe_api_bvd_interface_set_run_queue_batch_mode(batch_mode);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+        for (depth_index = 0; depth_index < COUNT_VON_COUNT_DEPTH_COUNT; depth_index++)
+        {
+            count_von_count_run_depth(lun_object_id,
+                                      count_von_count_queue_depths[depth_index],
+                                      batch_mode,
+                                      &count_von_count_results[batch_mode][depth_index]);
+        }
+    }
+
+    mut_printf(MUT_LOG_TEST_STATUS, "== %s fixed vs. adaptive ==", __FUNCTION__);
+    for (depth_index = 0; depth_index < COUNT_VON_COUNT_DEPTH_COUNT; depth_index++)
+    {
+        fixed_p = &count_von_count_results[FBE_TRANSPORT_RUN_QUEUE_BATCH_MODE_FIXED][depth_index];
+        adaptive_p = &count_von_count_results[FBE_TRANSPORT_RUN_QUEUE_BATCH_MODE_ADAPTIVE][depth_index];
+        mut_printf(MUT_LOG_TEST_STATUS, "   depth %3d: IOPS %6d / %6d latency %6d / %6d us runq wait %4d / %4d us",
+                   count_von_count_queue_depths[depth_index],
+                   fixed_p->iops, adaptive_p->iops,
+                   fixed_p->latency_us, adaptive_p->latency_us,
+                   fixed_p->runq_wait_us, adaptive_p->runq_wait_us);
+    }
+
+    status = fbe_api_bvd_interface_set_run_queue_batch_mode(FBE_TRANSPORT_RUN_QUEUE_BATCH_MODE_ADAPTIVE);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    status = fbe_api_bvd_interface_disable_peformance_statistics();
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    return;
+}
+/******************************************
+ * end count_von_count_test_rg_config()
+ ******************************************/
+
+/*!**************************************************************
+ * count_von_count_test()
+ ****************************************************************
+ * @brief
+ *  Run the run queue batching comparison.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void count_von_count_test(void)
+{
+    fbe_test_run_test_on_rg_config(&count_von_count_raid_group_config[0], NULL, count_von_count_test_rg_config,
+                                   COUNT_VON_COUNT_LUNS_PER_RAID_GROUP,
+                                   COUNT_VON_COUNT_CHUNKS_PER_LUN);
+    return;
+}
+/******************************************
+ * end count_von_count_test()
+ ******************************************/
+
+/*!**************************************************************
+ * count_von_count_setup()
+ ****************************************************************
+ * @brief
+ *  Setup for the run queue batching comparison.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void count_von_count_setup(void)
+{
+    mut_printf(MUT_LOG_HIGH, "%s entry", __FUNCTION__);
+
+    /* Only load the physical config in simulation.
+     */
+    if (fbe_test_util_is_simulation())
+    {
+        fbe_test_rg_configuration_t *rg_config_p = &count_von_count_raid_group_config[0];
+
+        fbe_test_sep_util_init_rg_configuration_array(rg_config_p);
+        elmo_load_config(rg_config_p,
+                         COUNT_VON_COUNT_LUNS_PER_RAID_GROUP,
+                         COUNT_VON_COUNT_CHUNKS_PER_LUN);
+    }
+
+    /* Initialize any required fields
+     */
+    fbe_test_common_util_test_setup_init();
+    return;
+}
+/**************************************
+ * end count_von_count_setup()
+ **************************************/
+
+/*!**************************************************************
+ * count_von_count_cleanup()
+ ****************************************************************
+ * @brief
+ *  Cleanup the count von count test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void count_von_count_cleanup(void)
+{
+    mut_printf(MUT_LOG_HIGH, "%s entry", __FUNCTION__);
+
+    if (fbe_test_util_is_simulation())
+    {
+        fbe_test_sep_util_destroy_neit_sep_physical();
+    }
+    return;
+}
+/******************************************
+ * end count_von_count_cleanup()
+ ******************************************/
+
+/*************************
+ * end file count_von_count_test.c
+ *************************/
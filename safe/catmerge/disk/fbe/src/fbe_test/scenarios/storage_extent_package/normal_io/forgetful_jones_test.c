@@ -0,0 +1,359 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2009
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!**************************************************************************
+ * @file forgetful_jones_test.c
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains an open loop latency sweep of a LUN.  rdgen issues
+ *  reads at increasing arrival rates until the LUN saturates and we report
+ *  the response time percentiles measured from the scheduled arrival time.
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "mut.h"
+#include "fbe/fbe_api_rdgen_interface.h"
+#include "sep_tests.h"
+#include "fbe/fbe_winddk.h"
+#include "fbe/fbe_api_common.h"
+#include "fbe_test_package_config.h"
+#include "fbe_test_configurations.h"
+#include "sep_utils.h"
+#include "fbe/fbe_api_utils.h"
+#include "fbe/fbe_api_sim_server.h"
+#include "fbe/fbe_api_database_interface.h"
+#include "pp_utils.h"
+#include "fbe_test_common_utils.h"
+
+/*************************
+ *   FUNCTION DEFINITIONS
+ *************************/
+
+char * forgetful_jones_short_desc = "rdgen open loop latency curve of a LUN";
+char * forgetful_jones_long_desc ="\
+The Forgetful Jones scenario pushes a LUN past saturation with open loop (poisson) rdgen I/O.\n\
+\n\
+STEP 1: configure a raid 5 raid group with one LUN.\n\
+\n\
+STEP 2: run random 4K reads at a fixed rate of 100 IOPS.\n\
+        - make sure no more I/Os are issued than were scheduled.\n\
+\n\
+STEP 3: for each arrival rate from 100 to 12800 IOPS\n\
+        - reset the rdgen statistics.\n\
+        - run random 4K reads with poisson arrivals at that rate for a fixed amount of time.\n\
+        - make sure the achieved rate does not exceed the arrival rate.\n\
+        - report the achieved IOPS and the p50/p90/p99/max response times\n\
+          measured from the scheduled arrival of each I/O.\n\
+\n\
+STEP 4: destroy the configuration.\n\
+\n"
+"Description last updated: 10/19/2026.\n";
+
+/*!*******************************************************************
+ * @def FORGETFUL_JONES_LUNS_PER_RAID_GROUP
+ *********************************************************************
+ * @brief Number of LUNs in the raid group.
+ *
+ *********************************************************************/
+#define FORGETFUL_JONES_LUNS_PER_RAID_GROUP 1
+
+/*!*******************************************************************
+ * @def FORGETFUL_JONES_CHUNKS_PER_LUN
+ *********************************************************************
+ * @brief Number of chunks each LUN will occupy.
+ *
+ *********************************************************************/
+#define FORGETFUL_JONES_CHUNKS_PER_LUN 6
+
+/*!*******************************************************************
+ * @def FORGETFUL_JONES_RUN_SECONDS
+ *********************************************************************
+ * @brief How long we run I/O at each arrival rate.
+ *
+ *********************************************************************/
+#define FORGETFUL_JONES_RUN_SECONDS 5
+
+/*!*******************************************************************
+ * @def FORGETFUL_JONES_BLOCKS
+ *********************************************************************
+ * @brief Size of each I/O.
+ *
+ *********************************************************************/
+#define FORGETFUL_JONES_BLOCKS 8
+
+/*!*******************************************************************
+ * @def FORGETFUL_JONES_THREADS
+ *********************************************************************
+ * @brief Most I/Os we allow outstanding.  Once the LUN saturates the
+ *        rest of the backlog waits in rdgen and shows up as latency.
+ *
+ *********************************************************************/
+#define FORGETFUL_JONES_THREADS 32
+
+/*!*******************************************************************
+ * @def FORGETFUL_JONES_FIXED_RATE_IOPS
+ *********************************************************************
+ * @brief Rate of the fixed rate run, well below saturation.
+ *
+ *********************************************************************/
+#define FORGETFUL_JONES_FIXED_RATE_IOPS 100
+
+/*!*******************************************************************
+ * @var forgetful_jones_arrival_iops
+ *********************************************************************
+ * @brief Arrival rates we measure.
+ *
+ *********************************************************************/
+static fbe_u32_t forgetful_jones_arrival_iops[] = {100, 200, 400, 800, 1600, 3200, 6400, 12800};
+
+#define FORGETFUL_JONES_RATE_COUNT (sizeof(forgetful_jones_arrival_iops) / sizeof(forgetful_jones_arrival_iops[0]))
+
+/*!*******************************************************************
+ * @var forgetful_jones_raid_group_config
+ *********************************************************************
+ * @brief Raid group we run I/O to.
+ *
+ *********************************************************************/
+static fbe_test_rg_configuration_t forgetful_jones_raid_group_config[] =
+{
+    /* width,   capacity    raid type,                  class,                  block size      RAID-id.    bandwidth.*/
+    {5,       0xE000,     FBE_RAID_GROUP_TYPE_RAID5,  FBE_CLASS_ID_PARITY,      520,            0,          0},
+    {FBE_U32_MAX, FBE_U32_MAX, FBE_U32_MAX, /* Terminator. */},
+};
+
+/*!**************************************************************
+ * forgetful_jones_run_rate()
+ ****************************************************************
+ * @brief
+ *  Run open loop random reads at one arrival rate and report
+ *  the response time percentiles.
+ *
+ * @param lun_object_id - LUN to run I/O to.
+ * @param arrival_mode - fixed rate or poisson.
+ * @param arrival_iops - target arrival rate.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void forgetful_jones_run_rate(fbe_object_id_t lun_object_id,
+                                     fbe_rdgen_arrival_mode_t arrival_mode,
+                                     fbe_u32_t arrival_iops)
+{
+    fbe_status_t                                status;
+    fbe_api_rdgen_context_t                     rdgen_context;
+    fbe_rdgen_filter_t                          filter;
+    fbe_rdgen_control_get_latency_histogram_t   histogram;
+    fbe_api_rdgen_latency_percentiles_t         percentiles;
+    fbe_time_t                                  start_time;
+    fbe_u32_t                                   elapsed_msec;
+    fbe_u64_t                                   io_count;
+    fbe_u64_t                                   max_io_count;
+
+    status = fbe_api_rdgen_reset_stats();
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    status = fbe_api_rdgen_test_context_init(&rdgen_context,
+                                             lun_object_id,
+                                             FBE_CLASS_ID_INVALID,
+                                             FBE_PACKAGE_ID_SEP_0,
+                                             FBE_RDGEN_OPERATION_READ_ONLY,
+                                             FBE_RDGEN_PATTERN_LBA_PASS,
+                                             0,    /* passes (manual stop) */
+                                             0,    /* io count not used */
+                                             0,    /* time not used */
+                                             FORGETFUL_JONES_THREADS,
+                                             FBE_RDGEN_LBA_SPEC_RANDOM,
+                                             0,    /* start lba */
+                                             0,    /* min lba */
+                                             FBE_LBA_INVALID, /* use capacity */
+                                             FBE_RDGEN_BLOCK_SPEC_CONSTANT,
+                                             FORGETFUL_JONES_BLOCKS,
+                                             FORGETFUL_JONES_BLOCKS);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    status = fbe_api_rdgen_io_specification_set_arrival_rate(&rdgen_context.start_io.specification,
+                                                             arrival_mode,
+                                                             arrival_iops);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    start_time = fbe_get_time();
+    status = fbe_api_rdgen_start_tests(&rdgen_context, FBE_PACKAGE_ID_NEIT, 1);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    fbe_api_sleep(FORGETFUL_JONES_RUN_SECONDS * FBE_TIME_MILLISECONDS_PER_SECOND);
+
+    status = fbe_api_rdgen_stop_tests(&rdgen_context, 1);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    elapsed_msec = fbe_get_elapsed_milliseconds(start_time);
+
+    MUT_ASSERT_INT_EQUAL(rdgen_context.start_io.statistics.error_count, 0);
+    io_count = rdgen_context.start_io.statistics.io_count;
+    MUT_ASSERT_TRUE(io_count > 0);
+
+    /* The I/O count is bounded by the offered load, since no I/O is released
+     * before its arrival.  A fixed rate schedules exactly arrival_iops, allow
+     * for the randomness of poisson arrivals.  Each thread can also have its
+     * first arrival due at the start.
+     */
+    if (arrival_mode == FBE_RDGEN_ARRIVAL_MODE_FIXED_RATE)
+    {
+        max_io_count = ((fbe_u64_t)arrival_iops * elapsed_msec) / FBE_TIME_MILLISECONDS_PER_SECOND + FORGETFUL_JONES_THREADS;
+    }
+    else
+    {
+        max_io_count = ((fbe_u64_t)arrival_iops * elapsed_msec * 3) / (2 * FBE_TIME_MILLISECONDS_PER_SECOND) + FORGETFUL_JONES_THREADS;
+    }
+    MUT_ASSERT_TRUE(io_count <= max_io_count);
+
+    status = fbe_api_rdgen_test_context_destroy(&rdgen_context);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    /* All threads are done, so everything is in the historical histogram.
+     */
+    status = fbe_api_rdgen_filter_init(&filter, FBE_RDGEN_FILTER_TYPE_OBJECT, lun_object_id,
+                                       FBE_CLASS_ID_INVALID, FBE_PACKAGE_ID_SEP_0, 0);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    status = fbe_api_rdgen_get_latency_histogram(&histogram, &filter);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    fbe_api_rdgen_latency_histogram_get_percentiles(&histogram.historical[FBE_RDGEN_LATENCY_TYPE_READ], &percentiles);
+    MUT_ASSERT_TRUE(percentiles.count > 0);
+
+    mut_printf(MUT_LOG_TEST_STATUS, "   arrival %5d IOPS: %6d IOPS p50 %7lld us p90 %7lld us p99 %7lld us max %7lld us",
+               arrival_iops,
+               (int)((io_count * FBE_TIME_MILLISECONDS_PER_SECOND) / FBE_MAX(elapsed_msec, 1)),
+               (long long)percentiles.p50_usec, (long long)percentiles.p90_usec,
+               (long long)percentiles.p99_usec, (long long)percentiles.max_usec);
+    return;
+}
+/******************************************
+ * end forgetful_jones_run_rate()
+ ******************************************/
+
+/*!**************************************************************
+ * forgetful_jones_test_rg_config()
+ ****************************************************************
+ * @brief
+ *  Sweep the arrival rate past the point where the LUN saturates.
+ *
+ * @param rg_config_p - config to run test against.
+ * @param context_p - not used.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void forgetful_jones_test_rg_config(fbe_test_rg_configuration_t *rg_config_p, void * context_p)
+{
+    fbe_status_t    status;
+    fbe_object_id_t lun_object_id;
+    fbe_u32_t       rate_index;
+
+    status = fbe_api_database_lookup_lun_by_number(rg_config_p->logical_unit_configuration_list[0].lun_number, &lun_object_id);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    mut_printf(MUT_LOG_TEST_STATUS, "== %s fixed rate ==", __FUNCTION__);
+    forgetful_jones_run_rate(lun_object_id, FBE_RDGEN_ARRIVAL_MODE_FIXED_RATE, FORGETFUL_JONES_FIXED_RATE_IOPS);
+
+    mut_printf(MUT_LOG_TEST_STATUS, "== %s open loop latency curve ==", __FUNCTION__);
+    for (rate_index = 0; rate_index < FORGETFUL_JONES_RATE_COUNT; rate_index++)
+    {
+        forgetful_jones_run_rate(lun_object_id, FBE_RDGEN_ARRIVAL_MODE_POISSON, forgetful_jones_arrival_iops[rate_index]);
+    }
+    return;
+}
+/******************************************
+ * end forgetful_jones_test_rg_config()
+ ******************************************/
+
+/*!**************************************************************
+ * forgetful_jones_test()
+ ****************************************************************
+ * @brief
+ *  Run the open loop latency sweep.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void forgetful_jones_test(void)
+{
+    fbe_test_run_test_on_rg_config(&forgetful_jones_raid_group_config[0], NULL, forgetful_jones_test_rg_config,
+                                   FORGETFUL_JONES_LUNS_PER_RAID_GROUP,
+                                   FORGETFUL_JONES_CHUNKS_PER_LUN);
+    return;
+}
+/******************************************
+ * end forgetful_jones_test()
+ ******************************************/
+
+/*!**************************************************************
+ * forgetful_jones_setup()
+ ****************************************************************
+ * @brief
+ *  Setup for the open loop latency sweep.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void forgetful_jones_setup(void)
+{
+    mut_printf(MUT_LOG_HIGH, "%s entry", __FUNCTION__);
+
+    /* Only load the physical config in simulation.
+     */
+    if (fbe_test_util_is_simulation())
+    {
+        fbe_test_rg_configuration_t *rg_config_p = &forgetful_jones_raid_group_config[0];
+
+        fbe_test_sep_util_init_rg_configuration_array(rg_config_p);
+        elmo_load_config(rg_config_p,
+                         FORGETFUL_JONES_LUNS_PER_RAID_GROUP,
+                         FORGETFUL_JONES_CHUNKS_PER_LUN);
+    }
+
+    /* Initialize any required fields
+     */
+    fbe_test_common_util_test_setup_init();
+    return;
+}
+/**************************************
+ * end forgetful_jones_setup()
+ **************************************/
+
+/*!**************************************************************
+ * forgetful_jones_cleanup()
+ ****************************************************************
+ * @brief
+ *  Cleanup the forgetful jones test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void forgetful_jones_cleanup(void)
+{
+    mut_printf(MUT_LOG_HIGH, "%s entry", __FUNCTION__);
+
+    if (fbe_test_util_is_simulation())
+    {
+        fbe_test_sep_util_destroy_neit_sep_physical();
+    }
+    return;
+}
+/******************************************
+ * end forgetful_jones_cleanup()
+ ******************************************/
+
+/*************************
+ * end file forgetful_jones_test.c
+ *************************/
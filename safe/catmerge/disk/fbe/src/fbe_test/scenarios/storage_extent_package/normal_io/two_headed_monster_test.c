@@ -0,0 +1,406 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2009
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!**************************************************************************
+ * @file two_headed_monster_test.c
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains a sequential read test of the raid group read-ahead.
+ *  We run the same sequential 8K read stream with read-ahead disabled and
+ *  enabled, check the read-ahead counters and report the bandwidth of both.
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "mut.h"
+#include "fbe/fbe_api_rdgen_interface.h"
+#include "sep_tests.h"
+#include "fbe/fbe_winddk.h"
+#include "fbe/fbe_api_common.h"
+#include "fbe/fbe_api_raid_group_interface.h"
+#include "fbe_test_package_config.h"
+#include "fbe_test_configurations.h"
+#include "sep_utils.h"
+#include "fbe/fbe_api_utils.h"
+#include "fbe/fbe_api_sim_server.h"
+#include "fbe/fbe_api_database_interface.h"
+#include "pp_utils.h"
+#include "fbe_test_common_utils.h"
+
+/*************************
+ *   FUNCTION DEFINITIONS
+ *************************/
+
+char * two_headed_monster_short_desc = "raid group read-ahead of sequential reads";
+char * two_headed_monster_long_desc ="\
+The Two Headed Monster scenario measures the read-ahead of sequential read streams.\n\
+\n\
+STEP 1: configure a raid 5 and a raid 0 raid group with one LUN each.\n\
+\n\
+STEP 2: write a pattern to the entire LUN.\n\
+\n\
+STEP 3: with read-ahead disabled and then enabled\n\
+        - run a single stream of sequential 8K reads for a fixed amount of time.\n\
+        - make sure the data read matches the pattern.\n\
+        - make sure reads are read ahead and completed from the buffers only when read-ahead is enabled.\n\
+        - report the MB/s and IOPS of the stream.\n\
+\n\
+STEP 4: run sequential write/read/check with read-ahead enabled to make sure\n\
+        writes drop the data read ahead.\n\
+\n\
+STEP 5: destroy the configuration.\n\
+\n"
+"Description last updated: 10/19/2026.\n";
+
+/*!*******************************************************************
+ * @def TWO_HEADED_MONSTER_LUNS_PER_RAID_GROUP
+ *********************************************************************
+ * @brief Number of LUNs in each raid group.
+ *
+ *********************************************************************/
+#define TWO_HEADED_MONSTER_LUNS_PER_RAID_GROUP 1
+
+/*!*******************************************************************
+ * @def TWO_HEADED_MONSTER_CHUNKS_PER_LUN
+ *********************************************************************
+ * @brief Number of chunks each LUN will occupy.
+ *
+ *********************************************************************/
+#define TWO_HEADED_MONSTER_CHUNKS_PER_LUN 6
+
+/*!*******************************************************************
+ * @def TWO_HEADED_MONSTER_RUN_SECONDS
+ *********************************************************************
+ * @brief How long we run each sequential read stream.
+ *
+ *********************************************************************/
+#define TWO_HEADED_MONSTER_RUN_SECONDS 10
+
+/*!*******************************************************************
+ * @def TWO_HEADED_MONSTER_BLOCKS
+ *********************************************************************
+ * @brief Size of each read (8K of 520 byte blocks).
+ *
+ *********************************************************************/
+#define TWO_HEADED_MONSTER_BLOCKS 16
+
+/*!*******************************************************************
+ * @def TWO_HEADED_MONSTER_FILL_BLOCKS
+ *********************************************************************
+ * @brief Size of each write when we fill the LUN.
+ *
+ *********************************************************************/
+#define TWO_HEADED_MONSTER_FILL_BLOCKS 0x80
+
+/*!*******************************************************************
+ * @var two_headed_monster_raid_group_config
+ *********************************************************************
+ * @brief Raid groups we run I/O to.
+ *
+ *********************************************************************/
+static fbe_test_rg_configuration_t two_headed_monster_raid_group_config[] =
+{
+    /* width,   capacity    raid type,                  class,                  block size      RAID-id.    bandwidth.*/
+    {5,       0xE000,     FBE_RAID_GROUP_TYPE_RAID5,  FBE_CLASS_ID_PARITY,      520,            0,          0},
+    {3,       0xE000,     FBE_RAID_GROUP_TYPE_RAID0,  FBE_CLASS_ID_STRIPER,     520,            1,          0},
+    {FBE_U32_MAX, FBE_U32_MAX, FBE_U32_MAX, /* Terminator. */},
+};
+
+/*!**************************************************************
+ * two_headed_monster_run_sequential()
+ ****************************************************************
+ * @brief
+ *  Run one pass of sequential I/O over the whole LUN.
+ *
+ * @param lun_object_id - LUN to run I/O to.
+ * @param rdgen_operation - Operation to run.
+ * @param blocks - Size of each I/O.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void two_headed_monster_run_sequential(fbe_object_id_t lun_object_id,
+                                              fbe_rdgen_operation_t rdgen_operation,
+                                              fbe_block_count_t blocks)
+{
+    fbe_status_t            status;
+    fbe_api_rdgen_context_t rdgen_context;
+
+    status = fbe_api_rdgen_test_context_init(&rdgen_context,
+                                             lun_object_id,
+                                             FBE_CLASS_ID_INVALID,
+                                             FBE_PACKAGE_ID_SEP_0,
+                                             rdgen_operation,
+                                             FBE_RDGEN_PATTERN_LBA_PASS,
+                                             1,    /* passes */
+                                             0,    /* io count not used */
+                                             0,    /* time not used */
+                                             1,    /* threads */
+                                             FBE_RDGEN_LBA_SPEC_SEQUENTIAL_INCREASING,
+                                             0,    /* start lba */
+                                             0,    /* min lba */
+                                             FBE_LBA_INVALID, /* use capacity */
+                                             FBE_RDGEN_BLOCK_SPEC_CONSTANT,
+                                             blocks,
+                                             blocks);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    status = fbe_api_rdgen_test_context_run_all_tests(&rdgen_context, FBE_PACKAGE_ID_NEIT, 1);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    MUT_ASSERT_INT_EQUAL(rdgen_context.start_io.statistics.error_count, 0);
+
+    status = fbe_api_rdgen_test_context_destroy(&rdgen_context);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    return;
+}
+/******************************************
+ * end two_headed_monster_run_sequential()
+ ******************************************/
+
+/*!**************************************************************
+ * two_headed_monster_run_stream()
+ ****************************************************************
+ * @brief
+ *  Run a sequential 8K read stream for a fixed time and report
+ *  its bandwidth.
+ *
+ * @param rg_object_id - Raid group of the LUN.
+ * @param lun_object_id - LUN to run I/O to.
+ * @param b_read_ahead - FBE_TRUE to allow read-ahead.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void two_headed_monster_run_stream(fbe_object_id_t rg_object_id,
+                                          fbe_object_id_t lun_object_id,
+                                          fbe_bool_t b_read_ahead)
+{
+    fbe_status_t            status;
+    fbe_api_rdgen_context_t rdgen_context;
+    fbe_time_t              start_time;
+    fbe_u32_t               elapsed_msec;
+    fbe_u64_t               io_count;
+    fbe_u64_t               kb_per_second;
+    fbe_raid_group_get_read_ahead_stats_t start_stats;
+    fbe_raid_group_get_read_ahead_stats_t end_stats;
+
+    status = fbe_api_raid_group_set_group_debug_flags(rg_object_id,
+                                                      (b_read_ahead) ? 0 : FBE_RAID_GROUP_DEBUG_FLAG_DISABLE_READ_AHEAD);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    status = fbe_api_rdgen_test_context_init(&rdgen_context,
+                                             lun_object_id,
+                                             FBE_CLASS_ID_INVALID,
+                                             FBE_PACKAGE_ID_SEP_0,
+                                             FBE_RDGEN_OPERATION_READ_ONLY,
+                                             FBE_RDGEN_PATTERN_LBA_PASS,
+                                             0,    /* passes (manual stop) */
+                                             0,    /* io count not used */
+                                             0,    /* time not used */
+                                             1,    /* threads */
+                                             FBE_RDGEN_LBA_SPEC_SEQUENTIAL_INCREASING,
+                                             0,    /* start lba */
+                                             0,    /* min lba */
+                                             FBE_LBA_INVALID, /* use capacity */
+                                             FBE_RDGEN_BLOCK_SPEC_CONSTANT,
+                                             TWO_HEADED_MONSTER_BLOCKS,
+                                             TWO_HEADED_MONSTER_BLOCKS);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    status = fbe_api_raid_group_get_read_ahead_stats(rg_object_id, &start_stats);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    start_time = fbe_get_time();
+    status = fbe_api_rdgen_start_tests(&rdgen_context, FBE_PACKAGE_ID_NEIT, 1);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    fbe_api_sleep(TWO_HEADED_MONSTER_RUN_SECONDS * FBE_TIME_MILLISECONDS_PER_SECOND);
+
+    status = fbe_api_rdgen_stop_tests(&rdgen_context, 1);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    elapsed_msec = FBE_MAX(fbe_get_elapsed_milliseconds(start_time), 1);
+
+    /* rdgen checks every read against the pattern we wrote.
+     */
+    MUT_ASSERT_INT_EQUAL(rdgen_context.start_io.statistics.error_count, 0);
+    io_count = rdgen_context.start_io.statistics.io_count;
+    MUT_ASSERT_TRUE(io_count > 0);
+
+    status = fbe_api_raid_group_get_read_ahead_stats(rg_object_id, &end_stats);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    end_stats.hit_count -= start_stats.hit_count;
+    end_stats.read_ahead_count -= start_stats.read_ahead_count;
+    mut_printf(MUT_LOG_TEST_STATUS, "   read-ahead %s: %llu read-ahead reads, %llu reads from the buffers",
+               (b_read_ahead) ? "enabled " : "disabled",
+               (unsigned long long)end_stats.read_ahead_count, (unsigned long long)end_stats.hit_count);
+
+    /* A single SP stream of small sequential reads is read ahead and then
+     * found in the buffers.  With read-ahead disabled every read goes to the drives.
+     */
+    if (b_read_ahead)
+    {
+        MUT_ASSERT_TRUE(end_stats.read_ahead_count > 0);
+        MUT_ASSERT_TRUE(end_stats.hit_count > 0);
+        MUT_ASSERT_TRUE(end_stats.hit_count <= io_count);
+    }
+    else
+    {
+        MUT_ASSERT_UINT64_EQUAL(end_stats.read_ahead_count, 0);
+        MUT_ASSERT_UINT64_EQUAL(end_stats.hit_count, 0);
+    }
+
+    kb_per_second = (io_count * TWO_HEADED_MONSTER_BLOCKS * FBE_BE_BYTES_PER_BLOCK) / elapsed_msec;
+    mut_printf(MUT_LOG_TEST_STATUS, "   read-ahead %s: %4lld.%03lld MB/s %6d IOPS",
+               (b_read_ahead) ? "enabled " : "disabled",
+               (long long)(kb_per_second / 1000), (long long)(kb_per_second % 1000),
+               (int)((io_count * FBE_TIME_MILLISECONDS_PER_SECOND) / elapsed_msec));
+
+    status = fbe_api_rdgen_test_context_destroy(&rdgen_context);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    return;
+}
+/******************************************
+ * end two_headed_monster_run_stream()
+ ******************************************/
+
+/*!**************************************************************
+ * two_headed_monster_test_rg_config()
+ ****************************************************************
+ * @brief
+ *  Run the sequential read stream without and with read-ahead on
+ *  each raid group.
+ *
+ * @param rg_config_p - config to run test against.
+ * @param context_p - not used.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void two_headed_monster_test_rg_config(fbe_test_rg_configuration_t *rg_config_p, void * context_p)
+{
+    fbe_status_t    status;
+    fbe_object_id_t rg_object_id;
+    fbe_object_id_t lun_object_id;
+    fbe_u32_t       raid_group_count = fbe_test_get_rg_array_length(rg_config_p);
+    fbe_u32_t       rg_index;
+
+    for (rg_index = 0; rg_index < raid_group_count; rg_index++)
+    {
+        if (!fbe_test_rg_config_is_enabled(&rg_config_p[rg_index]))
+        {
+            continue;
+        }
+        status = fbe_api_database_lookup_raid_group_by_number(rg_config_p[rg_index].raid_group_id, &rg_object_id);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+        status = fbe_api_database_lookup_lun_by_number(rg_config_p[rg_index].logical_unit_configuration_list[0].lun_number,
+                                                       &lun_object_id);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+        mut_printf(MUT_LOG_TEST_STATUS, "== %s raid group 0x%x sequential 8K reads ==", __FUNCTION__, rg_object_id);
+        two_headed_monster_run_sequential(lun_object_id, FBE_RDGEN_OPERATION_WRITE_ONLY, TWO_HEADED_MONSTER_FILL_BLOCKS);
+
+        two_headed_monster_run_stream(rg_object_id, lun_object_id, FBE_FALSE);
+        two_headed_monster_run_stream(rg_object_id, lun_object_id, FBE_TRUE);
+
+        /* Each write lands right where the stream reads ahead.
+         */
+        two_headed_monster_run_sequential(lun_object_id, FBE_RDGEN_OPERATION_WRITE_READ_CHECK, TWO_HEADED_MONSTER_BLOCKS);
+    }
+    return;
+}
+/******************************************
+ * end two_headed_monster_test_rg_config()
+ ******************************************/
+
+/*!**************************************************************
+ * two_headed_monster_test()
+ ****************************************************************
+ * @brief
+ *  Run the sequential read-ahead test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void two_headed_monster_test(void)
+{
+    fbe_test_run_test_on_rg_config(&two_headed_monster_raid_group_config[0], NULL, two_headed_monster_test_rg_config,
+                                   TWO_HEADED_MONSTER_LUNS_PER_RAID_GROUP,
+                                   TWO_HEADED_MONSTER_CHUNKS_PER_LUN);
+    return;
+}
+/******************************************
+ * end two_headed_monster_test()
+ ******************************************/
+
+/*!**************************************************************
+ * two_headed_monster_setup()
+ ****************************************************************
+ * @brief
+ *  Setup for the sequential read-ahead test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void two_headed_monster_setup(void)
+{
+    mut_printf(MUT_LOG_HIGH, "%s entry", __FUNCTION__);
+
+    /* Only load the physical config in simulation.
+     */
+    if (fbe_test_util_is_simulation())
+    {
+        fbe_test_rg_configuration_t *rg_config_p = &two_headed_monster_raid_group_config[0];
+
+        fbe_test_sep_util_init_rg_configuration_array(rg_config_p);
+        elmo_load_config(rg_config_p,
+                         TWO_HEADED_MONSTER_LUNS_PER_RAID_GROUP,
+                         TWO_HEADED_MONSTER_CHUNKS_PER_LUN);
+    }
+
+    /* Initialize any required fields
+     */
+    fbe_test_common_util_test_setup_init();
+    return;
+}
+/**************************************
+ * end two_headed_monster_setup()
+ **************************************/
+
+/*!**************************************************************
+ * two_headed_monster_cleanup()
+ ****************************************************************
+ * @brief
+ *  Cleanup the two headed monster test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void two_headed_monster_cleanup(void)
+{
+    mut_printf(MUT_LOG_HIGH, "%s entry", __FUNCTION__);
+
+    if (fbe_test_util_is_simulation())
+    {
+        fbe_test_sep_util_destroy_neit_sep_physical();
+    }
+    return;
+}
+/******************************************
+ * end two_headed_monster_cleanup()
+ ******************************************/
+
+/*************************
+ * end file two_headed_monster_test.c
+ *************************/
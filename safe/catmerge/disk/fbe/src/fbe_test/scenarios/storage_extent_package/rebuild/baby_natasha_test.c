@@ -0,0 +1,476 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2009
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!**************************************************************************
+ * @file baby_natasha_test.c
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains a test of the rebuild catch up window.  A RAID-6
+ *  drive that comes back a little behind another one catches up to it, so
+ *  both are rebuilt with one read of the other drives.
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "mut.h"
+#include "sep_tests.h"
+#include "sep_rebuild_utils.h"
+#include "sep_hook.h"
+#include "fbe/fbe_winddk.h"
+#include "fbe/fbe_api_common.h"
+#include "fbe_test_package_config.h"
+#include "fbe_test_configurations.h"
+#include "sep_utils.h"
+#include "fbe/fbe_api_utils.h"
+#include "fbe/fbe_api_sim_server.h"
+#include "fbe/fbe_api_database_interface.h"
+#include "fbe/fbe_api_discovery_interface.h"
+#include "fbe/fbe_api_raid_group_interface.h"
+#include "fbe/fbe_api_physical_drive_interface.h"
+#include "fbe/fbe_api_virtual_drive_interface.h"
+#include "fbe/fbe_api_scheduler_interface.h"
+#include "fbe/fbe_api_perfstats_interface.h"
+#include "pp_utils.h"
+#include "fbe_test_common_utils.h"
+
+/*************************
+ *   FUNCTION DEFINITIONS
+ *************************/
+
+char * baby_natasha_short_desc = "RAID-6 double drive rebuild catch up";
+char * baby_natasha_long_desc ="\
+The Baby Natasha scenario tests that a RAID-6 drive which needs a rebuild catches up to another one\n\
+so both are rebuilt with one read of the other drives.\n\
+\n\
+STEP 1: configure a raid 6 raid group with one LUN.\n\
+\n\
+STEP 2: rebuild one drive.\n\
+        - pull one drive and write the whole LUN so every chunk needs a rebuild.\n\
+        - reinsert the drive and wait for the rebuild to finish.\n\
+        - report the time and how many times each stripe was read from the other drives.\n\
+\n\
+STEP 3: rebuild two drives.\n\
+        - pull two drives and write the whole LUN.\n\
+        - reinsert the first drive and hold its rebuild once it gets a little ahead.\n\
+        - reinsert the second drive and validate it catches up to the first checkpoint.\n\
+        - release the rebuild and wait for both rebuilds to finish.\n\
+        - validate each stripe was read from the other drives less than twice.\n\
+        - validate fewer blocks were read than for the single drive rebuild.\n\
+\n\
+STEP 4: destroy the configuration.\n\
+\n"
+"Description last updated: 10/19/2026.\n";
+
+/*!*******************************************************************
+ * @def BABY_NATASHA_LUNS_PER_RAID_GROUP
+ *********************************************************************
+ * @brief Number of LUNs in the raid group.
+ *
+ *********************************************************************/
+#define BABY_NATASHA_LUNS_PER_RAID_GROUP 1
+
+/*!*******************************************************************
+ * @def BABY_NATASHA_CHUNKS_PER_LUN
+ *********************************************************************
+ * @brief Number of chunks each LUN will occupy.
+ *
+ *********************************************************************/
+#define BABY_NATASHA_CHUNKS_PER_LUN 32
+
+/*!*******************************************************************
+ * @def BABY_NATASHA_HEAD_START_CHECKPOINT
+ *********************************************************************
+ * @brief How far the first rebuild gets before the second drive is back.
+ *
+ *********************************************************************/
+#define BABY_NATASHA_HEAD_START_CHECKPOINT 0x1000
+
+/*!*******************************************************************
+ * @var baby_natasha_rdgen_context
+ *********************************************************************
+ * @brief Context used to write the LUN while it is degraded.
+ *
+ *********************************************************************/
+static fbe_api_rdgen_context_t baby_natasha_rdgen_context;
+
+/*!*******************************************************************
+ * @var baby_natasha_raid_group_config
+ *********************************************************************
+ * @brief Raid group we rebuild.
+ *
+ *********************************************************************/
+static fbe_test_rg_configuration_t baby_natasha_raid_group_config[] =
+{
+    /* width,   capacity    raid type,                  class,                  block size      RAID-id.    bandwidth.*/
+    {6,       0xE000,     FBE_RAID_GROUP_TYPE_RAID6,  FBE_CLASS_ID_PARITY,      520,            0,          0},
+    {FBE_U32_MAX, FBE_U32_MAX, FBE_U32_MAX, /* Terminator. */},
+};
+
+extern fbe_u32_t sep_rebuild_utils_number_physical_objects_g;
+
+/*!**************************************************************
+ * baby_natasha_get_blocks_read()
+ ****************************************************************
+ * @brief
+ *  Add up the blocks read from every drive we do not rebuild.
+ *
+ * @param rg_config_p - config to run test against.
+ * @param rebuild_positions - positions we rebuild, not counted.
+ *
+ * @return fbe_u64_t - blocks read on all the other drives.
+ *
+ ****************************************************************/
+static fbe_u64_t baby_natasha_get_blocks_read(fbe_test_rg_configuration_t *rg_config_p,
+                                              fbe_raid_position_bitmask_t rebuild_positions)
+{
+    fbe_status_t                    status;
+    fbe_u32_t                       position;
+    fbe_u32_t                       core;
+    fbe_object_id_t                 pdo_object_id;
+    fbe_pdo_performance_counters_t  pdo_stats;
+    fbe_u64_t                       blocks_read = 0;
+
+    for (position = 0; position < rg_config_p->width; position++)
+    {
+        if ((1 << position) & rebuild_positions)
+        {
+            continue;
+        }
+        status = fbe_api_get_physical_drive_object_id_by_location(rg_config_p->rg_disk_set[position].bus,
+                                                                  rg_config_p->rg_disk_set[position].enclosure,
+                                                                  rg_config_p->rg_disk_set[position].slot,
+                                                                  &pdo_object_id);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+        status = fbe_api_physical_drive_get_perf_stats(pdo_object_id, &pdo_stats);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+        for (core = 0; core < PERFSTATS_CORES_SUPPORTED; core++)
+        {
+            blocks_read += pdo_stats.disk_blocks_read[core];
+        }
+    }
+    return blocks_read;
+}
+/******************************************
+ * end baby_natasha_get_blocks_read()
+ ******************************************/
+
+/*!**************************************************************
+ * baby_natasha_wait_for_catch_up()
+ ****************************************************************
+ * @brief
+ *  The first rebuild is held at the head start.  Wait for the
+ *  second position to rebuild up to the same checkpoint.  Without
+ *  the catch up it stays at 0 until the first rebuild finishes.
+ *
+ * @param rg_config_p - config to run test against.
+ * @param positions - first and second position to rebuild.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void baby_natasha_wait_for_catch_up(fbe_test_rg_configuration_t *rg_config_p,
+                                           fbe_u32_t *positions)
+{
+    fbe_lba_t   first_checkpoint;
+    fbe_lba_t   second_checkpoint;
+    fbe_u32_t   total_time_ms = 0;
+
+    for ( ; ; )
+    {
+        sep_rebuild_utils_get_reb_checkpoint(rg_config_p, positions[0], &first_checkpoint);
+        sep_rebuild_utils_get_reb_checkpoint(rg_config_p, positions[1], &second_checkpoint);
+        if (second_checkpoint == first_checkpoint)
+        {
+            break;
+        }
+        if (total_time_ms >= FBE_TEST_WAIT_TIMEOUT_MS)
+        {
+            mut_printf(MUT_LOG_TEST_STATUS, "second checkpoint 0x%llx did not catch up to 0x%llx",
+                       (unsigned long long)second_checkpoint, (unsigned long long)first_checkpoint);
+            MUT_FAIL();
+        }
+        fbe_api_sleep(500);
+        total_time_ms += 500;
+    }
+    MUT_ASSERT_TRUE(second_checkpoint >= BABY_NATASHA_HEAD_START_CHECKPOINT);
+    return;
+}
+/******************************************
+ * end baby_natasha_wait_for_catch_up()
+ ******************************************/
+
+/*!**************************************************************
+ * baby_natasha_rebuild()
+ ****************************************************************
+ * @brief
+ *  Pull the drives, make every chunk need a rebuild, put the drives
+ *  back one after the other and count what the rebuild read.
+ *
+ * @param rg_config_p - config to run test against.
+ * @param positions - positions to pull.
+ * @param position_count - number of positions to pull.
+ * @param blocks_read_p - blocks the rebuild read from the other drives.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void baby_natasha_rebuild(fbe_test_rg_configuration_t *rg_config_p,
+                                 fbe_u32_t *positions,
+                                 fbe_u32_t position_count,
+                                 fbe_u64_t *blocks_read_p)
+{
+    fbe_status_t                        status;
+    fbe_object_id_t                     rg_object_id;
+    fbe_api_raid_group_get_info_t       rg_info;
+    fbe_api_terminator_device_handle_t  drive_info[2];
+    fbe_raid_position_bitmask_t         rebuild_positions = 0;
+    fbe_u32_t                           index;
+    fbe_u64_t                           start_blocks_read;
+    fbe_u64_t                           blocks_read;
+    fbe_u64_t                           stripe_blocks;
+    fbe_time_t                          start_time;
+    fbe_u32_t                           elapsed_msec;
+
+    status = fbe_api_database_lookup_raid_group_by_number(rg_config_p->raid_group_id, &rg_object_id);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    status = fbe_api_raid_group_get_info(rg_object_id, &rg_info, FBE_PACKET_FLAG_NO_ATTRIB);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    /* Pull the drives and write everything, so the whole raid group needs a rebuild.
+     */
+    for (index = 0; index < position_count; index++)
+    {
+        rebuild_positions |= (1 << positions[index]);
+        sep_rebuild_utils_number_physical_objects_g -= 1;
+        sep_rebuild_utils_remove_drive_and_verify(rg_config_p, positions[index], sep_rebuild_utils_number_physical_objects_g, &drive_info[index]);
+    }
+    sep_rebuild_utils_write_bg_pattern(&baby_natasha_rdgen_context, SEP_REBUILD_UTILS_ELEMENT_SIZE);
+
+    /* Hold the first rebuild once it gets a little ahead, so the second drive starts behind it.
+     */
+    if (position_count > 1)
+    {
+        status = fbe_api_scheduler_add_debug_hook(rg_object_id,
+                                                  SCHEDULER_MONITOR_STATE_RAID_GROUP_REBUILD,
+                                                  FBE_RAID_GROUP_SUBSTATE_REBUILD_ENTRY,
+                                                  BABY_NATASHA_HEAD_START_CHECKPOINT,
+                                                  NULL,
+                                                  SCHEDULER_CHECK_VALS_LT,
+                                                  SCHEDULER_DEBUG_ACTION_PAUSE);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    }
+
+    start_blocks_read = baby_natasha_get_blocks_read(rg_config_p, rebuild_positions);
+    start_time = fbe_get_time();
+
+    sep_rebuild_utils_number_physical_objects_g += 1;
+    sep_rebuild_utils_reinsert_drive_and_verify(rg_config_p, positions[0], sep_rebuild_utils_number_physical_objects_g, &drive_info[0]);
+
+    if (position_count > 1)
+    {
+        status = fbe_test_wait_for_debug_hook(rg_object_id,
+                                              SCHEDULER_MONITOR_STATE_RAID_GROUP_REBUILD,
+                                              FBE_RAID_GROUP_SUBSTATE_REBUILD_ENTRY,
+                                              SCHEDULER_CHECK_VALS_LT,
+                                              SCHEDULER_DEBUG_ACTION_PAUSE,
+                                              BABY_NATASHA_HEAD_START_CHECKPOINT,
+                                              NULL);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+        for (index = 1; index < position_count; index++)
+        {
+            sep_rebuild_utils_number_physical_objects_g += 1;
+            sep_rebuild_utils_reinsert_drive_and_verify(rg_config_p, positions[index], sep_rebuild_utils_number_physical_objects_g, &drive_info[index]);
+        }
+        sep_rebuild_utils_wait_for_rb_logging_clear(rg_config_p);
+
+        /* The second drive is within the catch up window, so it rebuilds up to the first.
+         */
+        baby_natasha_wait_for_catch_up(rg_config_p, positions);
+
+        status = fbe_api_scheduler_del_debug_hook(rg_object_id,
+                                                  SCHEDULER_MONITOR_STATE_RAID_GROUP_REBUILD,
+                                                  FBE_RAID_GROUP_SUBSTATE_REBUILD_ENTRY,
+                                                  BABY_NATASHA_HEAD_START_CHECKPOINT,
+                                                  NULL,
+                                                  SCHEDULER_CHECK_VALS_LT,
+                                                  SCHEDULER_DEBUG_ACTION_PAUSE);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    }
+
+    for (index = 0; index < position_count; index++)
+    {
+        sep_rebuild_utils_wait_for_rb_comp(rg_config_p, positions[index]);
+    }
+    elapsed_msec = fbe_get_elapsed_milliseconds(start_time);
+    blocks_read = baby_natasha_get_blocks_read(rg_config_p, rebuild_positions) - start_blocks_read;
+
+    sep_rebuild_utils_check_bits(rg_object_id);
+    sep_rebuild_utils_read_bg_pattern(&baby_natasha_rdgen_context, SEP_REBUILD_UTILS_ELEMENT_SIZE);
+
+    /* Each drive we read holds raid capacity / data disks blocks of every stripe.
+     */
+    stripe_blocks = (rg_info.raid_capacity / rg_info.num_data_disk) * (rg_config_p->width - position_count);
+    mut_printf(MUT_LOG_TEST_STATUS, "   %d drive rebuild: %d msec, %lld blocks read, %lld.%02lld reads per stripe",
+               position_count, elapsed_msec, (long long)blocks_read,
+               (long long)(blocks_read / FBE_MAX(stripe_blocks, 1)),
+               (long long)(((blocks_read % FBE_MAX(stripe_blocks, 1)) * 100) / FBE_MAX(stripe_blocks, 1)));
+
+    /* Every stripe is read at least once.  With the catch up both drives are rebuilt 
+     * by the same pass, so no stripe is read a second time.
+     */
+    MUT_ASSERT_TRUE(blocks_read >= stripe_blocks);
+    MUT_ASSERT_TRUE(blocks_read < 2 * stripe_blocks);
+
+    *blocks_read_p = blocks_read;
+    return;
+}
+/******************************************
+ * end baby_natasha_rebuild()
+ ******************************************/
+
+/*!**************************************************************
+ * baby_natasha_test_rg_config()
+ ****************************************************************
+ * @brief
+ *  Rebuild one drive and then two, and make sure the two drive
+ *  rebuild read less than the single drive rebuild.
+ *
+ * @param rg_config_p - config to run test against.
+ * @param context_p - not used.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void baby_natasha_test_rg_config(fbe_test_rg_configuration_t *rg_config_p, void * context_p)
+{
+    fbe_status_t    status;
+    fbe_u32_t       positions[2] = {SEP_REBUILD_UTILS_POSITION_0, SEP_REBUILD_UTILS_POSITION_1};
+    fbe_u64_t       one_drive_blocks_read;
+    fbe_u64_t       two_drive_blocks_read;
+
+    status = fbe_api_get_total_objects(&sep_rebuild_utils_number_physical_objects_g, FBE_PACKAGE_ID_PHYSICAL);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    /* We reinsert the same drives, so don't let a spare swap in.
+     */
+    status = fbe_api_control_automatic_hot_spare(FBE_FALSE);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    status = fbe_api_perfstats_enable_statistics_for_package(FBE_PACKAGE_ID_PHYSICAL);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    mut_printf(MUT_LOG_TEST_STATUS, "== %s raid 6 width %d ==", __FUNCTION__, rg_config_p->width);
+    baby_natasha_rebuild(rg_config_p, positions, 1, &one_drive_blocks_read);
+    baby_natasha_rebuild(rg_config_p, positions, 2, &two_drive_blocks_read);
+
+    /* Two drives rebuilt in one pass read one less drive per stripe than a single drive rebuild.
+     */
+    MUT_ASSERT_TRUE(two_drive_blocks_read < one_drive_blocks_read);
+
+    status = fbe_api_perfstats_disable_statistics_for_package(FBE_PACKAGE_ID_PHYSICAL);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    status = fbe_api_control_automatic_hot_spare(FBE_TRUE);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    return;
+}
+/******************************************
+ * end baby_natasha_test_rg_config()
+ ******************************************/
+
+/*!**************************************************************
+ * baby_natasha_test()
+ ****************************************************************
+ * @brief
+ *  Run the double drive rebuild test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void baby_natasha_test(void)
+{
+    fbe_test_run_test_on_rg_config(&baby_natasha_raid_group_config[0], NULL, baby_natasha_test_rg_config,
+                                   BABY_NATASHA_LUNS_PER_RAID_GROUP,
+                                   BABY_NATASHA_CHUNKS_PER_LUN);
+    return;
+}
+/******************************************
+ * end baby_natasha_test()
+ ******************************************/
+
+/*!**************************************************************
+ * baby_natasha_setup()
+ ****************************************************************
+ * @brief
+ *  Setup for the double drive rebuild test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void baby_natasha_setup(void)
+{
+    fbe_scheduler_debug_hook_t hook;
+
+    mut_printf(MUT_LOG_HIGH, "%s entry", __FUNCTION__);
+
+    /* Only load the physical config in simulation.
+     */
+    if (fbe_test_util_is_simulation())
+    {
+        fbe_test_rg_configuration_t *rg_config_p = &baby_natasha_raid_group_config[0];
+
+        fbe_test_sep_util_init_rg_configuration_array(rg_config_p);
+        elmo_load_config(rg_config_p,
+                         BABY_NATASHA_LUNS_PER_RAID_GROUP,
+                         BABY_NATASHA_CHUNKS_PER_LUN);
+    }
+    fbe_api_scheduler_clear_all_debug_hooks(&hook);
+
+    /* Initialize any required fields
+     */
+    fbe_test_common_util_test_setup_init();
+    return;
+}
+/**************************************
+ * end baby_natasha_setup()
+ **************************************/
+
+/*!**************************************************************
+ * baby_natasha_cleanup()
+ ****************************************************************
+ * @brief
+ *  Cleanup the baby natasha test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void baby_natasha_cleanup(void)
+{
+    mut_printf(MUT_LOG_HIGH, "%s entry", __FUNCTION__);
+
+    if (fbe_test_util_is_simulation())
+    {
+        fbe_test_sep_util_destroy_neit_sep_physical();
+    }
+    return;
+}
+/******************************************
+ * end baby_natasha_cleanup()
+ ******************************************/
+
+/*************************
+ * end file baby_natasha_test.c
+ *************************/
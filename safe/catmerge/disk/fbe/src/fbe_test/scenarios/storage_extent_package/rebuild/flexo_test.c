@@ -39,6 +39,7 @@
 #include "fbe/fbe_random.h"                         //  for fbe_random()
 #include "fbe_test_common_utils.h"                  //  for discovering config
 #include "fbe/fbe_api_scheduler_interface.h"
+#include "sep_hook.h"
 #include "fbe/fbe_api_base_config_interface.h"
 #include "fbe/fbe_api_lun_interface.h"
 
@@ -720,6 +721,7 @@ static void flexo_test_dual_rebuilds_second_during_first(
 	fbe_scheduler_debug_hook_t          hook;
 	fbe_lba_t                           target_checkpoint[FLEXO_TEST_CONFIGS][FLEXO_NUM_DISKS_TO_REMOVE];
 	fbe_lba_t                           checkpoint;
+	fbe_lba_t                           first_checkpoint;
 	fbe_test_rg_configuration_t*        rg_config_p;
 
     //  Print message as to where the test is at
@@ -883,9 +885,24 @@ static void flexo_test_dual_rebuilds_second_during_first(
 		rg_config_p = in_rg_config_p;
 		for (rg_index = 0; rg_index < FLEXO_TEST_CONFIGS; rg_index++)
 		{
+			/* The second position is within the catch up window of the first, so it is
+			 * rebuilt first until it reaches the first.  After that both are rebuilt
+			 * together and the 2nd hook stops them at the same checkpoint.
+			 */
+			status = fbe_test_wait_for_debug_hook(raid_group_object_id[rg_index],
+												  SCHEDULER_MONITOR_STATE_RAID_GROUP_REBUILD,
+												  FBE_RAID_GROUP_SUBSTATE_REBUILD_ENTRY,
+												  SCHEDULER_CHECK_VALS_LT,
+												  SCHEDULER_DEBUG_ACTION_PAUSE,
+												  target_checkpoint[rg_index][1],
+												  NULL);
+			MUT_ASSERT_INT_EQUAL(status, FBE_STATUS_OK);
+
+			sep_rebuild_utils_get_reb_checkpoint(rg_config_p, drive_slots_to_be_removed[rg_index][0], &first_checkpoint);
 			sep_rebuild_utils_get_reb_checkpoint(rg_config_p, drive_slots_to_be_removed[rg_index][1], &checkpoint);
 
-			MUT_ASSERT_UINT64_EQUAL(checkpoint, 0);
+			MUT_ASSERT_UINT64_EQUAL(first_checkpoint, checkpoint);
+			MUT_ASSERT_TRUE(checkpoint >= target_checkpoint[rg_index][1]);
 
 			mut_printf(MUT_LOG_TEST_STATUS, "Getting 2nd Debug Hook...");
 
@@ -992,7 +1009,6 @@ static void flexo_test_dual_rebuilds_second_during_first_hs(
 	fbe_object_id_t                     raid_group_object_id[FLEXO_TEST_CONFIGS];
 	fbe_scheduler_debug_hook_t          hook;
 	fbe_lba_t                           target_checkpoint[FLEXO_TEST_CONFIGS][FLEXO_NUM_DISKS_TO_REMOVE];
-	fbe_lba_t                           checkpoint;
 	fbe_test_rg_configuration_t*        rg_config_p;
     fbe_raid_position_t rebuilding_position;
     fbe_raid_position_t second_rebuild_position[FLEXO_TEST_CONFIGS];
@@ -1188,12 +1204,11 @@ static void flexo_test_dual_rebuilds_second_during_first_hs(
             /* Wait for first rebuild to finish.
              */
             sep_rebuild_utils_wait_for_rb_comp(rg_config_p, first_rebuild_position[rg_index]);
-            /* Because of the second debug hook the second rebuild cannot start.
-             * Validate the checkpoint is still 0. 
+            /* The second position is within the catch up window of the first, so it
+             * catches up and both are rebuilt together.  The raid group is never singly
+             * degraded, so the second rebuild finishes with the first even with the 2nd hook.
              */
-			sep_rebuild_utils_get_reb_checkpoint(rg_config_p, second_rebuild_position[rg_index], &checkpoint);
-
-			MUT_ASSERT_UINT64_EQUAL(checkpoint, 0);
+            sep_rebuild_utils_wait_for_rb_comp(rg_config_p, second_rebuild_position[rg_index]);
 
 			mut_printf(MUT_LOG_TEST_STATUS, "Getting 2nd Debug Hook...");
 
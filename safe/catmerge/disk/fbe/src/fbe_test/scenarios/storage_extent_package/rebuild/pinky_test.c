@@ -0,0 +1,420 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2009
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!**************************************************************************
+ * @file pinky_test.c
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains a rebuild throughput test.  We rebuild the same raid
+ *  group with one rebuild I/O at a time and with concurrent rebuild I/Os,
+ *  with host I/O running, and report the rebuild rate and the host response
+ *  time of both.
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "sep_rebuild_utils.h"
+#include "mut.h"
+#include "fbe/fbe_api_rdgen_interface.h"
+#include "sep_tests.h"
+#include "sep_test_io.h"
+#include "fbe/fbe_api_common.h"
+#include "fbe/fbe_api_raid_group_interface.h"
+#include "fbe/fbe_api_terminator_interface.h"
+#include "fbe/fbe_api_discovery_interface.h"
+#include "fbe_test_package_config.h"
+#include "fbe_test_configurations.h"
+#include "sep_utils.h"
+#include "fbe/fbe_api_utils.h"
+#include "fbe/fbe_api_database_interface.h"
+#include "pp_utils.h"
+#include "fbe_test_common_utils.h"
+
+/*************************
+ *   FUNCTION DEFINITIONS
+ *************************/
+
+char * pinky_short_desc = "concurrent adaptive rebuild I/O throughput";
+char * pinky_long_desc ="\
+The Pinky scenario measures the rebuild rate with concurrent rebuild I/Os.\n\
+\n\
+STEP 1: configure a raid 5 raid group and slow down every drive I/O in the terminator.\n\
+\n\
+STEP 2: with one rebuild I/O at a time\n\
+        - remove a drive and write the whole LUN so that every chunk needs a rebuild.\n\
+        - start random host reads and re-insert the drive.\n\
+        - wait for the rebuild to complete.\n\
+        - report the rebuild MB/s and the average host response time.\n\
+        - read back and check the data.\n\
+        - make sure a single rebuild I/O never issued concurrent rebuild I/Os.\n\
+\n\
+STEP 3: rebuild again with the default concurrent rebuild I/Os and no host I/O.\n\
+        - make sure the rebuild ramped up to concurrent rebuild I/Os.\n\
+        - make sure the rebuild queue depth grew past one I/O.\n\
+        - read back and check the data.\n\
+\n\
+STEP 4: rebuild again with the default concurrent rebuild I/Os and host reads.\n\
+        - make sure the rebuild queue depth and I/O size dropped below the idle rebuild.\n\
+        - read back and check the data.\n\
+\n\
+STEP 5: destroy the configuration.\n\
+\n"
+"Description last updated: 10/19/2026.\n";
+
+/*!*******************************************************************
+ * @def PINKY_LUNS_PER_RAID_GROUP
+ *********************************************************************
+ * @brief Number of LUNs in each raid group.
+ *
+ *********************************************************************/
+#define PINKY_LUNS_PER_RAID_GROUP 1
+
+/*!*******************************************************************
+ * @def PINKY_CHUNKS_PER_LUN
+ *********************************************************************
+ * @brief Number of chunks each LUN will occupy.
+ *
+ *********************************************************************/
+#define PINKY_CHUNKS_PER_LUN 40
+
+/*!*******************************************************************
+ * @def PINKY_DRIVE_DELAY_MS
+ *********************************************************************
+ * @brief Milliseconds the terminator delays the completion of every
+ *        drive I/O, so that drive latency dominates the rebuild.
+ *
+ *********************************************************************/
+#define PINKY_DRIVE_DELAY_MS 2
+
+/*!*******************************************************************
+ * @def PINKY_HOST_THREADS
+ *********************************************************************
+ * @brief Number of rdgen threads of host reads during the rebuild.
+ *
+ *********************************************************************/
+#define PINKY_HOST_THREADS 2
+
+/*!*******************************************************************
+ * @def PINKY_HOST_BLOCKS
+ *********************************************************************
+ * @brief Size of each host read (8K of 520 byte blocks).
+ *
+ *********************************************************************/
+#define PINKY_HOST_BLOCKS 16
+
+/*!*******************************************************************
+ * @def PINKY_DEFAULT_CONCURRENT_IOS
+ *********************************************************************
+ * @brief Default number of rebuild I/Os a raid group has in flight.
+ *
+ *********************************************************************/
+#define PINKY_DEFAULT_CONCURRENT_IOS 4
+
+/*!*******************************************************************
+ * @def PINKY_REMOVED_POSITION
+ *********************************************************************
+ * @brief Position of the drive we rebuild.
+ *
+ *********************************************************************/
+#define PINKY_REMOVED_POSITION 0
+
+/*!*******************************************************************
+ * @var pinky_raid_group_config
+ *********************************************************************
+ * @brief Raid group we rebuild.
+ *
+ *********************************************************************/
+static fbe_test_rg_configuration_t pinky_raid_group_config[] =
+{
+    /* width,   capacity    raid type,                  class,                  block size      RAID-id.    bandwidth.*/
+    {5,       0x32000,    FBE_RAID_GROUP_TYPE_RAID5,  FBE_CLASS_ID_PARITY,      520,            0,          0},
+    {FBE_U32_MAX, FBE_U32_MAX, FBE_U32_MAX, /* Terminator. */},
+};
+
+/*!*******************************************************************
+ * @var pinky_test_context_g
+ *********************************************************************
+ * @brief Context for the background pattern of the LUN.
+ *
+ *********************************************************************/
+static fbe_api_rdgen_context_t pinky_test_context_g[PINKY_LUNS_PER_RAID_GROUP];
+
+/*! Physical object count the rebuild utilities verify drive removal against. */
+extern fbe_u32_t sep_rebuild_utils_number_physical_objects_g;
+
+/*!**************************************************************
+ * pinky_rebuild_one_drive()
+ ****************************************************************
+ * @brief
+ *  Rebuild the whole user area of one drive, optionally with host
+ *  reads running, and report the rebuild rate and host response
+ *  time.
+ *
+ * @param rg_config_p - raid group to rebuild.
+ * @param lun_object_id - LUN to run host I/O to.
+ * @param max_concurrent_ios - rebuild I/Os in flight per raid group.
+ * @param b_host_io - FBE_TRUE to run host reads during the rebuild.
+ * @param queue_depth_p - rebuild I/Os issued together at the end.
+ * @param op_chunks_p - chunks per rebuild I/O at the end.
+ *
+ * @return fbe_u32_t - Rebuild requests issued as concurrent I/Os.
+ *
+ ****************************************************************/
+static fbe_u32_t pinky_rebuild_one_drive(fbe_test_rg_configuration_t *rg_config_p,
+                                         fbe_object_id_t lun_object_id,
+                                         fbe_u32_t max_concurrent_ios,
+                                         fbe_bool_t b_host_io,
+                                         fbe_u32_t *queue_depth_p,
+                                         fbe_u32_t *op_chunks_p)
+{
+    fbe_status_t                        status;
+    fbe_object_id_t                     rg_object_id;
+    fbe_api_raid_group_get_info_t       rg_info;
+    fbe_api_terminator_device_handle_t  drive_info;
+    fbe_api_rdgen_context_t             rdgen_context;
+    fbe_time_t                          start_time;
+    fbe_u32_t                           elapsed_msec;
+    fbe_u64_t                           io_count;
+    fbe_u64_t                           kb_per_second;
+    fbe_u32_t                           avg_response_us = 0;
+    fbe_u32_t                           concurrent_requests;
+
+    status = fbe_api_raid_group_set_max_concurrent_rebuild_ios(max_concurrent_ios);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    status = fbe_api_database_lookup_raid_group_by_number(rg_config_p->raid_group_id, &rg_object_id);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    /* Writing the whole LUN while degraded marks every chunk for rebuild.
+     */
+    status = fbe_api_get_total_objects(&sep_rebuild_utils_number_physical_objects_g, FBE_PACKAGE_ID_PHYSICAL);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    sep_rebuild_utils_number_physical_objects_g -= 1;
+    sep_rebuild_utils_remove_drive_and_verify(rg_config_p, PINKY_REMOVED_POSITION,
+                                              sep_rebuild_utils_number_physical_objects_g, &drive_info);
+    sep_rebuild_utils_verify_rb_logging(rg_config_p, PINKY_REMOVED_POSITION, &drive_info);
+    sep_rebuild_utils_write_bg_pattern(&pinky_test_context_g[0], SEP_REBUILD_UTILS_ELEMENT_SIZE);
+
+    status = fbe_api_raid_group_get_info(rg_object_id, &rg_info, FBE_PACKET_FLAG_NO_ATTRIB);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    concurrent_requests = rg_info.rebuild_concurrent_request_count;
+
+    status = fbe_api_rdgen_test_context_init(&rdgen_context,
+                                             lun_object_id,
+                                             FBE_CLASS_ID_INVALID,
+                                             FBE_PACKAGE_ID_SEP_0,
+                                             FBE_RDGEN_OPERATION_READ_ONLY,
+                                             FBE_RDGEN_PATTERN_LBA_PASS,
+                                             0,    /* passes (manual stop) */
+                                             0,    /* io count not used */
+                                             0,    /* time not used */
+                                             PINKY_HOST_THREADS,
+                                             FBE_RDGEN_LBA_SPEC_RANDOM,
+                                             0,    /* start lba */
+                                             0,    /* min lba */
+                                             FBE_LBA_INVALID, /* use capacity */
+                                             FBE_RDGEN_BLOCK_SPEC_CONSTANT,
+                                             PINKY_HOST_BLOCKS,
+                                             PINKY_HOST_BLOCKS);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    if (b_host_io)
+    {
+        status = fbe_api_rdgen_start_tests(&rdgen_context, FBE_PACKAGE_ID_NEIT, 1);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    }
+
+    start_time = fbe_get_time();
+    sep_rebuild_utils_number_physical_objects_g += 1;
+    sep_rebuild_utils_reinsert_drive_and_verify(rg_config_p, PINKY_REMOVED_POSITION,
+                                                sep_rebuild_utils_number_physical_objects_g, &drive_info);
+    sep_rebuild_utils_wait_for_rb_comp(rg_config_p, PINKY_REMOVED_POSITION);
+    elapsed_msec = FBE_MAX(fbe_get_elapsed_milliseconds(start_time), 1);
+
+    if (b_host_io)
+    {
+        status = fbe_api_rdgen_stop_tests(&rdgen_context, 1);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+        MUT_ASSERT_INT_EQUAL(rdgen_context.start_io.statistics.error_count, 0);
+        io_count = FBE_MAX(rdgen_context.start_io.statistics.io_count, 1);
+
+        /* Each host thread has one read outstanding at a time.
+         */
+        avg_response_us = (fbe_u32_t)(((fbe_u64_t)elapsed_msec * 1000 * PINKY_HOST_THREADS) / io_count);
+    }
+
+    status = fbe_api_raid_group_get_info(rg_object_id, &rg_info, FBE_PACKET_FLAG_NO_ATTRIB);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    concurrent_requests = rg_info.rebuild_concurrent_request_count - concurrent_requests;
+    *queue_depth_p = rg_info.rebuild_queue_depth;
+    *op_chunks_p = rg_info.rebuild_op_chunks;
+    kb_per_second = (rg_info.imported_blocks_per_disk * FBE_BE_BYTES_PER_BLOCK) / elapsed_msec;
+    mut_printf(MUT_LOG_TEST_STATUS, "   %d rebuild ios: rebuilt 0x%llx blocks in %d ms %4lld.%03lld MB/s host response %d us concurrent requests %d depth %d chunks %d",
+               max_concurrent_ios, (unsigned long long)rg_info.imported_blocks_per_disk, elapsed_msec,
+               (long long)(kb_per_second / 1000), (long long)(kb_per_second % 1000), avg_response_us,
+               concurrent_requests, rg_info.rebuild_queue_depth, rg_info.rebuild_op_chunks);
+
+    status = fbe_api_rdgen_test_context_destroy(&rdgen_context);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    sep_rebuild_utils_read_bg_pattern(&pinky_test_context_g[0], SEP_REBUILD_UTILS_ELEMENT_SIZE);
+    return concurrent_requests;
+}
+/******************************************
+ * end pinky_rebuild_one_drive()
+ ******************************************/
+
+/*!**************************************************************
+ * pinky_test_rg_config()
+ ****************************************************************
+ * @brief
+ *  Rebuild the raid group with one and with concurrent rebuild
+ *  I/Os.
+ *
+ * @param rg_config_p - config to run test against.
+ * @param context_p - not used.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void pinky_test_rg_config(fbe_test_rg_configuration_t *rg_config_p, void * context_p)
+{
+    fbe_status_t    status;
+    fbe_object_id_t lun_object_id;
+    fbe_u32_t       concurrent_requests;
+    fbe_u32_t       idle_queue_depth;
+    fbe_u32_t       idle_op_chunks;
+    fbe_u32_t       host_queue_depth;
+    fbe_u32_t       host_op_chunks;
+
+    status = fbe_api_database_lookup_lun_by_number(rg_config_p->logical_unit_configuration_list[0].lun_number,
+                                                   &lun_object_id);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    status = fbe_api_terminator_set_io_global_completion_delay(PINKY_DRIVE_DELAY_MS);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    mut_printf(MUT_LOG_TEST_STATUS, "== %s rebuild with %d ms drive latency ==", __FUNCTION__, PINKY_DRIVE_DELAY_MS);
+    concurrent_requests = pinky_rebuild_one_drive(rg_config_p, lun_object_id, 1, FBE_TRUE,
+                                                  &host_queue_depth, &host_op_chunks);
+    MUT_ASSERT_INT_EQUAL(0, concurrent_requests);
+    MUT_ASSERT_INT_EQUAL(1, host_queue_depth);
+
+    /* Without host I/O the fast drives let the rebuild ramp up to concurrent I/Os.
+     */
+    concurrent_requests = pinky_rebuild_one_drive(rg_config_p, lun_object_id, PINKY_DEFAULT_CONCURRENT_IOS, FBE_FALSE,
+                                                  &idle_queue_depth, &idle_op_chunks);
+    MUT_ASSERT_TRUE(concurrent_requests > 0);
+    MUT_ASSERT_TRUE(idle_queue_depth > 1);
+    MUT_ASSERT_TRUE(idle_queue_depth <= PINKY_DEFAULT_CONCURRENT_IOS);
+
+    /* Host I/O makes the rebuild give back the depth and size it gained while idle.
+     */
+    pinky_rebuild_one_drive(rg_config_p, lun_object_id, PINKY_DEFAULT_CONCURRENT_IOS, FBE_TRUE,
+                            &host_queue_depth, &host_op_chunks);
+    MUT_ASSERT_TRUE(host_queue_depth <= idle_queue_depth);
+    MUT_ASSERT_TRUE(host_op_chunks <= idle_op_chunks);
+    MUT_ASSERT_TRUE((host_queue_depth * host_op_chunks) < (idle_queue_depth * idle_op_chunks));
+
+    status = fbe_api_terminator_set_io_global_completion_delay(0);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    return;
+}
+/******************************************
+ * end pinky_test_rg_config()
+ ******************************************/
+
+/*!**************************************************************
+ * pinky_test()
+ ****************************************************************
+ * @brief
+ *  Run the rebuild throughput test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void pinky_test(void)
+{
+    fbe_test_run_test_on_rg_config(&pinky_raid_group_config[0], NULL, pinky_test_rg_config,
+                                   PINKY_LUNS_PER_RAID_GROUP,
+                                   PINKY_CHUNKS_PER_LUN);
+    return;
+}
+/******************************************
+ * end pinky_test()
+ ******************************************/
+
+/*!**************************************************************
+ * pinky_setup()
+ ****************************************************************
+ * @brief
+ *  Setup for the rebuild throughput test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void pinky_setup(void)
+{
+    mut_printf(MUT_LOG_HIGH, "%s entry", __FUNCTION__);
+
+    /* Only load the physical config in simulation.
+     */
+    if (fbe_test_util_is_simulation())
+    {
+        fbe_test_rg_configuration_t *rg_config_p = &pinky_raid_group_config[0];
+
+        fbe_test_sep_util_init_rg_configuration_array(rg_config_p);
+        elmo_load_config(rg_config_p,
+                         PINKY_LUNS_PER_RAID_GROUP,
+                         PINKY_CHUNKS_PER_LUN);
+    }
+
+    /* Initialize any required fields
+     */
+    fbe_test_common_util_test_setup_init();
+    return;
+}
+/**************************************
+ * end pinky_setup()
+ **************************************/
+
+/*!**************************************************************
+ * pinky_cleanup()
+ ****************************************************************
+ * @brief
+ *  Cleanup the pinky test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void pinky_cleanup(void)
+{
+    mut_printf(MUT_LOG_HIGH, "%s entry", __FUNCTION__);
+
+    /* Restore the default for the tests that follow.
+     */
+    fbe_api_raid_group_set_max_concurrent_rebuild_ios(PINKY_DEFAULT_CONCURRENT_IOS);
+
+    if (fbe_test_util_is_simulation())
+    {
+        fbe_test_sep_util_destroy_neit_sep_physical();
+    }
+    return;
+}
+/******************************************
+ * end pinky_cleanup()
+ ******************************************/
+
+/*************************
+ * end file pinky_test.c
+ *************************/
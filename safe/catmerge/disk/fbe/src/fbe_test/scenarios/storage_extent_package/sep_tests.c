@@ -136,6 +136,9 @@ mut_testsuite_t * fbe_test_create_sep_configuration_test_suite(mut_function_t st
     MUT_ADD_TEST_WITH_DESCRIPTION(sep_test_suite, jigglypuff_drive_validation_test, jigglypuff_drive_validation_setup, jigglypuff_drive_validation_cleanup,
                                   jigglypuff_drive_validation_short_desc, jigglypuff_drive_validation_long_desc)   
 
+    MUT_ADD_TEST_WITH_DESCRIPTION(sep_test_suite, sandy_cheeks_test, sandy_cheeks_setup, sandy_cheeks_cleanup,
+                                  sandy_cheeks_short_desc, sandy_cheeks_long_desc)
+
     return sep_test_suite;
 }
 
@@ -308,6 +311,9 @@ mut_testsuite_t * fbe_test_create_sep_disk_errors_test_suite(mut_function_t star
     MUT_ADD_TEST_WITH_DESCRIPTION(sep_test_suite, baymax_test, baymax_setup, baymax_cleanup,
                                   baymax_short_desc,baymax_long_desc)
 
+    MUT_ADD_TEST_WITH_DESCRIPTION(sep_test_suite, roosevelt_franklin_test, roosevelt_franklin_setup, roosevelt_franklin_cleanup,
+                                  roosevelt_franklin_short_desc, roosevelt_franklin_long_desc)
+
     return sep_test_suite;
 }
 mut_testsuite_t * fbe_test_create_sep_normal_io_test_suite(mut_function_t startup, mut_function_t teardown)
@@ -394,6 +400,8 @@ mut_testsuite_t * fbe_test_create_sep_normal_io_test_suite(mut_function_t startu
                                   launchpad_mcquack_short_desc, launchpad_mcquack_long_desc);
     MUT_ADD_TEST_WITH_DESCRIPTION(sep_test_suite, eye_of_vecna_test, eye_of_vecna_setup, eye_of_vecna_cleanup,
                                   eye_of_vecna_short_desc, eye_of_vecna_long_desc);
+    MUT_ADD_TEST_WITH_DESCRIPTION(sep_test_suite, two_headed_monster_test, two_headed_monster_setup, two_headed_monster_cleanup,
+                                  two_headed_monster_short_desc, two_headed_monster_long_desc);
 
     /* This can not be run with python, because it consumes a lot of memory */
     MUT_ADD_TEST_WITH_DESCRIPTION(sep_test_suite, performance_test, performance_test_init, performance_test_destroy,
@@ -486,6 +494,10 @@ mut_testsuite_t * fbe_test_create_sep_rebuild_test_suite(mut_function_t startup,
                                   momo_short_desc, momo_long_desc)
     MUT_ADD_TEST_WITH_DESCRIPTION(sep_test_suite, samwise_gamgee_test, samwise_gamgee_setup, samwise_gamgee_cleanup,
                                   samwise_gamgee_short_desc, samwise_gamgee_long_desc)
+    MUT_ADD_TEST_WITH_DESCRIPTION(sep_test_suite, pinky_test, pinky_setup, pinky_cleanup,
+                                  pinky_short_desc, pinky_long_desc)
+    MUT_ADD_TEST_WITH_DESCRIPTION(sep_test_suite, baby_natasha_test, baby_natasha_setup, baby_natasha_cleanup,
+                                  baby_natasha_short_desc, baby_natasha_long_desc)
     return sep_test_suite;
 
 }
@@ -513,6 +525,8 @@ mut_testsuite_t * fbe_test_create_sep_services_test_suite(mut_function_t startup
                                   harry_potter_short_desc, harry_potter_long_desc)
     MUT_ADD_TEST_WITH_DESCRIPTION(sep_test_suite, hermione_test, hermione_setup, hermione_cleanup,
                                   hermione_short_desc, hermione_long_desc)
+    MUT_ADD_TEST_WITH_DESCRIPTION(sep_test_suite, candace_test, candace_setup, candace_cleanup,
+                                  candace_short_desc, candace_long_desc)
 
 /*!@todo DE730 comment out sailor_moon test */
 //    MUT_ADD_TEST_WITH_DESCRIPTION(sep_test_suite, sailor_moon_test, sailor_moon_setup, sailor_moon_cleanup,
@@ -559,6 +573,8 @@ mut_testsuite_t * fbe_test_create_sep_sniff_test_suite(mut_function_t startup, m
 
     MUT_ADD_TEST_WITH_DESCRIPTION(sep_test_suite, scoop_test, scoop_test_init, scoop_test_destroy,
                                   scoop_short_desc, scoop_long_desc);
+    MUT_ADD_TEST_WITH_DESCRIPTION(sep_test_suite, scrappy_doo_test, scrappy_doo_setup, scrappy_doo_cleanup,
+                                  scrappy_doo_short_desc, scrappy_doo_long_desc)
     return sep_test_suite;
 }
 mut_testsuite_t * fbe_test_create_sep_sparing_test_suite(mut_function_t startup, mut_function_t teardown)
@@ -593,6 +609,9 @@ mut_testsuite_t * fbe_test_create_sep_sparing_test_suite(mut_function_t startup,
     MUT_ADD_TEST_WITH_DESCRIPTION(sep_test_suite, velma_test, 
                                   velma_setup, velma_cleanup, velma_short_desc, velma_long_desc)
 
+    MUT_ADD_TEST_WITH_DESCRIPTION(sep_test_suite, hoots_the_owl_test, hoots_the_owl_setup, hoots_the_owl_cleanup,
+                                  hoots_the_owl_short_desc, hoots_the_owl_long_desc)
+
     return sep_test_suite;
 }
 mut_testsuite_t * fbe_test_create_sep_copy_test_suite(mut_function_t startup, mut_function_t teardown)
@@ -639,6 +658,9 @@ mut_testsuite_t * fbe_test_create_sep_copy_test_suite(mut_function_t startup, mu
     MUT_ADD_TEST_WITH_DESCRIPTION(sep_test_suite, vincent_van_ghoul_test, vincent_van_ghoul_setup, vincent_van_ghoul_cleanup,
                                   vincent_van_ghoul_short_desc, vincent_van_ghoul_long_desc)
 
+    MUT_ADD_TEST_WITH_DESCRIPTION(sep_test_suite, brain_test, brain_setup, brain_cleanup,
+                                  brain_short_desc, brain_long_desc)
+
     /*! @note The following tests are not functional. 
      */
 
@@ -872,6 +894,8 @@ mut_testsuite_t * fbe_test_create_sep_zeroing_test_suite(mut_function_t startup,
                                   evie_short_desc, evie_long_desc)
     MUT_ADD_TEST_WITH_DESCRIPTION(sep_test_suite, hiro_hamada_test, hiro_hamada_setup, hiro_hamada_cleanup,
                                   hiro_hamada_short_desc, hiro_hamada_long_desc)
+    MUT_ADD_TEST_WITH_DESCRIPTION(sep_test_suite, wile_e_coyote_test, wile_e_coyote_setup, wile_e_coyote_cleanup,
+                                  wile_e_coyote_short_desc, wile_e_coyote_long_desc)
     return sep_test_suite; 
 }
 
@@ -891,6 +915,12 @@ mut_testsuite_t * fbe_test_create_sep_performance_test_suite(mut_function_t star
     MUT_ADD_TEST_WITH_DESCRIPTION(sep_test_suite, king_minos_test, king_minos_setup, king_minos_cleanup,
                                   king_minos_short_desc, king_minos_long_desc);
 
+    MUT_ADD_TEST_WITH_DESCRIPTION(sep_test_suite, count_von_count_test, count_von_count_setup, count_von_count_cleanup,
+                                  count_von_count_short_desc, count_von_count_long_desc);
+
+    MUT_ADD_TEST_WITH_DESCRIPTION(sep_test_suite, forgetful_jones_test, forgetful_jones_setup, forgetful_jones_cleanup,
+                                  forgetful_jones_short_desc, forgetful_jones_long_desc);
+
     return sep_test_suite;
 }
 
@@ -1639,6 +1669,9 @@ mut_testsuite_t * fbe_test_create_sep_dualsp_verify_test_suite(mut_function_t st
 
     MUT_ADD_TEST_WITH_DESCRIPTION(sep_dualsp_test_suite, bilbo_baggins_dualsp_test, bilbo_baggins_dualsp_setup, bilbo_baggins_dualsp_cleanup,
                                   bilbo_baggins_short_desc, bilbo_baggins_long_desc);
+
+    MUT_ADD_TEST_WITH_DESCRIPTION(sep_dualsp_test_suite, mr_noodle_dualsp_test, mr_noodle_dualsp_setup, mr_noodle_dualsp_cleanup,
+                                  mr_noodle_short_desc, mr_noodle_long_desc);
     return sep_dualsp_test_suite;
 }
 mut_testsuite_t * fbe_test_create_sep_dualsp_zeroing_test_suite(mut_function_t startup, mut_function_t teardown)
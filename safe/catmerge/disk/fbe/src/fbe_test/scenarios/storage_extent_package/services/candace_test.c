@@ -0,0 +1,371 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2009
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!**************************************************************************
+ * @file candace_test.c
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains the test for group commit of the persist service.
+ *  It measures how many journal commits and entry write I/Os the persist
+ *  service issues for a burst of LUN creates and for a burst of concurrent
+ *  single entry requests.
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "mut.h"
+#include "fbe_test_package_config.h"
+#include "fbe_test_configurations.h"
+#include "fbe/fbe_api_common.h"
+#include "fbe/fbe_api_sim_server.h"
+#include "fbe_test_common_utils.h"
+#include "sep_tests.h"
+#include "fbe/fbe_api_utils.h"
+#include "fbe/fbe_api_lun_interface.h"
+#include "pp_utils.h"
+#include "sep_utils.h"
+#include "fbe/fbe_api_database_interface.h"
+#include "fbe/fbe_api_persist_interface.h"
+#include "fbe/fbe_random.h"
+
+/*************************
+ *   LOCAL DEFINITIONS
+ *************************/
+
+/*!*******************************************************************
+ * @def CANDACE_LUN_COUNT
+ *********************************************************************
+ * @brief Number of LUNs we create in a row to load the database service.
+ *
+ *********************************************************************/
+#define CANDACE_LUN_COUNT 16
+
+/*!*******************************************************************
+ * @def CANDACE_FIRST_LUN_NUMBER
+ *********************************************************************
+ * @brief First LUN number we use.
+ *
+ *********************************************************************/
+#define CANDACE_FIRST_LUN_NUMBER 200
+
+/*!*******************************************************************
+ * @def CANDACE_SINGLE_ENTRY_COUNT
+ *********************************************************************
+ * @brief Number of single entry requests we send without waiting.
+ *
+ *********************************************************************/
+#define CANDACE_SINGLE_ENTRY_COUNT 64
+
+typedef struct candace_single_entry_context_s{
+    fbe_semaphore_t         sem;
+    fbe_atomic_t            failed_count;
+    fbe_persist_entry_id_t  entry_id[CANDACE_SINGLE_ENTRY_COUNT];
+}candace_single_entry_context_t;
+
+typedef struct candace_single_entry_request_s{
+    candace_single_entry_context_t *    context;
+    fbe_u32_t                           index;
+    fbe_u8_t                            data[FBE_PERSIST_DATA_BYTES_PER_ENTRY];
+}candace_single_entry_request_t;
+
+static candace_single_entry_request_t * candace_requests = NULL;
+
+/*************************
+ *   FUNCTION DEFINITIONS
+ *************************/
+static void candace_get_stats(fbe_persist_control_get_stats_t *stats_p);
+static void candace_report_stats(const fbe_char_t *operation_p,
+                                 fbe_persist_control_get_stats_t *before_p,
+                                 fbe_persist_control_get_stats_t *after_p,
+                                 fbe_u32_t elapsed_msec);
+static void candace_test_lun_create_burst(void);
+static void candace_test_single_entry_burst(void);
+static fbe_status_t candace_single_entry_completion(fbe_status_t op_status,
+                                                    fbe_persist_entry_id_t entry_id,
+                                                    fbe_persist_completion_context_t context);
+
+/*************************
+ *   TEST DESCRIPTION
+ *************************/
+char * candace_short_desc = "Persist service group commit of single entry requests";
+char * candace_long_desc =
+"The Candace scenario measures the journal commits and entry write I/Os of the persist service.\n"
+"\n"
+"Starting Config:\n"
+"        [PP] armada board\n"
+"        [PP] SAS PMC port\n"
+"        [PP] viper enclosure\n"
+"        [PP] SAS drives\n"
+"        [SEP] raid group and database LUN\n"
+"\n"
+"STEP 1: Create LUNs one after the other and report persist statistics and elapsed time.\n"
+"STEP 2: Destroy the LUNs.\n"
+"STEP 3: Send a burst of single entry writes without waiting for each of them.\n"
+"        - Verify all of them complete with success.\n"
+"        - Verify they were merged in fewer journal commits than requests.\n"
+"STEP 4: Delete the entries the same way and verify they are merged too.\n"
+;
+
+/*!**************************************************************
+ * candace_setup()
+ ****************************************************************
+ * @brief
+ *  Create a raid group we will bind the LUNs on.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void candace_setup(void)
+{
+    fbe_test_rg_configuration_t *rg_config_p = NULL;
+
+    sep_standard_logical_config_get_rg_configuration(FBE_TEST_SEP_RG_CONFIG_TYPE_ONE_R5, &rg_config_p);
+    sep_standard_logical_config_create_rg_with_lun(rg_config_p, 0);  /* just create a RG */
+    return;
+}
+/******************************************
+ * end candace_setup()
+ ******************************************/
+
+/*!**************************************************************
+ * candace_cleanup()
+ ****************************************************************
+ * @brief
+ *  Destroy the configuration.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void candace_cleanup(void)
+{
+    fbe_test_sep_util_destroy_neit_sep_physical();
+    return;
+}
+/******************************************
+ * end candace_cleanup()
+ ******************************************/
+
+/*!**************************************************************
+ * candace_test()
+ ****************************************************************
+ * @brief
+ *  Run the group commit scenario.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void candace_test(void)
+{
+    candace_test_lun_create_burst();
+    candace_test_single_entry_burst();
+    return;
+}
+/******************************************
+ * end candace_test()
+ ******************************************/
+
+static void candace_get_stats(fbe_persist_control_get_stats_t *stats_p)
+{
+    fbe_status_t status;
+
+    status = fbe_api_persist_get_stats(stats_p);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+}
+
+static void candace_report_stats(const fbe_char_t *operation_p,
+                                 fbe_persist_control_get_stats_t *before_p,
+                                 fbe_persist_control_get_stats_t *after_p,
+                                 fbe_u32_t elapsed_msec)
+{
+    mut_printf(MUT_LOG_TEST_STATUS, "%s: %s took %d msec", __FUNCTION__, operation_p, elapsed_msec);
+    mut_printf(MUT_LOG_TEST_STATUS, "%s:   journal commits: %llu entry write I/Os: %llu entries written: %llu",
+               __FUNCTION__,
+               (unsigned long long)(after_p->journal_commits - before_p->journal_commits),
+               (unsigned long long)(after_p->entry_write_ios - before_p->entry_write_ios),
+               (unsigned long long)(after_p->entries_written - before_p->entries_written));
+    mut_printf(MUT_LOG_TEST_STATUS, "%s:   single entry requests: %llu group commits: %llu",
+               __FUNCTION__,
+               (unsigned long long)(after_p->single_entry_requests - before_p->single_entry_requests),
+               (unsigned long long)(after_p->group_commits - before_p->group_commits));
+}
+
+/*!**************************************************************
+ * candace_test_lun_create_burst()
+ ****************************************************************
+ * @brief
+ *  Create and destroy a set of LUNs and report how much persist
+ *  work it generated.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void candace_test_lun_create_burst(void)
+{
+    fbe_status_t                        status;
+    fbe_api_lun_create_t                lun_create_req;
+    fbe_api_lun_destroy_t               lun_destroy_req;
+    fbe_object_id_t                     lu_id;
+    fbe_job_service_error_type_t        job_error_type;
+    fbe_persist_control_get_stats_t     before;
+    fbe_persist_control_get_stats_t     after;
+    fbe_time_t                          start_time;
+    fbe_u32_t                           lun_index;
+
+    mut_printf(MUT_LOG_TEST_STATUS, "=== Step 1: create %d LUNs ===", CANDACE_LUN_COUNT);
+
+    candace_get_stats(&before);
+    start_time = fbe_get_time();
+
+    for (lun_index = 0; lun_index < CANDACE_LUN_COUNT; lun_index++) {
+        fbe_zero_memory(&lun_create_req, sizeof(fbe_api_lun_create_t));
+        lun_create_req.raid_type = FBE_RAID_GROUP_TYPE_RAID5;
+        lun_create_req.raid_group_id = 5; /*sep_standard_logical_config_one_r5 is 5 so this is what we use*/
+        lun_create_req.lun_number = CANDACE_FIRST_LUN_NUMBER + lun_index;
+        lun_create_req.capacity = 0x1000;
+        lun_create_req.placement = FBE_BLOCK_TRANSPORT_BEST_FIT;
+        lun_create_req.ndb_b = FBE_FALSE;
+        lun_create_req.noinitialverify_b = FBE_FALSE;
+        lun_create_req.addroffset = FBE_LBA_INVALID;
+        lun_create_req.world_wide_name.bytes[0] = fbe_random() & 0xf;
+        lun_create_req.world_wide_name.bytes[1] = fbe_random() & 0xf;
+
+        status = fbe_api_create_lun(&lun_create_req, FBE_TRUE, 100000, &lu_id, &job_error_type);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    }
+
+    candace_get_stats(&after);
+    candace_report_stats("LUN create", &before, &after, fbe_get_elapsed_milliseconds(start_time));
+    MUT_ASSERT_TRUE(after.journal_commits > before.journal_commits);
+    /* Contiguous entries go out in one write, so we never need more I/Os than entries. */
+    MUT_ASSERT_TRUE((after.entry_write_ios - before.entry_write_ios) <= (after.entries_written - before.entries_written));
+
+    mut_printf(MUT_LOG_TEST_STATUS, "=== Step 2: destroy %d LUNs ===", CANDACE_LUN_COUNT);
+    for (lun_index = 0; lun_index < CANDACE_LUN_COUNT; lun_index++) {
+        lun_destroy_req.lun_number = CANDACE_FIRST_LUN_NUMBER + lun_index;
+        status = fbe_api_destroy_lun(&lun_destroy_req, FBE_TRUE, 100000, &job_error_type);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    }
+}
+/******************************************
+ * end candace_test_lun_create_burst()
+ ******************************************/
+
+/*!**************************************************************
+ * candace_test_single_entry_burst()
+ ****************************************************************
+ * @brief
+ *  Send a lot of single entry writes and deletes without waiting
+ *  for each other. Before group commit most of them failed with busy,
+ *  now they should all succeed and share journal commits.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void candace_test_single_entry_burst(void)
+{
+    fbe_status_t                        status;
+    candace_single_entry_context_t      context;
+    fbe_persist_control_get_stats_t     before;
+    fbe_persist_control_get_stats_t     after;
+    fbe_time_t                          start_time;
+    fbe_u32_t                           index;
+
+    mut_printf(MUT_LOG_TEST_STATUS, "=== Step 3: write %d single entries ===", CANDACE_SINGLE_ENTRY_COUNT);
+
+    candace_requests = (candace_single_entry_request_t *)malloc(sizeof(candace_single_entry_request_t) * CANDACE_SINGLE_ENTRY_COUNT);
+    MUT_ASSERT_NOT_NULL(candace_requests);
+
+    fbe_semaphore_init(&context.sem, 0, CANDACE_SINGLE_ENTRY_COUNT);
+    context.failed_count = 0;
+
+    candace_get_stats(&before);
+    start_time = fbe_get_time();
+
+    for (index = 0; index < CANDACE_SINGLE_ENTRY_COUNT; index++) {
+        candace_requests[index].context = &context;
+        candace_requests[index].index = index;
+        fbe_set_memory(candace_requests[index].data, (fbe_u8_t)index, FBE_PERSIST_DATA_BYTES_PER_ENTRY);
+        context.entry_id[index] = 0;
+
+        status = fbe_api_persist_write_single_entry(FBE_PERSIST_SECTOR_TYPE_SCRATCH_PAD,
+                                                    candace_requests[index].data,
+                                                    FBE_PERSIST_DATA_BYTES_PER_ENTRY,
+                                                    candace_single_entry_completion,
+                                                    &candace_requests[index]);
+        MUT_ASSERT_TRUE(status != FBE_STATUS_GENERIC_FAILURE);
+    }
+    for (index = 0; index < CANDACE_SINGLE_ENTRY_COUNT; index++) {
+        status = fbe_semaphore_wait_ms(&context.sem, 30000);
+        MUT_ASSERT_TRUE(status != FBE_STATUS_TIMEOUT);
+    }
+
+    candace_get_stats(&after);
+    candace_report_stats("single entry write", &before, &after, fbe_get_elapsed_milliseconds(start_time));
+    MUT_ASSERT_INT_EQUAL(0, (fbe_u32_t)context.failed_count);
+    MUT_ASSERT_TRUE((after.single_entry_requests - before.single_entry_requests) == CANDACE_SINGLE_ENTRY_COUNT);
+    MUT_ASSERT_TRUE((after.journal_commits - before.journal_commits) < CANDACE_SINGLE_ENTRY_COUNT);
+    MUT_ASSERT_TRUE(after.group_commits > before.group_commits);
+
+    mut_printf(MUT_LOG_TEST_STATUS, "=== Step 4: delete %d single entries ===", CANDACE_SINGLE_ENTRY_COUNT);
+    candace_get_stats(&before);
+    start_time = fbe_get_time();
+
+    for (index = 0; index < CANDACE_SINGLE_ENTRY_COUNT; index++) {
+        status = fbe_api_persist_delete_single_entry(context.entry_id[index],
+                                                     candace_single_entry_completion,
+                                                     &candace_requests[index]);
+        MUT_ASSERT_TRUE(status != FBE_STATUS_GENERIC_FAILURE);
+    }
+    for (index = 0; index < CANDACE_SINGLE_ENTRY_COUNT; index++) {
+        status = fbe_semaphore_wait_ms(&context.sem, 30000);
+        MUT_ASSERT_TRUE(status != FBE_STATUS_TIMEOUT);
+    }
+
+    candace_get_stats(&after);
+    candace_report_stats("single entry delete", &before, &after, fbe_get_elapsed_milliseconds(start_time));
+    MUT_ASSERT_INT_EQUAL(0, (fbe_u32_t)context.failed_count);
+    MUT_ASSERT_TRUE((after.journal_commits - before.journal_commits) < CANDACE_SINGLE_ENTRY_COUNT);
+
+    fbe_semaphore_destroy(&context.sem);
+    free(candace_requests);
+    candace_requests = NULL;
+}
+/******************************************
+ * end candace_test_single_entry_burst()
+ ******************************************/
+
+static fbe_status_t candace_single_entry_completion(fbe_status_t op_status,
+                                                    fbe_persist_entry_id_t entry_id,
+                                                    fbe_persist_completion_context_t context)
+{
+    candace_single_entry_request_t * request_p = (candace_single_entry_request_t *)context;
+
+    if (op_status != FBE_STATUS_OK) {
+        fbe_atomic_increment(&request_p->context->failed_count);
+    } else if (entry_id != 0) {
+        request_p->context->entry_id[request_p->index] = entry_id;
+    }
+    fbe_semaphore_release(&request_p->context->sem, 0, 1, FALSE);
+
+    return FBE_STATUS_OK;
+}
+
+/*************************
+ * end file candace_test.c
+ *************************/
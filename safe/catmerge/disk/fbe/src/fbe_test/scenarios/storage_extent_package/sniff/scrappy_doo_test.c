@@ -0,0 +1,601 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2009
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!**************************************************************************
+ * @file scrappy_doo_test.c
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains a test of sniff verify pacing.  It checks that sniff
+ *  speeds up while the host is idle and backs off under intermittent host
+ *  load, and reports how much sniff adds to the host response time.  It also
+ *  checks that a media error does not keep sniff from moving on.
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "mut.h"
+#include "fbe/fbe_api_rdgen_interface.h"
+#include "sep_tests.h"
+#include "fbe/fbe_winddk.h"
+#include "fbe/fbe_api_common.h"
+#include "fbe/fbe_api_provision_drive_interface.h"
+#include "fbe/fbe_api_logical_error_injection_interface.h"
+#include "fbe_test_package_config.h"
+#include "fbe_test_configurations.h"
+#include "sep_utils.h"
+#include "fbe/fbe_api_utils.h"
+#include "fbe/fbe_api_sim_server.h"
+#include "fbe/fbe_api_database_interface.h"
+#include "pp_utils.h"
+#include "fbe_test_common_utils.h"
+
+/*************************
+ *   FUNCTION DEFINITIONS
+ *************************/
+
+char * scrappy_doo_short_desc = "sniff verify pacing under idle and intermittent host load";
+char * scrappy_doo_long_desc ="\
+The Scrappy Doo scenario checks that sniff verify speeds up while the host is idle and backs\n\
+off when host I/O arrives, and reports the host response time with and without sniff running.\n\
+\n\
+STEP 1: configure a raid 5 raid group with one LUN and wait for zeroing to finish.\n\
+\n\
+STEP 2: with sniff disabled run bursts of random reads separated by idle gaps\n\
+        and report the response time percentiles.\n\
+\n\
+STEP 3: enable sniff on the first drive and leave the host idle.\n\
+        - make sure most sniff cycles ran sooner than the busy delay.\n\
+        - make sure sniff ended up below the busy delay.\n\
+        - report how far sniff got and the full pass time this rate works out to.\n\
+\n\
+STEP 4: run the same bursts as in step 2 with sniff enabled.\n\
+        - make sure every burst made sniff run at least one cycle at the busy delay.\n\
+        - make sure sniff sped up again in the idle gaps.\n\
+        - report the sniff rate and the response time percentiles.\n\
+\n\
+STEP 5: inject a media error at the start of the user area of the first drive,\n\
+        restart sniff from the beginning and make sure the checkpoint moves past\n\
+        the chunks around the error while the error is still there.\n\
+\n\
+STEP 6: destroy the configuration.\n\
+\n"
+"Description last updated: 10/19/2026.\n";
+
+/*!*******************************************************************
+ * @def SCRAPPY_DOO_LUNS_PER_RAID_GROUP
+ *********************************************************************
+ * @brief Number of LUNs in the raid group.
+ *
+ *********************************************************************/
+#define SCRAPPY_DOO_LUNS_PER_RAID_GROUP 1
+
+/*!*******************************************************************
+ * @def SCRAPPY_DOO_CHUNKS_PER_LUN
+ *********************************************************************
+ * @brief Number of chunks each LUN will occupy.
+ *
+ *********************************************************************/
+#define SCRAPPY_DOO_CHUNKS_PER_LUN 6
+
+/*!*******************************************************************
+ * @def SCRAPPY_DOO_CYCLES
+ *********************************************************************
+ * @brief Number of load bursts in a phase.
+ *
+ *********************************************************************/
+#define SCRAPPY_DOO_CYCLES 4
+
+/*!*******************************************************************
+ * @def SCRAPPY_DOO_BURST_SECONDS
+ *********************************************************************
+ * @brief How long each burst of host I/O runs.
+ *
+ *********************************************************************/
+#define SCRAPPY_DOO_BURST_SECONDS 2
+
+/*!*******************************************************************
+ * @def SCRAPPY_DOO_GAP_SECONDS
+ *********************************************************************
+ * @brief How long the host is idle after each burst.  Long enough for
+ *        sniff to notice the host is idle and speed up.
+ *
+ *********************************************************************/
+#define SCRAPPY_DOO_GAP_SECONDS 4
+
+/*!*******************************************************************
+ * @def SCRAPPY_DOO_ARRIVAL_IOPS
+ *********************************************************************
+ * @brief Arrival rate of the host I/O during a burst.
+ *
+ *********************************************************************/
+#define SCRAPPY_DOO_ARRIVAL_IOPS 200
+
+/*!*******************************************************************
+ * @def SCRAPPY_DOO_THREADS
+ *********************************************************************
+ * @brief Most host I/Os we allow outstanding.
+ *
+ *********************************************************************/
+#define SCRAPPY_DOO_THREADS 8
+
+/*!*******************************************************************
+ * @def SCRAPPY_DOO_BLOCKS
+ *********************************************************************
+ * @brief Size of each host I/O.
+ *
+ *********************************************************************/
+#define SCRAPPY_DOO_BLOCKS 8
+
+/*!*******************************************************************
+ * @def SCRAPPY_DOO_BUSY_RESCHEDULE_MS
+ *********************************************************************
+ * @brief Delay between sniff verifies while the host is busy.
+ *
+ *********************************************************************/
+#define SCRAPPY_DOO_BUSY_RESCHEDULE_MS 1000
+
+/*!*******************************************************************
+ * @def SCRAPPY_DOO_CHUNK_BLOCKS
+ *********************************************************************
+ * @brief Blocks in a provision drive chunk, the unit sniff verifies.
+ *
+ *********************************************************************/
+#define SCRAPPY_DOO_CHUNK_BLOCKS 0x800
+
+/*!*******************************************************************
+ * @def SCRAPPY_DOO_MEDIA_ERROR_LBA
+ *********************************************************************
+ * @brief Where the media error is injected, the first chunk of the
+ *        user area.
+ *
+ *********************************************************************/
+#define SCRAPPY_DOO_MEDIA_ERROR_LBA 0x10000
+
+/*!*******************************************************************
+ * @def SCRAPPY_DOO_MEDIA_ERROR_END_LBA
+ *********************************************************************
+ * @brief Sniff must get past the chunks verified again around the
+ *        media error.
+ *
+ *********************************************************************/
+#define SCRAPPY_DOO_MEDIA_ERROR_END_LBA (SCRAPPY_DOO_MEDIA_ERROR_LBA + (3 * SCRAPPY_DOO_CHUNK_BLOCKS))
+
+/*!*******************************************************************
+ * @var scrappy_doo_error_record
+ *********************************************************************
+ * @brief Media error that stays until the block is remapped.
+ *
+ *********************************************************************/
+static fbe_api_logical_error_injection_record_t scrappy_doo_error_record =
+{
+    0x4, 0x10, SCRAPPY_DOO_MEDIA_ERROR_LBA, 0x1, FBE_API_LOGICAL_ERROR_INJECTION_TYPE_MEDIA_ERROR,
+    FBE_API_LOGICAL_ERROR_INJECTION_MODE_INJECT_UNTIL_REMAPPED, 0x0, 0x15, 0x0, 0x15, 0x1, 0x0, 0x0, 0x0, 0x0
+};
+
+/*!*******************************************************************
+ * @var scrappy_doo_raid_group_config
+ *********************************************************************
+ * @brief Raid group we run I/O to.
+ *
+ *********************************************************************/
+static fbe_test_rg_configuration_t scrappy_doo_raid_group_config[] =
+{
+    /* width,   capacity    raid type,                  class,                  block size      RAID-id.    bandwidth.*/
+    {3,       0xE000,     FBE_RAID_GROUP_TYPE_RAID5,  FBE_CLASS_ID_PARITY,      520,            0,          0},
+    {FBE_U32_MAX, FBE_U32_MAX, FBE_U32_MAX, /* Terminator. */},
+};
+
+/*!**************************************************************
+ * scrappy_doo_get_sniff_blocks()
+ ****************************************************************
+ * @brief
+ *  Return how many blocks sniff verified since the given checkpoint,
+ *  allowing for sniff wrapping back to the start of the drive.
+ *
+ * @param pvd_object_id - Drive sniff runs on.
+ * @param start_checkpoint - Checkpoint at the start of the phase.
+ * @param capacity_p - Exported capacity of the drive.
+ *
+ * @return fbe_lba_t - Blocks verified.
+ *
+ ****************************************************************/
+static fbe_lba_t scrappy_doo_get_sniff_blocks(fbe_object_id_t pvd_object_id,
+                                              fbe_lba_t start_checkpoint,
+                                              fbe_lba_t *capacity_p)
+{
+    fbe_status_t                            status;
+    fbe_provision_drive_get_verify_status_t verify_status;
+
+    status = fbe_test_sep_util_provision_drive_get_verify_status(pvd_object_id, &verify_status);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    *capacity_p = verify_status.exported_capacity;
+    if (verify_status.verify_checkpoint >= start_checkpoint)
+    {
+        return verify_status.verify_checkpoint - start_checkpoint;
+    }
+    return (verify_status.exported_capacity - start_checkpoint) + verify_status.verify_checkpoint;
+}
+/******************************************
+ * end scrappy_doo_get_sniff_blocks()
+ ******************************************/
+
+/*!**************************************************************
+ * scrappy_doo_run_phase()
+ ****************************************************************
+ * @brief
+ *  Run bursts of host I/O separated by idle gaps, or just stay idle
+ *  for as long, and report the sniff rate and host response time.
+ *
+ * @param lun_object_id - LUN to run I/O to.
+ * @param pvd_object_id - Drive sniff runs on.
+ * @param b_host_io - FBE_TRUE to run host I/O bursts.
+ * @param phase_name - Name of the phase to report.
+ * @param busy_cycles_p - Returns the sniff cycles run at the busy delay.
+ * @param idle_cycles_p - Returns the sniff cycles run sooner.
+ * @param end_status_p - Returns the verify status at the end of the phase.
+ *
+ * @return fbe_lba_t - Blocks sniff verified during the phase.
+ *
+ ****************************************************************/
+static fbe_lba_t scrappy_doo_run_phase(fbe_object_id_t lun_object_id,
+                                       fbe_object_id_t pvd_object_id,
+                                       fbe_bool_t b_host_io,
+                                       const char *phase_name,
+                                       fbe_u64_t *busy_cycles_p,
+                                       fbe_u64_t *idle_cycles_p,
+                                       fbe_provision_drive_get_verify_status_t *end_status_p)
+{
+    fbe_status_t                                status;
+    fbe_api_rdgen_context_t                     rdgen_context;
+    fbe_rdgen_filter_t                          filter;
+    fbe_rdgen_control_get_latency_histogram_t   histogram;
+    fbe_api_rdgen_latency_percentiles_t         percentiles;
+    fbe_provision_drive_get_verify_status_t     verify_status;
+    fbe_time_t                                  start_time;
+    fbe_u32_t                                   elapsed_msec;
+    fbe_lba_t                                   sniff_blocks;
+    fbe_lba_t                                   capacity;
+    fbe_u64_t                                   blocks_per_second;
+    fbe_u32_t                                   cycle;
+
+    status = fbe_api_rdgen_reset_stats();
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    status = fbe_test_sep_util_provision_drive_get_verify_status(pvd_object_id, &verify_status);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    start_time = fbe_get_time();
+
+    for (cycle = 0; cycle < SCRAPPY_DOO_CYCLES; cycle++)
+    {
+        if (!b_host_io)
+        {
+            fbe_api_sleep((SCRAPPY_DOO_BURST_SECONDS + SCRAPPY_DOO_GAP_SECONDS) * FBE_TIME_MILLISECONDS_PER_SECOND);
+            continue;
+        }
+
+        status = fbe_api_rdgen_test_context_init(&rdgen_context,
+                                                 lun_object_id,
+                                                 FBE_CLASS_ID_INVALID,
+                                                 FBE_PACKAGE_ID_SEP_0,
+                                                 FBE_RDGEN_OPERATION_READ_ONLY,
+                                                 FBE_RDGEN_PATTERN_LBA_PASS,
+                                                 0,    /* passes (manual stop) */
+                                                 0,    /* io count not used */
+                                                 0,    /* time not used */
+                                                 SCRAPPY_DOO_THREADS,
+                                                 FBE_RDGEN_LBA_SPEC_RANDOM,
+                                                 0,    /* start lba */
+                                                 0,    /* min lba */
+                                                 FBE_LBA_INVALID, /* use capacity */
+                                                 FBE_RDGEN_BLOCK_SPEC_CONSTANT,
+                                                 SCRAPPY_DOO_BLOCKS,
+                                                 SCRAPPY_DOO_BLOCKS);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+        status = fbe_api_rdgen_io_specification_set_arrival_rate(&rdgen_context.start_io.specification,
+                                                                 FBE_RDGEN_ARRIVAL_MODE_POISSON,
+                                                                 SCRAPPY_DOO_ARRIVAL_IOPS);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+        status = fbe_api_rdgen_start_tests(&rdgen_context, FBE_PACKAGE_ID_NEIT, 1);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+        fbe_api_sleep(SCRAPPY_DOO_BURST_SECONDS * FBE_TIME_MILLISECONDS_PER_SECOND);
+
+        status = fbe_api_rdgen_stop_tests(&rdgen_context, 1);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+        MUT_ASSERT_INT_EQUAL(rdgen_context.start_io.statistics.error_count, 0);
+        MUT_ASSERT_TRUE(rdgen_context.start_io.statistics.io_count > 0);
+
+        status = fbe_api_rdgen_test_context_destroy(&rdgen_context);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+        fbe_api_sleep(SCRAPPY_DOO_GAP_SECONDS * FBE_TIME_MILLISECONDS_PER_SECOND);
+    }
+
+    elapsed_msec = fbe_get_elapsed_milliseconds(start_time);
+    sniff_blocks = scrappy_doo_get_sniff_blocks(pvd_object_id, verify_status.verify_checkpoint, &capacity);
+    blocks_per_second = (sniff_blocks * FBE_TIME_MILLISECONDS_PER_SECOND) / FBE_MAX(elapsed_msec, 1);
+
+    status = fbe_test_sep_util_provision_drive_get_verify_status(pvd_object_id, end_status_p);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    *busy_cycles_p = end_status_p->sniff_busy_cycles - verify_status.sniff_busy_cycles;
+    *idle_cycles_p = end_status_p->sniff_idle_cycles - verify_status.sniff_idle_cycles;
+
+    mut_printf(MUT_LOG_TEST_STATUS, "   %s: sniff 0x%llx blocks in %d ms, full pass %lld seconds",
+               phase_name, (unsigned long long)sniff_blocks, elapsed_msec,
+               (blocks_per_second == 0) ? -1LL : (long long)(capacity / blocks_per_second));
+    mut_printf(MUT_LOG_TEST_STATUS, "   %s: %lld busy cycles, %lld idle cycles, delay now %d ms",
+               phase_name, (long long)*busy_cycles_p, (long long)*idle_cycles_p,
+               end_status_p->sniff_reschedule_ms);
+
+    if (b_host_io)
+    {
+        /* All threads are done, so everything is in the historical histogram.
+         */
+        status = fbe_api_rdgen_filter_init(&filter, FBE_RDGEN_FILTER_TYPE_OBJECT, lun_object_id,
+                                           FBE_CLASS_ID_INVALID, FBE_PACKAGE_ID_SEP_0, 0);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+        status = fbe_api_rdgen_get_latency_histogram(&histogram, &filter);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+        fbe_api_rdgen_latency_histogram_get_percentiles(&histogram.historical[FBE_RDGEN_LATENCY_TYPE_READ], &percentiles);
+        MUT_ASSERT_TRUE(percentiles.count > 0);
+
+        mut_printf(MUT_LOG_TEST_STATUS, "   %s: host p50 %7lld us p90 %7lld us p99 %7lld us max %7lld us",
+                   phase_name,
+                   (long long)percentiles.p50_usec, (long long)percentiles.p90_usec,
+                   (long long)percentiles.p99_usec, (long long)percentiles.max_usec);
+    }
+    return sniff_blocks;
+}
+/******************************************
+ * end scrappy_doo_run_phase()
+ ******************************************/
+
+/*!**************************************************************
+ * scrappy_doo_run_media_error()
+ ****************************************************************
+ * @brief
+ *  Inject a media error, run sniff over it and make sure the
+ *  checkpoint still gets past the chunks around the error.
+ *
+ * @param pvd_object_id - Drive sniff runs on.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void scrappy_doo_run_media_error(fbe_object_id_t pvd_object_id)
+{
+    fbe_status_t                                        status;
+    fbe_api_logical_error_injection_get_object_stats_t  pvd_stats;
+    fbe_provision_drive_get_verify_status_t             verify_status;
+    fbe_u32_t                                           total_time_ms = 0;
+
+    mut_printf(MUT_LOG_TEST_STATUS, "== %s media error at lba 0x%llx of pvd 0x%x ==",
+               __FUNCTION__, (unsigned long long)SCRAPPY_DOO_MEDIA_ERROR_LBA, pvd_object_id);
+
+    status = fbe_test_sep_util_provision_drive_disable_verify(pvd_object_id);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    status = fbe_test_sep_util_provision_drive_clear_verify_report(pvd_object_id);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    status = fbe_api_logical_error_injection_disable_records(0, 255);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    status = fbe_api_logical_error_injection_create_record(&scrappy_doo_error_record);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    status = fbe_api_logical_error_injection_enable_object(pvd_object_id, FBE_PACKAGE_ID_SEP_0);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    status = fbe_api_logical_error_injection_enable();
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    status = fbe_test_sep_util_provision_drive_set_verify_checkpoint(pvd_object_id, 0);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    status = fbe_test_sep_util_provision_drive_enable_verify(pvd_object_id);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    /* Each media error found in a hot chunk used to queue the chunks around it
+     * again, so sniff verified them forever and the checkpoint never moved.
+     */
+    for ( ; ; )
+    {
+        status = fbe_test_sep_util_provision_drive_get_verify_status(pvd_object_id, &verify_status);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+        if (verify_status.verify_checkpoint > SCRAPPY_DOO_MEDIA_ERROR_END_LBA)
+        {
+            break;
+        }
+        if (total_time_ms >= FBE_TEST_WAIT_TIMEOUT_MS)
+        {
+            mut_printf(MUT_LOG_TEST_STATUS, "sniff checkpoint stuck at 0x%llx",
+                       (unsigned long long)verify_status.verify_checkpoint);
+            MUT_FAIL();
+        }
+        fbe_api_sleep(500);
+        total_time_ms += 500;
+    }
+
+    status = fbe_test_sep_util_provision_drive_disable_verify(pvd_object_id);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    status = fbe_api_logical_error_injection_get_object_stats(&pvd_stats, pvd_object_id);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    mut_printf(MUT_LOG_TEST_STATUS, "   media errors injected: %lld, checkpoint: 0x%llx",
+               (long long)pvd_stats.num_read_media_errors_injected,
+               (unsigned long long)verify_status.verify_checkpoint);
+    MUT_ASSERT_TRUE(pvd_stats.num_read_media_errors_injected > 0);
+
+    status = fbe_api_logical_error_injection_disable_object(pvd_object_id, FBE_PACKAGE_ID_SEP_0);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    status = fbe_api_logical_error_injection_disable();
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    return;
+}
+/******************************************
+ * end scrappy_doo_run_media_error()
+ ******************************************/
+
+/*!**************************************************************
+ * scrappy_doo_test_rg_config()
+ ****************************************************************
+ * @brief
+ *  Measure sniff and host I/O with sniff off, with the host idle and
+ *  with intermittent host I/O, then run sniff over a media error.
+ *
+ * @param rg_config_p - config to run test against.
+ * @param context_p - not used.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void scrappy_doo_test_rg_config(fbe_test_rg_configuration_t *rg_config_p, void * context_p)
+{
+    fbe_status_t    status;
+    fbe_object_id_t lun_object_id;
+    fbe_object_id_t pvd_object_id;
+    fbe_lba_t       sniff_blocks;
+    fbe_u64_t       busy_cycles;
+    fbe_u64_t       idle_cycles;
+    fbe_provision_drive_get_verify_status_t verify_status;
+
+    status = fbe_api_database_lookup_lun_by_number(rg_config_p->logical_unit_configuration_list[0].lun_number, &lun_object_id);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    status = fbe_api_provision_drive_get_obj_id_by_location(rg_config_p->rg_disk_set[0].bus,
+                                                            rg_config_p->rg_disk_set[0].enclosure,
+                                                            rg_config_p->rg_disk_set[0].slot,
+                                                            &pvd_object_id);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    /* Sniff does not run until zeroing is done.
+     */
+    status = fbe_test_zero_wait_for_disk_zeroing_complete(pvd_object_id, FBE_TEST_HOOK_WAIT_MSEC);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    mut_printf(MUT_LOG_TEST_STATUS, "== %s sniff pacing of pvd 0x%x ==", __FUNCTION__, pvd_object_id);
+
+    status = fbe_test_sep_util_provision_drive_disable_verify(pvd_object_id);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    scrappy_doo_run_phase(lun_object_id, pvd_object_id, FBE_TRUE, "no sniff, intermittent load",
+                          &busy_cycles, &idle_cycles, &verify_status);
+
+    status = fbe_test_sep_util_provision_drive_set_verify_checkpoint(pvd_object_id, 0);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    status = fbe_test_sep_util_provision_drive_enable_verify(pvd_object_id);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    /* Sniff only stays at the busy delay until the host has been idle for a
+     * couple of seconds, after that it keeps speeding up.
+     */
+    sniff_blocks = scrappy_doo_run_phase(lun_object_id, pvd_object_id, FBE_FALSE, "sniff, idle",
+                                         &busy_cycles, &idle_cycles, &verify_status);
+    MUT_ASSERT_TRUE(sniff_blocks > 0);
+    MUT_ASSERT_TRUE(idle_cycles > busy_cycles);
+    MUT_ASSERT_TRUE(verify_status.sniff_reschedule_ms < SCRAPPY_DOO_BUSY_RESCHEDULE_MS);
+
+    /* Every burst must push sniff back to the busy delay at least once, and
+     * every idle gap is long enough for it to speed up again.
+     */
+    scrappy_doo_run_phase(lun_object_id, pvd_object_id, FBE_TRUE, "sniff, intermittent load",
+                          &busy_cycles, &idle_cycles, &verify_status);
+    MUT_ASSERT_TRUE(busy_cycles >= SCRAPPY_DOO_CYCLES);
+    MUT_ASSERT_TRUE(idle_cycles > 0);
+
+    scrappy_doo_run_media_error(pvd_object_id);
+    return;
+}
+/******************************************
+ * end scrappy_doo_test_rg_config()
+ ******************************************/
+
+/*!**************************************************************
+ * scrappy_doo_test()
+ ****************************************************************
+ * @brief
+ *  Run the sniff pacing test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void scrappy_doo_test(void)
+{
+    fbe_test_run_test_on_rg_config(&scrappy_doo_raid_group_config[0], NULL, scrappy_doo_test_rg_config,
+                                   SCRAPPY_DOO_LUNS_PER_RAID_GROUP,
+                                   SCRAPPY_DOO_CHUNKS_PER_LUN);
+    return;
+}
+/******************************************
+ * end scrappy_doo_test()
+ ******************************************/
+
+/*!**************************************************************
+ * scrappy_doo_setup()
+ ****************************************************************
+ * @brief
+ *  Setup for the sniff pacing test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void scrappy_doo_setup(void)
+{
+    mut_printf(MUT_LOG_HIGH, "%s entry", __FUNCTION__);
+
+    /* Only load the physical config in simulation.
+     */
+    if (fbe_test_util_is_simulation())
+    {
+        fbe_test_rg_configuration_t *rg_config_p = &scrappy_doo_raid_group_config[0];
+
+        fbe_test_sep_util_init_rg_configuration_array(rg_config_p);
+        elmo_load_config(rg_config_p,
+                         SCRAPPY_DOO_LUNS_PER_RAID_GROUP,
+                         SCRAPPY_DOO_CHUNKS_PER_LUN);
+    }
+
+    /* Initialize any required fields
+     */
+    fbe_test_common_util_test_setup_init();
+    return;
+}
+/**************************************
+ * end scrappy_doo_setup()
+ **************************************/
+
+/*!**************************************************************
+ * scrappy_doo_cleanup()
+ ****************************************************************
+ * @brief
+ *  Cleanup the sniff pacing test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void scrappy_doo_cleanup(void)
+{
+    mut_printf(MUT_LOG_HIGH, "%s entry", __FUNCTION__);
+
+    if (fbe_test_util_is_simulation())
+    {
+        fbe_test_sep_util_destroy_neit_sep_physical();
+    }
+    return;
+}
+/******************************************
+ * end scrappy_doo_cleanup()
+ ******************************************/
+
+/*************************
+ * end file scrappy_doo_test.c
+ *************************/
@@ -0,0 +1,403 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2014
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!**************************************************************************
+ * @file hoots_the_owl_test.c
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains a test that fails a drive of many raid groups at once
+ *  and reports how long it takes until the permanent spares start to
+ *  rebuild.  All the spare requests are queued to the job service at the
+ *  same time so this measures the spare selection.  The spare index is
+ *  verified against the selection that asks every pvd.
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "mut.h"
+#include "sep_tests.h"
+#include "fbe/fbe_api_rdgen_interface.h"
+#include "fbe/fbe_api_common.h"
+#include "fbe/fbe_api_terminator_interface.h"
+#include "fbe/fbe_api_virtual_drive_interface.h"
+#include "fbe/fbe_api_provision_drive_interface.h"
+#include "fbe/fbe_api_discovery_interface.h"
+#include "fbe/fbe_api_job_service_interface.h"
+#include "fbe/fbe_api_database_interface.h"
+#include "fbe/fbe_api_utils.h"
+#include "fbe_test_package_config.h"
+#include "fbe_test_configurations.h"
+#include "fbe_test_common_utils.h"
+#include "sep_utils.h"
+#include "pp_utils.h"
+#include "sep_rebuild_utils.h"
+#include "fbe_spare.h"
+
+/*************************
+ *   FUNCTION DEFINITIONS
+ *************************/
+
+char * hoots_the_owl_short_desc = "time to rebuild after many drives fail at once";
+char * hoots_the_owl_long_desc ="\
+The Hoots the Owl scenario fails one drive of many raid groups at the same time and measures\n\
+how long the spare selection takes to get all of them rebuilding.\n\
+\n\
+STEP 1: configure raid 5 and raid 1 raid groups with one spare drive each.\n\
+        - set the permanent spare trigger time to 1 second.\n\
+        - verify the spare index: every selection is repeated asking every pvd.\n\
+\n\
+STEP 2: remove the first drive of every raid group at once.\n\
+        - wait for every raid group to start rebuilding a permanent spare.\n\
+        - report the time to the first and to the last rebuild.\n\
+        - make sure every raid group swapped in a different one of the spare drives.\n\
+        - make sure the spare index was used and selected the same spares and\n\
+          returned the same spare info as asking every pvd.\n\
+        - wait for the rebuilds to complete and check the data.\n\
+\n\
+STEP 3: destroy the configuration.\n\
+\n"
+"Description last updated: 10/19/2026.\n";
+
+/*!*******************************************************************
+ * @def HOOTS_THE_OWL_LUNS_PER_RAID_GROUP
+ *********************************************************************
+ * @brief Number of LUNs in each raid group.
+ *
+ *********************************************************************/
+#define HOOTS_THE_OWL_LUNS_PER_RAID_GROUP 1
+
+/*!*******************************************************************
+ * @def HOOTS_THE_OWL_CHUNKS_PER_LUN
+ *********************************************************************
+ * @brief Number of chunks each LUN will occupy.
+ *
+ *********************************************************************/
+#define HOOTS_THE_OWL_CHUNKS_PER_LUN 3
+
+/*!*******************************************************************
+ * @def HOOTS_THE_OWL_POSITION_TO_REMOVE
+ *********************************************************************
+ * @brief Position we remove from every raid group.
+ *
+ *********************************************************************/
+#define HOOTS_THE_OWL_POSITION_TO_REMOVE 0
+
+/*!*******************************************************************
+ * @def HOOTS_THE_OWL_MAX_RAID_GROUPS
+ *********************************************************************
+ * @brief Maximum number of raid groups in the configuration.
+ *
+ *********************************************************************/
+#define HOOTS_THE_OWL_MAX_RAID_GROUPS 8
+
+/*!*******************************************************************
+ * @var hoots_the_owl_raid_group_config
+ *********************************************************************
+ * @brief Raid groups that all lose a drive at once.
+ *
+ *********************************************************************/
+static fbe_test_rg_configuration_t hoots_the_owl_raid_group_config[HOOTS_THE_OWL_MAX_RAID_GROUPS + 1] =
+{
+    /* width,   capacity    raid type,                  class,                  block size      RAID-id.    bandwidth.*/
+    {3,       0x8000,     FBE_RAID_GROUP_TYPE_RAID5,  FBE_CLASS_ID_PARITY,      520,            0,          0},
+    {3,       0x8000,     FBE_RAID_GROUP_TYPE_RAID5,  FBE_CLASS_ID_PARITY,      520,            1,          0},
+    {3,       0x8000,     FBE_RAID_GROUP_TYPE_RAID5,  FBE_CLASS_ID_PARITY,      520,            2,          0},
+    {3,       0x8000,     FBE_RAID_GROUP_TYPE_RAID5,  FBE_CLASS_ID_PARITY,      520,            3,          0},
+    {2,       0x8000,     FBE_RAID_GROUP_TYPE_RAID1,  FBE_CLASS_ID_MIRROR,      520,            4,          0},
+    {2,       0x8000,     FBE_RAID_GROUP_TYPE_RAID1,  FBE_CLASS_ID_MIRROR,      520,            5,          0},
+    {2,       0x8000,     FBE_RAID_GROUP_TYPE_RAID1,  FBE_CLASS_ID_MIRROR,      520,            6,          0},
+    {2,       0x8000,     FBE_RAID_GROUP_TYPE_RAID1,  FBE_CLASS_ID_MIRROR,      520,            7,          0},
+    {FBE_U32_MAX, FBE_U32_MAX, FBE_U32_MAX, /* Terminator. */},
+};
+
+/*!*******************************************************************
+ * @var hoots_the_owl_test_context_g
+ *********************************************************************
+ * @brief Context for the background pattern of the LUNs.
+ *
+ *********************************************************************/
+static fbe_api_rdgen_context_t hoots_the_owl_test_context_g[HOOTS_THE_OWL_LUNS_PER_RAID_GROUP * HOOTS_THE_OWL_MAX_RAID_GROUPS];
+
+/*!**************************************************************
+ * hoots_the_owl_check_spare()
+ ****************************************************************
+ * @brief
+ *  Make sure the permanent spare swapped into the removed position
+ *  is one of the spare drives and was not used by a raid group we
+ *  already checked.  The raid group then refers to its spare.
+ *
+ * @param rg_config_p - all the raid groups.
+ * @param rg_index - raid group to check.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void hoots_the_owl_check_spare(fbe_test_rg_configuration_t *rg_config_p, fbe_u32_t rg_index)
+{
+    fbe_status_t                    status;
+    fbe_object_id_t                 rg_object_id;
+    fbe_object_id_t                 vd_object_id;
+    fbe_edge_index_t                edge_index;
+    fbe_api_get_block_edge_info_t   edge_info;
+    fbe_u32_t                       bus;
+    fbe_u32_t                       enclosure;
+    fbe_u32_t                       slot;
+    fbe_u32_t                       index;
+    fbe_u32_t                       extra_index;
+    fbe_bool_t                      b_found = FBE_FALSE;
+
+    fbe_test_sep_util_get_raid_group_object_id(&rg_config_p[rg_index], &rg_object_id);
+    status = fbe_test_sep_util_get_virtual_drive_object_id_by_position(rg_object_id, HOOTS_THE_OWL_POSITION_TO_REMOVE,
+                                                                       &vd_object_id);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    fbe_test_sep_drive_get_permanent_spare_edge_index(vd_object_id, &edge_index);
+    status = fbe_api_get_block_edge_info(vd_object_id, edge_index, &edge_info, FBE_PACKAGE_ID_SEP_0);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    status = fbe_api_provision_drive_get_location(edge_info.server_id, &bus, &enclosure, &slot);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    /* The spares are the extra drives of the raid groups.
+     */
+    for (index = 0; (index < fbe_test_get_rg_array_length(rg_config_p)) && !b_found; index++)
+    {
+        for (extra_index = 0; extra_index < rg_config_p[index].num_of_extra_drives; extra_index++)
+        {
+            if ((rg_config_p[index].extra_disk_set[extra_index].bus == bus)             &&
+                (rg_config_p[index].extra_disk_set[extra_index].enclosure == enclosure) &&
+                (rg_config_p[index].extra_disk_set[extra_index].slot == slot)              )
+            {
+                b_found = FBE_TRUE;
+                break;
+            }
+        }
+    }
+    if (!b_found)
+    {
+        mut_printf(MUT_LOG_TEST_STATUS, "rg %d swapped in %d_%d_%d which is not a spare drive",
+                   rg_config_p[rg_index].raid_group_id, bus, enclosure, slot);
+        MUT_FAIL();
+    }
+
+    /* Each spare can only be swapped into one raid group.
+     */
+    for (index = 0; index < rg_index; index++)
+    {
+        if ((rg_config_p[index].rg_disk_set[HOOTS_THE_OWL_POSITION_TO_REMOVE].bus == bus)             &&
+            (rg_config_p[index].rg_disk_set[HOOTS_THE_OWL_POSITION_TO_REMOVE].enclosure == enclosure) &&
+            (rg_config_p[index].rg_disk_set[HOOTS_THE_OWL_POSITION_TO_REMOVE].slot == slot)              )
+        {
+            mut_printf(MUT_LOG_TEST_STATUS, "rg %d and rg %d both swapped in %d_%d_%d",
+                       rg_config_p[index].raid_group_id, rg_config_p[rg_index].raid_group_id, bus, enclosure, slot);
+            MUT_FAIL();
+        }
+    }
+    rg_config_p[rg_index].rg_disk_set[HOOTS_THE_OWL_POSITION_TO_REMOVE].bus = bus;
+    rg_config_p[rg_index].rg_disk_set[HOOTS_THE_OWL_POSITION_TO_REMOVE].enclosure = enclosure;
+    rg_config_p[rg_index].rg_disk_set[HOOTS_THE_OWL_POSITION_TO_REMOVE].slot = slot;
+    return;
+}
+/******************************************
+ * end hoots_the_owl_check_spare()
+ ******************************************/
+
+/*!**************************************************************
+ * hoots_the_owl_test_rg_config()
+ ****************************************************************
+ * @brief
+ *  Remove a drive of every raid group at once and time the
+ *  start of the rebuilds.
+ *
+ * @param rg_config_p - config to run test against.
+ * @param context_p - not used.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void hoots_the_owl_test_rg_config(fbe_test_rg_configuration_t *rg_config_p, void * context_p)
+{
+    fbe_status_t                        status;
+    fbe_u32_t                           raid_group_count = fbe_test_get_rg_array_length(rg_config_p);
+    fbe_u32_t                           rg_index;
+    fbe_api_terminator_device_handle_t  drive_handle[HOOTS_THE_OWL_MAX_RAID_GROUPS];
+    fbe_time_t                          start_time;
+    fbe_u32_t                           elapsed_msec;
+    fbe_u32_t                           first_msec = FBE_U32_MAX;
+    fbe_u32_t                           last_msec = 0;
+    fbe_job_service_spare_index_info_t  spare_index_info;
+
+    MUT_ASSERT_TRUE(raid_group_count <= HOOTS_THE_OWL_MAX_RAID_GROUPS);
+
+    for (rg_index = 0; rg_index < raid_group_count; rg_index++)
+    {
+        fbe_test_sep_util_wait_for_initial_verify(&rg_config_p[rg_index]);
+    }
+    sep_rebuild_utils_write_bg_pattern(&hoots_the_owl_test_context_g[0], SEP_REBUILD_UTILS_ELEMENT_SIZE);
+
+    fbe_api_control_automatic_hot_spare(FBE_TRUE);
+    status = fbe_test_sep_util_update_permanent_spare_trigger_timer(1); /* 1 second hotspare timeout */
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    status = fbe_api_job_service_set_spare_index_verify(FBE_TRUE);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    /* Remove the drives back to back so that the spare requests are all
+     * queued to the job service together.
+     */
+    mut_printf(MUT_LOG_TEST_STATUS, "== %s remove position %d of %d raid groups ==",
+               __FUNCTION__, HOOTS_THE_OWL_POSITION_TO_REMOVE, raid_group_count);
+    start_time = fbe_get_time();
+    for (rg_index = 0; rg_index < raid_group_count; rg_index++)
+    {
+        status = fbe_test_sep_drive_pull_drive(&rg_config_p[rg_index].rg_disk_set[HOOTS_THE_OWL_POSITION_TO_REMOVE],
+                                               &drive_handle[rg_index]);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    }
+
+    /* We wait for the raid groups in order, so the first time is an upper
+     * bound of the first rebuild to start.
+     */
+    for (rg_index = 0; rg_index < raid_group_count; rg_index++)
+    {
+        sep_rebuild_utils_wait_for_rb_to_start(&rg_config_p[rg_index], HOOTS_THE_OWL_POSITION_TO_REMOVE);
+        elapsed_msec = fbe_get_elapsed_milliseconds(start_time);
+        first_msec = FBE_MIN(first_msec, elapsed_msec);
+        last_msec = FBE_MAX(last_msec, elapsed_msec);
+    }
+
+    mut_printf(MUT_LOG_TEST_STATUS, "   %d raid groups: first rebuild started after %d ms, all rebuilds started after %d ms",
+               raid_group_count, first_msec, last_msec);
+
+    for (rg_index = 0; rg_index < raid_group_count; rg_index++)
+    {
+        hoots_the_owl_check_spare(rg_config_p, rg_index);
+    }
+
+    /* The selections after the first find the other spares in the index, and
+     * asking every pvd instead must not change the info or the spare picked.
+     */
+    status = fbe_api_job_service_get_spare_index_info(&spare_index_info);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    mut_printf(MUT_LOG_TEST_STATUS, "   spare index hits: %d misses: %d lookup mismatches: %d selections: %d selection mismatches: %d",
+               spare_index_info.hits, spare_index_info.misses, spare_index_info.lookup_mismatches,
+               spare_index_info.verified_selections, spare_index_info.selection_mismatches);
+    MUT_ASSERT_TRUE(spare_index_info.b_verify);
+    MUT_ASSERT_TRUE(spare_index_info.hits > 0);
+    MUT_ASSERT_TRUE(spare_index_info.verified_selections >= raid_group_count);
+    MUT_ASSERT_INT_EQUAL(0, spare_index_info.lookup_mismatches);
+    MUT_ASSERT_INT_EQUAL(0, spare_index_info.selection_mismatches);
+    status = fbe_api_job_service_set_spare_index_verify(FBE_FALSE);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    for (rg_index = 0; rg_index < raid_group_count; rg_index++)
+    {
+        sep_rebuild_utils_wait_for_rb_comp(&rg_config_p[rg_index], HOOTS_THE_OWL_POSITION_TO_REMOVE);
+    }
+    sep_rebuild_utils_read_bg_pattern(&hoots_the_owl_test_context_g[0], SEP_REBUILD_UTILS_ELEMENT_SIZE);
+    return;
+}
+/******************************************
+ * end hoots_the_owl_test_rg_config()
+ ******************************************/
+
+/*!**************************************************************
+ * hoots_the_owl_test()
+ ****************************************************************
+ * @brief
+ *  Run the many drives failure test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void hoots_the_owl_test(void)
+{
+    fbe_test_sep_util_set_dualsp_test_mode(FBE_FALSE);
+    fbe_test_run_test_on_rg_config(&hoots_the_owl_raid_group_config[0], NULL, hoots_the_owl_test_rg_config,
+                                   HOOTS_THE_OWL_LUNS_PER_RAID_GROUP,
+                                   HOOTS_THE_OWL_CHUNKS_PER_LUN);
+    return;
+}
+/******************************************
+ * end hoots_the_owl_test()
+ ******************************************/
+
+/*!**************************************************************
+ * hoots_the_owl_setup()
+ ****************************************************************
+ * @brief
+ *  Setup for the many drives failure test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void hoots_the_owl_setup(void)
+{
+    mut_printf(MUT_LOG_HIGH, "%s entry", __FUNCTION__);
+
+    /* Only load the physical config in simulation.
+     */
+    if (fbe_test_util_is_simulation())
+    {
+        fbe_test_rg_configuration_t *rg_config_p = &hoots_the_owl_raid_group_config[0];
+        fbe_u32_t                    num_raid_groups;
+
+        fbe_test_sep_util_init_rg_configuration_array(rg_config_p);
+        num_raid_groups = fbe_test_get_rg_array_length(rg_config_p);
+
+        /* The extra drives are the permanent spares.
+         */
+        fbe_test_sep_util_populate_rg_num_extra_drives(rg_config_p);
+        fbe_test_create_physical_config_for_rg(rg_config_p, num_raid_groups);
+        sep_config_load_sep_and_neit();
+    }
+
+    /* Initialize any required fields
+     */
+    fbe_test_common_util_test_setup_init();
+    return;
+}
+/**************************************
+ * end hoots_the_owl_setup()
+ **************************************/
+
+/*!**************************************************************
+ * hoots_the_owl_cleanup()
+ ****************************************************************
+ * @brief
+ *  Cleanup the hoots_the_owl test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void hoots_the_owl_cleanup(void)
+{
+    mut_printf(MUT_LOG_HIGH, "%s entry", __FUNCTION__);
+
+    /* Restore the default for the tests that follow.
+     */
+    fbe_test_sep_util_update_permanent_spare_trigger_timer(FBE_SPARE_DEFAULT_SWAP_IN_TRIGGER_TIME);
+    fbe_api_job_service_set_spare_index_verify(FBE_FALSE);
+
+    if (fbe_test_util_is_simulation())
+    {
+        fbe_test_sep_util_destroy_neit_sep_physical();
+    }
+    return;
+}
+/******************************************
+ * end hoots_the_owl_cleanup()
+ ******************************************/
+
+/*************************
+ * end file hoots_the_owl_test.c
+ *************************/
@@ -0,0 +1,372 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2009
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!**************************************************************************
+ * @file mr_noodle_test.c
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains a test of how many checkpoint updates a background
+ *  verify sends to the peer for the amount of work it does, with and
+ *  without checkpoint batching.
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "mut.h"
+#include "sep_tests.h"
+#include "fbe/fbe_winddk.h"
+#include "fbe/fbe_api_common.h"
+#include "fbe_test_package_config.h"
+#include "fbe_test_configurations.h"
+#include "sep_utils.h"
+#include "fbe/fbe_api_utils.h"
+#include "fbe/fbe_api_sim_server.h"
+#include "fbe/fbe_api_database_interface.h"
+#include "fbe/fbe_api_raid_group_interface.h"
+#include "fbe/fbe_api_provision_drive_interface.h"
+#include "fbe/fbe_api_base_config_interface.h"
+#include "pp_utils.h"
+#include "fbe_test_common_utils.h"
+
+/*************************
+ *   FUNCTION DEFINITIONS
+ *************************/
+
+char * mr_noodle_short_desc = "verify invalidate checkpoint peer updates per GB";
+char * mr_noodle_long_desc ="\
+The Mr Noodle scenario checks that a background verify batches the checkpoint updates it sends to the peer.\n\
+\n\
+STEP 1: configure a raid 5 raid group with one LUN on both SPs.\n\
+        - wait for the zeroing of the first drive to finish and disable its sniff.\n\
+\n\
+STEP 2: run a verify invalidate of the whole first drive with checkpoint batching disabled.\n\
+        - count the nonpaged metadata writes and the messages the drive sent to the peer.\n\
+\n\
+STEP 3: run the same verify invalidate with checkpoint batching enabled.\n\
+        - make sure fewer peer messages per GB were sent than with batching disabled.\n\
+\n\
+STEP 4: destroy the configuration.\n\
+\n"
+"Description last updated: 10/19/2026.\n";
+
+/*!*******************************************************************
+ * @def MR_NOODLE_LUNS_PER_RAID_GROUP
+ *********************************************************************
+ * @brief Number of LUNs in the raid group.
+ *
+ *********************************************************************/
+#define MR_NOODLE_LUNS_PER_RAID_GROUP 1
+
+/*!*******************************************************************
+ * @def MR_NOODLE_CHUNKS_PER_LUN
+ *********************************************************************
+ * @brief Number of chunks each LUN will occupy.
+ *
+ *********************************************************************/
+#define MR_NOODLE_CHUNKS_PER_LUN 32
+
+/*!*******************************************************************
+ * @def MR_NOODLE_BLOCKS_PER_GB
+ *********************************************************************
+ * @brief Blocks in a GB of verify work.
+ *
+ *********************************************************************/
+#define MR_NOODLE_BLOCKS_PER_GB 0x200000
+
+/*!*******************************************************************
+ * @def MR_NOODLE_VERIFY_WAIT_MSEC
+ *********************************************************************
+ * @brief Most time we wait for a verify invalidate of the drive.
+ *
+ *********************************************************************/
+#define MR_NOODLE_VERIFY_WAIT_MSEC 120000
+
+/*!*******************************************************************
+ * @var mr_noodle_raid_group_config
+ *********************************************************************
+ * @brief Raid group whose first drive we verify.
+ *
+ *********************************************************************/
+static fbe_test_rg_configuration_t mr_noodle_raid_group_config[] =
+{
+    /* width,   capacity    raid type,                  class,                  block size      RAID-id.    bandwidth.*/
+    {5,       0xE000,     FBE_RAID_GROUP_TYPE_RAID5,  FBE_CLASS_ID_PARITY,      520,            0,          0},
+    {FBE_U32_MAX, FBE_U32_MAX, FBE_U32_MAX, /* Terminator. */},
+};
+
+/*!**************************************************************
+ * mr_noodle_set_batch_enabled()
+ ****************************************************************
+ * @brief
+ *  Enable or disable verify invalidate checkpoint batching on
+ *  both SPs.
+ *
+ * @param b_enabled - FBE_TRUE to batch peer updates.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void mr_noodle_set_batch_enabled(fbe_bool_t b_enabled)
+{
+    fbe_status_t                            status;
+    fbe_sim_transport_connection_target_t   current_target;
+
+    current_target = fbe_api_sim_transport_get_target_server();
+
+    fbe_api_sim_transport_set_target_server(FBE_SIM_SP_A);
+    status = fbe_api_provision_drive_set_verify_invalidate_batch_enabled(b_enabled);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    fbe_api_sim_transport_set_target_server(FBE_SIM_SP_B);
+    status = fbe_api_provision_drive_set_verify_invalidate_batch_enabled(b_enabled);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    fbe_api_sim_transport_set_target_server(current_target);
+    return;
+}
+/******************************************
+ * end mr_noodle_set_batch_enabled()
+ ******************************************/
+
+/*!**************************************************************
+ * mr_noodle_run_verify_invalidate()
+ ****************************************************************
+ * @brief
+ *  Verify invalidate the whole drive on the SP where the drive is
+ *  active and count what the drive wrote and sent to the peer.
+ *
+ * @param pvd_object_id - Drive to verify.
+ * @param b_batch_enabled - FBE_TRUE to batch peer updates.
+ * @param messages_per_gb_p - Peer messages per GB verified.
+ * @param writes_per_gb_p - Nonpaged metadata writes per GB verified.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void mr_noodle_run_verify_invalidate(fbe_object_id_t pvd_object_id,
+                                            fbe_bool_t b_batch_enabled,
+                                            fbe_u64_t *messages_per_gb_p,
+                                            fbe_u64_t *writes_per_gb_p)
+{
+    fbe_status_t                                    status;
+    fbe_api_provision_drive_info_t                  pvd_info;
+    fbe_api_base_config_get_metadata_statistics_t   start_stats;
+    fbe_api_base_config_get_metadata_statistics_t   end_stats;
+    fbe_lba_t                                       checkpoint = 0;
+    fbe_u64_t                                       messages;
+    fbe_u64_t                                       writes;
+    fbe_u32_t                                       elapsed_msec = 0;
+
+    mr_noodle_set_batch_enabled(b_batch_enabled);
+
+    status = fbe_api_provision_drive_get_info(pvd_object_id, &pvd_info);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    status = fbe_api_base_config_get_metadata_statistics(pvd_object_id, &start_stats);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    mut_printf(MUT_LOG_TEST_STATUS, "== %s verify invalidate pvd: 0x%x capacity: 0x%llx batching: %d ==",
+               __FUNCTION__, pvd_object_id, (unsigned long long)pvd_info.capacity, b_batch_enabled);
+    status = fbe_api_provision_drive_set_verify_invalidate_checkpoint(pvd_object_id, 0);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    /* The checkpoint goes back to invalid once the whole drive is verified.
+     */
+    while (elapsed_msec < MR_NOODLE_VERIFY_WAIT_MSEC)
+    {
+        status = fbe_api_provision_drive_get_verify_invalidate_checkpoint(pvd_object_id, &checkpoint);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+        if (checkpoint == FBE_LBA_INVALID)
+        {
+            break;
+        }
+        fbe_api_sleep(100);
+        elapsed_msec += 100;
+    }
+    MUT_ASSERT_UINT64_EQUAL_MSG(FBE_LBA_INVALID, checkpoint, "verify invalidate did not finish\n");
+
+    status = fbe_api_base_config_get_metadata_statistics(pvd_object_id, &end_stats);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    messages = end_stats.cmi_message_count - start_stats.cmi_message_count;
+    writes = end_stats.nonpaged_write_count - start_stats.nonpaged_write_count;
+
+    /* Both SPs are up, so at least the final checkpoint went to the peer.
+     */
+    MUT_ASSERT_TRUE(messages > 0);
+    MUT_ASSERT_TRUE(writes > 0);
+
+    *messages_per_gb_p = (messages * MR_NOODLE_BLOCKS_PER_GB) / FBE_MAX(pvd_info.capacity, 1);
+    *writes_per_gb_p = (writes * MR_NOODLE_BLOCKS_PER_GB) / FBE_MAX(pvd_info.capacity, 1);
+    mut_printf(MUT_LOG_TEST_STATUS, "   %lld nonpaged writes (%lld per GB), %lld peer messages (%lld per GB)",
+               (long long)writes, (long long)*writes_per_gb_p,
+               (long long)messages, (long long)*messages_per_gb_p);
+    return;
+}
+/******************************************
+ * end mr_noodle_run_verify_invalidate()
+ ******************************************/
+
+/*!**************************************************************
+ * mr_noodle_test_rg_config()
+ ****************************************************************
+ * @brief
+ *  Verify invalidate the first drive of the raid group with
+ *  batching disabled and enabled and compare the peer updates.
+ *
+ * @param rg_config_p - config to run test against.
+ * @param context_p - not used.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void mr_noodle_test_rg_config(fbe_test_rg_configuration_t *rg_config_p, void * context_p)
+{
+    fbe_status_t                            status;
+    fbe_object_id_t                         pvd_object_id;
+    fbe_sim_transport_connection_target_t   current_target;
+    fbe_sim_transport_connection_target_t   active_sp;
+    fbe_sim_transport_connection_target_t   passive_sp;
+    fbe_u64_t                               unbatched_messages_per_gb;
+    fbe_u64_t                               unbatched_writes_per_gb;
+    fbe_u64_t                               batched_messages_per_gb;
+    fbe_u64_t                               batched_writes_per_gb;
+
+    current_target = fbe_api_sim_transport_get_target_server();
+
+    status = fbe_api_provision_drive_get_obj_id_by_location(rg_config_p->rg_disk_set[0].bus,
+                                                            rg_config_p->rg_disk_set[0].enclosure,
+                                                            rg_config_p->rg_disk_set[0].slot,
+                                                            &pvd_object_id);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    /* Only the verify invalidate should move a checkpoint of the drive while we count.
+     */
+    status = fbe_test_zero_wait_for_disk_zeroing_complete(pvd_object_id, FBE_TEST_WAIT_TIMEOUT_MS);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    status = fbe_test_sep_util_provision_drive_disable_verify(pvd_object_id);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    /* The drive counts the messages on the SP that runs the verify invalidate.
+     */
+    fbe_test_sep_util_get_active_passive_sp(pvd_object_id, &active_sp, &passive_sp);
+    fbe_api_sim_transport_set_target_server(active_sp);
+
+    mr_noodle_run_verify_invalidate(pvd_object_id, FBE_FALSE, &unbatched_messages_per_gb, &unbatched_writes_per_gb);
+    mr_noodle_run_verify_invalidate(pvd_object_id, FBE_TRUE, &batched_messages_per_gb, &batched_writes_per_gb);
+
+    MUT_ASSERT_TRUE(batched_messages_per_gb < unbatched_messages_per_gb);
+
+    fbe_api_sim_transport_set_target_server(current_target);
+    return;
+}
+/******************************************
+ * end mr_noodle_test_rg_config()
+ ******************************************/
+
+/*!**************************************************************
+ * mr_noodle_dualsp_test()
+ ****************************************************************
+ * @brief
+ *  Run the verify invalidate checkpoint test on both SPs.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void mr_noodle_dualsp_test(void)
+{
+    fbe_test_sep_util_set_dualsp_test_mode(FBE_TRUE);
+
+    fbe_test_run_test_on_rg_config(&mr_noodle_raid_group_config[0], NULL, mr_noodle_test_rg_config,
+                                   MR_NOODLE_LUNS_PER_RAID_GROUP,
+                                   MR_NOODLE_CHUNKS_PER_LUN);
+
+    /* Always clear dualsp mode and put back the default batching.
+     */
+    mr_noodle_set_batch_enabled(FBE_TRUE);
+    fbe_test_sep_util_set_dualsp_test_mode(FBE_FALSE);
+    return;
+}
+/******************************************
+ * end mr_noodle_dualsp_test()
+ ******************************************/
+
+/*!**************************************************************
+ * mr_noodle_dualsp_setup()
+ ****************************************************************
+ * @brief
+ *  Setup for the verify invalidate checkpoint test on both SPs.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void mr_noodle_dualsp_setup(void)
+{
+    mut_printf(MUT_LOG_HIGH, "%s entry", __FUNCTION__);
+
+    /* Only load the physical config in simulation.
+     */
+    if (fbe_test_util_is_simulation())
+    {
+        fbe_test_rg_configuration_t *rg_config_p = &mr_noodle_raid_group_config[0];
+        fbe_u32_t raid_group_count;
+
+        fbe_test_sep_util_init_rg_configuration_array(rg_config_p);
+        raid_group_count = fbe_test_get_rg_array_length(rg_config_p);
+
+        /* The terminator does not instantiate the drives on both SPs, so create them on each.
+         */
+        fbe_api_sim_transport_set_target_server(FBE_SIM_SP_A);
+        elmo_create_physical_config_for_rg(rg_config_p, raid_group_count);
+        fbe_api_sim_transport_set_target_server(FBE_SIM_SP_B);
+        elmo_create_physical_config_for_rg(rg_config_p, raid_group_count);
+
+        fbe_api_sim_transport_set_target_server(FBE_SIM_SP_A);
+        sep_config_load_sep_and_neit_both_sps();
+    }
+
+    /* Initialize any required fields
+     */
+    fbe_test_common_util_test_setup_init();
+    return;
+}
+/**************************************
+ * end mr_noodle_dualsp_setup()
+ **************************************/
+
+/*!**************************************************************
+ * mr_noodle_dualsp_cleanup()
+ ****************************************************************
+ * @brief
+ *  Cleanup the mr noodle test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void mr_noodle_dualsp_cleanup(void)
+{
+    mut_printf(MUT_LOG_HIGH, "%s entry", __FUNCTION__);
+
+    if (fbe_test_util_is_simulation())
+    {
+        fbe_test_sep_util_destroy_neit_sep_physical_both_sps();
+    }
+    return;
+}
+/******************************************
+ * end mr_noodle_dualsp_cleanup()
+ ******************************************/
+
+/*************************
+ * end file mr_noodle_test.c
+ *************************/
@@ -0,0 +1,626 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2009
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!**************************************************************************
+ * @file wile_e_coyote_test.c
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains a test of random writes to a freshly zeroed LUN, where
+ *  every first write to a chunk is a zero on demand write.  It reports the
+ *  IOPS of every interval while the chunks get consumed.
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "mut.h"
+#include "fbe/fbe_api_rdgen_interface.h"
+#include "sep_tests.h"
+#include "fbe/fbe_api_common.h"
+#include "fbe_test_package_config.h"
+#include "fbe_test_configurations.h"
+#include "sep_utils.h"
+#include "fbe/fbe_api_utils.h"
+#include "fbe/fbe_api_sim_server.h"
+#include "fbe/fbe_api_database_interface.h"
+#include "pp_utils.h"
+#include "fbe_test_common_utils.h"
+
+/*************************
+ *   FUNCTION DEFINITIONS
+ *************************/
+
+char * wile_e_coyote_short_desc = "zero on demand write IOPS on a freshly zeroed LUN";
+char * wile_e_coyote_long_desc ="\
+The Wile E. Coyote scenario runs random writes to a LUN whose chunks all need zeroing.\n\
+\n\
+STEP 1: configure a raid 0 raid group with one LUN.\n\
+        Steps 2 to 5 run with zero on demand paged update batching disabled, then enabled.\n\
+\n\
+STEP 2: disable background zeroing and zero the LUN,\n\
+        so that every chunk of the LUN needs zero on demand.\n\
+\n\
+STEP 3: run random 4K writes for a fixed amount of time.\n\
+        - report the IOPS of every interval.\n\
+        - the first writes to a chunk zero it and update the paged metadata,\n\
+          concurrent updates of a paged block are batched by the provision drive.\n\
+        - make sure no I/O failed.\n\
+        - make sure writes were batched only when batching is enabled.\n\
+\n\
+STEP 4: zero the LUN again and run one write/read/check pass over the whole LUN.\n\
+        - make sure no I/O failed and the data reads back.\n\
+\n\
+STEP 5: make sure every chunk of the LUN on every drive is consumed and no longer needs zero.\n\
+\n\
+STEP 6: enable background zeroing and destroy the configuration.\n\
+\n"
+"Description last updated: 10/19/2026.\n";
+
+/*!*******************************************************************
+ * @def WILE_E_COYOTE_LUNS_PER_RAID_GROUP
+ *********************************************************************
+ * @brief Number of LUNs in the raid group.
+ *
+ *********************************************************************/
+#define WILE_E_COYOTE_LUNS_PER_RAID_GROUP 1
+
+/*!*******************************************************************
+ * @def WILE_E_COYOTE_CHUNKS_PER_LUN
+ *********************************************************************
+ * @brief Number of chunks each LUN will occupy.
+ *
+ *********************************************************************/
+#define WILE_E_COYOTE_CHUNKS_PER_LUN 32
+
+/*!*******************************************************************
+ * @def WILE_E_COYOTE_INTERVALS
+ *********************************************************************
+ * @brief Number of one second intervals we report IOPS for.
+ *
+ *********************************************************************/
+#define WILE_E_COYOTE_INTERVALS 10
+
+/*!*******************************************************************
+ * @def WILE_E_COYOTE_BLOCKS
+ *********************************************************************
+ * @brief Size of each write.
+ *
+ *********************************************************************/
+#define WILE_E_COYOTE_BLOCKS 8
+
+/*!*******************************************************************
+ * @def WILE_E_COYOTE_THREADS
+ *********************************************************************
+ * @brief Number of outstanding writes.
+ *
+ *********************************************************************/
+#define WILE_E_COYOTE_THREADS 32
+
+/*!*******************************************************************
+ * @def WILE_E_COYOTE_ZERO_BLOCKS
+ *********************************************************************
+ * @brief Size of each zero request when we zero the LUN.
+ *
+ *********************************************************************/
+#define WILE_E_COYOTE_ZERO_BLOCKS 0x800
+
+/*!*******************************************************************
+ * @def WILE_E_COYOTE_CHUNK_SIZE
+ *********************************************************************
+ * @brief Provision drive chunk size, one paged metadata record each.
+ *
+ *********************************************************************/
+#define WILE_E_COYOTE_CHUNK_SIZE 0x800
+
+/*!*******************************************************************
+ * @var wile_e_coyote_raid_group_config
+ *********************************************************************
+ * @brief Raid group we run I/O to.
+ *
+ *********************************************************************/
+static fbe_test_rg_configuration_t wile_e_coyote_raid_group_config[] =
+{
+    /* width,   capacity    raid type,                  class,                  block size      RAID-id.    bandwidth.*/
+    {3,       0x32000,    FBE_RAID_GROUP_TYPE_RAID0,  FBE_CLASS_ID_STRIPER,     520,            0,          0},
+    {FBE_U32_MAX, FBE_U32_MAX, FBE_U32_MAX, /* Terminator. */},
+};
+
+/*!**************************************************************
+ * wile_e_coyote_zero_lun()
+ ****************************************************************
+ * @brief
+ *  Zero the whole LUN so that its chunks need zeroing on the
+ *  provision drives.
+ *
+ * @param lun_object_id - LUN to zero.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void wile_e_coyote_zero_lun(fbe_object_id_t lun_object_id)
+{
+    fbe_status_t            status;
+    fbe_api_rdgen_context_t rdgen_context;
+
+    status = fbe_api_rdgen_test_context_init(&rdgen_context,
+                                             lun_object_id,
+                                             FBE_CLASS_ID_INVALID,
+                                             FBE_PACKAGE_ID_SEP_0,
+                                             FBE_RDGEN_OPERATION_ZERO_ONLY,
+                                             FBE_RDGEN_PATTERN_ZEROS,
+                                             1,    /* passes */
+                                             0,    /* io count not used */
+                                             0,    /* time not used */
+                                             1,    /* threads */
+                                             FBE_RDGEN_LBA_SPEC_SEQUENTIAL_INCREASING,
+                                             0,    /* start lba */
+                                             0,    /* min lba */
+                                             FBE_LBA_INVALID, /* use capacity */
+                                             FBE_RDGEN_BLOCK_SPEC_CONSTANT,
+                                             WILE_E_COYOTE_ZERO_BLOCKS,
+                                             WILE_E_COYOTE_ZERO_BLOCKS);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    status = fbe_api_rdgen_test_context_run_all_tests(&rdgen_context, FBE_PACKAGE_ID_NEIT, 1);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    MUT_ASSERT_INT_EQUAL(rdgen_context.start_io.statistics.error_count, 0);
+
+    status = fbe_api_rdgen_test_context_destroy(&rdgen_context);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    return;
+}
+/******************************************
+ * end wile_e_coyote_zero_lun()
+ ******************************************/
+
+/*!**************************************************************
+ * wile_e_coyote_get_batch_counts()
+ ****************************************************************
+ * @brief
+ *  Sum the zero on demand batching counters of the drives
+ *  of the raid group.
+ *
+ * @param rg_config_p - raid group to get the counters of.
+ * @param update_count_p - batched paged updates issued.
+ * @param batched_count_p - writes that joined another write's update.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void wile_e_coyote_get_batch_counts(fbe_test_rg_configuration_t *rg_config_p,
+                                           fbe_u64_t *update_count_p,
+                                           fbe_u64_t *batched_count_p)
+{
+    fbe_status_t                                status;
+    fbe_object_id_t                             pvd_object_id;
+    fbe_provision_drive_get_zod_batch_info_t    batch_info;
+    fbe_u32_t                                   index;
+
+    *update_count_p = 0;
+    *batched_count_p = 0;
+    for (index = 0; index < rg_config_p->width; index++)
+    {
+        status = fbe_api_provision_drive_get_obj_id_by_location(rg_config_p->rg_disk_set[index].bus,
+                                                                rg_config_p->rg_disk_set[index].enclosure,
+                                                                rg_config_p->rg_disk_set[index].slot,
+                                                                &pvd_object_id);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+        status = fbe_api_provision_drive_get_zod_batch_info(pvd_object_id, &batch_info);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+        *update_count_p += batch_info.update_count;
+        *batched_count_p += batch_info.batched_count;
+    }
+    return;
+}
+/******************************************
+ * end wile_e_coyote_get_batch_counts()
+ ******************************************/
+
+/*!**************************************************************
+ * wile_e_coyote_random_writes()
+ ****************************************************************
+ * @brief
+ *  Run random writes to the zeroed LUN and report IOPS over time.
+ *
+ * @param lun_object_id - LUN to write.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void wile_e_coyote_random_writes(fbe_object_id_t lun_object_id)
+{
+    fbe_status_t                status;
+    fbe_api_rdgen_context_t     rdgen_context;
+    fbe_api_rdgen_get_stats_t   stats;
+    fbe_rdgen_filter_t          filter;
+    fbe_u32_t                   interval;
+    fbe_u32_t                   last_io_count = 0;
+    fbe_u32_t                   elapsed_msec;
+    fbe_time_t                  interval_start;
+
+    mut_printf(MUT_LOG_TEST_STATUS, "== %s random %d block writes, %d threads ==",
+               __FUNCTION__, WILE_E_COYOTE_BLOCKS, WILE_E_COYOTE_THREADS);
+    status = fbe_api_rdgen_test_context_init(&rdgen_context,
+                                             lun_object_id,
+                                             FBE_CLASS_ID_INVALID,
+                                             FBE_PACKAGE_ID_SEP_0,
+                                             FBE_RDGEN_OPERATION_WRITE_ONLY,
+                                             FBE_RDGEN_PATTERN_LBA_PASS,
+                                             0,    /* passes (manual stop) */
+                                             0,    /* io count not used */
+                                             0,    /* time not used */
+                                             WILE_E_COYOTE_THREADS,
+                                             FBE_RDGEN_LBA_SPEC_RANDOM,
+                                             0,    /* start lba */
+                                             0,    /* min lba */
+                                             FBE_LBA_INVALID, /* use capacity */
+                                             FBE_RDGEN_BLOCK_SPEC_CONSTANT,
+                                             WILE_E_COYOTE_BLOCKS,
+                                             WILE_E_COYOTE_BLOCKS);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    status = fbe_api_rdgen_filter_init(&filter, FBE_RDGEN_FILTER_TYPE_OBJECT, lun_object_id,
+                                       FBE_CLASS_ID_INVALID, FBE_PACKAGE_ID_SEP_0, 0);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    status = fbe_api_rdgen_start_tests(&rdgen_context, FBE_PACKAGE_ID_NEIT, 1);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    /* The early intervals are mostly zero on demand writes.
+     */
+    for (interval = 0; interval < WILE_E_COYOTE_INTERVALS; interval++)
+    {
+        interval_start = fbe_get_time();
+        fbe_api_sleep(FBE_TIME_MILLISECONDS_PER_SECOND);
+
+        status = fbe_api_rdgen_get_stats(&stats, &filter);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+        elapsed_msec = fbe_get_elapsed_milliseconds(interval_start);
+
+        mut_printf(MUT_LOG_TEST_STATUS, "   interval %2d: %6d IOPS, %8d writes total",
+                   interval + 1,
+                   (fbe_u32_t)(((fbe_u64_t)(stats.io_count - last_io_count) * FBE_TIME_MILLISECONDS_PER_SECOND) /
+                               FBE_MAX(elapsed_msec, 1)),
+                   stats.io_count);
+        MUT_ASSERT_INT_EQUAL(stats.error_count, 0);
+        last_io_count = stats.io_count;
+    }
+
+    status = fbe_api_rdgen_stop_tests(&rdgen_context, 1);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    MUT_ASSERT_INT_EQUAL(rdgen_context.start_io.statistics.error_count, 0);
+    MUT_ASSERT_TRUE(rdgen_context.start_io.statistics.io_count > 0);
+
+    status = fbe_api_rdgen_test_context_destroy(&rdgen_context);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    return;
+}
+/******************************************
+ * end wile_e_coyote_random_writes()
+ ******************************************/
+
+/*!**************************************************************
+ * wile_e_coyote_write_read_check()
+ ****************************************************************
+ * @brief
+ *  Write, read back and check every block of the zeroed LUN
+ *  once.  The threads walk the LUN together so that neighbouring
+ *  chunks are written concurrently.
+ *
+ * @param lun_object_id - LUN to write.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void wile_e_coyote_write_read_check(fbe_object_id_t lun_object_id)
+{
+    fbe_status_t            status;
+    fbe_api_rdgen_context_t rdgen_context;
+
+    mut_printf(MUT_LOG_TEST_STATUS, "== %s write/read/check the LUN ==", __FUNCTION__);
+    status = fbe_api_rdgen_test_context_init(&rdgen_context,
+                                             lun_object_id,
+                                             FBE_CLASS_ID_INVALID,
+                                             FBE_PACKAGE_ID_SEP_0,
+                                             FBE_RDGEN_OPERATION_WRITE_READ_CHECK,
+                                             FBE_RDGEN_PATTERN_LBA_PASS,
+                                             1,    /* passes */
+                                             0,    /* io count not used */
+                                             0,    /* time not used */
+                                             WILE_E_COYOTE_THREADS,
+                                             FBE_RDGEN_LBA_SPEC_CATERPILLAR_INCREASING,
+                                             0,    /* start lba */
+                                             0,    /* min lba */
+                                             FBE_LBA_INVALID, /* use capacity */
+                                             FBE_RDGEN_BLOCK_SPEC_CONSTANT,
+                                             WILE_E_COYOTE_BLOCKS,
+                                             WILE_E_COYOTE_BLOCKS);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    status = fbe_api_rdgen_test_context_run_all_tests(&rdgen_context, FBE_PACKAGE_ID_NEIT, 1);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    MUT_ASSERT_INT_EQUAL(rdgen_context.start_io.statistics.error_count, 0);
+
+    status = fbe_api_rdgen_test_context_destroy(&rdgen_context);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    return;
+}
+/******************************************
+ * end wile_e_coyote_write_read_check()
+ ******************************************/
+
+/*!**************************************************************
+ * wile_e_coyote_check_paged()
+ ****************************************************************
+ * @brief
+ *  Make sure the paged metadata of every chunk of the LUN on
+ *  every drive is marked consumed and no longer needs zero.
+ *
+ * @param rg_config_p - raid group of the LUN.
+ * @param lun_object_id - LUN that was written.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void wile_e_coyote_check_paged(fbe_test_rg_configuration_t *rg_config_p,
+                                      fbe_object_id_t lun_object_id)
+{
+    fbe_status_t                                    status;
+    fbe_object_id_t                                 rg_object_id;
+    fbe_object_id_t                                 pvd_object_id;
+    fbe_api_lun_get_lun_info_t                      lun_info;
+    fbe_api_base_config_metadata_paged_get_bits_t   paged_get_bits;
+    fbe_api_provisional_drive_paged_bits_t *        pvd_metadata_p = NULL;
+    fbe_u64_t                                       pba_start;
+    fbe_u64_t                                       pba_end;
+    fbe_chunk_index_t                               chunk_index;
+    fbe_u32_t                                       index;
+
+    status = fbe_api_database_lookup_raid_group_by_number(rg_config_p->raid_group_id, &rg_object_id);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    status = fbe_api_lun_get_lun_info(lun_object_id, &lun_info);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    /* Only the chunks entirely within the user area of the LUN are written.
+     */
+    status = fbe_api_raid_group_get_physical_from_logical_lba(rg_object_id, lun_info.offset, &pba_start);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    status = fbe_api_raid_group_get_physical_from_logical_lba(rg_object_id,
+                                                              lun_info.offset + rg_config_p->logical_unit_configuration_list[0].capacity,
+                                                              &pba_end);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    mut_printf(MUT_LOG_TEST_STATUS, "== %s check chunks 0x%llx to 0x%llx ==", __FUNCTION__,
+               (unsigned long long)(pba_start / WILE_E_COYOTE_CHUNK_SIZE),
+               (unsigned long long)(pba_end / WILE_E_COYOTE_CHUNK_SIZE));
+
+    for (index = 0; index < rg_config_p->width; index++)
+    {
+        status = fbe_api_provision_drive_get_obj_id_by_location(rg_config_p->rg_disk_set[index].bus,
+                                                                rg_config_p->rg_disk_set[index].enclosure,
+                                                                rg_config_p->rg_disk_set[index].slot,
+                                                                &pvd_object_id);
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+        for (chunk_index = pba_start / WILE_E_COYOTE_CHUNK_SIZE; chunk_index < pba_end / WILE_E_COYOTE_CHUNK_SIZE; chunk_index++)
+        {
+            paged_get_bits.metadata_offset = chunk_index * sizeof(fbe_provision_drive_paged_metadata_t);
+            paged_get_bits.metadata_record_data_size = sizeof(fbe_api_provisional_drive_paged_bits_t);
+            * (fbe_u32_t *)paged_get_bits.metadata_record_data = 0;
+            paged_get_bits.get_bits_flags = 0;
+            status = fbe_api_base_config_metadata_paged_get_bits(pvd_object_id, &paged_get_bits);
+            MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+            pvd_metadata_p = (fbe_api_provisional_drive_paged_bits_t *)&paged_get_bits.metadata_record_data[0];
+            if ((pvd_metadata_p->need_zero_bit != 0) || (pvd_metadata_p->consumed_user_data_bit != 1))
+            {
+                mut_printf(MUT_LOG_TEST_STATUS, "pvd 0x%x chunk 0x%llx paged bits nz:%d cu:%d",
+                           pvd_object_id, (unsigned long long)chunk_index,
+                           pvd_metadata_p->need_zero_bit, pvd_metadata_p->consumed_user_data_bit);
+            }
+            MUT_ASSERT_INT_EQUAL(pvd_metadata_p->need_zero_bit, 0);
+            MUT_ASSERT_INT_EQUAL(pvd_metadata_p->consumed_user_data_bit, 1);
+        }
+    }
+    return;
+}
+/******************************************
+ * end wile_e_coyote_check_paged()
+ ******************************************/
+
+/*!**************************************************************
+ * wile_e_coyote_run_mode()
+ ****************************************************************
+ * @brief
+ *  Zero the LUN and write it with zero on demand paged update
+ *  batching enabled or disabled.
+ *
+ * @param rg_config_p - raid group of the LUN.
+ * @param lun_object_id - LUN to write.
+ * @param b_batch - FBE_TRUE to batch paged updates.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void wile_e_coyote_run_mode(fbe_test_rg_configuration_t *rg_config_p,
+                                   fbe_object_id_t lun_object_id,
+                                   fbe_bool_t b_batch)
+{
+    fbe_status_t    status;
+    fbe_u64_t       start_update_count;
+    fbe_u64_t       start_batched_count;
+    fbe_u64_t       update_count;
+    fbe_u64_t       batched_count;
+
+    mut_printf(MUT_LOG_TEST_STATUS, "== %s zero on demand batching %s ==",
+               __FUNCTION__, (b_batch) ? "enabled" : "disabled");
+    status = fbe_api_provision_drive_set_zod_batch_enabled(b_batch);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    wile_e_coyote_zero_lun(lun_object_id);
+    wile_e_coyote_get_batch_counts(rg_config_p, &start_update_count, &start_batched_count);
+
+    wile_e_coyote_random_writes(lun_object_id);
+
+    wile_e_coyote_get_batch_counts(rg_config_p, &update_count, &batched_count);
+    update_count -= start_update_count;
+    batched_count -= start_batched_count;
+    mut_printf(MUT_LOG_TEST_STATUS, "   %llu batched paged updates, %llu writes joined another update",
+               (unsigned long long)update_count, (unsigned long long)batched_count);
+
+    /* With 32 writes outstanding to the few paged blocks of the LUN some of them 
+     * always finish while an update of their block is in flight. 
+     */
+    if (b_batch)
+    {
+        MUT_ASSERT_TRUE(update_count > 0);
+        MUT_ASSERT_TRUE(batched_count > 0);
+    }
+    else
+    {
+        MUT_ASSERT_UINT64_EQUAL(update_count, 0);
+        MUT_ASSERT_UINT64_EQUAL(batched_count, 0);
+    }
+
+    /* Every chunk needs zero again, so the pass below marks all of them.
+     */
+    wile_e_coyote_zero_lun(lun_object_id);
+    wile_e_coyote_write_read_check(lun_object_id);
+    wile_e_coyote_check_paged(rg_config_p, lun_object_id);
+    return;
+}
+/******************************************
+ * end wile_e_coyote_run_mode()
+ ******************************************/
+
+/*!**************************************************************
+ * wile_e_coyote_test_rg_config()
+ ****************************************************************
+ * @brief
+ *  Run random writes to the zeroed LUN without and with
+ *  zero on demand paged update batching.
+ *
+ * @param rg_config_p - config to run test against.
+ * @param context_p - not used.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void wile_e_coyote_test_rg_config(fbe_test_rg_configuration_t *rg_config_p, void * context_p)
+{
+    fbe_status_t                status;
+    fbe_object_id_t             lun_object_id;
+
+    status = fbe_api_database_lookup_lun_by_number(rg_config_p->logical_unit_configuration_list[0].lun_number, &lun_object_id);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    /* Without background zeroing the chunks stay need zero until written.
+     */
+    status = fbe_test_sep_drive_disable_background_zeroing_for_all_pvds();
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+    /* Batching is the default, so run it last and leave it enabled.
+     */
+    wile_e_coyote_run_mode(rg_config_p, lun_object_id, FBE_FALSE);
+    wile_e_coyote_run_mode(rg_config_p, lun_object_id, FBE_TRUE);
+
+    status = fbe_test_sep_drive_enable_background_zeroing_for_all_pvds();
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    return;
+}
+/******************************************
+ * end wile_e_coyote_test_rg_config()
+ ******************************************/
+
+/*!**************************************************************
+ * wile_e_coyote_test()
+ ****************************************************************
+ * @brief
+ *  Run the zero on demand write test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void wile_e_coyote_test(void)
+{
+    fbe_test_run_test_on_rg_config(&wile_e_coyote_raid_group_config[0], NULL, wile_e_coyote_test_rg_config,
+                                   WILE_E_COYOTE_LUNS_PER_RAID_GROUP,
+                                   WILE_E_COYOTE_CHUNKS_PER_LUN);
+    return;
+}
+/******************************************
+ * end wile_e_coyote_test()
+ ******************************************/
+
+/*!**************************************************************
+ * wile_e_coyote_setup()
+ ****************************************************************
+ * @brief
+ *  Setup for the zero on demand write test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void wile_e_coyote_setup(void)
+{
+    mut_printf(MUT_LOG_HIGH, "%s entry", __FUNCTION__);
+
+    /* Only load the physical config in simulation.
+     */
+    if (fbe_test_util_is_simulation())
+    {
+        fbe_test_rg_configuration_t *rg_config_p = &wile_e_coyote_raid_group_config[0];
+
+        fbe_test_sep_util_init_rg_configuration_array(rg_config_p);
+        elmo_load_config(rg_config_p,
+                         WILE_E_COYOTE_LUNS_PER_RAID_GROUP,
+                         WILE_E_COYOTE_CHUNKS_PER_LUN);
+    }
+
+    /* Initialize any required fields
+     */
+    fbe_test_common_util_test_setup_init();
+    return;
+}
+/**************************************
+ * end wile_e_coyote_setup()
+ **************************************/
+
+/*!**************************************************************
+ * wile_e_coyote_cleanup()
+ ****************************************************************
+ * @brief
+ *  Cleanup the wile e coyote test.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void wile_e_coyote_cleanup(void)
+{
+    mut_printf(MUT_LOG_HIGH, "%s entry", __FUNCTION__);
+
+    if (fbe_test_util_is_simulation())
+    {
+        fbe_test_sep_util_destroy_neit_sep_physical();
+    }
+    return;
+}
+/******************************************
+ * end wile_e_coyote_cleanup()
+ ******************************************/
+
+/*************************
+ * end file wile_e_coyote_test.c
+ *************************/
@@ -1717,6 +1717,93 @@ fbe_status_t FBE_API_CALL fbe_api_traffic_trace_disable(fbe_u32_t object_tag,
  * end fbe_api_traffic_trace_disable()
  **************************************/
 
+/*!***************************************************************
+ *  fbe_api_traffic_trace_set_filter()
+ *****************************************************************
+ * @brief
+ *   This function sets or clears the RBA trace filter of one class.
+ *   A class with a filter is traced even if RBA tracing is not
+ *   enabled for it.
+ *
+ * @param filter_p - The filter to set.
+ * @param package_id - Package of the objects to trace.
+ * 
+ * @return fbe_status_t - FBE_STATUS_GENERIC_FAILURE if any issue
+ *
+ ****************************************************************/
+fbe_status_t FBE_API_CALL fbe_api_traffic_trace_set_filter(fbe_traffic_trace_filter_t *filter_p,
+                                                            fbe_package_id_t package_id)
+{
+    fbe_status_t status;
+    fbe_api_control_operation_status_info_t status_info;
+
+    status = fbe_api_common_send_control_packet_to_service(FBE_TRAFFIC_TRACE_CONTROL_CODE_SET_FILTER,
+                                                           filter_p,
+                                                           sizeof(fbe_traffic_trace_filter_t),
+                                                           FBE_SERVICE_ID_TRAFFIC_TRACE,
+                                                           FBE_PACKET_FLAG_NO_ATTRIB,
+                                                           &status_info,
+                                                           package_id);
+    if (status != FBE_STATUS_OK) 
+    {
+        fbe_api_trace (FBE_TRACE_LEVEL_ERROR, "%s: can't send control packet\n", __FUNCTION__); 
+        return status;
+    }
+
+    if (status_info.control_operation_status != FBE_PAYLOAD_CONTROL_STATUS_OK) 
+    {
+        fbe_api_trace (FBE_TRACE_LEVEL_ERROR, "%s: set request failed\n", __FUNCTION__); 
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+    return FBE_STATUS_OK;
+}
+/**************************************
+ * end fbe_api_traffic_trace_set_filter()
+ **************************************/
+
+/*!***************************************************************
+ *  fbe_api_traffic_trace_get_records()
+ *****************************************************************
+ * @brief
+ *   This function reads the binary RBA trace records saved by the
+ *   filters, starting at get_records_p->next_sequence.
+ *
+ * @param get_records_p - The sequence to read and the records read.
+ * @param package_id - Package to read the records of.
+ * 
+ * @return fbe_status_t - FBE_STATUS_GENERIC_FAILURE if any issue
+ *
+ ****************************************************************/
+fbe_status_t FBE_API_CALL fbe_api_traffic_trace_get_records(fbe_traffic_trace_get_records_t *get_records_p,
+                                                            fbe_package_id_t package_id)
+{
+    fbe_status_t status;
+    fbe_api_control_operation_status_info_t status_info;
+
+    status = fbe_api_common_send_control_packet_to_service(FBE_TRAFFIC_TRACE_CONTROL_CODE_GET_RECORDS,
+                                                           get_records_p,
+                                                           sizeof(fbe_traffic_trace_get_records_t),
+                                                           FBE_SERVICE_ID_TRAFFIC_TRACE,
+                                                           FBE_PACKET_FLAG_NO_ATTRIB,
+                                                           &status_info,
+                                                           package_id);
+    if (status != FBE_STATUS_OK) 
+    {
+        fbe_api_trace (FBE_TRACE_LEVEL_ERROR, "%s: can't send control packet\n", __FUNCTION__); 
+        return status;
+    }
+
+    if (status_info.control_operation_status != FBE_PAYLOAD_CONTROL_STATUS_OK) 
+    {
+        fbe_api_trace (FBE_TRACE_LEVEL_ERROR, "%s: get request failed\n", __FUNCTION__); 
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+    return FBE_STATUS_OK;
+}
+/**************************************
+ * end fbe_api_traffic_trace_get_records()
+ **************************************/
+
 /*!***************************************************************
  * @fn fbe_api_common_send_control_packet_to_service_with_sg_list(
  *       fbe_payload_control_operation_opcode_t control_code,
@@ -1618,6 +1618,126 @@ fbe_status_t fbe_api_rdgen_reset_stats(void)
 /**************************************
  * end fbe_api_rdgen_reset_stats()
  **************************************/
+/*!**************************************************************
+ * fbe_api_rdgen_get_latency_histogram()
+ ****************************************************************
+ * @brief
+ *  Get the read and write latency histograms from rdgen.
+ *  The in process histograms are merged over the active threads
+ *  matching the filter, the historical histograms cover all
+ *  threads that finished since the last reset of statistics.
+ *
+ * @param histogram_p - structure to return the histograms in.
+ * @param filter_p - filter for the in process histograms.
+ *
+ * @return fbe_status_t
+ *
+ ****************************************************************/
+fbe_status_t fbe_api_rdgen_get_latency_histogram(fbe_rdgen_control_get_latency_histogram_t *histogram_p,
+                                                fbe_rdgen_filter_t *filter_p)
+{
+    fbe_api_control_operation_status_info_t status_info;
+    fbe_status_t status;
+
+    histogram_p->filter = *filter_p;
+
+    status = fbe_api_common_send_control_packet_to_service(FBE_RDGEN_CONTROL_CODE_GET_LATENCY_HISTOGRAM,
+                                                           histogram_p,
+                                                           sizeof(fbe_rdgen_control_get_latency_histogram_t),
+                                                           FBE_SERVICE_ID_RDGEN,
+                                                           FBE_PACKET_FLAG_NO_ATTRIB,
+                                                           &status_info,
+                                                           FBE_PACKAGE_ID_NEIT);
+
+    if (status != FBE_STATUS_OK) {
+        fbe_api_trace (FBE_TRACE_LEVEL_ERROR, "%s: can't send control packet\n", __FUNCTION__); 
+        return status;
+    }
+    
+    if ((status_info.packet_status != FBE_STATUS_OK) ||
+        (status_info.control_operation_status != FBE_PAYLOAD_CONTROL_STATUS_OK)) {
+        fbe_api_trace(FBE_TRACE_LEVEL_ERROR,
+                   "%s get latency failed packet_status: 0x%x qual: 0x%x "
+                   "control payload status: 0x%x control qualifier: 0x%x\n",
+                   __FUNCTION__, status_info.packet_status, status_info.packet_qualifier,
+                   status_info.control_operation_status, status_info.control_operation_qualifier);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+    return FBE_STATUS_OK;
+}
+/**************************************
+ * end fbe_api_rdgen_get_latency_histogram()
+ **************************************/
+/*!**************************************************************
+ * fbe_api_rdgen_latency_histogram_get_percentile()
+ ****************************************************************
+ * @brief
+ *  Find the latency below which the given percentage of samples fall.
+ *
+ * @param histogram_p - histogram to search.
+ * @param percentile_x100 - percentile times 100, so 9990 is p99.9.
+ *
+ * @return Upper bound in microseconds of the bucket holding the
+ *         percentile, capped at the largest sample.  0 if empty.
+ *
+ ****************************************************************/
+fbe_u64_t fbe_api_rdgen_latency_histogram_get_percentile(fbe_rdgen_latency_histogram_t *histogram_p,
+                                                         fbe_u32_t percentile_x100)
+{
+    fbe_u64_t target;
+    fbe_u64_t count = 0;
+    fbe_u32_t bucket;
+
+    if (histogram_p->total_count == 0)
+    {
+        return 0;
+    }
+    /* Rank of the sample we are looking for, rounded up.
+     */
+    target = ((histogram_p->total_count * percentile_x100) + 9999) / 10000;
+    if (target == 0)
+    {
+        target = 1;
+    }
+    for (bucket = 0; bucket < FBE_RDGEN_LATENCY_HISTOGRAM_BUCKETS; bucket++)
+    {
+        count += histogram_p->buckets[bucket];
+        if (count >= target)
+        {
+            return FBE_MIN(fbe_rdgen_latency_histogram_get_bucket_max_usec(bucket), histogram_p->max_usec);
+        }
+    }
+    return histogram_p->max_usec;
+}
+/**************************************
+ * end fbe_api_rdgen_latency_histogram_get_percentile()
+ **************************************/
+/*!**************************************************************
+ * fbe_api_rdgen_latency_histogram_get_percentiles()
+ ****************************************************************
+ * @brief
+ *  Compute the standard set of percentiles for a histogram.
+ *
+ * @param histogram_p - histogram to summarize.
+ * @param percentiles_p - output percentiles.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void fbe_api_rdgen_latency_histogram_get_percentiles(fbe_rdgen_latency_histogram_t *histogram_p,
+                                                     fbe_api_rdgen_latency_percentiles_t *percentiles_p)
+{
+    percentiles_p->count = histogram_p->total_count;
+    percentiles_p->p50_usec = fbe_api_rdgen_latency_histogram_get_percentile(histogram_p, 5000);
+    percentiles_p->p90_usec = fbe_api_rdgen_latency_histogram_get_percentile(histogram_p, 9000);
+    percentiles_p->p99_usec = fbe_api_rdgen_latency_histogram_get_percentile(histogram_p, 9900);
+    percentiles_p->p99_9_usec = fbe_api_rdgen_latency_histogram_get_percentile(histogram_p, 9990);
+    percentiles_p->max_usec = histogram_p->max_usec;
+    return;
+}
+/**************************************
+ * end fbe_api_rdgen_latency_histogram_get_percentiles()
+ **************************************/
 /*!**************************************************************
  * fbe_api_rdgen_get_thread_info()
  ****************************************************************
@@ -4650,6 +4770,121 @@ fbe_status_t fbe_api_rdgen_set_msec_delay(fbe_rdgen_io_specification_t *io_spec_
 /******************************************
  * end fbe_api_rdgen_set_msec_delay()
  ******************************************/
+
+/*!**************************************************************
+ *  fbe_api_rdgen_io_specification_set_arrival_rate()
+ ****************************************************************
+ * @brief
+ *  Make the I/Os of this spec arrive on a schedule (open loop)
+ *  instead of back to back.  The rate is for the whole object and
+ *  is split across the spec's threads, so the threads bound how
+ *  many I/Os can be outstanding once the target saturates.
+ *
+ * @param io_spec_p - io spec to init.
+ * @param arrival_mode - Fixed rate, poisson or closed loop.
+ * @param arrival_iops - Target I/Os per second (0 for closed loop).
+ *
+ * @return fbe_status_t FBE_STATUS_OK if success.   
+ *
+ ****************************************************************/
+
+fbe_status_t fbe_api_rdgen_io_specification_set_arrival_rate(fbe_rdgen_io_specification_t *io_spec_p,
+                                                             fbe_rdgen_arrival_mode_t arrival_mode,
+                                                             fbe_u32_t arrival_iops)
+{
+    if ((io_spec_p == NULL) ||
+        (arrival_mode >= FBE_RDGEN_ARRIVAL_MODE_LAST) ||
+        ((arrival_mode != FBE_RDGEN_ARRIVAL_MODE_CLOSED_LOOP) && (arrival_iops == 0)))
+    {
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    io_spec_p->arrival_mode = arrival_mode;
+    io_spec_p->arrival_iops = (arrival_mode == FBE_RDGEN_ARRIVAL_MODE_CLOSED_LOOP) ? 0 : arrival_iops;
+    return FBE_STATUS_OK;
+}
+/******************************************
+ * end fbe_api_rdgen_io_specification_set_arrival_rate()
+ ******************************************/
+
+/*!**************************************************************
+ *  fbe_api_rdgen_filter_init_for_playback_trace()
+ ****************************************************************
+ * @brief
+ *  Initialize the filter to replay a text block trace.
+ *  A text trace describes I/O to one device, so unlike an rdgen
+ *  playback the target object is given here instead of in the file.
+ *
+ * @param filter_p - filter to init.
+ * @param file_name_p - Full path of the trace file.
+ * @param object_id - Object to replay the trace to.
+ * @param package_id - Package of the object.
+ *
+ * @return fbe_status_t - FBE_STATUS_OK on success.
+ *
+ ****************************************************************/
+
+fbe_status_t fbe_api_rdgen_filter_init_for_playback_trace(fbe_rdgen_filter_t *filter_p,
+                                                          fbe_char_t *file_name_p,
+                                                          fbe_object_id_t object_id,
+                                                          fbe_package_id_t package_id)
+{
+    fbe_status_t status;
+
+    if (object_id == FBE_OBJECT_ID_INVALID)
+    {
+        fbe_api_trace(FBE_TRACE_LEVEL_ERROR, "%s object id is invalid\n", __FUNCTION__);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+    status = fbe_api_rdgen_filter_init_for_playback(filter_p, FBE_RDGEN_FILTER_TYPE_PLAYBACK_SEQUENCE, file_name_p);
+    if (status != FBE_STATUS_OK)
+    {
+        return status;
+    }
+    filter_p->object_id = object_id;
+    filter_p->package_id = package_id;
+    return FBE_STATUS_OK;
+}
+/******************************************
+ * end fbe_api_rdgen_filter_init_for_playback_trace()
+ ******************************************/
+
+/*!**************************************************************
+ *  fbe_api_rdgen_io_specification_set_playback_trace()
+ ****************************************************************
+ * @brief
+ *  Select the format of the playback file and how fast to
+ *  replay its recorded times.  Use the extra options
+ *  FBE_RDGEN_EXTRA_OPTIONS_PLAYBACK_SCALE_LBA and
+ *  FBE_RDGEN_EXTRA_OPTIONS_PLAYBACK_NO_TIMING to scale lbas
+ *  or to drop the recorded timing.
+ *
+ * @param io_spec_p - io spec to init.
+ * @param format - Format of the playback file.
+ * @param time_scale_percent - Percent of the recorded time to take
+ *                             (100 or 0 is as recorded).
+ *
+ * @return fbe_status_t FBE_STATUS_OK if success.   
+ *
+ ****************************************************************/
+
+fbe_status_t fbe_api_rdgen_io_specification_set_playback_trace(fbe_rdgen_io_specification_t *io_spec_p,
+                                                               fbe_rdgen_playback_format_t format,
+                                                               fbe_u32_t time_scale_percent)
+{
+    if ((io_spec_p == NULL) ||
+        (format >= FBE_RDGEN_PLAYBACK_FORMAT_LAST))
+    {
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    io_spec_p->playback_format = format;
+    io_spec_p->playback_time_scale_percent = time_scale_percent;
+    return FBE_STATUS_OK;
+}
+/******************************************
+ * end fbe_api_rdgen_io_specification_set_playback_trace()
+ ******************************************/
 /*!***************************************************************
  * fbe_api_rdgen_set_svc_options()
  ****************************************************************
@@ -4066,6 +4066,53 @@ fbe_status_t FBE_API_CALL fbe_api_enclosure_set_enclosure_failed(fbe_object_id_t
     return status;
 }   // end of fbe_api_enclosure_get_eir_info
 
+/*!*******************************************************************
+ * @fn fbe_api_enclosure_status_page_stats(
+ *     fbe_object_id_t object_id, 
+ *     fbe_enclosure_mgmt_status_page_stats_t *stats) 
+ *********************************************************************
+ * @brief:
+ *  This function gets the status page processing statistics of an
+ *  ESES enclosure. It can also turn the incremental status page
+ *  processing on or off and clear the statistics.
+ *
+ * @param object_id - The object id to send request to
+ * @param stats (INPUT/OUTPUT) - the request and the statistics
+ *  
+ * @return fbe_status_t, success or failure
+ *
+ *********************************************************************/
+fbe_status_t FBE_API_CALL fbe_api_enclosure_status_page_stats(fbe_object_id_t object_id, 
+                                                         fbe_enclosure_mgmt_status_page_stats_t *stats)
+{
+    fbe_status_t                                    status = FBE_STATUS_GENERIC_FAILURE;
+    fbe_api_control_operation_status_info_t         status_info;
+
+    if (stats == NULL) 
+    {
+        fbe_api_trace (FBE_TRACE_LEVEL_ERROR, "%s: Command buffer is NULL\n", __FUNCTION__);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    status = fbe_api_common_send_control_packet(FBE_BASE_ENCLOSURE_CONTROL_CODE_STATUS_PAGE_STATS,
+                                                stats,
+                                                sizeof(fbe_enclosure_mgmt_status_page_stats_t),
+                                                object_id,
+                                                FBE_PACKET_FLAG_NO_ATTRIB,
+                                                &status_info,
+                                                FBE_PACKAGE_ID_PHYSICAL);
+
+    if (status != FBE_STATUS_OK || status_info.control_operation_status != FBE_PAYLOAD_CONTROL_STATUS_OK) 
+    {
+        fbe_api_trace (FBE_TRACE_LEVEL_ERROR, "%s:packet error:%d, packet qualifier:%d, payload error:%d, payload qualifier:%d\n", __FUNCTION__,
+                        status, status_info.packet_qualifier, status_info.control_operation_status, status_info.control_operation_qualifier);
+        
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    return status;
+}   // end of fbe_api_enclosure_status_page_stats
+
 /*!***************************************************************
  * @fn fbe_api_enclosure_get_drive_slot_info(fbe_object_id_t objectId,
  *                                     fbe_enclosure_mgmt_get_drive_slot_info_t * getDriveSlotInfo)
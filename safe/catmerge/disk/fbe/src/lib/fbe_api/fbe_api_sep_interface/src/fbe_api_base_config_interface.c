@@ -1677,6 +1677,7 @@ fbe_api_base_config_get_metadata_statistics(fbe_object_id_t object_id, fbe_api_b
     metadata_statistics->local_collision_count = stats.local_collision_count;
     metadata_statistics->peer_collision_count = stats.peer_collision_count;
     metadata_statistics->cmi_message_count = stats.cmi_message_count;
+    metadata_statistics->nonpaged_write_count = stats.nonpaged_write_count;
 
     return status;
 
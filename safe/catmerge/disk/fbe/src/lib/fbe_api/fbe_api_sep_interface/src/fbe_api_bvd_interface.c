@@ -689,6 +689,42 @@ fbe_status_t FBE_API_CALL fbe_api_bvd_interface_set_alert_time(fbe_u32_t alert_t
   
     return status;
 }
+
+fbe_status_t FBE_API_CALL fbe_api_bvd_interface_set_run_queue_batch_mode(fbe_transport_run_queue_batch_mode_t batch_mode)
+{
+    fbe_status_t                                 status = FBE_STATUS_GENERIC_FAILURE;
+    fbe_api_control_operation_status_info_t      status_info;
+    fbe_object_id_t                              bvd_id;
+    fbe_transport_run_queue_set_batch_mode_t     set_batch_mode;
+
+    /*first get BVD object ID*/
+    status = fbe_api_bvd_interface_get_bvd_object_id(&bvd_id);
+    if (status != FBE_STATUS_OK ){
+        fbe_api_trace (FBE_TRACE_LEVEL_ERROR, "%s:failed to get BVD ID\n", __FUNCTION__);
+        return status;
+    }
+
+    set_batch_mode.batch_mode = batch_mode;
+    status = fbe_api_common_send_control_packet (FBE_BVD_INTERFACE_CONTROL_CODE_SET_RUN_QUEUE_BATCH_MODE,
+                                                 &set_batch_mode,
+                                                 sizeof(fbe_transport_run_queue_set_batch_mode_t),
+                                                 bvd_id,
+                                                 FBE_PACKET_FLAG_NO_ATTRIB,
+                                                 &status_info,
+                                                 FBE_PACKAGE_ID_SEP_0);
+
+    if (status != FBE_STATUS_OK || status_info.control_operation_status != FBE_PAYLOAD_CONTROL_STATUS_OK){
+        fbe_api_trace (FBE_TRACE_LEVEL_ERROR,
+                       "%s:packet error:%d, packet qualifier:%d, payload error:%d, payload qualifier:%d\n", __FUNCTION__,
+                       status, status_info.packet_qualifier, status_info.control_operation_status,
+                       status_info.control_operation_qualifier);
+
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+  
+    return status;
+}
+
 /*!*******************************************************************
  * fbe_api_bvd_interface_shutdown()
  *********************************************************************
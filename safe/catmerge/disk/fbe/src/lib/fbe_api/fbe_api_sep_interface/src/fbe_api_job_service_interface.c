@@ -1947,6 +1947,190 @@ fbe_status_t FBE_API_CALL fbe_api_job_service_delete_debug_hook(fbe_object_id_t
 
 } // end of fbe_api_job_service_delete_debug_hook
 
+/*!***************************************************************************
+ * @fn      fbe_api_job_service_set_pipeline_mode()
+ ***************************************************************************** 
+ * 
+ * @brief   This function enables or disables the job service pipeline.  When
+ *          the pipeline is disabled every job runs to completion before the
+ *          next job starts.
+ *
+ * @param   b_enabled - FBE_TRUE to let independent jobs overlap their commit
+ *
+ * @return  fbe_status_t - FBE_STATUS_OK    - if no error.
+ *
+ *****************************************************************************/
+fbe_status_t FBE_API_CALL fbe_api_job_service_set_pipeline_mode(fbe_bool_t b_enabled)
+{
+    fbe_status_t                            status = FBE_STATUS_GENERIC_FAILURE;
+    fbe_api_control_operation_status_info_t status_info;
+    fbe_job_service_set_pipeline_mode_t     set_mode;
+
+    set_mode.b_enabled = b_enabled;
+    status = fbe_api_common_send_control_packet_to_service (FBE_JOB_CONTROL_CODE_SET_PIPELINE_MODE,
+                                                            &set_mode,
+                                                            sizeof(fbe_job_service_set_pipeline_mode_t),
+                                                            FBE_SERVICE_ID_JOB_SERVICE,
+                                                            FBE_PACKET_FLAG_NO_ATTRIB,
+                                                            &status_info,
+                                                            FBE_PACKAGE_ID_SEP_0);
+
+    if ((status != FBE_STATUS_OK) ||
+        (status_info.control_operation_status != FBE_PAYLOAD_CONTROL_STATUS_OK))
+    {
+        fbe_api_trace (FBE_TRACE_LEVEL_ERROR,
+                "%s:packet error:%d, packet qualifier:%d, payload error:%d, payload qualifier:%d\n", __FUNCTION__,
+                status,
+                status_info.packet_qualifier, 
+                status_info.control_operation_status, 
+                status_info.control_operation_qualifier);
+
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    return status;
+
+} // end of fbe_api_job_service_set_pipeline_mode
+
+/*!***************************************************************************
+ * @fn      fbe_api_job_service_get_pipeline_info()
+ ***************************************************************************** 
+ * 
+ * @brief   This function gets the job service pipeline mode and statistics.
+ *
+ * @param   pipeline_info_p - Buffer to fill in
+ *
+ * @return  fbe_status_t - FBE_STATUS_OK    - if no error.
+ *
+ *****************************************************************************/
+fbe_status_t FBE_API_CALL fbe_api_job_service_get_pipeline_info(fbe_job_service_pipeline_info_t *pipeline_info_p)
+{
+    fbe_status_t                            status = FBE_STATUS_GENERIC_FAILURE;
+    fbe_api_control_operation_status_info_t status_info;
+
+    if (pipeline_info_p == NULL) {
+        fbe_api_trace(FBE_TRACE_LEVEL_ERROR, "%s: NULL buffer\n", __FUNCTION__);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    fbe_zero_memory(pipeline_info_p, sizeof(fbe_job_service_pipeline_info_t));
+    status = fbe_api_common_send_control_packet_to_service (FBE_JOB_CONTROL_CODE_GET_PIPELINE_INFO,
+                                                            pipeline_info_p,
+                                                            sizeof(fbe_job_service_pipeline_info_t),
+                                                            FBE_SERVICE_ID_JOB_SERVICE,
+                                                            FBE_PACKET_FLAG_NO_ATTRIB,
+                                                            &status_info,
+                                                            FBE_PACKAGE_ID_SEP_0);
+
+    if ((status != FBE_STATUS_OK) ||
+        (status_info.control_operation_status != FBE_PAYLOAD_CONTROL_STATUS_OK))
+    {
+        fbe_api_trace (FBE_TRACE_LEVEL_ERROR,
+                "%s:packet error:%d, packet qualifier:%d, payload error:%d, payload qualifier:%d\n", __FUNCTION__,
+                status,
+                status_info.packet_qualifier, 
+                status_info.control_operation_status, 
+                status_info.control_operation_qualifier);
+
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    return status;
+
+} // end of fbe_api_job_service_get_pipeline_info
+
+/*!***************************************************************************
+ * @fn      fbe_api_job_service_set_spare_index_verify()
+ ***************************************************************************** 
+ * 
+ * @brief   This function enables or disables the verification of the spare
+ *          index.  While enabled every spare selection is repeated without
+ *          the index and every index hit is checked against the pvd.
+ *
+ * @param   b_enabled - FBE_TRUE to verify the spare index
+ *
+ * @return  fbe_status_t - FBE_STATUS_OK    - if no error.
+ *
+ *****************************************************************************/
+fbe_status_t FBE_API_CALL fbe_api_job_service_set_spare_index_verify(fbe_bool_t b_enabled)
+{
+    fbe_status_t                                status = FBE_STATUS_GENERIC_FAILURE;
+    fbe_api_control_operation_status_info_t     status_info;
+    fbe_job_service_set_spare_index_verify_t    set_verify;
+
+    set_verify.b_enabled = b_enabled;
+    status = fbe_api_common_send_control_packet_to_service (FBE_JOB_CONTROL_CODE_SET_SPARE_INDEX_VERIFY,
+                                                            &set_verify,
+                                                            sizeof(fbe_job_service_set_spare_index_verify_t),
+                                                            FBE_SERVICE_ID_JOB_SERVICE,
+                                                            FBE_PACKET_FLAG_NO_ATTRIB,
+                                                            &status_info,
+                                                            FBE_PACKAGE_ID_SEP_0);
+
+    if ((status != FBE_STATUS_OK) ||
+        (status_info.control_operation_status != FBE_PAYLOAD_CONTROL_STATUS_OK))
+    {
+        fbe_api_trace (FBE_TRACE_LEVEL_ERROR,
+                "%s:packet error:%d, packet qualifier:%d, payload error:%d, payload qualifier:%d\n", __FUNCTION__,
+                status,
+                status_info.packet_qualifier, 
+                status_info.control_operation_status, 
+                status_info.control_operation_qualifier);
+
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    return status;
+
+} // end of fbe_api_job_service_set_spare_index_verify
+
+/*!***************************************************************************
+ * @fn      fbe_api_job_service_get_spare_index_info()
+ ***************************************************************************** 
+ * 
+ * @brief   This function gets the spare index statistics.
+ *
+ * @param   spare_index_info_p - Buffer to fill in
+ *
+ * @return  fbe_status_t - FBE_STATUS_OK    - if no error.
+ *
+ *****************************************************************************/
+fbe_status_t FBE_API_CALL fbe_api_job_service_get_spare_index_info(fbe_job_service_spare_index_info_t *spare_index_info_p)
+{
+    fbe_status_t                            status = FBE_STATUS_GENERIC_FAILURE;
+    fbe_api_control_operation_status_info_t status_info;
+
+    if (spare_index_info_p == NULL) {
+        fbe_api_trace(FBE_TRACE_LEVEL_ERROR, "%s: NULL buffer\n", __FUNCTION__);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    fbe_zero_memory(spare_index_info_p, sizeof(fbe_job_service_spare_index_info_t));
+    status = fbe_api_common_send_control_packet_to_service (FBE_JOB_CONTROL_CODE_GET_SPARE_INDEX_INFO,
+                                                            spare_index_info_p,
+                                                            sizeof(fbe_job_service_spare_index_info_t),
+                                                            FBE_SERVICE_ID_JOB_SERVICE,
+                                                            FBE_PACKET_FLAG_NO_ATTRIB,
+                                                            &status_info,
+                                                            FBE_PACKAGE_ID_SEP_0);
+
+    if ((status != FBE_STATUS_OK) ||
+        (status_info.control_operation_status != FBE_PAYLOAD_CONTROL_STATUS_OK))
+    {
+        fbe_api_trace (FBE_TRACE_LEVEL_ERROR,
+                "%s:packet error:%d, packet qualifier:%d, payload error:%d, payload qualifier:%d\n", __FUNCTION__,
+                status,
+                status_info.packet_qualifier, 
+                status_info.control_operation_status, 
+                status_info.control_operation_qualifier);
+
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    return status;
+
+} // end of fbe_api_job_service_get_spare_index_info
+
 /*!***************************************************************************
  * @fn fbe_api_job_service_validate_database()
  *****************************************************************************
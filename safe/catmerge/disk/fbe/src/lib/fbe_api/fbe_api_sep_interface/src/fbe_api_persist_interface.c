@@ -826,6 +826,50 @@ fbe_status_t FBE_API_CALL fbe_api_persist_get_layout_info(fbe_persist_control_ge
 
 }
 
+/*!***************************************************************
+   @fn fbe_status_t FBE_API_CALL fbe_api_persist_get_stats(fbe_persist_control_get_stats_t *get_stats)
+ ****************************************************************
+ * @brief
+ *  This function gets the journal and live data I/O counters of the persist service
+ *
+ * @param get_stats      - pointer to data to fill
+ *
+ * @return
+ *  fbe_status_t
+ *
+ ****************************************************************/
+fbe_status_t FBE_API_CALL fbe_api_persist_get_stats(fbe_persist_control_get_stats_t *get_stats)
+{
+	fbe_status_t                                status;
+    fbe_api_control_operation_status_info_t     status_info;
+    
+	if (get_stats == NULL) {
+		fbe_api_trace (FBE_TRACE_LEVEL_ERROR, "%s NULL pointer\n", __FUNCTION__);
+		return FBE_STATUS_GENERIC_FAILURE;
+	}
+
+    status = fbe_api_common_send_control_packet_to_service (FBE_PERSIST_CONTROL_CODE_GET_STATS,
+															get_stats, 
+															sizeof(fbe_persist_control_get_stats_t),
+															FBE_SERVICE_ID_PERSIST,
+															FBE_PACKET_FLAG_NO_ATTRIB,
+															&status_info,
+															FBE_PACKAGE_ID_SEP_0);
+
+    if (status != FBE_STATUS_OK || status_info.control_operation_status != FBE_PAYLOAD_CONTROL_STATUS_OK){
+        fbe_api_trace (FBE_TRACE_LEVEL_ERROR, "%s:packet error:%d, packet qualifier:%d, payload error:%d, payload qualifier:%d\n", __FUNCTION__,
+                        status, status_info.packet_qualifier, status_info.control_operation_status, status_info.control_operation_qualifier);
+
+        if (status != FBE_STATUS_OK) {
+			return status;
+		}else{
+			return FBE_STATUS_GENERIC_FAILURE;
+		}
+    }
+    
+    return status;
+}
+
 /*!***************************************************************
    @fn fbe_status_t FBE_API_CALL fbe_api_persist_write_entry_with_auto_entry_id_on_top(fbe_persist_transaction_handle_t transaction_handle,
 																				fbe_persist_sector_type_t target_sector,
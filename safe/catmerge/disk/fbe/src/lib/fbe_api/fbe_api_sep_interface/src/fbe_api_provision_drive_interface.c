@@ -4696,6 +4696,135 @@ fbe_status_t FBE_API_CALL fbe_api_provision_drive_set_wear_leveling_timer(fbe_u6
  * end fbe_api_provision_drive_set_wear_leveling_timer()
  ***************************************************************/
 
+/*!***************************************************************
+ * @fn fbe_api_provision_drive_set_zod_batch_enabled()
+ *****************************************************************
+ * @brief
+ *  This function enables or disables batching of the zero on 
+ *  demand paged metadata updates for all provision drives.
+ *
+ * @param   b_enabled - FBE_TRUE to batch, FBE_FALSE to update per write
+ *
+ * @return
+ *  fbe_status_t
+ *
+ ****************************************************************/
+fbe_status_t FBE_API_CALL fbe_api_provision_drive_set_zod_batch_enabled(fbe_bool_t b_enabled)
+{
+    fbe_status_t                                status;
+    fbe_api_control_operation_status_info_t     status_info;
+    fbe_bool_t                                  enabled = b_enabled;
+
+    status = fbe_api_common_send_control_packet_to_class (FBE_PROVISION_DRIVE_CONTROL_CODE_SET_CLASS_ZOD_BATCH_ENABLED,
+                                                          &enabled,
+                                                          sizeof(fbe_bool_t),
+                                                          FBE_CLASS_ID_PROVISION_DRIVE,
+                                                          FBE_PACKET_FLAG_NO_ATTRIB,
+                                                          &status_info,
+                                                          FBE_PACKAGE_ID_SEP_0);
+
+    if (status != FBE_STATUS_OK || status_info.control_operation_status != FBE_PAYLOAD_CONTROL_STATUS_OK) {
+        fbe_api_trace (FBE_TRACE_LEVEL_WARNING, "%s:packet error:%d, packet qualifier:%d, payload error:%d, payload qualifier:%d\n", __FUNCTION__,
+        status, status_info.packet_qualifier, status_info.control_operation_status, status_info.control_operation_qualifier);
+
+        if (status != FBE_STATUS_OK) {
+            return status;
+        }else{
+            return FBE_STATUS_GENERIC_FAILURE;
+        }
+    }
+
+    return status;
+}   
+/***************************************************************
+ * end fbe_api_provision_drive_set_zod_batch_enabled()
+ ***************************************************************/
+
+/*!***************************************************************
+ * @fn fbe_api_provision_drive_set_verify_invalidate_batch_enabled()
+ *****************************************************************
+ * @brief
+ *  This function enables or disables batching of the verify 
+ *  invalidate checkpoint peer updates for all provision drives.
+ *
+ * @param   b_enabled - FBE_TRUE to batch, FBE_FALSE to update the
+ *                      peer on every checkpoint increment
+ *
+ * @return
+ *  fbe_status_t
+ *
+ ****************************************************************/
+fbe_status_t FBE_API_CALL fbe_api_provision_drive_set_verify_invalidate_batch_enabled(fbe_bool_t b_enabled)
+{
+    fbe_status_t                                status;
+    fbe_api_control_operation_status_info_t     status_info;
+    fbe_bool_t                                  enabled = b_enabled;
+
+    status = fbe_api_common_send_control_packet_to_class (FBE_PROVISION_DRIVE_CONTROL_CODE_SET_CLASS_VERIFY_INVALIDATE_BATCH_ENABLED,
+                                                          &enabled,
+                                                          sizeof(fbe_bool_t),
+                                                          FBE_CLASS_ID_PROVISION_DRIVE,
+                                                          FBE_PACKET_FLAG_NO_ATTRIB,
+                                                          &status_info,
+                                                          FBE_PACKAGE_ID_SEP_0);
+
+    if (status != FBE_STATUS_OK || status_info.control_operation_status != FBE_PAYLOAD_CONTROL_STATUS_OK) {
+        fbe_api_trace (FBE_TRACE_LEVEL_WARNING, "%s:packet error:%d, packet qualifier:%d, payload error:%d, payload qualifier:%d\n", __FUNCTION__,
+        status, status_info.packet_qualifier, status_info.control_operation_status, status_info.control_operation_qualifier);
+
+        if (status != FBE_STATUS_OK) {
+            return status;
+        }else{
+            return FBE_STATUS_GENERIC_FAILURE;
+        }
+    }
+
+    return status;
+}   
+/***************************************************************
+ * end fbe_api_provision_drive_set_verify_invalidate_batch_enabled()
+ ***************************************************************/
+
+/*!***************************************************************
+ * @fn fbe_api_provision_drive_get_zod_batch_info()
+ ****************************************************************
+ * @brief
+ *  This function gets the zero on demand paged update batching
+ *  state and counters of a provision drive.
+ *
+ * @param object_id - object ID
+ * @param get_info - buffer for the batching information
+ *
+ * @return
+ *  fbe_status_t - FBE_STATUS_OK - if no error.
+ *
+ ****************************************************************/
+fbe_status_t FBE_API_CALL 
+fbe_api_provision_drive_get_zod_batch_info(fbe_object_id_t object_id, fbe_provision_drive_get_zod_batch_info_t *get_info)
+{
+    fbe_status_t                                    status = FBE_STATUS_OK;
+    fbe_api_control_operation_status_info_t         status_info;
+
+    status = fbe_api_common_send_control_packet (FBE_PROVISION_DRIVE_CONTROL_CODE_GET_ZOD_BATCH_INFO,
+                                                 get_info,
+                                                 sizeof(fbe_provision_drive_get_zod_batch_info_t),
+                                                 object_id,
+                                                 FBE_PACKET_FLAG_NO_ATTRIB,
+                                                 &status_info,
+                                                 FBE_PACKAGE_ID_SEP_0);
+    if (status != FBE_STATUS_OK || status_info.control_operation_status != FBE_PAYLOAD_CONTROL_STATUS_OK) {
+        fbe_api_trace (FBE_TRACE_LEVEL_ERROR, "%s:packet error:%d, packet qualifier:%d, payload error:%d, payload qualifier:%d\n", __FUNCTION__,
+                        status, status_info.packet_qualifier, status_info.control_operation_status, status_info.control_operation_qualifier);
+
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    return status;
+}
+/*******************************************************************
+ * end fbe_api_provision_drive_get_zod_batch_info()
+ *******************************************************************/
+
 
 /***********************************************
  * end file fbe_api_provision_drive_interface.c
@@ -275,6 +275,9 @@ fbe_api_raid_group_get_info(fbe_object_id_t rg_object_id,
 
     raid_group_info_p->elements_per_parity_stripe = raid_group_info.elements_per_parity_stripe;
     raid_group_info_p->rekey_checkpoint = raid_group_info.rekey_checkpoint;
+    raid_group_info_p->rebuild_concurrent_request_count = raid_group_info.rebuild_concurrent_request_count;
+    raid_group_info_p->rebuild_queue_depth = raid_group_info.rebuild_queue_depth;
+    raid_group_info_p->rebuild_op_chunks = raid_group_info.rebuild_op_chunks;
     return status;
 }
 /**************************************
@@ -4588,6 +4591,158 @@ fbe_api_raid_group_set_chunks_per_rebuild(fbe_u32_t num_chunks_per_rebuild)
  * end fbe_api_raid_group_set_chunks_per_rebuild()
  **************************************/
 
+/*!***************************************************************
+ *  fbe_api_raid_group_set_max_concurrent_rebuild_ios()
+ ****************************************************************
+ * @brief
+ *  This function sets the maximum number of rebuild I/Os a raid
+ *  group has in flight.  The rebuild tunes the number it issues
+ *  between 1 and this maximum.
+ *
+ * @param max_concurrent_ios - maximum rebuild I/Os per raid group
+ *
+ * @return
+ *  fbe_status_t - FBE_STATUS_OK - if no error.
+ *
+ ****************************************************************/
+fbe_status_t FBE_API_CALL
+fbe_api_raid_group_set_max_concurrent_rebuild_ios(fbe_u32_t max_concurrent_ios)
+{
+    fbe_status_t                                            status;
+    fbe_api_control_operation_status_info_t                 status_info;
+    fbe_raid_group_class_set_max_concurrent_rebuild_ios_t   set_max_ios;
+
+    fbe_zero_memory(&set_max_ios, sizeof(fbe_raid_group_class_set_max_concurrent_rebuild_ios_t));
+    set_max_ios.max_concurrent_ios = max_concurrent_ios;
+    status = fbe_api_common_send_control_packet_to_class(FBE_RAID_GROUP_CONTROL_CODE_CLASS_SET_MAX_CONCURRENT_REBUILD_IOS,
+                                                         &set_max_ios,
+                                                         sizeof(fbe_raid_group_class_set_max_concurrent_rebuild_ios_t),
+                                                         /* There is no rg class
+                                                             * instances so we need to send 
+                                                             * it to one of the leaf 
+                                                             * classes. 
+                                                             */
+                                                         FBE_CLASS_ID_PARITY,
+                                                         FBE_PACKET_FLAG_NO_ATTRIB,
+                                                         &status_info,
+                                                         FBE_PACKAGE_ID_SEP_0);
+
+    if (status != FBE_STATUS_OK || status_info.control_operation_status != FBE_PAYLOAD_CONTROL_STATUS_OK) 
+    {
+        fbe_api_trace (FBE_TRACE_LEVEL_ERROR, "%s:packet error:%d, packet qualifier:%d, payload error:%d, payload qualifier:%d\n", __FUNCTION__,
+                        status, status_info.packet_qualifier, status_info.control_operation_status, status_info.control_operation_qualifier);
+
+        if (status == FBE_STATUS_OK) 
+        {
+            return FBE_STATUS_GENERIC_FAILURE;
+        }
+    }
+
+    return status;
+}
+/**************************************
+ * end fbe_api_raid_group_set_max_concurrent_rebuild_ios()
+ **************************************/
+
+/*!***************************************************************
+ *  fbe_api_raid_group_set_rebuild_catch_up_window()
+ ****************************************************************
+ * @brief
+ *  This function sets how many blocks a rebuild position can be
+ *  behind another one and still be rebuilt first, so that both
+ *  positions are then rebuilt in one pass.
+ *
+ * @param catch_up_window_blocks - physical blocks, 0 disables it
+ *
+ * @return
+ *  fbe_status_t - FBE_STATUS_OK - if no error.
+ *
+ ****************************************************************/
+fbe_status_t FBE_API_CALL
+fbe_api_raid_group_set_rebuild_catch_up_window(fbe_block_count_t catch_up_window_blocks)
+{
+    fbe_status_t                                        status;
+    fbe_api_control_operation_status_info_t             status_info;
+    fbe_raid_group_class_set_rebuild_catch_up_window_t  set_window;
+
+    fbe_zero_memory(&set_window, sizeof(fbe_raid_group_class_set_rebuild_catch_up_window_t));
+    set_window.catch_up_window_blocks = catch_up_window_blocks;
+    status = fbe_api_common_send_control_packet_to_class(FBE_RAID_GROUP_CONTROL_CODE_CLASS_SET_REBUILD_CATCH_UP_WINDOW,
+                                                         &set_window,
+                                                         sizeof(fbe_raid_group_class_set_rebuild_catch_up_window_t),
+                                                         /* There is no rg class
+                                                             * instances so we need to send 
+                                                             * it to one of the leaf 
+                                                             * classes. 
+                                                             */
+                                                         FBE_CLASS_ID_PARITY,
+                                                         FBE_PACKET_FLAG_NO_ATTRIB,
+                                                         &status_info,
+                                                         FBE_PACKAGE_ID_SEP_0);
+
+    if (status != FBE_STATUS_OK || status_info.control_operation_status != FBE_PAYLOAD_CONTROL_STATUS_OK) 
+    {
+        fbe_api_trace (FBE_TRACE_LEVEL_ERROR, "%s:packet error:%d, packet qualifier:%d, payload error:%d, payload qualifier:%d\n", __FUNCTION__,
+                        status, status_info.packet_qualifier, status_info.control_operation_status, status_info.control_operation_qualifier);
+
+        if (status == FBE_STATUS_OK) 
+        {
+            return FBE_STATUS_GENERIC_FAILURE;
+        }
+    }
+
+    return status;
+}
+/**************************************
+ * end fbe_api_raid_group_set_rebuild_catch_up_window()
+ **************************************/
+
+/*!***************************************************************
+ *  fbe_api_raid_group_get_read_ahead_stats()
+ ****************************************************************
+ * @brief
+ *  This function retrieves the read-ahead counters of the raid group.
+ *
+ * @param rg_object_id - RG object id
+ * @param stats_p - pointer to structure to report the counters
+ *
+ * @return
+ *  fbe_status_t - FBE_STATUS_OK - if no error.
+ *
+ ****************************************************************/
+fbe_status_t FBE_API_CALL
+fbe_api_raid_group_get_read_ahead_stats(fbe_object_id_t rg_object_id, 
+                                        fbe_raid_group_get_read_ahead_stats_t *stats_p)
+{
+    fbe_status_t                                    status = FBE_STATUS_OK;
+    fbe_api_control_operation_status_info_t         status_info;
+
+    if (stats_p == NULL) {
+        fbe_api_trace(FBE_TRACE_LEVEL_ERROR, "%s: NULL input buffer\n", __FUNCTION__);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    status = fbe_api_common_send_control_packet(FBE_RAID_GROUP_CONTROL_CODE_GET_READ_AHEAD_STATS,
+                                                stats_p,
+                                                sizeof(fbe_raid_group_get_read_ahead_stats_t),
+                                                rg_object_id,
+                                                FBE_PACKET_FLAG_NO_ATTRIB,
+                                                &status_info,
+                                                FBE_PACKAGE_ID_SEP_0);
+
+    if (status != FBE_STATUS_OK || status_info.control_operation_status != FBE_PAYLOAD_CONTROL_STATUS_OK) {
+        fbe_api_trace (FBE_TRACE_LEVEL_ERROR, "%s:packet error:%d, packet qualifier:%d, payload error:%d, payload qualifier:%d\n", __FUNCTION__,
+                        status, status_info.packet_qualifier, status_info.control_operation_status, status_info.control_operation_qualifier);
+
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    return status;
+}
+/**************************************
+ * end fbe_api_raid_group_get_read_ahead_stats()
+ **************************************/
+
 /******************************************
  * end file fbe_api_raid_group_interface.c
  ******************************************/
@@ -377,6 +377,49 @@ fbe_api_virtual_drive_class_set_unused_as_spare_flag(fbe_bool_t enable)
     return status;
 }
 
+/*!***************************************************************
+ * @fn fbe_api_virtual_drive_class_set_copy_concurrent_regions()
+ ****************************************************************
+ * @brief
+ *  This function sets the number of regions that each copy
+ *  request of the virtual drives copies at the same time.
+ *
+ * @param concurrent_regions - Number of regions (1 copies one
+ *                             region at a time).
+ *
+ * @return
+ *  fbe_status_t - FBE_STATUS_OK - if no error.
+ *
+ ****************************************************************/
+fbe_status_t FBE_API_CALL
+fbe_api_virtual_drive_class_set_copy_concurrent_regions(fbe_u32_t concurrent_regions)
+{
+    fbe_status_t                                                    status = FBE_STATUS_GENERIC_FAILURE;
+    fbe_virtual_drive_control_class_set_copy_concurrent_regions_t   set_regions;
+    fbe_api_control_operation_status_info_t                         status_info;
+
+    set_regions.concurrent_regions = concurrent_regions;
+
+    status = fbe_api_common_send_control_packet_to_class(FBE_VIRTUAL_DRIVE_CONTROL_CODE_CLASS_SET_COPY_CONCURRENT_REGIONS,
+                                                         &set_regions,
+                                                         sizeof(fbe_virtual_drive_control_class_set_copy_concurrent_regions_t),
+                                                         FBE_CLASS_ID_VIRTUAL_DRIVE,
+                                                         FBE_PACKET_FLAG_NO_ATTRIB,
+                                                         &status_info,
+                                                         FBE_PACKAGE_ID_SEP_0);
+
+    if ((status != FBE_STATUS_OK) ||
+        (status_info.control_operation_status != FBE_PAYLOAD_CONTROL_STATUS_OK))
+    {
+        fbe_api_trace (FBE_TRACE_LEVEL_ERROR, "%s:packet error:%d, packet qualifier:%d, payload error:%d, payload qualifier:%d\n", __FUNCTION__,
+                       status, status_info.packet_qualifier,
+                       status_info.control_operation_status, status_info.control_operation_qualifier);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    return status;
+}
+
 
 /*!***************************************************************************
  * fbe_api_virtual_drive_set_all_virtual_drive_debug_flags()
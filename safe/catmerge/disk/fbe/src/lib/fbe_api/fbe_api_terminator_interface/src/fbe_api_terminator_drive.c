@@ -1114,6 +1114,90 @@ fbe_status_t fbe_api_terminator_sas_drive_set_default_page_info(fbe_sas_drive_ty
     return FBE_STATUS_OK;
 }
 
+/*********************************************************************
+ *            fbe_api_terminator_drive_get_latency_model()
+ *********************************************************************
+ *
+ *  Description: Get the service time model the terminator's
+ *     simulated disk applies to a specific drive type.
+ *
+ *  Inputs: drive_type - type of the drive
+ *          model_p - latency model that is returned.
+ * 
+ *  Return Value: success or failure
+ *
+ *********************************************************************/
+fbe_status_t fbe_api_terminator_drive_get_latency_model(fbe_sas_drive_type_t drive_type, fbe_terminator_drive_latency_model_t *model_p)
+{
+    fbe_status_t status = FBE_STATUS_GENERIC_FAILURE;
+    fbe_api_control_operation_status_info_t status_info;
+    fbe_terminator_drive_latency_model_ioctl_t  ioctl;
+    
+    ioctl.drive_type = drive_type;    
+
+    status = fbe_api_common_send_control_packet_to_service(FBE_TERMINATOR_CONTROL_CODE_DRIVE_GET_LATENCY_MODEL,
+                                                           &ioctl,
+                                                           sizeof(ioctl),
+                                                           FBE_SERVICE_ID_TERMINATOR,
+                                                           FBE_PACKET_FLAG_NO_ATTRIB,
+                                                           &status_info,
+                                                           FBE_PACKAGE_ID_PHYSICAL);
+
+    if (status != FBE_STATUS_OK || status_info.control_operation_status != FBE_PAYLOAD_CONTROL_STATUS_OK) {
+        fbe_api_trace (FBE_TRACE_LEVEL_DEBUG_LOW, "%s:packet error:%d, packet qualifier:%d, payload error:%d, payload qualifier:%d\n", __FUNCTION__,
+                        status, status_info.packet_qualifier, status_info.control_operation_status, status_info.control_operation_qualifier);
+
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    *model_p = ioctl.model;
+
+    return FBE_STATUS_OK;
+}
+
+/*********************************************************************
+ *            fbe_api_terminator_drive_set_latency_model()
+ *********************************************************************
+ *
+ *  Description: Set the service time model (seek, rotation, per I/O
+ *     and per KB cost, queue depth and bandwidth cap) the terminator's
+ *     simulated disk applies to every drive of a specific drive type.
+ *     FBE_TERMINATOR_DRIVE_LATENCY_MODEL_NONE restores the default of
+ *     completing I/O as soon as the data is moved.
+ *
+ *  Inputs: drive_type - type of the drive
+ *          model_p - latency model to apply.
+ * 
+ *  Return Value: success or failure
+ *
+ *********************************************************************/
+fbe_status_t fbe_api_terminator_drive_set_latency_model(fbe_sas_drive_type_t drive_type, const fbe_terminator_drive_latency_model_t *model_p)
+{
+    fbe_status_t status = FBE_STATUS_GENERIC_FAILURE;
+    fbe_api_control_operation_status_info_t status_info;
+    fbe_terminator_drive_latency_model_ioctl_t  ioctl;
+
+    ioctl.drive_type = drive_type;   
+    ioctl.model = *model_p; 
+
+    status = fbe_api_common_send_control_packet_to_service(FBE_TERMINATOR_CONTROL_CODE_DRIVE_SET_LATENCY_MODEL,
+                                                           &ioctl,
+                                                           sizeof(ioctl),
+                                                           FBE_SERVICE_ID_TERMINATOR,
+                                                           FBE_PACKET_FLAG_NO_ATTRIB,
+                                                           &status_info,
+                                                           FBE_PACKAGE_ID_PHYSICAL);
+
+    if (status != FBE_STATUS_OK || status_info.control_operation_status != FBE_PAYLOAD_CONTROL_STATUS_OK) {
+        fbe_api_trace (FBE_TRACE_LEVEL_DEBUG_LOW, "%s:packet error:%d, packet qualifier:%d, payload error:%d, payload qualifier:%d\n", __FUNCTION__,
+                        status, status_info.packet_qualifier, status_info.control_operation_status, status_info.control_operation_qualifier);
+
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    return FBE_STATUS_OK;
+}
+
 /*********************************************************************
  *            fbe_api_terminator_sas_drive_set_default_field ()
  *********************************************************************
@@ -480,6 +480,16 @@ static __inline fbe_u32_t fbe_raid_get_std_buffer_size(void)
 #define fbe_raid_sg_set_physical_address(m_dest_sgl_p, m_phys_addr_local)((void)0)
 #define fbe_raid_sg_declare_physical_address(m_arg)((void)0)
 
+/*! @def fbe_raid_sg_is_adjacent  
+ *  @brief Determines if the memory of the next sg element starts exactly 
+ *         where the previous one ends, in which case both can be described 
+ *         by a single element.  Since we always use virtual addresses this 
+ *         is all that is needed. 
+ */
+#define fbe_raid_sg_is_adjacent(m_prev_sg_p, m_next_sg_p)\
+    (((m_next_sg_p)->count != 0) &&\
+     ((m_prev_sg_p)->address + (m_prev_sg_p)->count == (m_next_sg_p)->address))
+
 /*!*******************************************************************
  * @enum fbe_raid_option_flags_t
  *********************************************************************
@@ -62,6 +62,7 @@ fbe_status_t fbe_raid_iots_request_siots_allocation(fbe_raid_iots_t *iots_p);
 fbe_status_t fbe_raid_iots_process_allocated_siots(fbe_raid_iots_t *iots_p,
                                                    fbe_raid_siots_t **siots_pp);
 fbe_bool_t fbe_raid_iots_is_buffered_op(fbe_raid_iots_t *iots_p);
+fbe_u32_t fbe_raid_iots_get_host_sg_fragments(fbe_raid_iots_t *iots_p);
 
 /**************************************** 
  * fbe_raid_iots_states.c 
@@ -147,6 +148,12 @@ void fbe_raid_siots_enqueue_freed_list(fbe_raid_siots_t *siots_p,
                                        fbe_raid_memory_header_t *memory_p);
 fbe_status_t fbe_raid_siots_destroy_resources(fbe_raid_siots_t *siots_p);
 fbe_status_t fbe_raid_siots_setup_cached_sgd(fbe_raid_siots_t *siots_p, fbe_sg_element_with_offset_t *sgd_p);
+fbe_status_t fbe_raid_siots_scatter_cache_to_bed(fbe_raid_siots_t *siots_p,
+                                                fbe_u16_t data_pos,
+                                                fbe_u16_t data_disks,
+                                                fbe_lba_t blks_per_element,
+                                                fbe_sg_element_with_offset_t *src_sgd_ptr,
+                                                fbe_u32_t sg_total[]);
 fbe_status_t fbe_raid_siots_setup_sgd(fbe_raid_siots_t *siots_p, 
                               fbe_sg_element_with_offset_t *sgd_p);
 
@@ -687,6 +694,15 @@ fbe_status_t fbe_raid_scatter_cache_to_bed(fbe_lba_t lda,
                                            fbe_lba_t blks_per_element,
                                            fbe_sg_element_with_offset_t * src_sgd_ptr,
                                            fbe_u32_t sg_total[]);
+void fbe_raid_scatter_contiguous_to_bed(fbe_lba_t lda,
+                                        fbe_block_count_t blks_to_scatter,
+                                        fbe_u16_t data_pos,
+                                        fbe_u16_t data_disks,
+                                        fbe_lba_t blks_per_element,
+                                        fbe_u32_t sg_total[]);
+void fbe_raid_sg_count_fragments(fbe_sg_element_t *sg_p,
+                                 fbe_u32_t *sg_count_p,
+                                 fbe_u32_t *fragments_p);
 fbe_status_t fbe_raid_scatter_sg_to_bed(fbe_lba_t lda,
                                  fbe_u32_t blks_to_scatter,
                                  fbe_u16_t data_pos,
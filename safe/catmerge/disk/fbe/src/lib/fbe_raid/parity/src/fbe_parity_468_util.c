@@ -1510,13 +1510,12 @@ fbe_status_t fbe_parity_468_calculate_num_sgs(fbe_raid_siots_t *siots_p,
         }
 
 
-        status = fbe_raid_scatter_cache_to_bed(siots_p->start_lba,
-                                               siots_p->xfer_count,
-                                               data_pos,
-                                               fbe_raid_siots_get_width(siots_p) - parity_drives,
-                                               fbe_raid_siots_get_blocks_per_element(siots_p),
-                                               &sg_desc,
-                                               sg_count_vec);
+        status = fbe_raid_siots_scatter_cache_to_bed(siots_p,
+                                                     data_pos,
+                                                     fbe_raid_siots_get_width(siots_p) - parity_drives,
+                                                     fbe_raid_siots_get_blocks_per_element(siots_p),
+                                                     &sg_desc,
+                                                     sg_count_vec);
         if (RAID_COND_STATUS((status != FBE_STATUS_OK), status))
         {
             fbe_raid_siots_trace(siots_p, FBE_RAID_SIOTS_TRACE_PARAMS_ERROR, 
@@ -415,13 +415,12 @@ fbe_status_t fbe_parity_degraded_read_calculate_num_sgs(fbe_raid_siots_t *siots_
                 return (status);
             }
 
-            status = fbe_raid_scatter_cache_to_bed(siots_p->start_lba,
-                                                   siots_p->xfer_count,
-                                                   data_pos,
-                                                   fbe_raid_siots_get_width(siots_p) - parity_drives,
-                                                   fbe_raid_siots_get_blocks_per_element(siots_p),
-                                                   &sg_desc,
-                                                   num_read_sg_elements);
+            status = fbe_raid_siots_scatter_cache_to_bed(siots_p,
+                                                         data_pos,
+                                                         fbe_raid_siots_get_width(siots_p) - parity_drives,
+                                                         fbe_raid_siots_get_blocks_per_element(siots_p),
+                                                         &sg_desc,
+                                                         num_read_sg_elements);
             if (RAID_COND_STATUS((status != FBE_STATUS_OK), status))
             {
                 fbe_raid_siots_trace(siots_p, FBE_RAID_SIOTS_TRACE_PARAMS_ERROR, 
@@ -891,13 +891,12 @@ fbe_status_t fbe_parity_mr3_calculate_num_sgs(fbe_raid_siots_t *siots_p,
          * Note that the sg_count_vec already includes counts of S/G elements
          * for pre-read data, so we will add to these counts.
          */
-        status = fbe_raid_scatter_cache_to_bed(siots_p->start_lba,
-                                              siots_p->xfer_count,
-                                              current_data_pos,
-                                              data_disks,
-                                              fbe_raid_siots_get_blocks_per_element(siots_p),
-                                              &sg_desc,
-                                              sg_count_vec);
+        status = fbe_raid_siots_scatter_cache_to_bed(siots_p,
+                                                    current_data_pos,
+                                                    data_disks,
+                                                    fbe_raid_siots_get_blocks_per_element(siots_p),
+                                                    &sg_desc,
+                                                    sg_count_vec);
         if (RAID_COND_STATUS((status != FBE_STATUS_OK), status))
         {
             fbe_raid_siots_trace(siots_p, FBE_TRACE_LEVEL_ERROR, __LINE__, "parity_mr3_calc_num_sgs", 
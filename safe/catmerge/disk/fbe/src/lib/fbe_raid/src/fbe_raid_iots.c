@@ -700,6 +700,7 @@ fbe_status_t fbe_raid_iots_init(fbe_raid_iots_t* iots_p,
     fbe_payload_block_get_opcode(block_operation_p, &opcode);
     fbe_raid_iots_set_current_opcode(iots_p, opcode);
     fbe_raid_iots_set_host_start_offset(iots_p, 0);
+    fbe_raid_iots_clear_host_sg_fragments(iots_p);
     fbe_raid_iots_set_np_lock(iots_p, FBE_FALSE);
 
     /* Initialize common fields of the raid iots.
@@ -794,6 +795,7 @@ fbe_status_t fbe_raid_iots_fast_init(fbe_raid_iots_t* iots_p)
     fbe_raid_iots_set_block_status(iots_p, FBE_PAYLOAD_BLOCK_OPERATION_STATUS_INVALID);
     fbe_raid_iots_set_block_qualifier(iots_p, FBE_PAYLOAD_BLOCK_OPERATION_QUALIFIER_INVALID);
     fbe_raid_iots_set_host_start_offset(iots_p, 0);
+    fbe_raid_iots_clear_host_sg_fragments(iots_p);
     fbe_raid_iots_set_np_lock(iots_p, FBE_FALSE);
 
     fbe_raid_iots_set_blocks_transferred(iots_p, 0);
@@ -2150,6 +2152,45 @@ fbe_status_t fbe_raid_iots_init_for_next_lba(fbe_raid_iots_t *iots_p)
  * end fbe_raid_iots_init_for_next_lba()
  ******************************************/
 
+/*!**************************************************************
+ * fbe_raid_iots_get_host_sg_fragments()
+ ****************************************************************
+ * @brief
+ *  Return the number of contiguous memory runs in the host sg list.
+ *  The list is only walked the first time this is asked for a given
+ *  sg list, every siots of the request after that uses the saved count.
+ *
+ * @param iots_p - This I/O.
+ *
+ * @return fbe_u32_t - Number of fragments, 0 if there is no host sg.
+ *
+ ****************************************************************/
+fbe_u32_t fbe_raid_iots_get_host_sg_fragments(fbe_raid_iots_t *iots_p)
+{
+    fbe_sg_element_t *sg_p = NULL;
+    fbe_u32_t sg_count;
+    fbe_u32_t fragments;
+
+    fbe_raid_iots_get_sg_ptr(iots_p, &sg_p);
+    if (sg_p == NULL)
+    {
+        return 0;
+    }
+    if (iots_p->host_sg_fragments_sg_p != sg_p)
+    {
+        /* Siots of the same iots may get here at the same time, but they 
+         * all compute the same count, so there is no harm in that. 
+         */
+        fbe_raid_sg_count_fragments(sg_p, &sg_count, &fragments);
+        iots_p->host_sg_fragments = fragments;
+        iots_p->host_sg_fragments_sg_p = sg_p;
+    }
+    return iots_p->host_sg_fragments;
+}
+/******************************************
+ * end fbe_raid_iots_get_host_sg_fragments()
+ ******************************************/
+
 /*!***************************************************************
  * fbe_raid_iots_set_packet_status()
  ****************************************************************
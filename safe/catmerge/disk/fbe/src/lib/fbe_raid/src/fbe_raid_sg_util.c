@@ -489,6 +489,98 @@ fbe_status_t fbe_raid_scatter_cache_to_bed(fbe_lba_t lda,
 /**************************************
  * end fbe_raid_scatter_cache_to_bed()
  **************************************/
+
+/*!***************************************************************************
+ * fbe_raid_scatter_contiguous_to_bed()
+ ***************************************************************************
+ * @brief
+ *  Count the S/G elements needed for each disk when the source memory is 
+ *  one contiguous run.  Every stripe element accessed then takes exactly 
+ *  one S/G element, so unlike fbe_raid_scatter_cache_to_bed() we never need 
+ *  to walk the source S/G list.
+ *
+ * @param lda - logical address of first block.
+ * @param blks_to_scatter - number of blocks to be scattered.
+ * @param data_pos - position of first block in vector.
+ * @param data_disks - number of data disks in the array.
+ * @param blks_per_element - number of sectors per stripe element.
+ * @param sg_total - vector holding number of S/G list elements
+ *                   for each data disk.
+ *
+ * @return None.
+ *
+ * @notes
+ *  The caller has already initialized the element count vector.
+ *
+ ***************************************************************************/
+
+void fbe_raid_scatter_contiguous_to_bed(fbe_lba_t lda,
+                                        fbe_block_count_t blks_to_scatter,
+                                        fbe_u16_t data_pos,
+                                        fbe_u16_t data_disks,
+                                        fbe_lba_t blks_per_element,
+                                        fbe_u32_t sg_total[])
+{
+    fbe_block_count_t blks_for_disk;    /* num blocks to write into stripe element */
+
+    blks_for_disk = FBE_MIN(blks_to_scatter, blks_per_element -
+                                       (lda % blks_per_element));
+
+    while (0 < blks_for_disk)
+    {
+        sg_total[data_pos]++;
+
+        data_pos = (data_pos + 1) % data_disks;
+
+        blks_to_scatter -= blks_for_disk;
+        blks_for_disk = FBE_MIN(blks_to_scatter, blks_per_element);
+    }
+    return;
+}
+/**************************************
+ * end fbe_raid_scatter_contiguous_to_bed()
+ **************************************/
+
+/*!***************************************************************************
+ * fbe_raid_sg_count_fragments()
+ ***************************************************************************
+ * @brief
+ *  Determine the number of S/G elements in a list and the number of
+ *  fragments it is made of once physically adjacent elements are merged
+ *  the way fbe_raid_sg_clip_sg_list() merges them.
+ *
+ * @param sg_p - start of the S/G list.
+ * @param sg_count_p - number of S/G elements in the list.
+ * @param fragments_p - number of contiguous memory runs in the list.
+ *
+ * @return None.
+ *
+ ***************************************************************************/
+
+void fbe_raid_sg_count_fragments(fbe_sg_element_t *sg_p,
+                                 fbe_u32_t *sg_count_p,
+                                 fbe_u32_t *fragments_p)
+{
+    fbe_u32_t sg_count = 0;
+    fbe_u32_t fragments = 0;
+
+    while (sg_p->count != 0)
+    {
+        if ((sg_count == 0) ||
+            !fbe_raid_sg_is_adjacent(sg_p - 1, sg_p))
+        {
+            fragments++;
+        }
+        sg_count++;
+        sg_p++;
+    }
+    *sg_count_p = sg_count;
+    *fragments_p = fragments;
+    return;
+}
+/**************************************
+ * end fbe_raid_sg_count_fragments()
+ **************************************/
 /***************************************************************************
  * fbe_raid_scatter_sg_with_memory()
  ***************************************************************************
@@ -819,6 +911,7 @@ fbe_status_t fbe_raid_sg_count_nonuniform_blocks(fbe_block_count_t blks_to_count
                                               fbe_u32_t * sg_total_ptr)
 {
     fbe_status_t status = FBE_STATUS_OK;
+    fbe_sg_element_t *prev_sg_p = NULL;
     
     if(RAID_COND(0 >= *blks_remaining_ptr) )
     {
@@ -831,14 +924,21 @@ fbe_status_t fbe_raid_sg_count_nonuniform_blocks(fbe_block_count_t blks_to_count
 
     if (0 < blks_to_count)
     {
+        fbe_bool_t b_adjacent = FBE_FALSE;
+
         while (0 < *blks_remaining_ptr)
         {
             /*
              * Anticipate assignment of some portion
              * these blocks to another S/G element.
+             * A source element that starts where the previous one
+             * ended is merged into it by fbe_raid_sg_clip_sg_list().
              */
 
-            (*sg_total_ptr)++;
+            if (!b_adjacent)
+            {
+                (*sg_total_ptr)++;
+            }
 
             if (*blks_remaining_ptr > blks_to_count)
             {
@@ -860,8 +960,10 @@ fbe_status_t fbe_raid_sg_count_nonuniform_blocks(fbe_block_count_t blks_to_count
              */
 
             blks_to_count -= *blks_remaining_ptr;
+            prev_sg_p = src_sgd_ptr->sg_element;
             src_sgd_ptr->sg_element = src_sgd_ptr->get_next_sg_fn(src_sgd_ptr->sg_element);
             *blks_remaining_ptr = src_sgd_ptr->sg_element->count / bytes_per_blk;
+            b_adjacent = fbe_raid_sg_is_adjacent(prev_sg_p, src_sgd_ptr->sg_element);
 
             if (0 >= blks_to_count)
             {
@@ -1009,6 +1111,7 @@ fbe_status_t fbe_raid_sg_clip_sg_list(fbe_sg_element_with_offset_t * src_sgd_ptr
     else
     {
         fbe_sg_element_t src_sg_element;    /* element from source S/G list */
+        fbe_u32_t bytes_to_copy;            /* bytes taken from the source element */
         fbe_raid_sg_declare_physical_address(fbe_u64_t phys_addr_local = 0);
 
         /*
@@ -1057,13 +1160,29 @@ fbe_status_t fbe_raid_sg_clip_sg_list(fbe_sg_element_with_offset_t * src_sgd_ptr
             // For Release-13 Buffer memory IS in virtual space so this
             // check is inappropriate. 
             // assert (HEMI_IS_PSEUDO_ADR_DATA(SG_ADDRESS(&src_sg_element)));
-            sg_total++;
+            bytes_to_copy = FBE_MIN(dest_bytecnt, src_sg_element.count);
 
-            dest_sgl_ptr->address = src_sg_element.address;
+            if ((sg_total > 0) &&
+                fbe_raid_sg_is_adjacent(dest_sgl_ptr - 1, &src_sg_element))
+            {
+                /* This source element starts where the last destination
+                 * element ends, so just grow the last element.  This keeps 
+                 * fragmented host buffers from producing long lists that 
+                 * xor and the miniport would have to walk. 
+                 */
+                (dest_sgl_ptr - 1)->count += bytes_to_copy;
+            }
+            else
+            {
+                sg_total++;
+
+                dest_sgl_ptr->address = src_sg_element.address;
 
+                fbe_raid_sg_get_physical_address(&src_sg_element, phys_addr_local);
+                fbe_raid_sg_set_physical_address(dest_sgl_ptr, phys_addr_local);            
 
-            fbe_raid_sg_get_physical_address(&src_sg_element, phys_addr_local);
-            fbe_raid_sg_set_physical_address(dest_sgl_ptr, phys_addr_local);            
+                (dest_sgl_ptr++)->count = bytes_to_copy;
+            }
 
             if (dest_bytecnt < src_sg_element.count)
             {
@@ -1074,7 +1193,6 @@ fbe_status_t fbe_raid_sg_clip_sg_list(fbe_sg_element_with_offset_t * src_sgd_ptr
                  * and leave the loop.
                  */
 
-                (dest_sgl_ptr++)->count = dest_bytecnt,
                 src_sgd_ptr->offset += dest_bytecnt;
 
                 break;
@@ -1091,7 +1209,6 @@ fbe_status_t fbe_raid_sg_clip_sg_list(fbe_sg_element_with_offset_t * src_sgd_ptr
 #ifndef XOR_ASIC_ARCH           
             // assert (HEMI_IS_PSEUDO_ADR_DATA(dest_sgl_ptr->address));
 #endif
-            (dest_sgl_ptr++)->count = src_sg_element.count,
             dest_bytecnt -= src_sg_element.count;
 
             src_sgd_ptr->sg_element = src_sgd_ptr->get_next_sg_fn(src_sgd_ptr->sg_element);
@@ -518,6 +518,60 @@ fbe_status_t fbe_raid_siots_setup_cached_sgd(fbe_raid_siots_t *siots_p, fbe_sg_e
 /******************************************
  * end fbe_raid_siots_setup_cached_sgd()
  ******************************************/
+/*!**************************************************************
+ * fbe_raid_siots_scatter_cache_to_bed()
+ ****************************************************************
+ * @brief
+ *  Count the sgs needed per position to scatter this siots' part of
+ *  the host sg list.  When the host memory is one contiguous run we
+ *  know each stripe element takes exactly one sg, so there is no need
+ *  to walk the host sg list.  This gives the same counts as
+ *  fbe_raid_scatter_cache_to_bed() since the clip merges adjacent elements.
+ *
+ * @param siots_p - The current request.
+ * @param data_pos - position of first block in vector.
+ * @param data_disks - number of data disks in the array.
+ * @param blks_per_element - number of sectors per stripe element.
+ * @param src_sgd_ptr - Host sg descriptor from fbe_raid_siots_setup_cached_sgd().
+ * @param sg_total - vector holding number of sg elements for each data disk.
+ *
+ * @return fbe_status_t
+ *
+ ****************************************************************/
+fbe_status_t fbe_raid_siots_scatter_cache_to_bed(fbe_raid_siots_t *siots_p,
+                                                fbe_u16_t data_pos,
+                                                fbe_u16_t data_disks,
+                                                fbe_lba_t blks_per_element,
+                                                fbe_sg_element_with_offset_t *src_sgd_ptr,
+                                                fbe_u32_t sg_total[])
+{
+    fbe_raid_iots_t *iots_p = fbe_raid_siots_get_iots(siots_p);
+
+    /* Operations like zero re-use one buffer for all the data, in that case 
+     * the descriptor does not walk the host sg list and we need to count. 
+     */
+    if ((src_sgd_ptr->get_next_sg_fn == fbe_sg_element_with_offset_get_next_sg) &&
+        (fbe_raid_iots_get_host_sg_fragments(iots_p) == 1))
+    {
+        fbe_raid_scatter_contiguous_to_bed(siots_p->start_lba,
+                                           siots_p->xfer_count,
+                                           data_pos,
+                                           data_disks,
+                                           blks_per_element,
+                                           sg_total);
+        return FBE_STATUS_OK;
+    }
+    return fbe_raid_scatter_cache_to_bed(siots_p->start_lba,
+                                         siots_p->xfer_count,
+                                         data_pos,
+                                         data_disks,
+                                         blks_per_element,
+                                         src_sgd_ptr,
+                                         sg_total);
+}
+/******************************************
+ * end fbe_raid_siots_scatter_cache_to_bed()
+ ******************************************/
 /*!**************************************************************
  * fbe_raid_siots_init_memory_fields()
  ****************************************************************
@@ -558,13 +558,12 @@ fbe_status_t fbe_striper_write_calculate_num_sgs(fbe_raid_siots_t *siots_p,
             return status;
         }
 
-        status = fbe_raid_scatter_cache_to_bed(siots_p->start_lba,
-                                               siots_p->xfer_count,
-                                               start_pos,
-                                               width,
-                                               elsz,
-                                               &sg_desc,
-                                               num_sg_elements);
+        status = fbe_raid_siots_scatter_cache_to_bed(siots_p,
+                                                     start_pos,
+                                                     width,
+                                                     elsz,
+                                                     &sg_desc,
+                                                     num_sg_elements);
         if (RAID_COND_STATUS((status != FBE_STATUS_OK), status))
         {
             fbe_raid_siots_trace(siots_p, FBE_RAID_SIOTS_TRACE_PARAMS_ERROR, 
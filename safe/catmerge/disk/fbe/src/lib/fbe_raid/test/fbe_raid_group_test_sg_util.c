@@ -25,6 +25,8 @@
  *      - fbe_raid_adjust_sg_desc() 
  *      - raid_get_sg_ptr_offset() 
  *      - fbe_raid_fill_invalid_sectors() 
+ *      - fbe_raid_sg_count_fragments() 
+ *      - fbe_raid_scatter_contiguous_to_bed() 
  *
  *  This file also contains following utility functions:
  *      - util_rg_init_sg_list_ap()
@@ -1741,6 +1743,327 @@ static void utest_raid_fill_invalid_sectors(void)
  * end utest_raid_fill_invalid_sectors()
  ******************************************/
 #endif
+/* Host buffer used by the sg coalescing tests.  Only the addresses are
+ * used, the data is never touched.  It is twice the size of the largest
+ * list so that fragmented lists can leave a gap between elements.
+ */
+#define UTEST_COALESCE_MAX_BLOCKS   1024
+#define UTEST_COALESCE_MAX_DISKS    8
+static fbe_u8_t utest_coalesce_buffer[2 * UTEST_COALESCE_MAX_BLOCKS * FBE_BE_BYTES_PER_BLOCK];
+static fbe_sg_element_t utest_coalesce_sg_list[UTEST_COALESCE_MAX_BLOCKS + 1];
+static fbe_sg_element_t utest_coalesce_dest_pool[UTEST_COALESCE_MAX_DISKS][UTEST_COALESCE_MAX_BLOCKS + 1];
+
+/*****************************************************************************
+ * util_rg_init_sg_list_fragments()
+ *****************************************************************************
+ * @brief
+ *   Initializes an SG list of one block elements in the coalesce buffer.
+ *   Elements either follow each other in memory or leave a one block gap, 
+ *   and a gap can also be left before a single element.
+ *
+ *   sgl [IO] - list of SG elements, terminated.
+ *   blocks [I] - number of one block elements.
+ *   b_adjacent [I] - FBE_TRUE to place elements next to each other.
+ *   gap_index [I] - element to leave a gap in front of, or blocks for none.
+ *  
+ * @return
+ *   None.
+ * 
+ ****************************************************************************/
+static void util_rg_init_sg_list_fragments(fbe_sg_element_t *sgl,
+                                           fbe_u32_t blocks,
+                                           fbe_bool_t b_adjacent,
+                                           fbe_u32_t gap_index)
+{
+    fbe_u8_t *address_p = &utest_coalesce_buffer[0];
+    fbe_u32_t sg_index;
+
+    for (sg_index = 0; sg_index < blocks; sg_index++)
+    {
+        if (!b_adjacent || (sg_index == gap_index))
+        {
+            address_p += FBE_BE_BYTES_PER_BLOCK;
+        }
+        sgl[sg_index].address = address_p;
+        sgl[sg_index].count = FBE_BE_BYTES_PER_BLOCK;
+        address_p += FBE_BE_BYTES_PER_BLOCK;
+    }
+    sgl[sg_index].address = NULL;
+    sgl[sg_index].count = 0;
+    return;
+}
+/******************************************
+ * end util_rg_init_sg_list_fragments()
+ ******************************************/
+
+/*********************************************************************
+ * fbe_raid_group_test_clip_sg_list_coalesce()
+ *********************************************************************
+ * @brief
+ *   Make sure that fbe_raid_sg_count_fragments(), 
+ *   fbe_raid_sg_count_nonuniform_blocks() and fbe_raid_sg_clip_sg_list()
+ *   all merge adjacent source elements the same way.
+ *
+ * @return
+ *   None.
+ * 
+ ********************************************************************/
+static void fbe_raid_group_test_clip_sg_list_coalesce(void)
+{
+    #define UTEST_COALESCE_LIST_BLOCKS 64
+    #define UTEST_COALESCE_GAP_INDEX   32
+    fbe_sg_element_t *sgl = &utest_coalesce_sg_list[0];
+    fbe_sg_element_t *dest_sgl = &utest_coalesce_dest_pool[0][0];
+    fbe_sg_element_with_offset_t sgd;
+    fbe_u32_t sg_count;
+    fbe_u32_t fragments;
+    fbe_u32_t sg_total;
+    fbe_u16_t sg_used;
+    fbe_block_count_t blks_remaining;
+    fbe_status_t status;
+
+    /* Fully adjacent list is a single fragment.
+     */
+    util_rg_init_sg_list_fragments(sgl, UTEST_COALESCE_LIST_BLOCKS, FBE_TRUE, UTEST_COALESCE_LIST_BLOCKS);
+    fbe_raid_sg_count_fragments(sgl, &sg_count, &fragments);
+    MUT_ASSERT_INT_EQUAL(UTEST_COALESCE_LIST_BLOCKS, sg_count);
+    MUT_ASSERT_INT_EQUAL(1, fragments);
+
+    /* Count and clip 40 blocks starting 3 blocks in, this takes one element.
+     */
+    sg_total = 0;
+    fbe_sg_element_with_offset_init(&sgd, 3 * FBE_BE_BYTES_PER_BLOCK, sgl, NULL);
+    fbe_raid_adjust_sg_desc(&sgd);
+    blks_remaining = (sgd.sg_element->count - sgd.offset) / FBE_BE_BYTES_PER_BLOCK;
+    status = fbe_raid_sg_count_nonuniform_blocks(40, &sgd, FBE_BE_BYTES_PER_BLOCK, &blks_remaining, &sg_total);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    MUT_ASSERT_INT_EQUAL(1, sg_total);
+
+    fbe_sg_element_with_offset_init(&sgd, 3 * FBE_BE_BYTES_PER_BLOCK, sgl, NULL);
+    status = fbe_raid_sg_clip_sg_list(&sgd, dest_sgl, 40 * FBE_BE_BYTES_PER_BLOCK, &sg_used);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    MUT_ASSERT_INT_EQUAL(1, sg_used);
+    MUT_ASSERT_TRUE(dest_sgl[0].address == sgl[3].address);
+    MUT_ASSERT_INT_EQUAL(40 * FBE_BE_BYTES_PER_BLOCK, dest_sgl[0].count);
+    MUT_ASSERT_INT_EQUAL(0, dest_sgl[1].count);
+    MUT_ASSERT_TRUE(sgd.sg_element == &sgl[43]);
+    MUT_ASSERT_INT_EQUAL(0, sgd.offset);
+
+    /* A single gap splits the same range in two.
+     */
+    util_rg_init_sg_list_fragments(sgl, UTEST_COALESCE_LIST_BLOCKS, FBE_TRUE, UTEST_COALESCE_GAP_INDEX);
+    fbe_raid_sg_count_fragments(sgl, &sg_count, &fragments);
+    MUT_ASSERT_INT_EQUAL(2, fragments);
+
+    sg_total = 0;
+    fbe_sg_element_with_offset_init(&sgd, 3 * FBE_BE_BYTES_PER_BLOCK, sgl, NULL);
+    fbe_raid_adjust_sg_desc(&sgd);
+    blks_remaining = (sgd.sg_element->count - sgd.offset) / FBE_BE_BYTES_PER_BLOCK;
+    status = fbe_raid_sg_count_nonuniform_blocks(40, &sgd, FBE_BE_BYTES_PER_BLOCK, &blks_remaining, &sg_total);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    MUT_ASSERT_INT_EQUAL(2, sg_total);
+
+    fbe_sg_element_with_offset_init(&sgd, 3 * FBE_BE_BYTES_PER_BLOCK, sgl, NULL);
+    status = fbe_raid_sg_clip_sg_list(&sgd, dest_sgl, 40 * FBE_BE_BYTES_PER_BLOCK, &sg_used);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    MUT_ASSERT_INT_EQUAL(2, sg_used);
+    MUT_ASSERT_TRUE(dest_sgl[0].address == sgl[3].address);
+    MUT_ASSERT_INT_EQUAL((UTEST_COALESCE_GAP_INDEX - 3) * FBE_BE_BYTES_PER_BLOCK, dest_sgl[0].count);
+    MUT_ASSERT_TRUE(dest_sgl[1].address == sgl[UTEST_COALESCE_GAP_INDEX].address);
+    MUT_ASSERT_INT_EQUAL((43 - UTEST_COALESCE_GAP_INDEX) * FBE_BE_BYTES_PER_BLOCK, dest_sgl[1].count);
+    MUT_ASSERT_INT_EQUAL(0, dest_sgl[2].count);
+
+    /* Nothing is merged when every element is apart.
+     */
+    util_rg_init_sg_list_fragments(sgl, UTEST_COALESCE_LIST_BLOCKS, FBE_FALSE, UTEST_COALESCE_LIST_BLOCKS);
+    fbe_raid_sg_count_fragments(sgl, &sg_count, &fragments);
+    MUT_ASSERT_INT_EQUAL(UTEST_COALESCE_LIST_BLOCKS, fragments);
+
+    fbe_sg_element_with_offset_init(&sgd, 0, sgl, NULL);
+    status = fbe_raid_sg_clip_sg_list(&sgd, dest_sgl, 40 * FBE_BE_BYTES_PER_BLOCK, &sg_used);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+    MUT_ASSERT_INT_EQUAL(40, sg_used);
+    return;
+}
+/******************************************
+ * end fbe_raid_group_test_clip_sg_list_coalesce()
+ ******************************************/
+
+/*********************************************************************
+ * fbe_raid_group_test_scatter_contiguous_to_bed()
+ *********************************************************************
+ * @brief
+ *   Validate that counting a contiguous host buffer with 
+ *   fbe_raid_scatter_contiguous_to_bed() gives the same counts as
+ *   walking it with fbe_raid_scatter_cache_to_bed(), and that 
+ *   fbe_raid_scatter_sg_to_bed() fills exactly that many elements.
+ *
+ * @return
+ *   None.
+ * 
+ ********************************************************************/
+static void fbe_raid_group_test_scatter_contiguous_to_bed(void)
+{
+    #define UTEST_CONTIGUOUS_BLOCKS 64
+    fbe_sg_element_t *sgl = &utest_coalesce_sg_list[0];
+    fbe_sg_element_t *dest_sgl_ptrv[UTEST_COALESCE_MAX_DISKS];
+    fbe_u32_t walked_total[UTEST_COALESCE_MAX_DISKS];
+    fbe_u32_t contiguous_total[UTEST_COALESCE_MAX_DISKS];
+    fbe_sg_element_with_offset_t sgd;
+    fbe_u16_t data_disks;
+    fbe_u16_t data_pos;
+    fbe_u32_t elsz_index;
+    fbe_u32_t blocks;
+    fbe_u32_t pos;
+    fbe_lba_t lda;
+    fbe_status_t status;
+
+    util_rg_init_sg_list_fragments(sgl, UTEST_CONTIGUOUS_BLOCKS, FBE_TRUE, UTEST_CONTIGUOUS_BLOCKS);
+
+    for (data_disks = 1; data_disks <= UTEST_COALESCE_MAX_DISKS; data_disks++)
+    {
+        for (data_pos = 0; data_pos < data_disks; data_pos++)
+        {
+            for (elsz_index = 0; elsz_index < MAX_TYPE_OF_ELSZ; elsz_index++)
+            {
+                fbe_u32_t elsz = utest_elsz_type[elsz_index];
+
+                for (lda = 0; lda < elsz; lda += ((elsz > 4) ? (elsz / 4) : 1))
+                {
+                    for (blocks = 1; blocks <= UTEST_CONTIGUOUS_BLOCKS; blocks++)
+                    {
+                        fbe_zero_memory(walked_total, sizeof(walked_total));
+                        fbe_zero_memory(contiguous_total, sizeof(contiguous_total));
+
+                        fbe_sg_element_with_offset_init(&sgd, 0, sgl, NULL);
+                        status = fbe_raid_scatter_cache_to_bed(lda, blocks, data_pos, data_disks, elsz,
+                                                               &sgd, walked_total);
+                        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+                        fbe_raid_scatter_contiguous_to_bed(lda, blocks, data_pos, data_disks, elsz,
+                                                           contiguous_total);
+
+                        for (pos = 0; pos < data_disks; pos++)
+                        {
+                            dest_sgl_ptrv[pos] = &utest_coalesce_dest_pool[pos][0];
+                        }
+                        fbe_sg_element_with_offset_init(&sgd, 0, sgl, NULL);
+                        status = fbe_raid_scatter_sg_to_bed(lda, blocks, data_pos, data_disks, elsz,
+                                                            &sgd, dest_sgl_ptrv);
+                        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+                        for (pos = 0; pos < data_disks; pos++)
+                        {
+                            MUT_ASSERT_INT_EQUAL(walked_total[pos], contiguous_total[pos]);
+                            MUT_ASSERT_INT_EQUAL(walked_total[pos], 
+                                                 (fbe_u32_t)(dest_sgl_ptrv[pos] - &utest_coalesce_dest_pool[pos][0]));
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return;
+}
+/******************************************
+ * end fbe_raid_group_test_scatter_contiguous_to_bed()
+ ******************************************/
+
+/*********************************************************************
+ * fbe_raid_group_test_sg_setup_time()
+ *********************************************************************
+ * @brief
+ *   Measure the time to count and build the per position sg lists
+ *   of a 4+1 raid 5 write for a host buffer made of one block fragments,
+ *   the same buffer with all fragments adjacent, and the adjacent buffer
+ *   counted with the once per iots fragment count.
+ *
+ * @return
+ *   None.
+ * 
+ ********************************************************************/
+static void fbe_raid_group_test_sg_setup_time(void)
+{
+    #define UTEST_SETUP_DATA_DISKS  4
+    #define UTEST_SETUP_ELSZ        0x80
+    #define UTEST_SETUP_PASSES      200
+    fbe_sg_element_t *sgl = &utest_coalesce_sg_list[0];
+    fbe_sg_element_t *dest_sgl_ptrv[UTEST_COALESCE_MAX_DISKS];
+    fbe_u32_t sg_total[UTEST_COALESCE_MAX_DISKS];
+    fbe_sg_element_with_offset_t sgd;
+    fbe_u32_t sg_count;
+    fbe_u32_t fragments;
+    fbe_u32_t total_sgs;
+    fbe_u32_t pass;
+    fbe_u32_t pos;
+    fbe_u32_t layout;
+    fbe_time_t start_time;
+    fbe_time_t elapsed_us;
+    fbe_status_t status;
+    const char *layout_name[3] = {"fragmented", "adjacent", "adjacent, counted once"};
+
+    for (layout = 0; layout < 3; layout++)
+    {
+        util_rg_init_sg_list_fragments(sgl, UTEST_COALESCE_MAX_BLOCKS, (layout != 0), UTEST_COALESCE_MAX_BLOCKS);
+        fbe_raid_sg_count_fragments(sgl, &sg_count, &fragments);
+        total_sgs = 0;
+
+        start_time = fbe_get_time_in_us();
+        for (pass = 0; pass < UTEST_SETUP_PASSES; pass++)
+        {
+            fbe_zero_memory(sg_total, sizeof(sg_total));
+            if ((layout == 2) && (fragments == 1))
+            {
+                fbe_raid_scatter_contiguous_to_bed(0, UTEST_COALESCE_MAX_BLOCKS, 0, UTEST_SETUP_DATA_DISKS,
+                                                   UTEST_SETUP_ELSZ, sg_total);
+            }
+            else
+            {
+                fbe_sg_element_with_offset_init(&sgd, 0, sgl, NULL);
+                status = fbe_raid_scatter_cache_to_bed(0, UTEST_COALESCE_MAX_BLOCKS, 0, UTEST_SETUP_DATA_DISKS,
+                                                       UTEST_SETUP_ELSZ, &sgd, sg_total);
+                MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+            }
+
+            for (pos = 0; pos < UTEST_SETUP_DATA_DISKS; pos++)
+            {
+                dest_sgl_ptrv[pos] = &utest_coalesce_dest_pool[pos][0];
+            }
+            fbe_sg_element_with_offset_init(&sgd, 0, sgl, NULL);
+            status = fbe_raid_scatter_sg_to_bed(0, UTEST_COALESCE_MAX_BLOCKS, 0, UTEST_SETUP_DATA_DISKS,
+                                                UTEST_SETUP_ELSZ, &sgd, dest_sgl_ptrv);
+            MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+        }
+        elapsed_us = fbe_get_time_in_us() - start_time;
+
+        for (pos = 0; pos < UTEST_SETUP_DATA_DISKS; pos++)
+        {
+            MUT_ASSERT_INT_EQUAL(sg_total[pos], 
+                                 (fbe_u32_t)(dest_sgl_ptrv[pos] - &utest_coalesce_dest_pool[pos][0]));
+            total_sgs += sg_total[pos];
+        }
+
+        /* Fragments are only merged when they are adjacent, otherwise every 
+         * host element shows up in a drive sg list. 
+         */
+        if (layout == 0)
+        {
+            MUT_ASSERT_INT_EQUAL(UTEST_COALESCE_MAX_BLOCKS, total_sgs);
+        }
+        else
+        {
+            MUT_ASSERT_INT_EQUAL(UTEST_COALESCE_MAX_BLOCKS / UTEST_SETUP_ELSZ, total_sgs);
+        }
+        mut_printf(MUT_LOG_TEST_STATUS, "sg setup %-24s host sgs: %4d fragments: %4d drive sgs: %4d time per setup: %llu ns",
+                   layout_name[layout], sg_count, fragments, total_sgs,
+                   (unsigned long long)((elapsed_us * 1000) / UTEST_SETUP_PASSES));
+    }
+    return;
+}
+/******************************************
+ * end fbe_raid_group_test_sg_setup_time()
+ ******************************************/
+
 /****************************************************************
  * fbe_raid_library_test_add_sg_util_tests()
  ****************************************************************
@@ -1779,6 +2102,9 @@ void fbe_raid_library_test_add_sg_util_tests(mut_testsuite_t * const suite_p)
     MUT_ADD_TEST(suite_p, fbe_raid_group_test_scatter_cache_to_bed, NULL, NULL);
     MUT_ADD_TEST(suite_p, fbe_raid_group_test_scatter_fed_to_bed, NULL, NULL);
     MUT_ADD_TEST(suite_p, fbe_raid_group_test_scatter_sg_to_bed, NULL, NULL);
+    MUT_ADD_TEST(suite_p, fbe_raid_group_test_clip_sg_list_coalesce, NULL, NULL);
+    MUT_ADD_TEST(suite_p, fbe_raid_group_test_scatter_contiguous_to_bed, NULL, NULL);
+    MUT_ADD_TEST(suite_p, fbe_raid_group_test_sg_setup_time, NULL, NULL);
 
     MUT_RUN_TESTSUITE(sg_suite_p);
 }
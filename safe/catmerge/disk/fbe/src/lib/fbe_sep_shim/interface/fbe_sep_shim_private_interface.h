@@ -49,6 +49,7 @@ fbe_sep_shim_io_struct_t * fbe_sep_shim_process_io_structure_request(fbe_cpu_id_
 void fbe_sep_shim_destroy_waiting_requests(void);
 void fbe_sep_shim_increment_wait_stats(fbe_cpu_id_t cpu_id);
 void fbe_sep_shim_decrement_wait_stats(fbe_cpu_id_t cpu_id);
+fbe_u64_t fbe_sep_shim_get_outstanding_io_count(void);
 void fbe_sep_shim_set_shutdown_in_progress(void);
 fbe_bool_t fbe_sep_shim_is_shutdown_in_progress(void);
 fbe_status_t fbe_sep_shim_display_irp(PEMCPAL_IRP PIrp, fbe_trace_level_t trace_level);
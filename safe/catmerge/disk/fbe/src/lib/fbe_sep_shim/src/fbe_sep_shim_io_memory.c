@@ -12,9 +12,24 @@
 #define FBE_SEP_SHIM_MAX_ALLOCATED_STRUCTURES	1100
 
 
+/*!*******************************************************************
+ * @struct fbe_sep_shim_core_data_t
+ *********************************************************************
+ * @brief
+ *  What the shim counts for one core.  Every I/O only touches the
+ *  entry of the core it was taken from, and the entries are cache line
+ *  aligned so that cores do not bounce each other's lines.  The totals
+ *  are only summed up for quiesce, shutdown and statistics.
+ *
+ *********************************************************************/
+typedef struct fbe_sep_shim_core_data_s{
+    FBE_ALIGN(64)fbe_sep_shim_perf_stat_per_core_t stats;/*MUST be first, the debug extension reads it*/
+    fbe_sep_shim_perf_stat_per_core_t   wait_stats;/*protected by the waiting request lock of the core*/
+    fbe_u64_t                           outstanding_ios;/*always counted, protected by the core lock*/
+}fbe_sep_shim_core_data_t;
+
 /*local varaibles*/
-static fbe_sep_shim_perf_stat_per_core_t    fbe_sep_shim_stats_data[FBE_CPU_ID_MAX];
-static fbe_sep_shim_perf_stat_per_core_t    fbe_sep_shim_wait_stats_data[FBE_CPU_ID_MAX];
+static fbe_sep_shim_core_data_t             fbe_sep_shim_core_data[FBE_CPU_ID_MAX];
 static fbe_multicore_queue_t 				fbe_sep_shim_io_in_progress_queue;
 static fbe_multicore_queue_t 				fbe_sep_shim_pre_allocated_ios_queue;
 static fbe_cpu_id_t			 				fbe_sep_shim_cpu_count = 0;
@@ -55,8 +70,7 @@ void fbe_sep_shim_init_io_memory(void)
     fbe_sep_shim_init_waiting_request_data();
     for (cpu_id = 0; cpu_id < fbe_sep_shim_cpu_count; cpu_id++)
     {
-        fbe_zero_memory(&fbe_sep_shim_stats_data[cpu_id], sizeof(fbe_sep_shim_perf_stat_per_core_t));
-        fbe_zero_memory(&fbe_sep_shim_wait_stats_data[cpu_id], sizeof(fbe_sep_shim_perf_stat_per_core_t));
+        fbe_zero_memory(&fbe_sep_shim_core_data[cpu_id], sizeof(fbe_sep_shim_core_data_t));
         for (io_strcut_count = 0; io_strcut_count < FBE_SEP_SHIM_MAX_ALLOCATED_STRUCTURES; io_strcut_count++)
         {
             sep_shim_io_struct = (fbe_sep_shim_io_struct_t *)fbe_memory_ex_allocate(sizeof(fbe_sep_shim_io_struct_t));
@@ -87,16 +101,16 @@ void fbe_sep_shim_destroy_io_memory(void)
 	for (cpu_id = 0; cpu_id < fbe_sep_shim_cpu_count; cpu_id++) {
 
 		/*do we have ios in flight ?*/
-		while (fbe_sep_shim_stats_data[cpu_id].current_ios_in_progress != 0 && delay_count < 100) {
+		while (fbe_sep_shim_core_data[cpu_id].outstanding_ios != 0 && delay_count < 100) {
 			if (delay_count == 0) {
-				fbe_sep_shim_trace(FBE_TRACE_LEVEL_WARNING, "%s %llu outstanding IOs when destroying !!\n", __FUNCTION__, (unsigned long long)fbe_sep_shim_stats_data[cpu_id].current_ios_in_progress);
+				fbe_sep_shim_trace(FBE_TRACE_LEVEL_WARNING, "%s %llu outstanding IOs when destroying !!\n", __FUNCTION__, (unsigned long long)fbe_sep_shim_core_data[cpu_id].outstanding_ios);
 			}
 			fbe_thread_delay(100);
 			delay_count++;
 		}
 
 		if (delay_count == 100) {
-			fbe_sep_shim_trace(FBE_TRACE_LEVEL_WARNING, "%s %llu outstanding IOs after 10sec, we will leak memory !!\n", __FUNCTION__, (unsigned long long)fbe_sep_shim_stats_data[cpu_id].current_ios_in_progress);
+			fbe_sep_shim_trace(FBE_TRACE_LEVEL_WARNING, "%s %llu outstanding IOs after 10sec, we will leak memory !!\n", __FUNCTION__, (unsigned long long)fbe_sep_shim_core_data[cpu_id].outstanding_ios);
 			continue;
 		}
 
@@ -168,10 +182,7 @@ fbe_sep_shim_io_struct_t * fbe_sep_shim_process_io_structure_request(fbe_cpu_id_
         return NULL;
     }
 
-    if (fbe_sep_shim_stats_enabled)
-    {
-        fbe_sep_shim_increment_io_stats(cpu_id);
-    }
+    fbe_sep_shim_increment_io_stats(cpu_id);
 
     fbe_multicore_queue_unlock(&fbe_sep_shim_pre_allocated_ios_queue, cpu_id);
     return sep_shim_io_struct;
@@ -221,10 +232,7 @@ void fbe_sep_shim_return_io_structure(fbe_sep_shim_io_struct_t *io_struct)
 
     fbe_multicore_queue_push_front(&fbe_sep_shim_pre_allocated_ios_queue, &io_struct->queue_element, cpu_id);
 
-    if (fbe_sep_shim_stats_enabled)
-    {
-        fbe_sep_shim_decrement_io_stats(cpu_id);
-    }
+    fbe_sep_shim_decrement_io_stats(cpu_id);
 
     fbe_multicore_queue_unlock(&fbe_sep_shim_pre_allocated_ios_queue, cpu_id);
 
@@ -250,12 +258,40 @@ void fbe_sep_shim_return_io_structure(fbe_sep_shim_io_struct_t *io_struct)
  ****************************************************************/
 fbe_status_t fbe_sep_shim_get_perf_stat(fbe_sep_shim_get_perf_stat_t *stat)
 {
-    fbe_copy_memory(&stat->core_stat, &fbe_sep_shim_stats_data, sizeof(fbe_sep_shim_perf_stat_per_core_t) * FBE_CPU_ID_MAX );
+    fbe_cpu_id_t    cpu_id = 0;
+
+    fbe_zero_memory(&stat->core_stat, sizeof(fbe_sep_shim_perf_stat_per_core_t) * FBE_CPU_ID_MAX);
+    for (cpu_id = 0; cpu_id < fbe_sep_shim_cpu_count; cpu_id++) {
+        fbe_copy_memory(&stat->core_stat[cpu_id], &fbe_sep_shim_core_data[cpu_id].stats, sizeof(fbe_sep_shim_perf_stat_per_core_t));
+    }
 	stat->structures_per_core = FBE_SEP_SHIM_MAX_ALLOCATED_STRUCTURES;
     
     return FBE_STATUS_OK;
 }
 
+/*!**************************************************************
+ * fbe_sep_shim_get_outstanding_io_count()
+ ****************************************************************
+ * @brief
+ *  Sum up the I/Os in flight on all the cores.  The per core counts
+ *  are read without their locks, so this is only a snapshot.
+ *
+ * @param None.
+ *        
+ * @return fbe_u64_t - Number of I/Os in flight.
+ *
+ ****************************************************************/
+fbe_u64_t fbe_sep_shim_get_outstanding_io_count(void)
+{
+    fbe_cpu_id_t    cpu_id = 0;
+    fbe_u64_t       outstanding_ios = 0;
+
+    for (cpu_id = 0; cpu_id < fbe_sep_shim_cpu_count; cpu_id++) {
+        outstanding_ios += fbe_sep_shim_core_data[cpu_id].outstanding_ios;
+    }
+    return outstanding_ios;
+}
+
 void fbe_sep_shim_perf_stat_enable(void)
 {
 	fbe_sep_shim_perf_stat_clear();
@@ -273,34 +309,41 @@ void fbe_sep_shim_perf_stat_clear(void)
 
     for (cpu_id = 0; cpu_id < fbe_sep_shim_cpu_count; cpu_id++) {
 		fbe_multicore_queue_lock(&fbe_sep_shim_pre_allocated_ios_queue, cpu_id);
-		fbe_zero_memory(&fbe_sep_shim_stats_data[cpu_id], sizeof(fbe_sep_shim_perf_stat_per_core_t));
+		fbe_zero_memory(&fbe_sep_shim_core_data[cpu_id].stats, sizeof(fbe_sep_shim_perf_stat_per_core_t));
+		/*the I/Os in flight are still in flight, do not lose track of them*/
+		fbe_sep_shim_core_data[cpu_id].stats.current_ios_in_progress = fbe_sep_shim_core_data[cpu_id].outstanding_ios;
 		fbe_multicore_queue_unlock(&fbe_sep_shim_pre_allocated_ios_queue, cpu_id);
 	}
 
 }
 
-/*should be called under the lock and only when stats is enabled*/
+/*should be called under the lock, the outstanding count is kept even when stats is disabled*/
 static void fbe_sep_shim_increment_io_stats(fbe_cpu_id_t cpu_id)
 {
-	/*! @todo: Make sure that all IOs (like PSM) 
-	 *  are core affined to save locking and atomic operations here
-	 */
-	fbe_sep_shim_stats_data[cpu_id].current_ios_in_progress++;
-	fbe_sep_shim_stats_data[cpu_id].total_ios++;
+	fbe_sep_shim_core_data_t *core_data_p = &fbe_sep_shim_core_data[cpu_id];
 
-	if (fbe_sep_shim_stats_data[cpu_id].current_ios_in_progress > 
-		fbe_sep_shim_stats_data[cpu_id].max_io_q_depth) {
-		fbe_sep_shim_stats_data[cpu_id].max_io_q_depth = fbe_sep_shim_stats_data[cpu_id].current_ios_in_progress;
+	core_data_p->outstanding_ios++;
+	if (!fbe_sep_shim_stats_enabled) {
+		return;
+	}
+
+	core_data_p->stats.current_ios_in_progress = core_data_p->outstanding_ios;
+	core_data_p->stats.total_ios++;
+
+	if (core_data_p->stats.current_ios_in_progress > core_data_p->stats.max_io_q_depth) {
+		core_data_p->stats.max_io_q_depth = core_data_p->stats.current_ios_in_progress;
 	}
 }
 
-/*should be called under the lock and only when stats is enabled*/
+/*should be called under the lock, the outstanding count is kept even when stats is disabled*/
 static void fbe_sep_shim_decrement_io_stats(fbe_cpu_id_t cpu_id)
 {
-	/*! @todo: Make sure that all IOs (like PSM) 
-	 *  are core affined to save locking and atomic operations here
-	 */
-	fbe_sep_shim_stats_data[cpu_id].current_ios_in_progress--;
+	fbe_sep_shim_core_data_t *core_data_p = &fbe_sep_shim_core_data[cpu_id];
+
+	core_data_p->outstanding_ios--;
+	if (fbe_sep_shim_stats_enabled) {
+		core_data_p->stats.current_ios_in_progress = core_data_p->outstanding_ios;
+	}
 }
 
 /*should be called under the lock and only when stats is enabled*/
@@ -309,12 +352,12 @@ void fbe_sep_shim_increment_wait_stats(fbe_cpu_id_t cpu_id)
 	/*! @todo: Make sure that all IOs (like PSM) 
 	 *  are core affined to save locking and atomic operations here
 	 */
-	fbe_sep_shim_wait_stats_data[cpu_id].current_ios_in_progress++;
-	fbe_sep_shim_wait_stats_data[cpu_id].total_ios++;
+	fbe_sep_shim_core_data[cpu_id].wait_stats.current_ios_in_progress++;
+	fbe_sep_shim_core_data[cpu_id].wait_stats.total_ios++;
 
-	if (fbe_sep_shim_wait_stats_data[cpu_id].current_ios_in_progress > 
-		fbe_sep_shim_wait_stats_data[cpu_id].max_io_q_depth) {
-		fbe_sep_shim_wait_stats_data[cpu_id].max_io_q_depth = fbe_sep_shim_wait_stats_data[cpu_id].current_ios_in_progress;
+	if (fbe_sep_shim_core_data[cpu_id].wait_stats.current_ios_in_progress > 
+		fbe_sep_shim_core_data[cpu_id].wait_stats.max_io_q_depth) {
+		fbe_sep_shim_core_data[cpu_id].wait_stats.max_io_q_depth = fbe_sep_shim_core_data[cpu_id].wait_stats.current_ios_in_progress;
 	}
 }
 
@@ -324,7 +367,7 @@ void fbe_sep_shim_decrement_wait_stats(fbe_cpu_id_t cpu_id)
 	/*! @todo: Make sure that all IOs (like PSM) 
 	 *  are core affined to save locking and atomic operations here
 	 */
-	fbe_sep_shim_wait_stats_data[cpu_id].current_ios_in_progress--;
+	fbe_sep_shim_core_data[cpu_id].wait_stats.current_ios_in_progress--;
 }
 fbe_bool_t fbe_sep_shim_is_io_drained(void)
 {
@@ -400,7 +443,8 @@ fbe_status_t fbe_sep_shim_shutdown_bvd(void)
     fbe_sep_shim_trace(FBE_TRACE_LEVEL_INFO, "%s Wait for I/O to Drain. \n", __FUNCTION__);
     drained = fbe_sep_shim_is_io_drained();
     while (!drained) {
-        fbe_sep_shim_trace(FBE_TRACE_LEVEL_INFO, "%s IO is not drained yet, wait 1 sec. \n", __FUNCTION__);
+        fbe_sep_shim_trace(FBE_TRACE_LEVEL_INFO, "%s IO is not drained yet, %llu in flight, wait 1 sec. \n", 
+                           __FUNCTION__, (unsigned long long)fbe_sep_shim_get_outstanding_io_count());
         fbe_thread_delay(1000);
         wait_seconds += 1;
         if (wait_seconds >= (2 * 60)) {
@@ -0,0 +1,269 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2014
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!*************************************************************************
+ * @file fbe_sep_shim_test_main.c
+ ***************************************************************************
+ *
+ * @brief
+ *  Unit tests of the per core I/O counts of the SEP shim.
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "fbe/fbe_winddk.h"
+#include "fbe/fbe_types.h"
+#include "fbe/fbe_platform.h"
+#include "mut.h"
+#include "fbe/fbe_sep_shim.h"
+#include "fbe_sep_shim_private_interface.h"
+#include "fbe/fbe_emcutil_shell_include.h"
+
+/*!*******************************************************************
+ * @def SEP_SHIM_TEST_MAX_CORES
+ *********************************************************************
+ * @brief Most cores we take I/O structures on.
+ *
+ *********************************************************************/
+#define SEP_SHIM_TEST_MAX_CORES 4
+
+/*!*******************************************************************
+ * @def SEP_SHIM_TEST_MAX_IOS
+ *********************************************************************
+ * @brief Most I/O structures we hold at once.
+ *
+ *********************************************************************/
+#define SEP_SHIM_TEST_MAX_IOS ((SEP_SHIM_TEST_MAX_CORES * (SEP_SHIM_TEST_MAX_CORES + 1)) / 2)
+
+static fbe_sep_shim_io_struct_t *sep_shim_test_ios[SEP_SHIM_TEST_MAX_IOS];
+static fbe_u32_t sep_shim_test_io_count;
+static fbe_sep_shim_get_perf_stat_t sep_shim_test_stats;
+
+/*!**************************************************************
+ * sep_shim_test_setup()
+ ****************************************************************
+ * @brief
+ *  Start every test with the I/O structures of every core free.
+ *
+ ****************************************************************/
+static void sep_shim_test_setup(void)
+{
+    fbe_sep_shim_init_io_memory();
+    sep_shim_test_io_count = 0;
+    return;
+}
+
+/*!**************************************************************
+ * sep_shim_test_teardown()
+ ****************************************************************
+ * @brief
+ *  Free the I/O structures.
+ *
+ ****************************************************************/
+static void sep_shim_test_teardown(void)
+{
+    fbe_sep_shim_perf_stat_disable();
+    fbe_sep_shim_destroy_io_memory();
+    return;
+}
+
+/*!**************************************************************
+ * sep_shim_test_get_core_count()
+ ****************************************************************
+ * @brief
+ *  Return the number of cores the tests take I/O structures on.
+ *
+ ****************************************************************/
+static fbe_u32_t sep_shim_test_get_core_count(void)
+{
+    return FBE_MIN(fbe_get_cpu_count(), SEP_SHIM_TEST_MAX_CORES);
+}
+
+/*!**************************************************************
+ * sep_shim_test_start_ios()
+ ****************************************************************
+ * @brief
+ *  Take I/O structures on one core, the way the shim does when
+ *  a host I/O arrives on that core.
+ *
+ ****************************************************************/
+static void sep_shim_test_start_ios(fbe_cpu_id_t cpu_id, fbe_u32_t io_count)
+{
+    fbe_sep_shim_io_struct_t *io_struct_p;
+    fbe_u32_t index;
+
+    for (index = 0; index < io_count; index++)
+    {
+        MUT_ASSERT_TRUE(sep_shim_test_io_count < SEP_SHIM_TEST_MAX_IOS);
+        io_struct_p = fbe_sep_shim_process_io_structure_request(cpu_id, &sep_shim_test_ios[sep_shim_test_io_count]);
+        MUT_ASSERT_NOT_NULL(io_struct_p);
+        MUT_ASSERT_INT_EQUAL(cpu_id, io_struct_p->core_take_from);
+
+        /* No packet or memory was allocated for these.
+         */
+        io_struct_p->memory_request.ptr = NULL;
+        io_struct_p->buffer.ptr = NULL;
+        sep_shim_test_ios[sep_shim_test_io_count++] = io_struct_p;
+    }
+    return;
+}
+
+/*!**************************************************************
+ * sep_shim_test_complete_ios()
+ ****************************************************************
+ * @brief
+ *  Return every I/O structure taken.  Each one goes back to the
+ *  core it was taken from.
+ *
+ ****************************************************************/
+static void sep_shim_test_complete_ios(void)
+{
+    while (sep_shim_test_io_count > 0)
+    {
+        fbe_sep_shim_return_io_structure(sep_shim_test_ios[--sep_shim_test_io_count]);
+    }
+    return;
+}
+
+/*!**************************************************************
+ * sep_shim_test_per_core_counts()
+ ****************************************************************
+ * @brief
+ *  I/Os started on several cores are only counted on their own
+ *  core, and the outstanding count is the sum of all the cores.
+ *
+ ****************************************************************/
+static void sep_shim_test_per_core_counts(void)
+{
+    fbe_u32_t core_count = sep_shim_test_get_core_count();
+    fbe_u32_t expected_outstanding = 0;
+    fbe_cpu_id_t cpu_id;
+
+    fbe_sep_shim_perf_stat_enable();
+
+    /* Core n holds n + 1 I/Os so that a count landing on the wrong core shows.
+     */
+    for (cpu_id = 0; cpu_id < core_count; cpu_id++)
+    {
+        sep_shim_test_start_ios(cpu_id, cpu_id + 1);
+        expected_outstanding += cpu_id + 1;
+    }
+    MUT_ASSERT_UINT64_EQUAL(expected_outstanding, fbe_sep_shim_get_outstanding_io_count());
+
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, fbe_sep_shim_get_perf_stat(&sep_shim_test_stats));
+    for (cpu_id = 0; cpu_id < core_count; cpu_id++)
+    {
+        MUT_ASSERT_UINT64_EQUAL(cpu_id + 1, sep_shim_test_stats.core_stat[cpu_id].current_ios_in_progress);
+        MUT_ASSERT_UINT64_EQUAL(cpu_id + 1, sep_shim_test_stats.core_stat[cpu_id].total_ios);
+        MUT_ASSERT_UINT64_EQUAL(cpu_id + 1, sep_shim_test_stats.core_stat[cpu_id].max_io_q_depth);
+    }
+
+    sep_shim_test_complete_ios();
+    MUT_ASSERT_UINT64_EQUAL(0, fbe_sep_shim_get_outstanding_io_count());
+
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, fbe_sep_shim_get_perf_stat(&sep_shim_test_stats));
+    for (cpu_id = 0; cpu_id < core_count; cpu_id++)
+    {
+        MUT_ASSERT_UINT64_EQUAL(0, sep_shim_test_stats.core_stat[cpu_id].current_ios_in_progress);
+        MUT_ASSERT_UINT64_EQUAL(cpu_id + 1, sep_shim_test_stats.core_stat[cpu_id].total_ios);
+        MUT_ASSERT_UINT64_EQUAL(cpu_id + 1, sep_shim_test_stats.core_stat[cpu_id].max_io_q_depth);
+    }
+    return;
+}
+
+/*!**************************************************************
+ * sep_shim_test_clear_in_flight()
+ ****************************************************************
+ * @brief
+ *  Clearing the statistics with I/Os in flight keeps them in
+ *  flight, so the counts do not wrap when they complete.
+ *
+ ****************************************************************/
+static void sep_shim_test_clear_in_flight(void)
+{
+    fbe_u32_t core_count = sep_shim_test_get_core_count();
+    fbe_cpu_id_t cpu_id;
+
+    fbe_sep_shim_perf_stat_enable();
+    for (cpu_id = 0; cpu_id < core_count; cpu_id++)
+    {
+        sep_shim_test_start_ios(cpu_id, 2);
+    }
+
+    fbe_sep_shim_perf_stat_clear();
+    MUT_ASSERT_UINT64_EQUAL(2 * core_count, fbe_sep_shim_get_outstanding_io_count());
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, fbe_sep_shim_get_perf_stat(&sep_shim_test_stats));
+    for (cpu_id = 0; cpu_id < core_count; cpu_id++)
+    {
+        MUT_ASSERT_UINT64_EQUAL(2, sep_shim_test_stats.core_stat[cpu_id].current_ios_in_progress);
+        MUT_ASSERT_UINT64_EQUAL(0, sep_shim_test_stats.core_stat[cpu_id].total_ios);
+    }
+
+    sep_shim_test_complete_ios();
+    MUT_ASSERT_UINT64_EQUAL(0, fbe_sep_shim_get_outstanding_io_count());
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, fbe_sep_shim_get_perf_stat(&sep_shim_test_stats));
+    for (cpu_id = 0; cpu_id < core_count; cpu_id++)
+    {
+        MUT_ASSERT_UINT64_EQUAL(0, sep_shim_test_stats.core_stat[cpu_id].current_ios_in_progress);
+    }
+    return;
+}
+
+/*!**************************************************************
+ * sep_shim_test_stats_disabled()
+ ****************************************************************
+ * @brief
+ *  The outstanding count is kept while the statistics are
+ *  disabled, since shutdown and quiesce wait on it.
+ *
+ ****************************************************************/
+static void sep_shim_test_stats_disabled(void)
+{
+    fbe_u32_t core_count = sep_shim_test_get_core_count();
+    fbe_cpu_id_t cpu_id;
+
+    fbe_sep_shim_perf_stat_enable();
+    fbe_sep_shim_perf_stat_disable();
+    for (cpu_id = 0; cpu_id < core_count; cpu_id++)
+    {
+        sep_shim_test_start_ios(cpu_id, 1);
+    }
+    MUT_ASSERT_UINT64_EQUAL(core_count, fbe_sep_shim_get_outstanding_io_count());
+
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, fbe_sep_shim_get_perf_stat(&sep_shim_test_stats));
+    for (cpu_id = 0; cpu_id < core_count; cpu_id++)
+    {
+        MUT_ASSERT_UINT64_EQUAL(0, sep_shim_test_stats.core_stat[cpu_id].total_ios);
+    }
+
+    sep_shim_test_complete_ios();
+    MUT_ASSERT_UINT64_EQUAL(0, fbe_sep_shim_get_outstanding_io_count());
+    return;
+}
+
+int __cdecl main (int argc , char ** argv)
+{
+    mut_testsuite_t *sepShimSuite;
+
+#include "fbe/fbe_emcutil_shell_maincode.h"
+
+    mut_init(argc, argv);
+
+    sepShimSuite = MUT_CREATE_TESTSUITE("sepShimSuite")
+    MUT_ADD_TEST(sepShimSuite, sep_shim_test_per_core_counts, sep_shim_test_setup, sep_shim_test_teardown);
+    MUT_ADD_TEST(sepShimSuite, sep_shim_test_clear_in_flight, sep_shim_test_setup, sep_shim_test_teardown);
+    MUT_ADD_TEST(sepShimSuite, sep_shim_test_stats_disabled, sep_shim_test_setup, sep_shim_test_teardown);
+
+    MUT_RUN_TESTSUITE(sepShimSuite);
+
+    exit(0);
+}
+
+/*************************
+ * end file fbe_sep_shim_test_main.c
+ *************************/
@@ -0,0 +1,773 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2014
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!*************************************************************************
+ * @file fbe_spare_index.c
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains the in-memory index of the hot spare candidates. The
+ *  spare selection used to send a get spare info packet to every pvd in the
+ *  spare pool for every swap-in request.  When many drives fail at once the
+ *  job service spends most of its time collecting the same information over
+ *  and over.  The index keeps the spare information of each pvd and the pvd
+ *  notifications invalidate the entry of any pvd that changes, so that a
+ *  selection only sends packets for the pvds that changed since the last one.
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "fbe/fbe_types.h"
+#include "fbe/fbe_winddk.h"
+#include "fbe/fbe_time.h"
+#include "fbe/fbe_notification_interface.h"
+#include "fbe_base_service.h"
+#include "fbe_service_manager.h"
+#include "fbe_transport_memory.h"
+#include "fbe/fbe_library_interface.h"
+#include "fbe_spare.h"
+#include "fbe_spare_lib_private.h"
+
+/*!*******************************************************************
+ * @def FBE_SPARE_INDEX_NUM_ENTRIES
+ *********************************************************************
+ * @brief Number of entries in the index.  Twice the number of spare
+ *        objects keeps the linear probes short.
+ *
+ *********************************************************************/
+#define FBE_SPARE_INDEX_NUM_ENTRIES         (FBE_MAX_SPARE_OBJECTS * 2)
+
+/*!*******************************************************************
+ * @def FBE_SPARE_INDEX_MAX_USED_ENTRIES
+ *********************************************************************
+ * @brief Once this many entries are used the index is cleared and
+ *        refilled by the following selections.
+ *
+ *********************************************************************/
+#define FBE_SPARE_INDEX_MAX_USED_ENTRIES    ((FBE_SPARE_INDEX_NUM_ENTRIES * 3) / 4)
+
+/*!*******************************************************************
+ * @def FBE_SPARE_INDEX_MAX_AGE_MS
+ *********************************************************************
+ * @brief Maximum age of an entry.  Older entries are fetched again even
+ *        if no notification was received for the pvd.
+ *
+ *********************************************************************/
+#define FBE_SPARE_INDEX_MAX_AGE_MS          10000
+
+/*!****************************************************************************
+ * @struct fbe_spare_index_entry_t
+ ******************************************************************************
+ * @brief
+ *  One entry of the spare index.  Once used an entry keeps its object id
+ *  until the index is cleared so that the linear probing never breaks.
+ ******************************************************************************/
+typedef struct fbe_spare_index_entry_s
+{
+    fbe_object_id_t         object_id;          /*!< Pvd object id or invalid if unused. */
+    fbe_bool_t              b_valid;            /*!< FBE_TRUE if the spare info is current. */
+    fbe_u32_t               generation;         /*!< Changed whenever the pvd is invalidated. */
+    fbe_time_t              fetch_time;         /*!< Time the spare info was fetched. */
+    fbe_spare_drive_info_t  spare_drive_info;   /*!< Spare info returned by the pvd. */
+} fbe_spare_index_entry_t;
+
+/*!****************************************************************************
+ * @struct fbe_spare_index_t
+ ******************************************************************************
+ * @brief
+ *  The spare index and its notification registration.
+ ******************************************************************************/
+typedef struct fbe_spare_index_s
+{
+    fbe_spinlock_t              lock;
+    fbe_bool_t                  b_is_initialized;
+    fbe_bool_t                  b_is_registered;
+    fbe_notification_element_t  notification_element;
+    fbe_spare_index_entry_t    *entries_p;
+    fbe_u32_t                   used_entries;
+    fbe_u32_t                   next_generation; /*!< Source of the entry generations. */
+    fbe_u32_t                   hits;
+    fbe_u32_t                   misses;
+    fbe_bool_t                  b_verify;               /*!< Check the index against the pvds. */
+    fbe_u32_t                   lookup_mismatches;      /*!< Index hits that differ from the pvd. */
+    fbe_u32_t                   verified_selections;    /*!< Selections repeated without the index. */
+    fbe_u32_t                   selection_mismatches;   /*!< Selections that differ without the index. */
+} fbe_spare_index_t;
+
+static fbe_spare_index_t fbe_spare_index = {0};
+
+/*****************************************
+ * LOCAL FUNCTION FUNCTIONS
+ *****************************************/
+static fbe_status_t fbe_spare_lib_index_init(void);
+static fbe_status_t fbe_spare_lib_index_send_notification_control(fbe_payload_control_operation_opcode_t control_code);
+static fbe_status_t fbe_spare_lib_index_notification_callback(fbe_object_id_t object_id,
+                                                              fbe_notification_info_t notification_info,
+                                                              fbe_notification_context_t context);
+static fbe_spare_index_entry_t *fbe_spare_lib_index_find_entry(fbe_object_id_t object_id,
+                                                               fbe_bool_t b_allocate);
+
+/*!****************************************************************************
+ * fbe_spare_lib_index_init()
+ ******************************************************************************
+ * @brief
+ *  Allocate the index and register for the pvd notifications.  The index is
+ *  set up by the first spare selection since the spare library has no
+ *  initialization of its own.  This is always called from the job service
+ *  thread so only one caller can get here at a time.
+ *
+ * @return status - The status of the operation.
+ *
+ ******************************************************************************/
+static fbe_status_t fbe_spare_lib_index_init(void)
+{
+    fbe_status_t                status;
+    fbe_spare_index_entry_t    *entries_p = NULL;
+    fbe_u32_t                   entry_index;
+
+    entries_p = (fbe_spare_index_entry_t *)fbe_memory_native_allocate(sizeof(fbe_spare_index_entry_t) * FBE_SPARE_INDEX_NUM_ENTRIES);
+    if (entries_p == NULL)
+    {
+        fbe_base_library_trace(FBE_LIBRARY_ID_DRIVE_SPARING,
+                               FBE_TRACE_LEVEL_WARNING,
+                               FBE_TRACE_MESSAGE_ID_INFO,
+                               "spare_index: failed to allocate %d entries\n",
+                               FBE_SPARE_INDEX_NUM_ENTRIES);
+        return FBE_STATUS_INSUFFICIENT_RESOURCES;
+    }
+    for (entry_index = 0; entry_index < FBE_SPARE_INDEX_NUM_ENTRIES; entry_index++)
+    {
+        entries_p[entry_index].object_id = FBE_OBJECT_ID_INVALID;
+        entries_p[entry_index].b_valid = FBE_FALSE;
+        entries_p[entry_index].generation = 0;
+    }
+
+    fbe_spinlock_init(&fbe_spare_index.lock);
+    fbe_spare_index.entries_p = entries_p;
+    fbe_spare_index.used_entries = 0;
+    fbe_spare_index.next_generation = 0;
+    fbe_spare_index.hits = 0;
+    fbe_spare_index.misses = 0;
+    fbe_spare_index.lookup_mismatches = 0;
+    fbe_spare_index.verified_selections = 0;
+    fbe_spare_index.selection_mismatches = 0;
+    fbe_spare_index.b_is_initialized = FBE_TRUE;
+
+    /* A lifecycle state change, end of life, configuration change or swap of a
+     * pvd invalidates its entry.  Those are the changes of the spare info,
+     * the frequent zeroing and data change notifications are not wanted.
+     */
+    fbe_spare_index.notification_element.notification_function = fbe_spare_lib_index_notification_callback;
+    fbe_spare_index.notification_element.notification_context = &fbe_spare_index;
+    fbe_spare_index.notification_element.notification_type = (FBE_NOTIFICATION_TYPE_LIFECYCLE_ANY_NON_PENDING_STATE_CHANGE |
+                                                              FBE_NOTIFICATION_TYPE_END_OF_LIFE |
+                                                              FBE_NOTIFICATION_TYPE_CONFIGURATION_CHANGED |
+                                                              FBE_NOTIFICATION_TYPE_SWAP_INFO);
+    fbe_spare_index.notification_element.object_type = FBE_TOPOLOGY_OBJECT_TYPE_PROVISIONED_DRIVE;
+    status = fbe_spare_lib_index_send_notification_control(FBE_NOTIFICATION_CONTROL_CODE_REGISTER);
+    if (status != FBE_STATUS_OK)
+    {
+        /* Without the notifications we cannot trust the index.
+         */
+        fbe_base_library_trace(FBE_LIBRARY_ID_DRIVE_SPARING,
+                               FBE_TRACE_LEVEL_WARNING,
+                               FBE_TRACE_MESSAGE_ID_INFO,
+                               "spare_index: register for notifications failed - status: 0x%x\n",
+                               status);
+        fbe_spare_index.b_is_initialized = FBE_FALSE;
+        fbe_spare_index.entries_p = NULL;
+        fbe_spinlock_destroy(&fbe_spare_index.lock);
+        fbe_memory_native_release(entries_p);
+        return status;
+    }
+    fbe_spare_index.b_is_registered = FBE_TRUE;
+
+    fbe_base_library_trace(FBE_LIBRARY_ID_DRIVE_SPARING,
+                           FBE_TRACE_LEVEL_INFO,
+                           FBE_TRACE_MESSAGE_ID_INFO,
+                           "spare_index: initialized with %d entries\n",
+                           FBE_SPARE_INDEX_NUM_ENTRIES);
+    return FBE_STATUS_OK;
+}
+/******************************************************************************
+ * end fbe_spare_lib_index_init()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * fbe_spare_lib_index_destroy()
+ ******************************************************************************
+ * @brief
+ *  Unregister the notifications and release the index.  Called when the job
+ *  service is destroyed, before the notification service goes away.
+ *
+ * @return None.
+ *
+ ******************************************************************************/
+void fbe_spare_lib_index_destroy(void)
+{
+    fbe_status_t    status;
+
+    if (fbe_spare_index.b_is_initialized == FBE_FALSE)
+    {
+        return;
+    }
+
+    if (fbe_spare_index.b_is_registered == FBE_TRUE)
+    {
+        status = fbe_spare_lib_index_send_notification_control(FBE_NOTIFICATION_CONTROL_CODE_UNREGISTER);
+        if (status != FBE_STATUS_OK)
+        {
+            fbe_base_library_trace(FBE_LIBRARY_ID_DRIVE_SPARING,
+                                   FBE_TRACE_LEVEL_ERROR,
+                                   FBE_TRACE_MESSAGE_ID_INFO,
+                                   "spare_index: unregister for notifications failed - status: 0x%x\n",
+                                   status);
+        }
+        fbe_spare_index.b_is_registered = FBE_FALSE;
+    }
+
+    fbe_spinlock_lock(&fbe_spare_index.lock);
+    fbe_spare_index.b_is_initialized = FBE_FALSE;
+    fbe_spinlock_unlock(&fbe_spare_index.lock);
+
+    fbe_base_library_trace(FBE_LIBRARY_ID_DRIVE_SPARING,
+                           FBE_TRACE_LEVEL_INFO,
+                           FBE_TRACE_MESSAGE_ID_INFO,
+                           "spare_index: destroy hits: %d misses: %d\n",
+                           fbe_spare_index.hits, fbe_spare_index.misses);
+
+    fbe_spinlock_destroy(&fbe_spare_index.lock);
+    fbe_memory_native_release(fbe_spare_index.entries_p);
+    fbe_spare_index.entries_p = NULL;
+    return;
+}
+/******************************************************************************
+ * end fbe_spare_lib_index_destroy()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * fbe_spare_lib_index_send_notification_control()
+ ******************************************************************************
+ * @brief
+ *  Register or unregister the index notification element with the
+ *  notification service.
+ *
+ * @param control_code - Register or unregister.
+ *
+ * @return status - The status of the operation.
+ *
+ ******************************************************************************/
+static fbe_status_t fbe_spare_lib_index_send_notification_control(fbe_payload_control_operation_opcode_t control_code)
+{
+    fbe_status_t                        status;
+    fbe_packet_t                       *packet_p = NULL;
+    fbe_payload_ex_t                   *payload_p = NULL;
+    fbe_payload_control_operation_t    *control_p = NULL;
+
+    packet_p = fbe_transport_allocate_packet();
+    if (packet_p == NULL)
+    {
+        return FBE_STATUS_INSUFFICIENT_RESOURCES;
+    }
+
+    fbe_transport_initialize_packet(packet_p);
+    payload_p = fbe_transport_get_payload_ex(packet_p);
+    control_p = fbe_payload_ex_allocate_control_operation(payload_p);
+    fbe_payload_control_build_operation(control_p,
+                                        control_code,
+                                        &fbe_spare_index.notification_element,
+                                        sizeof(fbe_notification_element_t));
+    fbe_transport_set_address(packet_p,
+                              FBE_PACKAGE_ID_SEP_0,
+                              FBE_SERVICE_ID_NOTIFICATION,
+                              FBE_CLASS_ID_INVALID,
+                              FBE_OBJECT_ID_INVALID);
+    fbe_transport_set_sync_completion_type(packet_p, FBE_TRANSPORT_COMPLETION_TYPE_MORE_PROCESSING_REQUIRED);
+    fbe_service_manager_send_control_packet(packet_p);
+
+    /* The packet is always completed so the status above need not be checked.
+     */
+    fbe_transport_wait_completion(packet_p);
+    status = fbe_transport_get_status_code(packet_p);
+    fbe_payload_ex_release_control_operation(payload_p, control_p);
+    fbe_transport_release_packet(packet_p);
+    return status;
+}
+/******************************************************************************
+ * end fbe_spare_lib_index_send_notification_control()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * fbe_spare_lib_index_notification_callback()
+ ******************************************************************************
+ * @brief
+ *  A pvd changed, invalidate its entry.  The next selection that looks at
+ *  this pvd fetches its spare information again.
+ *
+ * @param object_id - Pvd that changed.
+ * @param notification_info - Unused.
+ * @param context - Unused.
+ *
+ * @return status - Always FBE_STATUS_OK.
+ *
+ ******************************************************************************/
+static fbe_status_t fbe_spare_lib_index_notification_callback(fbe_object_id_t object_id,
+                                                              fbe_notification_info_t notification_info,
+                                                              fbe_notification_context_t context)
+{
+    FBE_UNREFERENCED_PARAMETER(notification_info);
+    FBE_UNREFERENCED_PARAMETER(context);
+
+    fbe_spare_lib_index_invalidate(object_id);
+    return FBE_STATUS_OK;
+}
+/******************************************************************************
+ * end fbe_spare_lib_index_notification_callback()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * fbe_spare_lib_index_find_entry()
+ ******************************************************************************
+ * @brief
+ *  Find the entry of a pvd with linear probing.  The caller holds the lock.
+ *
+ * @param object_id - Pvd object id.
+ * @param b_allocate - FBE_TRUE to take a free entry if the pvd has none.
+ *
+ * @return The entry or NULL if not found (or the index is full).
+ *
+ ******************************************************************************/
+static fbe_spare_index_entry_t *fbe_spare_lib_index_find_entry(fbe_object_id_t object_id,
+                                                               fbe_bool_t b_allocate)
+{
+    fbe_u32_t                   entry_index = object_id % FBE_SPARE_INDEX_NUM_ENTRIES;
+    fbe_u32_t                   probes;
+    fbe_spare_index_entry_t    *entry_p = NULL;
+
+    for (probes = 0; probes < FBE_SPARE_INDEX_NUM_ENTRIES; probes++)
+    {
+        entry_p = &fbe_spare_index.entries_p[entry_index];
+        if (entry_p->object_id == object_id)
+        {
+            return entry_p;
+        }
+        if (entry_p->object_id == FBE_OBJECT_ID_INVALID)
+        {
+            if ((b_allocate == FBE_FALSE)                                           ||
+                (fbe_spare_index.used_entries >= FBE_SPARE_INDEX_MAX_USED_ENTRIES)     )
+            {
+                return NULL;
+            }
+            entry_p->object_id = object_id;
+            entry_p->b_valid = FBE_FALSE;
+            entry_p->generation = ++fbe_spare_index.next_generation;
+            fbe_spare_index.used_entries++;
+            return entry_p;
+        }
+        entry_index = (entry_index + 1) % FBE_SPARE_INDEX_NUM_ENTRIES;
+    }
+    return NULL;
+}
+/******************************************************************************
+ * end fbe_spare_lib_index_find_entry()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * fbe_spare_lib_index_invalidate()
+ ******************************************************************************
+ * @brief
+ *  Invalidate the entry of a pvd.  Its generation changes so that a fetch
+ *  of the pvd which is still in progress does not mark the entry valid.
+ *  The entries of the other pvds are not affected.
+ *
+ * @param object_id - Pvd object id.
+ *
+ * @return None.
+ *
+ ******************************************************************************/
+void fbe_spare_lib_index_invalidate(fbe_object_id_t object_id)
+{
+    fbe_spare_index_entry_t    *entry_p = NULL;
+
+    if (fbe_spare_index.b_is_initialized == FBE_FALSE)
+    {
+        return;
+    }
+
+    fbe_spinlock_lock(&fbe_spare_index.lock);
+    if (fbe_spare_index.b_is_initialized == FBE_TRUE)
+    {
+        entry_p = fbe_spare_lib_index_find_entry(object_id, FBE_FALSE);
+        if (entry_p != NULL)
+        {
+            entry_p->b_valid = FBE_FALSE;
+            entry_p->generation = ++fbe_spare_index.next_generation;
+        }
+    }
+    fbe_spinlock_unlock(&fbe_spare_index.lock);
+    return;
+}
+/******************************************************************************
+ * end fbe_spare_lib_index_invalidate()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * fbe_spare_lib_index_update()
+ ******************************************************************************
+ * @brief
+ *  Save freshly fetched spare information of a pvd in the index.  The entry
+ *  is only marked valid if the pvd was not invalidated while the information
+ *  was being fetched, otherwise the change could be missing from it.  If the
+ *  entry went away meanwhile (the index was cleared) the information is saved
+ *  but not marked valid.
+ *
+ * @param object_id - Pvd object id.
+ * @param spare_drive_info_p - Spare info just returned by the pvd.
+ * @param generation - Entry generation before the info was fetched.
+ *
+ * @return None.
+ *
+ ******************************************************************************/
+void fbe_spare_lib_index_update(fbe_object_id_t object_id,
+                                fbe_spare_drive_info_t *spare_drive_info_p,
+                                fbe_u32_t generation)
+{
+    fbe_spare_index_entry_t    *entry_p = NULL;
+
+    if (fbe_spare_index.b_is_initialized == FBE_FALSE)
+    {
+        return;
+    }
+
+    fbe_spinlock_lock(&fbe_spare_index.lock);
+    entry_p = fbe_spare_lib_index_find_entry(object_id, FBE_FALSE);
+    if (entry_p != NULL)
+    {
+        fbe_copy_memory(&entry_p->spare_drive_info, spare_drive_info_p, sizeof(fbe_spare_drive_info_t));
+        entry_p->fetch_time = fbe_get_time();
+        entry_p->b_valid = (generation == entry_p->generation) ? FBE_TRUE : FBE_FALSE;
+    }
+    fbe_spinlock_unlock(&fbe_spare_index.lock);
+    return;
+}
+/******************************************************************************
+ * end fbe_spare_lib_index_update()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * fbe_spare_lib_index_get_hot_spare_info()
+ ******************************************************************************
+ * @brief
+ *  Get the spare information of a hot spare pvd from the index.  If the pvd
+ *  has no valid entry (or the entry is too old) the information is fetched
+ *  from the pvd and saved in the index.
+ *
+ * @param hs_pvd_object_id - Hot spare pvd object id.
+ * @param spare_drive_info_p - Returns the spare drive info.
+ * @param b_from_index_p - Returns FBE_TRUE if the info came from the index.
+ *
+ * @return status - The status of the operation.
+ *
+ ******************************************************************************/
+fbe_status_t fbe_spare_lib_index_get_hot_spare_info(fbe_object_id_t hs_pvd_object_id,
+                                                    fbe_spare_drive_info_t *spare_drive_info_p,
+                                                    fbe_bool_t *b_from_index_p)
+{
+    fbe_status_t                status;
+    fbe_spare_index_entry_t    *entry_p = NULL;
+    fbe_u32_t                   generation;
+    fbe_spare_drive_info_t      pvd_spare_drive_info;
+
+    *b_from_index_p = FBE_FALSE;
+
+    if (fbe_spare_index.b_is_initialized == FBE_FALSE)
+    {
+        status = fbe_spare_lib_index_init();
+        if (status != FBE_STATUS_OK)
+        {
+            /* Without the index simply ask the pvd.
+             */
+            return fbe_spare_lib_selection_get_hot_spare_info(hs_pvd_object_id, spare_drive_info_p);
+        }
+    }
+
+    fbe_spinlock_lock(&fbe_spare_index.lock);
+    entry_p = fbe_spare_lib_index_find_entry(hs_pvd_object_id, FBE_FALSE);
+    if ((entry_p != NULL)                                                               &&
+        (entry_p->b_valid == FBE_TRUE)                                                  &&
+        (fbe_get_elapsed_milliseconds(entry_p->fetch_time) < FBE_SPARE_INDEX_MAX_AGE_MS)   )
+    {
+        fbe_copy_memory(spare_drive_info_p, &entry_p->spare_drive_info, sizeof(fbe_spare_drive_info_t));
+        fbe_spare_index.hits++;
+        fbe_spinlock_unlock(&fbe_spare_index.lock);
+        *b_from_index_p = FBE_TRUE;
+
+        /* When verifying, ask the pvd anyway and count the entries that are
+         * out of date.  We still return the index info so that the selection
+         * is the same as without verification.
+         */
+        if (fbe_spare_index.b_verify == FBE_TRUE)
+        {
+            status = fbe_spare_lib_selection_get_hot_spare_info(hs_pvd_object_id, &pvd_spare_drive_info);
+            if ((status == FBE_STATUS_OK)                                                                   &&
+                !fbe_equal_memory(&pvd_spare_drive_info, spare_drive_info_p, sizeof(fbe_spare_drive_info_t))   )
+            {
+                fbe_base_library_trace(FBE_LIBRARY_ID_DRIVE_SPARING,
+                                       FBE_TRACE_LEVEL_WARNING,
+                                       FBE_TRACE_MESSAGE_ID_INFO,
+                                       "spare_index: entry of pvd obj: 0x%x differs from the pvd\n",
+                                       hs_pvd_object_id);
+                fbe_spinlock_lock(&fbe_spare_index.lock);
+                fbe_spare_index.lookup_mismatches++;
+                fbe_spinlock_unlock(&fbe_spare_index.lock);
+            }
+        }
+        return FBE_STATUS_OK;
+    }
+    fbe_spare_index.misses++;
+    fbe_spinlock_unlock(&fbe_spare_index.lock);
+
+    /* Take the entry before we fetch so that a change of the pvd during the
+     * fetch is not lost.
+     */
+    generation = fbe_spare_lib_index_get_generation(hs_pvd_object_id);
+
+    status = fbe_spare_lib_selection_get_hot_spare_info(hs_pvd_object_id, spare_drive_info_p);
+    if (status != FBE_STATUS_OK)
+    {
+        fbe_spare_lib_index_invalidate(hs_pvd_object_id);
+        return status;
+    }
+    fbe_spare_lib_index_update(hs_pvd_object_id, spare_drive_info_p, generation);
+    return FBE_STATUS_OK;
+}
+/******************************************************************************
+ * end fbe_spare_lib_index_get_hot_spare_info()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * fbe_spare_lib_index_get_generation()
+ ******************************************************************************
+ * @brief
+ *  Return the generation of the entry of a pvd, taking an entry for the pvd
+ *  if it has none.  Callers that fetch the spare information of the pvd get
+ *  it before the fetch and pass it to fbe_spare_lib_index_update().  If the
+ *  index is full it is cleared first.
+ *
+ * @param object_id - Pvd object id.
+ *
+ * @return The entry generation, 0 if the pvd has no entry.
+ *
+ ******************************************************************************/
+fbe_u32_t fbe_spare_lib_index_get_generation(fbe_object_id_t object_id)
+{
+    fbe_spare_index_entry_t    *entry_p = NULL;
+    fbe_u32_t                   entry_index;
+    fbe_u32_t                   generation = 0;
+
+    if (fbe_spare_index.b_is_initialized == FBE_FALSE)
+    {
+        return 0;
+    }
+    fbe_spinlock_lock(&fbe_spare_index.lock);
+    entry_p = fbe_spare_lib_index_find_entry(object_id, FBE_TRUE);
+    if (entry_p == NULL)
+    {
+        /* The index is full.  Start over, the following selections fill it
+         * with the pvds that are still in the spare pool.
+         */
+        for (entry_index = 0; entry_index < FBE_SPARE_INDEX_NUM_ENTRIES; entry_index++)
+        {
+            fbe_spare_index.entries_p[entry_index].object_id = FBE_OBJECT_ID_INVALID;
+            fbe_spare_index.entries_p[entry_index].b_valid = FBE_FALSE;
+        }
+        fbe_spare_index.used_entries = 0;
+        entry_p = fbe_spare_lib_index_find_entry(object_id, FBE_TRUE);
+    }
+    if (entry_p != NULL)
+    {
+        generation = entry_p->generation;
+    }
+    fbe_spinlock_unlock(&fbe_spare_index.lock);
+    return generation;
+}
+/******************************************************************************
+ * end fbe_spare_lib_index_get_generation()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * fbe_spare_lib_index_is_verify_enabled()
+ ******************************************************************************
+ * @brief
+ *  Return FBE_TRUE if the selections with the index are checked against the
+ *  selection without it.
+ *
+ * @return fbe_bool_t
+ *
+ ******************************************************************************/
+fbe_bool_t fbe_spare_lib_index_is_verify_enabled(void)
+{
+    return fbe_spare_index.b_verify;
+}
+/******************************************************************************
+ * end fbe_spare_lib_index_is_verify_enabled()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * fbe_spare_lib_index_verify_selection()
+ ******************************************************************************
+ * @brief
+ *  Count a selection that was repeated without the index and whether both
+ *  selected the same spare.
+ *
+ * @param vd_object_id - Virtual drive that needs a spare.
+ * @param selected_object_id - Spare selected with the index.
+ * @param linear_object_id - Spare selected asking every pvd.
+ *
+ * @return None.
+ *
+ ******************************************************************************/
+void fbe_spare_lib_index_verify_selection(fbe_object_id_t vd_object_id,
+                                          fbe_object_id_t selected_object_id,
+                                          fbe_object_id_t linear_object_id)
+{
+    if (selected_object_id != linear_object_id)
+    {
+        fbe_base_library_trace(FBE_LIBRARY_ID_DRIVE_SPARING,
+                               FBE_TRACE_LEVEL_WARNING,
+                               FBE_TRACE_MESSAGE_ID_INFO,
+                               "spare_index: vd obj: 0x%x selected pvd obj: 0x%x without the index: 0x%x\n",
+                               vd_object_id, selected_object_id, linear_object_id);
+    }
+
+    fbe_spinlock_lock(&fbe_spare_index.lock);
+    fbe_spare_index.verified_selections++;
+    if (selected_object_id != linear_object_id)
+    {
+        fbe_spare_index.selection_mismatches++;
+    }
+    fbe_spinlock_unlock(&fbe_spare_index.lock);
+    return;
+}
+/******************************************************************************
+ * end fbe_spare_lib_index_verify_selection()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * fbe_spare_lib_index_set_verify()
+ ******************************************************************************
+ * @brief
+ *  Enable or disable the verification of the spare index.  While enabled
+ *  every index hit also asks the pvd and every selection is repeated without
+ *  the index, so that tests can check the index against the pvds.
+ *
+ * @param packet_p - packet with fbe_job_service_set_spare_index_verify_t
+ *
+ * @return status - The status of the operation.
+ *
+ ******************************************************************************/
+fbe_status_t fbe_spare_lib_index_set_verify(fbe_packet_t *packet_p)
+{
+    fbe_job_service_set_spare_index_verify_t   *set_verify_p = NULL;
+    fbe_payload_ex_t                           *payload_p = NULL;
+    fbe_payload_control_operation_t            *control_operation = NULL;
+    fbe_payload_control_buffer_length_t         length = 0;
+
+    payload_p = fbe_transport_get_payload_ex(packet_p);
+    control_operation = fbe_payload_ex_get_control_operation(payload_p);
+
+    fbe_payload_control_get_buffer(control_operation, &set_verify_p);
+    fbe_payload_control_get_buffer_length(control_operation, &length);
+    if ((set_verify_p == NULL) || (length != sizeof(fbe_job_service_set_spare_index_verify_t)))
+    {
+        fbe_base_library_trace(FBE_LIBRARY_ID_DRIVE_SPARING,
+                               FBE_TRACE_LEVEL_ERROR,
+                               FBE_TRACE_MESSAGE_ID_INFO,
+                               "%s invalid set spare index verify request\n", __FUNCTION__);
+        fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
+        fbe_transport_set_status(packet_p, FBE_STATUS_GENERIC_FAILURE, 0);
+        fbe_transport_complete_packet(packet_p);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    fbe_base_library_trace(FBE_LIBRARY_ID_DRIVE_SPARING,
+                           FBE_TRACE_LEVEL_INFO,
+                           FBE_TRACE_MESSAGE_ID_INFO,
+                           "spare_index: verify %s\n", set_verify_p->b_enabled ? "enabled" : "disabled");
+    fbe_spare_index.b_verify = set_verify_p->b_enabled;
+
+    fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_OK);
+    fbe_transport_set_status(packet_p, FBE_STATUS_OK, 0);
+    fbe_transport_complete_packet(packet_p);
+    return FBE_STATUS_OK;
+}
+/******************************************************************************
+ * end fbe_spare_lib_index_set_verify()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * fbe_spare_lib_index_get_info()
+ ******************************************************************************
+ * @brief
+ *  Return the spare index statistics.  They are all 0 until the first
+ *  selection sets up the index.
+ *
+ * @param packet_p - packet with fbe_job_service_spare_index_info_t
+ *
+ * @return status - The status of the operation.
+ *
+ ******************************************************************************/
+fbe_status_t fbe_spare_lib_index_get_info(fbe_packet_t *packet_p)
+{
+    fbe_job_service_spare_index_info_t         *info_p = NULL;
+    fbe_payload_ex_t                           *payload_p = NULL;
+    fbe_payload_control_operation_t            *control_operation = NULL;
+    fbe_payload_control_buffer_length_t         length = 0;
+
+    payload_p = fbe_transport_get_payload_ex(packet_p);
+    control_operation = fbe_payload_ex_get_control_operation(payload_p);
+
+    fbe_payload_control_get_buffer(control_operation, &info_p);
+    fbe_payload_control_get_buffer_length(control_operation, &length);
+    if ((info_p == NULL) || (length != sizeof(fbe_job_service_spare_index_info_t)))
+    {
+        fbe_base_library_trace(FBE_LIBRARY_ID_DRIVE_SPARING,
+                               FBE_TRACE_LEVEL_ERROR,
+                               FBE_TRACE_MESSAGE_ID_INFO,
+                               "%s invalid get spare index info request\n", __FUNCTION__);
+        fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
+        fbe_transport_set_status(packet_p, FBE_STATUS_GENERIC_FAILURE, 0);
+        fbe_transport_complete_packet(packet_p);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    fbe_zero_memory(info_p, sizeof(fbe_job_service_spare_index_info_t));
+    info_p->b_verify = fbe_spare_index.b_verify;
+    if (fbe_spare_index.b_is_initialized == FBE_TRUE)
+    {
+        fbe_spinlock_lock(&fbe_spare_index.lock);
+        info_p->hits = fbe_spare_index.hits;
+        info_p->misses = fbe_spare_index.misses;
+        info_p->lookup_mismatches = fbe_spare_index.lookup_mismatches;
+        info_p->verified_selections = fbe_spare_index.verified_selections;
+        info_p->selection_mismatches = fbe_spare_index.selection_mismatches;
+        fbe_spinlock_unlock(&fbe_spare_index.lock);
+    }
+
+    fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_OK);
+    fbe_transport_set_status(packet_p, FBE_STATUS_OK, 0);
+    fbe_transport_complete_packet(packet_p);
+    return FBE_STATUS_OK;
+}
+/******************************************************************************
+ * end fbe_spare_lib_index_get_info()
+ ******************************************************************************/
+
+/*************************
+ * end file fbe_spare_index.c
+ *************************/
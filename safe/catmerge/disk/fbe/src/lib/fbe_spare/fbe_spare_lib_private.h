@@ -50,6 +50,16 @@
         return FBE_STATUS_GENERIC_FAILURE;                             \
     }                                                                  \
 
+/*!*******************************************************************
+ * @def FBE_SPARE_INDEX_MAX_SELECTION_PASSES
+ *********************************************************************
+ * @brief Number of times we select a spare when the spare index was
+ *        stale for the selected spare.  The last pass does not use
+ *        the index.
+ *
+ *********************************************************************/
+#define FBE_SPARE_INDEX_MAX_SELECTION_PASSES    3
+
 /*!*******************************************************************
  * @struct fbe_virtual_drive_spare_info_s
  *********************************************************************
@@ -322,6 +332,20 @@ fbe_status_t fbe_spare_lib_selection_get_hot_spare_info(fbe_object_id_t hs_pvd_o
 // Get the upstream object information
 fbe_status_t fbe_spare_lib_selection_get_virtual_drive_upstream_object_info(fbe_object_id_t in_vd_object_id,
                                                                             fbe_spare_get_upsteam_object_info_t *in_upstream_object_info_p);
+/* fbe_spare_index.c */
+fbe_status_t fbe_spare_lib_index_get_hot_spare_info(fbe_object_id_t hs_pvd_object_id,
+                                                    fbe_spare_drive_info_t *spare_drive_info_p,
+                                                    fbe_bool_t *b_from_index_p);
+void fbe_spare_lib_index_update(fbe_object_id_t object_id,
+                                fbe_spare_drive_info_t *spare_drive_info_p,
+                                fbe_u32_t generation);
+void fbe_spare_lib_index_invalidate(fbe_object_id_t object_id);
+fbe_u32_t fbe_spare_lib_index_get_generation(fbe_object_id_t object_id);
+fbe_bool_t fbe_spare_lib_index_is_verify_enabled(void);
+void fbe_spare_lib_index_verify_selection(fbe_object_id_t vd_object_id,
+                                          fbe_object_id_t selected_object_id,
+                                          fbe_object_id_t linear_object_id);
+
 /* fbe_spare_main.c */
 fbe_u32_t fbe_spare_main_get_operation_timeout_secs(void);
 fbe_bool_t fbe_spare_main_is_operation_confirmation_enabled(void);
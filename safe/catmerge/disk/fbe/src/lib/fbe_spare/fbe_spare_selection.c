@@ -2621,6 +2621,103 @@ fbe_status_t fbe_spare_lib_selection_apply_selection_algorithm(fbe_spare_selecti
  * end fbe_spare_lib_selection_apply_selection_algorithm()
  ******************************************************************************/
 
+/*!****************************************************************************
+ * fbe_spare_lib_selection_select_spare_from_spare_pool_pass()
+ ******************************************************************************
+ * @brief
+ * It is used to apply the selection rules to every spare in the spare pool
+ * once.  The spare information comes either from the spare index or directly
+ * from the pvds.
+ *
+ * @param desired_spare_info_p - Desired spare selection info.
+ * @param spare_drive_pool_p - Spare drive pool.
+ * @param b_use_index - FBE_TRUE to get the spare information from the index.
+ * @param selected_hot_spare_info_p - Returns the selected spare.
+ * @param b_selected_from_index_p - Returns FBE_TRUE if the information of the
+ *                                  selected spare came from the index.
+ *
+ * @return None.
+ *
+ ******************************************************************************/
+static void
+fbe_spare_lib_selection_select_spare_from_spare_pool_pass(fbe_spare_selection_info_t *desired_spare_info_p,
+                                                          fbe_spare_drive_pool_t *spare_drive_pool_p,
+                                                          fbe_bool_t b_use_index,
+                                                          fbe_spare_selection_info_t *selected_hot_spare_info_p,
+                                                          fbe_bool_t *b_selected_from_index_p)
+{
+    fbe_status_t                status = FBE_STATUS_OK;
+    fbe_u32_t                   curr_spare_index = 0;
+    fbe_spare_selection_info_t  curr_hot_spare_info;
+    fbe_bool_t                  b_from_index;
+
+    /* Initialize the selected hot spare drive information as default values. */
+    fbe_spare_initialize_spare_selection_drive_info(selected_hot_spare_info_p);
+    *b_selected_from_index_p = FBE_FALSE;
+    
+    /* Loop through the spare object list to select the best suitable spare. */
+    while (spare_drive_pool_p->spare_object_list[curr_spare_index] != FBE_OBJECT_ID_INVALID)
+    {
+        /* Update the hot spare drive inforamtion with current object-id. */
+        fbe_spare_initialize_spare_selection_drive_info(&curr_hot_spare_info);
+        fbe_spare_lib_hot_spare_info_set_object_id(&curr_hot_spare_info,
+                                                   spare_drive_pool_p->spare_object_list[curr_spare_index]);
+
+        /* Get hot spare information for this hot spare object. */
+        b_from_index = FBE_FALSE;
+        if (b_use_index)
+        {
+            status = fbe_spare_lib_index_get_hot_spare_info(curr_hot_spare_info.spare_object_id,
+                                                            &curr_hot_spare_info.spare_drive_info,
+                                                            &b_from_index);
+        }
+        else
+        {
+            status = fbe_spare_lib_selection_get_hot_spare_info(curr_hot_spare_info.spare_object_id,
+                                                                &curr_hot_spare_info.spare_drive_info);
+        }
+        if (status != FBE_STATUS_OK) 
+        {
+            /* Ignore this hot spare object on error and jump to next object. */
+            curr_spare_index++;
+            continue;
+        }
+
+        /*! @note We must allow system drives to be used as spare since the user
+         *        can bind on the system drives and then need to `spare' back to
+         *        them after the original spare fails.  Log an warning and
+         *        continue.
+         */
+        if (fbe_database_is_object_system_pvd(curr_hot_spare_info.spare_object_id) == FBE_TRUE)
+        {
+            /* Log an warning and continue.
+             */
+            fbe_base_library_trace(FBE_LIBRARY_ID_DRIVE_SPARING,
+                                   FBE_TRACE_LEVEL_WARNING,
+                                   FBE_TRACE_MESSAGE_ID_INFO,
+                                   "%s Allow system pvd: 0x%x as a spare.\n", 
+                                   __FUNCTION__, curr_hot_spare_info.spare_object_id);
+        }
+
+        /* Apply the rules to select the best suitable spare. */
+        fbe_spare_lib_selection_apply_selection_algorithm(desired_spare_info_p,
+                                                          &curr_hot_spare_info,
+                                                          selected_hot_spare_info_p);
+        if (selected_hot_spare_info_p->spare_object_id == curr_hot_spare_info.spare_object_id)
+        {
+            *b_selected_from_index_p = b_from_index;
+        }
+
+        /* Increment the index to go through the next available spare. */
+        curr_spare_index++;
+    }
+
+    return;
+}
+/******************************************************************************
+ * end fbe_spare_lib_selection_select_spare_from_spare_pool_pass()
+ ******************************************************************************/
+
 /*!****************************************************************************
  * fbe_spare_lib_selection_select_suitable_spare_from_spare_pool()
  ******************************************************************************
@@ -2636,6 +2733,14 @@ fbe_status_t fbe_spare_lib_selection_apply_selection_algorithm(fbe_spare_selecti
  *
  * @return status - The status of the operation.
  *
+ * @note The spare information of the candidates comes from the spare index,
+ *       which only asks the pvds that changed since the last selection.
+ *       Before we return the selected spare we ask it again.  If its
+ *       information changed we select again and on the last pass we ask
+ *       every candidate.  Only the selected spare is verified, so a stale
+ *       entry of another candidate can still hide a better spare until a
+ *       notification invalidates the entry or it expires.
+ *
  * @author
  *  10/26/2009 - Created. Dhaval Patel
  ******************************************************************************/
@@ -2648,10 +2753,14 @@ fbe_spare_lib_selection_select_suitable_spare_from_spare_pool(fbe_packet_t *pack
                                                               fbe_object_id_t vd_object_id)
 {
     fbe_status_t                status = FBE_STATUS_OK;
-    fbe_u32_t                   curr_spare_index = 0;
     fbe_spare_selection_info_t  desired_spare_info;
-    fbe_spare_selection_info_t  curr_hot_spare_info;
     fbe_spare_selection_info_t  selected_hot_spare_info;
+    fbe_spare_selection_info_t  linear_hot_spare_info;
+    fbe_spare_drive_info_t      current_spare_drive_info;
+    fbe_bool_t                  b_selected_from_index = FBE_FALSE;
+    fbe_bool_t                  b_linear_from_index;
+    fbe_u32_t                   generation;
+    fbe_u32_t                   pass;
     
     FBE_SPARE_LIB_TRACE_FUNC_ENTRY();
 
@@ -2665,50 +2774,70 @@ fbe_spare_lib_selection_select_suitable_spare_from_spare_pool(fbe_packet_t *pack
     fbe_copy_memory(&desired_spare_info.spare_drive_info, desired_spare_drive_info_p, sizeof(*desired_spare_drive_info_p));
     fbe_spare_lib_hot_spare_info_set_object_id(&desired_spare_info, vd_object_id);
 
-    /* Initialize the selected hot spare drive information as default values. */
-    fbe_spare_initialize_spare_selection_drive_info(&selected_hot_spare_info);
-    
-    /* Loop through the spare object list to select the best suitable spare. */
-    while (spare_drive_pool_p->spare_object_list[curr_spare_index] != FBE_OBJECT_ID_INVALID)
+    for (pass = 0; pass < FBE_SPARE_INDEX_MAX_SELECTION_PASSES; pass++)
     {
-        /* Update the hot spare drive inforamtion with current object-id. */
-        fbe_spare_initialize_spare_selection_drive_info(&curr_hot_spare_info);
-        fbe_spare_lib_hot_spare_info_set_object_id(&curr_hot_spare_info,
-                                                   spare_drive_pool_p->spare_object_list[curr_spare_index]);
-
-        /* Get hot spare information for this hot spare object. */
-        status = fbe_spare_lib_selection_get_hot_spare_info(curr_hot_spare_info.spare_object_id,
-                                                            &curr_hot_spare_info.spare_drive_info);
-        if (status != FBE_STATUS_OK) 
+        /* The last pass does not use the index.
+         */
+        fbe_spare_lib_selection_select_spare_from_spare_pool_pass(&desired_spare_info,
+                                                                  spare_drive_pool_p,
+                                                                  (pass + 1) < FBE_SPARE_INDEX_MAX_SELECTION_PASSES,
+                                                                  &selected_hot_spare_info,
+                                                                  &b_selected_from_index);
+        if ((b_selected_from_index == FBE_FALSE)                                ||
+            (selected_hot_spare_info.spare_object_id == FBE_OBJECT_ID_INVALID)     )
         {
-            /* Ignore this hot spare object on error and jump to next object. */
-            curr_spare_index++;
-            continue;
+            break;
         }
 
-        /*! @note We must allow system drives to be used as spare since the user
-         *        can bind on the system drives and then need to `spare' back to
-         *        them after the original spare fails.  Log an warning and
-         *        continue.
+        /* Make sure the index is still current for the selected spare.
          */
-        if (fbe_database_is_object_system_pvd(curr_hot_spare_info.spare_object_id) == FBE_TRUE)
+        generation = fbe_spare_lib_index_get_generation(selected_hot_spare_info.spare_object_id);
+        status = fbe_spare_lib_selection_get_hot_spare_info(selected_hot_spare_info.spare_object_id,
+                                                            &current_spare_drive_info);
+        if ((status == FBE_STATUS_OK)                                          &&
+            fbe_equal_memory(&current_spare_drive_info,
+                             &selected_hot_spare_info.spare_drive_info,
+                             sizeof(fbe_spare_drive_info_t))                      )
         {
-            /* Log an warning and continue.
-             */
-            fbe_base_library_trace(FBE_LIBRARY_ID_DRIVE_SPARING,
-                                   FBE_TRACE_LEVEL_WARNING,
-                                   FBE_TRACE_MESSAGE_ID_INFO,
-                                   "%s Allow system pvd: 0x%x as a spare.\n", 
-                                   __FUNCTION__, curr_hot_spare_info.spare_object_id);
+            break;
         }
 
-        /* Apply the rules to select the best suitable spare. */
-        status = fbe_spare_lib_selection_apply_selection_algorithm(&desired_spare_info,
-                                                                   &curr_hot_spare_info,
-                                                                   &selected_hot_spare_info);
+        fbe_base_library_trace(FBE_LIBRARY_ID_DRIVE_SPARING,
+                               FBE_TRACE_LEVEL_INFO,
+                               FBE_TRACE_MESSAGE_ID_INFO,
+                               "spare_selection: index stale for pvd obj: 0x%x vd obj: 0x%x pass: %d, select again\n", 
+                               selected_hot_spare_info.spare_object_id, vd_object_id, pass);
+        if (status == FBE_STATUS_OK)
+        {
+            fbe_spare_lib_index_update(selected_hot_spare_info.spare_object_id, &current_spare_drive_info, generation);
+        }
+        else
+        {
+            fbe_spare_lib_index_invalidate(selected_hot_spare_info.spare_object_id);
+        }
+    }
 
-        /* Increment the index to go through the next available spare. */
-        curr_spare_index++;
+    /* When the index is verified, select again asking every pvd and count
+     * the selections that would have picked another spare.
+     */
+    if (fbe_spare_lib_index_is_verify_enabled() == FBE_TRUE)
+    {
+        fbe_spare_lib_selection_select_spare_from_spare_pool_pass(&desired_spare_info,
+                                                                  spare_drive_pool_p,
+                                                                  FBE_FALSE, /* Do not use the index. */
+                                                                  &linear_hot_spare_info,
+                                                                  &b_linear_from_index);
+        fbe_spare_lib_index_verify_selection(vd_object_id,
+                                             selected_hot_spare_info.spare_object_id,
+                                             linear_hot_spare_info.spare_object_id);
+    }
+
+    /* The selected spare is about to be swapped in and its information will
+     * change, do not wait for the notification.
+     */
+    if (selected_hot_spare_info.spare_object_id != FBE_OBJECT_ID_INVALID)
+    {
+        fbe_spare_lib_index_invalidate(selected_hot_spare_info.spare_object_id);
     }
 
     /* Copy the selected spare object id. */
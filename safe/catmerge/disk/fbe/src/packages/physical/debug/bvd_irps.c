@@ -60,7 +60,7 @@ CSX_DBG_EXT_DEFINE_CMD(bvd_irps, "bvd_irps")
     fbe_cpu_id_t cpu_id = 0;
     fbe_dbgext_ptr shim_stats_data_ptr = 0;
     fbe_sep_shim_perf_stat_per_core_t fbe_sep_shim_stats_data_per_core;
-    fbe_u32_t fbe_sep_shim_perf_stat_per_core_size;
+    fbe_u32_t fbe_sep_shim_core_data_size;
     fbe_u32_t fbe_multicore_queue_entry_size;
     fbe_dbgext_ptr io_queue_entry_per_core_ptr;
     fbe_dbgext_ptr shim_stats_data_per_core_ptr;
@@ -144,25 +144,26 @@ CSX_DBG_EXT_DEFINE_CMD(bvd_irps, "bvd_irps")
     fbe_debug_trace_func(NULL, "cpu_count 0x%x\n", cpu_count);
 
     /* Get the IO statistics */
-    FBE_GET_EXPRESSION(pp_ext_module_name, fbe_sep_shim_stats_data, &shim_stats_data_ptr);
+    FBE_GET_EXPRESSION(pp_ext_module_name, fbe_sep_shim_core_data, &shim_stats_data_ptr);
     fbe_trace_indent(fbe_debug_trace_func, NULL, 4);
-    fbe_debug_trace_func(NULL, "fbe_sep_shim_stats_data_ptr %llx\n",
+    fbe_debug_trace_func(NULL, "fbe_sep_shim_core_data_ptr %llx\n",
 			 (unsigned long long)shim_stats_data_ptr);
     if(shim_stats_data_ptr == 0)
     {
         fbe_trace_indent(fbe_debug_trace_func, NULL, 4);
-        fbe_debug_trace_func(NULL, "fbe_sep_shim_stats_data is not available \n");
+        fbe_debug_trace_func(NULL, "fbe_sep_shim_core_data is not available \n");
         return;
     }
-    FBE_GET_TYPE_SIZE(module_name, fbe_sep_shim_perf_stat_per_core_t, &fbe_sep_shim_perf_stat_per_core_size);
+    /* The stats are the first field of each core's data. */
+    FBE_GET_TYPE_SIZE(module_name, fbe_sep_shim_core_data_t, &fbe_sep_shim_core_data_size);
     FBE_GET_TYPE_SIZE(module_name, fbe_multicore_queue_entry_t, &fbe_multicore_queue_entry_size);
     fbe_trace_indent(fbe_debug_trace_func, NULL, 4);
-    fbe_debug_trace_func(NULL, "fbe_sep_shim_stats_data size:0x%x \n",fbe_sep_shim_perf_stat_per_core_size);
+    fbe_debug_trace_func(NULL, "fbe_sep_shim_core_data size:0x%x \n",fbe_sep_shim_core_data_size);
 
     /* Loop through each queue for each CPU*/
     for(cpu_id = 0; cpu_id < cpu_count; cpu_id++)
     {
-        shim_stats_data_per_core_ptr = shim_stats_data_ptr + (fbe_sep_shim_perf_stat_per_core_size * cpu_id);
+        shim_stats_data_per_core_ptr = shim_stats_data_ptr + (fbe_sep_shim_core_data_size * cpu_id);
         FBE_READ_MEMORY(shim_stats_data_per_core_ptr, &fbe_sep_shim_stats_data_per_core, sizeof(fbe_sep_shim_perf_stat_per_core_t));
         /* Display IO stats data for each CPU*/
         fbe_debug_trace_func(NULL,"\n");
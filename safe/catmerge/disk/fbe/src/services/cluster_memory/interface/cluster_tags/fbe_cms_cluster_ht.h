@@ -17,6 +17,8 @@
 *   INCLUDE FILES
 *************************/
 #include "fbe_cms_cluster_tag.h"
+#include "fbe/fbe_winddk.h"
+#include "fbe/fbe_atomic.h"
 
 /*************************
 *   DATA STRUCTURES
@@ -26,9 +28,31 @@ typedef struct fbe_cms_cluster_ht_entry_s
     fbe_sll_element_t      m_sll_head;
 }fbe_cms_cluster_ht_entry_t;
 
+/* Bucket i (of the current and of the old table) is protected by stripe (i % FBE_CMS_HASH_LOCK_STRIPES).
+ * Because both table sizes are multiples of the stripe count, a tag stays under the same stripe when it
+ * moves from the old table to the new one.
+ */
+typedef struct fbe_cms_cluster_ht_stripe_s
+{
+    fbe_spinlock_t  m_lock;
+    fbe_u32_t       m_entry_count;  /* tags hashed to this stripe, drives the resize */
+}fbe_cms_cluster_ht_stripe_t;
+
 typedef struct fbe_cms_cluster_ht_s
 {
+    /* Current table, new tags always go here */
     void * mp_ht_mem;
+    fbe_u32_t m_bucket_count;
+
+    /* Table we are moving away from, NULL when no resize is in progress */
+    void * mp_old_ht_mem;
+    fbe_u32_t m_old_bucket_count;
+    fbe_spinlock_t m_migrate_lock;    /* protects m_migrate_next, taken after the stripes when nested */
+    fbe_u32_t m_migrate_next;         /* next old bucket to claim */
+    fbe_atomic_t m_migrated_count;    /* old buckets already moved */
+    fbe_atomic_t m_resize_in_progress;
+
+    fbe_cms_cluster_ht_stripe_t m_stripes[FBE_CMS_HASH_LOCK_STRIPES];
 }fbe_cms_cluster_ht_t;
 
 /*************************
@@ -38,9 +62,11 @@ fbe_sll_element_t * fbe_cms_cluster_ht_entry_get_head(fbe_cms_cluster_ht_entry_t
 fbe_status_t fbe_cms_cluster_ht_init();
 fbe_status_t fbe_cms_cluster_ht_destroy();
 void fbe_cms_cluster_ht_setup(fbe_cms_cluster_ht_t * ht);
-fbe_cms_cluster_ht_entry_t * fbe_cms_get_hash_entry(fbe_cms_alloc_id_t alloc_id);
 fbe_u64_t fbe_cms_cluster_hash(fbe_cms_alloc_id_t alloc_id);
 void fbe_cms_cluster_ht_insert(fbe_cms_cluster_tag_t * p_new_tag);
 fbe_bool_t fbe_cms_cluster_ht_delete(fbe_cms_alloc_id_t alloc_id);
+fbe_cms_cluster_tag_t * fbe_cms_cluster_ht_lookup(fbe_cms_alloc_id_t alloc_id);
+fbe_u32_t fbe_cms_cluster_ht_get_bucket_count(void);
+fbe_bool_t fbe_cms_cluster_ht_is_resizing(void);
 
 #endif /* FBE_CMS_CLUSTER_HT_H */
@@ -34,6 +34,12 @@
 #define FBE_CMS_MAX_HASH_SIZE (((FBE_CMS_MAX_MEM_SIZE/FBE_CMS_BUFFER_SIZE) * ((fbe_u64_t)sizeof(fbe_cms_cluster_ht_entry_t))) / FBE_CMS_AVG_HASH_CHAIN_SIZE)
 #define FBE_CMS_MAX_HASH_ENTRIES ((FBE_CMS_MAX_MEM_SIZE/FBE_CMS_BUFFER_SIZE) / FBE_CMS_AVG_HASH_CHAIN_SIZE)
 #define FBE_CMS_CMM_MEMORY_BLOCKING_SIZE (512 * 520 * 4) //TODO: use (CMM_MEMORY_BLOCKING_SIZE) 
+/* The table starts small and doubles up to FBE_CMS_MAX_HASH_ENTRIES (both powers of 2) */
+#define FBE_CMS_MIN_HASH_ENTRIES (1024)
+/* Number of locks the buckets are striped across (power of 2, <= FBE_CMS_MIN_HASH_ENTRIES) */
+#define FBE_CMS_HASH_LOCK_STRIPES (64)
+/* Number of old buckets every insert/delete moves to the new table while resizing */
+#define FBE_CMS_HASH_MIGRATE_BUCKETS_PER_OP (4)
 
 /* Operations related Defines */
 #define FBE_CMS_BUFF_TRACKER_CNT (1024)
@@ -26,6 +26,15 @@
 
 static fbe_cms_cluster_ht_t g_ht;
 
+static fbe_u64_t fbe_cms_cluster_ht_mix(fbe_u64_t key);
+static fbe_cms_cluster_ht_stripe_t * fbe_cms_cluster_ht_get_stripe(fbe_u64_t hash);
+static fbe_cms_cluster_ht_entry_t * fbe_cms_cluster_ht_get_bucket(void * p_ht_mem, fbe_u32_t bucket_count, fbe_u64_t hash);
+static fbe_cms_cluster_tag_t * fbe_cms_cluster_ht_find_in_bucket(fbe_cms_cluster_ht_entry_t * p_hash_entry, fbe_cms_alloc_id_t alloc_id);
+static void fbe_cms_cluster_ht_lock_all_stripes(void);
+static void fbe_cms_cluster_ht_unlock_all_stripes(void);
+static void fbe_cms_cluster_ht_start_resize(void);
+static void fbe_cms_cluster_ht_migrate(void);
+
 fbe_sll_element_t * fbe_cms_cluster_ht_entry_get_head(fbe_cms_cluster_ht_entry_t * p_ht_entry)
 {
     return &p_ht_entry->m_sll_head; 
@@ -33,6 +42,8 @@ fbe_sll_element_t * fbe_cms_cluster_ht_entry_get_head(fbe_cms_cluster_ht_entry_t
 
 fbe_status_t fbe_cms_cluster_ht_init() 
 {
+    fbe_u32_t stripe_idx;
+
     if(FBE_CMS_MAX_HASH_SIZE > FBE_CMS_CMM_MEMORY_BLOCKING_SIZE)
     {   
         /* TODO: Need to implement Catalog */
@@ -43,13 +54,28 @@ fbe_status_t fbe_cms_cluster_ht_init()
                   );
         return FBE_STATUS_GENERIC_FAILURE; 
     }
-    g_ht.mp_ht_mem = fbe_cms_cmm_memory_allocate(FBE_CMS_MAX_HASH_SIZE);
+
+    /* Start small, the table grows as tags are hashed in */
+    g_ht.m_bucket_count = FBE_CMS_MIN_HASH_ENTRIES;
+    g_ht.mp_ht_mem = fbe_cms_cmm_memory_allocate(g_ht.m_bucket_count * sizeof(fbe_cms_cluster_ht_entry_t));
 
     if(!g_ht.mp_ht_mem)
     {
         return FBE_STATUS_GENERIC_FAILURE;
     }
 
+    g_ht.mp_old_ht_mem = NULL;
+    g_ht.m_old_bucket_count = 0;
+    g_ht.m_migrate_next = 0;
+    g_ht.m_migrated_count = 0;
+    g_ht.m_resize_in_progress = 0;
+    fbe_spinlock_init(&g_ht.m_migrate_lock);
+    for (stripe_idx = 0; stripe_idx < FBE_CMS_HASH_LOCK_STRIPES; stripe_idx++)
+    {
+        fbe_spinlock_init(&g_ht.m_stripes[stripe_idx].m_lock);
+        g_ht.m_stripes[stripe_idx].m_entry_count = 0;
+    }
+
     fbe_cms_cluster_ht_setup(&g_ht);
 
     return FBE_STATUS_OK;
@@ -57,35 +83,55 @@ fbe_status_t fbe_cms_cluster_ht_init()
 
 fbe_status_t fbe_cms_cluster_ht_destroy() 
 {
+    fbe_u32_t stripe_idx;
+
+    if(g_ht.mp_old_ht_mem)
+    {
+        fbe_cms_cmm_memory_release(g_ht.mp_old_ht_mem);
+        g_ht.mp_old_ht_mem = NULL;
+    }
     fbe_cms_cmm_memory_release(g_ht.mp_ht_mem);
+    g_ht.mp_ht_mem = NULL;
+
+    for (stripe_idx = 0; stripe_idx < FBE_CMS_HASH_LOCK_STRIPES; stripe_idx++)
+    {
+        fbe_spinlock_destroy(&g_ht.m_stripes[stripe_idx].m_lock);
+    }
+    fbe_spinlock_destroy(&g_ht.m_migrate_lock);
     
     return FBE_STATUS_OK;
 }
 
-fbe_cms_cluster_ht_entry_t * fbe_cms_get_hash_entry(fbe_cms_alloc_id_t alloc_id) 
+static fbe_u64_t fbe_cms_cluster_ht_mix(fbe_u64_t key)
 {
-    // Hash the Key
-    fbe_u64_t hash_idx = fbe_cms_cluster_hash(alloc_id);   
-
-    // Index into hashtable and return pointer to Hash entry
-    fbe_cms_cluster_ht_entry_t * p = ((fbe_cms_cluster_ht_entry_t*)g_ht.mp_ht_mem) + hash_idx;
-
-    return p;
+    /* 64 bit finalizer of MurmurHash3, every input bit affects every output bit */
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
 }
 
+/* Returns the full 64 bit hash, the table and the stripe locks use the low bits of it. */
 fbe_u64_t fbe_cms_cluster_hash(fbe_cms_alloc_id_t alloc_id)
 {
     /*
-     * Below computation is only based on LUN/LBA. We also need to take into account objectID, etc.
+     * Owners allocate consecutive buffer IDs, and different owners use the same buffer IDs,
+     * so mix the owner first and the buffer ID into the result, instead of a plain XOR/modulo.
      */
-    fbe_u64_t hash;
-	fbe_u64_t key = (alloc_id.buff_id ^ alloc_id.owner_id);
-    
-    hash = key & (0xffffffffffff); // initialize the hash with the LBA (low 48 bits)
-    hash += (key >> 33) & 0xffff8000; // offset by LUN * 2GB zones
-    hash %= (FBE_CMS_MAX_HASH_ENTRIES);
+    return fbe_cms_cluster_ht_mix(alloc_id.buff_id ^ fbe_cms_cluster_ht_mix(alloc_id.owner_id));
+}
+
+static fbe_cms_cluster_ht_stripe_t * fbe_cms_cluster_ht_get_stripe(fbe_u64_t hash)
+{
+    return &g_ht.m_stripes[hash & (FBE_CMS_HASH_LOCK_STRIPES - 1)];
+}
 
-    return hash;
+static fbe_cms_cluster_ht_entry_t * fbe_cms_cluster_ht_get_bucket(void * p_ht_mem, fbe_u32_t bucket_count, fbe_u64_t hash)
+{
+    // Index into hashtable and return pointer to Hash entry
+    return ((fbe_cms_cluster_ht_entry_t*)p_ht_mem) + (hash & (bucket_count - 1));
 }
 
 void fbe_cms_cluster_ht_setup(fbe_cms_cluster_ht_t * ht)
@@ -93,8 +139,8 @@ void fbe_cms_cluster_ht_setup(fbe_cms_cluster_ht_t * ht)
     ULONG l_hash_idx;
     fbe_cms_cluster_ht_entry_t * lp_hash_entry = ht->mp_ht_mem;  
 
-    // Loop through all hash entries within a cmm block
-    for (l_hash_idx = 0; l_hash_idx < FBE_CMS_MAX_HASH_ENTRIES; l_hash_idx++)
+    // Loop through all hash entries of the current table
+    for (l_hash_idx = 0; l_hash_idx < ht->m_bucket_count; l_hash_idx++)
     {
         // Initialize Hash chain to NUll
         fbe_sll_element_init(fbe_cms_cluster_ht_entry_get_head(lp_hash_entry));
@@ -102,10 +148,188 @@ void fbe_cms_cluster_ht_setup(fbe_cms_cluster_ht_t * ht)
     }
 }
 
+static fbe_cms_cluster_tag_t * fbe_cms_cluster_ht_find_in_bucket(fbe_cms_cluster_ht_entry_t * p_hash_entry, fbe_cms_alloc_id_t alloc_id)
+{
+    fbe_cms_cluster_tag_t * p_tag;
+
+    /* Search the hash chain of cluster tags for match on allocID */
+    for (p_tag = fbe_cms_tag_get_tag_from_hash_element(fbe_sll_front(fbe_cms_cluster_ht_entry_get_head(p_hash_entry))); 
+          p_tag; 
+          p_tag = fbe_cms_tag_get_tag_from_hash_element(fbe_sll_next(fbe_cms_cluster_ht_entry_get_head(p_hash_entry), fbe_cms_tag_get_hash_element(p_tag))))
+    {
+        if ((fbe_cms_tag_get_owner_id(p_tag) == alloc_id.owner_id) && 
+			(fbe_cms_tag_get_buffer_id(p_tag) == alloc_id.buff_id))
+        { 
+            return p_tag;
+        }
+    }
+    return NULL;
+}
+
+static void fbe_cms_cluster_ht_lock_all_stripes(void)
+{
+    fbe_u32_t stripe_idx;
+
+    /* Always in ascending order, and never while holding one of them or the migrate lock */
+    for (stripe_idx = 0; stripe_idx < FBE_CMS_HASH_LOCK_STRIPES; stripe_idx++)
+    {
+        fbe_spinlock_lock(&g_ht.m_stripes[stripe_idx].m_lock);
+    }
+}
+
+static void fbe_cms_cluster_ht_unlock_all_stripes(void)
+{
+    fbe_u32_t stripe_idx;
+
+    for (stripe_idx = FBE_CMS_HASH_LOCK_STRIPES; stripe_idx > 0; stripe_idx--)
+    {
+        fbe_spinlock_unlock(&g_ht.m_stripes[stripe_idx - 1].m_lock);
+    }
+}
+
+/*!**************************************************************
+ * fbe_cms_cluster_ht_start_resize()
+ ****************************************************************
+ * @brief
+ *  Allocate a table twice the size of the current one and make it
+ *  the current table. The tags are not moved here, every insert
+ *  and delete moves a few old buckets until the old table is empty.
+ *  All stripes are only held for the pointer swap.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void fbe_cms_cluster_ht_start_resize(void)
+{
+    void *                          p_new_ht_mem;
+    fbe_u32_t                       new_bucket_count;
+    fbe_cms_cluster_ht_entry_t *    lp_hash_entry;
+    fbe_u32_t                       l_hash_idx;
+
+    /* Only one resize at a time, whoever wins also frees the old table when done */
+    if (fbe_atomic_compare_exchange(&g_ht.m_resize_in_progress, 1, 0) != 0)
+    {
+        return;
+    }
+
+    new_bucket_count = g_ht.m_bucket_count * 2;
+    if (new_bucket_count > FBE_CMS_MAX_HASH_ENTRIES)
+    {
+        fbe_atomic_exchange(&g_ht.m_resize_in_progress, 0);
+        return;
+    }
+
+    p_new_ht_mem = fbe_cms_cmm_memory_allocate(new_bucket_count * sizeof(fbe_cms_cluster_ht_entry_t));
+    if (!p_new_ht_mem)
+    {
+        /* Not fatal, we just keep longer chains */
+        cms_trace(FBE_TRACE_LEVEL_WARNING, "%s: failed to allocate %d buckets\n", __FUNCTION__, new_bucket_count);
+        fbe_atomic_exchange(&g_ht.m_resize_in_progress, 0);
+        return;
+    }
+
+    lp_hash_entry = p_new_ht_mem;
+    for (l_hash_idx = 0; l_hash_idx < new_bucket_count; l_hash_idx++)
+    {
+        fbe_sll_element_init(fbe_cms_cluster_ht_entry_get_head(lp_hash_entry));
+        lp_hash_entry++;
+    }
+
+    fbe_cms_cluster_ht_lock_all_stripes();
+    fbe_spinlock_lock(&g_ht.m_migrate_lock);
+    g_ht.mp_old_ht_mem = g_ht.mp_ht_mem;
+    g_ht.m_old_bucket_count = g_ht.m_bucket_count;
+    g_ht.mp_ht_mem = p_new_ht_mem;
+    g_ht.m_bucket_count = new_bucket_count;
+    g_ht.m_migrate_next = 0;
+    g_ht.m_migrated_count = 0;
+    fbe_spinlock_unlock(&g_ht.m_migrate_lock);
+    fbe_cms_cluster_ht_unlock_all_stripes();
+
+    cms_trace(FBE_TRACE_LEVEL_DEBUG_LOW, "%s: growing from %d to %d buckets\n",
+              __FUNCTION__, new_bucket_count / 2, new_bucket_count);
+}
+
+/*!**************************************************************
+ * fbe_cms_cluster_ht_migrate()
+ ****************************************************************
+ * @brief
+ *  Move up to FBE_CMS_HASH_MIGRATE_BUCKETS_PER_OP buckets of the
+ *  old table to the current one. The last one to finish releases
+ *  the old table.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void fbe_cms_cluster_ht_migrate(void)
+{
+    fbe_u32_t                       migrated;
+    fbe_u32_t                       old_bucket_idx;
+    fbe_cms_cluster_ht_stripe_t *   p_stripe;
+    fbe_cms_cluster_ht_entry_t *    p_old_entry;
+    fbe_sll_element_t *             p_element;
+    fbe_cms_cluster_tag_t *         p_tag;
+    fbe_u64_t                       hash;
+    void *                          p_old_ht_mem;
+    fbe_u32_t                       old_bucket_count;
+
+    for (migrated = 0; migrated < FBE_CMS_HASH_MIGRATE_BUCKETS_PER_OP; migrated++)
+    {
+        /* Claim the next old bucket. The resize can't complete (nor a new one start) until
+         * the bucket we claim here is moved, so the old table stays valid until we are done.
+         */
+        fbe_spinlock_lock(&g_ht.m_migrate_lock);
+        old_bucket_count = g_ht.m_old_bucket_count;
+        if ((g_ht.mp_old_ht_mem == NULL) || (g_ht.m_migrate_next >= old_bucket_count))
+        {
+            /* Everything is claimed already */
+            fbe_spinlock_unlock(&g_ht.m_migrate_lock);
+            return;
+        }
+        old_bucket_idx = g_ht.m_migrate_next++;
+        fbe_spinlock_unlock(&g_ht.m_migrate_lock);
+
+        /* The stripe of the old bucket is the stripe of all the tags on it */
+        p_stripe = &g_ht.m_stripes[old_bucket_idx & (FBE_CMS_HASH_LOCK_STRIPES - 1)];
+        fbe_spinlock_lock(&p_stripe->m_lock);
+        p_old_ht_mem = g_ht.mp_old_ht_mem;
+
+        p_old_entry = ((fbe_cms_cluster_ht_entry_t*)p_old_ht_mem) + old_bucket_idx;
+        while ((p_element = fbe_sll_front(fbe_cms_cluster_ht_entry_get_head(p_old_entry))) != NULL)
+        {
+            p_tag = fbe_cms_tag_get_tag_from_hash_element(p_element);
+            fbe_sll_remove(fbe_cms_cluster_ht_entry_get_head(p_old_entry), p_element);
+            hash = fbe_cms_cluster_hash(fbe_cms_tag_get_allocation_id(p_tag));
+            fbe_sll_push_front(fbe_cms_cluster_ht_entry_get_head(fbe_cms_cluster_ht_get_bucket(g_ht.mp_ht_mem, g_ht.m_bucket_count, hash)),
+                               p_element);
+        }
+        fbe_spinlock_unlock(&p_stripe->m_lock);
+
+        if (fbe_atomic_increment(&g_ht.m_migrated_count) == (fbe_atomic_t)old_bucket_count)
+        {
+            /* Last bucket moved, nobody can find anything in the old table any more */
+            fbe_cms_cluster_ht_lock_all_stripes();
+            fbe_spinlock_lock(&g_ht.m_migrate_lock);
+            g_ht.mp_old_ht_mem = NULL;
+            g_ht.m_old_bucket_count = 0;
+            fbe_spinlock_unlock(&g_ht.m_migrate_lock);
+            fbe_cms_cluster_ht_unlock_all_stripes();
+
+            fbe_cms_cmm_memory_release(p_old_ht_mem);
+            fbe_atomic_exchange(&g_ht.m_resize_in_progress, 0);
+            return;
+        }
+    }
+}
+
 void fbe_cms_cluster_ht_insert(fbe_cms_cluster_tag_t * p_new_tag)
 {
     fbe_cms_cluster_ht_entry_t  * p_hash_entry;
+    fbe_cms_cluster_ht_stripe_t * p_stripe;
     fbe_cms_alloc_id_t          alloc_id;
+    fbe_u64_t                   hash;
+    fbe_bool_t                  b_grow;
+    fbe_bool_t                  b_migrate;
 
     alloc_id = fbe_cms_tag_get_allocation_id(p_new_tag);
     if(alloc_id.buff_id == FBE_CMS_INVALID_ALLOC_ID)
@@ -113,41 +337,114 @@ void fbe_cms_cluster_ht_insert(fbe_cms_cluster_tag_t * p_new_tag)
         cms_trace(FBE_TRACE_LEVEL_ERROR, "%s: Invalid allocID. Tag: 0x%x \n", __FUNCTION__, p_new_tag);
     }
 
-    /* Index into hashtable and get pointer to Hash entry */
-    p_hash_entry = fbe_cms_get_hash_entry(alloc_id);
+    hash = fbe_cms_cluster_hash(alloc_id);
+    p_stripe = fbe_cms_cluster_ht_get_stripe(hash);
+
+    fbe_spinlock_lock(&p_stripe->m_lock);
+
+    /* Index into the current table and get pointer to Hash entry */
+    p_hash_entry = fbe_cms_cluster_ht_get_bucket(g_ht.mp_ht_mem, g_ht.m_bucket_count, hash);
 
     /* Add passed in Tag to the head of Hash Chain */
     cms_trace(FBE_TRACE_LEVEL_DEBUG_LOW, "%s: allocID: 0x%x \n", __FUNCTION__, alloc_id);
     fbe_sll_push_front(fbe_cms_cluster_ht_entry_get_head(p_hash_entry), fbe_cms_tag_get_hash_element(p_new_tag));
+    p_stripe->m_entry_count++;
+
+    /* Each stripe owns 1/FBE_CMS_HASH_LOCK_STRIPES of the buckets, grow when its chains get longer than the average we size for */
+    b_grow = (p_stripe->m_entry_count > (g_ht.m_bucket_count / FBE_CMS_HASH_LOCK_STRIPES) * FBE_CMS_AVG_HASH_CHAIN_SIZE);
+    b_migrate = (g_ht.mp_old_ht_mem != NULL);
+    fbe_spinlock_unlock(&p_stripe->m_lock);
+
+    if (b_migrate)
+    {
+        fbe_cms_cluster_ht_migrate();
+    }
+    else if (b_grow)
+    {
+        fbe_cms_cluster_ht_start_resize();
+    }
 }
 
 fbe_bool_t fbe_cms_cluster_ht_delete(fbe_cms_alloc_id_t alloc_id)
 {
     fbe_cms_cluster_ht_entry_t * p_hash_entry;
+    fbe_cms_cluster_ht_stripe_t * p_stripe;
     fbe_cms_cluster_tag_t * p_tag;
+    fbe_u64_t hash;
+    fbe_bool_t b_migrate;
 
     cms_trace(FBE_TRACE_LEVEL_DEBUG_LOW, "%s: allocID: 0x%x \n", __FUNCTION__, alloc_id);
 
-    /* Index into hashtable and get pointer to Hash entry */
-    p_hash_entry = fbe_cms_get_hash_entry(alloc_id);
+    hash = fbe_cms_cluster_hash(alloc_id);
+    p_stripe = fbe_cms_cluster_ht_get_stripe(hash);
 
-    /* Search the hash chain of cluster tags for match on allocID */
-    for (p_tag = fbe_cms_tag_get_tag_from_hash_element(fbe_sll_front(fbe_cms_cluster_ht_entry_get_head(p_hash_entry))); 
-          p_tag; 
-          p_tag = fbe_cms_tag_get_tag_from_hash_element(fbe_sll_next(fbe_cms_cluster_ht_entry_get_head(p_hash_entry), fbe_cms_tag_get_hash_element(p_tag))))
+    fbe_spinlock_lock(&p_stripe->m_lock);
+
+    /* While resizing the tag may still be on its old bucket */
+    p_tag = NULL;
+    if (g_ht.mp_old_ht_mem != NULL)
     {
-        if ((fbe_cms_tag_get_owner_id(p_tag) == alloc_id.owner_id) && 
-			(fbe_cms_tag_get_buffer_id(p_tag) == alloc_id.buff_id))
-        { 
-            cms_trace(FBE_TRACE_LEVEL_DEBUG_LOW, "%s: Found allocID: 0x%x cluster_tag 0x%x \n", __FUNCTION__, alloc_id, p_tag);
-            
-            /* Remove it from the hash chain */
-            fbe_sll_remove(fbe_cms_cluster_ht_entry_get_head(p_hash_entry), fbe_cms_tag_get_hash_element(p_tag));
-            return true;
-        }
+        p_hash_entry = fbe_cms_cluster_ht_get_bucket(g_ht.mp_old_ht_mem, g_ht.m_old_bucket_count, hash);
+        p_tag = fbe_cms_cluster_ht_find_in_bucket(p_hash_entry, alloc_id);
+    }
+    if (p_tag == NULL)
+    {
+        p_hash_entry = fbe_cms_cluster_ht_get_bucket(g_ht.mp_ht_mem, g_ht.m_bucket_count, hash);
+        p_tag = fbe_cms_cluster_ht_find_in_bucket(p_hash_entry, alloc_id);
     }
 
-    /* We did not find this element on our hash chain */
-    return false;
+    if (p_tag != NULL)
+    {
+        cms_trace(FBE_TRACE_LEVEL_DEBUG_LOW, "%s: Found allocID: 0x%x cluster_tag 0x%x \n", __FUNCTION__, alloc_id, p_tag);
+
+        /* Remove it from the hash chain */
+        fbe_sll_remove(fbe_cms_cluster_ht_entry_get_head(p_hash_entry), fbe_cms_tag_get_hash_element(p_tag));
+        p_stripe->m_entry_count--;
+    }
+    b_migrate = (g_ht.mp_old_ht_mem != NULL);
+    fbe_spinlock_unlock(&p_stripe->m_lock);
+
+    if (b_migrate)
+    {
+        fbe_cms_cluster_ht_migrate();
+    }
+
+    /* We did not find this element on our hash chain if p_tag is NULL */
+    return (p_tag != NULL);
 }
 
+fbe_cms_cluster_tag_t * fbe_cms_cluster_ht_lookup(fbe_cms_alloc_id_t alloc_id)
+{
+    fbe_cms_cluster_ht_stripe_t * p_stripe;
+    fbe_cms_cluster_tag_t * p_tag = NULL;
+    fbe_u64_t hash;
+
+    hash = fbe_cms_cluster_hash(alloc_id);
+    p_stripe = fbe_cms_cluster_ht_get_stripe(hash);
+
+    /* Lookups only take the stripe of the alloc ID, so they scale with the number of stripes */
+    fbe_spinlock_lock(&p_stripe->m_lock);
+    if (g_ht.mp_old_ht_mem != NULL)
+    {
+        p_tag = fbe_cms_cluster_ht_find_in_bucket(fbe_cms_cluster_ht_get_bucket(g_ht.mp_old_ht_mem, g_ht.m_old_bucket_count, hash),
+                                                  alloc_id);
+    }
+    if (p_tag == NULL)
+    {
+        p_tag = fbe_cms_cluster_ht_find_in_bucket(fbe_cms_cluster_ht_get_bucket(g_ht.mp_ht_mem, g_ht.m_bucket_count, hash),
+                                                  alloc_id);
+    }
+    fbe_spinlock_unlock(&p_stripe->m_lock);
+
+    return p_tag;
+}
+
+fbe_u32_t fbe_cms_cluster_ht_get_bucket_count(void)
+{
+    return g_ht.m_bucket_count;
+}
+
+fbe_bool_t fbe_cms_cluster_ht_is_resizing(void)
+{
+    return (g_ht.m_resize_in_progress != 0);
+}
@@ -0,0 +1,338 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2011
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!**************************************************************************
+ * @file fbe_cms_cluster_ht_test_main.c
+ ***************************************************************************
+ *
+ * @brief
+ *  Unit test for the cluster tag hashtable. Checks that tags can be found
+ *  while the table grows, and measures insert/delete and lookup throughput
+ *  as the number of threads grows.
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "fbe/fbe_winddk.h"
+#include "fbe/fbe_types.h"
+#include "fbe/fbe_atomic.h"
+#include "fbe_cms_cluster_ht.h"
+#include "fbe_cms_cluster_tag.h"
+#include "fbe_cms_defines.h"
+#include "mut.h"
+#include "mut_assert.h"
+#include "fbe/fbe_emcutil_shell_include.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+
+/*************************
+ *   LOCAL DEFINITIONS
+ *************************/
+
+/* As many tags as the largest table is sized for */
+#define CMS_HT_TEST_TAG_COUNT          (FBE_CMS_MAX_HASH_ENTRIES)
+/* Tags are spread across this many owners, like the clients of CMS do */
+#define CMS_HT_TEST_OWNER_COUNT        (8)
+#define CMS_HT_TEST_MAX_THREADS        (16)
+#define CMS_HT_TEST_LOOKUPS_PER_THREAD (1000000)
+#define CMS_HT_TEST_INSERT_PASSES      (32)
+
+typedef struct cms_ht_test_thread_s {
+    fbe_thread_t    thread;
+    fbe_u32_t       thread_index;
+    fbe_u32_t       thread_count;
+    fbe_u32_t       failed_lookups;
+} cms_ht_test_thread_t;
+
+static fbe_cms_cluster_tag_t *  cms_ht_test_tags = NULL;
+static cms_ht_test_thread_t     cms_ht_test_threads[CMS_HT_TEST_MAX_THREADS];
+static fbe_atomic_t             cms_ht_test_go = 0;
+
+/*************************
+ *   STUBS
+ *************************/
+
+/* The hashtable only needs these from the rest of CMS. */
+void cms_trace(fbe_trace_level_t trace_level, const char * fmt, ...)
+{
+    va_list args;
+
+    if (trace_level > FBE_TRACE_LEVEL_WARNING) {
+        return;
+    }
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+}
+
+void * fbe_cms_cmm_memory_allocate(fbe_u32_t allocation_size_in_bytes)
+{
+    return malloc(allocation_size_in_bytes);
+}
+
+void fbe_cms_cmm_memory_release(void * ptr)
+{
+    free(ptr);
+}
+
+void * fbe_cms_memory_get_va_of_buffer(fbe_u32_t tag_index)
+{
+    return NULL;
+}
+
+/*************************
+ *   FUNCTIONS
+ *************************/
+
+static fbe_cms_alloc_id_t cms_ht_test_get_alloc_id(fbe_u32_t tag_index)
+{
+    fbe_cms_alloc_id_t alloc_id;
+
+    /* Each owner allocates consecutive buffer IDs */
+    alloc_id.owner_id = (tag_index % CMS_HT_TEST_OWNER_COUNT) + 1;
+    alloc_id.buff_id = tag_index / CMS_HT_TEST_OWNER_COUNT;
+    return alloc_id;
+}
+
+static void cms_ht_test_setup(void)
+{
+    fbe_u32_t       tag_index;
+    fbe_status_t    status;
+
+    cms_ht_test_tags = (fbe_cms_cluster_tag_t *)malloc(sizeof(fbe_cms_cluster_tag_t) * CMS_HT_TEST_TAG_COUNT);
+    MUT_ASSERT_NOT_NULL(cms_ht_test_tags);
+
+    for (tag_index = 0; tag_index < CMS_HT_TEST_TAG_COUNT; tag_index++) {
+        fbe_cms_cluster_tag_init(&cms_ht_test_tags[tag_index]);
+        fbe_cms_tag_set_tag_index(&cms_ht_test_tags[tag_index], tag_index);
+        fbe_cms_tag_set_allocation_id(&cms_ht_test_tags[tag_index], cms_ht_test_get_alloc_id(tag_index));
+    }
+
+    status = fbe_cms_cluster_ht_init();
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+}
+
+static void cms_ht_test_teardown(void)
+{
+    fbe_cms_cluster_ht_destroy();
+    free(cms_ht_test_tags);
+    cms_ht_test_tags = NULL;
+}
+
+/*!**************************************************************
+ * cms_ht_test_grow()
+ ****************************************************************
+ * @brief
+ *  Fill the table so it has to grow to its maximum size, and check
+ *  every tag can be found (and deleted) at every point.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void cms_ht_test_grow(void)
+{
+    fbe_u32_t                   tag_index;
+    fbe_u32_t                   check_index;
+    fbe_cms_cluster_tag_t *     p_tag;
+
+    MUT_ASSERT_INT_EQUAL(FBE_CMS_MIN_HASH_ENTRIES, fbe_cms_cluster_ht_get_bucket_count());
+
+    for (tag_index = 0; tag_index < CMS_HT_TEST_TAG_COUNT; tag_index++) {
+        fbe_cms_cluster_ht_insert(&cms_ht_test_tags[tag_index]);
+
+        /* Whatever we inserted must be found, also in the middle of a resize */
+        if ((tag_index % 512) == 0) {
+            for (check_index = 0; check_index <= tag_index; check_index++) {
+                p_tag = fbe_cms_cluster_ht_lookup(cms_ht_test_get_alloc_id(check_index));
+                MUT_ASSERT_TRUE(p_tag == &cms_ht_test_tags[check_index]);
+            }
+        }
+    }
+
+    /* The last resize finishes as deletes keep moving old buckets */
+    for (tag_index = 0; tag_index < CMS_HT_TEST_TAG_COUNT; tag_index += 2) {
+        MUT_ASSERT_TRUE(fbe_cms_cluster_ht_delete(cms_ht_test_get_alloc_id(tag_index)));
+    }
+    mut_printf(MUT_LOG_TEST_STATUS, "%s: %d buckets for %d tags, resizing: %d",
+               __FUNCTION__, fbe_cms_cluster_ht_get_bucket_count(), CMS_HT_TEST_TAG_COUNT,
+               fbe_cms_cluster_ht_is_resizing());
+    MUT_ASSERT_TRUE(fbe_cms_cluster_ht_get_bucket_count() > FBE_CMS_MIN_HASH_ENTRIES);
+    MUT_ASSERT_FALSE(fbe_cms_cluster_ht_is_resizing());
+
+    for (tag_index = 0; tag_index < CMS_HT_TEST_TAG_COUNT; tag_index++) {
+        p_tag = fbe_cms_cluster_ht_lookup(cms_ht_test_get_alloc_id(tag_index));
+        if (tag_index & 1) {
+            MUT_ASSERT_TRUE(p_tag == &cms_ht_test_tags[tag_index]);
+        } else {
+            MUT_ASSERT_NULL(p_tag);
+        }
+    }
+
+    /* Deleting twice must fail */
+    MUT_ASSERT_FALSE(fbe_cms_cluster_ht_delete(cms_ht_test_get_alloc_id(0)));
+}
+
+static void cms_ht_test_wait_for_go(void)
+{
+    while (fbe_atomic_exchange(&cms_ht_test_go, cms_ht_test_go) == 0) {
+        fbe_thread_delay(1);
+    }
+}
+
+static void cms_ht_test_insert_thread(void * context)
+{
+    cms_ht_test_thread_t *  thread_p = (cms_ht_test_thread_t *)context;
+    fbe_u32_t               pass;
+    fbe_u32_t               tag_index;
+
+    cms_ht_test_wait_for_go();
+
+    /* Every thread owns an interleaved slice of the tags */
+    for (pass = 0; pass < CMS_HT_TEST_INSERT_PASSES; pass++) {
+        for (tag_index = thread_p->thread_index; tag_index < CMS_HT_TEST_TAG_COUNT; tag_index += thread_p->thread_count) {
+            fbe_cms_cluster_ht_insert(&cms_ht_test_tags[tag_index]);
+        }
+        if (pass == (CMS_HT_TEST_INSERT_PASSES - 1)) {
+            break;
+        }
+        for (tag_index = thread_p->thread_index; tag_index < CMS_HT_TEST_TAG_COUNT; tag_index += thread_p->thread_count) {
+            fbe_cms_cluster_ht_delete(cms_ht_test_get_alloc_id(tag_index));
+        }
+    }
+    fbe_thread_exit(EMCPAL_STATUS_SUCCESS);
+}
+
+static void cms_ht_test_lookup_thread(void * context)
+{
+    cms_ht_test_thread_t *  thread_p = (cms_ht_test_thread_t *)context;
+    fbe_u32_t               lookup;
+    fbe_u32_t               tag_index = thread_p->thread_index;
+
+    cms_ht_test_wait_for_go();
+
+    for (lookup = 0; lookup < CMS_HT_TEST_LOOKUPS_PER_THREAD; lookup++) {
+        /* Walk all tags with a stride so threads don't hit the same chains in lock step */
+        tag_index = (tag_index + 7919) % CMS_HT_TEST_TAG_COUNT;
+        if (fbe_cms_cluster_ht_lookup(cms_ht_test_get_alloc_id(tag_index)) != &cms_ht_test_tags[tag_index]) {
+            thread_p->failed_lookups++;
+        }
+    }
+    fbe_thread_exit(EMCPAL_STATUS_SUCCESS);
+}
+
+/*!**************************************************************
+ * cms_ht_test_run_threads()
+ ****************************************************************
+ * @brief
+ *  Start thread_count threads running thread_func, release them
+ *  together and return how long it took for all to finish.
+ *
+ * @return elapsed time in milliseconds.
+ *
+ ****************************************************************/
+static fbe_u32_t cms_ht_test_run_threads(fbe_u32_t thread_count, fbe_thread_user_root_t thread_func)
+{
+    fbe_u32_t       thread_index;
+    fbe_time_t      start_time;
+    fbe_u32_t       elapsed_msec;
+    EMCPAL_STATUS   nt_status;
+
+    cms_ht_test_go = 0;
+    for (thread_index = 0; thread_index < thread_count; thread_index++) {
+        cms_ht_test_threads[thread_index].thread_index = thread_index;
+        cms_ht_test_threads[thread_index].thread_count = thread_count;
+        cms_ht_test_threads[thread_index].failed_lookups = 0;
+        nt_status = fbe_thread_init(&cms_ht_test_threads[thread_index].thread, "cms_ht_test",
+                                    thread_func, &cms_ht_test_threads[thread_index]);
+        MUT_ASSERT_INT_EQUAL(EMCPAL_STATUS_SUCCESS, nt_status);
+    }
+
+    start_time = fbe_get_time();
+    fbe_atomic_exchange(&cms_ht_test_go, 1);
+
+    for (thread_index = 0; thread_index < thread_count; thread_index++) {
+        fbe_thread_wait(&cms_ht_test_threads[thread_index].thread);
+        fbe_thread_destroy(&cms_ht_test_threads[thread_index].thread);
+    }
+    elapsed_msec = fbe_get_elapsed_milliseconds(start_time);
+
+    /* Don't divide by zero on very fast runs */
+    return (elapsed_msec == 0) ? 1 : elapsed_msec;
+}
+
+/*!**************************************************************
+ * cms_ht_test_scaling()
+ ****************************************************************
+ * @brief
+ *  For 1, 2, 4 ... threads, insert/delete all the tags from scratch
+ *  (so every run goes through all the resizes) and then look them
+ *  up, and report operations per millisecond.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void cms_ht_test_scaling(void)
+{
+    fbe_u32_t       max_threads;
+    fbe_u32_t       thread_count;
+    fbe_u32_t       thread_index;
+    fbe_u32_t       elapsed_msec;
+    fbe_u64_t       operations;
+    fbe_status_t    status;
+
+    max_threads = fbe_get_cpu_count();
+    if (max_threads > CMS_HT_TEST_MAX_THREADS) {
+        max_threads = CMS_HT_TEST_MAX_THREADS;
+    }
+
+    mut_printf(MUT_LOG_TEST_STATUS, "threads   insert+delete ops/ms   lookup ops/ms   buckets");
+    for (thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+        /* Start from the minimum size every time */
+        fbe_cms_cluster_ht_destroy();
+        status = fbe_cms_cluster_ht_init();
+        MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, status);
+
+        elapsed_msec = cms_ht_test_run_threads(thread_count, cms_ht_test_insert_thread);
+        operations = (fbe_u64_t)CMS_HT_TEST_TAG_COUNT * (2 * CMS_HT_TEST_INSERT_PASSES - 1);
+        mut_printf(MUT_LOG_TEST_STATUS, "%7d   %20llu", thread_count,
+                   (unsigned long long)(operations / elapsed_msec));
+
+        elapsed_msec = cms_ht_test_run_threads(thread_count, cms_ht_test_lookup_thread);
+        operations = (fbe_u64_t)CMS_HT_TEST_LOOKUPS_PER_THREAD * thread_count;
+        mut_printf(MUT_LOG_TEST_STATUS, "%7d   %20s   %13llu   %7d", thread_count, "",
+                   (unsigned long long)(operations / elapsed_msec), fbe_cms_cluster_ht_get_bucket_count());
+
+        for (thread_index = 0; thread_index < thread_count; thread_index++) {
+            MUT_ASSERT_INT_EQUAL(0, cms_ht_test_threads[thread_index].failed_lookups);
+        }
+    }
+}
+
+int __cdecl main (int argc , char ** argv)
+{
+    mut_testsuite_t *suite_p;
+
+#include "fbe/fbe_emcutil_shell_maincode.h"
+
+    mut_init(argc, argv);
+
+    suite_p = MUT_CREATE_TESTSUITE("fbe_cms_cluster_ht_test_suite");
+
+    MUT_ADD_TEST(suite_p, cms_ht_test_grow, cms_ht_test_setup, cms_ht_test_teardown);
+    MUT_ADD_TEST(suite_p, cms_ht_test_scaling, cms_ht_test_setup, cms_ht_test_teardown);
+
+    MUT_RUN_TESTSUITE(suite_p);
+
+    exit(0);
+}
+
+/*************************
+ * end file fbe_cms_cluster_ht_test_main.c
+ *************************/
@@ -737,6 +737,26 @@ fbe_status_t fbe_job_service_hook_check_hook_and_take_action(fbe_job_queue_eleme
  * end fbe_job_service_hook_check_hook_and_take_action()
  *******************************************************/
 
+/*!**************************************************************
+ *          fbe_job_service_hook_is_any_hook_set()
+ **************************************************************** 
+ * 
+ * @brief   Determine if any debug hook is set.  Jobs are not pipelined
+ *          while hooks are set so that a paused job still holds off
+ *          the jobs behind it.
+ *
+ * @param   None
+ *
+ * @return  fbe_bool_t - FBE_TRUE if at least one hook is set
+ *
+ ****************************************************************/
+fbe_bool_t fbe_job_service_hook_is_any_hook_set(void)
+{
+    return (fbe_job_service_hooks_in_use != 0) ? FBE_TRUE : FBE_FALSE;
+}
+/******************************************** 
+ * end fbe_job_service_hook_is_any_hook_set()
+ ********************************************/
 
 /********************************
  *end of fbe_job_service_hook.c
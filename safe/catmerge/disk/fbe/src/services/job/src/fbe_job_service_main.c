@@ -211,6 +211,11 @@ fbe_status_t fbe_job_service_init(fbe_packet_t * packet_p)
     */
     fbe_transport_initialize_sep_packet (fbe_job_service.job_packet_p);
 
+    /* set up the commit slots, if this fails every job simply runs on the
+     * job thread from start to end
+     */
+    fbe_job_service_pipeline_init();
+
     /* set processing of queues default = FBE_TRUE */
     fbe_job_service_handle_queue_access(FBE_TRUE);
 
@@ -440,6 +445,9 @@ fbe_status_t fbe_job_service_destroy(fbe_packet_t * packet_p)
     fbe_thread_destroy(&fbe_job_service.thread_handle);
     fbe_semaphore_destroy(&fbe_job_service.job_control_process_semaphore);
 
+    /* The job thread drained the pipeline on its way out, stop the commit slots */
+    fbe_job_service_pipeline_destroy();
+
     /* ********************************************************/
     /*  job service arrival queues - Destroy Queue and Lock   */
     /* ********************************************************/
@@ -576,6 +584,10 @@ fbe_status_t fbe_job_service_destroy(fbe_packet_t * packet_p)
     }
 
     fbe_job_service_debug_hook_destroy();
+
+    /* Release the spare index while the notification service is still up. */
+    fbe_spare_lib_index_destroy();
+
     job_service_trace(FBE_TRACE_LEVEL_INFO, 
             FBE_TRACE_MESSAGE_ID_FUNCTION_ENTRY,
             "%s, number_recovery_object %d, number creation job %d, job number 0x%llX\n",
@@ -751,6 +763,18 @@ static fbe_status_t fbe_job_service_control_entry(fbe_packet_t * packet_p)
         case FBE_JOB_CONTROL_CODE_REMOVE_DEBUG_HOOK:
             status = fbe_job_service_hook_remove_debug_hook(packet_p);
             break;
+        case FBE_JOB_CONTROL_CODE_SET_PIPELINE_MODE:
+            status = fbe_job_service_pipeline_set_mode(packet_p);
+            break;
+        case FBE_JOB_CONTROL_CODE_GET_PIPELINE_INFO:
+            status = fbe_job_service_pipeline_get_info(packet_p);
+            break;
+        case FBE_JOB_CONTROL_CODE_SET_SPARE_INDEX_VERIFY:
+            status = fbe_spare_lib_index_set_verify(packet_p);
+            break;
+        case FBE_JOB_CONTROL_CODE_GET_SPARE_INDEX_INFO:
+            status = fbe_spare_lib_index_get_info(packet_p);
+            break;
 
         default:
             status = fbe_base_service_control_entry((fbe_base_service_t*)&fbe_job_service, packet_p);
@@ -930,6 +954,18 @@ fbe_status_t fbe_job_service_translate_control_entry(fbe_payload_control_operati
         case FBE_JOB_CONTROL_CODE_DESTROY_EXTENT_POOL_LUN:
             *pp_control_code_name = "FBE_JOB_CONTROL_CODE_DESTROY_EXTENT_POOL_LUN";
             break;
+        case FBE_JOB_CONTROL_CODE_SET_PIPELINE_MODE:
+            *pp_control_code_name = "FBE_JOB_CONTROL_CODE_SET_PIPELINE_MODE";
+            break;
+        case FBE_JOB_CONTROL_CODE_GET_PIPELINE_INFO:
+            *pp_control_code_name = "FBE_JOB_CONTROL_CODE_GET_PIPELINE_INFO";
+            break;
+        case FBE_JOB_CONTROL_CODE_SET_SPARE_INDEX_VERIFY:
+            *pp_control_code_name = "FBE_JOB_CONTROL_CODE_SET_SPARE_INDEX_VERIFY";
+            break;
+        case FBE_JOB_CONTROL_CODE_GET_SPARE_INDEX_INFO:
+            *pp_control_code_name = "FBE_JOB_CONTROL_CODE_GET_SPARE_INDEX_INFO";
+            break;
         default:
             *pp_control_code_name = "UNKNOWN_FBE_JOB_CONTROL_CODE";
             break;
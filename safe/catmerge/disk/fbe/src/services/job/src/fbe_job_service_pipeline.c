@@ -0,0 +1,662 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2010
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!**************************************************************************
+ * @file fbe_job_service_pipeline.c
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains the job service pipeline.  The pipeline lets the
+ *  commit phase of a job (waiting for the object to reach its lifecycle
+ *  state, the job notification and the peer update) run in a commit slot
+ *  while the job thread starts on the next job.
+ *
+ *  Validation, update in memory and persist are still run one job at a
+ *  time on the job thread since the database only allows one open
+ *  transaction.  Only jobs whose rollback after commit is a notification
+ *  are pipelined.  Jobs on the same object wait for each other, and any
+ *  other job drains the pipeline before it starts.
+ *
+ * @version
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "fbe/fbe_types.h"
+#include "fbe/fbe_queue.h"
+#include "fbe/fbe_memory.h"
+#include "fbe/fbe_winddk.h"
+#include "fbe/fbe_transport.h"
+#include "fbe_base_object.h"
+#include "fbe_transport_memory.h"
+#include "fbe_base_service.h"
+#include "fbe_topology.h"
+#include "fbe_job_service_private.h"
+#include "fbe_job_service.h"
+#include "fbe_job_service_cmi.h"
+
+/*************************
+ *   FUNCTION DEFINITIONS
+ *************************/
+static void fbe_job_service_pipeline_slot_thread_func(void * context);
+static void fbe_job_service_pipeline_release_slot(fbe_job_service_pipeline_slot_t *slot_p);
+
+/*!**************************************************************
+ * fbe_job_service_pipeline_is_pipelined_job_type()
+ ****************************************************************
+ * @brief
+ * Determine if the commit of this job type can overlap with the
+ * next job.
+ *
+ * @param job_type - job type to check
+ *
+ * @return fbe_bool_t - FBE_TRUE if the job can be pipelined
+ *
+ ****************************************************************/
+static fbe_bool_t fbe_job_service_pipeline_is_pipelined_job_type(fbe_job_type_t job_type)
+{
+    switch (job_type)
+    {
+        /* The rollback of these jobs after commit only sends the job
+         * notification, so a commit failure never needs the database.
+         */
+        case FBE_JOB_TYPE_LUN_CREATE:
+        case FBE_JOB_TYPE_LUN_DESTROY:
+            return FBE_TRUE;
+
+        default:
+            return FBE_FALSE;
+    }
+}
+/********************************************************
+ * end fbe_job_service_pipeline_is_pipelined_job_type()
+ ********************************************************/
+
+/*!**************************************************************
+ * fbe_job_service_pipeline_get_job_keys()
+ ****************************************************************
+ * @brief
+ * Get the objects a pipelined job works on.
+ *
+ * @param job_queue_element_p - job to look at
+ * @param lun_number_p - LUN number of the job
+ * @param lun_object_id_p - LUN object of the job
+ *
+ * @return - none
+ *
+ ****************************************************************/
+static void fbe_job_service_pipeline_get_job_keys(fbe_job_queue_element_t *job_queue_element_p,
+                                                  fbe_u32_t *lun_number_p,
+                                                  fbe_object_id_t *lun_object_id_p)
+{
+    fbe_job_service_lun_create_t  *lun_create_p = NULL;
+    fbe_job_service_lun_destroy_t *lun_destroy_p = NULL;
+
+    *lun_number_p = FBE_U32_MAX;
+    *lun_object_id_p = FBE_OBJECT_ID_INVALID;
+
+    if (job_queue_element_p->job_type == FBE_JOB_TYPE_LUN_CREATE)
+    {
+        lun_create_p = (fbe_job_service_lun_create_t *)job_queue_element_p->command_data;
+        *lun_number_p = lun_create_p->lun_number;
+        *lun_object_id_p = lun_create_p->lun_object_id;
+    }
+    else if (job_queue_element_p->job_type == FBE_JOB_TYPE_LUN_DESTROY)
+    {
+        lun_destroy_p = (fbe_job_service_lun_destroy_t *)job_queue_element_p->command_data;
+        *lun_number_p = lun_destroy_p->lun_number;
+        *lun_object_id_p = lun_destroy_p->lun_object_id;
+    }
+    return;
+}
+/*********************************************
+ * end fbe_job_service_pipeline_get_job_keys()
+ *********************************************/
+
+/*!**************************************************************
+ * fbe_job_service_pipeline_is_conflict()
+ ****************************************************************
+ * @brief
+ * Determine if a job has to wait for the job in a commit slot.
+ * Called with the job service lock held.
+ *
+ * @param job_queue_element_p - job about to start
+ * @param slot_p - busy commit slot
+ *
+ * @return fbe_bool_t - FBE_TRUE if the job must wait
+ *
+ ****************************************************************/
+static fbe_bool_t fbe_job_service_pipeline_is_conflict(fbe_job_queue_element_t *job_queue_element_p,
+                                                       fbe_job_service_pipeline_slot_t *slot_p)
+{
+    fbe_u32_t       lun_number;
+    fbe_object_id_t lun_object_id;
+
+    fbe_job_service_pipeline_get_job_keys(job_queue_element_p, &lun_number, &lun_object_id);
+
+    if ((lun_number != FBE_U32_MAX) &&
+        (lun_number == slot_p->lun_number))
+    {
+        return FBE_TRUE;
+    }
+    if ((lun_object_id != FBE_OBJECT_ID_INVALID) &&
+        (lun_object_id == slot_p->lun_object_id))
+    {
+        return FBE_TRUE;
+    }
+
+    /* A LUN being destroyed still holds its edge and capacity on the raid
+     * group until it is gone, so no LUN is created until it is.
+     */
+    if ((job_queue_element_p->job_type == FBE_JOB_TYPE_LUN_CREATE) &&
+        (slot_p->job_queue_element_p->job_type == FBE_JOB_TYPE_LUN_DESTROY))
+    {
+        return FBE_TRUE;
+    }
+    return FBE_FALSE;
+}
+/*********************************************
+ * end fbe_job_service_pipeline_is_conflict()
+ *********************************************/
+
+/*!**************************************************************
+ * fbe_job_service_pipeline_init()
+ ****************************************************************
+ * @brief
+ * Allocate the commit slots and start their threads.
+ *
+ * @param - none
+ *
+ * @return fbe_status_t - FBE_STATUS_OK, otherwise the pipeline is
+ *                        left disabled and is cleaned up by
+ *                        fbe_job_service_pipeline_destroy().
+ *
+ ****************************************************************/
+fbe_status_t fbe_job_service_pipeline_init(void)
+{
+    fbe_job_service_pipeline_t      *pipeline_p = &fbe_job_service.pipeline;
+    fbe_job_service_pipeline_slot_t *slot_p = NULL;
+    fbe_u32_t                       slot_index;
+    EMCPAL_STATUS                   nt_status;
+
+    fbe_zero_memory(pipeline_p, sizeof(fbe_job_service_pipeline_t));
+    fbe_semaphore_init(&pipeline_p->slot_free_semaphore, 0, FBE_SEMAPHORE_MAX);
+
+    /* Everything destroy looks at is set up first, so that a partly set up
+     * pipeline is cleaned up with the rest of the job service.
+     */
+    for (slot_index = 0; slot_index < FBE_JOB_SERVICE_PIPELINE_MAX_SLOTS; slot_index++)
+    {
+        slot_p = &pipeline_p->slots[slot_index];
+        slot_p->slot_index = slot_index;
+        slot_p->lun_number = FBE_U32_MAX;
+        slot_p->lun_object_id = FBE_OBJECT_ID_INVALID;
+        fbe_semaphore_init(&slot_p->start_semaphore, 0, 1);
+        fbe_semaphore_init(&slot_p->process_semaphore, 0, 1);
+    }
+
+    for (slot_index = 0; slot_index < FBE_JOB_SERVICE_PIPELINE_MAX_SLOTS; slot_index++)
+    {
+        slot_p = &pipeline_p->slots[slot_index];
+        slot_p->packet_p = fbe_transport_allocate_packet();
+        slot_p->cmi_message_p = (fbe_job_service_cmi_message_t *)
+            fbe_memory_native_allocate(sizeof(fbe_job_service_cmi_message_t));
+        if ((slot_p->packet_p == NULL) || (slot_p->cmi_message_p == NULL))
+        {
+            job_service_trace(FBE_TRACE_LEVEL_WARNING,
+                    FBE_TRACE_MESSAGE_ID_INFO,
+                    "%s: cannot allocate commit slot %d, jobs will not be pipelined\n",
+                    __FUNCTION__, slot_index);
+            return FBE_STATUS_INSUFFICIENT_RESOURCES;
+        }
+        fbe_transport_initialize_sep_packet(slot_p->packet_p);
+        fbe_transport_set_cpu_id(slot_p->packet_p, 0);
+        fbe_zero_memory(slot_p->cmi_message_p, sizeof(fbe_job_service_cmi_message_t));
+        fbe_semaphore_init(&slot_p->cmi_message_p->sem, 0, 1);
+
+        nt_status = fbe_thread_init(&slot_p->thread_handle, "fbe_job_cmt",
+                                    fbe_job_service_pipeline_slot_thread_func, slot_p);
+        if (nt_status != EMCPAL_STATUS_SUCCESS)
+        {
+            job_service_trace(FBE_TRACE_LEVEL_WARNING,
+                    FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                    "%s: fbe_thread_init failed for slot %d, jobs will not be pipelined\n",
+                    __FUNCTION__, slot_index);
+            return FBE_STATUS_GENERIC_FAILURE;
+        }
+        slot_p->b_thread_started = FBE_TRUE;
+    }
+
+    pipeline_p->b_enabled = FBE_TRUE;
+    return FBE_STATUS_OK;
+}
+/*************************************
+ * end fbe_job_service_pipeline_init()
+ *************************************/
+
+/*!**************************************************************
+ * fbe_job_service_pipeline_destroy()
+ ****************************************************************
+ * @brief
+ * Stop the commit slot threads and release their resources.
+ * The job thread is already stopped and drained the pipeline.
+ *
+ * @param - none
+ *
+ * @return - none
+ *
+ ****************************************************************/
+void fbe_job_service_pipeline_destroy(void)
+{
+    fbe_job_service_pipeline_t      *pipeline_p = &fbe_job_service.pipeline;
+    fbe_job_service_pipeline_slot_t *slot_p = NULL;
+    fbe_u32_t                       slot_index;
+
+    pipeline_p->b_enabled = FBE_FALSE;
+    pipeline_p->b_stop = FBE_TRUE;
+
+    for (slot_index = 0; slot_index < FBE_JOB_SERVICE_PIPELINE_MAX_SLOTS; slot_index++)
+    {
+        slot_p = &pipeline_p->slots[slot_index];
+        if (slot_p->b_thread_started)
+        {
+            fbe_semaphore_release(&slot_p->start_semaphore, 0, 1, FALSE);
+            fbe_thread_wait(&slot_p->thread_handle);
+            fbe_thread_destroy(&slot_p->thread_handle);
+            slot_p->b_thread_started = FBE_FALSE;
+        }
+        if (slot_p->packet_p != NULL)
+        {
+            fbe_transport_release_packet(slot_p->packet_p);
+            slot_p->packet_p = NULL;
+        }
+        if (slot_p->cmi_message_p != NULL)
+        {
+            fbe_semaphore_destroy(&slot_p->cmi_message_p->sem);
+            fbe_memory_native_release(slot_p->cmi_message_p);
+            slot_p->cmi_message_p = NULL;
+        }
+        fbe_semaphore_destroy(&slot_p->start_semaphore);
+        fbe_semaphore_destroy(&slot_p->process_semaphore);
+    }
+    fbe_semaphore_destroy(&pipeline_p->slot_free_semaphore);
+    return;
+}
+/****************************************
+ * end fbe_job_service_pipeline_destroy()
+ ****************************************/
+
+/*!**************************************************************
+ * fbe_job_service_pipeline_drain()
+ ****************************************************************
+ * @brief
+ * Wait until every pipelined job has finished its commit.  Called
+ * by the job thread before it runs a job that cannot overlap.
+ *
+ * @param - none
+ *
+ * @return - none
+ *
+ ****************************************************************/
+void fbe_job_service_pipeline_drain(void)
+{
+    fbe_job_service_pipeline_t *pipeline_p = &fbe_job_service.pipeline;
+    fbe_bool_t                 b_counted = FBE_FALSE;
+
+    fbe_job_service_lock();
+    while (pipeline_p->in_flight != 0)
+    {
+        if (!b_counted)
+        {
+            pipeline_p->barrier_drains++;
+            b_counted = FBE_TRUE;
+        }
+        fbe_job_service_unlock();
+        fbe_semaphore_wait(&pipeline_p->slot_free_semaphore, NULL);
+        fbe_job_service_lock();
+    }
+    fbe_job_service_unlock();
+    return;
+}
+/**************************************
+ * end fbe_job_service_pipeline_drain()
+ **************************************/
+
+/*!**************************************************************
+ * fbe_job_service_pipeline_prepare_job()
+ ****************************************************************
+ * @brief
+ * Called by the job thread before it runs a creation queue job.
+ * Waits until the job can run beside the jobs that are being
+ * committed and tells the caller if the job's own commit goes to
+ * a commit slot.
+ *
+ * @param job_queue_element_p - job about to start
+ *
+ * @return fbe_bool_t - FBE_TRUE if the job should stop at commit
+ *
+ ****************************************************************/
+fbe_bool_t fbe_job_service_pipeline_prepare_job(fbe_job_queue_element_t *job_queue_element_p)
+{
+    fbe_job_service_pipeline_t *pipeline_p = &fbe_job_service.pipeline;
+    fbe_u32_t                  slot_index;
+    fbe_bool_t                 b_conflict;
+    fbe_bool_t                 b_counted = FBE_FALSE;
+
+    /* Hooks pause the job thread, keep the jobs behind a paused job
+     * waiting as they always have.
+     */
+    if (!pipeline_p->b_enabled ||
+        !fbe_job_service_pipeline_is_pipelined_job_type(job_queue_element_p->job_type) ||
+        fbe_job_service_hook_is_any_hook_set())
+    {
+        fbe_job_service_pipeline_drain();
+        fbe_job_service_lock();
+        pipeline_p->serialized_jobs++;
+        fbe_job_service_unlock();
+        return FBE_FALSE;
+    }
+
+    fbe_job_service_lock();
+    while (1)
+    {
+        b_conflict = FBE_FALSE;
+        for (slot_index = 0; slot_index < FBE_JOB_SERVICE_PIPELINE_MAX_SLOTS; slot_index++)
+        {
+            if ((pipeline_p->slots[slot_index].job_queue_element_p != NULL) &&
+                fbe_job_service_pipeline_is_conflict(job_queue_element_p, &pipeline_p->slots[slot_index]))
+            {
+                b_conflict = FBE_TRUE;
+                break;
+            }
+        }
+        if (!b_conflict && (pipeline_p->in_flight < FBE_JOB_SERVICE_PIPELINE_MAX_SLOTS))
+        {
+            break;
+        }
+        if (b_conflict && !b_counted)
+        {
+            pipeline_p->conflict_waits++;
+            b_counted = FBE_TRUE;
+        }
+        fbe_job_service_unlock();
+        fbe_semaphore_wait(&pipeline_p->slot_free_semaphore, NULL);
+        fbe_job_service_lock();
+    }
+    fbe_job_service_unlock();
+
+    /* Only the job thread fills slots, so a free slot is still free
+     * when this job reaches its commit.
+     */
+    return FBE_TRUE;
+}
+/********************************************
+ * end fbe_job_service_pipeline_prepare_job()
+ ********************************************/
+
+/*!**************************************************************
+ * fbe_job_service_pipeline_start_commit()
+ ****************************************************************
+ * @brief
+ * Hand a persisted job over to a free commit slot.
+ *
+ * @param job_queue_element_p - job that reached its commit phase
+ *
+ * @return - none
+ *
+ ****************************************************************/
+void fbe_job_service_pipeline_start_commit(fbe_job_queue_element_t *job_queue_element_p)
+{
+    fbe_job_service_pipeline_t      *pipeline_p = &fbe_job_service.pipeline;
+    fbe_job_service_pipeline_slot_t *slot_p = NULL;
+    fbe_u32_t                       slot_index;
+
+    fbe_job_service_lock();
+    for (slot_index = 0; slot_index < FBE_JOB_SERVICE_PIPELINE_MAX_SLOTS; slot_index++)
+    {
+        if (pipeline_p->slots[slot_index].job_queue_element_p == NULL)
+        {
+            slot_p = &pipeline_p->slots[slot_index];
+            break;
+        }
+    }
+    if (slot_p == NULL)
+    {
+        /* prepare_job reserved a slot, this should never happen */
+        fbe_job_service_unlock();
+        job_service_trace(FBE_TRACE_LEVEL_ERROR,
+                FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                "%s no free commit slot for job 0x%llx, commit inline\n",
+                __FUNCTION__, (unsigned long long)job_queue_element_p->job_number);
+        fbe_job_service_process_queue_element(job_queue_element_p,
+                                              fbe_job_service.job_packet_p,
+                                              &fbe_job_service.job_control_process_semaphore,
+                                              FBE_FALSE);
+        fbe_job_service_complete_creation_job(job_queue_element_p,
+                                              fbe_job_service.job_service_cmi_message_exec_p,
+                                              fbe_job_service.job_packet_p);
+        return;
+    }
+
+    /* The keys are final now, validation may have filled them in */
+    fbe_job_service_pipeline_get_job_keys(job_queue_element_p, &slot_p->lun_number, &slot_p->lun_object_id);
+    slot_p->job_queue_element_p = job_queue_element_p;
+    pipeline_p->in_flight++;
+    pipeline_p->pipelined_jobs++;
+    fbe_job_service_unlock();
+
+    job_service_trace(FBE_TRACE_LEVEL_INFO,
+            FBE_TRACE_MESSAGE_ID_INFO,
+            "   job number 0x%llx commit handed to slot %d\n",
+            (unsigned long long)job_queue_element_p->job_number, slot_p->slot_index);
+
+    fbe_semaphore_release(&slot_p->start_semaphore, 0, 1, FALSE);
+    return;
+}
+/*********************************************
+ * end fbe_job_service_pipeline_start_commit()
+ *********************************************/
+
+/*!**************************************************************
+ * fbe_job_service_pipeline_release_slot()
+ ****************************************************************
+ * @brief
+ * Mark a commit slot free and wake up the job thread.
+ *
+ * @param slot_p - slot whose job is finished
+ *
+ * @return - none
+ *
+ ****************************************************************/
+static void fbe_job_service_pipeline_release_slot(fbe_job_service_pipeline_slot_t *slot_p)
+{
+    fbe_job_service_pipeline_t *pipeline_p = &fbe_job_service.pipeline;
+
+    fbe_job_service_lock();
+    slot_p->job_queue_element_p = NULL;
+    slot_p->lun_number = FBE_U32_MAX;
+    slot_p->lun_object_id = FBE_OBJECT_ID_INVALID;
+    pipeline_p->in_flight--;
+    fbe_job_service_unlock();
+
+    fbe_semaphore_release(&pipeline_p->slot_free_semaphore, 0, 1, FALSE);
+    return;
+}
+/*********************************************
+ * end fbe_job_service_pipeline_release_slot()
+ *********************************************/
+
+/*!**************************************************************
+ * fbe_job_service_pipeline_slot_thread_func()
+ ****************************************************************
+ * @brief
+ * Runs the commit (and the rollback if the commit fails) of the
+ * jobs handed to this slot, then tells the peer the job is done.
+ *
+ * @param context - the commit slot
+ *
+ * @return - none
+ *
+ ****************************************************************/
+static void fbe_job_service_pipeline_slot_thread_func(void * context)
+{
+    fbe_job_service_pipeline_slot_t *slot_p = (fbe_job_service_pipeline_slot_t *)context;
+    fbe_job_queue_element_t         *job_queue_element_p = NULL;
+
+    while (1)
+    {
+        fbe_semaphore_wait(&slot_p->start_semaphore, NULL);
+
+        job_queue_element_p = slot_p->job_queue_element_p;
+        if (job_queue_element_p == NULL)
+        {
+            if (fbe_job_service.pipeline.b_stop)
+            {
+                break;
+            }
+            continue;
+        }
+
+        fbe_job_service_process_queue_element(job_queue_element_p,
+                                              slot_p->packet_p,
+                                              &slot_p->process_semaphore,
+                                              FBE_FALSE);
+
+        fbe_job_service_complete_creation_job(job_queue_element_p,
+                                              slot_p->cmi_message_p,
+                                              slot_p->packet_p);
+
+        fbe_job_service_pipeline_release_slot(slot_p);
+    }
+
+    fbe_thread_exit(EMCPAL_STATUS_SUCCESS);
+}
+/*************************************************
+ * end fbe_job_service_pipeline_slot_thread_func()
+ *************************************************/
+
+/*!**************************************************************
+ * fbe_job_service_pipeline_set_mode()
+ ****************************************************************
+ * @brief
+ * Enable or disable the pipeline.  Jobs already committing finish,
+ * the next job drains them when the pipeline is disabled.
+ *
+ * @param packet_p - packet with fbe_job_service_set_pipeline_mode_t
+ *
+ * @return fbe_status_t
+ *
+ ****************************************************************/
+fbe_status_t fbe_job_service_pipeline_set_mode(fbe_packet_t *packet_p)
+{
+    fbe_job_service_set_pipeline_mode_t    *set_mode_p = NULL;
+    fbe_payload_ex_t                       *payload_p = NULL;
+    fbe_payload_control_operation_t        *control_operation = NULL;
+    fbe_payload_control_buffer_length_t    length = 0;
+    fbe_u32_t                              slot_index;
+
+    payload_p = fbe_transport_get_payload_ex(packet_p);
+    control_operation = fbe_payload_ex_get_control_operation(payload_p);
+
+    fbe_payload_control_get_buffer(control_operation, &set_mode_p);
+    fbe_payload_control_get_buffer_length(control_operation, &length);
+    if ((set_mode_p == NULL) || (length != sizeof(fbe_job_service_set_pipeline_mode_t)))
+    {
+        job_service_trace(FBE_TRACE_LEVEL_ERROR,
+                FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                "%s : ERROR: invalid set pipeline mode request\n", __FUNCTION__);
+        fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
+        fbe_transport_set_status(packet_p, FBE_STATUS_GENERIC_FAILURE, 0);
+        fbe_transport_complete_packet(packet_p);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    /* The slots must have come up to enable the pipeline */
+    for (slot_index = 0; slot_index < FBE_JOB_SERVICE_PIPELINE_MAX_SLOTS; slot_index++)
+    {
+        if (set_mode_p->b_enabled &&
+            !fbe_job_service.pipeline.slots[slot_index].b_thread_started)
+        {
+            fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
+            fbe_transport_set_status(packet_p, FBE_STATUS_GENERIC_FAILURE, 0);
+            fbe_transport_complete_packet(packet_p);
+            return FBE_STATUS_GENERIC_FAILURE;
+        }
+    }
+
+    job_service_trace(FBE_TRACE_LEVEL_INFO,
+            FBE_TRACE_MESSAGE_ID_INFO,
+            "%s pipeline %s\n", __FUNCTION__, set_mode_p->b_enabled ? "enabled" : "disabled");
+    fbe_job_service.pipeline.b_enabled = set_mode_p->b_enabled;
+
+    fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_OK);
+    fbe_transport_set_status(packet_p, FBE_STATUS_OK, 0);
+    fbe_transport_complete_packet(packet_p);
+    return FBE_STATUS_OK;
+}
+/*****************************************
+ * end fbe_job_service_pipeline_set_mode()
+ *****************************************/
+
+/*!**************************************************************
+ * fbe_job_service_pipeline_get_info()
+ ****************************************************************
+ * @brief
+ * Return the pipeline mode and statistics.
+ *
+ * @param packet_p - packet with fbe_job_service_pipeline_info_t
+ *
+ * @return fbe_status_t
+ *
+ ****************************************************************/
+fbe_status_t fbe_job_service_pipeline_get_info(fbe_packet_t *packet_p)
+{
+    fbe_job_service_pipeline_info_t        *info_p = NULL;
+    fbe_job_service_pipeline_t             *pipeline_p = &fbe_job_service.pipeline;
+    fbe_payload_ex_t                       *payload_p = NULL;
+    fbe_payload_control_operation_t        *control_operation = NULL;
+    fbe_payload_control_buffer_length_t    length = 0;
+
+    payload_p = fbe_transport_get_payload_ex(packet_p);
+    control_operation = fbe_payload_ex_get_control_operation(payload_p);
+
+    fbe_payload_control_get_buffer(control_operation, &info_p);
+    fbe_payload_control_get_buffer_length(control_operation, &length);
+    if ((info_p == NULL) || (length != sizeof(fbe_job_service_pipeline_info_t)))
+    {
+        job_service_trace(FBE_TRACE_LEVEL_ERROR,
+                FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                "%s : ERROR: invalid get pipeline info request\n", __FUNCTION__);
+        fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
+        fbe_transport_set_status(packet_p, FBE_STATUS_GENERIC_FAILURE, 0);
+        fbe_transport_complete_packet(packet_p);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    fbe_job_service_lock();
+    info_p->b_enabled = pipeline_p->b_enabled;
+    info_p->max_in_flight = FBE_JOB_SERVICE_PIPELINE_MAX_SLOTS;
+    info_p->in_flight = pipeline_p->in_flight;
+    info_p->pipelined_jobs = pipeline_p->pipelined_jobs;
+    info_p->serialized_jobs = pipeline_p->serialized_jobs;
+    info_p->conflict_waits = pipeline_p->conflict_waits;
+    info_p->barrier_drains = pipeline_p->barrier_drains;
+    fbe_job_service_unlock();
+
+    fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_OK);
+    fbe_transport_set_status(packet_p, FBE_STATUS_OK, 0);
+    fbe_transport_complete_packet(packet_p);
+    return FBE_STATUS_OK;
+}
+/*****************************************
+ * end fbe_job_service_pipeline_get_info()
+ *****************************************/
+
+/***********************************
+ * end of fbe_job_service_pipeline.c
+ ***********************************/
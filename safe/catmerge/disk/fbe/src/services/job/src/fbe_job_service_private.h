@@ -48,11 +48,84 @@
 #define FBE_JOB_SERVICE_PACKET_TIMEOUT  (-20 * (10000000L))
 
 
+/*! @def FBE_JOB_SERVICE_PIPELINE_MAX_SLOTS 
+ *  
+ *  @brief This is the maximum number of jobs that can be in their commit
+ *         phase at the same time while the job thread moves on to the
+ *         next job.
+ */
+#define FBE_JOB_SERVICE_PIPELINE_MAX_SLOTS  4
+
 enum fbe_job_service_gate_e{
     FBE_JOB_SERVICE_GATE_BIT     = 0x10000000,
     FBE_JOB_SERVICE_GATE_MASK    = 0x0FFFFFFF,
 };
 
+/*!*******************************************************************
+ * @struct fbe_job_service_pipeline_slot_t
+ *********************************************************************
+ * @brief
+ *  One commit slot of the job pipeline.  A slot owns everything the
+ *  commit phase of a job needs so that it can run beside the job thread:
+ *  its own packet, completion semaphore and peer message.
+ *
+ *********************************************************************/
+typedef struct fbe_job_service_pipeline_slot_s
+{
+    /*! Job being committed, NULL when the slot is free */
+    fbe_job_queue_element_t *job_queue_element_p;
+
+    /*! Objects the job works on, used to serialize conflicting jobs */
+    fbe_u32_t       lun_number;
+    fbe_object_id_t lun_object_id;
+
+    fbe_packet_t *packet_p;
+
+    /*! Wakes up the slot thread when a job is handed over */
+    fbe_semaphore_t start_semaphore;
+
+    /*! Completion of the client's commit/rollback function */
+    fbe_semaphore_t process_semaphore;
+
+    /*! Used to tell the peer the job is done */
+    fbe_job_service_cmi_message_t *cmi_message_p;
+
+    fbe_thread_t thread_handle;
+    fbe_bool_t   b_thread_started;
+    fbe_u32_t    slot_index;
+}
+fbe_job_service_pipeline_slot_t;
+
+/*!*******************************************************************
+ * @struct fbe_job_service_pipeline_t
+ *********************************************************************
+ * @brief
+ *  Lets the commit phase of independent jobs overlap with the next job.
+ *  Validation, update in memory and persist stay on the job thread since
+ *  the database only allows a single open transaction.
+ *
+ *********************************************************************/
+typedef struct fbe_job_service_pipeline_s
+{
+    fbe_bool_t b_enabled;
+    fbe_bool_t b_stop;
+
+    /*! Protected by the job service lock */
+    fbe_u32_t in_flight;
+
+    /*! Released each time a slot frees up */
+    fbe_semaphore_t slot_free_semaphore;
+
+    /*! Statistics */
+    fbe_u64_t pipelined_jobs;
+    fbe_u64_t serialized_jobs;
+    fbe_u64_t conflict_waits;
+    fbe_u64_t barrier_drains;
+
+    fbe_job_service_pipeline_slot_t slots[FBE_JOB_SERVICE_PIPELINE_MAX_SLOTS];
+}
+fbe_job_service_pipeline_t;
+
 /*!*******************************************************************
  * @struct fbe_job_service_t
  *********************************************************************
@@ -120,6 +193,9 @@ typedef struct fbe_job_service_s
 
     /*! helps us execute some logic when peer is dead */
     fbe_cmi_sp_state_t  sp_state_for_peer_lost_handle;     
+
+    /*! commit phases running beside the job thread */
+    fbe_job_service_pipeline_t pipeline;
 }
 fbe_job_service_t;
 
@@ -165,6 +241,13 @@ extern fbe_status_t fbe_job_service_get_number_of_elements_in_recovery_queue(fbe
 extern fbe_status_t fbe_job_service_get_number_of_elements_in_creation_queue(fbe_packet_t * packet_p);
 extern void fbe_job_service_process_recovery_queue(void);
 extern void fbe_job_service_process_creation_queue(void);
+extern void fbe_job_service_process_queue_element(fbe_job_queue_element_t * job_queue_element_p,
+                                                  fbe_packet_t *packet_p,
+                                                  fbe_semaphore_t *process_semaphore_p,
+                                                  fbe_bool_t b_stop_at_commit);
+extern void fbe_job_service_complete_creation_job(fbe_job_queue_element_t *job_queue_element_p,
+                                                  fbe_job_service_cmi_message_t *cmi_message_p,
+                                                  fbe_packet_t *packet_p);
 extern fbe_status_t fbe_job_service_enqueue_job_request(fbe_packet_t * packet_p);
 extern fbe_status_t fbe_job_service_add_element_to_recovery_queue(fbe_job_queue_element_t *job_element_p);
 extern fbe_status_t fbe_job_service_add_element_to_creation_queue(fbe_job_queue_element_t *job_element_p);
@@ -247,6 +330,17 @@ extern fbe_status_t fbe_job_service_hook_get_debug_hook(fbe_packet_t *packet_p);
 extern fbe_status_t fbe_job_service_hook_remove_debug_hook(fbe_packet_t *packet_p);
 extern fbe_status_t fbe_job_service_hook_check_hook_and_take_action(fbe_job_queue_element_t *job_queue_element_p,
                                                                     fbe_bool_t b_state_start);
+extern fbe_bool_t fbe_job_service_hook_is_any_hook_set(void);
+
+/* fbe_job_service_pipeline.c
+*/
+extern fbe_status_t fbe_job_service_pipeline_init(void);
+extern void fbe_job_service_pipeline_destroy(void);
+extern fbe_bool_t fbe_job_service_pipeline_prepare_job(fbe_job_queue_element_t *job_queue_element_p);
+extern void fbe_job_service_pipeline_start_commit(fbe_job_queue_element_t *job_queue_element_p);
+extern void fbe_job_service_pipeline_drain(void);
+extern fbe_status_t fbe_job_service_pipeline_set_mode(fbe_packet_t *packet_p);
+extern fbe_status_t fbe_job_service_pipeline_get_info(fbe_packet_t *packet_p);
 
 /************************************
  * end file fbe_job_service_private.h
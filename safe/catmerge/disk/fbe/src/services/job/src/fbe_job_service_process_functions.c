@@ -90,17 +90,16 @@ static fbe_job_service_operation_t* job_service_operation_list[] =
  *   FUNCTION DEFINITIONS
  *************************/
 
-static fbe_bool_t fbe_job_service_process_validation_function(fbe_job_queue_element_t *);
-static fbe_bool_t fbe_job_service_process_selection_function(fbe_job_queue_element_t * );
-static fbe_bool_t fbe_job_service_process_update_in_memory_function(fbe_job_queue_element_t *);
-static fbe_bool_t fbe_job_service_process_rollback_function(fbe_job_queue_element_t *);
-static fbe_bool_t fbe_job_service_process_persist_function(fbe_job_queue_element_t *);
-static fbe_bool_t fbe_job_service_process_commit_function(fbe_job_queue_element_t *);
+static fbe_bool_t fbe_job_service_process_validation_function(fbe_job_queue_element_t *, fbe_packet_t *, fbe_semaphore_t *);
+static fbe_bool_t fbe_job_service_process_selection_function(fbe_job_queue_element_t *, fbe_packet_t *, fbe_semaphore_t *);
+static fbe_bool_t fbe_job_service_process_update_in_memory_function(fbe_job_queue_element_t *, fbe_packet_t *, fbe_semaphore_t *);
+static fbe_bool_t fbe_job_service_process_rollback_function(fbe_job_queue_element_t *, fbe_packet_t *, fbe_semaphore_t *);
+static fbe_bool_t fbe_job_service_process_persist_function(fbe_job_queue_element_t *, fbe_packet_t *, fbe_semaphore_t *);
+static fbe_bool_t fbe_job_service_process_commit_function(fbe_job_queue_element_t *, fbe_packet_t *, fbe_semaphore_t *);
 static void fbe_job_service_set_element_timestamp(fbe_job_queue_element_t *job_queue_element_p,
         fbe_time_t timestamp);
 static fbe_status_t fbe_job_service_packet_completion(fbe_packet_t * packet, 
         fbe_packet_completion_context_t context);
-static void fbe_job_service_process_queue_element(fbe_job_queue_element_t * job_queue_element_p);
 static fbe_job_action_state_t fbe_job_service_get_next_function_state(fbe_job_action_state_t current_state);
 static void fbe_job_service_set_state(fbe_job_action_state_t *previous_state, fbe_job_action_state_t *current_state,
         fbe_job_action_state_t set_state);
@@ -115,6 +114,10 @@ fbe_status_t fbe_job_service_translate_function_name(fbe_job_action_state_t stat
  * processing of Job service client's functions
  *
  * @param fbe_job_queue_element_t - entry of queue          
+ * @param packet_p - packet used to call the client's functions
+ * @param process_semaphore_p - semaphore the client's completion releases
+ * @param b_stop_at_commit - FBE_TRUE to return once the job reaches its
+ *                           commit phase so the pipeline can commit it
  *
  * @return - none
  *
@@ -124,7 +127,10 @@ fbe_status_t fbe_job_service_translate_function_name(fbe_job_action_state_t stat
  ****************************************************************/
 
 void fbe_job_service_process_queue_element( 
-        fbe_job_queue_element_t * job_queue_element_p) 
+        fbe_job_queue_element_t * job_queue_element_p,
+        fbe_packet_t *packet_p,
+        fbe_semaphore_t *process_semaphore_p,
+        fbe_bool_t b_stop_at_commit) 
 { 
     fbe_payload_ex_t                      *sep_payload_p = NULL;
     fbe_payload_control_operation_t        *control_operation = NULL;
@@ -139,7 +145,7 @@ void fbe_job_service_process_queue_element(
     timeout.QuadPart = FBE_JOB_SERVICE_PACKET_TIMEOUT; 
     p_timeout = &timeout; 
 
-    sep_payload_p = fbe_transport_get_payload_ex (fbe_job_service.job_packet_p);
+    sep_payload_p = fbe_transport_get_payload_ex (packet_p);
     control_operation = fbe_payload_ex_allocate_control_operation(sep_payload_p);
 
     fbe_payload_control_build_operation (control_operation,
@@ -148,11 +154,19 @@ void fbe_job_service_process_queue_element(
                                          sizeof(fbe_job_queue_element_t));
 
     /* Mark packet with the attribute, either travvalidation_functionerse or not */
-    fbe_transport_set_packet_attr(fbe_job_service.job_packet_p, FBE_PACKET_FLAG_NO_ATTRIB);
+    fbe_transport_set_packet_attr(packet_p, FBE_PACKET_FLAG_NO_ATTRIB);
     fbe_payload_ex_increment_control_operation_level(sep_payload_p);
  
     while(job_queue_element_p->current_state != FBE_JOB_ACTION_STATE_DONE) 
     { 
+        /* the commit of a pipelined job runs in a commit slot */
+        if (b_stop_at_commit &&
+            (job_queue_element_p->current_state == FBE_JOB_ACTION_STATE_COMMIT))
+        {
+            fbe_payload_ex_release_control_operation(sep_payload_p, control_operation);
+            return;
+        }
+
         /* we need to determine if a call to a function was actually job_queue_element_p made so that we set 
          * a timer for it, otherwise we transition to next function, function_called will 
          * indicate if the call to a client's function has been made 
@@ -164,19 +178,19 @@ void fbe_job_service_process_queue_element(
         switch(job_queue_element_p->current_state) 
         { 
             case FBE_JOB_ACTION_STATE_VALIDATE: 
-                function_called = fbe_job_service_process_validation_function(job_queue_element_p); 
+                function_called = fbe_job_service_process_validation_function(job_queue_element_p, packet_p, process_semaphore_p); 
                 break; 
 
             case FBE_JOB_ACTION_STATE_SELECTION: 
-                function_called = fbe_job_service_process_selection_function(job_queue_element_p); 
+                function_called = fbe_job_service_process_selection_function(job_queue_element_p, packet_p, process_semaphore_p); 
                 break; 
 
             case FBE_JOB_ACTION_STATE_UPDATE_IN_MEMORY: 
-                function_called = fbe_job_service_process_update_in_memory_function(job_queue_element_p); 
+                function_called = fbe_job_service_process_update_in_memory_function(job_queue_element_p, packet_p, process_semaphore_p); 
                 break; 
 
             case FBE_JOB_ACTION_STATE_PERSIST:
-                function_called = fbe_job_service_process_persist_function(job_queue_element_p); 
+                function_called = fbe_job_service_process_persist_function(job_queue_element_p, packet_p, process_semaphore_p); 
                 break; 
 
             case FBE_JOB_ACTION_STATE_ROLLBACK: 
@@ -185,11 +199,11 @@ void fbe_job_service_process_queue_element(
                  * 
                  * NOTE: A Job Service client must always register a rollback function 
                  */ 
-                function_called = fbe_job_service_process_rollback_function(job_queue_element_p);
+                function_called = fbe_job_service_process_rollback_function(job_queue_element_p, packet_p, process_semaphore_p);
                 break; 
 
             case FBE_JOB_ACTION_STATE_COMMIT: 
-                function_called = fbe_job_service_process_commit_function(job_queue_element_p);
+                function_called = fbe_job_service_process_commit_function(job_queue_element_p, packet_p, process_semaphore_p);
                 break; 
 
             default: 
@@ -213,7 +227,7 @@ void fbe_job_service_process_queue_element(
         { 
             /* if we are here, we called a client's function, wait on the reply 
             */ 
-            while ((sem_status = fbe_semaphore_wait(&fbe_job_service.job_control_process_semaphore, 
+            while ((sem_status = fbe_semaphore_wait(process_semaphore_p, 
                             p_timeout)) != EMCPAL_STATUS_SUCCESS) 
             { 
                 if (sem_status == EMCPAL_STATUS_TIMEOUT) 
@@ -221,12 +235,12 @@ void fbe_job_service_process_queue_element(
                     /* we need to cancel the packet, and wait until we are 
                      * completed on the cancellation 
                      */ 
-                    fbe_transport_cancel_packet(fbe_job_service.job_packet_p); 
+                    fbe_transport_cancel_packet(packet_p); 
                     p_timeout = NULL; 
                 } 
             } 
 
-            status = fbe_transport_get_status_code(fbe_job_service.job_packet_p); 
+            status = fbe_transport_get_status_code(packet_p); 
 #if 0 
             if (status == FBE_STATUS_CANCELED) 
             { 
@@ -240,7 +254,7 @@ void fbe_job_service_process_queue_element(
              */ 
 #endif 
 
-            sep_payload_p = fbe_transport_get_payload_ex (fbe_job_service.job_packet_p);
+            sep_payload_p = fbe_transport_get_payload_ex (packet_p);
             control_operation = fbe_payload_ex_get_control_operation(sep_payload_p);
             fbe_payload_control_get_status(control_operation, &payload_status);
 
@@ -390,7 +404,10 @@ void fbe_job_service_process_recovery_queue(void)
         job_queue_element_p->current_state = FBE_JOB_ACTION_STATE_VALIDATE;
     }
 
-    fbe_job_service_process_queue_element(job_queue_element_p);
+    fbe_job_service_process_queue_element(job_queue_element_p,
+                                          fbe_job_service.job_packet_p,
+                                          &fbe_job_service.job_control_process_semaphore,
+                                          FBE_FALSE);
 
     job_service_trace(FBE_TRACE_LEVEL_INFO, 
         FBE_TRACE_MESSAGE_ID_FUNCTION_ENTRY,
@@ -482,6 +499,7 @@ void fbe_job_service_process_creation_queue(void)
 {
     fbe_job_queue_element_t  *job_queue_element_p = NULL;
     const char               *p_job_type_str = NULL;
+    fbe_bool_t               b_pipelined = FBE_FALSE;
 
     job_service_trace(FBE_TRACE_LEVEL_INFO, 
         FBE_TRACE_MESSAGE_ID_FUNCTION_ENTRY,
@@ -533,8 +551,53 @@ void fbe_job_service_process_creation_queue(void)
     }
 
 
-    fbe_job_service_process_queue_element(job_queue_element_p);
+    /* Jobs that can overlap with the next job stop at their commit phase
+     * and are handed over to a commit slot.
+     */
+    b_pipelined = fbe_job_service_pipeline_prepare_job(job_queue_element_p);
+
+    fbe_job_service_process_queue_element(job_queue_element_p,
+                                          fbe_job_service.job_packet_p,
+                                          &fbe_job_service.job_control_process_semaphore,
+                                          b_pipelined);
+
+    if (b_pipelined &&
+        (job_queue_element_p->current_state == FBE_JOB_ACTION_STATE_COMMIT))
+    {
+        fbe_transport_reuse_packet(fbe_job_service.job_packet_p);
+        fbe_job_service_pipeline_start_commit(job_queue_element_p);
+        return;
+    }
+
+    fbe_job_service_complete_creation_job(job_queue_element_p,
+                                          fbe_job_service.job_service_cmi_message_exec_p,
+                                          fbe_job_service.job_packet_p);
+    return;
+}
+/*****************************************************
+ * end fbe_job_service_process_creation_queue()
+ *****************************************************/
+
+/*!**************************************************************
+ * fbe_job_service_complete_creation_job()
+ ****************************************************************
+ * @brief
+ * Tells the peer a creation queue job is finished and releases
+ * the job element.  Runs on the job thread, or on the commit slot
+ * that committed the job.
+ *
+ * @param job_queue_element_p - finished job
+ * @param cmi_message_p - peer message owned by the caller's thread
+ * @param packet_p - packet the job ran with
+ *
+ * @return - none
+ *
+ ****************************************************************/
 
+void fbe_job_service_complete_creation_job(fbe_job_queue_element_t *job_queue_element_p,
+                                           fbe_job_service_cmi_message_t *cmi_message_p,
+                                           fbe_packet_t *packet_p)
+{
     job_service_trace(FBE_TRACE_LEVEL_INFO, 
             FBE_TRACE_MESSAGE_ID_FUNCTION_ENTRY,
             "   completed processing for job number 0x%llx \n",
@@ -564,20 +627,20 @@ void fbe_job_service_process_creation_queue(void)
                 job_queue_element_p->status);
     }
 
-    fbe_job_service.job_service_cmi_message_exec_p->job_number = job_queue_element_p->job_number;
-    fbe_job_service.job_service_cmi_message_exec_p->status = job_queue_element_p->status;
-    fbe_job_service.job_service_cmi_message_exec_p->error_code = job_queue_element_p->error_code;
-    fbe_job_service.job_service_cmi_message_exec_p->object_id = job_queue_element_p->object_id;
-    fbe_job_service.job_service_cmi_message_exec_p->class_id = job_queue_element_p->class_id;
-    fbe_job_service.job_service_cmi_message_exec_p->queue_type = FBE_JOB_CREATION_QUEUE;
-    fbe_job_service.job_service_cmi_message_exec_p->msg.job_service_queue_element.job_element.job_type = job_queue_element_p->job_type;
-    fbe_job_service.job_service_cmi_message_exec_p->msg.job_service_queue_element.job_element.object_id = job_queue_element_p->object_id;
+    cmi_message_p->job_number = job_queue_element_p->job_number;
+    cmi_message_p->status = job_queue_element_p->status;
+    cmi_message_p->error_code = job_queue_element_p->error_code;
+    cmi_message_p->object_id = job_queue_element_p->object_id;
+    cmi_message_p->class_id = job_queue_element_p->class_id;
+    cmi_message_p->queue_type = FBE_JOB_CREATION_QUEUE;
+    cmi_message_p->msg.job_service_queue_element.job_element.job_type = job_queue_element_p->job_type;
+    cmi_message_p->msg.job_service_queue_element.job_element.object_id = job_queue_element_p->object_id;
 
-    fbe_job_service.job_service_cmi_message_exec_p->job_service_cmi_message_type = 
+    cmi_message_p->job_service_cmi_message_type = 
         FBE_JOB_CONTROL_SERVICE_CMI_MESSAGE_TYPE_REMOVE_FROM_CREATION_QUEUE;
 
     /* now send message to peer SP */	
-    fbe_job_service_cmi_send_message(fbe_job_service.job_service_cmi_message_exec_p, NULL);
+    fbe_job_service_cmi_send_message(cmi_message_p, NULL);
 
     if ((job_queue_element_p->local_job_data_valid == FBE_TRUE) &&
         (job_queue_element_p->additional_job_data != NULL))
@@ -593,11 +656,11 @@ void fbe_job_service_process_creation_queue(void)
 
     /*! reuse packet
     */
-    fbe_transport_reuse_packet(fbe_job_service.job_packet_p);
+    fbe_transport_reuse_packet(packet_p);
     return;
 }
 /*****************************************************
- * end fbe_job_service_process_creation_queue()
+ * end fbe_job_service_complete_creation_job()
  *****************************************************/
 
 /*!**************************************************************
@@ -608,6 +671,8 @@ void fbe_job_service_process_creation_queue(void)
  * selection function
  *
  * @param job_queue_element_p - entry of recovery queue          
+ * @param packet_p - packet used to call the client's function
+ * @param process_semaphore_p - released when the client completes the packet
  *
  * @return fbe_bool_t - TRUE if call was made to client's function
  *                      FALSE otherwise
@@ -618,7 +683,9 @@ void fbe_job_service_process_creation_queue(void)
  ****************************************************************/
 
 fbe_bool_t fbe_job_service_process_validation_function(
-        fbe_job_queue_element_t * job_queue_element_p)
+        fbe_job_queue_element_t * job_queue_element_p,
+        fbe_packet_t *packet_p,
+        fbe_semaphore_t *process_semaphore_p)
 {
     fbe_job_service_operation_t *job_service_operation_p = NULL;
     fbe_job_command_data_t      *command_data_p = NULL;
@@ -643,16 +710,16 @@ fbe_bool_t fbe_job_service_process_validation_function(
         /* we need to set the completion functivalidation_functionon only for function calls
          * that were registered with the job service
          */
-        fbe_transport_set_completion_function (fbe_job_service.job_packet_p,
+        fbe_transport_set_completion_function (packet_p,
                 fbe_job_service_packet_validation_completion_function,
-                &fbe_job_service.job_control_process_semaphore);    
+                process_semaphore_p);    
 
         /* when we start processing of an element, we set the timestamp
         */
         fbe_job_service_set_element_timestamp(job_queue_element_p, fbe_get_time());
 
         function_called = TRUE;
-        job_service_operation_p->action.validation_function(fbe_job_service.job_packet_p);
+        job_service_operation_p->action.validation_function(packet_p);
     }
 
     return function_called;
@@ -669,6 +736,8 @@ fbe_bool_t fbe_job_service_process_validation_function(
  * selection function
  *
  * @param job_queue_element_p - entry of recovery queue          
+ * @param packet_p - packet used to call the client's function
+ * @param process_semaphore_p - released when the client completes the packet
  *
  * @return fbe_bool_t - TRUE if call was made to client's function
  *                      FALSE otherwise
@@ -679,7 +748,9 @@ fbe_bool_t fbe_job_service_process_validation_function(
  ****************************************************************/
 
 fbe_bool_t fbe_job_service_process_selection_function(
-        fbe_job_queue_element_t * job_queue_element_p)
+        fbe_job_queue_element_t * job_queue_element_p,
+        fbe_packet_t *packet_p,
+        fbe_semaphore_t *process_semaphore_p)
 {
     fbe_job_service_operation_t *job_service_operation_p = NULL;
     fbe_job_command_data_t      *command_data_p = NULL;
@@ -694,16 +765,16 @@ fbe_bool_t fbe_job_service_process_selection_function(
         */
         command_data_p = (void *)job_queue_element_p->command_data;
 
-        fbe_transport_set_completion_function (fbe_job_service.job_packet_p,
+        fbe_transport_set_completion_function (packet_p,
                 fbe_job_service_packet_selection_completion_function,
-                &fbe_job_service.job_control_process_semaphore);  
+                process_semaphore_p);  
 
         /* when we start processing of an element, we set the timestamp
         */
         fbe_job_service_set_element_timestamp(job_queue_element_p, fbe_get_time());
 
         function_called = TRUE;
-        job_service_operation_p->action.selection_function(fbe_job_service.job_packet_p);
+        job_service_operation_p->action.selection_function(packet_p);
     }
 
     return function_called;
@@ -720,6 +791,8 @@ fbe_bool_t fbe_job_service_process_selection_function(
  * update_in_memory function
  *
  * @param job_queue_element_p  - entry of recovery queue          
+ * @param packet_p - packet used to call the client's function
+ * @param process_semaphore_p - released when the client completes the packet
  *
  * @return fbe_bool_t - TRUE if call was made to client's function
  *                      FALSE otherwise
@@ -730,7 +803,9 @@ fbe_bool_t fbe_job_service_process_selection_function(
  ****************************************************************/
 
 fbe_bool_t fbe_job_service_process_update_in_memory_function(
-        fbe_job_queue_element_t * job_queue_element_p)
+        fbe_job_queue_element_t * job_queue_element_p,
+        fbe_packet_t *packet_p,
+        fbe_semaphore_t *process_semaphore_p)
 {
     fbe_job_command_data_t      *command_data_p = NULL;
     fbe_job_service_operation_t *job_service_operation_p = NULL;
@@ -744,16 +819,16 @@ fbe_bool_t fbe_job_service_process_update_in_memory_function(
         /* get the client's data 
         */
         command_data_p = (void *)job_queue_element_p->command_data;
-        fbe_transport_set_completion_function (fbe_job_service.job_packet_p,
+        fbe_transport_set_completion_function (packet_p,
                 fbe_job_service_packet_update_in_memory_completion_function,
-                &fbe_job_service.job_control_process_semaphore);   
+                process_semaphore_p);   
 
         /* when we start processing of an element, we set the timestamp
         */
         fbe_job_service_set_element_timestamp(job_queue_element_p, fbe_get_time());
 
         function_called = FALSE;
-        job_service_operation_p->action.update_in_memory_function(fbe_job_service.job_packet_p);
+        job_service_operation_p->action.update_in_memory_function(packet_p);
         function_called = TRUE;
     }
     return function_called;
@@ -770,6 +845,8 @@ fbe_bool_t fbe_job_service_process_update_in_memory_function(
  * persist function
  *
  * @param job_queue_element_p - entry of recovery queue          
+ * @param packet_p - packet used to call the client's function
+ * @param process_semaphore_p - released when the client completes the packet
  *
  * @return fbe_bool_t - TRUE if call was made to client's function
  *                      FALSE otherwise
@@ -780,7 +857,9 @@ fbe_bool_t fbe_job_service_process_update_in_memory_function(
  ****************************************************************/
 
 fbe_bool_t fbe_job_service_process_persist_function(
-        fbe_job_queue_element_t * job_queue_element_p)
+        fbe_job_queue_element_t * job_queue_element_p,
+        fbe_packet_t *packet_p,
+        fbe_semaphore_t *process_semaphore_p)
 {
     fbe_job_service_operation_t *job_service_operation_p = NULL;
     fbe_job_command_data_t      *command_data_p = NULL;
@@ -794,16 +873,16 @@ fbe_bool_t fbe_job_service_process_persist_function(
         /* get the client's data 
         */
         command_data_p = (void *)job_queue_element_p->command_data;
-        fbe_transport_set_completion_function (fbe_job_service.job_packet_p,
+        fbe_transport_set_completion_function (packet_p,
                 fbe_job_service_packet_persist_completion_function,
-                &fbe_job_service.job_control_process_semaphore);    
+                process_semaphore_p);    
 
         /* when we start processing of an element, we set the timestamp
         */
         fbe_job_service_set_element_timestamp(job_queue_element_p, fbe_get_time());
 
         function_called = TRUE;
-        job_service_operation_p->action.persist_function(fbe_job_service.job_packet_p);
+        job_service_operation_p->action.persist_function(packet_p);
     }
     return function_called;
 }
@@ -819,6 +898,8 @@ fbe_bool_t fbe_job_service_process_persist_function(
  * rollback function
  *
  * @param job_queue_element_p  - entry of recovery queue          
+ * @param packet_p - packet used to call the client's function
+ * @param process_semaphore_p - released when the client completes the packet
  *
  * @return fbe_bool_t - TRUE if call was made to client's function
  *                      FALSE otherwise
@@ -829,7 +910,9 @@ fbe_bool_t fbe_job_service_process_persist_function(
  ****************************************************************/
 
 fbe_bool_t fbe_job_service_process_rollback_function(
-        fbe_job_queue_element_t * job_queue_element_p)
+        fbe_job_queue_element_t * job_queue_element_p,
+        fbe_packet_t *packet_p,
+        fbe_semaphore_t *process_semaphore_p)
 {
     fbe_job_service_operation_t *job_service_operation_p = NULL;
     fbe_job_command_data_t      *command_data_p = NULL;
@@ -843,16 +926,16 @@ fbe_bool_t fbe_job_service_process_rollback_function(
         /* get the client's data 
         */
         command_data_p = (void *)job_queue_element_p->command_data;
-        fbe_transport_set_completion_function (fbe_job_service.job_packet_p,
+        fbe_transport_set_completion_function (packet_p,
                 fbe_job_service_packet_rollback_completion_function,
-                &fbe_job_service.job_control_process_semaphore);  
+                process_semaphore_p);  
 
         /* when we start processing of an element, we set the timestamp
         */
         fbe_job_service_set_element_timestamp(job_queue_element_p, fbe_get_time());
 
         function_called = TRUE;
-        job_service_operation_p->action.rollback_function(fbe_job_service.job_packet_p);
+        job_service_operation_p->action.rollback_function(packet_p);
     }
     else
     {
@@ -875,6 +958,8 @@ fbe_bool_t fbe_job_service_process_rollback_function(
  * commit function
  *
  * @param job_queue_element_p - entry of recovery queue          
+ * @param packet_p - packet used to call the client's function
+ * @param process_semaphore_p - released when the client completes the packet
  *
  * @return fbe_bool_t - TRUE if call was made to client's function
  *                      FALSE otherwise
@@ -885,7 +970,9 @@ fbe_bool_t fbe_job_service_process_rollback_function(
  ****************************************************************/
 
 fbe_bool_t fbe_job_service_process_commit_function(
-        fbe_job_queue_element_t * job_queue_element_p)
+        fbe_job_queue_element_t * job_queue_element_p,
+        fbe_packet_t *packet_p,
+        fbe_semaphore_t *process_semaphore_p)
 {
     fbe_job_service_operation_t *job_service_operation_p = NULL;
     fbe_job_command_data_t      *command_data_p = NULL;
@@ -899,16 +986,16 @@ fbe_bool_t fbe_job_service_process_commit_function(
         /* get the client's data 
         */
         command_data_p = (void *)job_queue_element_p->command_data;
-        fbe_transport_set_completion_function (fbe_job_service.job_packet_p,
+        fbe_transport_set_completion_function (packet_p,
                 fbe_job_service_packet_commit_completion_function,
-                &fbe_job_service.job_control_process_semaphore);  
+                process_semaphore_p);  
 
         /* when we start processing of an element, we set the timestamp
         */
         fbe_job_service_set_element_timestamp(job_queue_element_p, fbe_get_time());
 
         function_called = TRUE;
-        job_service_operation_p->action.commit_function(fbe_job_service.job_packet_p);
+        job_service_operation_p->action.commit_function(packet_p);
     }
     else
     {
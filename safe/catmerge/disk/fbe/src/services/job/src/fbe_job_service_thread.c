@@ -187,6 +187,8 @@ void job_service_thread_func(void * context)
             while ((!fbe_queue_is_empty(&fbe_job_service.recovery_q_head))  &&
                     (fbe_job_service_get_recovery_queue_access() == FBE_TRUE))
             {
+                /* recovery jobs never overlap with pipelined creation jobs */
+                fbe_job_service_pipeline_drain();
                 fbe_job_service_process_recovery_queue();
             }
 
@@ -200,6 +202,9 @@ void job_service_thread_func(void * context)
         }
     }
 
+    /* let the jobs that are still committing finish before we say we are done */
+    fbe_job_service_pipeline_drain();
+
     fbe_job_service_thread_set_flag(FBE_JOB_SERVICE_THREAD_FLAGS_DONE); 
     fbe_thread_exit(EMCPAL_STATUS_SUCCESS);
 }
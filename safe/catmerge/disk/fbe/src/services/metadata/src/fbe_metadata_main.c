@@ -757,6 +757,7 @@ fbe_metadata_element_init_stripe_lock_queue(fbe_metadata_element_t* metadata_ele
 	metadata_element_p->local_collision_count = 0;
 	metadata_element_p->peer_collision_count = 0;
 	metadata_element_p->cmi_message_count = 0;
+	metadata_element_p->nonpaged_write_count = 0;
 
     return FBE_STATUS_OK;
 }
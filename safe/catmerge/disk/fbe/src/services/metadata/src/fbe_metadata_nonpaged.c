@@ -302,6 +302,7 @@ fbe_metadata_nonpaged_operation_write(fbe_packet_t * packet)
                     metadata_operation->u.metadata.record_data_size);
 
 	fbe_spinlock_unlock(&metadata_element->metadata_element_lock);
+    fbe_atomic_increment(&metadata_element->nonpaged_write_count);
 
 
 	if(!fbe_metadata_is_peer_object_alive(metadata_element) && fbe_metadata_element_is_active(metadata_element)){
@@ -415,6 +416,7 @@ fbe_metadata_nonpaged_operation_write_allocation_completion(fbe_memory_request_t
 		return FBE_STATUS_OK;
 	}
 
+    fbe_atomic_increment(&metadata_element->cmi_message_count);
     fbe_metadata_cmi_send_message(metadata_cmi_message, packet);
 
     return FBE_STATUS_OK;
@@ -574,6 +576,7 @@ fbe_metadata_nonpaged_operation_post_persist_allocation_completion(fbe_memory_re
 		return FBE_STATUS_OK;
 	}
 
+    fbe_atomic_increment(&metadata_element->cmi_message_count);
     fbe_metadata_cmi_send_message(metadata_cmi_message, packet);
 
     return FBE_STATUS_OK;
@@ -680,6 +683,7 @@ fbe_metadata_nonpaged_operation_change_bits(fbe_packet_t * packet)
         data_ptr += metadata_operation->u.metadata.record_data_size;
     }
 	fbe_spinlock_unlock(&metadata_element->metadata_element_lock);
+    fbe_atomic_increment(&metadata_element->nonpaged_write_count);
 
 	if(!fbe_metadata_is_peer_object_alive(metadata_element)){
         fbe_payload_metadata_set_status(metadata_operation, FBE_PAYLOAD_METADATA_STATUS_OK);
@@ -801,6 +805,7 @@ fbe_metadata_nonpaged_operation_change_bits_allocation_completion(fbe_memory_req
 	}
 
 
+    fbe_atomic_increment(&metadata_element->cmi_message_count);
     fbe_metadata_cmi_send_message(metadata_cmi_message, packet);
 
     return FBE_STATUS_OK;
@@ -2979,6 +2984,7 @@ fbe_metadata_nonpaged_operation_change_checkpoint(fbe_packet_t * packet)
 		}
 	}
 	fbe_spinlock_unlock(&metadata_element->metadata_element_lock);
+    fbe_atomic_increment(&metadata_element->nonpaged_write_count);
 
     /* We do not update the peer for certain opcodes.
      */
@@ -3102,6 +3108,7 @@ fbe_metadata_nonpaged_operation_change_checkpoint_allocation_completion(fbe_memo
 		return FBE_STATUS_OK;
 	}
 
+    fbe_atomic_increment(&metadata_element->cmi_message_count);
     fbe_metadata_cmi_send_message(metadata_cmi_message, packet);
 
     return FBE_STATUS_OK;
@@ -13,6 +13,7 @@ static fbe_status_t fbe_persist_get_required_lun_size(fbe_packet_t * packet);
 static fbe_status_t persist_perform_hook(fbe_packet_t * packet);
 static fbe_status_t persist_get_entry_info(fbe_packet_t * packet);
 static fbe_status_t persist_validate_entry(fbe_packet_t * packet);
+static fbe_status_t persist_get_stats(fbe_packet_t * packet);
 
 
 static fbe_status_t
@@ -852,8 +853,6 @@ persist_write_single_entry(fbe_packet_t * packet)
     fbe_u32_t control_write_length;
     fbe_sg_element_t * sg_element;
     fbe_u32_t sg_element_count;
-    fbe_status_t status;
-	fbe_persist_transaction_handle_t tran_handle;
 
     if (fbe_persist_service.database_lun_object_id == FBE_OBJECT_ID_INVALID) {
         fbe_persist_trace(FBE_TRACE_LEVEL_WARNING,
@@ -937,39 +936,8 @@ persist_write_single_entry(fbe_packet_t * packet)
         return FBE_STATUS_GENERIC_FAILURE;
     }
 
-	/*let's first open a transaction*/
-	status = fbe_persist_transaction_start(packet, &tran_handle);
-	if (status != FBE_STATUS_OK) {
-		fbe_persist_trace(FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
-                          "%s can't open transaction, status:%d \n", __FUNCTION__, status);
-
-		if (status == FBE_STATUS_BUSY) {
-			fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_BUSY);
-		}else{
-			fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
-		}
-
-		fbe_transport_set_status(packet, status, 0);
-		fbe_transport_complete_packet(packet);
-		return status;
-	}
-
-    status = fbe_persist_transaction_write_entry(tran_handle,
-												 control_write->target_sector,
-                                                 &control_write->entry_id,
-                                                 sg_element->address,
-                                                 sg_element->count,
-												 FBE_FALSE);
-    if (status != FBE_STATUS_OK) {
-		fbe_persist_transaction_abort(tran_handle);
-        fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
-        fbe_transport_set_status(packet, FBE_STATUS_GENERIC_FAILURE, 0);
-        fbe_transport_complete_packet(packet);
-        return FBE_STATUS_GENERIC_FAILURE;
-    }
-
-	/*now let's commit it*/
-	return fbe_persist_transaction_commit(packet, tran_handle);
+	/*the transaction service opens the transaction, merges us with any other single entry requests waiting for it and commits*/
+	return fbe_persist_transaction_queue_single_entry(packet);
 }
 
 
@@ -982,9 +950,6 @@ persist_modify_single_entry(fbe_packet_t * packet)
     fbe_u32_t 									control_write_length;
     fbe_sg_element_t * 							sg_element;
     fbe_u32_t 									sg_element_count;
-    fbe_status_t 								status;
-	fbe_bool_t 									entry_deleted = FBE_FALSE;
-	fbe_persist_transaction_handle_t 			tran_handle;
 
     if (fbe_persist_service.database_lun_object_id == FBE_OBJECT_ID_INVALID) {
         fbe_persist_trace(FBE_TRACE_LEVEL_WARNING,
@@ -1068,49 +1033,9 @@ persist_modify_single_entry(fbe_packet_t * packet)
         return FBE_STATUS_GENERIC_FAILURE;
     }
 
-	/*any chance the user already deleted this entry ?*/
-	status = fbe_persist_transaction_is_entry_deleted(control_modify->entry_id, &entry_deleted);
-	if ((status != FBE_STATUS_OK) || (FBE_IS_TRUE(entry_deleted))) {
-		 fbe_persist_trace(FBE_TRACE_LEVEL_WARNING, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
-                          "%s entry already marked for deletion: id: %lld\n" ,__FUNCTION__, (long long)control_modify->entry_id);
-        fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
-        fbe_transport_set_status(packet, FBE_STATUS_GENERIC_FAILURE, 0);
-        fbe_transport_complete_packet(packet);
-        return FBE_STATUS_GENERIC_FAILURE;
-
-	}
-
-	/*let's first open a transaction*/
-	status = fbe_persist_transaction_start(packet, &tran_handle);
-	if (status != FBE_STATUS_OK) {
-		fbe_persist_trace(FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
-                          "%s can't open transaction, status:%d \n", __FUNCTION__, status);
-
-		if (status == FBE_STATUS_BUSY) {
-			fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_BUSY);
-		}else{
-			fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
-		}
-
-		fbe_transport_set_status(packet, status, 0);
-		fbe_transport_complete_packet(packet);
-		return status;
-	}
-
-    status = fbe_persist_transaction_modify_entry(tran_handle,
-                                                 control_modify->entry_id,
-                                                 sg_element->address,
-                                                 sg_element->count);
-    if (status != FBE_STATUS_OK) {
-		fbe_persist_transaction_abort(tran_handle);
-        fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
-        fbe_transport_set_status(packet, FBE_STATUS_GENERIC_FAILURE, 0);
-        fbe_transport_complete_packet(packet);
-        return FBE_STATUS_GENERIC_FAILURE;
-    }
-
-    /*now let's commit it*/
-	return fbe_persist_transaction_commit(packet, tran_handle);
+	/*the transaction service opens the transaction, merges us with any other single entry requests waiting for it and commits.
+	  It also checks if an earlier request in the same transaction already deleted this entry*/
+	return fbe_persist_transaction_queue_single_entry(packet);
 }
 
 static fbe_status_t
@@ -1120,8 +1045,6 @@ persist_delete_single_entry(fbe_packet_t * packet)
     fbe_payload_control_operation_t * control_operation;
     fbe_persist_control_delete_single_entry_t * control_delete;
     fbe_u32_t control_delete_length;
-    fbe_status_t status;
-	fbe_persist_transaction_handle_t 			tran_handle;
 
     if (fbe_persist_service.database_lun_object_id == FBE_OBJECT_ID_INVALID) {
         fbe_persist_trace(FBE_TRACE_LEVEL_WARNING,
@@ -1178,35 +1101,8 @@ persist_delete_single_entry(fbe_packet_t * packet)
     }
 
 
-	/*let's first open a transaction*/
-	status = fbe_persist_transaction_start(packet, &tran_handle);
-	if (status != FBE_STATUS_OK) {
-		fbe_persist_trace(FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
-                          "%s can't open transaction, status:%d \n", __FUNCTION__, status);
-
-		if (status == FBE_STATUS_BUSY) {
-			fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_BUSY);
-		}else{
-			fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
-		}
-
-		fbe_transport_set_status(packet, status, 0);
-		fbe_transport_complete_packet(packet);
-		return status;
-	}
-
-    status = fbe_persist_transaction_delete_entry(tran_handle, control_delete->entry_id);
-    if (status != FBE_STATUS_OK) {
-		fbe_persist_transaction_abort(tran_handle);
-        fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
-        fbe_transport_set_status(packet, FBE_STATUS_GENERIC_FAILURE, 0);
-        fbe_transport_complete_packet(packet);
-        return FBE_STATUS_GENERIC_FAILURE;
-    }
-
-    /*now let's commit it*/
-	return fbe_persist_transaction_commit(packet, tran_handle);
-
+	/*the transaction service opens the transaction, merges us with any other single entry requests waiting for it and commits*/
+	return fbe_persist_transaction_queue_single_entry(packet);
 }
 
 /* This is the entry point for handling persist service control requests. */
@@ -1243,6 +1139,9 @@ persist_control_entry(fbe_packet_t * packet)
 		case FBE_PERSIST_CONTROL_CODE_GET_REQUEIRED_LUN_SIZE:
 			status = fbe_persist_get_required_lun_size(packet);
 			return status;
+		case FBE_PERSIST_CONTROL_CODE_GET_STATS:
+			status = persist_get_stats(packet);
+			return status;
         case FBE_PERSIST_CONTROL_CODE_UNSET_LUN:
             status = persist_unset_database_lun(packet, state);            
             return status;
@@ -1750,3 +1649,59 @@ static fbe_status_t persist_validate_entry(fbe_packet_t * packet)
     fbe_transport_complete_packet(packet);
     return FBE_STATUS_OK;
 }
+
+static fbe_status_t persist_get_stats(fbe_packet_t * packet)
+{
+    fbe_payload_ex_t *						payload;
+    fbe_payload_control_operation_t *		control_operation;
+    fbe_persist_control_get_stats_t *		get_stats;
+    fbe_u32_t 								buffer_length;
+
+    payload = fbe_transport_get_payload_ex(packet);
+    if (payload == NULL) {
+        fbe_persist_trace(FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                          "%s: get_sep_payload failed\n", __FUNCTION__);
+        fbe_transport_set_status(packet, FBE_STATUS_GENERIC_FAILURE, 0);
+        fbe_transport_complete_packet(packet);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    control_operation = fbe_payload_ex_get_control_operation(payload);
+    if (control_operation == NULL) {
+        fbe_persist_trace(FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                          "%s: get_control_operation failed\n", __FUNCTION__);
+        fbe_transport_set_status(packet, FBE_STATUS_GENERIC_FAILURE, 0);
+        fbe_transport_complete_packet(packet);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    get_stats = NULL;
+    fbe_payload_control_get_buffer(control_operation, &get_stats);
+    if (get_stats == NULL){
+        fbe_persist_trace(FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                          "%s fbe_payload_control_get_buffer failed\n", __FUNCTION__);
+        fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
+        fbe_transport_set_status(packet, FBE_STATUS_GENERIC_FAILURE, 0);
+        fbe_transport_complete_packet(packet);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    buffer_length = 0;
+    fbe_payload_control_get_buffer_length(control_operation, &buffer_length);
+    if (buffer_length != sizeof(fbe_persist_control_get_stats_t)) {
+        fbe_persist_trace(FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                          "%s Invalid len %d != %llu \n", __FUNCTION__,
+                          buffer_length, (unsigned long long)sizeof(fbe_persist_control_get_stats_t));
+        fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
+        fbe_transport_set_status(packet, FBE_STATUS_GENERIC_FAILURE, 0);
+        fbe_transport_complete_packet(packet);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    fbe_persist_transaction_get_stats(get_stats);
+
+    fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_OK);
+    fbe_transport_set_status(packet, FBE_STATUS_OK, 0);
+    fbe_transport_complete_packet(packet);
+    return FBE_STATUS_OK;
+}
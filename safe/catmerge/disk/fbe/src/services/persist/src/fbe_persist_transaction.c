@@ -16,6 +16,17 @@ static fbe_persist_transaction_handle_t next_tran_handle = 1;
 static fbe_spinlock_t persist_tran_lock;
 static fbe_packet_t * transaction_subpacket;/*we need only one since we are serailizing our transactions*/
 
+/* Single entry requests that arrive while the transaction slot is busy wait on persist_tran_group_queue.
+ * When the slot frees up they are merged into one transaction (one journal write, one commit) that is
+ * driven by persist_tran_group_packet.  The requests in that transaction sit on the inflight queue. */
+static fbe_queue_head_t persist_tran_group_queue;
+static fbe_queue_head_t persist_tran_group_inflight_queue;
+static fbe_packet_t * persist_tran_group_packet;
+static fbe_persist_control_transaction_t persist_tran_group_control;
+static fbe_bool_t persist_tran_group_in_progress = FBE_FALSE;
+
+static fbe_persist_control_get_stats_t persist_tran_stats;
+
 extern fbe_persist_db_header_t          persist_db_header;
 
 /**********************/
@@ -24,7 +35,7 @@ extern fbe_persist_db_header_t          persist_db_header;
 
 static fbe_status_t fbe_persist_transaction_clear_marked_entries(void);
 static void fbe_persist_clear_deleted_entries(void);
-static void persist_commit_write_transaction(fbe_packet_t * request_packet, fbe_persist_tran_elem_t *tran_elem, fbe_u32_t index);
+static void persist_commit_write_transaction(fbe_packet_t * request_packet, fbe_u32_t index);
 static fbe_status_t persist_write_entry_completion(fbe_packet_t * subpacket, fbe_packet_completion_context_t notused);
 static fbe_status_t persist_write_journal(fbe_packet_t * packet);
 static fbe_status_t fbe_persist_transaction_read_and_replay_journal_completion(fbe_packet_t * subpacket, fbe_packet_completion_context_t notused);
@@ -36,6 +47,9 @@ static fbe_status_t fbe_persist_rebuild_entry_bitmap(fbe_packet_t *packet, fbe_p
 static fbe_status_t
 persist_tran_journal_invalidate_completion(fbe_packet_t * subpacket, fbe_packet_completion_context_t notused);
 static fbe_status_t persist_tran_write_journal_header_completion(fbe_packet_t * subpacket, fbe_packet_completion_context_t notused);
+static void persist_tran_group_commit_start(void);
+static fbe_status_t persist_tran_group_commit_completion(fbe_packet_t * packet, fbe_packet_completion_context_t notused);
+static void persist_tran_group_fail_queued_requests(fbe_status_t status);
 
 
 /**************************************************************************************************************************************************/
@@ -210,7 +224,7 @@ persist_tran_buffer_destroy(void)
 static fbe_status_t
 persist_tran_buffer_init(void)
 {
-    fbe_u32_t ii, jj, kk, pp;
+    fbe_u32_t ii, jj, kk;
     fbe_u32_t sgl_size;
     fbe_persist_tran_elem_t * tran_elem;
     fbe_u8_t *tran_buffer_ptr;
@@ -230,8 +244,8 @@ persist_tran_buffer_init(void)
         return FBE_STATUS_GENERIC_FAILURE;
     }
 
-	/*allocate memory for the commit sgl*/
-	sgl_size = FBE_PERSIST_SGL_ELEM_PER_TRAN_COMMIT * sizeof(fbe_sg_element_t) * 2;/*we need twice as many entries because for each one we need a terminating one as well*/
+	/*allocate memory for the commit sgl, it is rebuilt for each run of contiguous entries we write (plus a terminating entry)*/
+	sgl_size = (FBE_PERSIST_SGL_ELEM_PER_TRAN_COMMIT + 1) * sizeof(fbe_sg_element_t);
     persist_tran_commit_sgl = (fbe_sg_element_t*)fbe_memory_native_allocate(sgl_size);
     if (persist_tran_commit_sgl == NULL) {
         fbe_persist_trace(FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
@@ -250,7 +264,7 @@ persist_tran_buffer_init(void)
 
     /* Allocate the transaction buffers. */
     tran_buffer_ptr = persist_tran_buffer_memory;
-    for (ii = jj = pp= 0; ii < FBE_PERSIST_TRAN_BUF_MAX; ii++) {
+    for (ii = jj = 0; ii < FBE_PERSIST_TRAN_BUF_MAX; ii++) {
         persist_tran_buffer[ii] = tran_buffer_ptr;
         tran_buffer_ptr += FBE_PERSIST_TRAN_BUF_SIZE;
 
@@ -259,14 +273,8 @@ persist_tran_buffer_init(void)
         /* Cycle across this buffer setting the tran element pointers. */
         tran_elem = (fbe_persist_tran_elem_t*)persist_tran_buffer[ii];
         for (kk = 0; kk < FBE_PERSIST_TRAN_ENTRY_PER_TRAN_BUF; kk++) {
-			/* Create an sgl entry for this buffer. 
-			the pp index just makes sure we keep filling the whole 64 entries of sgl with data in the even ones and termination in the odd ones*/
-            fbe_sg_element_init(&persist_tran_commit_sgl[pp++], FBE_PERSIST_TRAN_BUF_SIZE / 2, (void*)(persist_tran_buffer[ii] + (kk * (FBE_PERSIST_TRAN_BUF_SIZE / 2))));
-			/*and fill the actual table that points to each entry*/
+			/*fill the actual table that points to each entry*/
             persist_tran_elem[jj++] = tran_elem++;
-			fbe_sg_element_terminate(&persist_tran_commit_sgl[pp++]);/*will terminate the one just below the one we just set*/
-			
-			
         }
     }
     /* Null terminate the sgl. */
@@ -294,7 +302,7 @@ persist_tran_elem_commit(fbe_packet_t * request_packet, fbe_persist_tran_elem_t
 		case FBE_PERSIST_TRAN_OP_WRITE_ENTRY:
 		case FBE_PERSIST_TRAN_OP_MODIFY_ENTRY:
 		case FBE_PERSIST_TRAN_OP_DELETE_ENTRY:
-			persist_commit_write_transaction(request_packet, tran_elem, index);
+			persist_commit_write_transaction(request_packet, index);
             break;
         default:
             fbe_persist_trace(FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
@@ -373,11 +381,11 @@ persist_transaction_commit(fbe_packet_t * request_packet)
     }
     fbe_spinlock_unlock(&persist_tran_lock);
 
-    /* Commit the next transaction element. */
+    /* Commit the next transaction element, along with any following elements that live in contiguous entries. */
     if (persist_tran_header->tran_elem_committed_count < persist_tran_header->tran_elem_count) {
         tran_elem = persist_tran_elem[persist_tran_header->tran_elem_committed_count];
+        /* The committed count is advanced past the whole run before the write is sent. */
         persist_tran_elem_commit(request_packet, tran_elem, persist_tran_header->tran_elem_committed_count);
-		persist_tran_header->tran_elem_committed_count++;
         /* Each transaction element commit is an asynchronous operation,
          * any additional commits will happen after this one completes. */
         return;
@@ -545,6 +553,7 @@ static fbe_status_t persist_write_journal(fbe_packet_t * packet)
 
     /* Do the block-level checksums across the transaction buffers. */
     persist_tran_buffer_set_checksums();
+    persist_tran_stats.journal_commits++;
     /* Put an sgl pointer in the packet payload. */
     fbe_payload_ex_set_sg_list(payload, persist_tran_journal_sgl, FBE_PERSIST_SGL_ELEM_PER_TRAN_JOURNAL);
     /* Link the subpacket into the caller's request packet. */
@@ -586,6 +595,24 @@ fbe_persist_transaction_init(void)
         return FBE_STATUS_GENERIC_FAILURE;
 	}
 
+    /* The group commit packet plays the part of the caller's commit request for merged single entry requests. */
+    fbe_queue_init(&persist_tran_group_queue);
+    fbe_queue_init(&persist_tran_group_inflight_queue);
+    persist_tran_group_in_progress = FBE_FALSE;
+    fbe_zero_memory(&persist_tran_stats, sizeof(fbe_persist_control_get_stats_t));
+
+	persist_tran_group_packet = fbe_transport_allocate_packet();
+	if (persist_tran_group_packet == NULL) {
+        fbe_persist_trace(FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED, "%s Can't allocate group packet\n", __FUNCTION__);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+	status = fbe_transport_initialize_sep_packet(persist_tran_group_packet);
+	if (status != FBE_STATUS_OK) {
+		fbe_persist_trace(FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED, "%s failed to init group packet\n", __FUNCTION__);
+        return FBE_STATUS_GENERIC_FAILURE;
+	}
+
     return FBE_STATUS_OK;
 }
 
@@ -616,10 +643,16 @@ fbe_persist_transaction_destroy(void)
         fbe_spinlock_unlock(&persist_tran_lock);
     }
 
+    /* Nobody is going to commit the requests that are still waiting for a group commit. */
+    persist_tran_group_fail_queued_requests(FBE_STATUS_CANCELED);
+
     fbe_spinlock_destroy(&persist_tran_lock);
     persist_tran_buffer_destroy();
 
 	fbe_transport_release_packet(transaction_subpacket);
+	fbe_transport_release_packet(persist_tran_group_packet);
+    fbe_queue_destroy(&persist_tran_group_queue);
+    fbe_queue_destroy(&persist_tran_group_inflight_queue);
 	fbe_persist_trace(FBE_TRACE_LEVEL_INFO, FBE_TRACE_MESSAGE_ID_INFO, "%s Done\n", __FUNCTION__);
     return;
 }
@@ -827,6 +860,9 @@ fbe_persist_transaction_abort(fbe_persist_transaction_handle_t callers_tran_hand
 	}
     fbe_persist_transaction_invalidate_transaction_lock();
     fbe_spinlock_unlock(&persist_tran_lock);
+
+    /* The slot is free, let any waiting single entry requests go. */
+    persist_tran_group_commit_start();
     return FBE_STATUS_OK;
 }
 
@@ -894,6 +930,7 @@ fbe_persist_transaction_commit(fbe_packet_t * packet, fbe_persist_transaction_ha
                       "%s: transaction commit requested, but the current transaction is empty!\n", __FUNCTION__);        
         fbe_transport_set_status(packet, FBE_STATUS_OK, 0);
         fbe_transport_complete_packet(packet);
+        persist_tran_group_commit_start();
         return FBE_STATUS_OK;
     }
 
@@ -1142,13 +1179,58 @@ static void fbe_persist_clear_deleted_entries(void)
 	return ;
 }
 
-/*write to disk a transaction that created or changed a record*/
-static void persist_commit_write_transaction(fbe_packet_t * packet, fbe_persist_tran_elem_t *tran_elem, fbe_u32_t index)
+/* This local function collects the run of transaction elements starting at first_index whose entries are
+ * contiguous on disk, so that they can be committed with a single write.  The run never reorders elements,
+ * it stops at the first element that does not directly follow the previous one, so two writes to the same
+ * entry within a transaction still land in order.  The commit sgl is built to cover the run. */
+static fbe_status_t
+persist_tran_build_commit_run(fbe_u32_t first_index, fbe_lba_t *run_lba, fbe_u32_t *run_elem_count)
+{
+    fbe_u32_t                   index;
+    fbe_u32_t                   sg_index = 0;
+    fbe_lba_t                   elem_lba;
+    fbe_lba_t                   next_lba;
+    fbe_persist_tran_elem_t *   tran_elem;
+    fbe_status_t                status;
+
+    tran_elem = persist_tran_elem[first_index];
+    status = fbe_persist_database_get_entry_lba(tran_elem->tran_elem_header.header.entry_id, run_lba);
+    if (status != FBE_STATUS_OK) {
+        return status;
+    }
+
+    fbe_sg_element_init(&persist_tran_commit_sgl[sg_index++], FBE_PERSIST_TRAN_ENTRY_SIZE, (void*)tran_elem);
+    next_lba = *run_lba + FBE_PERSIST_BLOCKS_PER_TRAN_ENTRY;
+
+    for (index = first_index + 1; index < persist_tran_header->tran_elem_count; index++) {
+        tran_elem = persist_tran_elem[index];
+        if ((tran_elem->tran_elem_header.header.tran_elem_op != FBE_PERSIST_TRAN_OP_WRITE_ENTRY) &&
+            (tran_elem->tran_elem_header.header.tran_elem_op != FBE_PERSIST_TRAN_OP_MODIFY_ENTRY) &&
+            (tran_elem->tran_elem_header.header.tran_elem_op != FBE_PERSIST_TRAN_OP_DELETE_ENTRY)) {
+            /* Let the commit loop report it when it gets to this element. */
+            break;
+        }
+        status = fbe_persist_database_get_entry_lba(tran_elem->tran_elem_header.header.entry_id, &elem_lba);
+        if ((status != FBE_STATUS_OK) || (elem_lba != next_lba)) {
+            break;
+        }
+        fbe_sg_element_init(&persist_tran_commit_sgl[sg_index++], FBE_PERSIST_TRAN_ENTRY_SIZE, (void*)tran_elem);
+        next_lba += FBE_PERSIST_BLOCKS_PER_TRAN_ENTRY;
+    }
+    fbe_sg_element_terminate(&persist_tran_commit_sgl[sg_index]);
+
+    *run_elem_count = sg_index;
+    return FBE_STATUS_OK;
+}
+
+/*write to disk a transaction that created or changed a record, together with the elements after it that are contiguous on disk*/
+static void persist_commit_write_transaction(fbe_packet_t * packet, fbe_u32_t index)
 {
 	fbe_packet_t * 					subpacket;
     fbe_payload_ex_t * 			payload;
     fbe_payload_block_operation_t * block_operation;
     fbe_lba_t 						tran_write_lba;
+    fbe_u32_t                       run_elem_count = 0;
     fbe_status_t					status;
 
     /* Create a subpacket for an I/O that writes the transaction to the journal. */
@@ -1178,20 +1260,22 @@ static void persist_commit_write_transaction(fbe_packet_t * packet, fbe_persist_
         return ;
     }
 
-    status = fbe_persist_database_get_entry_lba(tran_elem->tran_elem_header.header.entry_id, &tran_write_lba);
+    status = persist_tran_build_commit_run(index, &tran_write_lba, &run_elem_count);
 	if (status != FBE_STATUS_OK) {
 		fbe_persist_trace(FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
                           "%s Can't get lba\n", __FUNCTION__);
+        fbe_payload_ex_release_block_operation(payload, block_operation);
         fbe_transport_reuse_packet(subpacket);
 		fbe_persist_transaction_invalidate_transaction();
         fbe_transport_set_status(packet, FBE_STATUS_GENERIC_FAILURE, 0);
         fbe_transport_complete_packet(packet);
+        return ;
 	}
 
     fbe_payload_block_build_operation(block_operation,
                                       FBE_PAYLOAD_BLOCK_OPERATION_OPCODE_WRITE,
                                       tran_write_lba,
-                                      FBE_PERSIST_BLOCKS_PER_TRAN_ENTRY,
+                                      FBE_PERSIST_BLOCKS_PER_TRAN_ENTRY * run_elem_count,
                                       FBE_PERSIST_BYTES_PER_BLOCK,
                                       0,     /* optimum block size (not used) */
                                       NULL); /* preread descriptor (not used) */
@@ -1199,7 +1283,13 @@ static void persist_commit_write_transaction(fbe_packet_t * packet, fbe_persist_
     fbe_payload_ex_increment_block_operation_level(payload);
     
     /* Put an sgl pointer in the packet payload. */
-    fbe_payload_ex_set_sg_list(payload, &persist_tran_commit_sgl[index * 2], 2);/*we multiply by two because every other element is the terminating one*/
+    fbe_payload_ex_set_sg_list(payload, persist_tran_commit_sgl, run_elem_count + 1);
+
+    /* The whole run is committed by this write. If we crash before it completes the journal is still valid
+     * and the replay rewrites every entry of the transaction. */
+    persist_tran_header->tran_elem_committed_count += run_elem_count;
+    persist_tran_stats.entry_write_ios++;
+    persist_tran_stats.entries_written += run_elem_count;
 
 	/* Link the subpacket into the caller's request packet. */
     fbe_transport_add_subpacket(packet, subpacket);
@@ -1408,8 +1498,8 @@ static fbe_status_t fbe_persist_transaction_read_and_replay_journal(fbe_packet_t
         fbe_persist_trace(FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
             "%s Can't get payload\n", __FUNCTION__);
 
-        fbe_persist_transaction_invalidate_transaction();
         fbe_transport_reuse_packet(subpacket);
+        fbe_persist_transaction_invalidate_transaction();
         fbe_transport_set_status(packet, FBE_STATUS_GENERIC_FAILURE, 0);
         fbe_transport_complete_packet(packet);
         return FBE_STATUS_MORE_PROCESSING_REQUIRED;
@@ -1421,8 +1511,8 @@ static fbe_status_t fbe_persist_transaction_read_and_replay_journal(fbe_packet_t
         fbe_persist_trace(FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
             "%s Can't get block_operation\n", __FUNCTION__);
 
-        fbe_persist_transaction_invalidate_transaction();
         fbe_transport_reuse_packet(subpacket);
+        fbe_persist_transaction_invalidate_transaction();
         fbe_transport_set_status(packet, FBE_STATUS_GENERIC_FAILURE, 0);
         fbe_transport_complete_packet(packet);
         return FBE_STATUS_MORE_PROCESSING_REQUIRED;
@@ -1494,8 +1584,8 @@ static fbe_status_t fbe_persist_transaction_read_and_replay_journal_completion(f
     if (payload == NULL) {
         fbe_persist_trace(FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
                           "%s Can't get payload\n", __FUNCTION__);
-		fbe_persist_transaction_invalidate_transaction();
         fbe_transport_reuse_packet(subpacket);
+		fbe_persist_transaction_invalidate_transaction();
         fbe_transport_set_status(request_packet, FBE_STATUS_GENERIC_FAILURE, 0);
         fbe_transport_complete_packet(request_packet);
         return FBE_STATUS_MORE_PROCESSING_REQUIRED;
@@ -1506,8 +1596,8 @@ static fbe_status_t fbe_persist_transaction_read_and_replay_journal_completion(f
     if (block_operation == NULL) {
         fbe_persist_trace(FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
                           "%s Can't get block_operation\n", __FUNCTION__);
-		fbe_persist_transaction_invalidate_transaction();
         fbe_transport_reuse_packet(subpacket);
+		fbe_persist_transaction_invalidate_transaction();
         fbe_transport_set_status(request_packet, FBE_STATUS_GENERIC_FAILURE, 0);
         fbe_transport_complete_packet(request_packet);
         return FBE_STATUS_MORE_PROCESSING_REQUIRED;
@@ -1518,9 +1608,9 @@ static fbe_status_t fbe_persist_transaction_read_and_replay_journal_completion(f
     if (status != FBE_STATUS_OK) {
         fbe_persist_trace(FBE_TRACE_LEVEL_WARNING, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
                           "%s journal read failed\n", __FUNCTION__);
-		fbe_persist_transaction_invalidate_transaction();
 		 fbe_payload_ex_release_block_operation(payload, block_operation);
         fbe_transport_reuse_packet(subpacket);
+		fbe_persist_transaction_invalidate_transaction();
         fbe_transport_set_status(request_packet, FBE_STATUS_GENERIC_FAILURE, 0);
         fbe_transport_complete_packet(request_packet);
         return FBE_STATUS_MORE_PROCESSING_REQUIRED;
@@ -1530,9 +1620,9 @@ static fbe_status_t fbe_persist_transaction_read_and_replay_journal_completion(f
     if (block_status != FBE_PAYLOAD_BLOCK_OPERATION_STATUS_SUCCESS) {
         fbe_persist_trace(FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
                           "%s Block_operation error, status: 0x%X\n", __FUNCTION__, block_status);
-		fbe_persist_transaction_invalidate_transaction();
 		 fbe_payload_ex_release_block_operation(payload, block_operation);
         fbe_transport_reuse_packet(subpacket);
+		fbe_persist_transaction_invalidate_transaction();
         fbe_transport_set_status(request_packet, FBE_STATUS_GENERIC_FAILURE, 0);
         fbe_transport_complete_packet(request_packet);
         return FBE_STATUS_MORE_PROCESSING_REQUIRED;
@@ -1650,17 +1740,27 @@ static void fbe_persist_transaction_invalidate_transaction_lock(void)
 	persist_tran_header->tran_elem_committed_count = 0;
 }
 
+/* Every path that ends a transaction (commit done, commit failed, LUN set) comes through here,
+ * so this is also where single entry requests waiting for the slot get started. */
 static void fbe_persist_transaction_invalidate_transaction(void)
 {
 	fbe_spinlock_lock(&persist_tran_lock);
     fbe_persist_transaction_invalidate_transaction_lock();
 	fbe_spinlock_unlock(&persist_tran_lock);
+
+    persist_tran_group_commit_start();
 }
 
 /*while unsetting the LUN (repond to FBE_PERSIST_CONTROL_CODE_UNSET_LUN) we also reset the transaction*/
 fbe_status_t fbe_persist_transaction_reset(void)
 {
-    fbe_persist_transaction_invalidate_transaction();
+    /* There is no LUN to commit to, so bounce the waiting single entry requests back to their
+     * callers as busy, exactly as if they had arrived while a transaction was in progress. */
+    persist_tran_group_fail_queued_requests(FBE_STATUS_BUSY);
+
+	fbe_spinlock_lock(&persist_tran_lock);
+    fbe_persist_transaction_invalidate_transaction_lock();
+	fbe_spinlock_unlock(&persist_tran_lock);
     return FBE_STATUS_OK;
 }
 
@@ -1813,10 +1913,11 @@ persist_tran_journal_invalidate_completion(fbe_packet_t * request_packet, fbe_pa
     as free entries. We waited until now in case the user aborted the transaction */
     fbe_persist_clear_deleted_entries();
 
-    /* We are done with the transaction. */
-    fbe_persist_transaction_invalidate_transaction();
+    /* We are done with the transaction. The header is cleared first since invalidating the transaction
+     * may start the next group commit right away. */
     persist_db_header.journal_state = 0;
     persist_db_header.journal_size = 0;
+    fbe_persist_transaction_invalidate_transaction();
 
     /* We are done with the commit request. */
     fbe_transport_set_status(request_packet, status, 0);
@@ -1952,3 +2053,306 @@ fbe_persist_transaction_validate_entry(fbe_persist_transaction_handle_t callers_
     return FBE_STATUS_OK;
 }
 
+
+/*!*******************************************************************************************
+ * @fn persist_tran_group_complete_single_entry
+ *********************************************************************************************
+* @brief
+*  Completes one single entry request with the status of the commit it was part of.
+*
+* @param packet - single entry request packet
+* @param status - commit status
+*
+* @return none
+ *
+ ********************************************************************************************/
+static void persist_tran_group_complete_single_entry(fbe_packet_t * packet, fbe_status_t status)
+{
+    fbe_payload_ex_t *                  payload = fbe_transport_get_payload_ex(packet);
+    fbe_payload_control_operation_t *   control_operation = fbe_payload_ex_get_control_operation(payload);
+
+    if (status == FBE_STATUS_OK) {
+        fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_OK);
+    } else if (status == FBE_STATUS_BUSY) {
+        fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_BUSY);
+    } else {
+        fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
+    }
+    fbe_transport_set_status(packet, status, 0);
+    fbe_transport_complete_packet(packet);
+}
+
+/*!*******************************************************************************************
+ * @fn persist_tran_group_fail_queued_requests
+ *********************************************************************************************
+* @brief
+*  Completes all single entry requests that are still waiting for a group commit.
+*
+* @param status - status to complete them with
+*
+* @return none
+ *
+ ********************************************************************************************/
+static void persist_tran_group_fail_queued_requests(fbe_status_t status)
+{
+    fbe_queue_head_t        fail_queue;
+    fbe_queue_element_t *   queue_element;
+
+    fbe_queue_init(&fail_queue);
+    fbe_spinlock_lock(&persist_tran_lock);
+    while (!fbe_queue_is_empty(&persist_tran_group_queue)) {
+        queue_element = fbe_queue_pop(&persist_tran_group_queue);
+        fbe_queue_push(&fail_queue, queue_element);
+    }
+    fbe_spinlock_unlock(&persist_tran_lock);
+
+    while (!fbe_queue_is_empty(&fail_queue)) {
+        queue_element = fbe_queue_pop(&fail_queue);
+        persist_tran_group_complete_single_entry(fbe_transport_queue_element_to_packet(queue_element), status);
+    }
+    fbe_queue_destroy(&fail_queue);
+}
+
+/*!*******************************************************************************************
+ * @fn persist_tran_group_add_single_entry
+ *********************************************************************************************
+* @brief
+*  Adds the element of one single entry request to the group transaction.
+*
+* @param packet - single entry request packet
+* @param tran_handle - handle of the group transaction
+*
+* @return fbe_status_t - FBE_STATUS_GENERIC_FAILURE if the request can't be part of the transaction
+ *
+ ********************************************************************************************/
+static fbe_status_t persist_tran_group_add_single_entry(fbe_packet_t * packet, fbe_persist_transaction_handle_t tran_handle)
+{
+    fbe_payload_ex_t *                              payload = fbe_transport_get_payload_ex(packet);
+    fbe_payload_control_operation_t *               control_operation = fbe_payload_ex_get_control_operation(payload);
+    fbe_persist_control_write_single_entry_t *      control_write = NULL;
+    fbe_persist_control_modify_single_entry_t *     control_modify = NULL;
+    fbe_persist_control_delete_single_entry_t *     control_delete = NULL;
+    fbe_sg_element_t *                              sg_element = NULL;
+    fbe_u32_t                                       sg_element_count;
+    fbe_bool_t                                      entry_deleted = FBE_FALSE;
+    fbe_status_t                                    status;
+
+    fbe_payload_ex_get_sg_list(payload, &sg_element, &sg_element_count);
+
+    switch (fbe_transport_get_control_code(packet)) {
+        case FBE_PERSIST_CONTROL_CODE_WRITE_SINGLE_ENTRY:
+            fbe_payload_control_get_buffer(control_operation, &control_write);
+            status = fbe_persist_transaction_write_entry(tran_handle,
+                                                         control_write->target_sector,
+                                                         &control_write->entry_id,
+                                                         sg_element->address,
+                                                         sg_element->count,
+                                                         FBE_FALSE);
+            break;
+        case FBE_PERSIST_CONTROL_CODE_MODIFY_SINGLE_ENTRY:
+            fbe_payload_control_get_buffer(control_operation, &control_modify);
+            /*any chance an earlier request in this group already deleted this entry ?*/
+            status = fbe_persist_transaction_is_entry_deleted(control_modify->entry_id, &entry_deleted);
+            if ((status != FBE_STATUS_OK) || (FBE_IS_TRUE(entry_deleted))) {
+                fbe_persist_trace(FBE_TRACE_LEVEL_WARNING, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                                  "%s entry already marked for deletion: id: %lld\n" ,__FUNCTION__, (long long)control_modify->entry_id);
+                return FBE_STATUS_GENERIC_FAILURE;
+            }
+            status = fbe_persist_transaction_modify_entry(tran_handle,
+                                                          control_modify->entry_id,
+                                                          sg_element->address,
+                                                          sg_element->count);
+            break;
+        case FBE_PERSIST_CONTROL_CODE_DELETE_SINGLE_ENTRY:
+            fbe_payload_control_get_buffer(control_operation, &control_delete);
+            status = fbe_persist_transaction_delete_entry(tran_handle, control_delete->entry_id);
+            break;
+        default:
+            fbe_persist_trace(FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                              "%s unexpected control code 0x%x\n", __FUNCTION__, fbe_transport_get_control_code(packet));
+            status = FBE_STATUS_GENERIC_FAILURE;
+            break;
+    }
+
+    return status;
+}
+
+/*!*******************************************************************************************
+ * @fn persist_tran_group_commit_start
+ *********************************************************************************************
+* @brief
+*  If the transaction slot is idle and single entry requests are waiting, open one transaction
+*  for all of them (up to FBE_PERSIST_TRAN_ENTRY_MAX), and commit it with a single journal write.
+*  The crash guarantees are those of any other transaction: the journal holds every element
+*  of the group until all of them are in the live data region.
+*
+* @return none
+ *
+ ********************************************************************************************/
+static void persist_tran_group_commit_start(void)
+{
+    fbe_persist_transaction_handle_t    tran_handle;
+    fbe_queue_element_t *               queue_element;
+    fbe_packet_t *                      packet;
+    fbe_payload_ex_t *                  payload;
+    fbe_payload_control_operation_t *   control_operation;
+    fbe_u32_t                           merged_count;
+    fbe_status_t                        status;
+
+    do {
+        fbe_spinlock_lock(&persist_tran_lock);
+        if (persist_tran_group_in_progress ||
+            fbe_queue_is_empty(&persist_tran_group_queue) ||
+            (persist_tran_header->tran_state != FBE_PERSIST_TRAN_STATE_INVALID) ||
+            (persist_tran_header->tran_handle != FBE_PERSIST_TRAN_HANDLE_INVALID)) {
+            /* Whoever owns the slot (or the group in flight) will call us again when it is done. */
+            fbe_spinlock_unlock(&persist_tran_lock);
+            return;
+        }
+        persist_tran_group_in_progress = FBE_TRUE;
+        fbe_spinlock_unlock(&persist_tran_lock);
+
+        fbe_transport_reuse_packet(persist_tran_group_packet);
+        status = fbe_persist_transaction_start(persist_tran_group_packet, &tran_handle);
+        if (status != FBE_STATUS_OK) {
+            /* Somebody took the slot in the meantime, they will kick us when they are done. */
+            fbe_spinlock_lock(&persist_tran_lock);
+            persist_tran_group_in_progress = FBE_FALSE;
+            fbe_spinlock_unlock(&persist_tran_lock);
+            if (status == FBE_STATUS_BUSY) {
+                return;
+            }
+            persist_tran_group_fail_queued_requests(status);
+            return;
+        }
+
+        /* Move as many waiting requests as fit into the transaction. */
+        merged_count = 0;
+        while (merged_count < FBE_PERSIST_TRAN_ENTRY_MAX) {
+            fbe_spinlock_lock(&persist_tran_lock);
+            if (fbe_queue_is_empty(&persist_tran_group_queue)) {
+                fbe_spinlock_unlock(&persist_tran_lock);
+                break;
+            }
+            queue_element = fbe_queue_pop(&persist_tran_group_queue);
+            fbe_spinlock_unlock(&persist_tran_lock);
+
+            packet = fbe_transport_queue_element_to_packet(queue_element);
+            status = persist_tran_group_add_single_entry(packet, tran_handle);
+            if (status != FBE_STATUS_OK) {
+                persist_tran_group_complete_single_entry(packet, FBE_STATUS_GENERIC_FAILURE);
+                continue;
+            }
+            /* Only the owner of the group touches the inflight queue. */
+            fbe_queue_push(&persist_tran_group_inflight_queue, queue_element);
+            merged_count++;
+        }
+
+        if (merged_count == 0) {
+            /* Every request failed on its own, there is nothing to commit. */
+            fbe_spinlock_lock(&persist_tran_lock);
+            fbe_persist_transaction_invalidate_transaction_lock();
+            persist_tran_group_in_progress = FBE_FALSE;
+            fbe_spinlock_unlock(&persist_tran_lock);
+            /* Requests may have been queued while we were busy, look again. */
+            continue;
+        }
+
+        if (merged_count > 1) {
+            persist_tran_stats.group_commits++;
+        }
+        fbe_persist_trace(FBE_TRACE_LEVEL_DEBUG_LOW, FBE_TRACE_MESSAGE_ID_INFO,
+                          "%s: committing tran 0x%llx with %d single entry requests\n",
+                          __FUNCTION__, (unsigned long long)tran_handle, merged_count);
+
+        /* The commit expects a control request, build one for the group. */
+        persist_tran_group_control.tran_handle = tran_handle;
+        persist_tran_group_control.tran_op_type = FBE_PERSIST_TRANSACTION_OP_COMMIT;
+        persist_tran_group_control.caller_package = FBE_PACKAGE_ID_SEP_0;
+        payload = fbe_transport_get_payload_ex(persist_tran_group_packet);
+        control_operation = fbe_payload_ex_allocate_control_operation(payload);
+        fbe_payload_control_build_operation(control_operation,
+                                            FBE_PERSIST_CONTROL_CODE_TRANSACTION,
+                                            &persist_tran_group_control,
+                                            sizeof(fbe_persist_control_transaction_t));
+        fbe_transport_set_completion_function(persist_tran_group_packet, persist_tran_group_commit_completion, NULL);
+
+        fbe_persist_transaction_commit(persist_tran_group_packet, tran_handle);
+        return;
+
+    } while (FBE_TRUE);
+}
+
+/*!*******************************************************************************************
+ * @fn persist_tran_group_commit_completion
+ *********************************************************************************************
+* @brief
+*  Completion of a group commit. Completes every request that was merged into the group, then
+*  starts the next group for the requests that arrived while this one was being committed.
+*
+* @param packet - the group commit packet
+* @param notused - always NULL
+*
+* @return fbe_status_t - FBE_STATUS_MORE_PROCESSING_REQUIRED, the packet is ours
+ *
+ ********************************************************************************************/
+static fbe_status_t persist_tran_group_commit_completion(fbe_packet_t * packet, fbe_packet_completion_context_t notused)
+{
+    fbe_status_t                        status = fbe_transport_get_status_code(packet);
+    fbe_payload_ex_t *                  payload = fbe_transport_get_payload_ex(packet);
+    fbe_payload_control_operation_t *   control_operation = fbe_payload_ex_get_control_operation(payload);
+    fbe_queue_element_t *               queue_element;
+
+    if (control_operation != NULL) {
+        fbe_payload_ex_release_control_operation(payload, control_operation);
+    }
+
+    if (status != FBE_STATUS_OK) {
+        fbe_persist_trace(FBE_TRACE_LEVEL_WARNING, FBE_TRACE_MESSAGE_ID_INFO,
+                          "%s group commit failed, status: 0x%x\n", __FUNCTION__, status);
+    }
+
+    while (!fbe_queue_is_empty(&persist_tran_group_inflight_queue)) {
+        queue_element = fbe_queue_pop(&persist_tran_group_inflight_queue);
+        persist_tran_group_complete_single_entry(fbe_transport_queue_element_to_packet(queue_element), status);
+    }
+
+    fbe_spinlock_lock(&persist_tran_lock);
+    persist_tran_group_in_progress = FBE_FALSE;
+    fbe_spinlock_unlock(&persist_tran_lock);
+
+    persist_tran_group_commit_start();
+    return FBE_STATUS_MORE_PROCESSING_REQUIRED;
+}
+
+/*!*******************************************************************************************
+ * @fn fbe_persist_transaction_queue_single_entry
+ *********************************************************************************************
+* @brief
+*  Entry point for validated FBE_PERSIST_CONTROL_CODE_WRITE/MODIFY/DELETE_SINGLE_ENTRY requests.
+*  Instead of failing with busy when a transaction is in progress, the request waits and is
+*  committed together with the other requests that arrived in the meantime.
+*
+* @param packet - single entry request packet
+*
+* @return fbe_status_t - FBE_STATUS_OK, the packet is completed once it is committed
+ *
+ ********************************************************************************************/
+fbe_status_t fbe_persist_transaction_queue_single_entry(fbe_packet_t * packet)
+{
+    fbe_spinlock_lock(&persist_tran_lock);
+    fbe_queue_push(&persist_tran_group_queue, fbe_transport_get_queue_element(packet));
+    persist_tran_stats.single_entry_requests++;
+    fbe_spinlock_unlock(&persist_tran_lock);
+
+    persist_tran_group_commit_start();
+    return FBE_STATUS_OK;
+}
+
+/* This external function is called when a FBE_PERSIST_CONTROL_CODE_GET_STATS request is received. */
+void fbe_persist_transaction_get_stats(fbe_persist_control_get_stats_t * get_stats)
+{
+    fbe_spinlock_lock(&persist_tran_lock);
+    *get_stats = persist_tran_stats;
+    fbe_spinlock_unlock(&persist_tran_lock);
+}
@@ -126,6 +126,8 @@ fbe_status_t fbe_persist_read_persist_db_header_and_replay_journal(fbe_packet_t
 fbe_status_t persist_set_database_lun_completion(fbe_packet_t * request_packet, fbe_packet_completion_context_t notused);
 fbe_status_t fbe_persist_transaction_validate_entry(fbe_persist_transaction_handle_t callers_tran_handle,
                                                     fbe_persist_entry_id_t entry_id);
+fbe_status_t fbe_persist_transaction_queue_single_entry(fbe_packet_t * packet);
+void fbe_persist_transaction_get_stats(fbe_persist_control_get_stats_t * get_stats);
 
 
 #endif /* FBE_PERSIST_TRANSACTION_H */
@@ -31,6 +31,7 @@
 
 typedef struct fbe_protocol_error_injection_error_element_s {
     fbe_queue_element_t queue_element;
+    fbe_queue_element_t object_queue_element; /* on the queue of the object bucket */
     fbe_protocol_error_injection_magic_number_t magic_number;
     fbe_protocol_error_injection_error_record_t protocol_error_injection_error_record;
 }fbe_protocol_error_injection_error_element_t;
@@ -88,6 +89,9 @@ static fbe_status_t protocol_error_injection_notification_callback(fbe_object_id
                                                     fbe_notification_context_t context);
 fbe_bool_t protocol_error_injection_is_record_active(fbe_protocol_error_injection_error_record_t *error_record);
 static fbe_status_t fbe_protocol_error_injection_service_remove_all_records(void);
+static fbe_protocol_error_injection_object_bucket_t * protocol_error_injection_get_object_bucket(fbe_object_id_t object_id);
+static fbe_protocol_error_injection_error_element_t * protocol_error_injection_object_queue_element_to_error_element(fbe_queue_element_t * object_queue_element_p);
+static void protocol_error_injection_inc_error_on_all_pos(fbe_protocol_error_injection_error_element_t * inserted_element_p, fbe_u32_t tag);
 
 /*!**************************************************************
  * fbe_protocol_error_injection_service_init()
@@ -105,6 +109,8 @@ static fbe_status_t fbe_protocol_error_injection_service_remove_all_records(void
  ****************************************************************/
 static fbe_status_t fbe_protocol_error_injection_service_init(fbe_packet_t * packet_p)
 {
+    fbe_u32_t bucket_index;
+
     fbe_protocol_error_injection_service_trace(FBE_TRACE_LEVEL_DEBUG_HIGH, 
                         FBE_TRACE_MESSAGE_ID_FUNCTION_ENTRY,
                         "%s: entry\n", __FUNCTION__);
@@ -117,6 +123,13 @@ static fbe_status_t fbe_protocol_error_injection_service_init(fbe_packet_t * pac
     fbe_queue_init(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue);
     fbe_spinlock_init(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue_lock);
 
+    for (bucket_index = 0; bucket_index < FBE_PROTOCOL_ERROR_INJECTION_OBJECT_BUCKETS; bucket_index++)
+    {
+        fbe_queue_init(&fbe_protocol_error_injection_service.object_buckets[bucket_index].record_queue);
+        fbe_spinlock_init(&fbe_protocol_error_injection_service.object_buckets[bucket_index].lock);
+        fbe_protocol_error_injection_service.object_buckets[bucket_index].record_count = 0;
+    }
+
     /*register with physical packge for notification. we are only interested in destroy, so that the records can be cleaned*/
 //  status = protocol_error_injection_register_notification_element(FBE_PACKAGE_ID_PHYSICAL,
 //                                                                  protocol_error_injection_notification_callback,
@@ -153,6 +166,7 @@ static fbe_status_t fbe_protocol_error_injection_service_init(fbe_packet_t * pac
 static fbe_status_t fbe_protocol_error_injection_service_destroy(fbe_packet_t * packet_p)
 {
     fbe_status_t status;
+    fbe_u32_t bucket_index;
 
     fbe_protocol_error_injection_service_trace(FBE_TRACE_LEVEL_DEBUG_HIGH, 
                        FBE_TRACE_MESSAGE_ID_FUNCTION_ENTRY,
@@ -165,6 +179,12 @@ static fbe_status_t fbe_protocol_error_injection_service_destroy(fbe_packet_t *
     fbe_queue_destroy(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue);
     fbe_spinlock_destroy(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue_lock);
 
+    for (bucket_index = 0; bucket_index < FBE_PROTOCOL_ERROR_INJECTION_OBJECT_BUCKETS; bucket_index++)
+    {
+        fbe_queue_destroy(&fbe_protocol_error_injection_service.object_buckets[bucket_index].record_queue);
+        fbe_spinlock_destroy(&fbe_protocol_error_injection_service.object_buckets[bucket_index].lock);
+    }
+
     /*unregister with physical packge for notification*/
 //  status = protocol_error_injection_unregister_notification_element(FBE_PACKAGE_ID_PHYSICAL,
 //                                                                  protocol_error_injection_notification_callback,
@@ -378,6 +398,7 @@ protocol_error_injection_add_record(fbe_protocol_error_injection_error_record_t
     fbe_protocol_error_injection_error_element_t * protocol_error_injection_error_element = NULL;
     fbe_transport_control_set_edge_tap_hook_t hook_info;
     fbe_class_id_t class_id;
+    fbe_protocol_error_injection_object_bucket_t * bucket_p = NULL;
 
     *protocol_error_injection_record_handle = NULL;
 
@@ -412,8 +433,14 @@ protocol_error_injection_add_record(fbe_protocol_error_injection_error_record_t
         return FBE_STATUS_GENERIC_FAILURE;
     }
 
+    bucket_p = protocol_error_injection_get_object_bucket(protocol_error_injection_error_element->protocol_error_injection_error_record.object_id);
+
     fbe_spinlock_lock(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue_lock);
     fbe_queue_push(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue, &protocol_error_injection_error_element->queue_element);
+    fbe_spinlock_lock(&bucket_p->lock);
+    fbe_queue_push(&bucket_p->record_queue, &protocol_error_injection_error_element->object_queue_element);
+    fbe_atomic_increment(&bucket_p->record_count);
+    fbe_spinlock_unlock(&bucket_p->lock);
     fbe_spinlock_unlock(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue_lock);
     *protocol_error_injection_record_handle = protocol_error_injection_error_element;
     return FBE_STATUS_OK;
@@ -478,6 +505,7 @@ static fbe_status_t protocol_error_injection_remove_record(fbe_protocol_error_in
     fbe_status_t status = FBE_STATUS_CONTINUE;
     fbe_protocol_error_injection_error_element_t * protocol_error_injection_error_element = NULL;
     fbe_transport_control_set_edge_tap_hook_t hook_info;
+    fbe_protocol_error_injection_object_bucket_t * bucket_p = NULL;
 
 //    PHYSICAL_ADDRESS  HighestAcceptableAddress;
 
@@ -494,8 +522,14 @@ static fbe_status_t protocol_error_injection_remove_record(fbe_protocol_error_in
         return FBE_STATUS_GENERIC_FAILURE;
     }
 
+    bucket_p = protocol_error_injection_get_object_bucket(protocol_error_injection_error_element->protocol_error_injection_error_record.object_id);
+
     fbe_spinlock_lock(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue_lock);
     fbe_queue_remove(&protocol_error_injection_error_element->queue_element);
+    fbe_spinlock_lock(&bucket_p->lock);
+    fbe_queue_remove(&protocol_error_injection_error_element->object_queue_element);
+    fbe_atomic_decrement(&bucket_p->record_count);
+    fbe_spinlock_unlock(&bucket_p->lock);
     fbe_spinlock_unlock(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue_lock);
 
     /* If we have not records for this object id we should disable the hook */
@@ -577,6 +611,7 @@ static fbe_status_t protocol_error_injection_remove_object(fbe_object_id_t objec
     fbe_transport_control_set_edge_tap_hook_t hook_info;
     fbe_status_t status;
     fbe_class_id_t class_id;
+    fbe_protocol_error_injection_object_bucket_t * bucket_p = protocol_error_injection_get_object_bucket(object_id);
 
     fbe_spinlock_lock(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue_lock);
     protocol_error_injection_error_element = (fbe_protocol_error_injection_error_element_t *)fbe_queue_front(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue);
@@ -584,6 +619,10 @@ static fbe_status_t protocol_error_injection_remove_object(fbe_object_id_t objec
         protocol_error_injection_error_element_next = (fbe_protocol_error_injection_error_element_t *)fbe_queue_next(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue, (fbe_queue_element_t *)protocol_error_injection_error_element);
         if(protocol_error_injection_error_element->protocol_error_injection_error_record.object_id == object_id){ /* We found our record */
             fbe_queue_remove((fbe_queue_element_t *)protocol_error_injection_error_element);
+            fbe_spinlock_lock(&bucket_p->lock);
+            fbe_queue_remove(&protocol_error_injection_error_element->object_queue_element);
+            fbe_atomic_decrement(&bucket_p->record_count);
+            fbe_spinlock_unlock(&bucket_p->lock);
             fbe_release_contiguous_memory(protocol_error_injection_error_element);
         }
         protocol_error_injection_error_element = protocol_error_injection_error_element_next;
@@ -1188,7 +1227,9 @@ protocol_error_injection_edge_hook_function(fbe_packet_t * packet)
 {
     /* Find record by object_id */
     fbe_protocol_error_injection_error_element_t * protocol_error_injection_error_element = NULL;
-    fbe_protocol_error_injection_error_element_t * main_protocol_error_injection_error_element = NULL;
+    fbe_protocol_error_injection_object_bucket_t * bucket_p = NULL;
+    fbe_queue_element_t * queue_element_p = NULL;
+    fbe_u32_t tag;
     fbe_base_edge_t * edge;
     fbe_object_id_t client_id;
     fbe_transport_id_t transport_id;
@@ -1234,6 +1275,15 @@ protocol_error_injection_edge_hook_function(fbe_packet_t * packet)
     fbe_base_transport_get_client_id(edge, &client_id);
     fbe_base_transport_get_transport_id(edge, &transport_id);
 
+    /* Only the records of this object's bucket can match.  If the bucket is empty
+     * there is nothing to inject, so skip the lock.
+     */
+    bucket_p = protocol_error_injection_get_object_bucket(client_id);
+    if (bucket_p->record_count == 0)
+    {
+        return FBE_STATUS_CONTINUE;
+    }
+
     /* Check the transport type */
     if(transport_id == FBE_TRANSPORT_ID_SSP){
         cdb_operation = fbe_payload_ex_get_cdb_operation(payload);
@@ -1262,17 +1312,17 @@ protocol_error_injection_edge_hook_function(fbe_packet_t * packet)
         return FBE_STATUS_CONTINUE; /* We do not want to be too disruptive */
     }
 
-    fbe_spinlock_lock(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue_lock);
-    protocol_error_injection_error_element = (fbe_protocol_error_injection_error_element_t *)fbe_queue_front(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue);
-    main_protocol_error_injection_error_element = protocol_error_injection_error_element;
-    while(protocol_error_injection_error_element != NULL){
+    fbe_spinlock_lock(&bucket_p->lock);
+    queue_element_p = fbe_queue_front(&bucket_p->record_queue);
+    while(queue_element_p != NULL){
+        protocol_error_injection_error_element = protocol_error_injection_object_queue_element_to_error_element(queue_element_p);
         if(protocol_error_injection_error_element->protocol_error_injection_error_record.object_id == client_id){ /* We found our record */
                        
             switch(protocol_error_injection_error_element->protocol_error_injection_error_record.protocol_error_injection_error_type)
             {
                 case FBE_PROTOCOL_ERROR_INJECTION_ERROR_TYPE_PORT:
                     status = protocol_error_injection_handle_port_error(packet, &protocol_error_injection_error_element->protocol_error_injection_error_record);
-                    fbe_spinlock_unlock(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue_lock);
+                    fbe_spinlock_unlock(&bucket_p->lock);
                     if(status != FBE_STATUS_CONTINUE){
                         fbe_transport_set_status(packet, status, 0);
                         fbe_transport_complete_packet_async(packet);                        
@@ -1286,7 +1336,7 @@ protocol_error_injection_edge_hook_function(fbe_packet_t * packet)
                         if(fis_operation != NULL)
                         {
                             status = protocol_error_injection_handle_fis_error(fis_operation, &protocol_error_injection_error_element->protocol_error_injection_error_record);
-                            fbe_spinlock_unlock(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue_lock);
+                            fbe_spinlock_unlock(&bucket_p->lock);
                             if (status == FBE_STATUS_OK)
                             {
                                 fbe_transport_set_status(packet, FBE_STATUS_OK, 0);
@@ -1300,36 +1350,18 @@ protocol_error_injection_edge_hook_function(fbe_packet_t * packet)
                 case FBE_PROTOCOL_ERROR_INJECTION_ERROR_TYPE_SCSI:
                     if (protocol_error_injection_error_element->protocol_error_injection_error_record.b_inc_error_on_all_pos)
                     {
-                        fbe_protocol_error_injection_error_record_t *error_record_main = &(protocol_error_injection_error_element->protocol_error_injection_error_record);
                         if (protocol_error_injection_error_element->protocol_error_injection_error_record.num_of_times_to_insert > protocol_error_injection_error_element->protocol_error_injection_error_record.times_inserted)
                         {
-                            fbe_protocol_error_injection_error_element_t *main_protocol_error_injection_error_element_temp = main_protocol_error_injection_error_element;
                             if(cdb_operation != NULL)
                             {
                                 status = protocol_error_injection_insert_scsi_error(packet, payload, cdb_operation, protocol_error_injection_error_element);
                                 if (status != FBE_STATUS_CONTINUE) {   
-                                    while(main_protocol_error_injection_error_element_temp != NULL)
-                                    {
-                                        fbe_protocol_error_injection_error_record_t *error_record = &(main_protocol_error_injection_error_element_temp->protocol_error_injection_error_record);
-                                        /*Increment the error counters of the record for which tag value is similar */
-                                        if( (main_protocol_error_injection_error_element_temp != protocol_error_injection_error_element) && 
-                                            (error_record->tag == error_record_main->tag))
-                                        {
-                                            error_record->times_inserted++;
-                                            /*Split trace to two lines*/
-                                            fbe_protocol_error_injection_service_trace(FBE_TRACE_LEVEL_INFO,
-                                                                           FBE_TRACE_MESSAGE_ID_INFO,
-                                                                           "%s Increment times insert for err record tmp pos 0x%x>\n", 
-                                                                           __FUNCTION__, error_record->times_inserted);
-                                            fbe_protocol_error_injection_service_trace(FBE_TRACE_LEVEL_INFO,
-                                                                           FBE_TRACE_MESSAGE_ID_INFO,
-                                                                           "%s err_rec_tmp->num_of_times_to_ins 0x%x obj_id:0x%x<\n", 
-                                                                           __FUNCTION__, error_record->num_of_times_to_insert, 
-                                                                           protocol_error_injection_error_element->protocol_error_injection_error_record.object_id);
-                                        }
-                                        main_protocol_error_injection_error_element_temp = (fbe_protocol_error_injection_error_element_t *)fbe_queue_next(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue, (fbe_queue_element_t *)main_protocol_error_injection_error_element_temp);
-                                    }
-                                    fbe_spinlock_unlock(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue_lock);  
+                                    /* The records with the same tag can belong to any object, 
+                                     * so drop our bucket lock before we go look for them. 
+                                     */
+                                    tag = protocol_error_injection_error_element->protocol_error_injection_error_record.tag;
+                                    fbe_spinlock_unlock(&bucket_p->lock);  
+                                    protocol_error_injection_inc_error_on_all_pos(protocol_error_injection_error_element, tag);
                                     fbe_transport_set_status(packet, status, 0);
                                     fbe_transport_complete_packet_async(packet);
                                     return status;
@@ -1342,11 +1374,11 @@ protocol_error_injection_edge_hook_function(fbe_packet_t * packet)
                     {
                         status = protocol_error_injection_insert_scsi_error(packet, payload, cdb_operation, protocol_error_injection_error_element);
                         if (status == FBE_STATUS_NO_ACTION) {   
-                            fbe_spinlock_unlock(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue_lock); 
+                            fbe_spinlock_unlock(&bucket_p->lock); 
                             return status;
                         }
                         if (status != FBE_STATUS_CONTINUE) {   
-                            fbe_spinlock_unlock(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue_lock);  
+                            fbe_spinlock_unlock(&bucket_p->lock);  
                             fbe_transport_set_status(packet, status, 0);
                             fbe_transport_complete_packet_async(packet);
                             return status;
@@ -1357,7 +1389,7 @@ protocol_error_injection_edge_hook_function(fbe_packet_t * packet)
                     break;
 
                 default: 
-                    fbe_spinlock_unlock(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue_lock);
+                    fbe_spinlock_unlock(&bucket_p->lock);
                     fbe_protocol_error_injection_service_trace(FBE_TRACE_LEVEL_ERROR,
                                            FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
                                            "%s Invalid protocol_error_injection_error_type %X\n", __FUNCTION__, protocol_error_injection_error_element->protocol_error_injection_error_record.protocol_error_injection_error_type);
@@ -1365,33 +1397,138 @@ protocol_error_injection_edge_hook_function(fbe_packet_t * packet)
             }
         } /* It is not our record */
 
-        protocol_error_injection_error_element = (fbe_protocol_error_injection_error_element_t *)fbe_queue_next(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue, (fbe_queue_element_t *)protocol_error_injection_error_element);
-    }/* while(protocol_error_injection_error_element != NULL) */
+        queue_element_p = fbe_queue_next(&bucket_p->record_queue, queue_element_p);
+    }/* while(queue_element_p != NULL) */
 
-    fbe_spinlock_unlock(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue_lock);
+    fbe_spinlock_unlock(&bucket_p->lock);
 
     return FBE_STATUS_CONTINUE;
 }
 /**************************************
  * end protocol_error_injection_edge_hook_function()
  **************************************/
+
+/*!**************************************************************
+ * protocol_error_injection_inc_error_on_all_pos()
+ ****************************************************************
+ * @brief
+ *  An error was inserted for a record with b_inc_error_on_all_pos
+ *  set.  Count it against every other record with the same tag.
+ *  The caller must not hold a bucket lock.
+ *
+ * @param inserted_element_p - Element we inserted the error for.
+ * @param tag - Tag of that record.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void 
+protocol_error_injection_inc_error_on_all_pos(fbe_protocol_error_injection_error_element_t * inserted_element_p, fbe_u32_t tag)
+{
+    fbe_protocol_error_injection_error_element_t *protocol_error_injection_error_element = NULL;
+    fbe_protocol_error_injection_error_record_t *error_record = NULL;
+    fbe_protocol_error_injection_object_bucket_t *bucket_p = NULL;
+
+    fbe_spinlock_lock(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue_lock);
+    protocol_error_injection_error_element = (fbe_protocol_error_injection_error_element_t *)fbe_queue_front(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue);
+    while(protocol_error_injection_error_element != NULL)
+    {
+        error_record = &(protocol_error_injection_error_element->protocol_error_injection_error_record);
+        /*Increment the error counters of the record for which tag value is similar */
+        if( (protocol_error_injection_error_element != inserted_element_p) && 
+            (error_record->tag == tag))
+        {
+            /* The hit counters are protected by the lock of the record's bucket.
+             */
+            bucket_p = protocol_error_injection_get_object_bucket(error_record->object_id);
+            fbe_spinlock_lock(&bucket_p->lock);
+            error_record->times_inserted++;
+            fbe_spinlock_unlock(&bucket_p->lock);
+            /*Split trace to two lines*/
+            fbe_protocol_error_injection_service_trace(FBE_TRACE_LEVEL_INFO,
+                                           FBE_TRACE_MESSAGE_ID_INFO,
+                                           "%s Increment times insert for err record tmp pos 0x%x>\n", 
+                                           __FUNCTION__, error_record->times_inserted);
+            fbe_protocol_error_injection_service_trace(FBE_TRACE_LEVEL_INFO,
+                                           FBE_TRACE_MESSAGE_ID_INFO,
+                                           "%s err_rec_tmp->num_of_times_to_ins 0x%x obj_id:0x%x<\n", 
+                                           __FUNCTION__, error_record->num_of_times_to_insert, 
+                                           error_record->object_id);
+        }
+        protocol_error_injection_error_element = (fbe_protocol_error_injection_error_element_t *)fbe_queue_next(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue, (fbe_queue_element_t *)protocol_error_injection_error_element);
+    }
+    fbe_spinlock_unlock(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue_lock);
+    return;
+}
+/**************************************
+ * end protocol_error_injection_inc_error_on_all_pos()
+ **************************************/
+
+/*!**************************************************************
+ * protocol_error_injection_get_object_bucket()
+ ****************************************************************
+ * @brief
+ *  Return the bucket of the per object index for this object.
+ *
+ * @param object_id - Object to get the bucket for.
+ *
+ * @return fbe_protocol_error_injection_object_bucket_t *
+ *
+ ****************************************************************/
+static fbe_protocol_error_injection_object_bucket_t * 
+protocol_error_injection_get_object_bucket(fbe_object_id_t object_id)
+{
+    return &fbe_protocol_error_injection_service.object_buckets[object_id & (FBE_PROTOCOL_ERROR_INJECTION_OBJECT_BUCKETS - 1)];
+}
+/**************************************
+ * end protocol_error_injection_get_object_bucket()
+ **************************************/
+
+/*!**************************************************************
+ * protocol_error_injection_object_queue_element_to_error_element()
+ ****************************************************************
+ * @brief
+ *  Convert the object queue element of an error element into a
+ *  pointer to the error element.
+ *
+ * @param object_queue_element_p - Queue element on the bucket queue.
+ *
+ * @return fbe_protocol_error_injection_error_element_t *
+ *
+ ****************************************************************/
+static fbe_protocol_error_injection_error_element_t * 
+protocol_error_injection_object_queue_element_to_error_element(fbe_queue_element_t * object_queue_element_p)
+{
+    /* Subtract the offset of the queue element from its address.
+     */
+    fbe_protocol_error_injection_error_element_t * element_p;
+    element_p = (fbe_protocol_error_injection_error_element_t *)((fbe_u8_t *)object_queue_element_p - 
+                    (fbe_u8_t *)(&((fbe_protocol_error_injection_error_element_t *)0)->object_queue_element));
+    return element_p;
+}
+/**************************************
+ * end protocol_error_injection_object_queue_element_to_error_element()
+ **************************************/
 static fbe_protocol_error_injection_error_element_t * 
 protocol_error_injection_find_error_element_by_object_id(fbe_object_id_t object_id)
 {
     fbe_protocol_error_injection_error_element_t * protocol_error_injection_error_element = NULL;
+    fbe_protocol_error_injection_object_bucket_t * bucket_p = protocol_error_injection_get_object_bucket(object_id);
+    fbe_queue_element_t * queue_element_p = NULL;
 
-    fbe_spinlock_lock(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue_lock);
-    protocol_error_injection_error_element = (fbe_protocol_error_injection_error_element_t *)fbe_queue_front(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue);
-    while(protocol_error_injection_error_element != NULL){
+    fbe_spinlock_lock(&bucket_p->lock);
+    queue_element_p = fbe_queue_front(&bucket_p->record_queue);
+    while(queue_element_p != NULL){
+        protocol_error_injection_error_element = protocol_error_injection_object_queue_element_to_error_element(queue_element_p);
         if(protocol_error_injection_error_element->protocol_error_injection_error_record.object_id == object_id){ /* We found our record */
-            fbe_spinlock_unlock(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue_lock);
+            fbe_spinlock_unlock(&bucket_p->lock);
             return protocol_error_injection_error_element;
         } else {
-            protocol_error_injection_error_element = (fbe_protocol_error_injection_error_element_t *)fbe_queue_next(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue, (fbe_queue_element_t *)protocol_error_injection_error_element);
+            queue_element_p = fbe_queue_next(&bucket_p->record_queue, queue_element_p);
         }
-    }/* while(protocol_error_injection_error_element != NULL) */
+    }/* while(queue_element_p != NULL) */
 
-    fbe_spinlock_unlock(&fbe_protocol_error_injection_service.protocol_error_injection_error_queue_lock);
+    fbe_spinlock_unlock(&bucket_p->lock);
     return NULL;
 }
 /**************************************
@@ -25,6 +25,7 @@
 #include "fbe/fbe_types.h"
 #include "fbe/fbe_queue.h"
 #include "fbe/fbe_memory.h"
+#include "fbe/fbe_atomic.h"
 #include "fbe/fbe_winddk.h"
 #include "fbe_base_object.h"
 #include "fbe_base_service.h"
@@ -37,6 +38,43 @@
 
 #define FBE_PROTOCOL_ERROR_INJECTION_INVALID 0xFFFFFFFF
 
+/*!*******************************************************************
+ * @def FBE_PROTOCOL_ERROR_INJECTION_OBJECT_BUCKETS
+ *********************************************************************
+ * @brief
+ *  Number of buckets in the per object index of the error records.
+ *  The bucket is picked by masking the object id so this must be a
+ *  power of two.
+ *
+ *********************************************************************/
+#define FBE_PROTOCOL_ERROR_INJECTION_OBJECT_BUCKETS 256
+
+/*!*******************************************************************
+ * @struct fbe_protocol_error_injection_object_bucket_t
+ *********************************************************************
+ * @brief
+ *  One bucket of the per object index.  The edge hook only looks at
+ *  the records of the bucket of the object the I/O is for, so I/O to
+ *  one drive does not contend with the records of the other drives.
+ *
+ *********************************************************************/
+typedef struct fbe_protocol_error_injection_object_bucket_s
+{
+    /*! Protects the queue and the hit counters of its records.
+     */
+    fbe_spinlock_t   lock;
+
+    /*! Records of all the objects that hash to this bucket.
+     */
+    fbe_queue_head_t record_queue;
+
+    /*! Number of records on the queue.  The edge hook reads this
+     *  without the lock to skip objects that have nothing armed.
+     */
+    fbe_atomic_t     record_count;
+}
+fbe_protocol_error_injection_object_bucket_t;
+
 /*************************
  *   FUNCTION DEFINITIONS
  *************************/
@@ -61,6 +99,11 @@ typedef struct fbe_protocol_error_injection_service_s
      * which track all error to be injected. 
      */
     fbe_queue_head_t protocol_error_injection_error_queue;
+
+    /*! The same records indexed by object id.  When both locks are 
+     * needed the queue lock above is always taken first. 
+     */
+    fbe_protocol_error_injection_object_bucket_t object_buckets[FBE_PROTOCOL_ERROR_INJECTION_OBJECT_BUCKETS];
 }fbe_protocol_error_injection_service_t;
 
 void fbe_protocol_error_injection_service_trace(fbe_trace_level_t trace_level,
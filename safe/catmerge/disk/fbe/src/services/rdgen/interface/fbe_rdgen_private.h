@@ -174,6 +174,25 @@ enum fbe_rdgen_constants_e
  ***************************************************/
 #define FBE_RDGEN_MAX_IO_MSECS 60 * 1000
 
+/*!**************************************************
+ * @def FBE_RDGEN_ARRIVAL_POLL_USEC
+ ***************************************************
+ * @brief Once the next arrival is due within this many
+ *        usecs the arrival thread polls the clock instead
+ *        of waiting on its event.  An event wait is never
+ *        shorter than the minimum timeout and can overrun
+ *        it by about as much again.
+ ***************************************************/
+#define FBE_RDGEN_ARRIVAL_POLL_USEC (2 * EMCPAL_MINIMUM_TIMEOUT_MSECS * FBE_TIME_MILLISECONDS_PER_MICROSECOND)
+
+/*!**************************************************
+ * @def FBE_RDGEN_POISSON_GAP_TABLE_SIZE
+ ***************************************************
+ * @brief Number of points we sample the exponential
+ *        distribution at to pick poisson arrival gaps.
+ ***************************************************/
+#define FBE_RDGEN_POISSON_GAP_TABLE_SIZE 128
+
 /*!*******************************************************************
  * @def FBE_RDGEN_MAX_TRACE_CHARS
  *********************************************************************
@@ -369,6 +388,10 @@ typedef struct fbe_rdgen_service_s
      */
     fbe_rdgen_thread_t object_thread;
 
+    /*! Thread to hold open loop I/Os until they arrive.
+     */
+    fbe_rdgen_thread_t arrival_thread;
+
     /*! Thread to scan for I/Os that are taking too long.
      */
     fbe_rdgen_thread_t scan_thread;
@@ -385,6 +408,11 @@ typedef struct fbe_rdgen_service_s
      */
     fbe_rdgen_io_statistics_t historical_stats;
 
+    /*! Latency histograms of every ts that finished since the last reset.
+     *  Only updated under the rdgen lock.
+     */
+    fbe_rdgen_latency_histogram_t historical_latency[FBE_RDGEN_LATENCY_TYPE_LAST];
+
     fbe_u32_t num_outstanding_peer_req; /*!< Number of requests outstanding to peer.  */
 
     fbe_u32_t random_context; /*! Used to seed all our random numbers. */
@@ -479,8 +507,10 @@ typedef struct fbe_rdgen_object_file_record_s
     fbe_u32_t msec_to_ramp; /*!< number of milliseconds to ramp up. */
     fbe_u32_t priority;
     fbe_u32_t io_interface; /*!< Interface to be used for this I/O. */
-    fbe_u32_t reserved_1;
-    fbe_u32_t reserved_2;
+    /*! Usecs from the start of the playback this I/O arrives at.
+     *  Filled in for text traces only, 0 in rdgen files.
+     */
+    fbe_u64_t arrival_usec;
 }
 fbe_rdgen_object_file_record_t;
 #pragma pack()
@@ -490,6 +520,8 @@ enum {
     FBE_RDGEN_PLAYBACK_RECORDS_PER_BUFFER = ( (512*64) / sizeof(fbe_rdgen_object_file_record_t)),
     /*! Number of buffers to allocate at once. */
     FBE_RDGEN_PLAYBACK_CHUNK_COUNT = 2, 
+    /*! Bytes we read at once when parsing a text trace, also the longest line we accept. */
+    FBE_RDGEN_PLAYBACK_TEXT_BUFFER_BYTES = 4096,
 };
 
 /*!*******************************************************************
@@ -646,6 +678,27 @@ typedef struct fbe_rdgen_object_s
     fbe_u32_t restart_msec;
     fbe_time_t time_to_restart;
 
+    /*! Text traces are parsed into records as they are read.  
+     *  The whole trace is scanned once up front to count the records, 
+     *  and find the lba range and time span used for scaling. 
+     */
+    fbe_rdgen_playback_format_t playback_format;
+    fbe_u64_t playback_file_offset; /*!< Offset of the next line to parse. */
+    fbe_u32_t playback_trace_threads; /*!< Threads to replay the trace with. */
+    fbe_lba_t playback_trace_end_lba; /*!< End of the highest I/O in the trace. */
+    fbe_u64_t playback_trace_start_usec; /*!< Time stamp of the first I/O in the trace. */
+    fbe_u64_t playback_trace_end_usec; /*!< Time stamp of the last I/O in the trace. */
+    fbe_u64_t playback_pass_usec; /*!< Added to the arrivals of the current pass. */
+    fbe_u32_t playback_cpu; /*!< Round robins cores for formats without a cpu. */
+    fbe_bool_t b_playback_scale_lba;
+
+    /*! When timing is kept, arrivals are relative to when the first I/O 
+     *  was generated, stretched by the time scale. 
+     */
+    fbe_bool_t b_playback_timing;
+    fbe_u32_t playback_time_scale_percent;
+    fbe_time_t playback_start_time;
+
     fbe_u64_t random_context; /*! Seed for generating object random numbers. */
 }
 fbe_rdgen_object_t;
@@ -903,6 +956,13 @@ typedef struct fbe_rdgen_ts_s
      */
     fbe_time_t last_send_time;
 
+    /*! Open loop only.  Time the next I/O is scheduled to arrive, 
+     *  and the arrival time the I/O about to be sent is timed from. 
+     *  arrival_time is cleared once the I/O is sent. 
+     */
+    fbe_time_t next_arrival_time;
+    fbe_time_t arrival_time;
+
     fbe_time_t last_response_time;/*!< Last response took this long. */
     fbe_time_t max_response_time; /*!< Max of all responses. */
     /*! Every time we increment io count we also increment this. 
@@ -911,6 +971,11 @@ typedef struct fbe_rdgen_ts_s
     fbe_time_t cumulative_response_time;
     fbe_u64_t total_responses; /*!< Number of responses that have gone into cumulative. */
 
+    /*! Response time histograms split by read and write. 
+     * Only the completion of this ts updates these, so no locks are needed. 
+     */
+    fbe_rdgen_latency_histogram_t latency_histogram[FBE_RDGEN_LATENCY_TYPE_LAST];
+
     /*! Time when this thread started.
      */
     fbe_time_t start_time;
@@ -1144,6 +1209,8 @@ fbe_bool_t fbe_rdgen_object_is_lun_destroy_registered(void);
 fbe_status_t fbe_rdgen_object_register_lun_destroy_notifications(void);
 fbe_status_t fbe_rdgen_object_unregister_lun_destroy_notifications(void);
 void fbe_rdgen_object_set_file(fbe_rdgen_object_t *object_p, fbe_char_t *file_p);
+void fbe_rdgen_object_set_playback_options(fbe_rdgen_object_t *object_p,
+                                           fbe_rdgen_io_specification_t *spec_p);
 fbe_rdgen_object_t * fbe_rdgen_object_thread_queue_element_to_ts_ptr(fbe_queue_element_t * thread_queue_element_p);
 fbe_rdgen_object_t * fbe_rdgen_object_process_queue_element_to_ts_ptr(fbe_queue_element_t * thread_queue_element_p);
 fbe_status_t fbe_rdgen_object_enqueue_to_thread(fbe_rdgen_object_t *object_p);
@@ -1241,6 +1308,9 @@ fbe_bool_t fbe_rdgen_ts_is_playback(fbe_rdgen_ts_t *ts_p);
 fbe_rdgen_ts_state_status_t fbe_rdgen_ts_generate_playback(fbe_rdgen_ts_t *ts_p);
 fbe_rdgen_ts_state_status_t fbe_rdgen_ts_set_first_state(fbe_rdgen_ts_t *ts_p,
                                                          fbe_rdgen_ts_state_t state);
+fbe_rdgen_ts_state_status_t fbe_rdgen_ts_wait_for_arrival(fbe_rdgen_ts_t *ts_p,
+                                                          fbe_rdgen_ts_state_t state);
+void fbe_rdgen_arrival_thread_enqueue(fbe_rdgen_ts_t *ts_p);
 void fbe_rdgen_ts_init_random(fbe_rdgen_ts_t *ts_p);
 void fbe_rdgen_ts_save_context(fbe_rdgen_ts_t *ts_p);
 
@@ -1277,6 +1347,14 @@ fbe_data_pattern_sp_id_t fbe_rdgen_cmi_get_sp_id(void);
  */
 fbe_status_t fbe_rdgen_playback_get_header(fbe_u32_t *targets_p,
                                            fbe_rdgen_root_file_filter_t **filter_p, fbe_char_t *file_p);
+fbe_status_t fbe_rdgen_playback_get_targets(fbe_rdgen_control_start_io_t *start_p,
+                                            fbe_u32_t *targets_p,
+                                            fbe_rdgen_root_file_filter_t **filter_p);
+fbe_bool_t fbe_rdgen_playback_parse_trace_line(fbe_rdgen_playback_format_t format,
+                                               fbe_char_t *line_p,
+                                               fbe_rdgen_object_file_record_t *record_p,
+                                               fbe_u64_t *time_usec_p);
+fbe_lba_t fbe_rdgen_playback_scale_lba(fbe_lba_t lba, fbe_lba_t trace_end_lba, fbe_lba_t capacity);
 fbe_bool_t fbe_rdgen_playback_generate_wait(fbe_rdgen_ts_t *ts_p);
 void fbe_rdgen_playback_handle_objects(fbe_rdgen_thread_t *thread_p,
                                        fbe_time_t *min_msecs_to_wait_p);
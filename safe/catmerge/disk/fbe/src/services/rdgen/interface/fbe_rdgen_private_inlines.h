@@ -148,6 +148,12 @@ static __forceinline fbe_status_t fbe_rdgen_get_object_thread(fbe_rdgen_thread_t
     *thread_p = &rdgen_p->object_thread;
     return FBE_STATUS_OK;
 }
+static __forceinline fbe_status_t fbe_rdgen_get_arrival_thread(fbe_rdgen_thread_t **thread_p)
+{
+    fbe_rdgen_service_t *rdgen_p = fbe_get_rdgen_service();
+    *thread_p = &rdgen_p->arrival_thread;
+    return FBE_STATUS_OK;
+}
 static __forceinline void fbe_rdgen_setup_thread_pool(fbe_rdgen_thread_t *thread_p)
 {
     fbe_rdgen_service_t *rdgen_p = fbe_get_rdgen_service();
@@ -170,6 +176,7 @@ static void fbe_rdgen_service_clear_io_statistics(void)
 {
     fbe_rdgen_service_t *rdgen_p = fbe_get_rdgen_service();
     fbe_zero_memory(&rdgen_p->historical_stats, sizeof(fbe_rdgen_io_statistics_t));
+    fbe_zero_memory(&rdgen_p->historical_latency[0], sizeof(rdgen_p->historical_latency));
 }
 
 static __forceinline void fbe_rdgen_inc_requests_from_peer(void)
@@ -195,6 +202,11 @@ static __forceinline fbe_rdgen_io_statistics_t* fbe_rdgen_get_historical_stats(v
     fbe_rdgen_service_t *rdgen_p = fbe_get_rdgen_service();
     return &rdgen_p->historical_stats;
 }
+static __forceinline fbe_rdgen_latency_histogram_t* fbe_rdgen_get_historical_latency(fbe_rdgen_latency_type_t latency_type)
+{
+    fbe_rdgen_service_t *rdgen_p = fbe_get_rdgen_service();
+    return &rdgen_p->historical_latency[latency_type];
+}
 
 /* Accessors for the number of outstanding peer requests.
  */
@@ -660,6 +672,10 @@ static __forceinline fbe_u32_t fbe_rdgen_object_get_restart_msec(fbe_rdgen_objec
 {
     return object_p->playback_records_p->record_data[object_p->playback_record_index].msec_to_ramp;
 }
+static __forceinline fbe_bool_t fbe_rdgen_object_is_playback_trace(fbe_rdgen_object_t *object_p)
+{
+    return (object_p->playback_format != FBE_RDGEN_PLAYBACK_FORMAT_RDGEN);
+}
 static __forceinline void fbe_rdgen_object_inc_playback_index(fbe_rdgen_object_t *object_p)
 {
     object_p->playback_record_index++;
@@ -1528,8 +1544,22 @@ static __forceinline void fbe_rdgen_ts_clear_flag(fbe_rdgen_ts_t *raid_p,
 static __forceinline void fbe_rdgen_ts_update_last_send_time(fbe_rdgen_ts_t *ts_p)
 {
     ts_p->last_send_time = fbe_get_time_in_us();
+
+    /* Open loop I/Os are timed from when they were scheduled to arrive, 
+     * so time spent behind schedule counts toward the response time. 
+     * They are never released before their arrival.
+     */
+    if (ts_p->arrival_time != 0)
+    {
+        ts_p->last_send_time = ts_p->arrival_time;
+    }
+    ts_p->arrival_time = 0;
     return;
 }
+static __forceinline fbe_bool_t fbe_rdgen_ts_is_open_loop(fbe_rdgen_ts_t *ts_p)
+{
+    return (ts_p->request_p->specification.arrival_mode != FBE_RDGEN_ARRIVAL_MODE_CLOSED_LOOP);
+}
 static __forceinline void fbe_rdgen_ts_update_start_time(fbe_rdgen_ts_t *ts_p)
 {
     ts_p->start_time = fbe_get_time();
@@ -1618,6 +1648,33 @@ static __forceinline void fbe_rdgen_ts_reset_stats(fbe_rdgen_ts_t *ts_p)
     ts_p->invalid_request_err_count = 0;
     ts_p->bad_crc_blocks_count = 0;
     ts_p->lock_conflict_count = 0;
+    fbe_zero_memory(&ts_p->latency_histogram[0], sizeof(ts_p->latency_histogram));
+    return;
+}
+/*!**************************************************************
+ * fbe_rdgen_ts_update_latency_histogram()
+ ****************************************************************
+ * @brief
+ *  Add this response to the read or write histogram of the ts.
+ *  Only the ts completion calls this, so this is safe without
+ *  a lock even with FBE_RDGEN_OPTIONS_PERFORMANCE.
+ *
+ * @param ts_p - Current ts.
+ * @param last_response_time - Response time in microseconds.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static __forceinline void fbe_rdgen_ts_update_latency_histogram(fbe_rdgen_ts_t *ts_p,
+                                                                fbe_time_t last_response_time)
+{
+    fbe_rdgen_latency_type_t latency_type = FBE_RDGEN_LATENCY_TYPE_READ;
+
+    if (fbe_payload_block_operation_opcode_is_media_modify(ts_p->block_opcode))
+    {
+        latency_type = FBE_RDGEN_LATENCY_TYPE_WRITE;
+    }
+    fbe_rdgen_latency_histogram_add_sample(&ts_p->latency_histogram[latency_type], last_response_time);
     return;
 }
 static __forceinline void fbe_rdgen_ts_update_cum_resp_time(fbe_rdgen_ts_t *ts_p,
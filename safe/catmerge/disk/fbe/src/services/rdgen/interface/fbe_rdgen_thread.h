@@ -51,6 +51,10 @@ typedef enum fbe_rdgen_thread_type_e
     /*! Thread to coordinate playback.
      */
     FBE_RDGEN_THREAD_TYPE_OBJECT_PLAYBACK,
+
+    /*! Thread to release open loop I/Os at their scheduled arrival time.
+     */
+    FBE_RDGEN_THREAD_TYPE_ARRIVAL,
 }
 fbe_rdgen_thread_type_t;
 
@@ -62,6 +66,15 @@ fbe_rdgen_thread_type_t;
  *********************************************************************/
 #define FBE_RDGEN_THREAD_MAX_SCAN_SECONDS 15
 
+/*!*******************************************************************
+ * @def FBE_RDGEN_THREAD_MAX_ARRIVAL_WAIT_MSECS
+ *********************************************************************
+ * @brief Max time the arrival thread sleeps.  Bounds how long an
+ *        aborted ts can sit waiting for its next arrival.
+ *
+ *********************************************************************/
+#define FBE_RDGEN_THREAD_MAX_ARRIVAL_WAIT_MSECS 1000
+
 /*!*******************************************************************
  * @enum fbe_rdgen_thread_flags_t
  *********************************************************************
@@ -175,6 +188,7 @@ fbe_bool_t fbe_rdgen_peer_thread_is_empty(void);
 void fbe_rdgen_wakeup_abort_thread(void);
 void fbe_rdgen_peer_thread_signal(void);
 void fbe_rdgen_object_thread_signal(void);
+void fbe_rdgen_wakeup_arrival_thread(void);
 
 /*************************
  * end file fbe_rdgen_thread.h
@@ -584,6 +584,7 @@ EMCPAL_STATUS fbe_rdgen_ts_irp_completion(PEMCPAL_DEVICE_OBJECT device_object_p,
     fbe_rdgen_ts_set_last_response_time(ts_p, usec);
     fbe_rdgen_ts_update_cum_resp_time(ts_p, usec);
     fbe_rdgen_ts_update_max_response_time(ts_p, usec);
+    fbe_rdgen_ts_update_latency_histogram(ts_p, usec);
 
     /* Save the status of the operation in the ts last packet status. 
      */ 
@@ -1737,6 +1738,7 @@ fbe_status_t fbe_rdgen_ts_send_to_bdev(fbe_rdgen_ts_t *ts_p,
     fbe_rdgen_ts_set_last_response_time(ts_p, usec);
     fbe_rdgen_ts_update_cum_resp_time(ts_p, usec);
     fbe_rdgen_ts_update_max_response_time(ts_p, usec);
+    fbe_rdgen_ts_update_latency_histogram(ts_p, usec);
 
     fbe_rdgen_ts_enqueue_to_thread(ts_p);
 
@@ -45,6 +45,7 @@ static fbe_status_t fbe_rdgen_service_reset_stats(fbe_packet_t * packet);
 static fbe_status_t fbe_rdgen_service_get_object_info(fbe_packet_t * packet_p);
 static fbe_status_t fbe_rdgen_service_get_request_info(fbe_packet_t * packet_p);
 static fbe_status_t fbe_rdgen_service_get_thread_info(fbe_packet_t * packet_p);
+static fbe_status_t fbe_rdgen_service_get_latency_histogram(fbe_packet_t * packet_p);
 static fbe_rdgen_service_t *fbe_rdgen_service_p = NULL;
 static fbe_status_t fbe_rdgen_start_io_on_object_allocate(fbe_packet_t *packet_p, 
                                                           fbe_rdgen_control_start_io_t * start_io_p,
@@ -296,6 +297,7 @@ static fbe_status_t fbe_rdgen_service_init(fbe_packet_t * packet_p)
     fbe_rdgen_thread_init_flags(&fbe_rdgen_service_p->scan_thread);
     fbe_rdgen_thread_init_flags(&fbe_rdgen_service_p->peer_thread);
     fbe_rdgen_thread_init_flags(&fbe_rdgen_service_p->object_thread);
+    fbe_rdgen_thread_init_flags(&fbe_rdgen_service_p->arrival_thread);
     fbe_rdgen_set_random_seed((fbe_u32_t)fbe_get_time());
     fbe_rdgen_init_peer_request_pool();
 
@@ -507,6 +509,19 @@ static fbe_status_t fbe_rdgen_initialize_all_threads(void)
                                 "%s: error initializing abort thread status: 0x%x\n", 
                                 __FUNCTION__, status);
     }
+
+    status = fbe_rdgen_thread_init(&fbe_rdgen_service_p->arrival_thread,
+                                   "fbe_rdgen_arrival",
+                                   FBE_RDGEN_THREAD_TYPE_ARRIVAL,
+                                   FBE_U32_MAX /* thread num not used since just one. */);
+
+    if (status != FBE_STATUS_OK)
+    {
+        fbe_rdgen_service_trace(FBE_TRACE_LEVEL_ERROR, 
+                                FBE_TRACE_MESSAGE_ID_INFO,
+                                "%s: error initializing arrival thread status: 0x%x\n", 
+                                __FUNCTION__, status);
+    }
 /* We likely do not need this thread since we have the abort thread.
  */
 #if 0
@@ -690,6 +705,11 @@ static fbe_status_t fbe_rdgen_destroy_threads(void)
         {
             return status;
         }
+        status = fbe_rdgen_thread_destroy(&fbe_rdgen_service_p->arrival_thread);
+        if (status != FBE_STATUS_OK)
+        {
+            return status;
+        }
     }
     /* Clear initializing to indicate we are done.
      */
@@ -1256,6 +1276,9 @@ fbe_status_t fbe_rdgen_service_control_entry(fbe_packet_t * packet_p)
         case FBE_RDGEN_CONTROL_CODE_SET_SVC_OPTIONS:
             status = fbe_rdgen_control_set_svc_options(packet_p);
             break;
+        case FBE_RDGEN_CONTROL_CODE_GET_LATENCY_HISTOGRAM:
+            status = fbe_rdgen_service_get_latency_histogram(packet_p);
+            break;
         default:
             return fbe_base_service_control_entry((fbe_base_service_t *)fbe_rdgen_service_p, packet_p);
             break;
@@ -2863,7 +2886,7 @@ static fbe_status_t fbe_rdgen_start_playback_io_allocate(fbe_packet_t * packet_p
     fbe_u32_t target_index;
     fbe_rdgen_root_file_filter_t *filter_list_p = NULL;
 
-    status = fbe_rdgen_playback_get_header(&targets, &filter_list_p, /* no filter list */ &start_p->filter.device_name[0]);
+    status = fbe_rdgen_playback_get_targets(start_p, &targets, &filter_list_p);
     if (status != FBE_STATUS_OK) { 
         fbe_rdgen_service_trace(FBE_TRACE_LEVEL_WARNING, FBE_TRACE_MESSAGE_ID_INFO,
                                 "%s: cannot read header file status %d\n", 
@@ -3527,7 +3550,7 @@ static fbe_status_t fbe_rdgen_start_playback_io(fbe_packet_t * packet_p,
         fbe_rdgen_complete_packet(packet_p, FBE_PAYLOAD_CONTROL_STATUS_FAILURE, status);
         return FBE_STATUS_OK;
     }
-    status = fbe_rdgen_playback_get_header(&targets, &filter_list_p, &start_p->filter.device_name[0]);
+    status = fbe_rdgen_playback_get_targets(start_p, &targets, &filter_list_p);
     if (status != FBE_STATUS_OK) {
         fbe_rdgen_service_trace(FBE_TRACE_LEVEL_ERROR, 
                                 FBE_TRACE_MESSAGE_ID_INFO,
@@ -3606,6 +3629,7 @@ static fbe_status_t fbe_rdgen_start_playback_io(fbe_packet_t * packet_p,
                                         __FUNCTION__, object_id, status);
                 break;
             }
+            fbe_rdgen_object_set_playback_options(object_p, &start_p->specification);
             fbe_rdgen_object_set_file(object_p, &start_p->filter.device_name[0]);
             if (status == FBE_STATUS_OK) 
             {
@@ -3712,6 +3736,47 @@ static fbe_status_t fbe_rdgen_validate_start_request(fbe_rdgen_control_start_io_
         return FBE_STATUS_GENERIC_FAILURE;
     }
 
+    /* Open loop needs a rate, and is only supported for the operations that 
+     * issue one I/O per pass.  It replaces any delay between passes. 
+     */
+    if (start_io_p->specification.arrival_mode >= FBE_RDGEN_ARRIVAL_MODE_LAST)
+    {
+        fbe_rdgen_service_trace(FBE_TRACE_LEVEL_WARNING, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                            "rdgn_val_start_req invalid arrival mode: 0x%x\n", 
+                            start_io_p->specification.arrival_mode);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+    if ((start_io_p->specification.arrival_mode != FBE_RDGEN_ARRIVAL_MODE_CLOSED_LOOP) &&
+        ((start_io_p->specification.arrival_iops == 0) ||
+         (start_io_p->specification.msecs_to_delay != 0) ||
+         fbe_rdgen_specification_options_is_set(&start_io_p->specification, FBE_RDGEN_OPTIONS_FILE) ||
+         ((start_io_p->specification.operation != FBE_RDGEN_OPERATION_READ_ONLY) &&
+          (start_io_p->specification.operation != FBE_RDGEN_OPERATION_WRITE_ONLY))))
+    {
+        fbe_rdgen_service_trace(FBE_TRACE_LEVEL_WARNING, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                            "rdgn_val_start_req open loop mode: 0x%x iops: %d op: 0x%x delay: %d not supported\n", 
+                            start_io_p->specification.arrival_mode,
+                            start_io_p->specification.arrival_iops,
+                            start_io_p->specification.operation,
+                            (int)start_io_p->specification.msecs_to_delay);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    /* Text traces name the object to replay to in the filter.
+     */
+    if ((start_io_p->specification.playback_format >= FBE_RDGEN_PLAYBACK_FORMAT_LAST) ||
+        ((start_io_p->specification.playback_format != FBE_RDGEN_PLAYBACK_FORMAT_RDGEN) &&
+         ((start_io_p->filter.filter_type != FBE_RDGEN_FILTER_TYPE_PLAYBACK_SEQUENCE) ||
+          (start_io_p->filter.object_id == FBE_OBJECT_ID_INVALID))))
+    {
+        fbe_rdgen_service_trace(FBE_TRACE_LEVEL_WARNING, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                            "rdgn_val_start_req playback format: 0x%x filter: 0x%x obj: 0x%x not supported\n", 
+                            start_io_p->specification.playback_format,
+                            start_io_p->filter.filter_type,
+                            start_io_p->filter.object_id);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
     /* Make sure the block_spec is defined.
      */
     if ((start_io_p->specification.block_spec == FBE_RDGEN_BLOCK_SPEC_INVALID) ||
@@ -4783,6 +4848,161 @@ static fbe_status_t fbe_rdgen_service_get_stats(fbe_packet_t * packet_p)
 /******************************************
  * end fbe_rdgen_service_get_stats()
  ******************************************/
+/*!**************************************************************
+ * fbe_rdgen_get_latency_histogram()
+ ****************************************************************
+ * @brief
+ *  Merge the latency histograms of all the active threads that
+ *  match the filter, and return the historical histograms of
+ *  all the threads that have already finished.
+ *
+ *  The threads keep updating their histograms without locks while
+ *  we merge, so the in process result is a close snapshot, not an
+ *  exact one.
+ *
+ * @param histogram_p - Information to fetch.
+ * @param filter_p - filter to match on.
+ *
+ * @return FBE_STATUS_OK
+ *
+ ****************************************************************/
+
+static fbe_status_t fbe_rdgen_get_latency_histogram(fbe_rdgen_control_get_latency_histogram_t *histogram_p,
+                                                    fbe_rdgen_filter_t *filter_p)
+{
+    fbe_queue_head_t *head_p = NULL;
+    fbe_queue_head_t *active_ts_head_p = NULL;
+    fbe_rdgen_request_t *request_p = NULL;
+    fbe_rdgen_ts_t *ts_p = NULL;
+    fbe_queue_element_t *queue_element_p = NULL;
+    fbe_u32_t num_threads = 0;
+    fbe_rdgen_latency_type_t latency_type;
+    fbe_rdgen_filter_t filter = *filter_p; /* saved copy of filter. */
+
+    fbe_zero_memory(histogram_p, sizeof(fbe_rdgen_control_get_latency_histogram_t));
+    histogram_p->filter = filter;
+
+    fbe_rdgen_lock();
+
+    fbe_rdgen_get_active_request_queue(&head_p);
+    request_p = (fbe_rdgen_request_t *) fbe_queue_front(head_p);
+    while (request_p != NULL)
+    {
+        fbe_rdgen_request_t *next_request_p = NULL;
+        fbe_bool_t b_check = FBE_FALSE;
+        fbe_rdgen_request_lock(request_p);
+
+        if (filter.filter_type == FBE_RDGEN_FILTER_TYPE_INVALID)
+        {
+            b_check = FBE_TRUE;
+        }
+        else if ((filter.filter_type == FBE_RDGEN_FILTER_TYPE_CLASS) &&
+                 (request_p->filter.filter_type == FBE_RDGEN_FILTER_TYPE_CLASS) &&
+                 (request_p->filter.class_id == filter.class_id))
+        {
+            b_check = FBE_TRUE;
+        }
+        else if ((filter.filter_type == FBE_RDGEN_FILTER_TYPE_OBJECT) &&
+                 (request_p->filter.filter_type == FBE_RDGEN_FILTER_TYPE_OBJECT) &&
+                 (request_p->filter.object_id == filter.object_id))
+        {
+            b_check = FBE_TRUE;
+        }
+        if (b_check)
+        {
+            fbe_rdgen_request_get_active_ts_queue(request_p, &active_ts_head_p);
+            queue_element_p = fbe_queue_front(active_ts_head_p);
+
+            while (queue_element_p != NULL)
+            {
+                ts_p = fbe_rdgen_ts_request_queue_element_to_ts_ptr(queue_element_p);
+                for (latency_type = 0; latency_type < FBE_RDGEN_LATENCY_TYPE_LAST; latency_type++)
+                {
+                    fbe_rdgen_latency_histogram_merge(&histogram_p->in_process[latency_type],
+                                                      &ts_p->latency_histogram[latency_type]);
+                }
+                num_threads++;
+                queue_element_p = fbe_queue_next(active_ts_head_p, &ts_p->request_queue_element);
+            }
+        }
+        next_request_p = (fbe_rdgen_request_t *)fbe_queue_next(head_p, &request_p->queue_element);
+        fbe_rdgen_request_unlock(request_p);
+        request_p = next_request_p;
+    }
+    histogram_p->threads = num_threads;
+
+    for (latency_type = 0; latency_type < FBE_RDGEN_LATENCY_TYPE_LAST; latency_type++)
+    {
+        histogram_p->historical[latency_type] = *fbe_rdgen_get_historical_latency(latency_type);
+    }
+    fbe_rdgen_unlock();
+
+    return FBE_STATUS_OK;
+}
+/******************************************
+ * end fbe_rdgen_get_latency_histogram()
+ ******************************************/
+/*!**************************************************************
+ * fbe_rdgen_service_get_latency_histogram()
+ ****************************************************************
+ * @brief
+ *  Return the merged latency histograms for an input filter.
+ *
+ * @param packet_p - Packet contains a control operation with
+ *                   an fbe_rdgen_control_get_latency_histogram_t.
+ *
+ * @return FBE_STATUS_OK
+ *
+ ****************************************************************/
+
+static fbe_status_t fbe_rdgen_service_get_latency_histogram(fbe_packet_t * packet_p)
+{
+    fbe_payload_ex_t  *payload_p = NULL;
+    fbe_payload_control_operation_t * control_operation_p = NULL;
+    fbe_rdgen_control_get_latency_histogram_t * histogram_p = NULL;
+    fbe_u32_t len;
+    fbe_status_t status;
+
+    payload_p = fbe_transport_get_payload_ex(packet_p);
+    control_operation_p = fbe_payload_ex_get_control_operation(payload_p);
+
+    fbe_payload_control_get_buffer(control_operation_p, &histogram_p);
+    if (histogram_p == NULL)
+    {
+        fbe_rdgen_service_trace(FBE_TRACE_LEVEL_ERROR,
+                            FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                            "%s fbe_payload_control_get_buffer failed\n", __FUNCTION__);
+        fbe_rdgen_complete_packet(packet_p, FBE_PAYLOAD_CONTROL_STATUS_FAILURE, FBE_STATUS_GENERIC_FAILURE);
+        return FBE_STATUS_OK;
+    }
+
+    fbe_payload_control_get_buffer_length(control_operation_p, &len);
+    if (len != sizeof(fbe_rdgen_control_get_latency_histogram_t))
+    {
+        fbe_rdgen_service_trace(FBE_TRACE_LEVEL_ERROR,
+                            FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                            "%s Invalid len %d != %llu \n", __FUNCTION__, len, 
+                            (unsigned long long)sizeof(fbe_rdgen_control_get_latency_histogram_t));
+
+        fbe_rdgen_complete_packet(packet_p, FBE_PAYLOAD_CONTROL_STATUS_FAILURE, FBE_STATUS_GENERIC_FAILURE);
+        return FBE_STATUS_OK;
+    }
+
+    status = fbe_rdgen_get_latency_histogram(histogram_p, &histogram_p->filter);
+
+    if (status == FBE_STATUS_OK)
+    {
+        fbe_rdgen_complete_packet(packet_p, FBE_PAYLOAD_CONTROL_STATUS_OK, FBE_STATUS_OK);
+    }
+    else
+    {
+        fbe_rdgen_complete_packet(packet_p, FBE_PAYLOAD_CONTROL_STATUS_FAILURE, FBE_STATUS_GENERIC_FAILURE);
+    }
+    return FBE_STATUS_OK;
+}
+/******************************************
+ * end fbe_rdgen_service_get_latency_histogram()
+ ******************************************/
 /*!**************************************************************
  * fbe_rdgen_reset_all_thread_stats()
  ****************************************************************
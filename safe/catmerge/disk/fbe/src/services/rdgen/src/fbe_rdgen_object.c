@@ -495,6 +495,10 @@ void fbe_rdgen_object_stop_io(fbe_rdgen_object_t *object_p)
         /* Unlock while we wait for things to halt.
          */
         fbe_rdgen_object_unlock(object_p);
+
+        /* Release any open loop ts waiting for their next arrival.
+         */
+        fbe_rdgen_wakeup_arrival_thread();
         
         /* Re-lock so we can check the queue.
          */
@@ -1153,12 +1157,52 @@ fbe_status_t fbe_rdgen_object_enqueue_to_thread(fbe_rdgen_object_t *object_p)
 void fbe_rdgen_object_set_file(fbe_rdgen_object_t *object_p, fbe_char_t *file_p)
 {
     fbe_u32_t length = (fbe_u32_t)strlen(file_p);
+
+    /* A text trace is the only file, there is no per object file.
+     */
+    if (object_p->playback_format != FBE_RDGEN_PLAYBACK_FORMAT_RDGEN){
+        csx_p_strncpy(&object_p->file_name[0], file_p, FBE_RDGEN_DEVICE_NAME_CHARS);
+        object_p->file_name[FBE_RDGEN_DEVICE_NAME_CHARS - 1] = 0;
+        return;
+    }
     csx_p_strncpy(&object_p->file_name[0], file_p, FBE_MIN(length-4, FBE_RDGEN_DEVICE_NAME_CHARS));
     sprintf(&object_p->file_name[0], "%s_%d.rdg", &object_p->file_name[0], object_p->object_id); 
 }
 /******************************************
  * end fbe_rdgen_object_set_file()
  ******************************************/
+
+/*!**************************************************************
+ * fbe_rdgen_object_set_playback_options()
+ ****************************************************************
+ * @brief
+ *  Save the options of a playback that the object thread needs
+ *  when it reads in records.  Must be set before the file.
+ *
+ * @param object_p - Current object.
+ * @param spec_p - Specification of the playback request.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+
+void fbe_rdgen_object_set_playback_options(fbe_rdgen_object_t *object_p,
+                                           fbe_rdgen_io_specification_t *spec_p)
+{
+    object_p->playback_format = spec_p->playback_format;
+    object_p->playback_trace_threads = spec_p->threads;
+    object_p->b_playback_scale_lba = fbe_rdgen_specification_extra_options_is_set(spec_p, 
+                                                                                   FBE_RDGEN_EXTRA_OPTIONS_PLAYBACK_SCALE_LBA);
+    /* Only text traces have time stamps.
+     */
+    object_p->b_playback_timing = ((spec_p->playback_format != FBE_RDGEN_PLAYBACK_FORMAT_RDGEN) &&
+                                   !fbe_rdgen_specification_extra_options_is_set(spec_p, 
+                                                                                 FBE_RDGEN_EXTRA_OPTIONS_PLAYBACK_NO_TIMING));
+    object_p->playback_time_scale_percent = (spec_p->playback_time_scale_percent == 0) ? 100 : spec_p->playback_time_scale_percent;
+}
+/******************************************
+ * end fbe_rdgen_object_set_playback_options()
+ ******************************************/
 /******************************
  * end file fbe_rdgen_object.c
  ******************************/
@@ -500,6 +500,12 @@ static fbe_status_t fbe_rdgen_ts_send_peer_request(fbe_rdgen_ts_t *ts_p)
     start_req_p->specification.peer_options = FBE_RDGEN_PEER_OPTIONS_INVALID;
     start_req_p->specification.max_passes = 1;
 
+    /* Our side already waited for the arrival, the peer just issues the I/O.
+     */
+    start_req_p->specification.arrival_mode = FBE_RDGEN_ARRIVAL_MODE_CLOSED_LOOP;
+    start_req_p->specification.arrival_iops = 0;
+    start_req_p->specification.playback_format = FBE_RDGEN_PLAYBACK_FORMAT_RDGEN;
+
     /* Setup constant size and constant lba.
      */
     start_req_p->specification.block_spec = FBE_RDGEN_BLOCK_SPEC_CONSTANT;
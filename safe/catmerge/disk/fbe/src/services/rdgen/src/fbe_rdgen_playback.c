@@ -23,6 +23,27 @@
 #include "fbe/fbe_rdgen.h"
 #include "fbe_rdgen_private_inlines.h"
 #include "fbe/fbe_file.h"
+#include "fbe/fbe_sector.h"
+
+/*!*******************************************************************
+ * @struct fbe_rdgen_playback_text_reader_t
+ *********************************************************************
+ * @brief Reads a text trace a line at a time, one buffer at a time.
+ *
+ *********************************************************************/
+typedef struct fbe_rdgen_playback_text_reader_s
+{
+    fbe_file_handle_t file_handle;
+    fbe_char_t *file_p;
+    fbe_u64_t buffer_offset; /*!< Offset in the file of buffer[0]. */
+    fbe_u32_t bytes; /*!< Valid bytes in the buffer. */
+    fbe_u32_t index; /*!< Start of the next line in the buffer. */
+    fbe_bool_t b_eof; /*!< Nothing more to read in. */
+    fbe_status_t status; /*!< Status of the file reads. */
+    fbe_char_t buffer[FBE_RDGEN_PLAYBACK_TEXT_BUFFER_BYTES + 1]; /*!< Extra char to terminate the last line. */
+}
+fbe_rdgen_playback_text_reader_t;
+
 /*************************
  *   FUNCTION DEFINITIONS
  *************************/
@@ -190,6 +211,56 @@ fbe_status_t fbe_rdgen_playback_get_header(fbe_u32_t *targets_p,
 /******************************************
  * end fbe_rdgen_playback_get_header()
  ******************************************/
+
+/*!**************************************************************
+ * fbe_rdgen_playback_get_targets()
+ ****************************************************************
+ * @brief
+ *  Determine the objects a playback runs to.
+ *  An rdgen playback lists them in its root file, but a text
+ *  trace is for a single device, so the request's filter
+ *  names the object to replay it to.
+ *   
+ * @param start_p - The playback request.
+ * @param targets_p - Number of targets returned.
+ * @param filter_p - Allocated list of targets, caller frees.
+ * 
+ * @return fbe_status_t    
+ *
+ ****************************************************************/
+fbe_status_t fbe_rdgen_playback_get_targets(fbe_rdgen_control_start_io_t *start_p,
+                                            fbe_u32_t *targets_p,
+                                            fbe_rdgen_root_file_filter_t **filter_p)
+{
+    fbe_rdgen_root_file_filter_t *local_filter_p = NULL;
+
+    if (start_p->specification.playback_format == FBE_RDGEN_PLAYBACK_FORMAT_RDGEN){
+        return fbe_rdgen_playback_get_header(targets_p, filter_p, &start_p->filter.device_name[0]);
+    }
+
+    local_filter_p = fbe_memory_native_allocate(sizeof(fbe_rdgen_root_file_filter_t));
+    if (local_filter_p == NULL){
+        fbe_rdgen_service_trace(FBE_TRACE_LEVEL_WARNING, FBE_TRACE_MESSAGE_ID_INFO,
+                                "%s, unable to allocate filter for %s.\n", __FUNCTION__, &start_p->filter.device_name[0]); 
+        return FBE_STATUS_INSUFFICIENT_RESOURCES;
+    }
+    fbe_zero_memory(local_filter_p, sizeof(fbe_rdgen_root_file_filter_t));
+    local_filter_p->filter_type = FBE_RDGEN_FILTER_TYPE_OBJECT;
+    local_filter_p->object_id = start_p->filter.object_id;
+    local_filter_p->package_id = start_p->filter.package_id;
+    local_filter_p->threads = start_p->specification.threads;
+
+    fbe_rdgen_service_trace(FBE_TRACE_LEVEL_INFO, FBE_TRACE_MESSAGE_ID_INFO,
+                            "Trace %s format: %d obj: 0x%x pkg: 0x%x th: %d\n", 
+                            &start_p->filter.device_name[0], start_p->specification.playback_format,
+                            local_filter_p->object_id, local_filter_p->package_id, local_filter_p->threads);
+    *targets_p = 1;
+    *filter_p = local_filter_p;
+    return FBE_STATUS_OK;
+}
+/******************************************
+ * end fbe_rdgen_playback_get_targets()
+ ******************************************/
 /*!**************************************************************
  * fbe_rdgen_request_inc_all_pass_counts()
  ****************************************************************
@@ -263,6 +334,17 @@ void fbe_rdgen_ts_playback_get_next_io(fbe_rdgen_ts_t *ts_p)
     fbe_rdgen_ts_set_core(ts_p, object_p->playback_records_p->record_data[object_p->playback_record_index].cpu);
     fbe_rdgen_ts_set_priority(ts_p, object_p->playback_records_p->record_data[object_p->playback_record_index].priority);
 
+    /* Timed traces arrive relative to the first I/O we generated.
+     */
+    if (object_p->b_playback_timing){
+        if (object_p->playback_start_time == 0){
+            object_p->playback_start_time = fbe_get_time_in_us();
+        }
+        ts_p->arrival_time = object_p->playback_start_time + 
+            ((object_p->playback_records_p->record_data[object_p->playback_record_index].arrival_usec * 
+              object_p->playback_time_scale_percent) / 100);
+    }
+
     if ((ts_p->priority > FBE_PACKET_PRIORITY_INVALID) &&
         (ts_p->priority < FBE_PACKET_PRIORITY_LAST)){
         fbe_packet_t *packet_p = NULL;
@@ -322,9 +404,13 @@ fbe_bool_t fbe_rdgen_playback_generate_wait(fbe_rdgen_ts_t *ts_p)
     fbe_rdgen_ts_clear_flag(ts_p, FBE_RDGEN_TS_FLAGS_LOCK_OBTAINED);
     fbe_rdgen_object_lock(ts_p->object_p);
 
+    /* Text traces are parsed again for each pass since the arrivals 
+     * of each pass are later than the last, so they never re-use records. 
+     */
     if ((object_p->playback_records_p != NULL) &&
         (object_p->playback_record_index >= object_p->playback_records_p->num_valid_records) &&
-        (object_p->playback_total_records <= FBE_RDGEN_PLAYBACK_RECORDS_PER_BUFFER)){
+        (object_p->playback_total_records <= FBE_RDGEN_PLAYBACK_RECORDS_PER_BUFFER) &&
+        !fbe_rdgen_object_is_playback_trace(object_p)){
 
         /* If we only needed one buffer. Just set the index back to zero.
          */
@@ -333,7 +419,8 @@ fbe_bool_t fbe_rdgen_playback_generate_wait(fbe_rdgen_ts_t *ts_p)
     }
     else if ((object_p->playback_records_p != NULL) &&
              (object_p->playback_record_index >= object_p->playback_records_p->num_valid_records) &&
-             (object_p->playback_total_chunks > FBE_RDGEN_PLAYBACK_CHUNK_COUNT)){
+             ((object_p->playback_total_chunks > FBE_RDGEN_PLAYBACK_CHUNK_COUNT) ||
+              fbe_rdgen_object_is_playback_trace(object_p))){
 
         /* We needed more than can fit in memory, so just free the current one and try to get another.
          */
@@ -448,6 +535,707 @@ fbe_bool_t fbe_rdgen_playback_generate_wait(fbe_rdgen_ts_t *ts_p)
  * end fbe_rdgen_playback_generate_wait()
  ******************************************/
 
+/*!**************************************************************
+ * fbe_rdgen_playback_skip_spaces()
+ ****************************************************************
+ * @brief
+ *  Skip over blanks in a trace line.
+ *
+ * @param char_p - Current position in the line.
+ *
+ * @return fbe_char_t* - First non blank character.
+ *
+ ****************************************************************/
+static fbe_char_t *fbe_rdgen_playback_skip_spaces(fbe_char_t *char_p)
+{
+    while ((*char_p == ' ') || (*char_p == '\t')){
+        char_p++;
+    }
+    return char_p;
+}
+/******************************************
+ * end fbe_rdgen_playback_skip_spaces()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_rdgen_playback_parse_u64()
+ ****************************************************************
+ * @brief
+ *  Parse an unsigned decimal number out of a trace line.
+ *
+ * @param char_p - Current position in the line.
+ * @param value_p - Value parsed.
+ *
+ * @return fbe_char_t* - Character after the number or
+ *                       NULL if there was no number.
+ *
+ ****************************************************************/
+static fbe_char_t *fbe_rdgen_playback_parse_u64(fbe_char_t *char_p, fbe_u64_t *value_p)
+{
+    fbe_char_t *start_p = char_p;
+    fbe_u64_t value = 0;
+
+    while ((*char_p >= '0') && (*char_p <= '9')){
+        value = (value * 10) + (*char_p - '0');
+        char_p++;
+    }
+    *value_p = value;
+    return (char_p == start_p) ? NULL : char_p;
+}
+/******************************************
+ * end fbe_rdgen_playback_parse_u64()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_rdgen_playback_parse_seconds()
+ ****************************************************************
+ * @brief
+ *  Parse a time in seconds with an optional fraction,
+ *  for example 12.000345678, into microseconds.
+ *
+ * @param char_p - Current position in the line.
+ * @param usec_p - Time parsed.
+ *
+ * @return fbe_char_t* - Character after the time or
+ *                       NULL if there was no time.
+ *
+ ****************************************************************/
+static fbe_char_t *fbe_rdgen_playback_parse_seconds(fbe_char_t *char_p, fbe_u64_t *usec_p)
+{
+    fbe_u64_t seconds;
+    fbe_u64_t usec = 0;
+    fbe_u64_t digit_usec = FBE_TIME_MICROSECONDS_PER_SECOND / 10;
+
+    char_p = fbe_rdgen_playback_parse_u64(char_p, &seconds);
+    if (char_p == NULL){
+        return NULL;
+    }
+    if (*char_p == '.'){
+        char_p++;
+        /* Digits beyond microseconds are dropped.
+         */
+        while ((*char_p >= '0') && (*char_p <= '9')){
+            usec += (*char_p - '0') * digit_usec;
+            digit_usec /= 10;
+            char_p++;
+        }
+    }
+    *usec_p = (seconds * FBE_TIME_MICROSECONDS_PER_SECOND) + usec;
+    return char_p;
+}
+/******************************************
+ * end fbe_rdgen_playback_parse_seconds()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_rdgen_playback_parse_blkparse_line()
+ ****************************************************************
+ * @brief
+ *  Parse one line of default blkparse output, for example:
+ *     8,0    3       11     0.009507758   697  D   W 223490 + 8 [kjournald]
+ *  Only the D (issue to driver) events of reads and writes are
+ *  used, since the same I/O shows up as Q, G, I, D and C events,
+ *  and D is what the device saw after merging.
+ *
+ * @param line_p - NULL terminated line.
+ * @param record_p - Gets the opcode, cpu, lba and blocks.
+ * @param time_usec_p - Gets the time stamp.
+ *
+ * @return fbe_bool_t - FBE_TRUE if this line is an I/O to replay.
+ *
+ ****************************************************************/
+static fbe_bool_t fbe_rdgen_playback_parse_blkparse_line(fbe_char_t *line_p,
+                                                         fbe_rdgen_object_file_record_t *record_p,
+                                                         fbe_u64_t *time_usec_p)
+{
+    fbe_char_t *char_p = fbe_rdgen_playback_skip_spaces(line_p);
+    fbe_u64_t value;
+    fbe_u64_t cpu;
+    fbe_u64_t sector;
+    fbe_u64_t count;
+    fbe_rdgen_operation_t opcode = FBE_RDGEN_OPERATION_INVALID;
+
+    /* Device major,minor then cpu, sequence number, time and pid.
+     */
+    char_p = fbe_rdgen_playback_parse_u64(char_p, &value);
+    if ((char_p == NULL) || (*char_p != ',')){
+        return FBE_FALSE;
+    }
+    char_p = fbe_rdgen_playback_parse_u64(char_p + 1, &value);
+    if (char_p == NULL){
+        return FBE_FALSE;
+    }
+    char_p = fbe_rdgen_playback_parse_u64(fbe_rdgen_playback_skip_spaces(char_p), &cpu);
+    if (char_p == NULL){
+        return FBE_FALSE;
+    }
+    char_p = fbe_rdgen_playback_parse_u64(fbe_rdgen_playback_skip_spaces(char_p), &value);
+    if (char_p == NULL){
+        return FBE_FALSE;
+    }
+    char_p = fbe_rdgen_playback_parse_seconds(fbe_rdgen_playback_skip_spaces(char_p), time_usec_p);
+    if (char_p == NULL){
+        return FBE_FALSE;
+    }
+    char_p = fbe_rdgen_playback_parse_u64(fbe_rdgen_playback_skip_spaces(char_p), &value);
+    if (char_p == NULL){
+        return FBE_FALSE;
+    }
+
+    /* Action, then the RWBS field.  Discards, flushes and anything 
+     * that is neither a read nor a write is not replayed. 
+     */
+    char_p = fbe_rdgen_playback_skip_spaces(char_p);
+    if ((char_p[0] != 'D') || ((char_p[1] != ' ') && (char_p[1] != '\t'))){
+        return FBE_FALSE;
+    }
+    char_p = fbe_rdgen_playback_skip_spaces(char_p + 1);
+    while ((*char_p != 0) && (*char_p != ' ') && (*char_p != '\t')){
+        if (*char_p == 'D'){
+            return FBE_FALSE;
+        }
+        if ((*char_p == 'R') && (opcode == FBE_RDGEN_OPERATION_INVALID)){
+            opcode = FBE_RDGEN_OPERATION_READ_ONLY;
+        }
+        else if ((*char_p == 'W') && (opcode == FBE_RDGEN_OPERATION_INVALID)){
+            opcode = FBE_RDGEN_OPERATION_WRITE_ONLY;
+        }
+        char_p++;
+    }
+    if (opcode == FBE_RDGEN_OPERATION_INVALID){
+        return FBE_FALSE;
+    }
+
+    /* sector + count, both in 512 byte sectors.
+     */
+    char_p = fbe_rdgen_playback_parse_u64(fbe_rdgen_playback_skip_spaces(char_p), &sector);
+    if (char_p == NULL){
+        return FBE_FALSE;
+    }
+    char_p = fbe_rdgen_playback_skip_spaces(char_p);
+    if (*char_p != '+'){
+        return FBE_FALSE;
+    }
+    char_p = fbe_rdgen_playback_parse_u64(fbe_rdgen_playback_skip_spaces(char_p + 1), &count);
+    if ((char_p == NULL) || (count == 0)){
+        return FBE_FALSE;
+    }
+    record_p->opcode = opcode;
+    record_p->cpu = (fbe_cpu_id_t)cpu;
+    record_p->lba = sector;
+    record_p->blocks = count;
+    return FBE_TRUE;
+}
+/******************************************
+ * end fbe_rdgen_playback_parse_blkparse_line()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_rdgen_playback_parse_snia_csv_line()
+ ****************************************************************
+ * @brief
+ *  Parse one line of a SNIA IOTTA style csv trace:
+ *     Timestamp,Hostname,DiskNumber,Type,Offset,Size[,...]
+ *  For example:
+ *     128166372003061629,hm,1,Read,7014609920,24576,41286
+ *  The time stamp is either in 100ns ticks (windows file time)
+ *  or in seconds when it has a fraction.  Offset and size are
+ *  in bytes.  Header lines do not start with a number and are
+ *  skipped.
+ *
+ * @param line_p - NULL terminated line.
+ * @param record_p - Gets the opcode, lba and blocks.
+ * @param time_usec_p - Gets the time stamp.
+ *
+ * @return fbe_bool_t - FBE_TRUE if this line is an I/O to replay.
+ *
+ ****************************************************************/
+static fbe_bool_t fbe_rdgen_playback_parse_snia_csv_line(fbe_char_t *line_p,
+                                                         fbe_rdgen_object_file_record_t *record_p,
+                                                         fbe_u64_t *time_usec_p)
+{
+    fbe_char_t *char_p = fbe_rdgen_playback_skip_spaces(line_p);
+    fbe_u64_t ticks;
+    fbe_u64_t offset;
+    fbe_u64_t size;
+    fbe_u32_t field;
+    fbe_rdgen_operation_t opcode;
+
+    char_p = fbe_rdgen_playback_parse_u64(char_p, &ticks);
+    if (char_p == NULL){
+        return FBE_FALSE;
+    }
+    if (*char_p == '.'){
+        char_p = fbe_rdgen_playback_parse_seconds(fbe_rdgen_playback_skip_spaces(line_p), time_usec_p);
+    }
+    else {
+        *time_usec_p = ticks / 10;
+    }
+    /* Skip the time stamp, hostname and disk number.
+     */
+    for (field = 0; field < 3; field++){
+        while ((*char_p != 0) && (*char_p != ',')){
+            char_p++;
+        }
+        if (*char_p == 0){
+            return FBE_FALSE;
+        }
+        char_p++;
+    }
+    char_p = fbe_rdgen_playback_skip_spaces(char_p);
+    if ((*char_p == 'R') || (*char_p == 'r')){
+        opcode = FBE_RDGEN_OPERATION_READ_ONLY;
+    }
+    else if ((*char_p == 'W') || (*char_p == 'w')){
+        opcode = FBE_RDGEN_OPERATION_WRITE_ONLY;
+    }
+    else {
+        return FBE_FALSE;
+    }
+    while ((*char_p != 0) && (*char_p != ',')){
+        char_p++;
+    }
+    if (*char_p == 0){
+        return FBE_FALSE;
+    }
+    char_p = fbe_rdgen_playback_parse_u64(fbe_rdgen_playback_skip_spaces(char_p + 1), &offset);
+    if (char_p == NULL){
+        return FBE_FALSE;
+    }
+    char_p = fbe_rdgen_playback_skip_spaces(char_p);
+    if (*char_p != ','){
+        return FBE_FALSE;
+    }
+    char_p = fbe_rdgen_playback_parse_u64(fbe_rdgen_playback_skip_spaces(char_p + 1), &size);
+    if ((char_p == NULL) || (size == 0)){
+        return FBE_FALSE;
+    }
+    /* Round out to whole blocks.
+     */
+    record_p->opcode = opcode;
+    record_p->lba = offset / FBE_BYTES_PER_BLOCK;
+    record_p->blocks = ((offset + size + FBE_BYTES_PER_BLOCK - 1) / FBE_BYTES_PER_BLOCK) - record_p->lba;
+    return FBE_TRUE;
+}
+/******************************************
+ * end fbe_rdgen_playback_parse_snia_csv_line()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_rdgen_playback_parse_trace_line()
+ ****************************************************************
+ * @brief
+ *  Parse one line of a text trace.  Only the fields that are in
+ *  the trace are filled in, the rest of the record is untouched.
+ *
+ * @param format - Format of the trace.
+ * @param line_p - NULL terminated line.
+ * @param record_p - Gets the opcode, lba and blocks (and cpu if traced).
+ * @param time_usec_p - Gets the time stamp.
+ *
+ * @return fbe_bool_t - FBE_TRUE if this line is an I/O to replay,
+ *                      FBE_FALSE for headers, comments or other events.
+ *
+ ****************************************************************/
+fbe_bool_t fbe_rdgen_playback_parse_trace_line(fbe_rdgen_playback_format_t format,
+                                               fbe_char_t *line_p,
+                                               fbe_rdgen_object_file_record_t *record_p,
+                                               fbe_u64_t *time_usec_p)
+{
+    switch (format){
+        case FBE_RDGEN_PLAYBACK_FORMAT_BLKPARSE:
+            return fbe_rdgen_playback_parse_blkparse_line(line_p, record_p, time_usec_p);
+        case FBE_RDGEN_PLAYBACK_FORMAT_SNIA_CSV:
+            return fbe_rdgen_playback_parse_snia_csv_line(line_p, record_p, time_usec_p);
+        default:
+            return FBE_FALSE;
+    }
+}
+/******************************************
+ * end fbe_rdgen_playback_parse_trace_line()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_rdgen_playback_scale_lba()
+ ****************************************************************
+ * @brief
+ *  Map an lba of the trace onto the target so that the whole
+ *  range the trace touched covers the whole target, keeping
+ *  the relative locations (and so the seek pattern) of the I/Os.
+ *
+ * @param lba - Lba from the trace.
+ * @param trace_end_lba - End of the highest I/O in the trace.
+ * @param capacity - Capacity of the target.
+ *
+ * @return fbe_lba_t - Scaled lba.
+ *
+ ****************************************************************/
+fbe_lba_t fbe_rdgen_playback_scale_lba(fbe_lba_t lba, fbe_lba_t trace_end_lba, fbe_lba_t capacity)
+{
+    /* Give up low order bits of the trace lbas so the multiply below 
+     * cannot overflow for any capacity under 2^40 blocks. 
+     */
+    while (trace_end_lba >= (1 << 24)){
+        lba >>= 1;
+        trace_end_lba >>= 1;
+    }
+    if (trace_end_lba == 0){
+        return lba;
+    }
+    return (lba * capacity) / trace_end_lba;
+}
+/******************************************
+ * end fbe_rdgen_playback_scale_lba()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_rdgen_playback_text_seek()
+ ****************************************************************
+ * @brief
+ *  Position the text reader so the next line is at this offset.
+ *
+ * @param reader_p - Text reader.
+ * @param offset - Offset in the file.
+ *
+ * @return fbe_status_t
+ *
+ ****************************************************************/
+static fbe_status_t fbe_rdgen_playback_text_seek(fbe_rdgen_playback_text_reader_t *reader_p, fbe_u64_t offset)
+{
+    fbe_u64_t seek_status;
+
+    seek_status = fbe_file_lseek(reader_p->file_handle, offset, 0);
+    if (seek_status == FBE_FILE_ERROR){
+        fbe_rdgen_service_trace(FBE_TRACE_LEVEL_WARNING, FBE_TRACE_MESSAGE_ID_INFO,
+                                "%s, seek to 0x%llx in %s failed.\n", __FUNCTION__, 
+                                (unsigned long long)offset, reader_p->file_p); 
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+    reader_p->buffer_offset = offset;
+    reader_p->bytes = 0;
+    reader_p->index = 0;
+    reader_p->b_eof = FBE_FALSE;
+    return FBE_STATUS_OK;
+}
+/******************************************
+ * end fbe_rdgen_playback_text_seek()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_rdgen_playback_text_open()
+ ****************************************************************
+ * @brief
+ *  Open the object's text trace for reading lines at an offset.
+ *
+ * @param object_p - Current object.
+ * @param offset - Offset of the first line to read.
+ *
+ * @return fbe_rdgen_playback_text_reader_t* - NULL on error.
+ *
+ ****************************************************************/
+static fbe_rdgen_playback_text_reader_t *fbe_rdgen_playback_text_open(fbe_rdgen_object_t *object_p, fbe_u64_t offset)
+{
+    fbe_rdgen_playback_text_reader_t *reader_p = NULL;
+
+    reader_p = fbe_memory_native_allocate(sizeof(fbe_rdgen_playback_text_reader_t));
+    if (reader_p == NULL){
+        fbe_rdgen_service_trace(FBE_TRACE_LEVEL_WARNING, FBE_TRACE_MESSAGE_ID_INFO,
+                                "%s, unable to allocate reader for %s.\n", __FUNCTION__, &object_p->file_name[0]); 
+        return NULL;
+    }
+    reader_p->file_p = &object_p->file_name[0];
+    reader_p->file_handle = fbe_rdgen_open_file(reader_p->file_p);
+    if (reader_p->file_handle == FBE_FILE_INVALID_HANDLE){
+        fbe_rdgen_service_trace(FBE_TRACE_LEVEL_WARNING, FBE_TRACE_MESSAGE_ID_INFO,
+                                "%s, Open file failed for %s.\n", __FUNCTION__, reader_p->file_p); 
+        fbe_memory_native_release(reader_p);
+        return NULL;
+    }
+    if (fbe_rdgen_playback_text_seek(reader_p, offset) != FBE_STATUS_OK){
+        fbe_file_close(reader_p->file_handle);
+        fbe_memory_native_release(reader_p);
+        return NULL;
+    }
+    reader_p->status = FBE_STATUS_OK;
+    return reader_p;
+}
+/******************************************
+ * end fbe_rdgen_playback_text_open()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_rdgen_playback_text_close()
+ ****************************************************************
+ * @brief
+ *  Close the text trace and free the reader.
+ *
+ * @param reader_p - Text reader.
+ *
+ * @return fbe_status_t - Status of the reads done with the reader.
+ *
+ ****************************************************************/
+static fbe_status_t fbe_rdgen_playback_text_close(fbe_rdgen_playback_text_reader_t *reader_p)
+{
+    fbe_status_t status = reader_p->status;
+
+    fbe_file_close(reader_p->file_handle);
+    fbe_memory_native_release(reader_p);
+    return status;
+}
+/******************************************
+ * end fbe_rdgen_playback_text_close()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_rdgen_playback_text_next_line()
+ ****************************************************************
+ * @brief
+ *  Return the next line of the text trace, reading in more of
+ *  the file as needed.  A line too long to fit in the buffer
+ *  cannot be a trace record, so we drop what we have of it.
+ *
+ * @param reader_p - Text reader.
+ *
+ * @return fbe_char_t* - NULL terminated line, which is valid
+ *                       until the next call, or NULL at the end
+ *                       of the file or on error.
+ *
+ ****************************************************************/
+static fbe_char_t *fbe_rdgen_playback_text_next_line(fbe_rdgen_playback_text_reader_t *reader_p)
+{
+    fbe_status_t status;
+    fbe_u32_t index;
+    fbe_u32_t remaining;
+    fbe_u32_t bytes_read;
+    fbe_char_t *line_p = NULL;
+
+    while (FBE_TRUE){
+        for (index = reader_p->index; index < reader_p->bytes; index++){
+            if (reader_p->buffer[index] == '\n'){
+                reader_p->buffer[index] = 0;
+                line_p = &reader_p->buffer[reader_p->index];
+                reader_p->index = index + 1;
+                return line_p;
+            }
+        }
+        if (reader_p->b_eof){
+            /* The last line need not end in a newline.
+             */
+            if (reader_p->index < reader_p->bytes){
+                reader_p->buffer[reader_p->bytes] = 0;
+                line_p = &reader_p->buffer[reader_p->index];
+                reader_p->index = reader_p->bytes;
+                return line_p;
+            }
+            return NULL;
+        }
+        if ((reader_p->index == 0) && (reader_p->bytes == FBE_RDGEN_PLAYBACK_TEXT_BUFFER_BYTES)){
+            /* Drop the start of a line that will not fit.
+             */
+            reader_p->index = reader_p->bytes;
+        }
+
+        /* Move the partial line to the front and fill in the rest of the buffer.
+         */
+        remaining = reader_p->bytes - reader_p->index;
+        if (remaining != 0){
+            fbe_move_memory(&reader_p->buffer[0], &reader_p->buffer[reader_p->index], remaining);
+        }
+        reader_p->buffer_offset += reader_p->index;
+        reader_p->bytes = remaining;
+        reader_p->index = 0;
+
+        status = fbe_rdgen_read_file(reader_p->file_handle, reader_p->file_p, 
+                                     FBE_RDGEN_PLAYBACK_TEXT_BUFFER_BYTES - remaining,
+                                     &bytes_read, &reader_p->buffer[remaining]);
+        if (status != FBE_STATUS_OK){
+            reader_p->status = status;
+            reader_p->b_eof = FBE_TRUE;
+            return NULL;
+        }
+        if (bytes_read < FBE_RDGEN_PLAYBACK_TEXT_BUFFER_BYTES - remaining){
+            reader_p->b_eof = FBE_TRUE;
+        }
+        reader_p->bytes += bytes_read;
+    }
+}
+/******************************************
+ * end fbe_rdgen_playback_text_next_line()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_rdgen_playback_scan_text_trace()
+ ****************************************************************
+ * @brief
+ *  Read through the whole text trace once to count the I/Os
+ *  and find the lba range and time span of the trace.
+ *
+ * @param object_p - Current object.
+ *
+ * @return fbe_status_t
+ *
+ ****************************************************************/
+static fbe_status_t fbe_rdgen_playback_scan_text_trace(fbe_rdgen_object_t *object_p)
+{
+    fbe_status_t status;
+    fbe_rdgen_playback_text_reader_t *reader_p = NULL;
+    fbe_char_t *line_p = NULL;
+    fbe_rdgen_object_file_record_t record;
+    fbe_u64_t time_usec;
+    fbe_u32_t records = 0;
+
+    reader_p = fbe_rdgen_playback_text_open(object_p, 0);
+    if (reader_p == NULL){
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+    while ((line_p = fbe_rdgen_playback_text_next_line(reader_p)) != NULL){
+        if (!fbe_rdgen_playback_parse_trace_line(object_p->playback_format, line_p, &record, &time_usec)){
+            continue;
+        }
+        if ((records == 0) || (time_usec < object_p->playback_trace_start_usec)){
+            object_p->playback_trace_start_usec = time_usec;
+        }
+        if ((records == 0) || (time_usec > object_p->playback_trace_end_usec)){
+            object_p->playback_trace_end_usec = time_usec;
+        }
+        object_p->playback_trace_end_lba = FBE_MAX(object_p->playback_trace_end_lba, record.lba + record.blocks);
+        records++;
+    }
+    status = fbe_rdgen_playback_text_close(reader_p);
+    if (status != FBE_STATUS_OK){
+        return status;
+    }
+    if (records == 0){
+        fbe_rdgen_service_trace(FBE_TRACE_LEVEL_WARNING, FBE_TRACE_MESSAGE_ID_INFO,
+                                "%s, no I/Os found in %s\n", __FUNCTION__, &object_p->file_name[0]);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+    object_p->playback_total_records = records;
+    object_p->playback_total_chunks = records / FBE_RDGEN_PLAYBACK_RECORDS_PER_BUFFER;
+    if (records % FBE_RDGEN_PLAYBACK_RECORDS_PER_BUFFER){
+        object_p->playback_total_chunks++;
+    }
+    fbe_rdgen_service_trace(FBE_TRACE_LEVEL_INFO, FBE_TRACE_MESSAGE_ID_INFO,
+                            "Scanned trace %s num_records: %d num_chunks: %d end lba: 0x%llx usec: %llu\n",
+                            &object_p->file_name[0], object_p->playback_total_records, object_p->playback_total_chunks,
+                            (unsigned long long)object_p->playback_trace_end_lba,
+                            (unsigned long long)(object_p->playback_trace_end_usec - object_p->playback_trace_start_usec));
+    return FBE_STATUS_OK;
+}
+/******************************************
+ * end fbe_rdgen_playback_scan_text_trace()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_rdgen_playback_read_text_records()
+ ****************************************************************
+ * @brief
+ *  Parse the next lines of a text trace into the free record
+ *  buffers of the object.  A buffer never spans the end of the
+ *  trace, so each pass has the same number of chunks as an
+ *  rdgen file of the same number of records.  Each pass
+ *  arrives one trace duration after the last.
+ *
+ * @param object_p - Current object.
+ *
+ * @return fbe_status_t
+ *
+ ****************************************************************/
+static fbe_status_t fbe_rdgen_playback_read_text_records(fbe_rdgen_object_t *object_p)
+{
+    fbe_status_t status;
+    fbe_rdgen_playback_text_reader_t *reader_p = NULL;
+    fbe_rdgen_object_record_t *object_record_p = NULL;
+    fbe_rdgen_object_file_record_t *record_p = NULL;
+    fbe_char_t *line_p = NULL;
+    fbe_u64_t time_usec;
+    fbe_u64_t duration_usec;
+    fbe_u32_t num_records;
+
+    reader_p = fbe_rdgen_playback_text_open(object_p, object_p->playback_file_offset);
+    if (reader_p == NULL){
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    fbe_rdgen_object_lock(object_p);
+    object_record_p = (fbe_rdgen_object_record_t*)fbe_queue_pop(&object_p->free_record_queue);
+    fbe_rdgen_object_unlock(object_p);
+    while (object_record_p != NULL) {
+
+        num_records = 0;
+        while (num_records < FBE_RDGEN_PLAYBACK_RECORDS_PER_BUFFER){
+            line_p = fbe_rdgen_playback_text_next_line(reader_p);
+            if (line_p == NULL){
+                if (reader_p->status != FBE_STATUS_OK){
+                    break;
+                }
+                /* End of this pass.  The next pass starts one average gap after 
+                 * the last I/O of this one. 
+                 */
+                duration_usec = object_p->playback_trace_end_usec - object_p->playback_trace_start_usec;
+                object_p->playback_pass_usec += duration_usec + (duration_usec / object_p->playback_total_records);
+                reader_p->status = fbe_rdgen_playback_text_seek(reader_p, 0);
+                break;
+            }
+            record_p = &object_record_p->record_data[num_records];
+            fbe_zero_memory(record_p, sizeof(fbe_rdgen_object_file_record_t));
+
+            /* Formats without a cpu get spread across the cores.
+             */
+            record_p->cpu = object_p->playback_cpu;
+            if (!fbe_rdgen_playback_parse_trace_line(object_p->playback_format, line_p, record_p, &time_usec)){
+                continue;
+            }
+            object_p->playback_cpu++;
+            record_p->threads = object_p->playback_trace_threads;
+            record_p->io_interface = FBE_RDGEN_INTERFACE_TYPE_PACKET;
+            if (object_p->b_playback_scale_lba){
+                record_p->lba = fbe_rdgen_playback_scale_lba(record_p->lba, object_p->playback_trace_end_lba, 
+                                                             object_p->capacity);
+            }
+            if (time_usec > object_p->playback_trace_start_usec){
+                record_p->arrival_usec = time_usec - object_p->playback_trace_start_usec;
+            }
+            record_p->arrival_usec += object_p->playback_pass_usec;
+            num_records++;
+        }
+
+        /* The trace was scanned when we started, so if a pass has no I/Os 
+         * the file was changed underneath us. 
+         */
+        if ((reader_p->status != FBE_STATUS_OK) || (num_records == 0)){
+            fbe_rdgen_service_trace(FBE_TRACE_LEVEL_WARNING, FBE_TRACE_MESSAGE_ID_INFO,
+                                    "%s, read of %s failed status: 0x%x records: %d\n", 
+                                    __FUNCTION__, &object_p->file_name[0], reader_p->status, num_records); 
+            fbe_rdgen_object_lock(object_p);
+            fbe_rdgen_object_enqueue_free_record(object_p, object_record_p);
+            fbe_rdgen_object_unlock(object_p);
+            fbe_rdgen_playback_text_close(reader_p);
+            return FBE_STATUS_GENERIC_FAILURE;
+        }
+        fbe_rdgen_service_trace(FBE_TRACE_LEVEL_DEBUG_HIGH, object_p->object_id,
+                                "obj thread: parsed %d records at chunk index: %d\n",
+                                num_records, object_p->playback_chunk_index);
+        object_p->playback_file_offset = reader_p->buffer_offset + reader_p->index;
+
+        fbe_rdgen_object_lock(object_p);
+        object_record_p->num_valid_records = num_records;
+        fbe_rdgen_object_enqueue_valid_record(object_p, object_record_p);
+
+        object_p->playback_chunk_index++;
+
+        /* Get the next record to read.
+         */
+        object_record_p = (fbe_rdgen_object_record_t*)fbe_queue_pop(&object_p->free_record_queue);
+        fbe_rdgen_object_unlock(object_p);
+    }
+    status = fbe_rdgen_playback_text_close(reader_p);
+    return status;
+}
+/******************************************
+ * end fbe_rdgen_playback_read_text_records()
+ ******************************************/
+
 /*!**************************************************************
  * fbe_rdgen_playback_read_object_header()
  ****************************************************************
@@ -471,6 +1259,15 @@ fbe_status_t fbe_rdgen_playback_read_object_header(fbe_rdgen_object_t *object_p)
     fbe_rdgen_object_file_header_t object_header;
     fbe_char_t *file_p = &object_p->file_name[0];
 
+    /* A text trace has no header, instead we scan the trace.
+     */
+    if (fbe_rdgen_object_is_playback_trace(object_p)){
+        if (object_p->playback_total_records == 0){
+            status = fbe_rdgen_playback_scan_text_trace(object_p);
+        }
+        return status;
+    }
+
     file_handle = fbe_rdgen_open_file(file_p);
 
     if(file_handle == FBE_FILE_INVALID_HANDLE) {
@@ -541,6 +1338,10 @@ fbe_status_t fbe_rdgen_playback_read_records(fbe_rdgen_object_t *object_p)
     fbe_u32_t remaining_records;
     fbe_rdgen_object_record_t *object_record_p = NULL;
 
+    if (fbe_rdgen_object_is_playback_trace(object_p)){
+        return fbe_rdgen_playback_read_text_records(object_p);
+    }
+
     file_handle = fbe_rdgen_open_file(file_p);
 
     if(file_handle == FBE_FILE_INVALID_HANDLE) {
@@ -28,6 +28,7 @@
 static void fbe_rdgen_abort_thread_func(void * context);   
 static void fbe_rdgen_scan_thread_func(void * context);
 static void fbe_rdgen_object_playback_thread_func(void * context);
+static void fbe_rdgen_arrival_thread_func(void * context);
 
 void fbe_rdgen_thread_enqueue(fbe_rdgen_thread_t *thread_p,
                               fbe_queue_element_t *queue_element_p)
@@ -258,6 +259,9 @@ fbe_status_t fbe_rdgen_get_thread_func(fbe_rdgen_thread_type_t thread_type,
         case FBE_RDGEN_THREAD_TYPE_PEER:
             *thread_fn_p = fbe_rdgen_peer_thread_func;
             break;
+        case FBE_RDGEN_THREAD_TYPE_ARRIVAL:
+            *thread_fn_p = fbe_rdgen_arrival_thread_func;
+            break;
         default:
             status = FBE_STATUS_GENERIC_FAILURE;
             break;
@@ -466,6 +470,202 @@ void fbe_rdgen_wakeup_abort_thread(void)
     return;
 }
 
+void fbe_rdgen_wakeup_arrival_thread(void)
+{
+    fbe_rdgen_thread_t *thread_p = NULL;
+    fbe_rdgen_get_arrival_thread(&thread_p);
+
+    fbe_rdgen_thread_lock(thread_p);
+    fbe_rendezvous_event_set(&thread_p->event);
+    fbe_rdgen_thread_unlock(thread_p);
+    return;
+}
+
+/*!**************************************************************
+ * fbe_rdgen_arrival_thread_enqueue()
+ ****************************************************************
+ * @brief
+ *  Hold an open loop ts on the arrival thread until its
+ *  arrival time.  The queue is kept sorted by arrival time.
+ *
+ * @param ts_p - ts with arrival_time set.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+
+void fbe_rdgen_arrival_thread_enqueue(fbe_rdgen_ts_t *ts_p)
+{
+    fbe_rdgen_thread_t *thread_p = NULL;
+    fbe_queue_element_t *queue_element_p = NULL;
+    fbe_rdgen_ts_t *current_ts_p = NULL;
+    fbe_rdgen_get_arrival_thread(&thread_p);
+
+    fbe_rdgen_thread_lock(thread_p);
+
+    /* Search from the back since new arrivals are usually the latest.
+     */
+    queue_element_p = fbe_queue_is_empty(&thread_p->ts_queue_head) ? NULL : (fbe_queue_element_t *)thread_p->ts_queue_head.prev;
+    while (queue_element_p != NULL)
+    {
+        current_ts_p = fbe_rdgen_ts_thread_queue_element_to_ts_ptr(queue_element_p);
+        if (current_ts_p->arrival_time <= ts_p->arrival_time)
+        {
+            break;
+        }
+        queue_element_p = fbe_queue_prev(&thread_p->ts_queue_head, queue_element_p);
+    }
+    if (queue_element_p == NULL)
+    {
+        /* Earliest arrival, the thread may need to wake up sooner.
+         */
+        fbe_queue_push_front(&thread_p->ts_queue_head, &ts_p->thread_queue_element);
+        fbe_rendezvous_event_set(&thread_p->event);
+    }
+    else
+    {
+        fbe_queue_insert(&ts_p->thread_queue_element, (fbe_queue_element_t *)queue_element_p->next);
+    }
+    fbe_rdgen_thread_unlock(thread_p);
+    return;
+}
+/******************************************
+ * end fbe_rdgen_arrival_thread_enqueue()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_rdgen_arrival_thread_process_queue()
+ ****************************************************************
+ * @brief
+ *  Kick off every ts that has arrived (or is aborted) and
+ *  determine how long to wait for the next one.
+ *
+ * @param thread_p - The arrival thread.
+ * @param msecs_to_wait_p - Time to sleep before the next arrival 
+ *                          is close enough to poll for, 0 to poll now.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+
+static void fbe_rdgen_arrival_thread_process_queue(fbe_rdgen_thread_t *thread_p,
+                                                   fbe_time_t *msecs_to_wait_p)
+{
+    fbe_queue_element_t *queue_element_p = NULL;
+    fbe_queue_element_t *next_element_p = NULL;
+    fbe_rdgen_ts_t *ts_p = NULL;
+    fbe_time_t current_time;
+    fbe_bool_t b_wait_set = FBE_FALSE;
+    fbe_queue_head_t tmp_queue;
+    fbe_queue_init(&tmp_queue);
+
+    *msecs_to_wait_p = FBE_RDGEN_THREAD_MAX_ARRIVAL_WAIT_MSECS;
+
+    fbe_rdgen_thread_lock(thread_p);
+    fbe_rendezvous_event_clear(&thread_p->event);
+    current_time = fbe_get_time_in_us();
+
+    /* Nothing is released ahead of its arrival.
+     * Aborted ts go now so they can finish.
+     */
+    queue_element_p = fbe_queue_front(&thread_p->ts_queue_head);
+    while (queue_element_p != NULL)
+    {
+        next_element_p = fbe_queue_next(&thread_p->ts_queue_head, queue_element_p);
+        ts_p = fbe_rdgen_ts_thread_queue_element_to_ts_ptr(queue_element_p);
+
+        if ((ts_p->arrival_time <= current_time) ||
+            fbe_rdgen_ts_is_aborted(ts_p))
+        {
+            fbe_queue_remove(queue_element_p);
+            fbe_queue_push(&tmp_queue, queue_element_p);
+        }
+        else if (!b_wait_set)
+        {
+            /* First one not due yet determines our wait. 
+             * Sleep until it is close, then poll for it. 
+             */
+            b_wait_set = FBE_TRUE;
+            if ((ts_p->arrival_time - current_time) <= FBE_RDGEN_ARRIVAL_POLL_USEC)
+            {
+                *msecs_to_wait_p = 0;
+            }
+            else
+            {
+                *msecs_to_wait_p = FBE_MIN((ts_p->arrival_time - current_time - FBE_RDGEN_ARRIVAL_POLL_USEC) / FBE_TIME_MILLISECONDS_PER_MICROSECOND,
+                                           FBE_RDGEN_THREAD_MAX_ARRIVAL_WAIT_MSECS);
+            }
+        }
+        queue_element_p = next_element_p;
+    }
+    fbe_rdgen_thread_unlock(thread_p);
+
+    while (queue_element_p = fbe_queue_pop(&tmp_queue))
+    {
+        ts_p = fbe_rdgen_ts_thread_queue_element_to_ts_ptr(queue_element_p);
+        fbe_rdgen_ts_enqueue_to_thread(ts_p);
+    }
+    fbe_queue_destroy(&tmp_queue);
+    return;
+}
+/******************************************
+ * end fbe_rdgen_arrival_thread_process_queue()
+ ******************************************/
+
+static void fbe_rdgen_arrival_thread_func(void * context)
+{
+    fbe_rdgen_thread_t *thread_p = context;
+    fbe_time_t msecs_to_wait = FBE_RDGEN_THREAD_MAX_ARRIVAL_WAIT_MSECS;
+    fbe_rdgen_service_trace(FBE_TRACE_LEVEL_DEBUG_HIGH, 
+                            FBE_TRACE_MESSAGE_ID_FUNCTION_ENTRY,
+                            "%s entry 0x%x\n", __FUNCTION__, (unsigned int)thread_p);
+
+    /* Wake up when a new earliest arrival is queued or the next one is due. 
+     * If we are told to halt, then the thread exits. 
+     */
+    while (1)
+    {
+        if (msecs_to_wait == 0)
+        {
+            /* The next arrival is closer than we can sleep, poll for it.
+             */
+            csx_p_thr_yield();
+        }
+        else
+        {
+            /* PAL APIs expect that timeout is not less than 
+             * EMCPAL_MINIMUM_TIMEOUT_MSECS.
+             */
+            if (msecs_to_wait < EMCPAL_MINIMUM_TIMEOUT_MSECS)
+            {
+                msecs_to_wait = EMCPAL_MINIMUM_TIMEOUT_MSECS;
+            }
+            fbe_rendezvous_event_wait(&thread_p->event, (fbe_u32_t)msecs_to_wait);
+        }
+
+        if (fbe_rdgen_thread_is_flag_set(thread_p, FBE_RDGEN_THREAD_FLAGS_HALT))
+        {
+            break;
+        }
+        fbe_rdgen_arrival_thread_process_queue(thread_p, &msecs_to_wait);
+    }
+
+    /* All I/O is stopped before the threads are destroyed.
+     */
+    if (!fbe_queue_is_empty(&thread_p->ts_queue_head))
+    {
+        fbe_rdgen_service_trace(FBE_TRACE_LEVEL_WARNING, 
+                                FBE_TRACE_MESSAGE_ID_INFO,
+                                "%s found items on the queue. 0x%x\n", __FUNCTION__, (unsigned int)thread_p);
+    }
+
+    fbe_rdgen_service_trace(FBE_TRACE_LEVEL_DEBUG_HIGH, 
+                            FBE_TRACE_MESSAGE_ID_FUNCTION_EXIT,
+                            "%s exiting 0x%p\n", __FUNCTION__, thread_p);
+    fbe_rdgen_thread_set_flag(thread_p, FBE_RDGEN_THREAD_FLAGS_STOPPED);
+    fbe_thread_exit(EMCPAL_STATUS_SUCCESS);
+}
+
 static void fbe_rdgen_scan_thread_func(void * context)
 {
     EMCPAL_STATUS nt_status;
@@ -97,6 +97,8 @@ void fbe_rdgen_ts_init(fbe_rdgen_ts_t *ts_p,
     ts_p->pre_read_blocks = 0;
     ts_p->pre_read_lba = FBE_LBA_INVALID;
     ts_p->region_index = 0;
+    ts_p->next_arrival_time = 0;
+    ts_p->arrival_time = 0;
     fbe_rdgen_ts_update_last_send_time(ts_p);
     fbe_rdgen_ts_update_start_time(ts_p);
 
@@ -643,6 +645,12 @@ fbe_rdgen_ts_state_status_t fbe_rdgen_ts_start(fbe_rdgen_ts_t *ts_p)
                             (unsigned long long)ts_p->request_p->specification.max_blocks,
                             ts_p->b_send_to_peer);
 
+    /* Open loop I/O does not start until its first scheduled arrival.
+     */
+    if (fbe_rdgen_ts_is_open_loop(ts_p))
+    {
+        return fbe_rdgen_ts_wait_for_arrival(ts_p, state);
+    }
     return FBE_RDGEN_TS_STATE_STATUS_EXECUTING;
 }
 /******************************************
@@ -666,6 +674,7 @@ fbe_rdgen_ts_state_status_t fbe_rdgen_ts_start(fbe_rdgen_ts_t *ts_p)
 void fbe_rdgen_ts_inc_historical_stats(fbe_rdgen_ts_t *ts_p)
 {
     fbe_rdgen_io_statistics_t *historical_stats_p = fbe_rdgen_get_historical_stats();
+    fbe_rdgen_latency_type_t latency_type;
 
     historical_stats_p->aborted_error_count += ts_p->abort_err_count;
     historical_stats_p->bad_crc_blocks_count += ts_p->bad_crc_blocks_count;
@@ -678,6 +687,14 @@ void fbe_rdgen_ts_inc_historical_stats(fbe_rdgen_ts_t *ts_p)
     historical_stats_p->still_congested_error_count += ts_p->still_congested_err_count;
     historical_stats_p->media_error_count += ts_p->media_err_count;
     historical_stats_p->pass_count += ts_p->pass_count;
+
+    /* The rdgen lock is held, so it is safe to merge our histograms.
+     */
+    for (latency_type = 0; latency_type < FBE_RDGEN_LATENCY_TYPE_LAST; latency_type++)
+    {
+        fbe_rdgen_latency_histogram_merge(fbe_rdgen_get_historical_latency(latency_type),
+                                          &ts_p->latency_histogram[latency_type]);
+    }
     return;
 }
 /******************************************
@@ -1012,6 +1029,7 @@ fbe_rdgen_packet_completion(fbe_packet_t * packet_p,
     fbe_rdgen_ts_set_last_response_time(ts_p, usec);
     fbe_rdgen_ts_update_cum_resp_time(ts_p, usec);
     fbe_rdgen_ts_update_max_response_time(ts_p, usec);
+    fbe_rdgen_ts_update_latency_histogram(ts_p, usec);
 
     if (fbe_rdgen_specification_options_is_set(&ts_p->request_p->specification,
                                                 FBE_RDGEN_OPTIONS_PERFORMANCE))
@@ -4379,6 +4397,15 @@ fbe_rdgen_ts_state_status_t fbe_rdgen_ts_generate_playback(fbe_rdgen_ts_t *ts_p)
     }
     fbe_rdgen_ts_set_state(ts_p, state);
 
+    /* A timed trace I/O is held until its arrival.  The arrival thread 
+     * releases it to its core, so there is no need to change cores here. 
+     */
+    if ((ts_p->arrival_time != 0) &&
+        (ts_p->arrival_time > fbe_get_time_in_us())){
+        fbe_rdgen_arrival_thread_enqueue(ts_p);
+        return FBE_RDGEN_TS_STATE_STATUS_WAITING;
+    }
+
     /* If the core number changed, then change cores now.
      */
     if (cpu_id != ts_p->core_num){
@@ -4423,6 +4450,127 @@ static fbe_status_t fbe_rdgen_ts_timer_completion(fbe_packet_t * packet,
 /******************************************
  * end fbe_rdgen_ts_timer_completion()
  ******************************************/
+
+/*!*******************************************************************
+ * @var fbe_rdgen_poisson_gap_per_mille
+ *********************************************************************
+ * @brief -ln(u) for 128 evenly spaced u in (0,1), scaled so the
+ *        table averages 1000.  Multiplying a mean gap by a random
+ *        entry / 1000 gives an exponentially distributed gap
+ *        without floating point.
+ *
+ *********************************************************************/
+static const fbe_u16_t fbe_rdgen_poisson_gap_per_mille[FBE_RDGEN_POISSON_GAP_TABLE_SIZE] =
+{
+    5560, 4459, 3946, 3609, 3357, 3156, 2988, 2845,
+    2719, 2608, 2507, 2416, 2333, 2255, 2184, 2117,
+    2054, 1995, 1940, 1887, 1837, 1789, 1743, 1700,
+    1658, 1618, 1579, 1542, 1506, 1472, 1438, 1406,
+    1375, 1344, 1315, 1286, 1258, 1231, 1205, 1179,
+    1154, 1129, 1106, 1082, 1059, 1037, 1015,  994,
+     973,  953,  933,  913,  894,  875,  856,  838,
+     820,  802,  785,  768,  751,  735,  719,  703,
+     687,  672,  657,  642,  627,  612,  598,  584,
+     570,  556,  543,  529,  516,  503,  490,  478,
+     465,  453,  440,  428,  416,  405,  393,  381,
+     370,  359,  348,  337,  326,  315,  304,  294,
+     283,  273,  263,  253,  243,  233,  223,  213,
+     203,  194,  184,  175,  166,  157,  147,  138,
+     129,  121,  112,  103,   94,   86,   77,   69,
+      61,   52,   44,   36,   28,   20,   12,    4,
+};
+
+/*!**************************************************************
+ * fbe_rdgen_ts_get_arrival_gap()
+ ****************************************************************
+ * @brief
+ *  Determine how long after the last arrival the next I/O
+ *  for this ts arrives.  Each thread carries an equal share
+ *  of the object's arrival rate, and independent poisson
+ *  streams add up to a poisson stream at the object rate.
+ *
+ * @param ts_p - Current ts.
+ *
+ * @return fbe_time_t - Gap in microseconds.
+ *
+ ****************************************************************/
+
+static fbe_time_t fbe_rdgen_ts_get_arrival_gap(fbe_rdgen_ts_t *ts_p)
+{
+    fbe_rdgen_io_specification_t *spec_p = &ts_p->request_p->specification;
+    fbe_u32_t threads = FBE_MAX(spec_p->threads, 1);
+    fbe_time_t mean_gap_us;
+    fbe_u32_t index;
+
+    mean_gap_us = ((fbe_time_t)threads * FBE_TIME_MICROSECONDS_PER_SECOND) / spec_p->arrival_iops;
+
+    if (spec_p->arrival_mode == FBE_RDGEN_ARRIVAL_MODE_POISSON)
+    {
+        index = fbe_rtl_random(&ts_p->random_context) % FBE_RDGEN_POISSON_GAP_TABLE_SIZE;
+        return (mean_gap_us * fbe_rdgen_poisson_gap_per_mille[index]) / 1000;
+    }
+    return mean_gap_us;
+}
+/******************************************
+ * end fbe_rdgen_ts_get_arrival_gap()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_rdgen_ts_wait_for_arrival()
+ ****************************************************************
+ * @brief
+ *  Schedule the next open loop arrival for this ts and hold
+ *  the ts until then.  The schedule does not depend on when
+ *  the last I/O finished, so once the object saturates the
+ *  ts falls behind schedule and issues back to back, with
+ *  the backlog showing up in the response times.
+ *
+ * @param ts_p - Current ts.
+ * @param state - State to run when the I/O arrives.
+ * 
+ * @return FBE_RDGEN_TS_STATE_STATUS_EXECUTING if already due,
+ *         FBE_RDGEN_TS_STATE_STATUS_WAITING otherwise.
+ *
+ ****************************************************************/
+
+fbe_rdgen_ts_state_status_t fbe_rdgen_ts_wait_for_arrival(fbe_rdgen_ts_t *ts_p,
+                                                          fbe_rdgen_ts_state_t state)
+{
+    fbe_rdgen_io_specification_t *spec_p = &ts_p->request_p->specification;
+    fbe_time_t current_time = fbe_get_time_in_us();
+    fbe_time_t gap_us = fbe_rdgen_ts_get_arrival_gap(ts_p);
+
+    if (ts_p->next_arrival_time == 0)
+    {
+        /* First arrival.  Stagger fixed rate threads across one interval so the 
+         * object sees evenly spaced I/Os instead of bursts of one per thread. 
+         */
+        if (spec_p->arrival_mode == FBE_RDGEN_ARRIVAL_MODE_FIXED_RATE)
+        {
+            gap_us = (gap_us * fbe_rdgen_ts_get_thread_num(ts_p)) / FBE_MAX(spec_p->threads, 1);
+        }
+        ts_p->next_arrival_time = current_time + gap_us;
+    }
+    else
+    {
+        ts_p->next_arrival_time += gap_us;
+    }
+    ts_p->arrival_time = ts_p->next_arrival_time;
+    fbe_rdgen_ts_set_state(ts_p, state);
+
+    /* Only an arrival that is already due goes now, the arrival thread 
+     * holds the rest so that no I/O is sent ahead of its schedule. 
+     */
+    if (ts_p->arrival_time <= current_time)
+    {
+        return FBE_RDGEN_TS_STATE_STATUS_EXECUTING;
+    }
+    fbe_rdgen_arrival_thread_enqueue(ts_p);
+    return FBE_RDGEN_TS_STATE_STATUS_WAITING;
+}
+/******************************************
+ * end fbe_rdgen_ts_wait_for_arrival()
+ ******************************************/
 /*!**************************************************************
  * fbe_rdgen_ts_set_first_state()
  ****************************************************************
@@ -4449,6 +4597,10 @@ fbe_rdgen_ts_state_status_t fbe_rdgen_ts_set_first_state(fbe_rdgen_ts_t *ts_p,
         /* A playback request goes through the generate state always in between requests.
          */
         state = fbe_rdgen_ts_generate_playback;
+    } else if (fbe_rdgen_ts_is_open_loop(ts_p)){
+        /* The next pass starts at its scheduled arrival, however long this one took.
+         */
+        return fbe_rdgen_ts_wait_for_arrival(ts_p, state);
     } else if (ts_p->request_p->specification.msecs_to_delay != 0){
         fbe_u32_t msecs_to_delay = (fbe_u32_t)ts_p->request_p->specification.msecs_to_delay;
         if (fbe_rdgen_specification_extra_options_is_set(&ts_p->request_p->specification,
@@ -22,6 +22,7 @@
 
 #include "fbe/fbe_api_rdgen_interface.h"
 #include "fbe/fbe_transport.h"
+#include "fbe/fbe_file.h"
 #include "mut.h"
 
 /*************************
@@ -701,6 +702,213 @@ void fbe_rdgen_test_read_compare(void)
 /******************************************
  * end fbe_rdgen_test_read_compare()
  ******************************************/
+/*!**************************************************************
+ * fbe_rdgen_test_latency_histogram()
+ ****************************************************************
+ * @brief
+ *  Validate the log-linear bucket math and percentiles of the
+ *  latency histogram, then make sure reads and writes get
+ *  accounted to the right histograms.
+ *
+ * @param None.               
+ *
+ * @return None.
+ *
+ ****************************************************************/
+
+void fbe_rdgen_test_latency_histogram(void)
+{
+    fbe_status_t status;
+    fbe_rdgen_unit_test_case_t *test_case_p = &fbe_rdgen_test_normal_cases[0];
+    fbe_rdgen_latency_histogram_t histogram;
+    fbe_rdgen_control_get_latency_histogram_t get_histogram;
+    fbe_api_rdgen_latency_percentiles_t percentiles;
+    fbe_rdgen_filter_t filter;
+    fbe_u64_t usec;
+    fbe_u32_t bucket;
+    fbe_u32_t prev_bucket = 0;
+
+    /* Every value must fall inside its bucket, buckets must be contiguous 
+     * and no bucket may be wider than 1/8 of its lower bound.
+     */
+    for (usec = 0; usec < (1 << 20); usec++)
+    {
+        bucket = fbe_rdgen_latency_histogram_get_bucket(usec);
+        MUT_ASSERT_TRUE(bucket < FBE_RDGEN_LATENCY_HISTOGRAM_BUCKETS);
+        MUT_ASSERT_TRUE(usec <= fbe_rdgen_latency_histogram_get_bucket_max_usec(bucket));
+        if (bucket > 0)
+        {
+            MUT_ASSERT_TRUE(usec > fbe_rdgen_latency_histogram_get_bucket_max_usec(bucket - 1));
+        }
+        MUT_ASSERT_TRUE((bucket == prev_bucket) || (bucket == prev_bucket + 1));
+        MUT_ASSERT_TRUE((fbe_rdgen_latency_histogram_get_bucket_max_usec(bucket) - usec) <= (usec / 8));
+        prev_bucket = bucket;
+    }
+    MUT_ASSERT_INT_EQUAL(fbe_rdgen_latency_histogram_get_bucket(FBE_U32_MAX), FBE_RDGEN_LATENCY_HISTOGRAM_BUCKETS - 1);
+    MUT_ASSERT_INT_EQUAL(fbe_rdgen_latency_histogram_get_bucket(FBE_U64_MAX), FBE_RDGEN_LATENCY_HISTOGRAM_BUCKETS - 1);
+
+    /* Uniform samples 1..10000 usec.
+     */
+    fbe_zero_memory(&histogram, sizeof(fbe_rdgen_latency_histogram_t));
+    for (usec = 1; usec <= 10000; usec++)
+    {
+        fbe_rdgen_latency_histogram_add_sample(&histogram, usec);
+    }
+    fbe_api_rdgen_latency_histogram_get_percentiles(&histogram, &percentiles);
+    MUT_ASSERT_UINT64_EQUAL(percentiles.count, 10000);
+    MUT_ASSERT_UINT64_EQUAL(percentiles.max_usec, 10000);
+    MUT_ASSERT_TRUE((percentiles.p50_usec >= 5000) && (percentiles.p50_usec <= 5000 + 5000 / 8));
+    MUT_ASSERT_TRUE((percentiles.p90_usec >= 9000) && (percentiles.p90_usec <= 9000 + 9000 / 8));
+    MUT_ASSERT_TRUE((percentiles.p99_usec >= 9900) && (percentiles.p99_usec <= 10000));
+    MUT_ASSERT_TRUE((percentiles.p99_9_usec >= 9990) && (percentiles.p99_9_usec <= 10000));
+
+    /* Now run writes then reads and make sure each lands in its own histogram.
+     */
+    status = fbe_api_rdgen_reset_stats();
+    MUT_ASSERT_INT_EQUAL(status, FBE_STATUS_OK);
+
+    fbe_rdgen_test_fixed_pattern(FBE_RDGEN_LBA_SPEC_SEQUENTIAL_INCREASING,
+                                 test_case_p,
+                                 FBE_RDGEN_OPERATION_WRITE_ONLY,
+                                 100);
+    fbe_rdgen_test_fixed_pattern(FBE_RDGEN_LBA_SPEC_SEQUENTIAL_INCREASING,
+                                 test_case_p,
+                                 FBE_RDGEN_OPERATION_READ_ONLY,
+                                 50);
+
+    fbe_zero_memory(&filter, sizeof(fbe_rdgen_filter_t));
+    filter.filter_type = FBE_RDGEN_FILTER_TYPE_INVALID;
+    status = fbe_api_rdgen_get_latency_histogram(&get_histogram, &filter);
+    MUT_ASSERT_INT_EQUAL(status, FBE_STATUS_OK);
+    MUT_ASSERT_INT_EQUAL(get_histogram.threads, 0);
+
+    /* Large I/Os may get broken up, so we can see more responses than I/Os.
+     */
+    MUT_ASSERT_TRUE(get_histogram.historical[FBE_RDGEN_LATENCY_TYPE_WRITE].total_count >= 100);
+    MUT_ASSERT_TRUE(get_histogram.historical[FBE_RDGEN_LATENCY_TYPE_READ].total_count >= 50);
+    MUT_ASSERT_UINT64_EQUAL(get_histogram.in_process[FBE_RDGEN_LATENCY_TYPE_READ].total_count, 0);
+    return;
+}
+/******************************************
+ * end fbe_rdgen_test_latency_histogram()
+ ******************************************/
+
+/*!*******************************************************************
+ * @var fbe_rdgen_test_blkparse_trace
+ *********************************************************************
+ * @brief A short blkparse trace.  Only the five D events of reads
+ *        and writes are I/Os to replay, the rest must be skipped.
+ *        The last I/O is far past the end of the test drive.
+ *
+ *********************************************************************/
+static fbe_char_t *fbe_rdgen_test_blkparse_trace = 
+"  8,0    0        1     0.000000000   697  Q   W 1000 + 8 [kjournald]\n"
+"  8,0    0        2     0.000010000   697  D   W 1000 + 8 [kjournald]\n"
+"  8,0    1        3     0.020000000   698  D   R 64 + 16 [dd]\n"
+"  8,0    1        4     0.020500000   698  D  FWS 0 + 0 [flush]\n"
+"  8,0    2        5     0.040000000   699  D   D 5000 + 128 [fstrim]\n"
+"  8,0    2        6     0.060000000   699  D  RA 2048 + 32 [dd]\n"
+"  8,0    3        7     0.080000000   700  C   W 1000 + 8 [0]\n"
+"  8,0    3        8     0.100000000   700  D  WS 4096 + 8 [sync]\n"
+"  8,0    0        9     0.200000000   697  D   R 4000000000 + 8 [dd]\n"
+"CPU0 (sda):\n"
+" Reads Queued:           2,       24KiB\t Writes Queued:           2,        8KiB\n";
+
+/*!**************************************************************
+ * fbe_rdgen_test_playback_trace()
+ ****************************************************************
+ * @brief
+ *  Write out a blkparse trace and replay it, once scaled onto
+ *  the drive at its recorded (compressed) timing and once
+ *  wrapping lbas without timing.
+ *
+ * @param None.               
+ *
+ * @return None.
+ *
+ ****************************************************************/
+
+void fbe_rdgen_test_playback_trace(void)
+{
+    fbe_status_t status;
+    fbe_api_rdgen_context_t *context_p = &fbe_rdgen_test_contexts[0];
+    fbe_char_t *file_p = "fbe_rdgen_unit_test_trace.blk";
+    fbe_file_handle_t file_handle;
+    fbe_u32_t bytes = (fbe_u32_t)strlen(fbe_rdgen_test_blkparse_trace);
+    fbe_u32_t pass;
+    fbe_time_t start_time;
+
+    file_handle = fbe_file_open(file_p, FBE_FILE_WRONLY | FBE_FILE_CREAT | FBE_FILE_TRUNC, 0, NULL);
+    MUT_ASSERT_TRUE(file_handle != FBE_FILE_INVALID_HANDLE);
+    MUT_ASSERT_INT_EQUAL(fbe_file_write(file_handle, fbe_rdgen_test_blkparse_trace, bytes, NULL), bytes);
+    fbe_file_close(file_handle);
+
+    for (pass = 0; pass < 2; pass++)
+    {
+        status = fbe_api_rdgen_test_context_init(context_p,
+                                                 fbe_rdgen_unit_test_physical_object_id,
+                                                 fbe_rdgen_unit_test_class_id,
+                                                 fbe_rdgen_unit_test_package_id,
+                                                 FBE_RDGEN_OPERATION_WRITE_ONLY,
+                                                 FBE_RDGEN_PATTERN_LBA_PASS,
+                                                 2, /* passes through the trace. */
+                                                 0, /* num ios not used */
+                                                 0, /* time not used */
+                                                 2, /* threads. */
+                                                 FBE_RDGEN_LBA_SPEC_FIXED,
+                                                 0, 0, FBE_LBA_INVALID,
+                                                 FBE_RDGEN_BLOCK_SPEC_CONSTANT,
+                                                 1, 1);
+        MUT_ASSERT_INT_EQUAL(status, FBE_STATUS_OK);
+        status = fbe_api_rdgen_filter_init_for_playback_trace(&context_p->start_io.filter, file_p,
+                                                              fbe_rdgen_unit_test_physical_object_id,
+                                                              fbe_rdgen_unit_test_package_id);
+        MUT_ASSERT_INT_EQUAL(status, FBE_STATUS_OK);
+        status = fbe_api_rdgen_io_specification_set_options(&context_p->start_io.specification, FBE_RDGEN_OPTIONS_FILE);
+        MUT_ASSERT_INT_EQUAL(status, FBE_STATUS_OK);
+
+        if (pass == 0)
+        {
+            /* The trace spans 200 msec, so two passes at half speed take at least 150 msec.
+             */
+            status = fbe_api_rdgen_io_specification_set_playback_trace(&context_p->start_io.specification,
+                                                                       FBE_RDGEN_PLAYBACK_FORMAT_BLKPARSE, 50);
+            MUT_ASSERT_INT_EQUAL(status, FBE_STATUS_OK);
+            status = fbe_api_rdgen_io_specification_set_extra_options(&context_p->start_io.specification,
+                                                                      FBE_RDGEN_EXTRA_OPTIONS_PLAYBACK_SCALE_LBA);
+        }
+        else
+        {
+            status = fbe_api_rdgen_io_specification_set_playback_trace(&context_p->start_io.specification,
+                                                                       FBE_RDGEN_PLAYBACK_FORMAT_BLKPARSE, 0);
+            MUT_ASSERT_INT_EQUAL(status, FBE_STATUS_OK);
+            status = fbe_api_rdgen_io_specification_set_extra_options(&context_p->start_io.specification,
+                                                                      FBE_RDGEN_EXTRA_OPTIONS_PLAYBACK_NO_TIMING);
+        }
+        MUT_ASSERT_INT_EQUAL(status, FBE_STATUS_OK);
+
+        start_time = fbe_get_time();
+        status = fbe_api_rdgen_run_tests(context_p, fbe_rdgen_unit_test_service_package_id, 1);
+        MUT_ASSERT_INT_EQUAL(status, FBE_STATUS_OK);
+        if (pass == 0)
+        {
+            MUT_ASSERT_TRUE(fbe_get_time() - start_time >= 150);
+        }
+
+        /* Each pass replays the five reads and writes.
+         */
+        MUT_ASSERT_INT_EQUAL(context_p->start_io.statistics.error_count, 0);
+        MUT_ASSERT_TRUE(context_p->start_io.statistics.io_count >= 5);
+
+        status = fbe_api_rdgen_test_context_destroy(context_p);
+        MUT_ASSERT_INT_EQUAL(status, FBE_STATUS_OK);
+    }
+    fbe_file_delete(file_p);
+    return;
+}
+/******************************************
+ * end fbe_rdgen_test_playback_trace()
+ ******************************************/
 
 /*!**************************************************************
  * fbe_rdgen_test_lba_block_errors()
@@ -1348,6 +1556,8 @@ void fbe_rdgen_test_add_unit_tests(mut_testsuite_t *suite_p)
     MUT_ADD_TEST(suite_p, fbe_rdgen_test_write_read_compare, fbe_rdgen_test_setup, fbe_rdgen_test_teardown);
     MUT_ADD_TEST(suite_p, fbe_rdgen_test_read_compare, fbe_rdgen_test_setup, fbe_rdgen_test_teardown);
     MUT_ADD_TEST(suite_p, fbe_rdgen_test_thread_counts, fbe_rdgen_test_setup, fbe_rdgen_test_teardown);
+    MUT_ADD_TEST(suite_p, fbe_rdgen_test_latency_histogram, fbe_rdgen_test_setup, fbe_rdgen_test_teardown);
+    MUT_ADD_TEST(suite_p, fbe_rdgen_test_playback_trace, fbe_rdgen_test_setup, fbe_rdgen_test_teardown);
     
     MUT_ADD_TEST(suite_p, fbe_rdgen_test_lba_block_errors, fbe_rdgen_test_setup, fbe_rdgen_test_teardown);
     MUT_ADD_TEST(suite_p, fbe_rdgen_test_thread_count_errors, fbe_rdgen_test_setup, fbe_rdgen_test_teardown);
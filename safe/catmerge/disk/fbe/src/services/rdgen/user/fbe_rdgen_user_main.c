@@ -121,6 +121,7 @@ fbe_status_t fbe_rdgen_ts_send_disk_device(fbe_rdgen_ts_t *ts_p,
     fbe_rdgen_ts_set_last_response_time(ts_p, usec);
     fbe_rdgen_ts_update_cum_resp_time(ts_p, usec);
     fbe_rdgen_ts_update_max_response_time(ts_p, usec);
+    fbe_rdgen_ts_update_latency_histogram(ts_p, usec);
     /* We just fake out status so that we can test this in simulation.
      */
     ts_p->last_packet_status.status = FBE_STATUS_OK;
@@ -361,6 +361,8 @@ fbe_status_t terminator_drive_set_state(fbe_terminator_device_ptr_t handle, term
 fbe_status_t terminator_sas_drive_get_default_page_info(fbe_sas_drive_type_t drive_type, fbe_terminator_sas_drive_type_default_info_t *default_info_p);
 fbe_status_t terminator_sas_drive_set_default_page_info(fbe_sas_drive_type_t drive_type, const fbe_terminator_sas_drive_type_default_info_t *default_info_p);
 fbe_status_t terminator_sas_drive_set_default_field(fbe_sas_drive_type_t drive_type, fbe_terminator_drive_default_field_t field, fbe_u8_t *data, fbe_u32_t size);
+fbe_status_t terminator_sas_drive_get_latency_model(fbe_sas_drive_type_t drive_type, fbe_terminator_drive_latency_model_t *model_p);
+fbe_status_t terminator_sas_drive_set_latency_model(fbe_sas_drive_type_t drive_type, const fbe_terminator_drive_latency_model_t *model_p);
 
 fbe_status_t terminator_drive_increment_error_count(fbe_terminator_device_ptr_t handle);
 //fbe_status_t terminator_drive_get_error_count(fbe_u32_t port_number,
@@ -79,6 +79,14 @@ typedef struct terminator_journal_record_s {
     terminator_journal_record_flags_t flags;
 }journal_record_t;
 
+/* Service time bookkeeping of the simulated disk latency model */
+typedef struct terminator_drive_latency_state_s{
+    fbe_lba_t   head_lba;          /* lba following the last media access */
+    fbe_time_t  bandwidth_free_us; /* when the bandwidth cap lets the next transfer start */
+    fbe_u32_t   outstanding;       /* I/Os waiting for their modelled completion */
+    fbe_time_t  channel_free_us[FBE_TERMINATOR_DRIVE_LATENCY_MAX_QUEUE_DEPTH]; /* when each service channel is idle */
+}terminator_drive_latency_state_t;
+
 typedef struct terminator_drive_s{
     base_component_t base;
 	fbe_u32_t reset_count;
@@ -114,6 +122,9 @@ typedef struct terminator_drive_s{
      */
     fbe_u32_t   maximum_transfer_bytes;
 
+    /* Latency model state, protected by the simulated disk latency lock */
+    terminator_drive_latency_state_t latency;
+
 }terminator_drive_t;
 
 typedef struct terminator_drive_array_s{
@@ -96,5 +96,19 @@ fbe_status_t terminator_simulated_disk_crypto_process_data(fbe_u8_t *data_buffer
                                                   fbe_u8_t *dek, 
                                                   fbe_u32_t dek_size);
 
+fbe_status_t terminator_simulated_disk_latency_init(void);
+fbe_status_t terminator_simulated_disk_latency_destroy(void);
+fbe_status_t terminator_simulated_disk_latency_set_model(fbe_sas_drive_type_t drive_type,
+                                                         const fbe_terminator_drive_latency_model_t *model_p);
+fbe_status_t terminator_simulated_disk_latency_get_model(fbe_sas_drive_type_t drive_type,
+                                                         fbe_terminator_drive_latency_model_t *model_p);
+fbe_bool_t terminator_simulated_disk_latency_is_queue_full(terminator_drive_t *drive);
+fbe_status_t terminator_simulated_disk_latency_defer_completion(terminator_drive_t *drive,
+                                                                struct fbe_terminator_io_s *terminator_io,
+                                                                fbe_lba_t lba,
+                                                                fbe_block_count_t blocks,
+                                                                fbe_bool_t b_read);
+void terminator_simulated_disk_latency_drive_flush(terminator_drive_t *drive);
+
 #endif /*TERMINATOR_SIMULATED_DISK_H*/
 
@@ -1582,6 +1582,7 @@ static fbe_status_t sas_drive_process_memory_xfer(fbe_payload_ex_t *payload_p,
                                                     sas_drive_xfer_data_t *xfer_data);
 
 /* Below are the functions that supports payload */
+static fbe_bool_t sas_drive_is_media_io_opcode(fbe_u8_t opcode);
 static fbe_status_t sas_drive_process_payload_inquiry (fbe_payload_ex_t * payload, fbe_terminator_device_ptr_t drive_handle);
 static fbe_status_t sas_drive_process_payload_read_capacity (fbe_payload_ex_t * payload, fbe_terminator_device_ptr_t drive_handle);
 static fbe_status_t sas_drive_process_payload_read_capacity_16 (fbe_payload_ex_t * payload, fbe_terminator_device_ptr_t drive_handle);
@@ -2393,6 +2394,16 @@ fbe_status_t fbe_terminator_sas_drive_payload(fbe_terminator_io_t * terminator_i
     else {
         terminator_io->b_key_valid = FBE_FALSE;
     }
+
+    /* A drive type modelled with an outstanding I/O limit rejects media I/O beyond it. */
+    if (sas_drive_is_media_io_opcode(*cdb_opcode) &&
+        terminator_simulated_disk_latency_is_queue_full((terminator_drive_t *)drive_handle))
+    {
+        fbe_payload_cdb_set_scsi_status(payload_cdb_operation, FBE_PAYLOAD_CDB_SCSI_STATUS_TASK_SET_FULL);
+        fbe_payload_cdb_set_request_status(payload_cdb_operation, FBE_PORT_REQUEST_STATUS_SUCCESS);
+        return FBE_STATUS_OK;
+    }
+
     /*check if we got a supported cdb*/
     switch(*cdb_opcode)
     {
@@ -2600,9 +2611,52 @@ fbe_status_t fbe_terminator_sas_drive_payload(fbe_terminator_io_t * terminator_i
         }
     }
     fbe_sas_drive_max_io_time_ms = FBE_MAX(fbe_sas_drive_max_io_time_ms, elapsed_ms);
+
+    /* The data has moved, hold the completion back by the modelled service time. */
+    if ((status == FBE_STATUS_OK) && sas_drive_is_media_io_opcode(*cdb_opcode))
+    {
+        status = terminator_simulated_disk_latency_defer_completion((terminator_drive_t *)drive_handle,
+                                                                    terminator_io,
+                                                                    xfer_data.lba,
+                                                                    xfer_data.blocks,
+                                                                    xfer_data.direction_in);
+    }
     return status;
 }
 
+/*!**************************************************************
+ * sas_drive_is_media_io_opcode()
+ ****************************************************************
+ * @brief
+ *  Determine if the opcode reads or writes the media and so is
+ *  subject to the simulated disk latency model.
+ *
+ * @param opcode - cdb opcode.
+ *
+ * @return FBE_TRUE for a media read or write.
+ *
+ ****************************************************************/
+static fbe_bool_t sas_drive_is_media_io_opcode(fbe_u8_t opcode)
+{
+    switch (opcode)
+    {
+    case FBE_SCSI_READ_6:
+    case FBE_SCSI_READ_10:
+    case FBE_SCSI_READ_16:
+    case FBE_SCSI_WRITE_6:
+    case FBE_SCSI_WRITE_10:
+    case FBE_SCSI_WRITE_16:
+    case FBE_SCSI_WRITE_VERIFY:
+    case FBE_SCSI_WRITE_VERIFY_16:
+        return FBE_TRUE;
+    default:
+        return FBE_FALSE;
+    }
+}
+/****************************************
+ * end sas_drive_is_media_io_opcode()
+ ****************************************/
+
 static fbe_status_t
 sas_drive_process_payload_inquiry (fbe_payload_ex_t * payload, fbe_terminator_device_ptr_t drive_handle)
 {
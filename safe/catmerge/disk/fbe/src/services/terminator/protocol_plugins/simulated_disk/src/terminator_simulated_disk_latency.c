@@ -0,0 +1,525 @@
+/***************************************************************************
+ *  terminator_simulated_disk_latency.c
+ ***************************************************************************
+ *
+ *  Description
+ *      Service time models for the simulated disk.  A drive type can be
+ *      given an HDD model (seek and rotational cost) or a flash model
+ *      (per I/O cost), both with a per KB transfer cost, a queue depth,
+ *      an outstanding I/O limit and a bandwidth cap.
+ *
+ *      The media access itself is still done synchronously by the drive
+ *      plugin.  Only the completion of the I/O is held back until the
+ *      modelled completion time, on a timer thread, so the drive looks
+ *      slow to the rest of the stack without slowing down the port thread.
+ *
+ ***************************************************************************/
+#include "terminator_simulated_disk_private.h"
+#include "fbe/fbe_queue.h"
+#include "fbe/fbe_time.h"
+#include "fbe_terminator.h"
+#include "fbe_terminator_common.h"
+#include "terminator_drive.h"
+#include "terminator_simulated_disk.h"
+#include "terminator_miniport_api_private.h"
+
+/**********************************/
+/*        local definitions       */
+/**********************************/
+
+/* Resolution of the completion timer in milliseconds */
+#define TERMINATOR_SIMULATED_DISK_LATENCY_TIMER_RESOLUTION 1L
+
+typedef enum latency_timer_thread_flag_e{
+    LATENCY_TIMER_THREAD_RUN,
+    LATENCY_TIMER_THREAD_STOP,
+    LATENCY_TIMER_THREAD_DONE
+}latency_timer_thread_flag_t;
+
+typedef struct terminator_simulated_disk_latency_timer_s{
+    fbe_queue_element_t   queue_element;
+    fbe_terminator_io_t  *terminator_io;
+    terminator_drive_t   *drive;
+    fbe_time_t            completion_time_us;
+}terminator_simulated_disk_latency_timer_t;
+
+/**********************************/
+/*        local variables         */
+/**********************************/
+
+/* Protects the models, the timer queue and the latency state of all drives */
+static fbe_spinlock_t                       latency_lock;
+/* Deferred completions, sorted by completion time */
+static fbe_queue_head_t                     latency_timer_queue_head;
+static fbe_thread_t                         latency_timer_thread_handle;
+static latency_timer_thread_flag_t          latency_timer_thread_flag = LATENCY_TIMER_THREAD_DONE;
+static fbe_terminator_drive_latency_model_t latency_models[FBE_SAS_DRIVE_LAST];
+
+/******************************/
+/*     local function         */
+/*****************************/
+static void latency_timer_thread_func(void * context);
+static void latency_timer_dispatch_queue(terminator_drive_t *drive, fbe_bool_t b_all);
+static fbe_time_t latency_compute_service_time(const fbe_terminator_drive_latency_model_t *model,
+                                               terminator_drive_t *drive,
+                                               fbe_lba_t lba,
+                                               fbe_block_count_t blocks,
+                                               fbe_bool_t b_read);
+
+/*!**************************************************************
+ * terminator_simulated_disk_latency_init()
+ ****************************************************************
+ * @brief
+ *  Clear the models of all drive types and start the thread that
+ *  completes deferred I/O.
+ *
+ * @param None.
+ *
+ * @return fbe_status_t
+ *
+ ****************************************************************/
+fbe_status_t terminator_simulated_disk_latency_init(void)
+{
+    terminator_trace(FBE_TRACE_LEVEL_DEBUG_HIGH,
+                     FBE_TRACE_MESSAGE_ID_FUNCTION_ENTRY,
+                     "%s entry\n", __FUNCTION__);
+
+    fbe_spinlock_init(&latency_lock);
+    fbe_queue_init(&latency_timer_queue_head);
+    fbe_zero_memory(latency_models, sizeof(latency_models));
+
+    latency_timer_thread_flag = LATENCY_TIMER_THREAD_RUN;
+    fbe_thread_init(&latency_timer_thread_handle, "terminator_disk_latency", latency_timer_thread_func, NULL);
+
+    return FBE_STATUS_OK;
+}
+/****************************************
+ * end terminator_simulated_disk_latency_init()
+ ****************************************/
+
+/*!**************************************************************
+ * terminator_simulated_disk_latency_destroy()
+ ****************************************************************
+ * @brief
+ *  Stop the timer thread and complete whatever I/O is still
+ *  waiting for its modelled completion time.
+ *
+ * @param None.
+ *
+ * @return fbe_status_t
+ *
+ ****************************************************************/
+fbe_status_t terminator_simulated_disk_latency_destroy(void)
+{
+    terminator_trace(FBE_TRACE_LEVEL_DEBUG_HIGH,
+                     FBE_TRACE_MESSAGE_ID_FUNCTION_ENTRY,
+                     "%s entry\n", __FUNCTION__);
+
+    if (latency_timer_thread_flag == LATENCY_TIMER_THREAD_RUN)
+    {
+        latency_timer_thread_flag = LATENCY_TIMER_THREAD_STOP;
+        fbe_thread_wait(&latency_timer_thread_handle);
+        fbe_thread_destroy(&latency_timer_thread_handle);
+
+        latency_timer_dispatch_queue(NULL, FBE_TRUE);
+
+        fbe_queue_destroy(&latency_timer_queue_head);
+        fbe_spinlock_destroy(&latency_lock);
+    }
+
+    return FBE_STATUS_OK;
+}
+/****************************************
+ * end terminator_simulated_disk_latency_destroy()
+ ****************************************/
+
+/*!**************************************************************
+ * terminator_simulated_disk_latency_set_model()
+ ****************************************************************
+ * @brief
+ *  Set the service time model of a drive type.  Drives of that
+ *  type already inserted pick the model up with their next I/O.
+ *
+ * @param drive_type - sas drive type the model applies to.
+ * @param model_p - model to apply.
+ *
+ * @return fbe_status_t
+ *
+ ****************************************************************/
+fbe_status_t terminator_simulated_disk_latency_set_model(fbe_sas_drive_type_t drive_type,
+                                                         const fbe_terminator_drive_latency_model_t *model_p)
+{
+    if ((drive_type <= FBE_SAS_DRIVE_INVALID) || (drive_type >= FBE_SAS_DRIVE_LAST))
+    {
+        terminator_trace(FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                         "%s: invalid drive type %d\n", __FUNCTION__, drive_type);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+    if ((model_p->model_type > FBE_TERMINATOR_DRIVE_LATENCY_MODEL_FLASH) ||
+        (model_p->queue_depth > FBE_TERMINATOR_DRIVE_LATENCY_MAX_QUEUE_DEPTH) ||
+        (model_p->full_stroke_seek_us < model_p->track_to_track_seek_us))
+    {
+        terminator_trace(FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                         "%s: invalid model type: %d queue depth: %d seek: %d/%d us\n",
+                         __FUNCTION__, model_p->model_type, model_p->queue_depth,
+                         model_p->track_to_track_seek_us, model_p->full_stroke_seek_us);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    fbe_spinlock_lock(&latency_lock);
+    latency_models[drive_type] = *model_p;
+    fbe_spinlock_unlock(&latency_lock);
+
+    terminator_trace(FBE_TRACE_LEVEL_INFO, FBE_TRACE_MESSAGE_ID_INFO,
+                     "%s: drive type %d model %d qd: %d max: %d bw: %d MB/s\n",
+                     __FUNCTION__, drive_type, model_p->model_type, model_p->queue_depth,
+                     model_p->max_outstanding, model_p->bandwidth_mb_per_sec);
+    return FBE_STATUS_OK;
+}
+/****************************************
+ * end terminator_simulated_disk_latency_set_model()
+ ****************************************/
+
+/*!**************************************************************
+ * terminator_simulated_disk_latency_get_model()
+ ****************************************************************
+ * @brief
+ *  Return the service time model of a drive type.
+ *
+ * @param drive_type - sas drive type.
+ * @param model_p - model that is returned.
+ *
+ * @return fbe_status_t
+ *
+ ****************************************************************/
+fbe_status_t terminator_simulated_disk_latency_get_model(fbe_sas_drive_type_t drive_type,
+                                                         fbe_terminator_drive_latency_model_t *model_p)
+{
+    if ((drive_type <= FBE_SAS_DRIVE_INVALID) || (drive_type >= FBE_SAS_DRIVE_LAST))
+    {
+        terminator_trace(FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                         "%s: invalid drive type %d\n", __FUNCTION__, drive_type);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    fbe_spinlock_lock(&latency_lock);
+    *model_p = latency_models[drive_type];
+    fbe_spinlock_unlock(&latency_lock);
+    return FBE_STATUS_OK;
+}
+/****************************************
+ * end terminator_simulated_disk_latency_get_model()
+ ****************************************/
+
+/*!**************************************************************
+ * terminator_simulated_disk_latency_is_queue_full()
+ ****************************************************************
+ * @brief
+ *  Determine if the drive already holds as many I/Os as its model
+ *  allows, in which case the next media I/O gets TASK SET FULL.
+ *
+ * @param drive - drive the I/O is for.
+ *
+ * @return FBE_TRUE if the I/O must be rejected.
+ *
+ ****************************************************************/
+fbe_bool_t terminator_simulated_disk_latency_is_queue_full(terminator_drive_t *drive)
+{
+    fbe_sas_drive_type_t drive_type;
+    fbe_bool_t b_full = FBE_FALSE;
+
+    if ((terminator_drive_get_type(drive, &drive_type) != FBE_STATUS_OK) ||
+        (drive_type <= FBE_SAS_DRIVE_INVALID) || (drive_type >= FBE_SAS_DRIVE_LAST))
+    {
+        return FBE_FALSE;
+    }
+
+    fbe_spinlock_lock(&latency_lock);
+    if ((latency_models[drive_type].model_type != FBE_TERMINATOR_DRIVE_LATENCY_MODEL_NONE) &&
+        (latency_models[drive_type].max_outstanding != 0) &&
+        (drive->latency.outstanding >= latency_models[drive_type].max_outstanding))
+    {
+        b_full = FBE_TRUE;
+    }
+    fbe_spinlock_unlock(&latency_lock);
+    return b_full;
+}
+/****************************************
+ * end terminator_simulated_disk_latency_is_queue_full()
+ ****************************************/
+
+/*!**************************************************************
+ * terminator_simulated_disk_latency_defer_completion()
+ ****************************************************************
+ * @brief
+ *  Charge a media I/O that was just serviced to the model of its
+ *  drive type.  The I/O is started on the service channel that
+ *  frees up first, held to the bandwidth cap, and its completion
+ *  is queued to the timer thread.
+ *
+ * @param drive - drive the I/O is for.
+ * @param terminator_io - I/O to complete.
+ * @param lba - first block accessed.
+ * @param blocks - number of blocks accessed.
+ * @param b_read - FBE_TRUE for a read.
+ *
+ * @return FBE_STATUS_PENDING if the timer thread completes the I/O,
+ *         FBE_STATUS_OK if the caller completes it now.
+ *
+ ****************************************************************/
+fbe_status_t terminator_simulated_disk_latency_defer_completion(terminator_drive_t *drive,
+                                                                struct fbe_terminator_io_s *terminator_io,
+                                                                fbe_lba_t lba,
+                                                                fbe_block_count_t blocks,
+                                                                fbe_bool_t b_read)
+{
+    fbe_sas_drive_type_t drive_type;
+    const fbe_terminator_drive_latency_model_t *model;
+    terminator_simulated_disk_latency_timer_t *timer = NULL;
+    fbe_queue_element_t *element = NULL;
+    fbe_queue_element_t *next_element = NULL;
+    fbe_time_t current_time_us;
+    fbe_time_t start_time_us;
+    fbe_time_t completion_time_us;
+    fbe_u32_t queue_depth;
+    fbe_u32_t channel;
+    fbe_u32_t index;
+
+    if ((terminator_drive_get_type(drive, &drive_type) != FBE_STATUS_OK) ||
+        (drive_type <= FBE_SAS_DRIVE_INVALID) || (drive_type >= FBE_SAS_DRIVE_LAST) ||
+        (latency_models[drive_type].model_type == FBE_TERMINATOR_DRIVE_LATENCY_MODEL_NONE))
+    {
+        return FBE_STATUS_OK;
+    }
+
+    timer = (terminator_simulated_disk_latency_timer_t *)fbe_terminator_allocate_memory(sizeof(terminator_simulated_disk_latency_timer_t));
+    if (timer == NULL)
+    {
+        terminator_trace(FBE_TRACE_LEVEL_WARNING, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                         "%s: allocate latency timer failed, completing unmodelled\n", __FUNCTION__);
+        return FBE_STATUS_OK;
+    }
+
+    fbe_spinlock_lock(&latency_lock);
+    model = &latency_models[drive_type];
+    current_time_us = fbe_get_time_in_us();
+
+    /* Start on the service channel that frees up first.
+     */
+    queue_depth = (model->queue_depth == 0) ? 1 : model->queue_depth;
+    channel = 0;
+    for (index = 1; index < queue_depth; index++)
+    {
+        if (drive->latency.channel_free_us[index] < drive->latency.channel_free_us[channel])
+        {
+            channel = index;
+        }
+    }
+    start_time_us = FBE_MAX(current_time_us, drive->latency.channel_free_us[channel]);
+    completion_time_us = start_time_us + latency_compute_service_time(model, drive, lba, blocks, b_read);
+
+    /* The bandwidth cap is shared by all channels.  1 MB/s moves about a byte per usec.
+     */
+    if (model->bandwidth_mb_per_sec != 0)
+    {
+        drive->latency.bandwidth_free_us = FBE_MAX(drive->latency.bandwidth_free_us, start_time_us) +
+                                           (blocks * drive->block_size) / model->bandwidth_mb_per_sec;
+        completion_time_us = FBE_MAX(completion_time_us, drive->latency.bandwidth_free_us);
+    }
+    drive->latency.channel_free_us[channel] = completion_time_us;
+
+    if (completion_time_us <= current_time_us)
+    {
+        fbe_spinlock_unlock(&latency_lock);
+        fbe_terminator_free_memory(timer);
+        return FBE_STATUS_OK;
+    }
+
+    timer->terminator_io = terminator_io;
+    timer->drive = drive;
+    timer->completion_time_us = completion_time_us;
+    drive->latency.outstanding++;
+
+    /* Keep the queue sorted, searching from the tail since later I/Os mostly complete later.
+     */
+    next_element = &latency_timer_queue_head;
+    element = fbe_queue_is_empty(&latency_timer_queue_head) ? NULL : (fbe_queue_element_t *)latency_timer_queue_head.prev;
+    while ((element != NULL) &&
+           (((terminator_simulated_disk_latency_timer_t *)element)->completion_time_us > completion_time_us))
+    {
+        next_element = element;
+        element = fbe_queue_prev(&latency_timer_queue_head, element);
+    }
+    fbe_queue_insert(&timer->queue_element, next_element);
+    fbe_spinlock_unlock(&latency_lock);
+
+    return FBE_STATUS_PENDING;
+}
+/****************************************
+ * end terminator_simulated_disk_latency_defer_completion()
+ ****************************************/
+
+/*!**************************************************************
+ * terminator_simulated_disk_latency_drive_flush()
+ ****************************************************************
+ * @brief
+ *  Complete all the deferred I/O of a drive that is going away.
+ *
+ * @param drive - drive being freed.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void terminator_simulated_disk_latency_drive_flush(terminator_drive_t *drive)
+{
+    if (latency_timer_thread_flag == LATENCY_TIMER_THREAD_RUN)
+    {
+        latency_timer_dispatch_queue(drive, FBE_TRUE);
+    }
+}
+/****************************************
+ * end terminator_simulated_disk_latency_drive_flush()
+ ****************************************/
+
+/*!**************************************************************
+ * latency_compute_service_time()
+ ****************************************************************
+ * @brief
+ *  Service time of one I/O under the model, not counting the time
+ *  it waits for a channel or for bandwidth.  Called with the
+ *  latency lock held since it moves the HDD head.
+ *
+ * @param model - model of the drive type.
+ * @param drive - drive the I/O is for.
+ * @param lba - first block accessed.
+ * @param blocks - number of blocks accessed.
+ * @param b_read - FBE_TRUE for a read.
+ *
+ * @return service time in usec.
+ *
+ ****************************************************************/
+static fbe_time_t latency_compute_service_time(const fbe_terminator_drive_latency_model_t *model,
+                                               terminator_drive_t *drive,
+                                               fbe_lba_t lba,
+                                               fbe_block_count_t blocks,
+                                               fbe_bool_t b_read)
+{
+    fbe_time_t service_time_us;
+    fbe_lba_t distance;
+    fbe_lba_t seek_step;
+
+    /* Media transfer, rounded up to whole KBs.
+     */
+    service_time_us = (((blocks * drive->block_size) + 1023) / 1024) * model->per_kb_us;
+
+    switch (model->model_type)
+    {
+    case FBE_TERMINATOR_DRIVE_LATENCY_MODEL_HDD:
+        /* A sequential access continues where the head is.  Anything else seeks
+         * in proportion to the distance (in 1/1024ths of the capacity) and then
+         * waits half a revolution on average.
+         */
+        if (lba != drive->latency.head_lba)
+        {
+            distance = (lba > drive->latency.head_lba) ? (lba - drive->latency.head_lba) : (drive->latency.head_lba - lba);
+            seek_step = (drive->capacity / 1024) + 1;
+            service_time_us += model->track_to_track_seek_us +
+                               ((model->full_stroke_seek_us - model->track_to_track_seek_us) * FBE_MIN(distance / seek_step, 1024)) / 1024;
+            if (model->rpm != 0)
+            {
+                service_time_us += 30000000 / model->rpm;
+            }
+        }
+        drive->latency.head_lba = lba + blocks;
+        break;
+    case FBE_TERMINATOR_DRIVE_LATENCY_MODEL_FLASH:
+        service_time_us += (b_read) ? model->read_us : model->write_us;
+        break;
+    default:
+        break;
+    }
+    return service_time_us;
+}
+/****************************************
+ * end latency_compute_service_time()
+ ****************************************/
+
+static void latency_timer_thread_func(void * context)
+{
+    FBE_UNREFERENCED_PARAMETER(context);
+
+    terminator_trace(FBE_TRACE_LEVEL_DEBUG_HIGH,
+                     FBE_TRACE_MESSAGE_ID_FUNCTION_ENTRY,
+                     "%s entry\n", __FUNCTION__);
+
+    while(1)
+    {
+        fbe_thread_delay(TERMINATOR_SIMULATED_DISK_LATENCY_TIMER_RESOLUTION);
+        if (latency_timer_thread_flag == LATENCY_TIMER_THREAD_RUN) {
+            latency_timer_dispatch_queue(NULL, FBE_FALSE);
+        } else {
+            break;
+        }
+    }
+
+    terminator_trace(FBE_TRACE_LEVEL_DEBUG_HIGH,
+                     FBE_TRACE_MESSAGE_ID_FUNCTION_ENTRY,
+                     "%s done\n", __FUNCTION__);
+
+    latency_timer_thread_flag = LATENCY_TIMER_THREAD_DONE;
+    fbe_thread_exit(EMCPAL_STATUS_SUCCESS);
+}
+
+/*!**************************************************************
+ * latency_timer_dispatch_queue()
+ ****************************************************************
+ * @brief
+ *  Complete the deferred I/O whose completion time has come.
+ *
+ * @param drive - only complete I/O of this drive, NULL for all drives.
+ * @param b_all - FBE_TRUE to complete regardless of completion time.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void latency_timer_dispatch_queue(terminator_drive_t *drive, fbe_bool_t b_all)
+{
+    terminator_simulated_disk_latency_timer_t *timer = NULL;
+    terminator_simulated_disk_latency_timer_t *next_timer = NULL;
+    fbe_queue_head_t expired_queue_head;
+    fbe_time_t current_time_us = fbe_get_time_in_us();
+
+    fbe_queue_init(&expired_queue_head);
+
+    fbe_spinlock_lock(&latency_lock);
+    next_timer = (terminator_simulated_disk_latency_timer_t *)fbe_queue_front(&latency_timer_queue_head);
+    while (next_timer != NULL)
+    {
+        timer = next_timer;
+        if (!b_all && (timer->completion_time_us > current_time_us))
+        {
+            /* Sorted, so nothing after this has expired either */
+            break;
+        }
+        next_timer = (terminator_simulated_disk_latency_timer_t *)fbe_queue_next(&latency_timer_queue_head, &timer->queue_element);
+        if ((drive == NULL) || (timer->drive == drive))
+        {
+            fbe_queue_remove(&timer->queue_element);
+            timer->drive->latency.outstanding--;
+            fbe_queue_push(&expired_queue_head, &timer->queue_element);
+        }
+    }
+    fbe_spinlock_unlock(&latency_lock);
+
+    /* Complete outside of the lock */
+    while (!fbe_queue_is_empty(&expired_queue_head))
+    {
+        timer = (terminator_simulated_disk_latency_timer_t *)fbe_queue_pop(&expired_queue_head);
+        fbe_terminator_miniport_api_complete_io(timer->terminator_io->miniport_port_index, timer->terminator_io);
+        fbe_terminator_free_memory(timer);
+    }
+    fbe_queue_destroy(&expired_queue_head);
+}
+/****************************************
+ * end latency_timer_dispatch_queue()
+ ****************************************/
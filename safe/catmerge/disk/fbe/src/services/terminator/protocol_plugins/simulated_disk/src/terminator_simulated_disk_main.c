@@ -47,51 +47,135 @@ fbe_status_t terminator_simulated_disk_generate_zero_buffer(fbe_u8_t * data_buff
     return FBE_STATUS_OK;
 }
 
+/*!**************************************************************
+ * terminator_simulated_disk_crypto_process_block_bytes()
+ ****************************************************************
+ * @brief
+ *  Encrypt or decrypt one block a byte at a time.  The data area is
+ *  xored with the key and the 8 bytes of metadata are inverted.
+ *
+ * @param block_p - Start of the block.
+ * @param dek - Key to xor the data with.
+ * @param dek_size - Bytes in the key.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void terminator_simulated_disk_crypto_process_block_bytes(fbe_u8_t *block_p,
+                                                                 fbe_u8_t *dek,
+                                                                 fbe_u32_t dek_size)
+{
+    fbe_u8_t * data_chunk_ptr = block_p;
+    fbe_u8_t * dek_chunk_ptr = dek;
+    fbe_u32_t data_counter = 0;
+    fbe_u32_t metadata_counter = 0;
+
+    for(data_counter = 0; data_counter < dek_size; data_counter++)
+    {
+        *data_chunk_ptr ^= *dek_chunk_ptr;
+        data_chunk_ptr++;
+        dek_chunk_ptr++;
+    }
+
+    /* Move the pointer to the Metadata area */
+    data_chunk_ptr = block_p + FBE_BYTES_PER_BLOCK;
+
+    /*Now Encrypt the metadata (last 8 bytes)*/
+    for (metadata_counter = 0; metadata_counter < (FBE_BE_BYTES_PER_BLOCK - FBE_BYTES_PER_BLOCK) ; metadata_counter++)
+    {
+        *data_chunk_ptr = ~(*data_chunk_ptr);
+        data_chunk_ptr++;
+    }
+    return;
+}
+/******************************************
+ * end terminator_simulated_disk_crypto_process_block_bytes()
+ ******************************************/
+
+/*!**************************************************************
+ * terminator_simulated_disk_crypto_process_data()
+ ****************************************************************
+ * @brief
+ *  Encrypt or decrypt a buffer of 520 byte blocks.  The transform is
+ *  its own inverse.  Whole blocks are done 8 bytes at a time, which gives
+ *  exactly the same bytes as doing them one at a time since both the xor
+ *  with the key and the metadata invert work on each byte on its own.
+ *
+ * @param data_buffer - Blocks to transform in place.
+ * @param buffer_size - Bytes in the buffer.
+ * @param dek - Key to xor the data with.
+ * @param dek_size - Bytes in the key.
+ *
+ * @return fbe_status_t
+ *
+ ****************************************************************/
 fbe_status_t terminator_simulated_disk_crypto_process_data(fbe_u8_t *data_buffer,
                                                   fbe_u32_t buffer_size,
                                                   fbe_u8_t *dek, 
                                                   fbe_u32_t dek_size)
 {
-    fbe_u8_t * data_chunk_ptr = NULL;
-    fbe_u8_t * dek_chunk_ptr = NULL;
-    fbe_u32_t data_counter = 0;
+    fbe_u64_t dek_words[FBE_BYTES_PER_BLOCK / sizeof(fbe_u64_t)];
+    fbe_u64_t * block_words_p = NULL;
+    fbe_u32_t dek_word_count;
+    fbe_u32_t word_index;
+    fbe_u32_t byte_index;
     fbe_u32_t block_counter = 0;
-    fbe_u32_t metadata_counter = 0;
 
     if (data_buffer == NULL)
     {
         return FBE_STATUS_GENERIC_FAILURE;
     }
 
-    //Loop through 1 block data of at a time
-    for (block_counter = 0; block_counter < buffer_size; block_counter += FBE_BE_BYTES_PER_BLOCK)
+    /* Words only work when the key fits in the data area and the blocks are 8 byte aligned.
+     * 520 is a multiple of 8 so if the first block is aligned they all are. 
+     */
+    if ((dek_size > FBE_BYTES_PER_BLOCK) ||
+        ((((fbe_u64_t)(csx_ptrhld_t)data_buffer) & (sizeof(fbe_u64_t) - 1)) != 0))
     {
-        data_chunk_ptr = data_buffer;
-        dek_chunk_ptr = dek;
-        for(data_counter = 0; data_counter < dek_size; data_counter++)
+        for (block_counter = 0; block_counter < buffer_size; block_counter += FBE_BE_BYTES_PER_BLOCK)
         {
-            *data_chunk_ptr ^= *dek_chunk_ptr;
-            data_chunk_ptr++;
-            dek_chunk_ptr++;
+            terminator_simulated_disk_crypto_process_block_bytes(data_buffer, dek, dek_size);
+            data_buffer += FBE_BE_BYTES_PER_BLOCK;
         }
+        return FBE_STATUS_OK;
+    }
 
-        /* Move the pointer to the Metadata area */
-        data_chunk_ptr = data_buffer + FBE_BYTES_PER_BLOCK;
-
-        /*Now Encrypt the metadata (last 8 bytes)*/
+    /* The key may not be aligned, so copy the whole words of it once.
+     */
+    dek_word_count = dek_size / sizeof(fbe_u64_t);
+    fbe_copy_memory(dek_words, dek, dek_word_count * sizeof(fbe_u64_t));
 
-        for (metadata_counter = 0; metadata_counter < (FBE_BE_BYTES_PER_BLOCK - FBE_BYTES_PER_BLOCK) ; metadata_counter++)
+    for (block_counter = 0; (block_counter + FBE_BE_BYTES_PER_BLOCK) <= buffer_size; block_counter += FBE_BE_BYTES_PER_BLOCK)
+    {
+        block_words_p = (fbe_u64_t *)data_buffer;
+        for (word_index = 0; word_index < dek_word_count; word_index++)
+        {
+            block_words_p[word_index] ^= dek_words[word_index];
+        }
+        for (byte_index = dek_word_count * sizeof(fbe_u64_t); byte_index < dek_size; byte_index++)
         {
-            *data_chunk_ptr = ~(*data_chunk_ptr);
-            data_chunk_ptr++;
+            data_buffer[byte_index] ^= dek[byte_index];
         }
 
+        /* The metadata is the last 8 bytes, invert them all at once.
+         */
+        block_words_p[FBE_BYTES_PER_BLOCK / sizeof(fbe_u64_t)] = ~block_words_p[FBE_BYTES_PER_BLOCK / sizeof(fbe_u64_t)];
+
         data_buffer += FBE_BE_BYTES_PER_BLOCK;
+    }
 
+    /* A partial block at the end is done the same way it always was.
+     */
+    if (block_counter < buffer_size)
+    {
+        terminator_simulated_disk_crypto_process_block_bytes(data_buffer, dek, dek_size);
     }
 
     return FBE_STATUS_OK;
-}   
+}
+/******************************************
+ * end terminator_simulated_disk_crypto_process_data()
+ ******************************************/
 
 fbe_status_t terminator_simulated_disk_encrypt_data(fbe_u8_t *data_buffer,
                                            fbe_u32_t buffer_size,
@@ -125,6 +125,8 @@ static fbe_status_t fbe_terminator_service_send_specl_sfi_mask_data(fbe_packet_t
 static fbe_status_t fbe_terminator_service_drive_set_state (fbe_packet_t *packet);
 static fbe_status_t fbe_terminator_service_drive_get_default_page_info(fbe_packet_t *packet);
 static fbe_status_t fbe_terminator_service_drive_set_default_page_info(fbe_packet_t *packet);
+static fbe_status_t fbe_terminator_service_drive_get_latency_model(fbe_packet_t *packet);
+static fbe_status_t fbe_terminator_service_drive_set_latency_model(fbe_packet_t *packet);
 static fbe_status_t fbe_terminator_service_drive_set_default_field(fbe_packet_t *packet);
 static fbe_status_t fbe_terminator_service_set_need_update_enclosure_resume_prom_checksum (fbe_packet_t *packet);
 static fbe_status_t fbe_terminator_service_get_need_update_enclosure_resume_prom_checksum (fbe_packet_t *packet);
@@ -447,6 +449,12 @@ fbe_status_t fbe_terminator_service_send_packet(fbe_packet_t *packet)
     case FBE_TERMINATOR_CONTROL_CODE_DRIVE_SET_DEFAULT_PAGE_INFO:
         status = fbe_terminator_service_drive_set_default_page_info(packet);
         break;
+    case FBE_TERMINATOR_CONTROL_CODE_DRIVE_GET_LATENCY_MODEL:
+        status = fbe_terminator_service_drive_get_latency_model(packet);
+        break;
+    case FBE_TERMINATOR_CONTROL_CODE_DRIVE_SET_LATENCY_MODEL:
+        status = fbe_terminator_service_drive_set_latency_model(packet);
+        break;
     case FBE_TERMINATOR_CONTROL_CODE_DRIVE_SET_DEFAULT_FIELD:
         status = fbe_terminator_service_drive_set_default_field(packet);
         break;
@@ -3748,6 +3756,76 @@ static fbe_status_t fbe_terminator_service_drive_set_default_page_info(fbe_packe
 }
 
 
+static fbe_status_t fbe_terminator_service_drive_get_latency_model(fbe_packet_t *packet)
+{
+    fbe_terminator_drive_latency_model_ioctl_t * ioctl = NULL;
+    fbe_status_t status = FBE_STATUS_GENERIC_FAILURE;
+    fbe_payload_control_buffer_length_t len = 0;
+    fbe_payload_control_operation_t * control_operation = NULL; 
+
+    terminator_trace(FBE_TRACE_LEVEL_DEBUG_HIGH, FBE_TRACE_MESSAGE_ID_INFO, "%s entry\n", __FUNCTION__);
+
+    fbe_terminator_service_get_control_operation(packet, &control_operation);
+
+    fbe_payload_control_get_buffer_length(control_operation, &len); 
+    if (len != sizeof(fbe_terminator_drive_latency_model_ioctl_t))
+    {
+        terminator_trace(FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_INVALID_IN_LEN, "%s Invalid buffer_len: %d\n", __FUNCTION__, len);
+        fbe_transport_set_status(packet, FBE_STATUS_GENERIC_FAILURE, 0);
+        fbe_transport_complete_packet(packet);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    fbe_payload_control_get_buffer(control_operation, &ioctl); 
+    if (ioctl == NULL)
+    {
+        terminator_trace(FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_INFO, "%s fbe_payload_control_get_buffer fail\n", __FUNCTION__);
+        fbe_transport_set_status(packet, FBE_STATUS_GENERIC_FAILURE, 0);
+        fbe_transport_complete_packet(packet);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+    status  = fbe_terminator_api_drive_get_latency_model (ioctl->drive_type, &ioctl->model);
+    fbe_transport_set_status(packet, status, 0);
+    fbe_transport_complete_packet(packet);
+    return FBE_STATUS_OK;
+}
+
+
+static fbe_status_t fbe_terminator_service_drive_set_latency_model(fbe_packet_t *packet)
+{
+    fbe_terminator_drive_latency_model_ioctl_t * ioctl = NULL;
+    fbe_status_t status = FBE_STATUS_GENERIC_FAILURE;
+    fbe_payload_control_buffer_length_t len = 0;
+    fbe_payload_control_operation_t * control_operation = NULL; 
+
+    terminator_trace(FBE_TRACE_LEVEL_DEBUG_HIGH, FBE_TRACE_MESSAGE_ID_INFO, "%s entry\n", __FUNCTION__);
+
+    fbe_terminator_service_get_control_operation(packet, &control_operation);
+
+    fbe_payload_control_get_buffer_length(control_operation, &len); 
+    if (len != sizeof(fbe_terminator_drive_latency_model_ioctl_t))
+    {
+        terminator_trace(FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_INVALID_IN_LEN, "%s Invalid buffer_len: %d\n", __FUNCTION__, len);
+        fbe_transport_set_status(packet, FBE_STATUS_GENERIC_FAILURE, 0);
+        fbe_transport_complete_packet(packet);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    fbe_payload_control_get_buffer(control_operation, &ioctl); 
+    if (ioctl == NULL)
+    {
+        terminator_trace(FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_INFO, "%s fbe_payload_control_get_buffer fail\n", __FUNCTION__);
+        fbe_transport_set_status(packet, FBE_STATUS_GENERIC_FAILURE, 0);
+        fbe_transport_complete_packet(packet);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+    status  = fbe_terminator_api_drive_set_latency_model (ioctl->drive_type, &ioctl->model);
+    fbe_transport_set_status(packet, status, 0);
+    fbe_transport_complete_packet(packet);
+    return FBE_STATUS_OK;
+}
+
+
 static fbe_status_t fbe_terminator_service_drive_set_default_field(fbe_packet_t *packet)
 {
     fbe_terminator_drive_default_ioctl_t * p_ioctl = NULL;
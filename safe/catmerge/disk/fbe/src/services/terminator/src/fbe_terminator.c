@@ -109,6 +109,9 @@ fbe_status_t terminator_init (void)
     status = terminator_sas_drive_write_buffer_timer_init();
     RETURN_ON_ERROR_STATUS;
 
+    status = terminator_simulated_disk_latency_init();
+    RETURN_ON_ERROR_STATUS;
+
     fbe_spinlock_init(&terminator_encl_firmware_activate_thread_queue_lock);
     fbe_queue_init(&terminator_encl_firmware_activate_thread_queue_head);
 
@@ -550,6 +553,9 @@ fbe_status_t terminator_destroy(void)
     status = terminator_sas_drive_write_buffer_timer_destroy();
     RETURN_ON_ERROR_STATUS;
 
+    status = terminator_simulated_disk_latency_destroy();
+    RETURN_ON_ERROR_STATUS;
+
     status = terminator_remove_board();
     RETURN_ON_ERROR_STATUS;
 
@@ -3614,6 +3620,16 @@ fbe_status_t terminator_sas_drive_set_default_page_info(fbe_sas_drive_type_t dri
     return sas_drive_set_default_page_info(drive_type, default_info_p);
 }
 
+fbe_status_t terminator_sas_drive_get_latency_model(fbe_sas_drive_type_t drive_type, fbe_terminator_drive_latency_model_t *model_p)
+{
+    return terminator_simulated_disk_latency_get_model(drive_type, model_p);
+}
+
+fbe_status_t terminator_sas_drive_set_latency_model(fbe_sas_drive_type_t drive_type, const fbe_terminator_drive_latency_model_t *model_p)
+{
+    return terminator_simulated_disk_latency_set_model(drive_type, model_p);
+}
+
 fbe_status_t terminator_sas_drive_set_default_field(fbe_sas_drive_type_t drive_type, fbe_terminator_drive_default_field_t field, fbe_u8_t *data, fbe_u32_t size)
 {
     return sas_drive_set_default_field(drive_type, field, data, size);
@@ -567,6 +567,10 @@ fbe_status_t drive_free(terminator_drive_t * drive)
     fbe_u32_t       drive_array_index;
     fbe_bool_t   b_drive_found = FBE_FALSE;
 
+    /* Complete any I/O still held back by the latency model
+     */
+    terminator_simulated_disk_latency_drive_flush(drive);
+
     /* Destroy the journal
      */
     status = drive_journal_destroy(drive);
@@ -308,6 +308,24 @@ fbe_status_t fbe_terminator_api_drive_set_default_page_info(fbe_sas_drive_type_t
     return terminator_sas_drive_set_default_page_info(drive_type, default_info_p);
 }
 
+fbe_status_t fbe_terminator_api_drive_get_latency_model(fbe_sas_drive_type_t drive_type, fbe_terminator_drive_latency_model_t *model_p)
+{
+    terminator_trace(FBE_TRACE_LEVEL_DEBUG_HIGH, 
+                     FBE_TRACE_MESSAGE_ID_FUNCTION_ENTRY,
+                     "%s entry\n", __FUNCTION__);
+
+    return terminator_sas_drive_get_latency_model(drive_type, model_p);
+}
+
+fbe_status_t fbe_terminator_api_drive_set_latency_model(fbe_sas_drive_type_t drive_type, const fbe_terminator_drive_latency_model_t *model_p)
+{
+    terminator_trace(FBE_TRACE_LEVEL_DEBUG_HIGH, 
+                     FBE_TRACE_MESSAGE_ID_FUNCTION_ENTRY,
+                     "%s entry\n", __FUNCTION__);
+
+    return terminator_sas_drive_set_latency_model(drive_type, model_p);
+}
+
 fbe_status_t fbe_terminator_api_sas_drive_set_default_field(fbe_sas_drive_type_t drive_type, fbe_terminator_drive_default_field_t field, fbe_u8_t *data, fbe_u32_t size)
 {
     terminator_trace(FBE_TRACE_LEVEL_DEBUG_HIGH, 
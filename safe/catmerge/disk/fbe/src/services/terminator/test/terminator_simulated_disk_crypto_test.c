@@ -0,0 +1,198 @@
+/*!**************************************************************************
+ * @file terminator_simulated_disk_crypto_test.c
+ ****************************************************************************
+ *
+ * @brief
+ *  This file contains a test of the simulated disk encryption transform.
+ *  It checks the transform against the original byte at a time loop, also
+ *  over the timed passes, and reports how fast each one runs.
+ *
+ ***************************************************************************/
+
+/**********************************/
+/*        include files           */
+/**********************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "terminator_test.h"
+#include "fbe/fbe_time.h"
+#include "fbe/fbe_sector.h"
+#include "fbe/fbe_encryption.h"
+#include "terminator_drive.h"
+#include "terminator_simulated_disk.h"
+
+/**********************************/
+/*        local definitions       */
+/**********************************/
+
+/* Blocks we transform per pass, 1 MB of 520 byte blocks. */
+#define TERMINATOR_CRYPTO_TEST_BLOCKS 2016
+
+/* Passes we time for each transform. */
+#define TERMINATOR_CRYPTO_TEST_PASSES 200
+
+/*!**************************************************************
+ * terminator_crypto_test_process_bytes()
+ ****************************************************************
+ * @brief
+ *  The original byte at a time transform, kept here as the reference.
+ *
+ * @param data_buffer - Blocks to transform in place.
+ * @param buffer_size - Bytes in the buffer.
+ * @param dek - Key to xor the data with.
+ * @param dek_size - Bytes in the key.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void terminator_crypto_test_process_bytes(fbe_u8_t *data_buffer,
+                                                 fbe_u32_t buffer_size,
+                                                 fbe_u8_t *dek,
+                                                 fbe_u32_t dek_size)
+{
+    fbe_u32_t block_counter;
+    fbe_u32_t data_counter;
+    fbe_u32_t metadata_counter;
+
+    for (block_counter = 0; block_counter < buffer_size; block_counter += FBE_BE_BYTES_PER_BLOCK)
+    {
+        for (data_counter = 0; data_counter < dek_size; data_counter++)
+        {
+            data_buffer[data_counter] ^= dek[data_counter];
+        }
+        for (metadata_counter = FBE_BYTES_PER_BLOCK; metadata_counter < FBE_BE_BYTES_PER_BLOCK; metadata_counter++)
+        {
+            data_buffer[metadata_counter] = ~data_buffer[metadata_counter];
+        }
+        data_buffer += FBE_BE_BYTES_PER_BLOCK;
+    }
+    return;
+}
+
+/*!**************************************************************
+ * terminator_crypto_test_report_rate()
+ ****************************************************************
+ * @brief
+ *  Report the MB/s a number of passes over the buffer took.
+ *
+ * @param name - What we timed.
+ * @param buffer_size - Bytes in each pass.
+ * @param elapsed_msec - Time all the passes took.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void terminator_crypto_test_report_rate(const char *name,
+                                               fbe_u32_t buffer_size,
+                                               fbe_u32_t elapsed_msec)
+{
+    fbe_u64_t bytes = (fbe_u64_t)buffer_size * TERMINATOR_CRYPTO_TEST_PASSES;
+
+    if (elapsed_msec == 0)
+    {
+        elapsed_msec = 1;
+    }
+    mut_printf(MUT_LOG_TEST_STATUS, "   %s: %d msec %lld MB/s",
+               name, elapsed_msec, (long long)((bytes / elapsed_msec) * 1000 / (1024 * 1024)));
+    return;
+}
+
+/*!**************************************************************
+ * terminator_simulated_disk_crypto_test()
+ ****************************************************************
+ * @brief
+ *  Make sure the simulated disk transform gives the same bytes as the
+ *  original byte loop, for aligned, unaligned and partial buffers, and
+ *  report the MB/s on one core of both.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void terminator_simulated_disk_crypto_test(void)
+{
+    fbe_u32_t   buffer_size = TERMINATOR_CRYPTO_TEST_BLOCKS * FBE_BE_BYTES_PER_BLOCK;
+    fbe_u8_t    key[FBE_ENCRYPTION_KEY_SIZE + 1];
+    fbe_u8_t   *expected_p;
+    fbe_u8_t   *actual_p;
+    fbe_u32_t   index;
+    fbe_u32_t   offset;
+    fbe_u32_t   pass;
+    fbe_time_t  start_time;
+
+    /* Leave room for an unaligned start and a partial block at the end.
+     */
+    expected_p = (fbe_u8_t *)malloc(buffer_size + 2 * FBE_BE_BYTES_PER_BLOCK);
+    actual_p = (fbe_u8_t *)malloc(buffer_size + 2 * FBE_BE_BYTES_PER_BLOCK);
+    MUT_ASSERT_NOT_NULL(expected_p);
+    MUT_ASSERT_NOT_NULL(actual_p);
+
+    for (index = 0; index < sizeof(key); index++)
+    {
+        key[index] = (fbe_u8_t)(index * 7 + 3);
+    }
+
+    /* Use an unaligned key and buffer start too, since the words must not change the result.
+     */
+    for (offset = 0; offset < sizeof(fbe_u64_t); offset++)
+    {
+        for (index = 0; index < buffer_size + 2 * FBE_BE_BYTES_PER_BLOCK; index++)
+        {
+            expected_p[index] = actual_p[index] = (fbe_u8_t)(index * 13 + offset);
+        }
+        terminator_crypto_test_process_bytes(expected_p + offset, buffer_size + 100, key + (offset & 1), FBE_ENCRYPTION_KEY_SIZE);
+        terminator_simulated_disk_encrypt_data(actual_p + offset, buffer_size + 100, key + (offset & 1), FBE_ENCRYPTION_KEY_SIZE);
+        MUT_ASSERT_INT_EQUAL(0, memcmp(expected_p, actual_p, buffer_size + 2 * FBE_BE_BYTES_PER_BLOCK));
+
+        /* Decrypt gets us back the original data.
+         */
+        terminator_simulated_disk_decrypt_data(actual_p + offset, buffer_size + 100, key + (offset & 1), FBE_ENCRYPTION_KEY_SIZE);
+        for (index = 0; index < buffer_size + 2 * FBE_BE_BYTES_PER_BLOCK; index++)
+        {
+            MUT_ASSERT_INT_EQUAL((fbe_u8_t)(index * 13 + offset), actual_p[index]);
+        }
+    }
+
+    /* Both timed runs start from the same data.
+     */
+    for (index = 0; index < buffer_size; index++)
+    {
+        expected_p[index] = actual_p[index] = (fbe_u8_t)(index * 13);
+    }
+
+    mut_printf(MUT_LOG_TEST_STATUS, "== %s %d passes of %d bytes ==", __FUNCTION__, TERMINATOR_CRYPTO_TEST_PASSES, buffer_size);
+    start_time = fbe_get_time();
+    for (pass = 0; pass < TERMINATOR_CRYPTO_TEST_PASSES; pass++)
+    {
+        terminator_crypto_test_process_bytes(expected_p, buffer_size, key, FBE_ENCRYPTION_KEY_SIZE);
+    }
+    terminator_crypto_test_report_rate("byte loop", buffer_size, fbe_get_elapsed_milliseconds(start_time));
+
+    start_time = fbe_get_time();
+    for (pass = 0; pass < TERMINATOR_CRYPTO_TEST_PASSES; pass++)
+    {
+        terminator_simulated_disk_encrypt_data(actual_p, buffer_size, key, FBE_ENCRYPTION_KEY_SIZE);
+    }
+    terminator_crypto_test_report_rate("simulated disk", buffer_size, fbe_get_elapsed_milliseconds(start_time));
+
+    /* Both transforms made the same bytes on every pass, and an even number of
+     * passes undoes itself.
+     */
+    MUT_ASSERT_INT_EQUAL(0, memcmp(expected_p, actual_p, buffer_size));
+    if ((TERMINATOR_CRYPTO_TEST_PASSES % 2) == 0)
+    {
+        for (index = 0; index < buffer_size; index++)
+        {
+            MUT_ASSERT_INT_EQUAL((fbe_u8_t)(index * 13), actual_p[index]);
+        }
+    }
+
+    free(expected_p);
+    free(actual_p);
+    return;
+}
+/******************************************
+ * end terminator_simulated_disk_crypto_test()
+ ******************************************/
@@ -23,6 +23,7 @@ void terminator_insert_remove(void);
 void terminator_pull_reinsert_drive(void);
 void terminator_pull_reinsert_enclosure(void);
 void terminator_enclosure_firmware_download_activate_test(void);
+void terminator_simulated_disk_crypto_test(void);
 
 /* terminator base test suite */
 void baseComponentTest_init(void);
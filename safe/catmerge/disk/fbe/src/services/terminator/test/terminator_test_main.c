@@ -46,6 +46,7 @@ int __cdecl main (int argc , char *argv[])
     MUT_ADD_TEST(terminator_suite, terminator_pull_reinsert_drive,                       NULL, NULL)
     MUT_ADD_TEST(terminator_suite, terminator_pull_reinsert_enclosure,                   NULL, NULL)
     MUT_ADD_TEST(terminator_suite, terminator_enclosure_firmware_download_activate_test, NULL, NULL)
+    MUT_ADD_TEST(terminator_suite, terminator_simulated_disk_crypto_test,                NULL, NULL)
 
     /* base component test suite */
     baseComponentTestSuite = MUT_CREATE_TESTSUITE("baseComponentTestSuite")
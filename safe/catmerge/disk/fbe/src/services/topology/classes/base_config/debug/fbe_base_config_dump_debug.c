@@ -492,6 +492,7 @@ fbe_debug_field_info_t fbe_metadata_element_dump_field_info[] =
     FBE_DEBUG_DECLARE_FIELD_INFO("local_collision_count", fbe_u64_t, FBE_FALSE, "0x%x"),
     FBE_DEBUG_DECLARE_FIELD_INFO("peer_collision_count", fbe_u64_t, FBE_FALSE, "0x%x"),
     FBE_DEBUG_DECLARE_FIELD_INFO("cmi_message_count", fbe_u64_t, FBE_FALSE, "0x%x"),
+    FBE_DEBUG_DECLARE_FIELD_INFO("nonpaged_write_count", fbe_u64_t, FBE_FALSE, "0x%x"),
     FBE_DEBUG_DECLARE_FIELD_INFO("attributes", fbe_u32_t, FBE_FALSE, "0x%x"),
 
     FBE_DEBUG_DECLARE_FIELD_INFO_FN("nonpaged_record", fbe_metadata_record_t, FBE_FALSE, "0x%x", 
@@ -1712,6 +1712,7 @@ fbe_status_t fbe_base_config_metadata_get_statistics(fbe_base_config_t * base_co
     metadata_statistics->local_collision_count = base_config->metadata_element.local_collision_count;
     metadata_statistics->peer_collision_count = base_config->metadata_element.peer_collision_count;
     metadata_statistics->cmi_message_count = base_config->metadata_element.cmi_message_count;
+    metadata_statistics->nonpaged_write_count = base_config->metadata_element.nonpaged_write_count;
     fbe_spinlock_unlock(&base_config->metadata_element.metadata_element_lock);
 
     fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_OK);
@@ -1893,6 +1894,80 @@ fbe_base_config_metadata_nonpaged_incr_checkpoint_no_peer(fbe_base_config_t * ba
     return status;
 }
 
+/*!****************************************************************************
+ * fbe_base_config_checkpoint_is_peer_update_due()
+ ******************************************************************************
+ * @brief
+ *  Some background operations send every checkpoint increment to the peer.
+ *  Those operations only send it once the checkpoint has moved far enough
+ *  since the last peer update, which bounds how much work the peer redoes if
+ *  it takes over.  Each operation keeps its own count of blocks so that one
+ *  operation never triggers or holds off the peer update of another.
+ *
+ * @param blocks_since_peer_update - Blocks the checkpoint will have moved
+ *                                   since the operation last updated the peer.
+ *
+ * @return fbe_bool_t - FBE_TRUE if the peer should be updated now.
+ *
+ ******************************************************************************/
+fbe_bool_t fbe_base_config_checkpoint_is_peer_update_due(fbe_block_count_t blocks_since_peer_update)
+{
+    if (blocks_since_peer_update >= FBE_BASE_CONFIG_PEER_CHECKPOINT_UPDATE_BLOCKS)
+    {
+        return FBE_TRUE;
+    }
+    return FBE_FALSE;
+}
+/******************************************************************************
+ * end fbe_base_config_checkpoint_is_peer_update_due()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * fbe_base_config_metadata_nonpaged_batch_checkpoint()
+ ******************************************************************************
+ * @brief
+ *  Move a background operation checkpoint forward by repeat_count blocks.
+ *  When the peer is due an update we set the checkpoint on both SPs.  A set
+ *  is needed since the peer might be out of date with us and an increment
+ *  will not suffice.  Otherwise we only increment the checkpoint locally.
+ *
+ * @param base_config - Object to change the checkpoint of.
+ * @param packet - Packet to use for the metadata operation.
+ * @param b_update_peer - FBE_TRUE to also send the checkpoint to the peer.
+ * @param metadata_offset - Offset of the checkpoint in the nonpaged.
+ * @param second_metadata_offset - Offset of a second checkpoint or 0.
+ * @param checkpoint - Current checkpoint.
+ * @param repeat_count - Blocks to move the checkpoint by.
+ *
+ * @return fbe_status_t
+ *
+ ******************************************************************************/
+fbe_status_t
+fbe_base_config_metadata_nonpaged_batch_checkpoint(fbe_base_config_t * base_config,
+                                                   fbe_packet_t * packet,
+                                                   fbe_bool_t  b_update_peer,
+                                                   fbe_u64_t   metadata_offset,
+                                                   fbe_u64_t   second_metadata_offset,
+                                                   fbe_u64_t   checkpoint,
+                                                   fbe_u64_t   repeat_count)
+{
+    if (b_update_peer)
+    {
+        return fbe_base_config_metadata_nonpaged_force_set_checkpoint(base_config, packet,
+                                                                      metadata_offset,
+                                                                      second_metadata_offset,
+                                                                      checkpoint + repeat_count);
+    }
+    return fbe_base_config_metadata_nonpaged_incr_checkpoint_no_peer(base_config, packet,
+                                                                     metadata_offset,
+                                                                     second_metadata_offset,
+                                                                     checkpoint,
+                                                                     repeat_count);
+}
+/******************************************************************************
+ * end fbe_base_config_metadata_nonpaged_batch_checkpoint()
+ ******************************************************************************/
+
 static fbe_status_t 
 base_config_metadata_nonpaged_incr_checkpoint_completion(fbe_packet_t * packet, fbe_packet_completion_context_t context)
 {
@@ -41,7 +41,8 @@
  enum fbe_base_config_constants_e {
     FBE_BASE_CONFIG_WIDTH_INVALID  = 0,
     FBE_BASE_CONFIG_DEFAULT_IDLE_TIME_IN_SECONDS  = 120,
-    FBE_BASE_CONFIG_HIBERNATION_WAKE_UP_DEFAULT = 1440 /*wake up every 24 hours (1440 seconds) to sniff*/
+    FBE_BASE_CONFIG_HIBERNATION_WAKE_UP_DEFAULT = 1440, /*wake up every 24 hours (1440 seconds) to sniff*/
+    FBE_BASE_CONFIG_PEER_CHECKPOINT_UPDATE_BLOCKS = 0x200000 /* Blocks (about 1 GB) a checkpoint may move before the peer is updated. */
 };
 
 /* Lifecycle definitions
@@ -831,6 +832,16 @@ fbe_base_config_metadata_nonpaged_incr_checkpoint_no_peer(fbe_base_config_t * ba
                                                           fbe_u64_t   checkpoint,
                                                           fbe_u64_t   repeat_count);
 
+fbe_bool_t fbe_base_config_checkpoint_is_peer_update_due(fbe_block_count_t blocks_since_peer_update);
+fbe_status_t
+fbe_base_config_metadata_nonpaged_batch_checkpoint(fbe_base_config_t * base_config,
+                                                   fbe_packet_t * packet,
+                                                   fbe_bool_t  b_update_peer,
+                                                   fbe_u64_t   metadata_offset,
+                                                   fbe_u64_t   second_metadata_offset,
+                                                   fbe_u64_t   checkpoint,
+                                                   fbe_u64_t   repeat_count);
+
 fbe_status_t fbe_base_config_metadata_get_statistics(fbe_base_config_t * base_config, fbe_packet_t * packet_p);
 
 fbe_status_t fbe_base_config_metadata_memory_read(fbe_base_config_t *base_config,
@@ -572,6 +572,9 @@ char * fbe_base_enclosure_getControlCodeString(fbe_u32_t controlCode)
         case FBE_BASE_ENCLOSURE_CONTROL_CODE_GET_SSC_INFO:
             controlCodeString = "GetSSCInfo";
             break;
+        case FBE_BASE_ENCLOSURE_CONTROL_CODE_STATUS_PAGE_STATS:
+            controlCodeString = "StatusPageStats";
+            break;
         default:
             controlCodeString = "UnknownEnclosureControlCode";
             break;
@@ -30,6 +30,7 @@
 
 #include "base_physical_drive_private.h"
 #include "swap_exports.h"
+#include "fbe_traffic_trace.h"
 
 
 static void fbe_base_drive_trace_queue_lengths(fbe_base_physical_drive_t *base_physical_drive, fbe_packet_t * packet);
@@ -49,6 +50,7 @@ void fbe_trace_RBA_traffic(fbe_base_physical_drive_t* base_physical_drive, fbe_l
 {
     fbe_u64_t number_of_blocks = 0;
     fbe_u64_t io_parameters = 0;
+    fbe_object_id_t object_id;
     
     number_of_blocks = (fbe_u64_t) block_count;
     /* io_traffic_info already contains the type of traffic so now
@@ -63,6 +65,15 @@ void fbe_trace_RBA_traffic(fbe_base_physical_drive_t* base_physical_drive, fbe_l
     io_parameters <<= 16;
     io_parameters |= (io_traffic_info & 0xFFFF);
 
+    /* A filter of the pd class may drop the record or save it in binary.
+     */
+    fbe_base_object_get_object_id((fbe_base_object_t *)base_physical_drive, &object_id);
+    if (!fbe_traffic_trace_filter_record(FBE_TRAFFIC_TRACE_CLASS_PD, object_id, lba, block_count,
+                                         (fbe_u16_t)io_traffic_info, io_parameters))
+    {
+        return;
+    }
+
 #if defined(UMODE_ENV) || defined(SIMMODE_ENV)
     /* In user mode, this trace is displayed on console window.*/
     fbe_KvTrace("PDO: lba high: 0x%llx lba low: 0x%llx bl: 0x%llx obj/opcode: 0x%llx\n",
@@ -50,6 +50,7 @@ static fbe_status_t bvd_interface_get_lun_attributes(fbe_packet_t * packet_p, os
 static fbe_status_t fbe_bvd_interface_usurper_clear_performace_statistics(fbe_bvd_interface_t* bvd_object_p, fbe_packet_t* packet_p);
 static fbe_status_t fbe_bvd_interface_usurper_set_rq_method(fbe_bvd_interface_t* bvd_object_p, fbe_packet_t* packet_p);
 static fbe_status_t fbe_bvd_interface_usurper_set_alert_time(fbe_bvd_interface_t* bvd_object_p, fbe_packet_t* packet_p);
+static fbe_status_t fbe_bvd_interface_usurper_set_run_queue_batch_mode(fbe_bvd_interface_t* bvd_object_p, fbe_packet_t* packet_p);
 static fbe_status_t fbe_bvd_interface_usurper_shutdown(fbe_bvd_interface_t* bvd_object_p, fbe_packet_t* packet_p);
 void fbe_bvd_interface_usurper_enable_pp_group_priority(void);
 void fbe_bvd_interface_usurper_disable_pp_group_priority(void);
@@ -144,6 +145,10 @@ fbe_status_t fbe_bvd_interface_control_entry(fbe_object_handle_t object_handle,
         status = fbe_bvd_interface_usurper_set_alert_time(bvd_object_p, packet_p);
         break;
 
+    case FBE_BVD_INTERFACE_CONTROL_CODE_SET_RUN_QUEUE_BATCH_MODE:
+        status = fbe_bvd_interface_usurper_set_run_queue_batch_mode(bvd_object_p, packet_p);
+        break;
+
 	case FBE_BVD_INTERFACE_CONTROL_CODE_ENABLE_GROUP_PRIORITY:
 		fbe_base_object_trace(  (fbe_base_object_t *)bvd_object_p,
 								FBE_TRACE_LEVEL_INFO,
@@ -1077,6 +1082,72 @@ static fbe_status_t fbe_bvd_interface_usurper_set_alert_time(fbe_bvd_interface_t
     return status;
 }
 
+/*!**************************************************************
+ * fbe_bvd_interface_usurper_set_run_queue_batch_mode()
+ ****************************************************************
+ * @brief
+ *  Switch the transport run queues between fixed and adaptive batching.
+ *  
+ * @param bvd_object_p    - BVD object.
+ * @param packet_p - The packet requesting this operation.
+ *
+ * @return status - The status of the operation.
+ *
+ ****************************************************************/
+static fbe_status_t fbe_bvd_interface_usurper_set_run_queue_batch_mode(fbe_bvd_interface_t* bvd_object_p,
+                                                        fbe_packet_t* packet_p)
+{
+    fbe_transport_run_queue_set_batch_mode_t*   req_buffer_p = NULL;
+    fbe_status_t                                status              = FBE_STATUS_OK;
+    fbe_payload_ex_t*                           payload_p           = NULL;
+    fbe_payload_control_operation_t*            control_operation_p = NULL;  
+    fbe_payload_control_buffer_length_t         length              = 0;
+    
+    fbe_base_object_trace(  (fbe_base_object_t *)bvd_object_p,
+                            FBE_TRACE_LEVEL_DEBUG_HIGH,
+                            FBE_TRACE_MESSAGE_ID_FUNCTION_ENTRY,
+                            "%s entry\n", __FUNCTION__);
+
+    /* Get the payload from the incoming packet */
+    payload_p = fbe_transport_get_payload_ex(packet_p);
+    control_operation_p = fbe_payload_ex_get_control_operation(payload_p);  
+
+    fbe_payload_control_get_buffer(control_operation_p, &req_buffer_p);
+    if (req_buffer_p == NULL){
+        fbe_base_object_trace(  (fbe_base_object_t *)bvd_object_p,
+                                FBE_TRACE_LEVEL_ERROR,
+                                FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                                "%s fbe_payload_control_get_buffer failed\n", __FUNCTION__);
+
+        fbe_payload_control_set_status(control_operation_p, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
+        fbe_transport_set_status(packet_p, FBE_STATUS_GENERIC_FAILURE, 0);
+        fbe_transport_complete_packet(packet_p);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    fbe_payload_control_get_buffer_length(control_operation_p, &length);
+    if (length != sizeof(fbe_transport_run_queue_set_batch_mode_t)){
+        fbe_base_object_trace(  (fbe_base_object_t *)bvd_object_p,
+                                FBE_TRACE_LEVEL_ERROR,
+                                FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                                "%s buffer length don't match with fbe_transport_run_queue_set_batch_mode_t\n", __FUNCTION__);
+
+        fbe_payload_control_set_status(control_operation_p, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
+        fbe_transport_set_status(packet_p, FBE_STATUS_GENERIC_FAILURE, 0);
+        fbe_transport_complete_packet(packet_p);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    status = fbe_transport_run_queue_set_batch_mode(req_buffer_p->batch_mode);
+    if (status != FBE_STATUS_OK){
+        fbe_payload_control_set_status(control_operation_p, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
+    }
+
+    fbe_transport_set_status(packet_p, status, 0);
+    status = fbe_transport_complete_packet(packet_p);
+    return status;
+}
+
 void fbe_bvd_interface_usurper_enable_pp_group_priority(void)
 {    
     fbe_status_t                                            status;
@@ -2660,6 +2660,9 @@ fbe_eses_enclosure_setup_send_diag_cmd(fbe_eses_enclosure_t * eses_enclosure,
                                                          &sg_count);             
 
             eses_enclosure->outstanding_write ++;
+
+            /* Drive and phy requests change how the following status pages are decoded. */
+            fbe_eses_enclosure_invalidate_status_page_cache(eses_enclosure);
             
             //fbe_eses_printSendControlPage(eses_enclosure, (fbe_u8_t *)sg_list->address);
 
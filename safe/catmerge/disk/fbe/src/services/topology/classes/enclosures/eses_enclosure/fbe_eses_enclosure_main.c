@@ -92,6 +92,7 @@ fbe_eses_enclosure_init(fbe_eses_enclosure_t *eses_enclosure)
     eses_enclosure->reset_reason = 0;
     eses_enclosure->poll_count = 0;
     eses_enclosure->reset_shutdown_timer = FALSE;
+    fbe_zero_memory(&eses_enclosure->status_page_cache, sizeof(fbe_eses_enclosure_status_page_cache_t));
     fbe_eses_enclosure_init_enclCurrentFupInfo(eses_enclosure);
     // initialize spin lock for enclosure Read/Status data
     fbe_spinlock_init(&eses_enclosure->enclGetInfoLock);
@@ -222,6 +223,8 @@ fbe_eses_enclosure_destroy_object( fbe_object_handle_t object_handle)
 
     fbe_spinlock_destroy(&eses_enclosure->enclGetInfoLock); /* SAFEBUG - needs destroy */
 
+    fbe_eses_enclosure_release_status_page_cache(eses_enclosure);
+
     /* no memory release is needed, as memory are allocated and destroyed from viper enclosure */
     if (eses_enclosure->enclCurrentFupInfo.enclFupImagePointer != NULL)
     {
@@ -123,6 +123,12 @@
 
 #define FBE_ESES_ENCLOSURE_MAX_POLL_COUNT_WRAP         60
 
+// Every this many status pages, all element groups are decoded even if
+// unchanged. The extract status handlers also read EDAL state the status
+// page does not carry (insert masking, power control requests), so a
+// skipped group never stays stale for long.
+#define FBE_ESES_ENCLOSURE_STATUS_PAGE_FULL_DECODE_FREQUENCY   10
+
 /* Increase to 12. Viking has 4 PS(each has one overall elements + two individual elements)*/
 #define FBE_ESES_ENCLOSURE_MAX_PS_INFO_COLLECTED       12
 
@@ -419,6 +425,27 @@ typedef struct fbe_eses_tunnel_fup_fsm_table_entry_s
     fbe_eses_tunnel_fup_state_t next_state;
 } fbe_eses_tunnel_fup_fsm_table_entry_t;
 
+/*!*******************************************************************
+ * @struct fbe_eses_enclosure_status_page_cache_t
+ *********************************************************************
+ * @brief The last status page processed. Element groups whose bytes
+ *        are the same in the next status page are not decoded again.
+ *********************************************************************/
+typedef struct fbe_eses_enclosure_status_page_cache_s
+{
+    fbe_u8_t  * page_p;             // copy of the last status page, allocated with the first one.
+    fbe_u16_t   page_length;        // 0 when the copy can not be compared against.
+    fbe_u32_t   generation_code;    // generation code of the copy.
+    fbe_u8_t    pages_since_full_decode;
+    fbe_bool_t  incremental_disabled;
+
+    fbe_u32_t   pages_processed;
+    fbe_u32_t   full_decodes;
+    fbe_u64_t   groups_decoded;
+    fbe_u64_t   groups_skipped;
+    fbe_u64_t   process_time_us;
+} fbe_eses_enclosure_status_page_cache_t;
+
 typedef struct fbe_eses_enclosure_s
 {
     fbe_sas_enclosure_t       sas_enclosure;
@@ -436,6 +463,7 @@ typedef struct fbe_eses_enclosure_s
     fbe_eses_enclosure_properties_t properties;
 
     fbe_eses_elem_group_t * elem_group;
+    fbe_eses_enclosure_status_page_cache_t status_page_cache;
 
     fbe_spinlock_t  enclGetInfoLock;            // spin lock to protect updating/copying of Status/Read data
 
@@ -646,6 +674,8 @@ fbe_enclosure_status_t fbe_eses_enclosure_process_addl_status_page(
 
 fbe_enclosure_status_t fbe_eses_enclosure_process_status_page(struct fbe_eses_enclosure_s * eses_enclosure, 
                                                          fbe_u8_t * status_page);
+void fbe_eses_enclosure_invalidate_status_page_cache(fbe_eses_enclosure_t * eses_enclosure);
+void fbe_eses_enclosure_release_status_page_cache(fbe_eses_enclosure_t * eses_enclosure);
 
 fbe_enclosure_status_t fbe_eses_enclosure_process_emc_specific_page(
                                                     fbe_eses_enclosure_t * eses_enclosure, 
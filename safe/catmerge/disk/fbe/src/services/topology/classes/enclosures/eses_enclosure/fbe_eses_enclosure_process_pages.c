@@ -25,6 +25,7 @@
 #include "edal_eses_enclosure_data.h"
 #include "fbe_enclosure_data_access_private.h"
 #include "fbe_sas_enclosure_debug.h"
+#include "fbe/fbe_time.h"
 
 /**************************
  * GLOBALS 
@@ -170,6 +171,14 @@ fbe_eses_enclosure_convert_subencl_prod_rev_level_to_fw_rev(fbe_eses_enclosure_t
                                                             ses_subencl_desc_struct *subencl_desc_p,
                                                             fbe_u8_t *pFirmwareRev);
 
+static void fbe_eses_enclosure_alloc_status_page_cache(fbe_eses_enclosure_t * eses_enclosure);
+static fbe_bool_t fbe_eses_enclosure_status_page_cache_usable(fbe_eses_enclosure_t * eses_enclosure,
+                                                              fbe_u8_t * status_page);
+static fbe_bool_t fbe_eses_enclosure_status_group_unchanged(fbe_eses_enclosure_t * eses_enclosure,
+                                                            fbe_u8_t * status_page,
+                                                            fbe_u8_t group_id);
+static fbe_bool_t fbe_eses_enclosure_status_group_coupled_changed(fbe_eses_enclosure_t * eses_enclosure,
+                                                                  fbe_u8_t * status_page);
 static fbe_status_t fbe_eses_enclosure_get_adjusted_lcc_slot(fbe_eses_enclosure_t * eses_enclosure,
                                                       fbe_u8_t *pSubenclProductId,
                                                       fbe_u8_t originalLccSlot,
@@ -223,6 +232,9 @@ fbe_enclosure_status_t fbe_eses_enclosure_process_configuration_page(fbe_eses_en
                             
     }
 
+    // The element groups of the status page are about to change.
+    fbe_eses_enclosure_invalidate_status_page_cache(eses_enclosure);
+
     // Initialize the configuration and mapping related info.
     if((encl_status = fbe_eses_enclosure_init_config_info(eses_enclosure)) != FBE_ENCLOSURE_STATUS_OK)
     {   
@@ -278,6 +290,11 @@ fbe_enclosure_status_t fbe_eses_enclosure_process_configuration_page(fbe_eses_en
                          "process_configuration_page, parse_type_descs failed, encl_status: 0x%x.\n", 
                          encl_status);
     }
+    else
+    {
+        // The status page is processed under the enclGetInfoLock, allocate its copy here.
+        fbe_eses_enclosure_alloc_status_page_cache(eses_enclosure);
+    }
 
     return encl_status;
 
@@ -2378,6 +2395,9 @@ static fbe_u8_t fbe_eses_enclosure_is_new_connector(fbe_eses_enclosure_t * eses_
 *       This function loops through all the groups to call the extract status
 *       method of each group to process the enclosure status read from 
 *       the status page. 
+*       The drive slot and expander phy groups make up most of the page.
+*       When they are byte for byte the same as in the previous status page
+*       they are not decoded again, see fbe_eses_enclosure_status_page_cache_t.
 *
 * @param   eses_enclosure - The pointer to the enclosure.
 *          status_page - The pointer to the status page.
@@ -2387,6 +2407,7 @@ static fbe_u8_t fbe_eses_enclosure_is_new_connector(fbe_eses_enclosure_t * eses_
 *       otherwise - error is found. 
 *
 * NOTES
+*       The caller holds the enclGetInfoLock.
 *
 * HISTORY
 *   27-Jul-2008 PHE - Created.
@@ -2402,6 +2423,10 @@ fbe_enclosure_status_t fbe_eses_enclosure_process_status_page(fbe_eses_enclosure
     const fbe_eses_enclosure_comp_type_hdlr_t * handler;
     fbe_enclosure_component_types_t component_type;
     fbe_eses_elem_group_t * elem_group = NULL;
+    fbe_eses_enclosure_status_page_cache_t * cache_p = &eses_enclosure->status_page_cache;
+    fbe_bool_t b_use_cache = FALSE;
+    fbe_bool_t b_coupled_changed = TRUE;
+    fbe_time_t start_time;
 
     fbe_enclosure_status_t encl_status = FBE_ENCLOSURE_STATUS_OK;
 
@@ -2415,6 +2440,8 @@ fbe_enclosure_status_t fbe_eses_enclosure_process_status_page(fbe_eses_enclosure
                      FBE_TRACE_LEVEL_DEBUG_HIGH,
                      fbe_base_enclosure_get_logheader((fbe_base_enclosure_t*)eses_enclosure),
                      "%s entry \n", __FUNCTION__ );
+
+    start_time = fbe_get_time_in_us();
    
     // get the page length
     eses_enclosure->eses_status_control_page_length = 
@@ -2425,6 +2452,12 @@ fbe_enclosure_status_t fbe_eses_enclosure_process_status_page(fbe_eses_enclosure
      */
 
     elem_group = fbe_eses_enclosure_get_elem_group_ptr(eses_enclosure); 
+
+    b_use_cache = fbe_eses_enclosure_status_page_cache_usable(eses_enclosure, status_page);
+    if(b_use_cache)
+    {
+        b_coupled_changed = fbe_eses_enclosure_status_group_coupled_changed(eses_enclosure, status_page);
+    }
   
     for(group_id = 0; group_id < fbe_eses_enclosure_get_number_of_actual_elem_groups(eses_enclosure); group_id ++ )
     {  
@@ -2432,6 +2465,7 @@ fbe_enclosure_status_t fbe_eses_enclosure_process_status_page(fbe_eses_enclosure
         
         if(group_byte_offset == 0)
         {  
+            cache_p->page_length = 0;
             return FBE_ENCLOSURE_STATUS_CONFIG_INVALID; 
         }
             
@@ -2440,6 +2474,7 @@ fbe_enclosure_status_t fbe_eses_enclosure_process_status_page(fbe_eses_enclosure
         // Check whether the element type is valid or not. 
         if(elem_type == SES_ELEM_TYPE_INVALID)
         {
+            cache_p->page_length = 0;
             return FBE_ENCLOSURE_STATUS_CONFIG_INVALID;
         }
 
@@ -2448,6 +2483,7 @@ fbe_enclosure_status_t fbe_eses_enclosure_process_status_page(fbe_eses_enclosure
     
         if(elem_byte_offset > eses_enclosure->eses_status_control_page_length)
         {
+            cache_p->page_length = 0;
             return FBE_ENCLOSURE_STATUS_CONFIG_INVALID;
         } 
  
@@ -2459,9 +2495,23 @@ fbe_enclosure_status_t fbe_eses_enclosure_process_status_page(fbe_eses_enclosure
         }
         else if(encl_status != FBE_ENCLOSURE_STATUS_OK)
         {
+            cache_p->page_length = 0;
             return encl_status;
         }
 
+        /* The drive slot status only depends on its own elements. The expander phy status
+         * also depends on the drive slots and connectors the phys are attached to.
+         * Every other group is cheap to decode and some debounce over time, always decode those.
+         */
+        if(b_use_cache &&
+           (((component_type == FBE_ENCL_DRIVE_SLOT) ||
+             ((component_type == FBE_ENCL_EXPANDER_PHY) && !b_coupled_changed)) &&
+            fbe_eses_enclosure_status_group_unchanged(eses_enclosure, status_page, group_id)))
+        {
+            cache_p->groups_skipped ++;
+            continue;
+        }
+
         handler = fbe_eses_enclosure_get_comp_type_hdlr(fbe_eses_enclosure_comp_type_hdlr_table, component_type);
             
         /* NULL pointer for handler shoud not be considered as a fault.
@@ -2470,6 +2520,7 @@ fbe_enclosure_status_t fbe_eses_enclosure_process_status_page(fbe_eses_enclosure
          */
         if((handler != NULL) && (handler->extract_status != NULL))
         {
+            cache_p->groups_decoded ++;
             encl_status = handler->extract_status(eses_enclosure, 
                                    group_id, 
                                   (fbe_eses_ctrl_stat_elem_t *)(status_page + group_byte_offset));
@@ -2477,16 +2528,223 @@ fbe_enclosure_status_t fbe_eses_enclosure_process_status_page(fbe_eses_enclosure
              if(!ENCL_STAT_OK(encl_status) &&
                (encl_status != FBE_ENCLOSURE_STATUS_EDAL_NOT_NEEDED))
             {
+                // Part of the page was not decoded, the next page has to be decoded completely.
+                cache_p->page_length = 0;
                 return encl_status;
             }
         }
       
     } // End of the loop.
+
+    // Keep this page to compare the next one against.
+    if((cache_p->page_p != NULL) &&
+       (eses_enclosure->eses_status_control_page_length <= FBE_ESES_ENCLOSURE_ESES_PAGE_RESPONSE_BUFFER_SIZE))
+    {
+        fbe_copy_memory(cache_p->page_p, status_page, eses_enclosure->eses_status_control_page_length);
+        cache_p->page_length = eses_enclosure->eses_status_control_page_length;
+        cache_p->generation_code = fbe_eses_get_pg_gen_code((ses_common_pg_hdr_struct *)status_page);
+    }
+    if(b_use_cache)
+    {
+        cache_p->pages_since_full_decode ++;
+    }
+    else
+    {
+        cache_p->pages_since_full_decode = 0;
+        cache_p->full_decodes ++;
+    }
+    cache_p->pages_processed ++;
+    cache_p->process_time_us += fbe_get_elapsed_microseconds(start_time);
         
     return FBE_ENCLOSURE_STATUS_OK;
 
 }// End of function fbe_eses_enclosure_process_status_page
 
+/*!*************************************************************************
+* @fn fbe_eses_enclosure_status_page_cache_usable(
+*                     fbe_eses_enclosure_t * eses_enclosure, 
+*                     fbe_u8_t * status_page)              
+***************************************************************************
+* @brief
+*   Decide whether the new status page can be compared against the copy
+*   of the previous one.
+*
+* @param   eses_enclosure - The pointer to the enclosure.
+* @param   status_page - The pointer to the new status page.
+*
+* @return  fbe_bool_t - TRUE if unchanged element groups may be skipped.
+*
+* NOTES
+*   Every FBE_ESES_ENCLOSURE_STATUS_PAGE_FULL_DECODE_FREQUENCY pages
+*   the whole page is decoded anyway.
+***************************************************************************/
+static fbe_bool_t fbe_eses_enclosure_status_page_cache_usable(fbe_eses_enclosure_t * eses_enclosure,
+                                                              fbe_u8_t * status_page)
+{
+    fbe_eses_enclosure_status_page_cache_t * cache_p = &eses_enclosure->status_page_cache;
+
+    if((cache_p->page_p == NULL) ||
+       cache_p->incremental_disabled ||
+       (cache_p->page_length == 0) ||
+       (cache_p->page_length != eses_enclosure->eses_status_control_page_length) ||
+       (cache_p->generation_code != fbe_eses_get_pg_gen_code((ses_common_pg_hdr_struct *)status_page)) ||
+       (cache_p->pages_since_full_decode >= (FBE_ESES_ENCLOSURE_STATUS_PAGE_FULL_DECODE_FREQUENCY - 1)))
+    {
+        return FALSE;
+    }
+
+    return TRUE;
+}// End of function fbe_eses_enclosure_status_page_cache_usable
+
+/*!*************************************************************************
+* @fn fbe_eses_enclosure_status_group_unchanged(
+*                     fbe_eses_enclosure_t * eses_enclosure, 
+*                     fbe_u8_t * status_page,
+*                     fbe_u8_t group_id)              
+***************************************************************************
+* @brief
+*   Compare the overall and individual elements of a group with the
+*   previous status page.
+*
+* @param   eses_enclosure - The pointer to the enclosure.
+* @param   status_page - The pointer to the new status page.
+* @param   group_id - The element group id.
+*
+* @return  fbe_bool_t - TRUE if every byte of the group is the same.
+***************************************************************************/
+static fbe_bool_t fbe_eses_enclosure_status_group_unchanged(fbe_eses_enclosure_t * eses_enclosure,
+                                                            fbe_u8_t * status_page,
+                                                            fbe_u8_t group_id)
+{
+    fbe_eses_enclosure_status_page_cache_t * cache_p = &eses_enclosure->status_page_cache;
+    fbe_eses_elem_group_t * elem_group = fbe_eses_enclosure_get_elem_group_ptr(eses_enclosure);
+    fbe_u16_t group_byte_offset = fbe_eses_elem_group_get_group_byte_offset(elem_group, group_id);
+    fbe_u32_t group_length;
+
+    // The overall element plus the individual elements.
+    group_length = (fbe_eses_elem_group_get_num_possible_elems(elem_group, group_id) + 1) * FBE_ESES_CTRL_STAT_ELEM_SIZE;
+
+    if((group_byte_offset + group_length) > cache_p->page_length)
+    {
+        return FALSE;
+    }
+
+    return fbe_equal_memory(cache_p->page_p + group_byte_offset, status_page + group_byte_offset, group_length);
+}// End of function fbe_eses_enclosure_status_group_unchanged
+
+/*!*************************************************************************
+* @fn fbe_eses_enclosure_status_group_coupled_changed(
+*                     fbe_eses_enclosure_t * eses_enclosure, 
+*                     fbe_u8_t * status_page)              
+***************************************************************************
+* @brief
+*   The expander phy status is derived from the drive slots and connectors
+*   too. Check whether any of those groups changed.
+*
+* @param   eses_enclosure - The pointer to the enclosure.
+* @param   status_page - The pointer to the new status page.
+*
+* @return  fbe_bool_t - TRUE if a drive slot or connector group changed.
+***************************************************************************/
+static fbe_bool_t fbe_eses_enclosure_status_group_coupled_changed(fbe_eses_enclosure_t * eses_enclosure,
+                                                                  fbe_u8_t * status_page)
+{
+    fbe_u8_t group_id = 0;
+    fbe_enclosure_component_types_t component_type;
+
+    for(group_id = 0; group_id < fbe_eses_enclosure_get_number_of_actual_elem_groups(eses_enclosure); group_id ++ )
+    {
+        if(fbe_eses_enclosure_get_comp_type(eses_enclosure, group_id, &component_type) != FBE_ENCLOSURE_STATUS_OK)
+        {
+            continue;
+        }
+
+        if(((component_type == FBE_ENCL_DRIVE_SLOT) || (component_type == FBE_ENCL_CONNECTOR)) &&
+           !fbe_eses_enclosure_status_group_unchanged(eses_enclosure, status_page, group_id))
+        {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}// End of function fbe_eses_enclosure_status_group_coupled_changed
+
+/*!*************************************************************************
+* @fn fbe_eses_enclosure_alloc_status_page_cache(fbe_eses_enclosure_t * eses_enclosure)              
+***************************************************************************
+* @brief
+*   Allocate the copy of the status page once the configuration is known.
+*   Without it every status page is simply decoded completely.
+*
+* @param   eses_enclosure - The pointer to the enclosure.
+*
+* @return  None.
+***************************************************************************/
+static void fbe_eses_enclosure_alloc_status_page_cache(fbe_eses_enclosure_t * eses_enclosure)
+{
+    fbe_eses_enclosure_status_page_cache_t * cache_p = &eses_enclosure->status_page_cache;
+
+    if(cache_p->page_p != NULL)
+    {
+        return;
+    }
+
+    cache_p->page_p = fbe_memory_ex_allocate(FBE_ESES_ENCLOSURE_ESES_PAGE_RESPONSE_BUFFER_SIZE);
+    if(cache_p->page_p == NULL)
+    {
+        fbe_base_object_customizable_trace((fbe_base_object_t*)eses_enclosure,
+                FBE_TRACE_LEVEL_WARNING,
+                fbe_base_enclosure_get_logheader((fbe_base_enclosure_t*)eses_enclosure),
+                "%s, failed allocating status page copy, status pages are decoded completely.\n",
+                __FUNCTION__);
+    }
+    return;
+}// End of function fbe_eses_enclosure_alloc_status_page_cache
+
+/*!*************************************************************************
+* @fn fbe_eses_enclosure_invalidate_status_page_cache(fbe_eses_enclosure_t * eses_enclosure)              
+***************************************************************************
+* @brief
+*   Make the next status page be decoded completely. Called when
+*   something the status decode depends on, other than the status page
+*   itself, changed.
+*
+* @param   eses_enclosure - The pointer to the enclosure.
+*
+* @return  None.
+*
+* NOTES
+*   The caller must not hold the enclGetInfoLock.
+***************************************************************************/
+void fbe_eses_enclosure_invalidate_status_page_cache(fbe_eses_enclosure_t * eses_enclosure)
+{
+    fbe_spinlock_lock(&eses_enclosure->enclGetInfoLock);
+    eses_enclosure->status_page_cache.page_length = 0;
+    fbe_spinlock_unlock(&eses_enclosure->enclGetInfoLock);
+    return;
+}// End of function fbe_eses_enclosure_invalidate_status_page_cache
+
+/*!*************************************************************************
+* @fn fbe_eses_enclosure_release_status_page_cache(fbe_eses_enclosure_t * eses_enclosure)              
+***************************************************************************
+* @brief
+*   Release the copy of the status page.
+*
+* @param   eses_enclosure - The pointer to the enclosure.
+*
+* @return  None.
+***************************************************************************/
+void fbe_eses_enclosure_release_status_page_cache(fbe_eses_enclosure_t * eses_enclosure)
+{
+    if(eses_enclosure->status_page_cache.page_p != NULL)
+    {
+        fbe_memory_ex_release(eses_enclosure->status_page_cache.page_p);
+        eses_enclosure->status_page_cache.page_p = NULL;
+    }
+    eses_enclosure->status_page_cache.page_length = 0;
+    return;
+}// End of function fbe_eses_enclosure_release_status_page_cache
+
 /*!*************************************************************************
 * @fn fbe_eses_enclosure_get_comp_type_hdlr(const fbe_eses_enclosure_comp_type_hdlr_t  * hdlr_table[],
 *                                 fbe_enclosure_component_types_t component_type)                  
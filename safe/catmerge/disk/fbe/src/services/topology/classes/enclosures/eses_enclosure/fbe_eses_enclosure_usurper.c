@@ -232,6 +232,8 @@ static fbe_status_t fbe_eses_enclosure_get_ssc_count(fbe_eses_enclosure_t * eses
 
 static fbe_status_t fbe_eses_enclosure_get_ssc_info(fbe_eses_enclosure_t * eses_enclosure, fbe_packet_t * packet);
 
+static fbe_status_t fbe_eses_enclosure_status_page_stats(fbe_eses_enclosure_t * eses_enclosure, fbe_packet_t * packet);
+
 /* String used to save enclosure fault reason */
 static char enclFaultReasonString[500];
 static fbe_status_t 
@@ -425,6 +427,10 @@ fbe_eses_enclosure_control_entry(fbe_object_handle_t object_handle, fbe_packet_t
             status = fbe_eses_enclosure_get_ssc_info(eses_enclosure, packet);
             break;
 
+        case FBE_BASE_ENCLOSURE_CONTROL_CODE_STATUS_PAGE_STATS:
+            status = fbe_eses_enclosure_status_page_stats(eses_enclosure, packet);
+            break;
+
         default:
             status = fbe_sas_enclosure_control_entry(object_handle, packet);
             if (status != FBE_STATUS_OK)
@@ -776,6 +782,77 @@ fbe_eses_enclosure_get_ssc_count(fbe_eses_enclosure_t *esesEnclosurePtr,
     return (status);
 } //fbe_eses_enclosure_get_ssc_count
 
+/*!*************************************************************************
+ *  @fn fbe_eses_enclosure_status_page_stats(
+ *                   fbe_eses_enclosure_t *esesEnclosurePtr, 
+ *                   fbe_packet_t *packetPtr)
+ **************************************************************************
+ *
+ *  @brief
+ *  Return the status page processing statistics. Optionally turn the
+ *  incremental status page processing on or off and clear the statistics.
+ *
+ *  @param    esesEnclosurePtr - pointer to a Eses Enclosure object
+ *  @param    packetPtr - pointer to an FBE control code packet
+ *
+ *  @return    Status from the processing of this control code.
+ **************************************************************************/
+static fbe_status_t 
+fbe_eses_enclosure_status_page_stats(fbe_eses_enclosure_t *esesEnclosurePtr, 
+                                     fbe_packet_t *packetPtr)
+{
+    fbe_enclosure_mgmt_status_page_stats_t  *pStats = NULL;
+    fbe_eses_enclosure_status_page_cache_t  *pCache = &esesEnclosurePtr->status_page_cache;
+    fbe_status_t                            status;    
+    fbe_enclosure_status_t                  encl_stat = FBE_ENCLOSURE_STATUS_PACKET_FAILED;
+
+    fbe_base_object_customizable_trace((fbe_base_object_t*)esesEnclosurePtr,
+                         FBE_TRACE_LEVEL_DEBUG_HIGH,
+                         fbe_base_enclosure_get_logheader((fbe_base_enclosure_t*)esesEnclosurePtr),
+                         "%s entry \n", __FUNCTION__);
+
+    status = fbe_base_enclosure_get_packet_payload_control_data(packetPtr,
+                                                                (fbe_base_enclosure_t*)esesEnclosurePtr,
+                                                                TRUE,
+                                                                (fbe_payload_control_buffer_t *)&pStats,
+                                                                sizeof(fbe_enclosure_mgmt_status_page_stats_t));
+    if(status == FBE_STATUS_OK)
+    {
+        fbe_spinlock_lock(&esesEnclosurePtr->enclGetInfoLock);
+        if(pStats->setIncremental)
+        {
+            pCache->incremental_disabled = !pStats->incremental;
+        }
+        pStats->incremental = !pCache->incremental_disabled;
+        pStats->pagesProcessed = pCache->pages_processed;
+        pStats->fullDecodes = pCache->full_decodes;
+        pStats->groupsDecoded = pCache->groups_decoded;
+        pStats->groupsSkipped = pCache->groups_skipped;
+        pStats->processTimeUs = pCache->process_time_us;
+        if(pStats->clearStats)
+        {
+            pCache->pages_processed = 0;
+            pCache->full_decodes = 0;
+            pCache->groups_decoded = 0;
+            pCache->groups_skipped = 0;
+            pCache->process_time_us = 0;
+        }
+        fbe_spinlock_unlock(&esesEnclosurePtr->enclGetInfoLock);
+        encl_stat = FBE_ENCLOSURE_STATUS_OK;       
+    }
+    else
+    {
+        fbe_base_object_customizable_trace((fbe_base_object_t*)esesEnclosurePtr,
+                         FBE_TRACE_LEVEL_INFO,
+                         fbe_base_enclosure_get_logheader((fbe_base_enclosure_t*)esesEnclosurePtr),
+                         "%s status:0x%x\n", __FUNCTION__, status);
+    }
+    fbe_base_enclosure_set_packet_payload_status(packetPtr, encl_stat);
+    fbe_transport_complete_packet(packetPtr);
+
+    return (status);
+} //fbe_eses_enclosure_status_page_stats
+
 /*!*************************************************************************
  *  @fn fbe_eses_enclosure_get_ssc_info(
  *                   fbe_eses_enclosure_t *esesEnclosurePtr, 
@@ -4358,6 +4435,9 @@ eses_enclosure_processDriveDebugControl(fbe_eses_enclosure_t *esesEnclosurePtr,
         }
     }
 
+    /* The drive slot status decode depends on the insert masking. */
+    fbe_eses_enclosure_invalidate_status_page_cache(esesEnclosurePtr);
+
 // jap - think about error handling
     if (returnEnclStatus == FBE_ENCLOSURE_STATUS_OK)
     {
@@ -228,11 +228,31 @@ typedef struct fbe_extent_pool_disk_info_s
 {
     fbe_block_count_t capacity;
     fbe_object_id_t object_id;
-    fbe_slice_index_t free_slice_index;
+    fbe_slice_count_t free_slice_count; /*!< Number of free slices on the free stack. */
+    fbe_u32_t *free_slice_stack_p; /*!< Indexes into drive_map_table_p of free slices, top is allocated next. */
+    fbe_u32_t heap_index; /*!< Position of this disk in the pool's free map heap. */
     fbe_extent_pool_disk_slice_t *drive_map_table_p;
 }
 fbe_extent_pool_disk_info_t;
 #pragma pack()
+
+/*!*******************************************************************
+ * @struct fbe_extent_pool_free_map_t
+ *********************************************************************
+ * @brief
+ *  Free space of the pool.  Each disk keeps a stack of its free
+ *  slices so that freed slices are reused in O(1), and the pool
+ *  keeps a heap of its disks ordered by free slices so that new
+ *  slices go to the least loaded disks in O(log n).
+ * 
+ *********************************************************************/
+typedef struct fbe_extent_pool_free_map_s
+{
+    fbe_u32_t *disk_heap_p; /*!< Disk indexes, the disk with the most free slices first. */
+    fbe_u32_t disk_count;   /*!< Number of disks in the heap. */
+    fbe_slice_count_t free_slices; /*!< Free slices of all disks. */
+}
+fbe_extent_pool_free_map_t;
 /*!****************************************************************************
  *    
  * @struct fbe_extent_pool_t
@@ -263,6 +283,8 @@ typedef struct fbe_extent_pool_s
     fbe_extent_pool_slice_t      *slice_p; /*!< Slice memory */
     fbe_queue_head_t slice_list; /* Free slice list. */
     fbe_extent_pool_disk_info_t  *disk_info_p; /*!< Disk info memory.*/
+    fbe_extent_pool_free_map_t   free_map; /*!< Free disk slices. */
+    fbe_u32_t                    *free_map_memory_p; /*!< Memory of the free stacks and heap. */
     fbe_raid_geometry_t *geometry_p;
 
     /* Lifecycle defines. */
@@ -376,6 +398,25 @@ fbe_status_t fbe_extent_pool_construct_lun_slices(fbe_extent_pool_t *extent_pool
                                                   fbe_u32_t lun);
 fbe_status_t fbe_extent_pool_construct_user_slices(fbe_extent_pool_t *extent_pool_p);
 
+/* fbe_extent_pool_free_map.c */
+fbe_u32_t fbe_extent_pool_free_map_get_memory_entries(fbe_extent_pool_disk_info_t *disk_info_p,
+                                                      fbe_u32_t pool_width,
+                                                      fbe_block_count_t blocks_per_disk_slice);
+fbe_status_t fbe_extent_pool_free_map_init(fbe_extent_pool_free_map_t *free_map_p,
+                                           fbe_extent_pool_disk_info_t *disk_info_p,
+                                           fbe_u32_t pool_width,
+                                           fbe_block_count_t blocks_per_disk_slice,
+                                           fbe_u32_t *memory_p);
+fbe_status_t fbe_extent_pool_free_map_allocate(fbe_extent_pool_free_map_t *free_map_p,
+                                               fbe_extent_pool_disk_info_t *disk_info_p,
+                                               fbe_u32_t width,
+                                               fbe_extent_pool_disk_slice_t **disk_slice_array,
+                                               fbe_u32_t *disk_index_array);
+fbe_status_t fbe_extent_pool_free_map_release(fbe_extent_pool_free_map_t *free_map_p,
+                                              fbe_extent_pool_disk_info_t *disk_info_p,
+                                              fbe_u32_t disk_index,
+                                              fbe_extent_pool_disk_slice_t *disk_slice_p);
+
 /* fbe_extent_pool_class.c */
 fbe_status_t fbe_extent_pool_class_control_entry(fbe_packet_t * packet);
 fbe_status_t fbe_extent_pool_class_init_slice_memory(void);
@@ -0,0 +1,345 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2014
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!*************************************************************************
+ * @file fbe_extent_pool_free_map.c
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains the free space map of the extent pool.
+ *
+ *  Every disk keeps a stack with the indexes of its free disk slices.
+ *  Allocating pops the top of the stack and freeing pushes the slice
+ *  back, so a freed slice is found again in O(1) no matter where it
+ *  is on the disk.
+ *
+ *  The pool keeps a binary max heap of its disks keyed by the number
+ *  of free slices (ties go to the lower disk index).  A user slice of
+ *  width N takes its disk slices from the N disks at the top of the
+ *  heap, so new slices spread across the drives by load in O(N log n).
+ *
+ *  The caller holds the pool lock.  Nothing in here traces or
+ *  allocates, so the unit test can drive it directly.
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "fbe_extent_pool_private.h"
+
+/*************************
+ *   FUNCTION DEFINITIONS
+ *************************/
+
+static fbe_bool_t fbe_extent_pool_free_map_is_before(fbe_extent_pool_disk_info_t *disk_info_p,
+                                                     fbe_u32_t disk_a,
+                                                     fbe_u32_t disk_b);
+static void fbe_extent_pool_free_map_sift_up(fbe_extent_pool_free_map_t *free_map_p,
+                                             fbe_extent_pool_disk_info_t *disk_info_p,
+                                             fbe_u32_t heap_index);
+static void fbe_extent_pool_free_map_sift_down(fbe_extent_pool_free_map_t *free_map_p,
+                                               fbe_extent_pool_disk_info_t *disk_info_p,
+                                               fbe_u32_t heap_index);
+static fbe_u32_t fbe_extent_pool_free_map_pop_disk(fbe_extent_pool_free_map_t *free_map_p,
+                                                   fbe_extent_pool_disk_info_t *disk_info_p);
+static void fbe_extent_pool_free_map_push_disk(fbe_extent_pool_free_map_t *free_map_p,
+                                               fbe_extent_pool_disk_info_t *disk_info_p,
+                                               fbe_u32_t disk_index);
+
+/*!**************************************************************
+ * fbe_extent_pool_free_map_get_memory_entries()
+ ****************************************************************
+ * @brief
+ *  Number of fbe_u32_t the free map needs: one stack entry per
+ *  disk slice plus one heap entry per disk.
+ *
+ * @param disk_info_p - Array of disk info of the pool.
+ * @param pool_width - Number of disks in the pool.
+ * @param blocks_per_disk_slice - Size of a disk slice.
+ *
+ * @return fbe_u32_t
+ *
+ ****************************************************************/
+fbe_u32_t fbe_extent_pool_free_map_get_memory_entries(fbe_extent_pool_disk_info_t *disk_info_p,
+                                                      fbe_u32_t pool_width,
+                                                      fbe_block_count_t blocks_per_disk_slice)
+{
+    fbe_u32_t entries = pool_width;
+    fbe_u32_t disk_index;
+
+    for (disk_index = 0; disk_index < pool_width; disk_index++) {
+        entries += (fbe_u32_t)(disk_info_p[disk_index].capacity / blocks_per_disk_slice);
+    }
+    return entries;
+}
+/******************************************
+ * end fbe_extent_pool_free_map_get_memory_entries()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_extent_pool_free_map_init()
+ ****************************************************************
+ * @brief
+ *  Build the free stacks of all disks from their drive map
+ *  tables and the heap of disks.  Slices already marked allocated
+ *  are left out.  Each stack is built so that the lowest free
+ *  slice is allocated first.
+ *
+ * @param free_map_p - Free map to initialize.
+ * @param disk_info_p - Array of disk info of the pool.
+ * @param pool_width - Number of disks in the pool.
+ * @param blocks_per_disk_slice - Size of a disk slice.
+ * @param memory_p - fbe_extent_pool_free_map_get_memory_entries() entries.
+ *
+ * @return fbe_status_t
+ *
+ ****************************************************************/
+fbe_status_t fbe_extent_pool_free_map_init(fbe_extent_pool_free_map_t *free_map_p,
+                                           fbe_extent_pool_disk_info_t *disk_info_p,
+                                           fbe_u32_t pool_width,
+                                           fbe_block_count_t blocks_per_disk_slice,
+                                           fbe_u32_t *memory_p)
+{
+    fbe_u32_t         disk_index;
+    fbe_slice_count_t disk_slices;
+    fbe_slice_index_t slice_index;
+    fbe_u8_t          flags;
+
+    free_map_p->disk_heap_p = memory_p;
+    free_map_p->disk_count = 0;
+    free_map_p->free_slices = 0;
+    memory_p += pool_width;
+
+    for (disk_index = 0; disk_index < pool_width; disk_index++) {
+        disk_slices = disk_info_p[disk_index].capacity / blocks_per_disk_slice;
+        disk_info_p[disk_index].free_slice_stack_p = memory_p;
+        disk_info_p[disk_index].free_slice_count = 0;
+        memory_p += disk_slices;
+
+        /* Push from the end of the disk so the start of the disk is on top.
+         */
+        for (slice_index = disk_slices; slice_index > 0; slice_index--) {
+            flags = fbe_extent_pool_disk_slice_address_get_flags(disk_info_p[disk_index].drive_map_table_p[slice_index - 1].disk_address);
+            if ((flags & FBE_DISK_SLICE_ADDRESS_FLAG_ALLOCATED) == 0) {
+                disk_info_p[disk_index].free_slice_stack_p[disk_info_p[disk_index].free_slice_count++] = (fbe_u32_t)(slice_index - 1);
+            }
+        }
+        free_map_p->free_slices += disk_info_p[disk_index].free_slice_count;
+        fbe_extent_pool_free_map_push_disk(free_map_p, disk_info_p, disk_index);
+    }
+    return FBE_STATUS_OK;
+}
+/******************************************
+ * end fbe_extent_pool_free_map_init()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_extent_pool_free_map_allocate()
+ ****************************************************************
+ * @brief
+ *  Take one free disk slice from each of the width disks with the
+ *  most free slices.  Either all width slices are allocated or none.
+ *  The caller marks the disk slices allocated.
+ *
+ * @param free_map_p - Free map of the pool.
+ * @param disk_info_p - Array of disk info of the pool.
+ * @param width - Number of disk slices (all on different disks).
+ * @param disk_slice_array - Output disk slices.
+ * @param disk_index_array - Output disk of each disk slice.
+ *
+ * @return FBE_STATUS_INSUFFICIENT_RESOURCES if fewer than width
+ *         disks have a free slice.
+ *
+ ****************************************************************/
+fbe_status_t fbe_extent_pool_free_map_allocate(fbe_extent_pool_free_map_t *free_map_p,
+                                               fbe_extent_pool_disk_info_t *disk_info_p,
+                                               fbe_u32_t width,
+                                               fbe_extent_pool_disk_slice_t **disk_slice_array,
+                                               fbe_u32_t *disk_index_array)
+{
+    fbe_u32_t                    index;
+    fbe_u32_t                    disk_index;
+    fbe_extent_pool_disk_info_t *current_disk_p = NULL;
+
+    if ((width == 0) || (width > free_map_p->disk_count)) {
+        return FBE_STATUS_INSUFFICIENT_RESOURCES;
+    }
+
+    /* Take the width least loaded disks off the heap so they are all different.
+     */
+    for (index = 0; index < width; index++) {
+        disk_index_array[index] = fbe_extent_pool_free_map_pop_disk(free_map_p, disk_info_p);
+    }
+
+    /* The heap is ordered, so if the last one has a free slice they all do.
+     */
+    if (disk_info_p[disk_index_array[width - 1]].free_slice_count == 0) {
+        for (index = 0; index < width; index++) {
+            fbe_extent_pool_free_map_push_disk(free_map_p, disk_info_p, disk_index_array[index]);
+        }
+        return FBE_STATUS_INSUFFICIENT_RESOURCES;
+    }
+
+    for (index = 0; index < width; index++) {
+        disk_index = disk_index_array[index];
+        current_disk_p = &disk_info_p[disk_index];
+        current_disk_p->free_slice_count--;
+        disk_slice_array[index] = &current_disk_p->drive_map_table_p[current_disk_p->free_slice_stack_p[current_disk_p->free_slice_count]];
+        fbe_extent_pool_free_map_push_disk(free_map_p, disk_info_p, disk_index);
+    }
+    free_map_p->free_slices -= width;
+    return FBE_STATUS_OK;
+}
+/******************************************
+ * end fbe_extent_pool_free_map_allocate()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_extent_pool_free_map_release()
+ ****************************************************************
+ * @brief
+ *  Return a disk slice to its disk.  The disk slice keeps its
+ *  disk lba but loses its extent address, position and flags.
+ *
+ * @param free_map_p - Free map of the pool.
+ * @param disk_info_p - Array of disk info of the pool.
+ * @param disk_index - Disk the disk slice is on.
+ * @param disk_slice_p - Disk slice to free.
+ *
+ * @return fbe_status_t
+ *
+ ****************************************************************/
+fbe_status_t fbe_extent_pool_free_map_release(fbe_extent_pool_free_map_t *free_map_p,
+                                              fbe_extent_pool_disk_info_t *disk_info_p,
+                                              fbe_u32_t disk_index,
+                                              fbe_extent_pool_disk_slice_t *disk_slice_p)
+{
+    fbe_extent_pool_disk_info_t *current_disk_p = &disk_info_p[disk_index];
+    fbe_u8_t                     flags;
+
+    flags = fbe_extent_pool_disk_slice_address_get_flags(disk_slice_p->disk_address);
+    if ((flags & FBE_DISK_SLICE_ADDRESS_FLAG_ALLOCATED) == 0) {
+        /* Already free, pushing it again would hand it out twice. */
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+    fbe_extent_pool_disk_slice_address_set(&disk_slice_p->disk_address,
+                                           fbe_extent_pool_disk_slice_address_get_lba(disk_slice_p->disk_address),
+                                           0, FBE_DISK_SLICE_ADDRESS_FLAG_NONE);
+    disk_slice_p->extent_address = 0;
+
+    current_disk_p->free_slice_stack_p[current_disk_p->free_slice_count++] = (fbe_u32_t)(disk_slice_p - current_disk_p->drive_map_table_p);
+    free_map_p->free_slices++;
+
+    /* More free slices only ever moves the disk up. */
+    fbe_extent_pool_free_map_sift_up(free_map_p, disk_info_p, current_disk_p->heap_index);
+    return FBE_STATUS_OK;
+}
+/******************************************
+ * end fbe_extent_pool_free_map_release()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_extent_pool_free_map_is_before()
+ ****************************************************************
+ * @brief
+ *  Heap order: more free slices first, then the lower disk index.
+ *
+ ****************************************************************/
+static fbe_bool_t fbe_extent_pool_free_map_is_before(fbe_extent_pool_disk_info_t *disk_info_p,
+                                                     fbe_u32_t disk_a,
+                                                     fbe_u32_t disk_b)
+{
+    if (disk_info_p[disk_a].free_slice_count != disk_info_p[disk_b].free_slice_count) {
+        return (disk_info_p[disk_a].free_slice_count > disk_info_p[disk_b].free_slice_count);
+    }
+    return (disk_a < disk_b);
+}
+
+static void fbe_extent_pool_free_map_swap(fbe_extent_pool_free_map_t *free_map_p,
+                                          fbe_extent_pool_disk_info_t *disk_info_p,
+                                          fbe_u32_t heap_a,
+                                          fbe_u32_t heap_b)
+{
+    fbe_u32_t disk_a = free_map_p->disk_heap_p[heap_a];
+    fbe_u32_t disk_b = free_map_p->disk_heap_p[heap_b];
+
+    free_map_p->disk_heap_p[heap_a] = disk_b;
+    free_map_p->disk_heap_p[heap_b] = disk_a;
+    disk_info_p[disk_b].heap_index = heap_a;
+    disk_info_p[disk_a].heap_index = heap_b;
+}
+
+static void fbe_extent_pool_free_map_sift_up(fbe_extent_pool_free_map_t *free_map_p,
+                                             fbe_extent_pool_disk_info_t *disk_info_p,
+                                             fbe_u32_t heap_index)
+{
+    fbe_u32_t parent;
+
+    while (heap_index > 0) {
+        parent = (heap_index - 1) / 2;
+        if (!fbe_extent_pool_free_map_is_before(disk_info_p,
+                                                free_map_p->disk_heap_p[heap_index],
+                                                free_map_p->disk_heap_p[parent])) {
+            break;
+        }
+        fbe_extent_pool_free_map_swap(free_map_p, disk_info_p, heap_index, parent);
+        heap_index = parent;
+    }
+}
+
+static void fbe_extent_pool_free_map_sift_down(fbe_extent_pool_free_map_t *free_map_p,
+                                               fbe_extent_pool_disk_info_t *disk_info_p,
+                                               fbe_u32_t heap_index)
+{
+    fbe_u32_t child;
+    fbe_u32_t best;
+
+    while (1) {
+        best = heap_index;
+        child = (2 * heap_index) + 1;
+        if ((child < free_map_p->disk_count) &&
+            fbe_extent_pool_free_map_is_before(disk_info_p, free_map_p->disk_heap_p[child], free_map_p->disk_heap_p[best])) {
+            best = child;
+        }
+        child++;
+        if ((child < free_map_p->disk_count) &&
+            fbe_extent_pool_free_map_is_before(disk_info_p, free_map_p->disk_heap_p[child], free_map_p->disk_heap_p[best])) {
+            best = child;
+        }
+        if (best == heap_index) {
+            break;
+        }
+        fbe_extent_pool_free_map_swap(free_map_p, disk_info_p, heap_index, best);
+        heap_index = best;
+    }
+}
+
+static fbe_u32_t fbe_extent_pool_free_map_pop_disk(fbe_extent_pool_free_map_t *free_map_p,
+                                                   fbe_extent_pool_disk_info_t *disk_info_p)
+{
+    fbe_u32_t disk_index = free_map_p->disk_heap_p[0];
+
+    free_map_p->disk_count--;
+    if (free_map_p->disk_count > 0) {
+        fbe_extent_pool_free_map_swap(free_map_p, disk_info_p, 0, free_map_p->disk_count);
+        fbe_extent_pool_free_map_sift_down(free_map_p, disk_info_p, 0);
+    }
+    return disk_index;
+}
+
+static void fbe_extent_pool_free_map_push_disk(fbe_extent_pool_free_map_t *free_map_p,
+                                               fbe_extent_pool_disk_info_t *disk_info_p,
+                                               fbe_u32_t disk_index)
+{
+    free_map_p->disk_heap_p[free_map_p->disk_count] = disk_index;
+    disk_info_p[disk_index].heap_index = free_map_p->disk_count;
+    free_map_p->disk_count++;
+    fbe_extent_pool_free_map_sift_up(free_map_p, disk_info_p, disk_info_p[disk_index].heap_index);
+}
+/*************************
+ * end file fbe_extent_pool_free_map.c
+ *************************/
@@ -260,6 +260,9 @@ fbe_extent_pool_release_memory(fbe_extent_pool_t *extent_pool_p)
     if (extent_pool_p->disk_info_p) {
         fbe_memory_release_required(extent_pool_p->disk_info_p);
     }
+    if (extent_pool_p->free_map_memory_p) {
+        fbe_memory_release_required(extent_pool_p->free_map_memory_p);
+    }
     if (extent_pool_p->slice_p) {
         fbe_memory_release_required(extent_pool_p->slice_p);
     }
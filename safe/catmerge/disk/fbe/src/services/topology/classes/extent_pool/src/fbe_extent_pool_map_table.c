@@ -338,60 +338,6 @@ fbe_status_t fbe_extent_pool_construct_lun_slices(fbe_extent_pool_t *extent_pool
  * end fbe_extent_pool_construct_lun_slices()
  ******************************************/
 
-/*!**************************************************************
- * fbe_extent_pool_disk_info_get_free_slice()
- ****************************************************************
- * @brief
- *  Populates the disk slices as if they were already allocated.
- *
- * @param extent_pool_p - Pool object.
- * @param disk_info_p -
- * @param slice_p - output free slice.
- *
- * @return fbe_status_t
- *
- * @author
- *  6/18/2014 - Created. Rob Foley
- *
- ****************************************************************/
-
-fbe_status_t fbe_extent_pool_disk_info_get_free_slice(fbe_extent_pool_t *extent_pool_p,
-                                                      fbe_extent_pool_disk_info_t *disk_info_p,
-                                                      fbe_slice_index_t disk_slice_offset,
-                                                      fbe_extent_pool_disk_slice_t **slice_p)
-{
-    fbe_slice_index_t max_slices;
-    fbe_block_count_t blocks_per_disk_slice;
-    fbe_u8_t          flags;
-    fbe_slice_index_t slice_index;
-
-    fbe_extent_pool_class_get_blocks_per_disk_slice(&blocks_per_disk_slice);
-    max_slices = disk_info_p->capacity / blocks_per_disk_slice;
-
-    if (disk_info_p->free_slice_index >= max_slices) {
-        *slice_p = NULL;
-        return FBE_STATUS_INSUFFICIENT_RESOURCES;
-    }
-
-    disk_slice_offset = disk_info_p->free_slice_index;
-    for (slice_index = disk_slice_offset; slice_index < max_slices; slice_index++) {
-        
-        flags = fbe_extent_pool_disk_slice_address_get_flags(disk_info_p->drive_map_table_p[slice_index].disk_address);
-
-        if ((flags & FBE_DISK_SLICE_ADDRESS_FLAG_ALLOCATED) == 0) {
-            *slice_p = &disk_info_p->drive_map_table_p[slice_index];
-            disk_info_p->free_slice_index = slice_index + 1;
-            return FBE_STATUS_OK;
-        }
-    }
-    *slice_p = NULL;
-    disk_info_p->free_slice_index = max_slices;
-    return FBE_STATUS_OK;
-}
-/**************************************
- * end fbe_extent_pool_disk_info_get_free_slice()
- **************************************/
-
 /*!**************************************************************
  * fbe_extent_pool_fully_map_lun()
  ****************************************************************
@@ -412,60 +358,47 @@ fbe_status_t fbe_extent_pool_fully_map_lun(fbe_extent_pool_t *extent_pool_p,
                                            fbe_block_count_t capacity,
                                            fbe_block_count_t offset)
 {
+    fbe_status_t                 status;
     fbe_extent_pool_disk_slice_t *slice_p = NULL;
-    fbe_u32_t                    pool_index;
     fbe_u32_t                    array_index;
-    fbe_extent_pool_disk_info_t *disk_info_p = NULL;
     fbe_slice_count_t            lun_slices;
     fbe_slice_index_t            slice_index;
     fbe_lba_t                    lba;
     fbe_lba_t                    disk_lba;
     fbe_block_count_t            blocks_per_slice;
     fbe_u32_t                    width;
-    fbe_u32_t                    pool_width;
     fbe_u16_t                    data_disks;
     fbe_raid_geometry_t         *geometry_p = NULL;
-    fbe_block_count_t            pool_slice_size;
-    fbe_slice_index_t            pool_slice_start;
+    fbe_extent_pool_disk_slice_t *slice_array[FBE_RAID_MAX_DISK_ARRAY_WIDTH];
+    fbe_u32_t                    disk_index_array[FBE_RAID_MAX_DISK_ARRAY_WIDTH];
 
     fbe_extent_pool_class_get_blocks_per_slice(&blocks_per_slice);
     fbe_extent_pool_get_user_pool_geometry(extent_pool_p, &geometry_p);
     fbe_raid_geometry_get_width(geometry_p, &width);
     fbe_raid_geometry_get_data_disks(geometry_p, &data_disks);
-    fbe_extent_pool_get_pool_width(extent_pool_p, &pool_width);
-    pool_slice_size = (pool_width / width) * data_disks * blocks_per_slice;
 
-    pool_slice_start = offset / pool_slice_size;
-    if (offset % pool_slice_size) {
-        pool_slice_start++;
-    }
     lun_slices = capacity / (blocks_per_slice * data_disks);
     fbe_base_object_trace((fbe_base_object_t*)extent_pool_p, 
                           FBE_TRACE_LEVEL_INFO, FBE_TRACE_MESSAGE_ID_INFO,
-                          "map: lun %u capacity: %llx offset: %llx start_slice: 0x%llx\n",
-                          lun, capacity, offset, pool_slice_start);
+                          "map: lun %u capacity: %llx offset: %llx free disk slices: 0x%llx\n",
+                          lun, capacity, offset, extent_pool_p->free_map.free_slices);
     fbe_extent_pool_lock(extent_pool_p);
-    /* For every slice in the LUN, initialize the disk addresses.
+    /* For every slice in the LUN, take a disk slice from each of the 
+     * least loaded disks and initialize the disk addresses.
      */
     lba = 0;
-    pool_index = 0;
     for (slice_index = 0; slice_index < lun_slices; slice_index++) {
-        array_index = 0;
-        while (array_index < width) {
-            fbe_extent_pool_get_disk_info(extent_pool_p, pool_index, &disk_info_p);
-            
-            fbe_extent_pool_disk_info_get_free_slice(extent_pool_p, disk_info_p, pool_slice_start, &slice_p);
-            if (slice_p == NULL) {
-                pool_index++;
-                if (pool_index >= pool_width) {
-                    fbe_base_object_trace((fbe_base_object_t*)extent_pool_p, 
-                                          FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
-                                          "Ran out of disk slices\n");
-                    fbe_extent_pool_unlock(extent_pool_p);
-                    return FBE_STATUS_GENERIC_FAILURE;
-                }
-                continue;
-            }
+        status = fbe_extent_pool_free_map_allocate(&extent_pool_p->free_map, extent_pool_p->disk_info_p,
+                                                   width, slice_array, disk_index_array);
+        if (status != FBE_STATUS_OK) {
+            fbe_base_object_trace((fbe_base_object_t*)extent_pool_p, 
+                                  FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                                  "Ran out of disk slices\n");
+            fbe_extent_pool_unlock(extent_pool_p);
+            return FBE_STATUS_GENERIC_FAILURE;
+        }
+        for (array_index = 0; array_index < width; array_index++) {
+            slice_p = slice_array[array_index];
             disk_lba = fbe_extent_pool_disk_slice_address_get_lba(slice_p->disk_address);
             /* Set the position and lba in the slice.
              */
@@ -483,12 +416,7 @@ fbe_status_t fbe_extent_pool_fully_map_lun(fbe_extent_pool_t *extent_pool_p,
             fbe_base_object_trace((fbe_base_object_t*)extent_pool_p, 
                                   FBE_TRACE_LEVEL_INFO, FBE_TRACE_MESSAGE_ID_INFO,
                                   "map: lun: %u disk_addr: %llx disk_lba: 0x%llx pool_idx: 0x%x\n",
-                                  lun, slice_p->disk_address, disk_lba, pool_index);
-            array_index++;
-            pool_index++;
-            if (pool_index >= pool_width) {
-                pool_index = 0;
-            }
+                                  lun, slice_p->disk_address, disk_lba, disk_index_array[array_index]);
         }
         lba += blocks_per_slice * data_disks;
     }
@@ -517,29 +445,25 @@ fbe_status_t fbe_extent_pool_fully_map_lun(fbe_extent_pool_t *extent_pool_p,
 
 fbe_status_t fbe_extent_pool_fully_map_pool(fbe_extent_pool_t *extent_pool_p)
 {
+    fbe_status_t                 status;
     fbe_extent_pool_disk_slice_t *slice_p = NULL;
-    fbe_u32_t                    pool_index;
     fbe_u32_t                    array_index;
-    fbe_extent_pool_disk_info_t *disk_info_p = NULL;
     fbe_slice_count_t            pool_slices;
     fbe_slice_index_t            slice_index;
     fbe_lba_t                    lba;
     fbe_lba_t                    disk_lba;
     fbe_block_count_t            blocks_per_slice;
     fbe_u32_t                    width;
-    fbe_u32_t                    pool_width;
     fbe_u16_t                    data_disks;
     fbe_raid_geometry_t         *geometry_p = NULL;
-    fbe_block_count_t            pool_slice_size;
     fbe_block_count_t            capacity;
     fbe_extent_pool_disk_slice_t *slice_array[FBE_RAID_MAX_DISK_ARRAY_WIDTH];
+    fbe_u32_t                    disk_index_array[FBE_RAID_MAX_DISK_ARRAY_WIDTH];
 
     fbe_extent_pool_class_get_blocks_per_slice(&blocks_per_slice);
     fbe_extent_pool_get_user_pool_geometry(extent_pool_p, &geometry_p);
     fbe_raid_geometry_get_width(geometry_p, &width);
     fbe_raid_geometry_get_data_disks(geometry_p, &data_disks);
-    fbe_extent_pool_get_pool_width(extent_pool_p, &pool_width);
-    pool_slice_size = (pool_width / width) * data_disks * blocks_per_slice;
 
     capacity = extent_pool_p->total_slices * blocks_per_slice;
     pool_slices = extent_pool_p->total_slices;
@@ -549,39 +473,33 @@ fbe_status_t fbe_extent_pool_fully_map_pool(fbe_extent_pool_t *extent_pool_p)
                           capacity, pool_slices);
 
     fbe_extent_pool_lock(extent_pool_p);
-    /* For every slice in the pool, initialize the disk addresses.
+    /* For every slice in the pool, take a disk slice from each of the 
+     * least loaded disks and initialize the disk addresses.
      */
     lba = 0;
-    pool_index = 0;
     for (slice_index = 0; slice_index < pool_slices; slice_index++) {
-        array_index = 0;
-        while (array_index < width) {
-            fbe_extent_pool_get_disk_info(extent_pool_p, pool_index, &disk_info_p);
-            
-            fbe_extent_pool_disk_info_get_free_slice(extent_pool_p, disk_info_p, 0, &slice_p);
-            if (slice_p == NULL) {
-                pool_index++;
-                if (pool_index >= pool_width) {
-                    fbe_lba_t total_capacity;
-
-                    extent_pool_p->total_slices = slice_index;
-                    total_capacity = extent_pool_p->total_slices * blocks_per_slice * FBE_EXTENT_POOL_DEFAULT_DATA_DISKS;
-
-                    fbe_base_object_trace((fbe_base_object_t*)extent_pool_p, 
-                                          FBE_TRACE_LEVEL_INFO, FBE_TRACE_MESSAGE_ID_INFO,
-                                          "total slices is: 0x%llx total_capacity: 0x%llx\n",
-                                          extent_pool_p->total_slices, total_capacity);
-
-                    fbe_base_config_set_capacity((fbe_base_config_t*)extent_pool_p, total_capacity);
-                    for (slice_index = 0; slice_index < array_index; slice_index++) {
-                        slice_array[slice_index]->disk_address = 0;
-                        slice_array[slice_index]->extent_address = 0;
-                    }
-                    fbe_extent_pool_unlock(extent_pool_p);
-                    return FBE_STATUS_OK;
-                }
-                continue;
-            }
+        status = fbe_extent_pool_free_map_allocate(&extent_pool_p->free_map, extent_pool_p->disk_info_p,
+                                                   width, slice_array, disk_index_array);
+        if (status != FBE_STATUS_OK) {
+            /* Drives of different capacities leave fewer full slices than
+             * the total disk slices suggest.  The pool ends here.
+             */
+            fbe_lba_t total_capacity;
+
+            extent_pool_p->total_slices = slice_index;
+            total_capacity = extent_pool_p->total_slices * blocks_per_slice * FBE_EXTENT_POOL_DEFAULT_DATA_DISKS;
+
+            fbe_base_object_trace((fbe_base_object_t*)extent_pool_p, 
+                                  FBE_TRACE_LEVEL_INFO, FBE_TRACE_MESSAGE_ID_INFO,
+                                  "total slices is: 0x%llx total_capacity: 0x%llx\n",
+                                  extent_pool_p->total_slices, total_capacity);
+
+            fbe_base_config_set_capacity((fbe_base_config_t*)extent_pool_p, total_capacity);
+            fbe_extent_pool_unlock(extent_pool_p);
+            return FBE_STATUS_OK;
+        }
+        for (array_index = 0; array_index < width; array_index++) {
+            slice_p = slice_array[array_index];
             disk_lba = fbe_extent_pool_disk_slice_address_get_lba(slice_p->disk_address);
             /* Set the position and lba in the slice.
              */
@@ -599,13 +517,7 @@ fbe_status_t fbe_extent_pool_fully_map_pool(fbe_extent_pool_t *extent_pool_p)
             fbe_base_object_trace((fbe_base_object_t*)extent_pool_p, 
                                   FBE_TRACE_LEVEL_INFO, FBE_TRACE_MESSAGE_ID_INFO,
                                   "map: disk_addr: %llx disk_lba: 0x%llx pool_idx: 0x%x\n",
-                                  slice_p->disk_address, disk_lba, pool_index);
-            slice_array[array_index] = slice_p;
-            array_index++;
-            pool_index++;
-            if (pool_index >= pool_width) {
-                pool_index = 0;
-            }
+                                  slice_p->disk_address, disk_lba, disk_index_array[array_index]);
         }
         lba += blocks_per_slice * data_disks;
     }
@@ -1375,6 +1375,7 @@ fbe_status_t fbe_extent_pool_init_disk_info(fbe_extent_pool_t *extent_pool_p)
     fbe_extent_pool_disk_slice_t *current_slice_p = NULL;
     fbe_lba_t                    lba;
     fbe_block_count_t            blocks_per_disk_slice;
+    fbe_u32_t                    free_map_entries;
 
     fbe_extent_pool_class_get_blocks_per_disk_slice(&blocks_per_disk_slice);
 
@@ -1420,7 +1421,7 @@ fbe_status_t fbe_extent_pool_init_disk_info(fbe_extent_pool_t *extent_pool_p)
     /* Initialize the disk information for all drives.
      */
     for (disk_index = 0; disk_index < pool_width; disk_index++) {
-        disk_info_p[disk_index].free_slice_index = 0;
+        disk_info_p[disk_index].free_slice_count = 0;
         disk_info_p[disk_index].object_id = pvd_list[disk_index];
         fbe_database_get_pvd_capacity(pvd_list[disk_index], &disk_info_p[disk_index].capacity);
         total_slices += disk_info_p[disk_index].capacity / blocks_per_disk_slice;
@@ -1474,6 +1475,19 @@ fbe_status_t fbe_extent_pool_init_disk_info(fbe_extent_pool_t *extent_pool_p)
             lba += blocks_per_disk_slice;
         }
     }
+
+    /* Every disk slice starts out free.
+     */
+    free_map_entries = fbe_extent_pool_free_map_get_memory_entries(disk_info_p, pool_width, blocks_per_disk_slice);
+    extent_pool_p->free_map_memory_p = fbe_memory_allocate_required((fbe_u32_t)(sizeof(fbe_u32_t) * free_map_entries));
+    if (extent_pool_p->free_map_memory_p == NULL) {
+        fbe_base_object_trace((fbe_base_object_t*)extent_pool_p, 
+                              FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                              "%s Cannot allocate memory for free map\n", __FUNCTION__);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+    fbe_extent_pool_free_map_init(&extent_pool_p->free_map, disk_info_p, pool_width, 
+                                  blocks_per_disk_slice, extent_pool_p->free_map_memory_p);
     return FBE_STATUS_OK;
 }
 /******************************************
@@ -0,0 +1,375 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2014
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!**************************************************************************
+ * @file fbe_extent_pool_free_map_tests.c
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains the unit test for the extent pool free map.
+ *
+ ***************************************************************************/
+#include "fbe_extent_pool_private.h"
+#include "fbe_extent_pool_test.h"
+#include "fbe/fbe_time.h"
+#include <stdlib.h>
+
+/*!*******************************************************************
+ * @def FBE_EXTENT_POOL_FREE_MAP_TEST_DISKS
+ *********************************************************************
+ * @brief Number of disks in the test pool.
+ *********************************************************************/
+#define FBE_EXTENT_POOL_FREE_MAP_TEST_DISKS 16
+
+/*!*******************************************************************
+ * @def FBE_EXTENT_POOL_FREE_MAP_TEST_WIDTH
+ *********************************************************************
+ * @brief Disk slices in each user slice.
+ *********************************************************************/
+#define FBE_EXTENT_POOL_FREE_MAP_TEST_WIDTH 5
+
+/*!*******************************************************************
+ * @def FBE_EXTENT_POOL_FREE_MAP_TEST_BLOCKS_PER_SLICE
+ *********************************************************************
+ * @brief Blocks in each disk slice.
+ *********************************************************************/
+#define FBE_EXTENT_POOL_FREE_MAP_TEST_BLOCKS_PER_SLICE 0x800
+
+/*!*******************************************************************
+ * @def FBE_EXTENT_POOL_FREE_MAP_TEST_ITERATIONS
+ *********************************************************************
+ * @brief Allocate or release operations of the churn.
+ *********************************************************************/
+#define FBE_EXTENT_POOL_FREE_MAP_TEST_ITERATIONS 200000
+
+/*!*******************************************************************
+ * @struct fbe_extent_pool_free_map_test_slice_t
+ *********************************************************************
+ * @brief
+ *  One user slice the test currently holds.
+ *
+ *********************************************************************/
+typedef struct fbe_extent_pool_free_map_test_slice_s
+{
+    fbe_extent_pool_disk_slice_t *disk_slice_p[FBE_EXTENT_POOL_FREE_MAP_TEST_WIDTH];
+    fbe_u32_t disk_index[FBE_EXTENT_POOL_FREE_MAP_TEST_WIDTH];
+}
+fbe_extent_pool_free_map_test_slice_t;
+
+/* fbe_extent_pool_free_map_churn_test */
+char * fbe_extent_pool_free_map_churn_short_desc = "Churn allocate and release of the extent pool free map";
+char * fbe_extent_pool_free_map_churn_long_desc =
+    "Allocates and releases user slices at random on a pool of disks of mixed capacity.\n"
+    "Checks that no disk slice is handed out twice, that the slices of a user slice\n"
+    "are on different disks and that the pool can be filled after the churn.\n"
+    "Reports the cost of each operation and the spread of free slices across the disks.\n";
+
+/*!**************************************************************
+ * fbe_extent_pool_free_map_test_random()
+ ****************************************************************
+ * @brief
+ *  Repeatable random number, so a failing run can be reproduced.
+ *
+ * @param seed_p - Generator state.
+ *
+ * @return fbe_u32_t
+ *
+ ****************************************************************/
+static fbe_u32_t fbe_extent_pool_free_map_test_random(fbe_u32_t *seed_p)
+{
+    *seed_p = (*seed_p * 1103515245) + 12345;
+    return (*seed_p >> 16) & 0x7fff;
+}
+/******************************************
+ * end fbe_extent_pool_free_map_test_random()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_extent_pool_free_map_test_validate()
+ ****************************************************************
+ * @brief
+ *  Check the free count of the map against its disks and return
+ *  the spread of free slices between the disks.
+ *
+ * @param free_map_p - Free map under test.
+ * @param disk_info_p - Disks of the pool.
+ *
+ * @return fbe_slice_count_t - Most minus fewest free slices on a disk.
+ *
+ ****************************************************************/
+static fbe_slice_count_t fbe_extent_pool_free_map_test_validate(fbe_extent_pool_free_map_t *free_map_p,
+                                                                fbe_extent_pool_disk_info_t *disk_info_p)
+{
+    fbe_u32_t         disk_index;
+    fbe_slice_count_t free_slices = 0;
+    fbe_slice_count_t min_free = (fbe_slice_count_t)-1;
+    fbe_slice_count_t max_free = 0;
+
+    for (disk_index = 0; disk_index < FBE_EXTENT_POOL_FREE_MAP_TEST_DISKS; disk_index++) {
+        free_slices += disk_info_p[disk_index].free_slice_count;
+        if (disk_info_p[disk_index].free_slice_count < min_free) {
+            min_free = disk_info_p[disk_index].free_slice_count;
+        }
+        if (disk_info_p[disk_index].free_slice_count > max_free) {
+            max_free = disk_info_p[disk_index].free_slice_count;
+        }
+    }
+    MUT_ASSERT_UINT64_EQUAL(free_map_p->free_slices, free_slices);
+    MUT_ASSERT_INT_EQUAL(free_map_p->disk_count, FBE_EXTENT_POOL_FREE_MAP_TEST_DISKS);
+    return max_free - min_free;
+}
+/******************************************
+ * end fbe_extent_pool_free_map_test_validate()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_extent_pool_free_map_test_allocate()
+ ****************************************************************
+ * @brief
+ *  Allocate one user slice and mark its disk slices allocated the
+ *  way the map table does.
+ *
+ * @param free_map_p - Free map under test.
+ * @param disk_info_p - Disks of the pool.
+ * @param slice_p - Output user slice.
+ *
+ * @return fbe_status_t
+ *
+ ****************************************************************/
+static fbe_status_t fbe_extent_pool_free_map_test_allocate(fbe_extent_pool_free_map_t *free_map_p,
+                                                           fbe_extent_pool_disk_info_t *disk_info_p,
+                                                           fbe_extent_pool_free_map_test_slice_t *slice_p)
+{
+    fbe_status_t                  status;
+    fbe_u32_t                     index;
+    fbe_u32_t                     other;
+    fbe_extent_pool_disk_slice_t *disk_slice_p = NULL;
+    fbe_u8_t                      flags;
+
+    status = fbe_extent_pool_free_map_allocate(free_map_p, disk_info_p, FBE_EXTENT_POOL_FREE_MAP_TEST_WIDTH,
+                                               slice_p->disk_slice_p, slice_p->disk_index);
+    if (status != FBE_STATUS_OK) {
+        return status;
+    }
+    for (index = 0; index < FBE_EXTENT_POOL_FREE_MAP_TEST_WIDTH; index++) {
+        for (other = 0; other < index; other++) {
+            MUT_ASSERT_INT_NOT_EQUAL(slice_p->disk_index[index], slice_p->disk_index[other]);
+        }
+        disk_slice_p = slice_p->disk_slice_p[index];
+        flags = fbe_extent_pool_disk_slice_address_get_flags(disk_slice_p->disk_address);
+        MUT_ASSERT_INT_EQUAL(flags & FBE_DISK_SLICE_ADDRESS_FLAG_ALLOCATED, 0);
+        fbe_extent_pool_disk_slice_address_set(&disk_slice_p->disk_address,
+                                               fbe_extent_pool_disk_slice_address_get_lba(disk_slice_p->disk_address),
+                                               (fbe_u8_t)index,
+                                               FBE_DISK_SLICE_ADDRESS_FLAG_ALLOCATED);
+    }
+    return FBE_STATUS_OK;
+}
+/******************************************
+ * end fbe_extent_pool_free_map_test_allocate()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_extent_pool_free_map_test_release()
+ ****************************************************************
+ * @brief
+ *  Release all the disk slices of one user slice.
+ *
+ * @param free_map_p - Free map under test.
+ * @param disk_info_p - Disks of the pool.
+ * @param slice_p - User slice to release.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void fbe_extent_pool_free_map_test_release(fbe_extent_pool_free_map_t *free_map_p,
+                                                  fbe_extent_pool_disk_info_t *disk_info_p,
+                                                  fbe_extent_pool_free_map_test_slice_t *slice_p)
+{
+    fbe_status_t status;
+    fbe_u32_t    index;
+
+    for (index = 0; index < FBE_EXTENT_POOL_FREE_MAP_TEST_WIDTH; index++) {
+        status = fbe_extent_pool_free_map_release(free_map_p, disk_info_p,
+                                                  slice_p->disk_index[index], slice_p->disk_slice_p[index]);
+        MUT_ASSERT_INT_EQUAL(status, FBE_STATUS_OK);
+    }
+}
+/******************************************
+ * end fbe_extent_pool_free_map_test_release()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_extent_pool_free_map_churn_test()
+ ****************************************************************
+ * @brief
+ *  Build a pool of disks of mixed capacity, churn random allocates
+ *  and releases of user slices, then fill the pool.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void fbe_extent_pool_free_map_churn_test(void)
+{
+    fbe_status_t                           status;
+    fbe_extent_pool_disk_info_t            disk_info[FBE_EXTENT_POOL_FREE_MAP_TEST_DISKS];
+    fbe_extent_pool_free_map_t             free_map;
+    fbe_extent_pool_free_map_test_slice_t *slices_p = NULL;
+    fbe_u32_t                             *memory_p = NULL;
+    fbe_u32_t                              disk_index;
+    fbe_slice_index_t                      slice_index;
+    fbe_slice_count_t                      disk_slices;
+    fbe_slice_count_t                      total_slices = 0;
+    fbe_u32_t                              max_user_slices;
+    fbe_u32_t                              live_slices = 0;
+    fbe_u32_t                              iteration;
+    fbe_u32_t                              allocates = 0;
+    fbe_u32_t                              releases = 0;
+    fbe_u32_t                              failed = 0;
+    fbe_u32_t                              victim;
+    fbe_u32_t                              disks_with_free = 0;
+    fbe_u32_t                              seed = 0x1234;
+    fbe_slice_count_t                      spread;
+    fbe_slice_count_t                      max_spread = 0;
+    fbe_time_t                             start_time;
+    fbe_u32_t                              elapsed_us;
+
+    /* Every fourth disk is larger, so balancing has something to do.
+     */
+    fbe_zero_memory(&disk_info[0], sizeof(disk_info));
+    for (disk_index = 0; disk_index < FBE_EXTENT_POOL_FREE_MAP_TEST_DISKS; disk_index++) {
+        disk_slices = ((disk_index % 4) == 3) ? 600 : 400;
+        disk_info[disk_index].capacity = disk_slices * FBE_EXTENT_POOL_FREE_MAP_TEST_BLOCKS_PER_SLICE;
+        disk_info[disk_index].object_id = disk_index;
+        disk_info[disk_index].drive_map_table_p = malloc((size_t)(sizeof(fbe_extent_pool_disk_slice_t) * disk_slices));
+        MUT_ASSERT_NOT_NULL(disk_info[disk_index].drive_map_table_p);
+        for (slice_index = 0; slice_index < disk_slices; slice_index++) {
+            disk_info[disk_index].drive_map_table_p[slice_index].extent_address = 0;
+            fbe_extent_pool_disk_slice_address_set(&disk_info[disk_index].drive_map_table_p[slice_index].disk_address,
+                                                   slice_index * FBE_EXTENT_POOL_FREE_MAP_TEST_BLOCKS_PER_SLICE,
+                                                   0, FBE_DISK_SLICE_ADDRESS_FLAG_NONE);
+        }
+        total_slices += disk_slices;
+    }
+    max_user_slices = (fbe_u32_t)(total_slices / FBE_EXTENT_POOL_FREE_MAP_TEST_WIDTH);
+    slices_p = malloc(sizeof(fbe_extent_pool_free_map_test_slice_t) * max_user_slices);
+    MUT_ASSERT_NOT_NULL(slices_p);
+
+    memory_p = malloc(sizeof(fbe_u32_t) *
+                      fbe_extent_pool_free_map_get_memory_entries(&disk_info[0], FBE_EXTENT_POOL_FREE_MAP_TEST_DISKS,
+                                                                  FBE_EXTENT_POOL_FREE_MAP_TEST_BLOCKS_PER_SLICE));
+    MUT_ASSERT_NOT_NULL(memory_p);
+    status = fbe_extent_pool_free_map_init(&free_map, &disk_info[0], FBE_EXTENT_POOL_FREE_MAP_TEST_DISKS,
+                                           FBE_EXTENT_POOL_FREE_MAP_TEST_BLOCKS_PER_SLICE, memory_p);
+    MUT_ASSERT_INT_EQUAL(status, FBE_STATUS_OK);
+    MUT_ASSERT_UINT64_EQUAL(free_map.free_slices, total_slices);
+
+    /* A fresh pool hands out the start of the disks first.
+     */
+    status = fbe_extent_pool_free_map_test_allocate(&free_map, &disk_info[0], &slices_p[0]);
+    MUT_ASSERT_INT_EQUAL(status, FBE_STATUS_OK);
+    MUT_ASSERT_UINT64_EQUAL(fbe_extent_pool_disk_slice_address_get_lba(slices_p[0].disk_slice_p[0]->disk_address), 0);
+    live_slices = 1;
+
+    /* Releasing a slice that is not allocated must fail and change nothing.
+     */
+    fbe_extent_pool_free_map_test_release(&free_map, &disk_info[0], &slices_p[0]);
+    status = fbe_extent_pool_free_map_release(&free_map, &disk_info[0],
+                                              slices_p[0].disk_index[0], slices_p[0].disk_slice_p[0]);
+    MUT_ASSERT_INT_NOT_EQUAL(status, FBE_STATUS_OK);
+    MUT_ASSERT_UINT64_EQUAL(free_map.free_slices, total_slices);
+    live_slices = 0;
+
+    /* Churn, allocating two times out of three so the pool runs close to full.
+     */
+    mut_printf(MUT_LOG_TEST_STATUS, "free map churn: %d disks, %llu slices, width %d, %d operations",
+               FBE_EXTENT_POOL_FREE_MAP_TEST_DISKS, (unsigned long long)total_slices,
+               FBE_EXTENT_POOL_FREE_MAP_TEST_WIDTH, FBE_EXTENT_POOL_FREE_MAP_TEST_ITERATIONS);
+    start_time = fbe_get_time_in_us();
+    for (iteration = 0; iteration < FBE_EXTENT_POOL_FREE_MAP_TEST_ITERATIONS; iteration++) {
+        if ((live_slices == 0) ||
+            ((fbe_extent_pool_free_map_test_random(&seed) % 3) != 0)) {
+            status = fbe_extent_pool_free_map_test_allocate(&free_map, &disk_info[0], &slices_p[live_slices]);
+            if (status == FBE_STATUS_OK) {
+                live_slices++;
+                allocates++;
+                continue;
+            }
+            MUT_ASSERT_INT_EQUAL(status, FBE_STATUS_INSUFFICIENT_RESOURCES);
+            failed++;
+            if (live_slices == 0) {
+                continue;
+            }
+        }
+        victim = fbe_extent_pool_free_map_test_random(&seed) % live_slices;
+        fbe_extent_pool_free_map_test_release(&free_map, &disk_info[0], &slices_p[victim]);
+        live_slices--;
+        slices_p[victim] = slices_p[live_slices];
+        releases++;
+
+        if ((iteration % 1000) == 0) {
+            spread = fbe_extent_pool_free_map_test_validate(&free_map, &disk_info[0]);
+            if (spread > max_spread) {
+                max_spread = spread;
+            }
+        }
+    }
+    elapsed_us = fbe_get_elapsed_microseconds(start_time);
+
+    spread = fbe_extent_pool_free_map_test_validate(&free_map, &disk_info[0]);
+    mut_printf(MUT_LOG_TEST_STATUS, "free map churn: %u allocates, %u releases, %u out of space, %u live",
+               allocates, releases, failed, live_slices);
+    mut_printf(MUT_LOG_TEST_STATUS, "free map churn: %u usec, %u nsec per operation",
+               elapsed_us, (fbe_u32_t)(((fbe_u64_t)elapsed_us * 1000) / FBE_EXTENT_POOL_FREE_MAP_TEST_ITERATIONS));
+    mut_printf(MUT_LOG_TEST_STATUS, "free map churn: free slice spread per drive %llu now, %llu max",
+               (unsigned long long)spread, (unsigned long long)max_spread);
+    for (disk_index = 0; disk_index < FBE_EXTENT_POOL_FREE_MAP_TEST_DISKS; disk_index++) {
+        mut_printf(MUT_LOG_TEST_STATUS, "  disk %2u: %4llu free of %4llu",
+                   disk_index, (unsigned long long)disk_info[disk_index].free_slice_count,
+                   (unsigned long long)(disk_info[disk_index].capacity / FBE_EXTENT_POOL_FREE_MAP_TEST_BLOCKS_PER_SLICE));
+    }
+
+    /* Fill the pool.  Balancing should leave free slices on fewer than width disks.
+     */
+    while (fbe_extent_pool_free_map_test_allocate(&free_map, &disk_info[0], &slices_p[live_slices]) == FBE_STATUS_OK) {
+        live_slices++;
+        MUT_ASSERT_TRUE(live_slices <= max_user_slices);
+    }
+    fbe_extent_pool_free_map_test_validate(&free_map, &disk_info[0]);
+    for (disk_index = 0; disk_index < FBE_EXTENT_POOL_FREE_MAP_TEST_DISKS; disk_index++) {
+        if (disk_info[disk_index].free_slice_count != 0) {
+            disks_with_free++;
+        }
+    }
+    mut_printf(MUT_LOG_TEST_STATUS, "free map fill: %u user slices of %u, %llu disk slices left on %u disks",
+               live_slices, max_user_slices, (unsigned long long)free_map.free_slices, disks_with_free);
+    MUT_ASSERT_TRUE(disks_with_free < FBE_EXTENT_POOL_FREE_MAP_TEST_WIDTH);
+
+    /* Give everything back.
+     */
+    while (live_slices > 0) {
+        live_slices--;
+        fbe_extent_pool_free_map_test_release(&free_map, &disk_info[0], &slices_p[live_slices]);
+    }
+    fbe_extent_pool_free_map_test_validate(&free_map, &disk_info[0]);
+    MUT_ASSERT_UINT64_EQUAL(free_map.free_slices, total_slices);
+
+    for (disk_index = 0; disk_index < FBE_EXTENT_POOL_FREE_MAP_TEST_DISKS; disk_index++) {
+        free(disk_info[disk_index].drive_map_table_p);
+    }
+    free(slices_p);
+    free(memory_p);
+    return;
+}
+/******************************************
+ * end fbe_extent_pool_free_map_churn_test()
+ ******************************************/
+
+/*******************************
+ * end fbe_extent_pool_free_map_tests.c
+ *******************************/
@@ -0,0 +1,10 @@
+#ifndef FBE_EXTENT_POOL_TEST_H
+#define FBE_EXTENT_POOL_TEST_H
+
+#include "mut.h"
+
+extern char * fbe_extent_pool_free_map_churn_short_desc;
+extern char * fbe_extent_pool_free_map_churn_long_desc;
+void fbe_extent_pool_free_map_churn_test(void);
+
+#endif
@@ -0,0 +1,62 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2014
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!**************************************************************************
+ * @file fbe_extent_pool_test_main.c
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains the unit test for the extent pool.
+ * 
+ * @ingroup extent_pool_unit_test_files
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "fbe_extent_pool_private.h"
+#include "fbe_extent_pool_test.h"
+#include "fbe/fbe_emcutil_shell_include.h"
+
+/*!***************************************************************
+ * main()
+ ****************************************************************
+ * @brief
+ *  This function is the main routine for the test.  
+ *  Test suite is created here and tests are added to the suite.
+ *  Suite is then excuted.
+ *
+ * @param  - argc, argv.
+ *
+ * @return - None 
+ *
+ ****************************************************************/
+int __cdecl main (int argc , char **argv)
+{
+    mut_testsuite_t *extent_pool_test_suite;        /* pointer to testsuite structure */
+
+    #include "fbe/fbe_emcutil_shell_maincode.h"
+
+    mut_init(argc, argv);                           /* before proceeding we need to initialize MUT infrastructure */
+
+    extent_pool_test_suite = MUT_CREATE_TESTSUITE("extent_pool_test_suite")  /* testsuite is created */
+    MUT_ADD_TEST_WITH_DESCRIPTION(extent_pool_test_suite, 
+                                  fbe_extent_pool_free_map_churn_test, 
+                                  NULL,
+                                  NULL,
+                                  fbe_extent_pool_free_map_churn_short_desc, 
+                                  fbe_extent_pool_free_map_churn_long_desc)
+
+    MUT_RUN_TESTSUITE(extent_pool_test_suite)
+}
+/**************************************************************
+ * end main()
+ **************************************************************/
+
+/*******************************
+ * end fbe_extent_pool_test_main.c
+ *******************************/
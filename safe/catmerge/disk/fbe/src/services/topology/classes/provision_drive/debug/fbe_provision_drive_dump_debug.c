@@ -433,6 +433,7 @@ fbe_debug_field_info_t fbe_provision_drive_dump_field_info[] =
     FBE_DEBUG_DECLARE_FIELD_INFO("configured_physical_block_size", fbe_u32_t, FBE_FALSE, "0x%x"),
     FBE_DEBUG_DECLARE_FIELD_INFO("max_drive_xfer_limit", fbe_block_count_t, FBE_FALSE, "0x%x"),
     FBE_DEBUG_DECLARE_FIELD_INFO("last_checkpoint_time", fbe_time_t, FBE_FALSE, "0x%x"),
+    FBE_DEBUG_DECLARE_FIELD_INFO("verify_invalidate_blocks_since_peer_update", fbe_block_count_t, FBE_FALSE, "0x%x"),
     FBE_DEBUG_DECLARE_FIELD_INFO("zero_priority", fbe_traffic_priority_t, FBE_FALSE, "0x%x"),
     FBE_DEBUG_DECLARE_FIELD_INFO("verify_priority", fbe_traffic_priority_t, FBE_FALSE, "0x%x"),
     FBE_DEBUG_DECLARE_FIELD_INFO("verify_invalidate_priority", fbe_traffic_priority_t, FBE_FALSE, "0x%x"),
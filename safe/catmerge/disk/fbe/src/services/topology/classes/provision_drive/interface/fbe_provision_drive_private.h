@@ -489,6 +489,109 @@ typedef struct fbe_provision_drive_metadata_cache_s
     fbe_provision_drive_metadata_cache_slot_t bgz_slot;
 }fbe_provision_drive_metadata_cache_t;
 
+/*!****************************************************************************
+ * @enum fbe_provision_drive_zod_batch_constants_e
+ *
+ * @brief
+ *    Enum for zero on demand paged update batching constants.
+ ******************************************************************************/
+typedef enum fbe_provision_drive_zod_batch_constants_e
+{
+    FBE_PROVISION_DRIVE_ZOD_BATCH_MAX_SLOTS        = 8,
+    FBE_PROVISION_DRIVE_ZOD_BATCH_CHUNKS_PER_BLOCK = 64,    /* 512 bytes of 8 byte paged records */
+}fbe_provision_drive_zod_batch_constants_t;
+
+/*!****************************************************************************
+ * @struct fbe_provision_drive_zod_batch_slot_s
+ *
+ * @brief
+ *    One paged metadata block with a zero on demand paged update in flight.
+ *    Writes to the block that finish meanwhile wait on the slot and are
+ *    marked by the next update of the block.
+ ******************************************************************************/
+typedef struct fbe_provision_drive_zod_batch_slot_s
+{
+    fbe_bool_t          in_use;
+    fbe_chunk_index_t   block_index;        /*!< Paged block, chunk index / 64. */
+    fbe_u64_t           chunk_bitmap;       /*!< Chunks of the block the update marks. */
+    fbe_packet_t *      carrier_packet_p;   /*!< Packet the update is issued on. */
+    fbe_queue_head_t    active_queue;       /*!< Other packets covered by the update. */
+    fbe_queue_head_t    wait_queue;         /*!< Packets waiting for the next update. */
+}fbe_provision_drive_zod_batch_slot_t;
+
+/*!****************************************************************************
+ * @struct fbe_provision_drive_zod_batch_s
+ *
+ * @brief
+ *    Zero on demand paged update batching state of a provision drive.
+ ******************************************************************************/
+typedef struct fbe_provision_drive_zod_batch_s
+{
+    void *              batch_lock;
+
+    /*! Paged updates issued and requests that joined another request's update. */
+    fbe_u64_t           update_count;
+    fbe_u64_t           batched_count;
+
+    fbe_provision_drive_zod_batch_slot_t slots[FBE_PROVISION_DRIVE_ZOD_BATCH_MAX_SLOTS];
+}fbe_provision_drive_zod_batch_t;
+
+/*!****************************************************************************
+ * @enum fbe_provision_drive_sniff_pacing_constants_e
+ *
+ * @brief
+ *    Enum for sniff verify pacing constants.
+ ******************************************************************************/
+typedef enum fbe_provision_drive_sniff_pacing_constants_e
+{
+    FBE_PROVISION_DRIVE_SNIFF_BUSY_RESCHEDULE_MS     = 1000,  /* delay between verifies while host i/o is seen */
+    FBE_PROVISION_DRIVE_SNIFF_IDLE_THRESHOLD_MS      = 2000,  /* host quiet time before sniff speeds up */
+    FBE_PROVISION_DRIVE_SNIFF_HOT_REGION_MAX         = 8,
+    FBE_PROVISION_DRIVE_SNIFF_HOT_REGION_RADIUS      = 2,     /* chunks verified on each side of a media error */
+}fbe_provision_drive_sniff_pacing_constants_t;
+
+/*!****************************************************************************
+ * @struct fbe_provision_drive_sniff_hot_region_s
+ *
+ * @brief
+ *    Chunks around a recent media error that sniff verifies again ahead of
+ *    its checkpoint.
+ ******************************************************************************/
+typedef struct fbe_provision_drive_sniff_hot_region_s
+{
+    fbe_lba_t           next_lba;           /*!< Next chunk of the region to verify. */
+    fbe_chunk_count_t   chunks_remaining;
+}fbe_provision_drive_sniff_hot_region_t;
+
+/*!****************************************************************************
+ * @struct fbe_provision_drive_sniff_pacing_s
+ *
+ * @brief
+ *    Non-persistent sniff verify pacing state of a provision drive.  Sniff
+ *    runs at the default rate while host i/o arrives, speeds up while the
+ *    host is idle, and verifies hot regions before continuing linearly.
+ ******************************************************************************/
+typedef struct fbe_provision_drive_sniff_pacing_s
+{
+    void *              pacing_lock;
+
+    /*! Client i/os that arrived through the block transport server. */
+    FBE_ALIGN(16)fbe_atomic_t host_io_count;
+
+    fbe_atomic_t        last_host_io_count;     /*!< Count seen by the previous sniff cycle. */
+    fbe_time_t          last_host_io_time;      /*!< When sniff last saw host i/o. */
+    fbe_u32_t           reschedule_ms;          /*!< Current delay between verify i/os. */
+    fbe_u64_t           busy_cycles;            /*!< Cycles rescheduled at the busy delay. */
+    fbe_u64_t           idle_cycles;            /*!< Cycles rescheduled sooner because the host was idle. */
+
+    fbe_lba_t           hot_verify_lba;         /*!< Hot chunk the current cycle verifies. */
+    fbe_lba_t           hot_media_error_lba;    /*!< Hot verify error waiting for the remap event. */
+
+    fbe_u32_t           hot_region_head;
+    fbe_u32_t           hot_region_count;
+    fbe_provision_drive_sniff_hot_region_t hot_regions[FBE_PROVISION_DRIVE_SNIFF_HOT_REGION_MAX];
+}fbe_provision_drive_sniff_pacing_t;
+
 typedef struct fbe_provision_drive_unmap_bitmap_s
 {
     //void *              spin_lock;
@@ -541,6 +644,9 @@ typedef struct fbe_provision_drive_s
      */
     fbe_time_t last_checkpoint_time;
 
+    /*! Blocks the verify invalidate checkpoint moved since we last sent it to the peer. */
+    fbe_block_count_t verify_invalidate_blocks_since_peer_update;
+
     fbe_provision_drive_metadata_memory_t provision_drive_metadata_memory;
     fbe_provision_drive_metadata_memory_t provision_drive_metadata_memory_peer;
 
@@ -599,6 +705,8 @@ typedef struct fbe_provision_drive_s
 
     fbe_provision_drive_metadata_cache_t paged_metadata_cache;
     fbe_provision_drive_unmap_bitmap_t unmap_bitmap;
+    fbe_provision_drive_zod_batch_t zod_batch;
+    fbe_provision_drive_sniff_pacing_t sniff_pacing;
 
     /*! The time we gathered the last wear leveling data from this pvd */
     fbe_time_t  last_wear_leveling_time;
@@ -1637,6 +1745,7 @@ fbe_status_t fbe_provision_drive_usurper_get_ssd_statitics(fbe_provision_drive_t
 
 /* fbe_provision_drive_executor.c */
 fbe_status_t fbe_provision_drive_block_transport_entry(fbe_transport_entry_context_t context, fbe_packet_t * packet);
+fbe_status_t fbe_provision_drive_block_transport_client_entry(fbe_transport_entry_context_t context, fbe_packet_t * packet);
 
 fbe_raid_state_status_t fbe_provision_drive_block_transport_restart_io(fbe_raid_iots_t * iots_p);
 
@@ -1673,6 +1782,14 @@ fbe_status_t fbe_provision_drive_metadata_incr_background_zero_checkpoint(fbe_pr
                                                             fbe_packet_t * packet_p,
                                                             fbe_lba_t zero_checkpoint,
                                                             fbe_block_count_t  block_count);
+fbe_bool_t fbe_provision_drive_metadata_is_checkpoint_peer_update_due(fbe_provision_drive_t * provision_drive_p);
+void fbe_provision_drive_metadata_set_verify_invalidate_batch_enabled(fbe_bool_t b_enabled);
+fbe_status_t fbe_provision_drive_metadata_batch_checkpoint(fbe_provision_drive_t * provision_drive_p,
+                                                           fbe_packet_t * packet_p,
+                                                           fbe_bool_t b_update_peer,
+                                                           fbe_u64_t metadata_offset,
+                                                           fbe_lba_t checkpoint,
+                                                           fbe_block_count_t block_count);
 fbe_status_t fbe_provision_drive_metadata_update_background_zero_checkpoint(fbe_provision_drive_t * provision_drive_p, 
                                                             fbe_packet_t * packet_p,
                                                             fbe_lba_t zero_checkpoint);
@@ -1920,6 +2037,10 @@ void fbe_provision_drive_update_verify_report(fbe_provision_drive_t * in_provisi
 fbe_status_t
 fbe_provision_drive_ask_verify_permission( fbe_base_object_t* in_object_p,
                                            fbe_packet_t*      in_packet_p  );   
+fbe_status_t
+fbe_provision_drive_send_verify_permission_event(fbe_provision_drive_t* provision_drive_p,
+                                                 fbe_packet_t*          packet_p,
+                                                 fbe_lba_t              start_lba);
 //sends a single sniff verify i/o request to the provision drive's executor
 fbe_status_t
 fbe_provision_drive_start_next_verify_io(fbe_provision_drive_t* in_provision_drive_p,
@@ -2327,6 +2448,44 @@ fbe_status_t fbe_provision_drive_unmap_bitmap_callback_entry(fbe_metadata_paged_
 fbe_bool_t fbe_provision_drive_unmap_bitmap_is_lba_range_mapped(fbe_provision_drive_t * provision_drive_p, 
                                                                 fbe_lba_t lba, fbe_block_count_t block_count);
 
+/* fbe_provision_drive_zod_batch.c
+ */
+fbe_status_t fbe_provision_drive_zod_batch_init(fbe_provision_drive_t * provision_drive_p);
+void fbe_provision_drive_zod_batch_set_enabled(fbe_bool_t b_enabled);
+void fbe_provision_drive_zod_batch_get_info(fbe_provision_drive_t * provision_drive_p,
+                                            fbe_provision_drive_get_zod_batch_info_t * get_info_p);
+fbe_bool_t fbe_provision_drive_zod_batch_update_paged_metadata(fbe_provision_drive_t * provision_drive_p,
+                                                               fbe_packet_t * packet_p,
+                                                               fbe_chunk_index_t start_chunk_index,
+                                                               fbe_chunk_count_t chunk_count);
+
+/* fbe_provision_drive_sniff_pacing.c
+ */
+fbe_status_t fbe_provision_drive_sniff_pacing_init(fbe_provision_drive_t * provision_drive_p);
+fbe_u32_t fbe_provision_drive_sniff_pacing_get_reschedule_ms(fbe_provision_drive_t * provision_drive_p);
+void fbe_provision_drive_sniff_pacing_add_hot_region(fbe_provision_drive_t * provision_drive_p,
+                                                     fbe_lba_t media_error_lba);
+fbe_bool_t fbe_provision_drive_sniff_pacing_get_hot_lba(fbe_provision_drive_t * provision_drive_p,
+                                                        fbe_lba_t * hot_lba_p);
+fbe_bool_t fbe_provision_drive_sniff_pacing_get_hot_media_error_lba(fbe_provision_drive_t * provision_drive_p,
+                                                                    fbe_lba_t * media_error_lba_p);
+fbe_status_t fbe_provision_drive_sniff_pacing_start_hot_verify_io(fbe_provision_drive_t * provision_drive_p,
+                                                                  fbe_packet_t * packet_p,
+                                                                  fbe_lba_t hot_lba);
+fbe_status_t fbe_provision_drive_sniff_pacing_remap_completion(fbe_event_t * event_p,
+                                                               fbe_event_completion_context_t context);
+
+/*!****************************************************************************
+ * @fn fbe_provision_drive_sniff_pacing_note_host_io()
+ ******************************************************************************
+ * @brief
+ *  Count a client i/o so that sniff can tell the host is not idle.
+ ******************************************************************************/
+static __forceinline void
+fbe_provision_drive_sniff_pacing_note_host_io(fbe_provision_drive_t * provision_drive_p)
+{
+    fbe_atomic_increment(&provision_drive_p->sniff_pacing.host_io_count);
+}
 
 fbe_bool_t fbe_provision_drive_is_location_valid(fbe_provision_drive_t *provision_drive_p);
 
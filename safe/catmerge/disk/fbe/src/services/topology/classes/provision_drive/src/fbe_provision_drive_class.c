@@ -62,6 +62,8 @@ static fbe_status_t fbe_provision_drive_get_dword_from_registry(fbe_u32_t *flag_
                                                                 fbe_u8_t* key_p,
                                                                 fbe_u32_t default_input_value);
 static fbe_status_t fbe_provision_drive_usurper_set_wear_leveling_timer(fbe_packet_t * packet_p);
+static fbe_status_t fbe_provision_drive_usurper_set_zod_batch_enabled(fbe_packet_t * packet_p);
+static fbe_status_t fbe_provision_drive_usurper_set_verify_invalidate_batch_enabled(fbe_packet_t * packet_p);
 
 /*!***************************************************************
  * fbe_provision_drive_class_is_max_drive_blocks_configured()
@@ -173,6 +175,14 @@ fbe_provision_drive_class_control_entry(fbe_packet_t * packet)
             status = fbe_provision_drive_usurper_set_wear_leveling_timer(packet); 
             break;
 
+        case FBE_PROVISION_DRIVE_CONTROL_CODE_SET_CLASS_ZOD_BATCH_ENABLED:
+            status = fbe_provision_drive_usurper_set_zod_batch_enabled(packet); 
+            break;
+
+        case FBE_PROVISION_DRIVE_CONTROL_CODE_SET_CLASS_VERIFY_INVALIDATE_BATCH_ENABLED:
+            status = fbe_provision_drive_usurper_set_verify_invalidate_batch_enabled(packet); 
+            break;
+
         default:
             fbe_transport_set_status(packet, FBE_STATUS_GENERIC_FAILURE, 0);
             status = fbe_transport_complete_packet(packet);
@@ -1285,6 +1295,116 @@ static fbe_status_t fbe_provision_drive_usurper_set_wear_leveling_timer(fbe_pack
  * end fbe_provision_drive_usurper_set_wear_leveling_timer()
  ******************************************/
 
+/*!**************************************************************
+ * fbe_provision_drive_usurper_set_zod_batch_enabled()
+ ****************************************************************
+ * @brief
+ *  Enable or disable batching of the zero on demand paged
+ *  updates for all provision drives.
+ *
+ * @param   packet_p - Pointer to the packet
+ *
+ * @return  status   
+ *
+ ****************************************************************/
+static fbe_status_t fbe_provision_drive_usurper_set_zod_batch_enabled(fbe_packet_t * packet_p)
+{
+    fbe_status_t                        status = FBE_STATUS_OK;
+    fbe_payload_ex_t                   *payload = NULL;
+    fbe_payload_control_operation_t    *control_operation = NULL;
+    fbe_payload_control_buffer_length_t length;
+    fbe_bool_t                         *b_enabled_p = NULL;
+
+    payload = fbe_transport_get_payload_ex(packet_p);
+    control_operation = fbe_payload_ex_get_control_operation(payload);
+
+    fbe_payload_control_get_buffer(control_operation, &b_enabled_p);
+    if (b_enabled_p == NULL) {
+        fbe_base_config_class_trace(FBE_TRACE_LEVEL_INFO, FBE_TRACE_MESSAGE_ID_INFO,
+                                    "%s fbe_payload_control_get_buffer failed\n", __FUNCTION__);
+        fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
+        fbe_transport_set_status(packet_p, FBE_STATUS_GENERIC_FAILURE, 0);
+        fbe_transport_complete_packet(packet_p);
+
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    fbe_payload_control_get_buffer_length (control_operation, &length);
+    if(length != sizeof(fbe_bool_t)) {
+        fbe_base_config_class_trace(FBE_TRACE_LEVEL_INFO, FBE_TRACE_MESSAGE_ID_INFO,
+                                    "%s fbe_payload_control_get_buffer length failed\n", __FUNCTION__);
+        fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
+        fbe_transport_set_status(packet_p, FBE_STATUS_GENERIC_FAILURE, 0);
+        fbe_transport_complete_packet(packet_p);
+
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    fbe_provision_drive_zod_batch_set_enabled(*b_enabled_p);
+
+    fbe_transport_set_status(packet_p, status, 0);
+    fbe_transport_complete_packet(packet_p);
+    return status;
+}
+/******************************************
+ * end fbe_provision_drive_usurper_set_zod_batch_enabled()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_provision_drive_usurper_set_verify_invalidate_batch_enabled()
+ ****************************************************************
+ * @brief
+ *  Enable or disable batching of the verify invalidate
+ *  checkpoint peer updates for all provision drives.
+ *
+ * @param   packet_p - Pointer to the packet
+ *
+ * @return  status   
+ *
+ ****************************************************************/
+static fbe_status_t fbe_provision_drive_usurper_set_verify_invalidate_batch_enabled(fbe_packet_t * packet_p)
+{
+    fbe_status_t                        status = FBE_STATUS_OK;
+    fbe_payload_ex_t                   *payload = NULL;
+    fbe_payload_control_operation_t    *control_operation = NULL;
+    fbe_payload_control_buffer_length_t length;
+    fbe_bool_t                         *b_enabled_p = NULL;
+
+    payload = fbe_transport_get_payload_ex(packet_p);
+    control_operation = fbe_payload_ex_get_control_operation(payload);
+
+    fbe_payload_control_get_buffer(control_operation, &b_enabled_p);
+    if (b_enabled_p == NULL) {
+        fbe_base_config_class_trace(FBE_TRACE_LEVEL_INFO, FBE_TRACE_MESSAGE_ID_INFO,
+                                    "%s fbe_payload_control_get_buffer failed\n", __FUNCTION__);
+        fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
+        fbe_transport_set_status(packet_p, FBE_STATUS_GENERIC_FAILURE, 0);
+        fbe_transport_complete_packet(packet_p);
+
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    fbe_payload_control_get_buffer_length (control_operation, &length);
+    if(length != sizeof(fbe_bool_t)) {
+        fbe_base_config_class_trace(FBE_TRACE_LEVEL_INFO, FBE_TRACE_MESSAGE_ID_INFO,
+                                    "%s fbe_payload_control_get_buffer length failed\n", __FUNCTION__);
+        fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
+        fbe_transport_set_status(packet_p, FBE_STATUS_GENERIC_FAILURE, 0);
+        fbe_transport_complete_packet(packet_p);
+
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    fbe_provision_drive_metadata_set_verify_invalidate_batch_enabled(*b_enabled_p);
+
+    fbe_transport_set_status(packet_p, status, 0);
+    fbe_transport_complete_packet(packet_p);
+    return status;
+}
+/******************************************
+ * end fbe_provision_drive_usurper_set_verify_invalidate_batch_enabled()
+ ******************************************/
+
 /*!***************************************************************************
  *          fbe_provision_drive_class_get_warranty_period()
  *****************************************************************************
@@ -141,6 +141,32 @@ fbe_provision_drive_block_transport_entry(fbe_transport_entry_context_t context,
     return status;
 }
 
+/*!****************************************************************************
+ * @fn fbe_provision_drive_block_transport_client_entry()
+ ******************************************************************************
+ * @brief
+ *   This is the entry function that the block transport server will call to
+ *   pass a client packet to the provision drive object.  The packet is
+ *   counted as host i/o for sniff pacing.  Monitor i/o does not come through
+ *   here, it calls fbe_provision_drive_block_transport_entry() directly.
+ *  
+ * @param context       - Pointer to the provision drive object. 
+ * @param packet      - The packet to process.
+ * 
+ * @return fbe_status_t
+ *
+ ******************************************************************************/
+fbe_status_t
+fbe_provision_drive_block_transport_client_entry(fbe_transport_entry_context_t context, fbe_packet_t * packet)
+{
+    fbe_provision_drive_sniff_pacing_note_host_io((fbe_provision_drive_t *)context);
+
+    return fbe_provision_drive_block_transport_entry(context, packet);
+}
+/******************************************************************************
+ * end fbe_provision_drive_block_transport_client_entry()
+ ******************************************************************************/
+
 /*!****************************************************************************
  * fbe_provision_drive_block_transport_restart_io()
  ******************************************************************************
@@ -1172,6 +1198,7 @@ void fbe_provision_drive_rba_trace(fbe_provision_drive_t * provision_drive,
         fbe_provision_drive_nonpaged_metadata_drive_info_t nonpaged_drive_info;
         fbe_u64_t fru;
         fbe_u32_t op;
+        fbe_object_id_t object_id;
 
         /* get port, enclosure and slot information and encode:
          * fru = 2 byte port | 2 byte enclosure | 2 byte slot 
@@ -1198,7 +1225,13 @@ void fbe_provision_drive_rba_trace(fbe_provision_drive_t * provision_drive,
                 op = KT_TRAFFIC_NO_OP;
         }
 
-        if (op != KT_TRAFFIC_NO_OP)
+        /* A filter of the pvd class may drop the record or save it in binary.
+         */
+        fbe_base_object_get_object_id((fbe_base_object_t *)provision_drive, &object_id);
+        if ((op != KT_TRAFFIC_NO_OP) &&
+            fbe_traffic_trace_filter_record(FBE_TRAFFIC_TRACE_CLASS_PVD, object_id,
+                                            block_operation_p->lba, block_operation_p->block_count,
+                                            (fbe_u16_t)op, fru))
         {
             KTRACEX(TRC_K_TRAFFIC,
                     KT_FBE_PVD_TRAFFIC,
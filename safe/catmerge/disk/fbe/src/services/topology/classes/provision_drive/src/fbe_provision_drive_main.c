@@ -51,7 +51,7 @@ fbe_class_methods_t fbe_provision_drive_class_methods = {FBE_CLASS_ID_PROVISION_
                                                          fbe_provision_drive_io_entry,
                                                          fbe_provision_drive_monitor_entry};
 
-fbe_block_transport_const_t fbe_provision_drive_block_transport_const = {fbe_provision_drive_block_transport_entry,
+fbe_block_transport_const_t fbe_provision_drive_block_transport_const = {fbe_provision_drive_block_transport_client_entry,
 																		 fbe_base_config_process_block_transport_event,
 																		 fbe_provision_drive_io_entry,
                                                                          NULL, NULL};
@@ -309,6 +309,7 @@ fbe_provision_drive_init(fbe_provision_drive_t * const provision_drive_p)
 
 	fbe_provision_drive_set_priorities(provision_drive_p, set_priorities);
     fbe_provision_drive_update_last_checkpoint_time(provision_drive_p);
+    provision_drive_p->verify_invalidate_blocks_since_peer_update = 0;
 	provision_drive_p->monitor_counter = 0;
 
 	provision_drive_p->last_zero_percent_notification = 0;
@@ -329,6 +330,12 @@ fbe_provision_drive_init(fbe_provision_drive_t * const provision_drive_p)
     /* Initialize unmap bitmap */
     fbe_zero_memory(&provision_drive_p->unmap_bitmap, sizeof(fbe_provision_drive_unmap_bitmap_t));
 
+    /* Initialize zero on demand paged update batching */
+    fbe_provision_drive_zod_batch_init(provision_drive_p);
+
+    /* Initialize sniff verify pacing */
+    fbe_provision_drive_sniff_pacing_init(provision_drive_p);
+
     return FBE_STATUS_OK;
 }
 /* end fbe_provision_drive_init() */
@@ -31,6 +31,12 @@
 #include "fbe/fbe_physical_drive.h"
 #include "fbe/fbe_event_log_utils.h"               /*  for message codes */
 
+/*! @var fbe_provision_drive_verify_invalidate_batch_enabled
+ *  @brief FBE_TRUE to only send the verify invalidate checkpoint to the peer
+ *         once it has moved FBE_BASE_CONFIG_PEER_CHECKPOINT_UPDATE_BLOCKS.
+ */
+static fbe_bool_t fbe_provision_drive_verify_invalidate_batch_enabled = FBE_TRUE;
+
 /*************************
  *   FORWARD DECLARATIONS
  *************************/
@@ -1673,8 +1679,7 @@ fbe_provision_drive_metadata_incr_background_zero_checkpoint(fbe_provision_drive
 {
     fbe_status_t    status;
     fbe_lba_t       exported_capacity = FBE_LBA_INVALID;
-    fbe_u32_t ms_since_checkpoint;
-    fbe_time_t last_checkpoint_time;
+    fbe_bool_t      b_update_peer;
 
     /* get the paged metadatas start lba. */
     fbe_base_config_get_capacity((fbe_base_config_t *) provision_drive_p, &exported_capacity);
@@ -1695,41 +1700,23 @@ fbe_provision_drive_metadata_incr_background_zero_checkpoint(fbe_provision_drive
                   (unsigned long long)block_count);        
     }
 
-    fbe_provision_drive_get_last_checkpoint_time(provision_drive_p, &last_checkpoint_time);
-    ms_since_checkpoint = fbe_get_elapsed_milliseconds(last_checkpoint_time);
-
-
-    if ((ms_since_checkpoint > FBE_PROVISION_DRIVE_PEER_CHECKPOINT_UPDATE_MS) && 
-        /* Update peer only when we actually wrote to paged MD */
-        !fbe_provision_drive_metadata_cache_is_flush_valid(provision_drive_p))
+    /* Periodically we will set the checkpoint to the peer.  Otherwise update the checkpoint 
+     * locally only and do not send it to the peer to avoid thrashing the CMI. 
+     */
+    b_update_peer = (fbe_provision_drive_metadata_is_checkpoint_peer_update_due(provision_drive_p) && 
+                     /* Update peer only when we actually wrote to paged MD */
+                     !fbe_provision_drive_metadata_cache_is_flush_valid(provision_drive_p));
+    status = fbe_provision_drive_metadata_batch_checkpoint(provision_drive_p, packet_p, b_update_peer,
+                                                           (fbe_u64_t)(&((fbe_provision_drive_nonpaged_metadata_t*)0)->zero_checkpoint),
+                                                           zero_checkpoint,
+                                                           block_count);
+    if (b_update_peer)
     {
-        /* Periodically we will set the checkpoint to the peer. 
-         * A set is needed since the peer might be out of date with us and an increment 
-         * will not suffice. 
-         */
-        status = fbe_base_config_metadata_nonpaged_force_set_checkpoint((fbe_base_config_t *) provision_drive_p,
-                                                                        packet_p,
-                                                                        (fbe_u64_t)(&((fbe_provision_drive_nonpaged_metadata_t*)0)->zero_checkpoint),
-                                                                        0,    /* Second metadata offset is not used for pvd*/
-                                                                        zero_checkpoint + block_count);
-        fbe_provision_drive_update_last_checkpoint_time(provision_drive_p);
         /* Also send notification upstream about our checkpoint.  Admin needs this in order to see the checkpoint
          * change. 
          */
         fbe_provision_drive_send_checkpoint_notification(provision_drive_p);
     }
-    else
-    {
-        /* Otherwise update the checkpoint locally only and do not send it to the peer to avoid 
-         * thrashing the CMI. 
-         */
-        status = fbe_base_config_metadata_nonpaged_incr_checkpoint_no_peer((fbe_base_config_t *) provision_drive_p,
-                                                                   packet_p,
-                                                                   (fbe_u64_t)(&((fbe_provision_drive_nonpaged_metadata_t*)0)->zero_checkpoint),
-                                                                   0,    /* Second metadata offset is not used for pvd*/
-                                                                   zero_checkpoint,
-                                                                   block_count);
-    }
     return FBE_STATUS_MORE_PROCESSING_REQUIRED;
 }
 /******************************************************************************
@@ -1761,6 +1748,7 @@ fbe_provision_drive_metadata_incr_verify_invalidate_checkpoint(fbe_provision_dri
 {
     fbe_status_t    status;
     fbe_lba_t       exported_capacity = FBE_LBA_INVALID;
+    fbe_bool_t      b_update_peer;
 
     /* get the paged metadatas start lba. */
     fbe_base_config_get_capacity((fbe_base_config_t *) provision_drive_p, &exported_capacity);
@@ -1779,20 +1767,118 @@ fbe_provision_drive_metadata_incr_verify_invalidate_checkpoint(fbe_provision_dri
                               (unsigned long long)invalidate_checkpoint, (unsigned long long)exported_capacity, (unsigned long long)block_count);        
     }
 
-    
-    /* The called function will take care of error and complete the packet */
-    status = fbe_base_config_metadata_nonpaged_incr_checkpoint((fbe_base_config_t *) provision_drive_p,
+    /* Only send the checkpoint to the peer once it has moved far enough since the last
+     * time we sent it, and when we reach the end.  With batching disabled every increment
+     * goes to the peer.  The called function will take care of error and complete the packet.
+     */
+    provision_drive_p->verify_invalidate_blocks_since_peer_update += block_count;
+    b_update_peer = (!fbe_provision_drive_verify_invalidate_batch_enabled ||
+                     fbe_base_config_checkpoint_is_peer_update_due(provision_drive_p->verify_invalidate_blocks_since_peer_update) ||
+                     ((invalidate_checkpoint + block_count) >= exported_capacity));
+    if (b_update_peer)
+    {
+        provision_drive_p->verify_invalidate_blocks_since_peer_update = 0;
+    }
+    status = fbe_base_config_metadata_nonpaged_batch_checkpoint((fbe_base_config_t *) provision_drive_p,
                                                                 packet_p,
-                                                               (fbe_u64_t)(&((fbe_provision_drive_nonpaged_metadata_t*)0)->verify_invalidate_checkpoint),
-                                                                0, /* Second metadata offset is not used for pvd*/
-                                                               invalidate_checkpoint,
-                                                               block_count);
+                                                                b_update_peer,
+                                                                (fbe_u64_t)(&((fbe_provision_drive_nonpaged_metadata_t*)0)->verify_invalidate_checkpoint),
+                                                                0,    /* Second metadata offset is not used for pvd*/
+                                                                invalidate_checkpoint,
+                                                                block_count);
     return FBE_STATUS_MORE_PROCESSING_REQUIRED;
 }
 /******************************************************************************
  * end fbe_provision_drive_metadata_incr_verify_invalidate_checkpoint()
  ******************************************************************************/
 
+/*!****************************************************************************
+ * fbe_provision_drive_metadata_set_verify_invalidate_batch_enabled()
+ ******************************************************************************
+ * @brief
+ *   Enable or disable batching of the verify invalidate checkpoint peer
+ *   updates for all provision drives.  While disabled every increment of
+ *   the checkpoint is sent to the peer.
+ *
+ * @param b_enabled                 - FBE_TRUE to batch peer updates.
+ *
+ * @return  None.
+ *
+ ******************************************************************************/
+void 
+fbe_provision_drive_metadata_set_verify_invalidate_batch_enabled(fbe_bool_t b_enabled)
+{
+    fbe_provision_drive_verify_invalidate_batch_enabled = b_enabled;
+}
+/******************************************************************************
+ * end fbe_provision_drive_metadata_set_verify_invalidate_batch_enabled()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * fbe_provision_drive_metadata_is_checkpoint_peer_update_due()
+ ******************************************************************************
+ * @brief
+ *   Determine if a background operation that batches its checkpoint by time
+ *   should also send the checkpoint to the peer.
+ *
+ * @param provision_drive_p         - pointer to the provision drive
+ *
+ * @return  fbe_bool_t - FBE_TRUE if the peer update interval has passed.
+ *
+ ******************************************************************************/
+fbe_bool_t 
+fbe_provision_drive_metadata_is_checkpoint_peer_update_due(fbe_provision_drive_t * provision_drive_p)
+{
+    fbe_time_t last_checkpoint_time;
+
+    fbe_provision_drive_get_last_checkpoint_time(provision_drive_p, &last_checkpoint_time);
+    return (fbe_get_elapsed_milliseconds(last_checkpoint_time) > FBE_PROVISION_DRIVE_PEER_CHECKPOINT_UPDATE_MS);
+}
+/******************************************************************************
+ * end fbe_provision_drive_metadata_is_checkpoint_peer_update_due()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * fbe_provision_drive_metadata_batch_checkpoint()
+ ******************************************************************************
+ * @brief
+ *   Move a background operation checkpoint forward by block_count.  When
+ *   the peer is updated we also restart the peer update interval.
+ *
+ * @param provision_drive_p         - pointer to the provision drive
+ * @param packet_p                  - pointer to a monitor packet.
+ * @param b_update_peer             - FBE_TRUE to also send the checkpoint to the peer.
+ * @param metadata_offset           - offset of the checkpoint in the nonpaged.
+ * @param checkpoint                - current checkpoint.
+ * @param block_count               - block count to increment the checkpoint by
+ *
+ * @return  fbe_status_t  
+ *
+ ******************************************************************************/
+fbe_status_t 
+fbe_provision_drive_metadata_batch_checkpoint(fbe_provision_drive_t * provision_drive_p,
+                                              fbe_packet_t * packet_p,
+                                              fbe_bool_t b_update_peer,
+                                              fbe_u64_t metadata_offset,
+                                              fbe_lba_t checkpoint,
+                                              fbe_block_count_t block_count)
+{
+    if (b_update_peer)
+    {
+        fbe_provision_drive_update_last_checkpoint_time(provision_drive_p);
+    }
+    return fbe_base_config_metadata_nonpaged_batch_checkpoint((fbe_base_config_t *) provision_drive_p,
+                                                              packet_p,
+                                                              b_update_peer,
+                                                              metadata_offset,
+                                                              0,    /* Second metadata offset is not used for pvd*/
+                                                              checkpoint,
+                                                              block_count);
+}
+/******************************************************************************
+ * end fbe_provision_drive_metadata_batch_checkpoint()
+ ******************************************************************************/
+
 /*!****************************************************************************
  * fbe_provision_drive_metadata_get_zero_on_demand_flag()
  ******************************************************************************
@@ -3424,6 +3424,9 @@ fbe_lifecycle_status_t fbe_provision_drive_run_verify(fbe_base_object_t*  object
     fbe_lba_t               start_lba = 0;          // starting lba - checkpoint
     fbe_lba_t               paged_metadata_start_lba;
     fbe_bool_t              is_event_outstanding;
+    fbe_lba_t               media_error_lba;
+    fbe_lba_t               hot_lba;
+    fbe_status_t            status;
 
 
     // trace function entry
@@ -3449,11 +3452,36 @@ fbe_lifecycle_status_t fbe_provision_drive_run_verify(fbe_base_object_t*  object
         return FBE_LIFECYCLE_STATUS_DONE;
     }
 
+    /* A hot region verify found a media error, have the upstream object mark the chunk for verify.
+     */
+    if (fbe_provision_drive_sniff_pacing_get_hot_media_error_lba(provision_drive_p, &media_error_lba))
+    {
+        status = fbe_provision_drive_ask_remap_action(provision_drive_p,
+                                                      packet_p,
+                                                      media_error_lba,
+                                                      1,
+                                                      fbe_provision_drive_sniff_pacing_remap_completion);
+
+        /* If the status is not ok, that means the called function completed the packet */
+        return (status != FBE_STATUS_OK) ? FBE_LIFECYCLE_STATUS_PENDING : FBE_LIFECYCLE_STATUS_DONE;
+    }
+
      // set completion function
     fbe_transport_set_completion_function( packet_p,
                                            fbe_provision_drive_run_verify_completion,
                                            provision_drive_p);
 
+    /* Verify the chunks around recent media errors before continuing from the checkpoint.  Not
+     * while a media error found at the checkpoint still waits for its remap.
+     */
+    fbe_provision_drive_metadata_get_sniff_media_error_lba( provision_drive_p, &media_error_lba );
+    if ((media_error_lba == FBE_LBA_INVALID) &&
+        fbe_provision_drive_sniff_pacing_get_hot_lba(provision_drive_p, &hot_lba))
+    {
+        fbe_provision_drive_send_verify_permission_event(provision_drive_p, packet_p, hot_lba);
+        return FBE_LIFECYCLE_STATUS_PENDING;
+    }
+
     // get starting lba for next verify i/o
     fbe_provision_drive_metadata_get_sniff_verify_checkpoint( provision_drive_p, &start_lba );
 
@@ -3522,6 +3550,9 @@ fbe_provision_drive_run_verify_completion(
     // get verify i/o completion status
     status = fbe_transport_get_status_code( packet_p );
 
+    // the hot chunk of this cycle, if any, is done with
+    provision_drive_p->sniff_pacing.hot_verify_lba = FBE_LBA_INVALID;
+
     if ( status == FBE_STATUS_OK )
     {
 #if 0 
@@ -3539,10 +3570,10 @@ fbe_provision_drive_run_verify_completion(
             return FBE_STATUS_OK;
         }
 #endif 
-        // reschedule to continue verify of this disk
+        // reschedule to continue verify of this disk, sooner while the host is idle
         fbe_lifecycle_reschedule( &fbe_provision_drive_lifecycle_const,
                                   (fbe_base_object_t*)provision_drive_p,
-                                  (fbe_lifecycle_timer_msec_t) 1000
+                                  (fbe_lifecycle_timer_msec_t) fbe_provision_drive_sniff_pacing_get_reschedule_ms(provision_drive_p)
                                 );
     }
 
@@ -0,0 +1,666 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2009-2014
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!**************************************************************************
+ * @file fbe_provision_drive_sniff_pacing.c
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains the pacing and ordering of sniff verify i/os.
+ *
+ *  Sniff verifies one chunk per monitor cycle.  While host i/o arrives the
+ *  monitor is rescheduled after the default delay.  Once the host has been
+ *  quiet for a while the delay is halved every cycle down to a floor that
+ *  depends on the drive type, and it goes back to the default delay as soon
+ *  as host i/o is seen again.
+ *
+ *  Media errors tend to cluster, so the chunks around a media error found by
+ *  sniff at its checkpoint are queued as a hot region.  Hot regions are
+ *  verified before sniff continues from its checkpoint, without moving the
+ *  checkpoint.  A media error found in a hot region is reported upstream
+ *  with a remap event so that RAID marks the chunk for verify, but it does
+ *  not queue another region, so hot verifies can not keep the checkpoint
+ *  from advancing.
+ *
+ * @ingroup provision_drive_class_files
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "fbe_provision_drive_private.h"
+#include "fbe/fbe_physical_drive.h"
+
+/*************************
+ *   FORWARD DECLARATIONS
+ *************************/
+static fbe_status_t fbe_provision_drive_sniff_pacing_hot_verify_io_completion(fbe_packet_t * packet_p,
+                                                                              fbe_packet_completion_context_t context);
+
+
+/*!****************************************************************************
+ * @fn fbe_provision_drive_sniff_pacing_lock()
+ ******************************************************************************
+ * @brief
+ *  This function is to lock the sniff pacing state.
+ *
+ * @param provision_drive_p     - Provision drive object.
+ *
+ * @return None.
+ *
+ ******************************************************************************/
+static __forceinline void
+fbe_provision_drive_sniff_pacing_lock(fbe_provision_drive_t * provision_drive_p)
+{
+    csx_p_spin_pointer_lock(&provision_drive_p->sniff_pacing.pacing_lock);
+}
+/******************************************************************************
+ * end fbe_provision_drive_sniff_pacing_lock()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * @fn fbe_provision_drive_sniff_pacing_unlock()
+ ******************************************************************************
+ * @brief
+ *  This function is to unlock the sniff pacing state.
+ *
+ * @param provision_drive_p     - Provision drive object.
+ *
+ * @return None.
+ *
+ ******************************************************************************/
+static __forceinline void
+fbe_provision_drive_sniff_pacing_unlock(fbe_provision_drive_t * provision_drive_p)
+{
+    csx_p_spin_pointer_unlock(&provision_drive_p->sniff_pacing.pacing_lock);
+}
+/******************************************************************************
+ * end fbe_provision_drive_sniff_pacing_unlock()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * @fn fbe_provision_drive_sniff_pacing_init()
+ ******************************************************************************
+ * @brief
+ *  This function is used to initialize the sniff pacing state.
+ *
+ * @param provision_drive_p             - Provision drive object.
+ *
+ * @return fbe_status_t                 - status of the operation.
+ *
+ ******************************************************************************/
+fbe_status_t
+fbe_provision_drive_sniff_pacing_init(fbe_provision_drive_t * provision_drive_p)
+{
+    fbe_provision_drive_sniff_pacing_t *pacing_p = &provision_drive_p->sniff_pacing;
+
+    fbe_zero_memory(pacing_p, sizeof(fbe_provision_drive_sniff_pacing_t));
+    pacing_p->pacing_lock = pacing_p;
+    pacing_p->last_host_io_time = fbe_get_time();
+    pacing_p->reschedule_ms = FBE_PROVISION_DRIVE_SNIFF_BUSY_RESCHEDULE_MS;
+    pacing_p->hot_verify_lba = FBE_LBA_INVALID;
+    pacing_p->hot_media_error_lba = FBE_LBA_INVALID;
+
+    return FBE_STATUS_OK;
+}
+/******************************************************************************
+ * end fbe_provision_drive_sniff_pacing_init()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * @fn fbe_provision_drive_sniff_pacing_get_idle_reschedule_ms()
+ ******************************************************************************
+ * @brief
+ *  This function returns the shortest delay between sniff verifies of an idle
+ *  drive.  High capacity drives take the longest to sniff and so go fastest,
+ *  flash drives do not gain much from sniffing and so go slowest.
+ *
+ * @param provision_drive_p     - Provision drive object.
+ *
+ * @return fbe_u32_t            - Delay in milliseconds.
+ *
+ ******************************************************************************/
+static fbe_u32_t
+fbe_provision_drive_sniff_pacing_get_idle_reschedule_ms(fbe_provision_drive_t * provision_drive_p)
+{
+    fbe_provision_drive_nonpaged_metadata_drive_info_t drive_info;
+    fbe_status_t status;
+
+    status = fbe_provision_drive_metadata_get_nonpaged_metadata_drive_info(provision_drive_p, &drive_info);
+    if (status != FBE_STATUS_OK)
+    {
+        return FBE_PROVISION_DRIVE_SNIFF_BUSY_RESCHEDULE_MS;
+    }
+
+    switch (drive_info.drive_type)
+    {
+        case FBE_DRIVE_TYPE_SAS_NL:
+        case FBE_DRIVE_TYPE_SATA:
+        case FBE_DRIVE_TYPE_SATA_PADDLECARD:
+            return 10;
+
+        case FBE_DRIVE_TYPE_FIBRE:
+        case FBE_DRIVE_TYPE_SAS:
+        case FBE_DRIVE_TYPE_SAS_SED:
+            return 50;
+
+        case FBE_DRIVE_TYPE_SAS_FLASH_HE:
+        case FBE_DRIVE_TYPE_SATA_FLASH_HE:
+        case FBE_DRIVE_TYPE_SAS_FLASH_ME:
+        case FBE_DRIVE_TYPE_SAS_FLASH_LE:
+        case FBE_DRIVE_TYPE_SAS_FLASH_RI:
+            return 200;
+
+        default:
+            return 100;
+    }
+}
+/******************************************************************************
+ * end fbe_provision_drive_sniff_pacing_get_idle_reschedule_ms()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * @fn fbe_provision_drive_sniff_pacing_get_reschedule_ms()
+ ******************************************************************************
+ * @brief
+ *  This function returns the delay before the next sniff verify.  It is
+ *  called once per sniff cycle from the monitor context and counts whether
+ *  the cycle ran at the busy delay or sooner.
+ *
+ * @param provision_drive_p     - Provision drive object.
+ *
+ * @return fbe_u32_t            - Delay in milliseconds.
+ *
+ ******************************************************************************/
+fbe_u32_t
+fbe_provision_drive_sniff_pacing_get_reschedule_ms(fbe_provision_drive_t * provision_drive_p)
+{
+    fbe_provision_drive_sniff_pacing_t *pacing_p = &provision_drive_p->sniff_pacing;
+    fbe_atomic_t host_io_count;
+    fbe_u32_t idle_reschedule_ms;
+
+    host_io_count = pacing_p->host_io_count;
+
+    /* Back off at once when host i/o arrived since the last cycle or is still in flight.
+     */
+    if ((host_io_count != pacing_p->last_host_io_count) ||
+        (provision_drive_p->base_config.block_transport_server.outstanding_io_count != 0))
+    {
+        pacing_p->last_host_io_count = host_io_count;
+        pacing_p->last_host_io_time = fbe_get_time();
+        pacing_p->reschedule_ms = FBE_PROVISION_DRIVE_SNIFF_BUSY_RESCHEDULE_MS;
+        pacing_p->busy_cycles++;
+        return pacing_p->reschedule_ms;
+    }
+
+    if (fbe_get_elapsed_milliseconds(pacing_p->last_host_io_time) >= FBE_PROVISION_DRIVE_SNIFF_IDLE_THRESHOLD_MS)
+    {
+        idle_reschedule_ms = fbe_provision_drive_sniff_pacing_get_idle_reschedule_ms(provision_drive_p);
+        pacing_p->reschedule_ms = FBE_MAX(pacing_p->reschedule_ms / 2, idle_reschedule_ms);
+    }
+
+    if (pacing_p->reschedule_ms < FBE_PROVISION_DRIVE_SNIFF_BUSY_RESCHEDULE_MS)
+    {
+        pacing_p->idle_cycles++;
+    }
+    else
+    {
+        pacing_p->busy_cycles++;
+    }
+    return pacing_p->reschedule_ms;
+}
+/******************************************************************************
+ * end fbe_provision_drive_sniff_pacing_get_reschedule_ms()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * @fn fbe_provision_drive_sniff_pacing_add_hot_region()
+ ******************************************************************************
+ * @brief
+ *  This function queues the chunks around a media error to be verified ahead
+ *  of the sniff checkpoint.  Regions are limited to the user area above the
+ *  default offset.  When all slots are taken the oldest region is dropped.
+ *
+ * @param provision_drive_p     - Provision drive object.
+ * @param media_error_lba       - Lba of the media error.
+ *
+ * @return None.
+ *
+ ******************************************************************************/
+void
+fbe_provision_drive_sniff_pacing_add_hot_region(fbe_provision_drive_t * provision_drive_p,
+                                                fbe_lba_t media_error_lba)
+{
+    fbe_provision_drive_sniff_pacing_t *pacing_p = &provision_drive_p->sniff_pacing;
+    fbe_provision_drive_sniff_hot_region_t *region_p;
+    fbe_lba_t default_offset;
+    fbe_lba_t paged_metadata_start_lba;
+    fbe_lba_t start_lba;
+    fbe_lba_t end_lba;
+    fbe_lba_t region_end_lba;
+    fbe_u32_t index;
+    fbe_u32_t i;
+
+    fbe_base_config_get_default_offset((fbe_base_config_t *)provision_drive_p, &default_offset);
+    fbe_base_config_metadata_get_paged_record_start_lba((fbe_base_config_t *)provision_drive_p,
+                                                        &paged_metadata_start_lba);
+
+    start_lba = (media_error_lba / FBE_PROVISION_DRIVE_CHUNK_SIZE) * FBE_PROVISION_DRIVE_CHUNK_SIZE;
+    end_lba = start_lba + ((FBE_PROVISION_DRIVE_SNIFF_HOT_REGION_RADIUS + 1) * FBE_PROVISION_DRIVE_CHUNK_SIZE);
+    if (start_lba >= (FBE_PROVISION_DRIVE_SNIFF_HOT_REGION_RADIUS * FBE_PROVISION_DRIVE_CHUNK_SIZE))
+    {
+        start_lba -= FBE_PROVISION_DRIVE_SNIFF_HOT_REGION_RADIUS * FBE_PROVISION_DRIVE_CHUNK_SIZE;
+    }
+    else
+    {
+        start_lba = 0;
+    }
+    default_offset = ((default_offset + FBE_PROVISION_DRIVE_CHUNK_SIZE - 1) / FBE_PROVISION_DRIVE_CHUNK_SIZE) *
+                     FBE_PROVISION_DRIVE_CHUNK_SIZE;
+    start_lba = FBE_MAX(start_lba, default_offset);
+    end_lba = FBE_MIN(end_lba, paged_metadata_start_lba);
+    if (start_lba >= end_lba)
+    {
+        return;
+    }
+
+    fbe_provision_drive_sniff_pacing_lock(provision_drive_p);
+
+    /* Grow a queued region the new one overlaps rather than verifying chunks twice.
+     */
+    for (i = 0; i < pacing_p->hot_region_count; i++)
+    {
+        region_p = &pacing_p->hot_regions[(pacing_p->hot_region_head + i) % FBE_PROVISION_DRIVE_SNIFF_HOT_REGION_MAX];
+        region_end_lba = region_p->next_lba + (region_p->chunks_remaining * FBE_PROVISION_DRIVE_CHUNK_SIZE);
+        if ((start_lba <= region_end_lba) && (end_lba >= region_p->next_lba))
+        {
+            end_lba = FBE_MAX(end_lba, region_end_lba);
+            region_p->next_lba = FBE_MIN(start_lba, region_p->next_lba);
+            region_p->chunks_remaining = (fbe_chunk_count_t)((end_lba - region_p->next_lba) / FBE_PROVISION_DRIVE_CHUNK_SIZE);
+            fbe_provision_drive_sniff_pacing_unlock(provision_drive_p);
+            return;
+        }
+    }
+
+    if (pacing_p->hot_region_count == FBE_PROVISION_DRIVE_SNIFF_HOT_REGION_MAX)
+    {
+        pacing_p->hot_region_head = (pacing_p->hot_region_head + 1) % FBE_PROVISION_DRIVE_SNIFF_HOT_REGION_MAX;
+        pacing_p->hot_region_count--;
+    }
+    index = (pacing_p->hot_region_head + pacing_p->hot_region_count) % FBE_PROVISION_DRIVE_SNIFF_HOT_REGION_MAX;
+    pacing_p->hot_regions[index].next_lba = start_lba;
+    pacing_p->hot_regions[index].chunks_remaining = (fbe_chunk_count_t)((end_lba - start_lba) / FBE_PROVISION_DRIVE_CHUNK_SIZE);
+    pacing_p->hot_region_count++;
+
+    fbe_provision_drive_sniff_pacing_unlock(provision_drive_p);
+
+    fbe_provision_drive_utils_trace(provision_drive_p,
+                                    FBE_TRACE_LEVEL_DEBUG_HIGH, FBE_TRACE_MESSAGE_ID_INFO,
+                                    FBE_PROVISION_DRIVE_DEBUG_FLAG_SNIFF_TRACING,
+                                    "SNIFF: hot region lba: 0x%llx end: 0x%llx media err lba: 0x%llx\n",
+                                    start_lba, end_lba, media_error_lba);
+}
+/******************************************************************************
+ * end fbe_provision_drive_sniff_pacing_add_hot_region()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * @fn fbe_provision_drive_sniff_pacing_skip_hot_chunks()
+ ******************************************************************************
+ * @brief
+ *  This function moves the oldest hot region up to the next consumed lba, or
+ *  drops it when nothing in it is consumed.  Chunks no upstream object
+ *  consumes are not verified, the same as at the checkpoint.
+ *
+ * @param provision_drive_p     - Provision drive object.
+ * @param hot_lba               - Start of the chunk that is not consumed.
+ * @param next_consumed_lba     - Next consumed lba, FBE_LBA_INVALID for none.
+ *
+ * @return None.
+ *
+ ******************************************************************************/
+static void
+fbe_provision_drive_sniff_pacing_skip_hot_chunks(fbe_provision_drive_t * provision_drive_p,
+                                                 fbe_lba_t hot_lba,
+                                                 fbe_lba_t next_consumed_lba)
+{
+    fbe_provision_drive_sniff_pacing_t *pacing_p = &provision_drive_p->sniff_pacing;
+    fbe_provision_drive_sniff_hot_region_t *region_p;
+    fbe_lba_t region_end_lba;
+    fbe_lba_t next_lba;
+
+    fbe_provision_drive_sniff_pacing_lock(provision_drive_p);
+    region_p = &pacing_p->hot_regions[pacing_p->hot_region_head];
+
+    /* The region may have been dropped or grown since we looked at it.
+     */
+    if ((pacing_p->hot_region_count != 0) && (region_p->next_lba == hot_lba))
+    {
+        region_end_lba = region_p->next_lba + (region_p->chunks_remaining * FBE_PROVISION_DRIVE_CHUNK_SIZE);
+        next_lba = (next_consumed_lba / FBE_PROVISION_DRIVE_CHUNK_SIZE) * FBE_PROVISION_DRIVE_CHUNK_SIZE;
+        if ((next_consumed_lba == FBE_LBA_INVALID) || (next_lba >= region_end_lba))
+        {
+            pacing_p->hot_region_head = (pacing_p->hot_region_head + 1) % FBE_PROVISION_DRIVE_SNIFF_HOT_REGION_MAX;
+            pacing_p->hot_region_count--;
+        }
+        else
+        {
+            region_p->chunks_remaining -= (fbe_chunk_count_t)((next_lba - region_p->next_lba) / FBE_PROVISION_DRIVE_CHUNK_SIZE);
+            region_p->next_lba = next_lba;
+        }
+    }
+    fbe_provision_drive_sniff_pacing_unlock(provision_drive_p);
+}
+/******************************************************************************
+ * end fbe_provision_drive_sniff_pacing_skip_hot_chunks()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * @fn fbe_provision_drive_sniff_pacing_get_hot_lba()
+ ******************************************************************************
+ * @brief
+ *  This function returns the next hot chunk to verify and remembers it as
+ *  the chunk of the current sniff cycle.  Like the verify at the checkpoint
+ *  it skips the chunks that no upstream object consumes.
+ *
+ * @param provision_drive_p     - Provision drive object.
+ * @param hot_lba_p             - Start of the hot chunk.
+ *
+ * @return fbe_bool_t           - FBE_TRUE if a hot chunk is queued.
+ *
+ ******************************************************************************/
+fbe_bool_t
+fbe_provision_drive_sniff_pacing_get_hot_lba(fbe_provision_drive_t * provision_drive_p,
+                                             fbe_lba_t * hot_lba_p)
+{
+    fbe_provision_drive_sniff_pacing_t *pacing_p = &provision_drive_p->sniff_pacing;
+    fbe_lba_t next_consumed_lba;
+
+    for ( ; ; )
+    {
+        *hot_lba_p = FBE_LBA_INVALID;
+        fbe_provision_drive_sniff_pacing_lock(provision_drive_p);
+        if (pacing_p->hot_region_count != 0)
+        {
+            *hot_lba_p = pacing_p->hot_regions[pacing_p->hot_region_head].next_lba;
+        }
+        fbe_provision_drive_sniff_pacing_unlock(provision_drive_p);
+
+        if (*hot_lba_p == FBE_LBA_INVALID)
+        {
+            break;
+        }
+
+        /* The block transport server takes its own lock, so look outside of ours.
+         */
+        fbe_block_transport_server_find_next_consumed_lba(&provision_drive_p->base_config.block_transport_server,
+                                                          *hot_lba_p,
+                                                          &next_consumed_lba);
+        if ((next_consumed_lba != FBE_LBA_INVALID) &&
+            (next_consumed_lba < (*hot_lba_p + FBE_PROVISION_DRIVE_CHUNK_SIZE)))
+        {
+            break;
+        }
+        fbe_provision_drive_sniff_pacing_skip_hot_chunks(provision_drive_p, *hot_lba_p, next_consumed_lba);
+    }
+
+    fbe_provision_drive_sniff_pacing_lock(provision_drive_p);
+    pacing_p->hot_verify_lba = *hot_lba_p;
+    fbe_provision_drive_sniff_pacing_unlock(provision_drive_p);
+
+    return (*hot_lba_p != FBE_LBA_INVALID);
+}
+/******************************************************************************
+ * end fbe_provision_drive_sniff_pacing_get_hot_lba()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * @fn fbe_provision_drive_sniff_pacing_hot_chunk_done()
+ ******************************************************************************
+ * @brief
+ *  This function moves the oldest hot region past a verified chunk and
+ *  drops the region once all of its chunks are verified.
+ *
+ * @param provision_drive_p     - Provision drive object.
+ * @param hot_lba               - Start of the verified chunk.
+ *
+ * @return None.
+ *
+ ******************************************************************************/
+static void
+fbe_provision_drive_sniff_pacing_hot_chunk_done(fbe_provision_drive_t * provision_drive_p,
+                                                fbe_lba_t hot_lba)
+{
+    fbe_provision_drive_sniff_pacing_t *pacing_p = &provision_drive_p->sniff_pacing;
+    fbe_provision_drive_sniff_hot_region_t *region_p;
+
+    fbe_provision_drive_sniff_pacing_lock(provision_drive_p);
+    region_p = &pacing_p->hot_regions[pacing_p->hot_region_head];
+
+    /* The region may have been dropped or grown while the verify was in flight.
+     */
+    if ((pacing_p->hot_region_count != 0) && (region_p->next_lba == hot_lba))
+    {
+        region_p->next_lba += FBE_PROVISION_DRIVE_CHUNK_SIZE;
+        region_p->chunks_remaining--;
+        if (region_p->chunks_remaining == 0)
+        {
+            pacing_p->hot_region_head = (pacing_p->hot_region_head + 1) % FBE_PROVISION_DRIVE_SNIFF_HOT_REGION_MAX;
+            pacing_p->hot_region_count--;
+        }
+    }
+    fbe_provision_drive_sniff_pacing_unlock(provision_drive_p);
+}
+/******************************************************************************
+ * end fbe_provision_drive_sniff_pacing_hot_chunk_done()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * @fn fbe_provision_drive_sniff_pacing_get_hot_media_error_lba()
+ ******************************************************************************
+ * @brief
+ *  This function takes the media error lba a hot region verify found, if any.
+ *
+ * @param provision_drive_p     - Provision drive object.
+ * @param media_error_lba_p     - Lba of the media error.
+ *
+ * @return fbe_bool_t           - FBE_TRUE if a media error is waiting.
+ *
+ ******************************************************************************/
+fbe_bool_t
+fbe_provision_drive_sniff_pacing_get_hot_media_error_lba(fbe_provision_drive_t * provision_drive_p,
+                                                         fbe_lba_t * media_error_lba_p)
+{
+    fbe_provision_drive_sniff_pacing_t *pacing_p = &provision_drive_p->sniff_pacing;
+
+    fbe_provision_drive_sniff_pacing_lock(provision_drive_p);
+    *media_error_lba_p = pacing_p->hot_media_error_lba;
+    pacing_p->hot_media_error_lba = FBE_LBA_INVALID;
+    fbe_provision_drive_sniff_pacing_unlock(provision_drive_p);
+
+    return (*media_error_lba_p != FBE_LBA_INVALID);
+}
+/******************************************************************************
+ * end fbe_provision_drive_sniff_pacing_get_hot_media_error_lba()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * @fn fbe_provision_drive_sniff_pacing_start_hot_verify_io()
+ ******************************************************************************
+ * @brief
+ *  This function sends a sniff verify of one hot chunk.  Unlike the verify at
+ *  the checkpoint it does not advance the checkpoint when it completes.
+ *
+ * @param provision_drive_p     - Provision drive object.
+ * @param packet_p              - Monitor packet.
+ * @param hot_lba               - Start of the hot chunk.
+ *
+ * @return fbe_status_t         - status of the operation.
+ *
+ ******************************************************************************/
+fbe_status_t
+fbe_provision_drive_sniff_pacing_start_hot_verify_io(fbe_provision_drive_t * provision_drive_p,
+                                                     fbe_packet_t * packet_p,
+                                                     fbe_lba_t hot_lba)
+{
+    fbe_transport_set_completion_function(packet_p,
+                                          fbe_provision_drive_sniff_pacing_hot_verify_io_completion,
+                                          provision_drive_p);
+
+    fbe_transport_set_traffic_priority(packet_p, provision_drive_p->verify_priority);
+    fbe_transport_set_packet_attr(packet_p, FBE_PACKET_FLAG_BACKGROUND_SNIFF);
+
+    fbe_provision_drive_utils_trace(provision_drive_p,
+                                    FBE_TRACE_LEVEL_DEBUG_HIGH, FBE_TRACE_MESSAGE_ID_INFO,
+                                    FBE_PROVISION_DRIVE_DEBUG_FLAG_SNIFF_TRACING,
+                                    "SNIFF: send hot verify lba: 0x%llx bl: 0x%x\n",
+                                    hot_lba, FBE_PROVISION_DRIVE_CHUNK_SIZE);
+
+    return fbe_provision_drive_send_monitor_packet(provision_drive_p, packet_p,
+                                                   FBE_PAYLOAD_BLOCK_OPERATION_OPCODE_VERIFY,
+                                                   hot_lba, FBE_PROVISION_DRIVE_CHUNK_SIZE);
+}
+/******************************************************************************
+ * end fbe_provision_drive_sniff_pacing_start_hot_verify_io()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * @fn fbe_provision_drive_sniff_pacing_hot_verify_io_completion()
+ ******************************************************************************
+ * @brief
+ *  This is the completion function of a hot chunk verify.  A media error is
+ *  left for the monitor to report upstream, since the remap event cannot be
+ *  sent from here.  It does not queue another hot region, only media errors
+ *  found at the checkpoint do, so that a bad area cannot keep sniff busy
+ *  with hot verifies forever.
+ *
+ * @param packet_p              - Monitor packet.
+ * @param context               - Provision drive object.
+ *
+ * @return fbe_status_t         - FBE_STATUS_OK
+ *
+ ******************************************************************************/
+static fbe_status_t
+fbe_provision_drive_sniff_pacing_hot_verify_io_completion(fbe_packet_t * packet_p,
+                                                          fbe_packet_completion_context_t context)
+{
+    fbe_provision_drive_t *                 provision_drive_p = (fbe_provision_drive_t *)context;
+    fbe_payload_ex_t *                      sep_payload_p;
+    fbe_payload_block_operation_t *         block_operation_p;
+    fbe_payload_block_operation_status_t    block_status;
+    fbe_payload_block_operation_qualifier_t block_qualifier;
+    fbe_provision_drive_io_status_t         io_status;
+    fbe_status_t                            transport_status;
+    fbe_lba_t                               hot_lba;
+    fbe_lba_t                               media_error_lba;
+
+    transport_status = fbe_transport_get_status_code(packet_p);
+
+    sep_payload_p = fbe_transport_get_payload_ex(packet_p);
+    block_operation_p = fbe_payload_ex_get_block_operation(sep_payload_p);
+    fbe_payload_block_get_status(block_operation_p, &block_status);
+    fbe_payload_block_get_qualifier(block_operation_p, &block_qualifier);
+    fbe_payload_ex_get_media_error_lba(sep_payload_p, &media_error_lba);
+    hot_lba = block_operation_p->lba;
+    fbe_payload_ex_release_block_operation(sep_payload_p, block_operation_p);
+
+    io_status = fbe_provision_drive_classify_io_status(transport_status, block_status, block_qualifier);
+
+    switch (io_status)
+    {
+        case FBE_PROVISION_DRIVE_IO_STATUS_SUCCESS:
+            fbe_provision_drive_sniff_pacing_hot_chunk_done(provision_drive_p, hot_lba);
+            fbe_transport_set_status(packet_p, FBE_STATUS_OK, 0);
+            break;
+
+        case FBE_PROVISION_DRIVE_IO_STATUS_HARD_MEDIA_ERROR:
+        case FBE_PROVISION_DRIVE_IO_STATUS_SOFT_MEDIA_ERROR:
+            fbe_base_object_trace((fbe_base_object_t *)provision_drive_p,
+                                  FBE_TRACE_LEVEL_WARNING,
+                                  FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                                  "SNIFF: hot verify media err at lba:0x%llx status:0x%x/0x%x\n",
+                                  (unsigned long long)media_error_lba, transport_status, block_status);
+
+            fbe_provision_drive_update_verify_report_error_counts(provision_drive_p, io_status);
+            fbe_provision_drive_sniff_pacing_hot_chunk_done(provision_drive_p, hot_lba);
+
+            fbe_provision_drive_sniff_pacing_lock(provision_drive_p);
+            provision_drive_p->sniff_pacing.hot_media_error_lba = media_error_lba;
+            fbe_provision_drive_sniff_pacing_unlock(provision_drive_p);
+
+            fbe_transport_set_status(packet_p, FBE_STATUS_OK, 0);
+            break;
+
+        case FBE_PROVISION_DRIVE_IO_STATUS_ERROR:
+        default:
+            /* Leave the chunk queued, it is retried on the next cycle.
+             */
+            fbe_base_object_trace((fbe_base_object_t *)provision_drive_p,
+                                  FBE_TRACE_LEVEL_WARNING,
+                                  FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                                  "SNIFF: hot verify i/o fail, stat:0x%x/0x%x\n",
+                                  transport_status, block_status);
+            fbe_transport_set_status(packet_p, FBE_STATUS_GENERIC_FAILURE, 0);
+            break;
+    }
+
+    return FBE_STATUS_OK;
+}
+/******************************************************************************
+ * end fbe_provision_drive_sniff_pacing_hot_verify_io_completion()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * @fn fbe_provision_drive_sniff_pacing_remap_completion()
+ ******************************************************************************
+ * @brief
+ *  This is the completion function of the remap event sent for a media error
+ *  found in a hot region.  Nothing is left to do on the provision drive, the
+ *  upstream object marked the chunk for verify or has no data there.
+ *
+ * @param event_p               - Remap event.
+ * @param context               - Provision drive object.
+ *
+ * @return fbe_status_t         - FBE_STATUS_OK
+ *
+ ******************************************************************************/
+fbe_status_t
+fbe_provision_drive_sniff_pacing_remap_completion(fbe_event_t * event_p,
+                                                  fbe_event_completion_context_t context)
+{
+    fbe_provision_drive_t * provision_drive_p = (fbe_provision_drive_t *)context;
+    fbe_event_stack_t *     event_stack_p;
+    fbe_event_status_t      event_status;
+    fbe_lba_t               lba;
+
+    event_stack_p = fbe_event_get_current_stack(event_p);
+    fbe_event_get_status(event_p, &event_status);
+    lba = event_stack_p->lba;
+
+    fbe_event_release_stack(event_p, event_stack_p);
+    fbe_event_destroy(event_p);
+    fbe_memory_ex_release(event_p);
+
+    fbe_lifecycle_set_cond(&fbe_provision_drive_lifecycle_const,
+                           (fbe_base_object_t *)provision_drive_p,
+                           FBE_PROVISION_DRIVE_LIFECYCLE_COND_CLEAR_EVENT_FLAG);
+
+    fbe_provision_drive_utils_trace(provision_drive_p,
+                                    FBE_TRACE_LEVEL_INFO, FBE_TRACE_MESSAGE_ID_INFO,
+                                    FBE_PROVISION_DRIVE_DEBUG_FLAG_SNIFF_TRACING,
+                                    "SNIFF: hot remap event lba: 0x%llx status: %d\n",
+                                    lba, event_status);
+
+    return FBE_STATUS_OK;
+}
+/******************************************************************************
+ * end fbe_provision_drive_sniff_pacing_remap_completion()
+ ******************************************************************************/
+
+/*******************************
+ * end fbe_provision_drive_sniff_pacing.c
+ *******************************/
@@ -479,34 +479,12 @@ fbe_provision_drive_advance_verify_checkpoint(fbe_provision_drive_t* provision_d
     }
     else
     {
-        fbe_u32_t ms_since_checkpoint;
-        fbe_time_t last_checkpoint_time;
-
-        fbe_provision_drive_get_last_checkpoint_time(provision_drive_p, &last_checkpoint_time);
-        ms_since_checkpoint = fbe_get_elapsed_milliseconds(last_checkpoint_time);
-
-        if (ms_since_checkpoint > FBE_PROVISION_DRIVE_PEER_CHECKPOINT_UPDATE_MS)
-        {
-            // update verify checkpoint for the next verify i/o with sending request to metadata service
-            status = fbe_base_config_metadata_nonpaged_force_set_checkpoint((fbe_base_config_t *)provision_drive_p,
-                                                                            packet_p,
-                                                                            (fbe_u64_t)(&((fbe_provision_drive_nonpaged_metadata_t*)0)->sniff_verify_checkpoint),
-                                                                            0,
-                                                                            checkpoint + block_count);
-            fbe_provision_drive_update_last_checkpoint_time(provision_drive_p);
-        }
-        else
-        {
-
-            // update verify checkpoint for the next verify i/o with sending request to metadata service
-            status = fbe_base_config_metadata_nonpaged_incr_checkpoint_no_peer((fbe_base_config_t *)provision_drive_p,
-                                                                               packet_p,
-                                                                               (fbe_u64_t)(&((fbe_provision_drive_nonpaged_metadata_t*)0)->sniff_verify_checkpoint),
-                                                                               0,
-                                                                               checkpoint,
-                                                                               block_count);
-
-        }
+        // update verify checkpoint for the next verify i/o, only sending it to the peer once in a while
+        status = fbe_provision_drive_metadata_batch_checkpoint(provision_drive_p, packet_p,
+                                                               fbe_provision_drive_metadata_is_checkpoint_peer_update_due(provision_drive_p),
+                                                               (fbe_u64_t)(&((fbe_provision_drive_nonpaged_metadata_t*)0)->sniff_verify_checkpoint),
+                                                               checkpoint,
+                                                               block_count);
     }
     //  Check the status of the call and trace if error.  The called function is completing the packet on error
     //  so we can't complete it here.  The condition will remain set so we will try again.
@@ -156,6 +156,7 @@ static fbe_status_t fbe_provision_drive_usurper_unquiesce(fbe_provision_drive_t
 static fbe_status_t fbe_provision_drive_usurper_get_clustered_flags(fbe_provision_drive_t * provision_drive_p, fbe_packet_t * packet_p);
 static fbe_status_t fbe_provision_drive_usurper_disable_paged_cache(fbe_provision_drive_t * provision_drive_p, fbe_packet_t * packet_p);
 static fbe_status_t fbe_provision_drive_usurper_get_paged_cache_info(fbe_provision_drive_t * provision_drive_p, fbe_packet_t * packet_p);
+static fbe_status_t fbe_provision_drive_usurper_get_zod_batch_info(fbe_provision_drive_t * provision_drive_p, fbe_packet_t * packet_p);
 
 static fbe_status_t fbe_provision_drive_usurper_set_swap_pending(fbe_provision_drive_t *provision_drive_p, 
                                                                        fbe_packet_t *packet_p);
@@ -531,6 +532,10 @@ fbe_provision_drive_control_entry(fbe_object_handle_t object_handle, fbe_packet_
             status = fbe_provision_drive_usurper_get_paged_cache_info(provision_drive, packet_p);
             break;
 
+        case FBE_PROVISION_DRIVE_CONTROL_CODE_GET_ZOD_BATCH_INFO:
+            status = fbe_provision_drive_usurper_get_zod_batch_info(provision_drive, packet_p);
+            break;
+
         case FBE_PROVISION_DRIVE_CONTROL_SET_SWAP_PENDING:
             status = fbe_provision_drive_usurper_set_swap_pending(provision_drive, packet_p); 
             break;
@@ -4527,6 +4532,10 @@ fbe_provision_drive_usurper_get_verify_status(
     
     verify_status_p->precentage_completed = (fbe_u8_t)(((double)verify_status_p->verify_checkpoint/(double)verify_status_p->exported_capacity)*100);
 
+    verify_status_p->sniff_reschedule_ms = in_provision_drive_p->sniff_pacing.reschedule_ms;
+    verify_status_p->sniff_busy_cycles = in_provision_drive_p->sniff_pacing.busy_cycles;
+    verify_status_p->sniff_idle_cycles = in_provision_drive_p->sniff_pacing.idle_cycles;
+
     // set success status in packet and complete operation
     fbe_transport_set_status( in_packet_p, FBE_STATUS_OK, 0 );
     fbe_transport_complete_packet( in_packet_p );
@@ -8906,6 +8915,55 @@ fbe_provision_drive_usurper_get_paged_cache_info(fbe_provision_drive_t * provisi
  * end fbe_provision_drive_usurper_get_paged_cache_info()
  **************************************/
 
+/*!**************************************************************
+ * fbe_provision_drive_usurper_get_zod_batch_info()
+ ****************************************************************
+ * @brief
+ *  This function gets the zero on demand paged update batching
+ *  counters.
+ *
+ * @param provision_drive_p - Provision drive object.
+ * @param packet_p     - Packet requesting operation.
+ *
+ * @return status - The status of the operation.
+ *
+ ****************************************************************/
+static fbe_status_t
+fbe_provision_drive_usurper_get_zod_batch_info(fbe_provision_drive_t * provision_drive_p, fbe_packet_t * packet_p)
+{
+    fbe_status_t status = FBE_STATUS_OK;
+    fbe_payload_ex_t *                  payload = NULL;
+    fbe_payload_control_operation_t *   control_operation = NULL;
+    fbe_provision_drive_get_zod_batch_info_t *get_info;
+
+    payload = fbe_transport_get_payload_ex(packet_p);
+    control_operation = fbe_payload_ex_get_control_operation(payload);
+
+    status = fbe_provision_drive_get_control_buffer(provision_drive_p, packet_p,
+                                                    sizeof(fbe_provision_drive_get_zod_batch_info_t),
+                                                    (fbe_payload_control_buffer_t)&get_info);
+    if (status != FBE_STATUS_OK) {
+        fbe_base_object_trace(  (fbe_base_object_t *)provision_drive_p,
+                                FBE_TRACE_LEVEL_ERROR,
+                                FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                                "%s fbe_payload_control_get_buffer failed\n",
+                                __FUNCTION__);
+        fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
+        fbe_transport_set_status(packet_p, status, 0);
+        fbe_transport_complete_packet(packet_p);
+        return status;
+    }
+
+    fbe_provision_drive_zod_batch_get_info(provision_drive_p, get_info);
+    fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_OK);
+    fbe_transport_set_status(packet_p, status, 0);
+    fbe_transport_complete_packet(packet_p);
+    return status;
+}
+/**************************************
+ * end fbe_provision_drive_usurper_get_zod_batch_info()
+ **************************************/
+
 /*!****************************************************************************
  *          fbe_provision_drive_set_swap_pending_completion()
  ******************************************************************************
@@ -302,11 +302,7 @@ fbe_provision_drive_ask_verify_permission( fbe_base_object_t* in_object_p,
                                            fbe_packet_t*      in_packet_p  )                                           
 {
     fbe_provision_drive_t*          provision_drive_p = NULL;  // pointer to provision drive
-    fbe_event_t*                    event_p = NULL;            // pointer to event
-    fbe_event_stack_t*              event_stack_p = NULL;      // event stack pointer
     fbe_lba_t                       start_lba = 0;          // starting lba - checkpoint
-    fbe_event_permit_request_t      permit_request = {0};
-    fbe_medic_action_priority_t     medic_action_priority;
     fbe_lba_t                       next_consumed_lba = FBE_LBA_INVALID;
     fbe_lba_t                       default_offset = FBE_LBA_INVALID;
    
@@ -359,7 +355,39 @@ fbe_provision_drive_ask_verify_permission( fbe_base_object_t* in_object_p,
         fbe_provision_drive_metadata_set_sniff_verify_checkpoint(provision_drive_p, in_packet_p, new_start_lba);
         return FBE_STATUS_OK;
     }
-    
+
+    return fbe_provision_drive_send_verify_permission_event(provision_drive_p, in_packet_p, start_lba);
+
+}   // end fbe_provision_drive_ask_verify_permission()
+
+
+/*!****************************************************************************
+ * fbe_provision_drive_send_verify_permission_event
+ ******************************************************************************
+ *
+ * @brief
+ *    This function sends the permission request event for a sniff verify of
+ *    the chunk at the specified lba to the upstream object.
+ *
+ * @param   provision_drive_p     -  pointer to provision drive
+ * @param   in_packet_p           -  pointer to control packet from scheduler
+ * @param   start_lba             -  start of the chunk to verify
+ *
+ * @return  fbe_status_t          -  FBE_STATUS_INSUFFICIENT_RESOURCES
+ *                                   FBE_STATUS_OK
+ *
+ ******************************************************************************/
+
+fbe_status_t
+fbe_provision_drive_send_verify_permission_event(fbe_provision_drive_t* provision_drive_p,
+                                                 fbe_packet_t*          in_packet_p,
+                                                 fbe_lba_t              start_lba)
+{
+    fbe_event_t*                    event_p = NULL;            // pointer to event
+    fbe_event_stack_t*              event_stack_p = NULL;      // event stack pointer
+    fbe_event_permit_request_t      permit_request = {0};
+    fbe_medic_action_priority_t     medic_action_priority;
+
     // allocate an event
     //event_p = fbe_memory_ex_allocate(sizeof(fbe_event_t));
 	event_p = &provision_drive_p->permision_event;
@@ -414,7 +442,7 @@ fbe_provision_drive_ask_verify_permission( fbe_base_object_t* in_object_p,
 
     return FBE_STATUS_OK;
 
-}   // end fbe_provision_drive_ask_verify_permission()
+}   // end fbe_provision_drive_send_verify_permission_event()
 
 
 /*!****************************************************************************
@@ -501,6 +529,13 @@ fbe_provision_drive_start_next_verify_io(fbe_provision_drive_t* in_provision_dri
     // trace function entry
     FBE_PROVISION_DRIVE_TRACE_FUNC_ENTRY( in_provision_drive_p );
 
+    // verify the hot chunk picked for this cycle, if any, without moving the checkpoint
+    if ( in_provision_drive_p->sniff_pacing.hot_verify_lba != FBE_LBA_INVALID )
+    {
+        return fbe_provision_drive_sniff_pacing_start_hot_verify_io( in_provision_drive_p, in_packet_p,
+                                                                     in_provision_drive_p->sniff_pacing.hot_verify_lba );
+    }
+
     // set default block count for next verify i/o (blocks per chunk)
     block_count = FBE_PROVISION_DRIVE_CHUNK_SIZE;
 
@@ -952,6 +987,9 @@ fbe_provision_drive_verify_io_completion(fbe_packet_t*                   in_pack
 									   "SNIFF: verify i/o fail-media err at lba:0x%llx,prev lba:0x%llx status:0x%x/0x%x\n",
 									   (unsigned long long)media_error_lba, (unsigned long long)prev_media_error_lba, transport_status, block_status);
 
+                // verify the chunks around the error again ahead of the checkpoint
+                fbe_provision_drive_sniff_pacing_add_hot_region( provision_drive_p, media_error_lba );
+
                 /* get the paged metadata start lba of the pvd object. */
                 fbe_base_config_metadata_get_paged_record_start_lba((fbe_base_config_t *) provision_drive_p,
                                                                     &paged_metadata_start_lba);
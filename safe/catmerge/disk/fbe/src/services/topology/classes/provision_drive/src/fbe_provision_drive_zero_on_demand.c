@@ -4033,6 +4033,13 @@ fbe_provision_drive_zero_on_demand_write_update_paged_metadata(fbe_provision_dri
     /* Release the existing read metadata operation before we send a request for paged metadata update. */
     fbe_payload_ex_release_metadata_operation(sep_payload_p, metadata_operation_p);
 
+    /* Writes within one paged block are marked together by a single update. */
+    if (fbe_provision_drive_zod_batch_update_paged_metadata(provision_drive_p, packet_p,
+                                                            start_chunk_index, chunk_count))
+    {
+        return FBE_STATUS_MORE_PROCESSING_REQUIRED;
+    }
+
     /* get the metadata offset for the chuk index. */
     metadata_offset = start_chunk_index * sizeof(fbe_provision_drive_paged_metadata_t);
 
@@ -0,0 +1,617 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2009-2014
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!**************************************************************************
+ * @file fbe_provision_drive_zod_batch.c
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains the batching of the paged metadata updates done by
+ *  zero on demand writes.
+ *
+ *  Every zero on demand write marks its chunks consumed (and clears need zero)
+ *  with a paged metadata update once the write finished.  Updates of the same
+ *  paged block are serialized by the metadata stripe lock, so on a freshly
+ *  bound drive random writes queue up behind each other on the paged blocks.
+ *
+ *  Instead, only one update per paged block is in flight.  Writes to the block
+ *  that finish while it is in flight wait on the block's slot and are all
+ *  marked by the next update, which is issued on the packet of the first of
+ *  them.  Each packet is completed once the update covering its chunks is done.
+ *
+ * @ingroup provision_drive_class_files
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "fbe_provision_drive_private.h"
+#include "fbe_transport_memory.h"
+
+static fbe_bool_t fbe_provision_drive_zod_batch_enabled = FBE_TRUE;
+
+/*************************
+ *   FORWARD DECLARATIONS
+ *************************/
+static fbe_status_t fbe_provision_drive_zod_batch_send_update(fbe_provision_drive_t * provision_drive_p,
+                                                              fbe_provision_drive_zod_batch_slot_t * slot_p);
+static fbe_status_t fbe_provision_drive_zod_batch_update_callback(fbe_packet_t * packet_p,
+                                                                  fbe_metadata_callback_context_t context);
+static fbe_status_t fbe_provision_drive_zod_batch_update_completion(fbe_packet_t * packet_p,
+                                                                    fbe_packet_completion_context_t context);
+
+
+/*!****************************************************************************
+ * @fn fbe_provision_drive_zod_batch_lock()
+ ******************************************************************************
+ * @brief
+ *  This function is to lock the zero on demand batching slots.
+ *
+ * @param provision_drive_p     - Provision drive object.
+ *
+ * @return None.
+ *
+ ******************************************************************************/
+static __forceinline void
+fbe_provision_drive_zod_batch_lock(fbe_provision_drive_t * provision_drive_p)
+{
+    csx_p_spin_pointer_lock(&provision_drive_p->zod_batch.batch_lock);
+}
+/******************************************************************************
+ * end fbe_provision_drive_zod_batch_lock()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * @fn fbe_provision_drive_zod_batch_unlock()
+ ******************************************************************************
+ * @brief
+ *  This function is to unlock the zero on demand batching slots.
+ *
+ * @param provision_drive_p     - Provision drive object.
+ *
+ * @return None.
+ *
+ ******************************************************************************/
+static __forceinline void
+fbe_provision_drive_zod_batch_unlock(fbe_provision_drive_t * provision_drive_p)
+{
+    csx_p_spin_pointer_unlock(&provision_drive_p->zod_batch.batch_lock);
+}
+/******************************************************************************
+ * end fbe_provision_drive_zod_batch_unlock()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * @fn fbe_provision_drive_zod_batch_get_chunk_mask()
+ ******************************************************************************
+ * @brief
+ *  This function returns the bits of the chunks a write covers within its
+ *  paged block.  The chunks must all be in the same paged block.
+ *
+ * @param start_chunk_index     - First chunk of the write.
+ * @param chunk_count           - Number of chunks of the write.
+ *
+ * @return fbe_u64_t            - Chunk bits, bit 0 is the first chunk of the block.
+ *
+ ******************************************************************************/
+static __forceinline fbe_u64_t
+fbe_provision_drive_zod_batch_get_chunk_mask(fbe_chunk_index_t start_chunk_index,
+                                             fbe_chunk_count_t chunk_count)
+{
+    fbe_u32_t first = (fbe_u32_t)(start_chunk_index % FBE_PROVISION_DRIVE_ZOD_BATCH_CHUNKS_PER_BLOCK);
+
+    if (chunk_count >= FBE_PROVISION_DRIVE_ZOD_BATCH_CHUNKS_PER_BLOCK)
+    {
+        return FBE_U64_MAX;
+    }
+    return (((fbe_u64_t)1 << chunk_count) - 1) << first;
+}
+/******************************************************************************
+ * end fbe_provision_drive_zod_batch_get_chunk_mask()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * @fn fbe_provision_drive_zod_batch_get_packet_chunk_mask()
+ ******************************************************************************
+ * @brief
+ *  This function returns the chunk bits of a waiting write from its block
+ *  operation.
+ *
+ * @param packet_p              - Sub-packet of the write.
+ *
+ * @return fbe_u64_t            - Chunk bits within the paged block.
+ *
+ ******************************************************************************/
+static fbe_u64_t
+fbe_provision_drive_zod_batch_get_packet_chunk_mask(fbe_packet_t * packet_p)
+{
+    fbe_payload_ex_t *              sep_payload_p = NULL;
+    fbe_payload_block_operation_t * block_operation_p = NULL;
+    fbe_lba_t                       start_lba;
+    fbe_block_count_t               block_count;
+    fbe_chunk_index_t               start_chunk_index;
+    fbe_chunk_count_t               chunk_count = 0;
+
+    sep_payload_p = fbe_transport_get_payload_ex(packet_p);
+    block_operation_p = fbe_payload_ex_get_present_block_operation(sep_payload_p);
+    fbe_payload_block_get_lba(block_operation_p, &start_lba);
+    fbe_payload_block_get_block_count(block_operation_p, &block_count);
+
+    fbe_provision_drive_utils_calculate_chunk_range(start_lba,
+                                                     block_count,
+                                                     FBE_PROVISION_DRIVE_CHUNK_SIZE,
+                                                     &start_chunk_index,
+                                                     &chunk_count);
+
+    return fbe_provision_drive_zod_batch_get_chunk_mask(start_chunk_index, chunk_count);
+}
+/******************************************************************************
+ * end fbe_provision_drive_zod_batch_get_packet_chunk_mask()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * @fn fbe_provision_drive_zod_batch_init()
+ ******************************************************************************
+ * @brief
+ *  This function is used to initialize the zero on demand batching slots.
+ *
+ * @param provision_drive_p             - Provision drive object.
+ *
+ * @return fbe_status_t                 - status of the operation.
+ *
+ ******************************************************************************/
+fbe_status_t
+fbe_provision_drive_zod_batch_init(fbe_provision_drive_t * provision_drive_p)
+{
+    fbe_u32_t i;
+    fbe_provision_drive_zod_batch_slot_t *slot_p;
+
+    provision_drive_p->zod_batch.batch_lock = &provision_drive_p->zod_batch;
+    provision_drive_p->zod_batch.update_count = 0;
+    provision_drive_p->zod_batch.batched_count = 0;
+
+    slot_p = &provision_drive_p->zod_batch.slots[0];
+    for (i = 0; i < FBE_PROVISION_DRIVE_ZOD_BATCH_MAX_SLOTS; i++)
+    {
+        slot_p->in_use = FBE_FALSE;
+        slot_p->block_index = 0;
+        slot_p->chunk_bitmap = 0;
+        slot_p->carrier_packet_p = NULL;
+        fbe_queue_init(&slot_p->active_queue);
+        fbe_queue_init(&slot_p->wait_queue);
+        slot_p++;
+    }
+
+    return FBE_STATUS_OK;
+}
+/******************************************************************************
+ * end fbe_provision_drive_zod_batch_init()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * @fn fbe_provision_drive_zod_batch_set_enabled()
+ ******************************************************************************
+ * @brief
+ *  This function enables or disables the batching for all provision drives.
+ *  Updates already batched finish normally, new writes take the existing
+ *  path while batching is disabled.
+ *
+ * @param b_enabled             - FBE_TRUE to batch paged updates.
+ *
+ * @return None.
+ *
+ ******************************************************************************/
+void
+fbe_provision_drive_zod_batch_set_enabled(fbe_bool_t b_enabled)
+{
+    fbe_provision_drive_zod_batch_enabled = b_enabled;
+}
+/******************************************************************************
+ * end fbe_provision_drive_zod_batch_set_enabled()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * @fn fbe_provision_drive_zod_batch_get_info()
+ ******************************************************************************
+ * @brief
+ *  This function returns whether batching is enabled and the batching
+ *  counters of the provision drive.
+ *
+ * @param provision_drive_p     - Provision drive object.
+ * @param get_info_p            - Buffer to return the information in.
+ *
+ * @return None.
+ *
+ ******************************************************************************/
+void
+fbe_provision_drive_zod_batch_get_info(fbe_provision_drive_t * provision_drive_p,
+                                       fbe_provision_drive_get_zod_batch_info_t * get_info_p)
+{
+    get_info_p->b_enabled = fbe_provision_drive_zod_batch_enabled;
+
+    fbe_provision_drive_zod_batch_lock(provision_drive_p);
+    get_info_p->update_count = provision_drive_p->zod_batch.update_count;
+    get_info_p->batched_count = provision_drive_p->zod_batch.batched_count;
+    fbe_provision_drive_zod_batch_unlock(provision_drive_p);
+}
+/******************************************************************************
+ * end fbe_provision_drive_zod_batch_get_info()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * @fn fbe_provision_drive_zod_batch_update_paged_metadata()
+ ******************************************************************************
+ * @brief
+ *  This function hands the paged metadata update of a finished zero on demand
+ *  write to the batching.  If an update of the same paged block is in flight
+ *  the packet waits for the next one, otherwise the update is started on it.
+ *
+ *  Writes which span paged blocks, packets from the monitor and writes
+ *  arriving when all slots are busy are left to the caller.
+ *
+ * @param provision_drive_p     - Provision drive object.
+ * @param packet_p              - Sub-packet of the write.
+ * @param start_chunk_index     - First chunk of the write.
+ * @param chunk_count           - Number of chunks of the write.
+ *
+ * @return fbe_bool_t           - FBE_TRUE if the batching owns the packet.
+ *
+ ******************************************************************************/
+fbe_bool_t
+fbe_provision_drive_zod_batch_update_paged_metadata(fbe_provision_drive_t * provision_drive_p,
+                                                    fbe_packet_t * packet_p,
+                                                    fbe_chunk_index_t start_chunk_index,
+                                                    fbe_chunk_count_t chunk_count)
+{
+    fbe_provision_drive_zod_batch_slot_t *  slot_p = NULL;
+    fbe_provision_drive_zod_batch_slot_t *  free_slot_p = NULL;
+    fbe_chunk_index_t                       block_index;
+    fbe_object_id_t                         pvd_object_id;
+    fbe_u32_t                               i;
+
+    if (!fbe_provision_drive_zod_batch_enabled || (chunk_count == 0))
+    {
+        return FBE_FALSE;
+    }
+
+    /* A waiting packet is kept on its queue element, which is only free on
+     * the sub-packets we allocated for host i/o.
+     */
+    fbe_base_object_get_object_id((fbe_base_object_t *)provision_drive_p, &pvd_object_id);
+    if ((fbe_transport_get_master_packet(packet_p) == NULL) ||
+        fbe_transport_is_monitor_packet(packet_p, pvd_object_id))
+    {
+        return FBE_FALSE;
+    }
+
+    block_index = start_chunk_index / FBE_PROVISION_DRIVE_ZOD_BATCH_CHUNKS_PER_BLOCK;
+    if (((start_chunk_index + chunk_count - 1) / FBE_PROVISION_DRIVE_ZOD_BATCH_CHUNKS_PER_BLOCK) != block_index)
+    {
+        return FBE_FALSE;
+    }
+
+    fbe_provision_drive_zod_batch_lock(provision_drive_p);
+    slot_p = &provision_drive_p->zod_batch.slots[0];
+    for (i = 0; i < FBE_PROVISION_DRIVE_ZOD_BATCH_MAX_SLOTS; i++, slot_p++)
+    {
+        if (!slot_p->in_use)
+        {
+            if (free_slot_p == NULL)
+            {
+                free_slot_p = slot_p;
+            }
+            continue;
+        }
+        if (slot_p->block_index == block_index)
+        {
+            /* Marked by the next update of this block. */
+            fbe_queue_push(&slot_p->wait_queue, &packet_p->queue_element);
+            fbe_provision_drive_zod_batch_unlock(provision_drive_p);
+            return FBE_TRUE;
+        }
+    }
+
+    if (free_slot_p == NULL)
+    {
+        fbe_provision_drive_zod_batch_unlock(provision_drive_p);
+        return FBE_FALSE;
+    }
+
+    free_slot_p->in_use = FBE_TRUE;
+    free_slot_p->block_index = block_index;
+    free_slot_p->chunk_bitmap = fbe_provision_drive_zod_batch_get_chunk_mask(start_chunk_index, chunk_count);
+    free_slot_p->carrier_packet_p = packet_p;
+    provision_drive_p->zod_batch.update_count++;
+    fbe_provision_drive_zod_batch_unlock(provision_drive_p);
+
+    fbe_provision_drive_zod_batch_send_update(provision_drive_p, free_slot_p);
+    return FBE_TRUE;
+}
+/******************************************************************************
+ * end fbe_provision_drive_zod_batch_update_paged_metadata()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * @fn fbe_provision_drive_zod_batch_send_update()
+ ******************************************************************************
+ * @brief
+ *  This function issues the paged metadata update of a slot on its carrier
+ *  packet.  The update spans the lowest to the highest chunk of the slot's
+ *  bitmap, the callback only marks the chunks in the bitmap.
+ *
+ * @param provision_drive_p     - Provision drive object.
+ * @param slot_p                - Slot to update the paged block of.
+ *
+ * @return fbe_status_t
+ *
+ ******************************************************************************/
+static fbe_status_t
+fbe_provision_drive_zod_batch_send_update(fbe_provision_drive_t * provision_drive_p,
+                                          fbe_provision_drive_zod_batch_slot_t * slot_p)
+{
+    fbe_packet_t *                      packet_p = slot_p->carrier_packet_p;
+    fbe_payload_ex_t *                  sep_payload_p = NULL;
+    fbe_payload_metadata_operation_t *  metadata_operation_p = NULL;
+    fbe_u32_t                           first_chunk = 0;
+    fbe_u32_t                           last_chunk = FBE_PROVISION_DRIVE_ZOD_BATCH_CHUNKS_PER_BLOCK - 1;
+    fbe_u64_t                           metadata_offset;
+    fbe_lba_t                           metadata_start_lba;
+    fbe_block_count_t                   metadata_block_count;
+
+    while ((slot_p->chunk_bitmap & ((fbe_u64_t)1 << first_chunk)) == 0)
+    {
+        first_chunk++;
+    }
+    while ((slot_p->chunk_bitmap & ((fbe_u64_t)1 << last_chunk)) == 0)
+    {
+        last_chunk--;
+    }
+
+    metadata_offset = (slot_p->block_index * FBE_PROVISION_DRIVE_ZOD_BATCH_CHUNKS_PER_BLOCK + first_chunk) *
+                      sizeof(fbe_provision_drive_paged_metadata_t);
+
+    sep_payload_p = fbe_transport_get_payload_ex(packet_p);
+    metadata_operation_p = fbe_payload_ex_allocate_metadata_operation(sep_payload_p);
+
+    fbe_transport_set_completion_function(packet_p,
+                                          fbe_provision_drive_zod_batch_update_completion,
+                                          provision_drive_p);
+
+    fbe_payload_metadata_build_paged_update(metadata_operation_p,
+                                            &(((fbe_base_config_t *) provision_drive_p)->metadata_element),
+                                            metadata_offset,
+                                            sizeof(fbe_provision_drive_paged_metadata_t),
+                                            last_chunk - first_chunk + 1,
+                                            fbe_provision_drive_zod_batch_update_callback,
+                                            (void *)slot_p);
+    fbe_provision_drive_metadata_paged_init_client_blob(packet_p, metadata_operation_p);
+
+    fbe_metadata_paged_get_lock_range(metadata_operation_p, &metadata_start_lba, &metadata_block_count);
+    fbe_payload_metadata_set_metadata_stripe_offset(metadata_operation_p, metadata_start_lba);
+    fbe_payload_metadata_set_metadata_stripe_count(metadata_operation_p, metadata_block_count);
+
+    fbe_payload_ex_increment_metadata_operation_level(sep_payload_p);
+    return fbe_metadata_operation_entry(packet_p);
+}
+/******************************************************************************
+ * end fbe_provision_drive_zod_batch_send_update()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * @fn fbe_provision_drive_zod_batch_update_callback()
+ ******************************************************************************
+ * @brief
+ *  This is the paged update callback of a batched update.  It marks consumed
+ *  the chunks of the slot's bitmap and leaves the other chunks of the range
+ *  as they are.
+ *
+ * @param packet_p          - Carrier packet.
+ * @param context           - Slot of the update.
+ *
+ * @return fbe_status_t.
+ *
+ ******************************************************************************/
+static fbe_status_t
+fbe_provision_drive_zod_batch_update_callback(fbe_packet_t * packet_p, fbe_metadata_callback_context_t context)
+{
+    fbe_provision_drive_zod_batch_slot_t *  slot_p = (fbe_provision_drive_zod_batch_slot_t *)context;
+    fbe_payload_ex_t *                      sep_payload = fbe_transport_get_payload_ex(packet_p);
+    fbe_payload_metadata_operation_t *      mdo = NULL;
+    fbe_provision_drive_paged_metadata_t *  paged_metadata_p;
+    fbe_sg_element_t *                      sg_list = NULL;
+    fbe_sg_element_t *                      sg_ptr = NULL;
+    fbe_lba_t                               lba_offset;
+    fbe_u64_t                               slot_offset;
+    fbe_u32_t                               chunk;
+
+    if(sep_payload->current_operation->payload_opcode == FBE_PAYLOAD_OPCODE_METADATA_OPERATION){
+        mdo = fbe_payload_ex_get_metadata_operation(sep_payload);
+    } else if(sep_payload->current_operation->payload_opcode == FBE_PAYLOAD_OPCODE_STRIPE_LOCK_OPERATION){
+        mdo = fbe_payload_ex_get_any_metadata_operation(sep_payload);
+    } else {
+        fbe_topology_class_trace(FBE_CLASS_ID_PROVISION_DRIVE, FBE_TRACE_LEVEL_ERROR, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                      "%s: Invalid payload opcode:%d \n", __FUNCTION__, sep_payload->current_operation->payload_opcode);
+        fbe_transport_set_status(packet_p, FBE_STATUS_GENERIC_FAILURE, 0);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    lba_offset = fbe_metadata_paged_get_lba_offset(mdo);
+    slot_offset = fbe_metadata_paged_get_slot_offset(mdo);
+    sg_list = mdo->u.metadata_callback.sg_list;
+    sg_ptr = &sg_list[lba_offset - mdo->u.metadata_callback.start_lba];
+    paged_metadata_p = (fbe_provision_drive_paged_metadata_t *)(sg_ptr->address + slot_offset);
+
+    while ((sg_ptr->address != NULL) && (mdo->u.metadata_callback.current_count_private < mdo->u.metadata_callback.repeat_count))
+    {
+        chunk = (fbe_u32_t)(fbe_metadata_paged_get_record_offset(mdo) % FBE_PROVISION_DRIVE_ZOD_BATCH_CHUNKS_PER_BLOCK);
+        if (slot_p->chunk_bitmap & ((fbe_u64_t)1 << chunk))
+        {
+            paged_metadata_p->consumed_user_data_bit = 1;
+            paged_metadata_p->need_zero_bit = 0;
+            paged_metadata_p->user_zero_bit = 0;
+        }
+
+        mdo->u.metadata_callback.current_count_private++;
+        paged_metadata_p++;
+        if (paged_metadata_p == (fbe_provision_drive_paged_metadata_t *)(sg_ptr->address + FBE_METADATA_BLOCK_DATA_SIZE))
+        {
+            sg_ptr++;
+            paged_metadata_p = (fbe_provision_drive_paged_metadata_t *)sg_ptr->address;
+        }
+    }
+
+    return FBE_STATUS_MORE_PROCESSING_REQUIRED;
+}
+/******************************************************************************
+ * end fbe_provision_drive_zod_batch_update_callback()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * @fn fbe_provision_drive_zod_batch_update_completion()
+ ******************************************************************************
+ * @brief
+ *  This function handles the completion of a batched paged update.  The
+ *  packets it covered are completed with its status.  If writes waited on
+ *  the slot meanwhile, the next update is started for them on the first of
+ *  them, otherwise the slot is freed.
+ *
+ * @param packet_p          - Carrier packet.
+ * @param context           - Provision drive object.
+ *
+ * @return fbe_status_t
+ *
+ ******************************************************************************/
+static fbe_status_t
+fbe_provision_drive_zod_batch_update_completion(fbe_packet_t * packet_p,
+                                                fbe_packet_completion_context_t context)
+{
+    fbe_provision_drive_t *                 provision_drive_p = (fbe_provision_drive_t *)context;
+    fbe_provision_drive_zod_batch_slot_t *  slot_p = NULL;
+    fbe_payload_ex_t *                      sep_payload_p = NULL;
+    fbe_payload_metadata_operation_t *      metadata_operation_p = NULL;
+    fbe_payload_block_operation_t *         block_operation_p = NULL;
+    fbe_payload_metadata_status_t           metadata_status;
+    fbe_status_t                            status;
+    fbe_u64_t                               metadata_offset;
+    fbe_bool_t                              b_failed;
+    fbe_bool_t                              b_send_next = FBE_FALSE;
+    fbe_queue_head_t                        done_queue;
+    fbe_queue_element_t *                   queue_element_p = NULL;
+    fbe_packet_t *                          member_packet_p = NULL;
+    fbe_u32_t                               i;
+
+    sep_payload_p = fbe_transport_get_payload_ex(packet_p);
+    metadata_operation_p = fbe_payload_ex_get_metadata_operation(sep_payload_p);
+    fbe_payload_metadata_get_status(metadata_operation_p, &metadata_status);
+    fbe_payload_metadata_get_metadata_offset(metadata_operation_p, &metadata_offset);
+    status = fbe_transport_get_status_code(packet_p);
+    fbe_payload_ex_release_metadata_operation(sep_payload_p, metadata_operation_p);
+
+    b_failed = ((status != FBE_STATUS_OK) || (metadata_status != FBE_PAYLOAD_METADATA_STATUS_OK));
+    if (b_failed)
+    {
+        fbe_provision_drive_utils_trace(provision_drive_p,
+                                        FBE_TRACE_LEVEL_WARNING,
+                                        FBE_TRACE_MESSAGE_ID_INFO,
+                                        FBE_PROVISION_DRIVE_DEBUG_FLAG_ZOD_TRACING,
+                                        "WRITE_ZOD:batched paged md update failed, offset:0x%llx, metadata_status:0x%x, status:0x%x.\n",
+                                        (unsigned long long)metadata_offset, metadata_status, status);
+
+        /* Same as an unbatched update, the failure goes back as retryable. */
+        block_operation_p = fbe_payload_ex_get_present_block_operation(sep_payload_p);
+        fbe_payload_block_set_status(block_operation_p,
+                                     FBE_PAYLOAD_BLOCK_OPERATION_STATUS_IO_FAILED,
+                                     FBE_PAYLOAD_BLOCK_OPERATION_QUALIFIER_RETRY_POSSIBLE);
+        fbe_transport_set_status(packet_p, FBE_STATUS_OK, 0);
+    }
+
+    fbe_queue_init(&done_queue);
+
+    fbe_provision_drive_zod_batch_lock(provision_drive_p);
+    slot_p = &provision_drive_p->zod_batch.slots[0];
+    for (i = 0; i < FBE_PROVISION_DRIVE_ZOD_BATCH_MAX_SLOTS; i++, slot_p++)
+    {
+        if (slot_p->in_use && (slot_p->carrier_packet_p == packet_p))
+        {
+            break;
+        }
+    }
+    if (i == FBE_PROVISION_DRIVE_ZOD_BATCH_MAX_SLOTS)
+    {
+        fbe_provision_drive_zod_batch_unlock(provision_drive_p);
+        fbe_provision_drive_utils_trace(provision_drive_p,
+                                        FBE_TRACE_LEVEL_ERROR,
+                                        FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                                        FBE_PROVISION_DRIVE_DEBUG_FLAG_ZOD_TRACING,
+                                        "%s: no slot for packet %p\n", __FUNCTION__, packet_p);
+        return FBE_STATUS_OK;
+    }
+
+    while (!fbe_queue_is_empty(&slot_p->active_queue))
+    {
+        queue_element_p = fbe_queue_pop(&slot_p->active_queue);
+        fbe_queue_push(&done_queue, queue_element_p);
+    }
+
+    if (!fbe_queue_is_empty(&slot_p->wait_queue))
+    {
+        /* The first waiter carries the next update for all of them. */
+        queue_element_p = fbe_queue_pop(&slot_p->wait_queue);
+        member_packet_p = fbe_transport_queue_element_to_packet(queue_element_p);
+        slot_p->carrier_packet_p = member_packet_p;
+        slot_p->chunk_bitmap = fbe_provision_drive_zod_batch_get_packet_chunk_mask(member_packet_p);
+
+        while (!fbe_queue_is_empty(&slot_p->wait_queue))
+        {
+            queue_element_p = fbe_queue_pop(&slot_p->wait_queue);
+            member_packet_p = fbe_transport_queue_element_to_packet(queue_element_p);
+            slot_p->chunk_bitmap |= fbe_provision_drive_zod_batch_get_packet_chunk_mask(member_packet_p);
+            fbe_queue_push(&slot_p->active_queue, queue_element_p);
+            provision_drive_p->zod_batch.batched_count++;
+        }
+        provision_drive_p->zod_batch.update_count++;
+        b_send_next = FBE_TRUE;
+    }
+    else
+    {
+        slot_p->in_use = FBE_FALSE;
+        slot_p->carrier_packet_p = NULL;
+        slot_p->chunk_bitmap = 0;
+    }
+    fbe_provision_drive_zod_batch_unlock(provision_drive_p);
+
+    /* Keep the paged block busy before completing the writes of this update. */
+    if (b_send_next)
+    {
+        fbe_provision_drive_zod_batch_send_update(provision_drive_p, slot_p);
+    }
+
+    while (!fbe_queue_is_empty(&done_queue))
+    {
+        queue_element_p = fbe_queue_pop(&done_queue);
+        member_packet_p = fbe_transport_queue_element_to_packet(queue_element_p);
+        if (b_failed)
+        {
+            sep_payload_p = fbe_transport_get_payload_ex(member_packet_p);
+            block_operation_p = fbe_payload_ex_get_present_block_operation(sep_payload_p);
+            fbe_payload_block_set_status(block_operation_p,
+                                         FBE_PAYLOAD_BLOCK_OPERATION_STATUS_IO_FAILED,
+                                         FBE_PAYLOAD_BLOCK_OPERATION_QUALIFIER_RETRY_POSSIBLE);
+            fbe_transport_set_status(member_packet_p, FBE_STATUS_OK, 0);
+        }
+        fbe_transport_complete_packet(member_packet_p);
+    }
+
+    return FBE_STATUS_OK;
+}
+/******************************************************************************
+ * end fbe_provision_drive_zod_batch_update_completion()
+ ******************************************************************************/
+
+/*******************************
+ * end fbe_provision_drive_zod_batch.c
+ *******************************/
@@ -460,6 +460,7 @@ fbe_debug_field_info_t fbe_raid_group_dump_field_info[] =
     FBE_DEBUG_DECLARE_FIELD_INFO("chunk_size", fbe_chunk_size_t, FBE_FALSE, "0x%x"),
     FBE_DEBUG_DECLARE_FIELD_INFO("paged_metadata_verify_pass_count", fbe_u32_t, FBE_FALSE, "0x%x"),
     FBE_DEBUG_DECLARE_FIELD_INFO("last_checkpoint_time", fbe_time_t, FBE_FALSE, "0x%x"),
+    FBE_DEBUG_DECLARE_FIELD_INFO("journal_verify_blocks_since_peer_update", fbe_block_count_t, FBE_FALSE, "0x%x"),
     FBE_DEBUG_DECLARE_FIELD_INFO("previous_rebuild_percent", fbe_u32_t, FBE_FALSE, "0x%x"),
     FBE_DEBUG_DECLARE_FIELD_INFO("last_check_rg_broken_timestamp", fbe_time_t, FBE_FALSE, "0x%x"),
     FBE_DEBUG_DECLARE_FIELD_INFO("emeh_current_mode", fbe_raid_emeh_mode_t, FBE_FALSE, "%d"),
@@ -169,6 +169,16 @@ fbe_status_t fbe_raid_group_update_verify_checkpoint(
                                                   fbe_raid_verify_flags_t in_verify_flags,
                                                   const char *caller);
 
+fbe_bool_t fbe_raid_group_is_checkpoint_peer_update_due(fbe_raid_group_t *raid_group_p);
+
+fbe_status_t fbe_raid_group_batch_checkpoint(fbe_raid_group_t *raid_group_p,
+                                             fbe_packet_t *packet_p,
+                                             fbe_bool_t b_update_peer,
+                                             fbe_u64_t metadata_offset,
+                                             fbe_u64_t second_metadata_offset,
+                                             fbe_lba_t checkpoint,
+                                             fbe_block_count_t block_count);
+
 fbe_status_t fbe_raid_group_ask_upstream_for_permission(
                                     fbe_packet_t*          in_packet_p,
                                     fbe_raid_group_t*      in_raid_group_p,
@@ -233,6 +233,16 @@ enum fbe_raid_group_constants_e
     FBE_RAID_GROUP_DEFAULT_POWER_SAVE_IDLE_TIME     =  1800,    /*RAID will sleep by default after 30 min. w/o activity*/
     FBE_RAID_GROUP_BACKGROUND_OP_CHUNKS             =     1,    /*!< Num of chunks for each background op. */
     FBE_RAID_GROUP_REBUILD_BACKGROUND_OP_CHUNKS     =     4,    /*!< Num of chunks for each rebuild background op. */
+    FBE_RAID_GROUP_REBUILD_MAX_CONCURRENT_IOS       =     4,    /*!< Max rebuild I/Os in flight per raid group. */
+
+    /*! Rebuild I/Os completing below this time (in ms) on an otherwise idle 
+     *  raid group let the rebuild issue more or larger I/Os. 
+     */
+    FBE_RAID_GROUP_REBUILD_FAST_IO_SERVICE_TIME     =    20,
+    /*! Rebuild I/Os completing above this time (in ms) make the rebuild back 
+     *  off to fewer or smaller I/Os. 
+     */
+    FBE_RAID_GROUP_REBUILD_SLOW_IO_SERVICE_TIME     =   100,
 
     /*! This time is the time we allow in between the start  
      *  of downloads.  This time includes the download time.
@@ -705,6 +715,23 @@ typedef struct fbe_raid_group_bg_op_info_s
 }
 fbe_raid_group_bg_op_info_t;
 
+/*!*******************************************************************
+ * @struct fbe_raid_group_rebuild_tuning_t
+ *********************************************************************
+ * @brief Size and number of the rebuild I/Os issued together.  Tuned
+ *        after each rebuild request from the service time of its I/Os
+ *        and the host load on the raid group.
+ *
+ *********************************************************************/
+typedef struct fbe_raid_group_rebuild_tuning_s
+{
+    fbe_u32_t queue_depth;          /*!< Rebuild I/Os issued together, 0 until first used. */
+    fbe_u32_t op_chunks;            /*!< Chunks per rebuild I/O. */
+    fbe_u32_t avg_service_time_ms;  /*!< Moving average of the rebuild I/O service time. */
+    fbe_u32_t concurrent_request_count; /*!< Rebuild requests issued as more than one I/O. */
+}
+fbe_raid_group_rebuild_tuning_t;
+
 /*!*******************************************************************
  * @struct fbe_raid_group_t
  *********************************************************************
@@ -776,6 +803,7 @@ typedef struct fbe_raid_group_s
     fbe_u32_t               paged_metadata_verify_pass_count;
 
     fbe_time_t last_checkpoint_time; /*!< Last time we updated the checkpoint. */
+    fbe_block_count_t journal_verify_blocks_since_peer_update; /*!< Blocks the journal verify checkpoint moved since it last updated the peer. */
     fbe_lba_t last_checkpoint_to_peer; /*!< Last checkpoint we sent to the peer. */
 
     /*! keep the list of the PVD Ids we were rebulding. We need that because 
@@ -793,6 +821,8 @@ typedef struct fbe_raid_group_s
     fbe_lba_t last_capacity; /*!< During expand this has the last capacity. */
 
     fbe_raid_group_bg_op_info_t *bg_info_p; /*!< Tracking information for background op. */
+    struct fbe_raid_group_read_ahead_s *read_ahead_p; /*!< Sequential read-ahead, allocated at activate. */
+    fbe_raid_group_rebuild_tuning_t rebuild_tuning; /*!< Size and depth of the rebuild I/Os. */
 
     fbe_raid_emeh_command_t         emeh_request;       /*! Outstanding EMEH request. */
     fbe_raid_emeh_mode_t            emeh_enabled_mode;  /*! Determines of EMEH is enabled for this raid group or not.*/
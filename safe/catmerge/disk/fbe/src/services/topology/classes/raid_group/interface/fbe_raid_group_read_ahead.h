@@ -0,0 +1,180 @@
+#ifndef FBE_RAID_GROUP_READ_AHEAD_H
+#define FBE_RAID_GROUP_READ_AHEAD_H
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2009-2014
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!*************************************************************************
+ * @file fbe_raid_group_read_ahead.h
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains the private defines for the sequential stream
+ *  detection and read-ahead of the striper and parity raid groups.
+ *
+ * @note
+ *  Read-ahead is single SP only.  Writes of the peer are not seen by
+ *  this SP, so no read is completed from a buffer while the peer is
+ *  alive.
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "fbe_raid_group_object.h"
+
+/*!*******************************************************************
+ * @def FBE_RAID_GROUP_READ_AHEAD_MAX_STREAMS
+ *********************************************************************
+ * @brief Number of sequential read streams tracked per raid group.
+ *
+ *********************************************************************/
+#define FBE_RAID_GROUP_READ_AHEAD_MAX_STREAMS 4
+
+/*!*******************************************************************
+ * @def FBE_RAID_GROUP_READ_AHEAD_MAX_BUFFERS
+ *********************************************************************
+ * @brief Number of read-ahead buffers of a raid group.
+ *
+ *********************************************************************/
+#define FBE_RAID_GROUP_READ_AHEAD_MAX_BUFFERS 4
+
+/*!*******************************************************************
+ * @def FBE_RAID_GROUP_READ_AHEAD_BUFFER_BLOCKS
+ *********************************************************************
+ * @brief Size of one read-ahead buffer and of each read-ahead read.
+ *
+ *********************************************************************/
+#define FBE_RAID_GROUP_READ_AHEAD_BUFFER_BLOCKS 0x100
+
+/*!*******************************************************************
+ * @def FBE_RAID_GROUP_READ_AHEAD_DEPTH
+ *********************************************************************
+ * @brief Number of buffers we read ahead of a stream.
+ *
+ *********************************************************************/
+#define FBE_RAID_GROUP_READ_AHEAD_DEPTH 2
+
+/*!*******************************************************************
+ * @def FBE_RAID_GROUP_READ_AHEAD_MAX_IO_BLOCKS
+ *********************************************************************
+ * @brief Larger reads are not part of a stream, they stream well
+ *        enough on their own.
+ *
+ *********************************************************************/
+#define FBE_RAID_GROUP_READ_AHEAD_MAX_IO_BLOCKS 0x80
+
+/*!*******************************************************************
+ * @def FBE_RAID_GROUP_READ_AHEAD_TRIGGER
+ *********************************************************************
+ * @brief Number of back to back reads before a stream is read ahead.
+ *
+ *********************************************************************/
+#define FBE_RAID_GROUP_READ_AHEAD_TRIGGER 4
+
+/*!*******************************************************************
+ * @def FBE_RAID_GROUP_READ_AHEAD_IDLE_MS
+ *********************************************************************
+ * @brief A stream without reads for this long has stopped.  Its
+ *        buffers are no longer used and may be reused.
+ *
+ *********************************************************************/
+#define FBE_RAID_GROUP_READ_AHEAD_IDLE_MS 1000
+
+/*!*******************************************************************
+ * @def FBE_RAID_GROUP_READ_AHEAD_MAX_POOLS
+ *********************************************************************
+ * @brief Number of raid groups which may hold read-ahead buffers at
+ *        the same time.  Later raid groups do not read ahead.
+ *
+ *********************************************************************/
+#define FBE_RAID_GROUP_READ_AHEAD_MAX_POOLS 16
+
+/*!*******************************************************************
+ * @enum fbe_raid_group_read_ahead_buffer_state_t
+ *********************************************************************
+ * @brief State of a read-ahead buffer.
+ *
+ *********************************************************************/
+typedef enum fbe_raid_group_read_ahead_buffer_state_e
+{
+    FBE_RAID_GROUP_READ_AHEAD_BUFFER_FREE = 0,
+    FBE_RAID_GROUP_READ_AHEAD_BUFFER_READING,   /*!< Read-ahead read outstanding. */
+    FBE_RAID_GROUP_READ_AHEAD_BUFFER_VALID,     /*!< Holds the data of its range. */
+}
+fbe_raid_group_read_ahead_buffer_state_t;
+
+/*!*******************************************************************
+ * @struct fbe_raid_group_read_ahead_buffer_t
+ *********************************************************************
+ * @brief One read-ahead buffer.
+ *
+ *********************************************************************/
+typedef struct fbe_raid_group_read_ahead_buffer_s
+{
+    fbe_raid_group_read_ahead_buffer_state_t state;
+    fbe_bool_t          b_stale;    /*!< A write overlapped the range while reading. */
+    fbe_lba_t           lba;
+    fbe_block_count_t   blocks;
+    fbe_time_t          fill_time;  /*!< Time the read completed. */
+    fbe_u32_t           copy_count; /*!< Reads copying from the buffer right now. */
+    fbe_u8_t           *data_p;
+    fbe_sg_element_t    sg[2];
+}
+fbe_raid_group_read_ahead_buffer_t;
+
+/*!*******************************************************************
+ * @struct fbe_raid_group_read_ahead_stream_t
+ *********************************************************************
+ * @brief One sequential read stream.
+ *
+ *********************************************************************/
+typedef struct fbe_raid_group_read_ahead_stream_s
+{
+    fbe_lba_t   next_lba;       /*!< Lba the next read of the stream starts at. */
+    fbe_lba_t   read_ahead_lba; /*!< End of what was read ahead for the stream. */
+    fbe_u32_t   sequential_count;
+    fbe_time_t  last_io_time;
+}
+fbe_raid_group_read_ahead_stream_t;
+
+/*!*******************************************************************
+ * @struct fbe_raid_group_read_ahead_t
+ *********************************************************************
+ * @brief Read-ahead state of a raid group.  Allocated with its
+ *        buffers when the raid group activates.
+ *
+ *********************************************************************/
+typedef struct fbe_raid_group_read_ahead_s
+{
+    fbe_spinlock_t      lock;
+    fbe_u32_t           reads_outstanding;
+
+    fbe_u64_t           hit_count;      /*!< Reads completed from a buffer. */
+    fbe_u64_t           read_ahead_count; /*!< Read-ahead reads issued. */
+
+    fbe_raid_group_read_ahead_stream_t streams[FBE_RAID_GROUP_READ_AHEAD_MAX_STREAMS];
+    fbe_raid_group_read_ahead_buffer_t buffers[FBE_RAID_GROUP_READ_AHEAD_MAX_BUFFERS];
+}
+fbe_raid_group_read_ahead_t;
+
+/*************************
+ *   FUNCTION DEFINITIONS
+ *************************/
+fbe_bool_t fbe_raid_group_read_ahead_handle_io(fbe_raid_group_t *raid_group_p,
+                                               fbe_packet_t *packet_p,
+                                               fbe_payload_block_operation_opcode_t opcode,
+                                               fbe_lba_t lba,
+                                               fbe_block_count_t blocks);
+void fbe_raid_group_read_ahead_init(fbe_raid_group_t *raid_group_p);
+void fbe_raid_group_read_ahead_destroy(fbe_raid_group_t *raid_group_p);
+void fbe_raid_group_read_ahead_get_stats(fbe_raid_group_t *raid_group_p,
+                                         fbe_raid_group_get_read_ahead_stats_t *stats_p);
+
+#endif /* FBE_RAID_GROUP_READ_AHEAD_H */
+/*************************
+ * end file fbe_raid_group_read_ahead.h
+ *************************/
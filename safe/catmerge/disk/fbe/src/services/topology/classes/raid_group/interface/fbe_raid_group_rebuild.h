@@ -35,6 +35,12 @@
 
 #define FBE_RAID_GROUP_INVALID_BLOCK_SIZE   (0)
 
+//  Default catch up window, 1 GB per disk.  If a position that needs rebuilding is this many physical
+//  blocks or less behind another one, rebuild it first so that it catches up and both are rebuilt
+//  together in one pass.  Setting the window to 0 disables the catch up, so the highest checkpoint
+//  is always rebuilt first.
+#define FBE_RAID_GROUP_REBUILD_CATCH_UP_WINDOW_BLOCKS   (0x200000)
+
 //-----------------------------------------------------------------------------
 //  ENUMERATIONS:
 
@@ -59,6 +65,20 @@ fbe_rebuild_operation_state_t;
 //  TYPEDEFS: 
 //
 
+/*!*******************************************************************
+ * @typedef fbe_raid_group_rebuild_send_io_function_t
+ *********************************************************************
+ * @brief
+ *  Sends one rebuild I/O of a concurrent rebuild request.  The raid
+ *  group and the virtual drive each issue their own rebuild I/O.
+ *
+ *********************************************************************/
+typedef fbe_status_t (*fbe_raid_group_rebuild_send_io_function_t)(fbe_raid_group_t *raid_group_p,
+                                                                  fbe_packet_t *packet_p,
+                                                                  fbe_bool_t b_queue_to_block_transport,
+                                                                  fbe_lba_t start_lba,
+                                                                  fbe_block_count_t block_count);
+
 /*!*******************************************************************
  * @struct fbe_raid_group_rebuild_context_s
  *********************************************************************
@@ -83,6 +103,23 @@ typedef struct fbe_raid_group_rebuild_context_s
     fbe_base_config_physical_drive_location_t  event_log_location; // !< bus number of the rebuilt disk
     fbe_raid_position_t             event_log_source_position;  // !< position for event log
     fbe_base_config_physical_drive_location_t  event_log_source_location; // !< bus number of the rebuilt disk
+
+    /*! A rebuild request of the user area is split into sub requests which 
+     *  are issued together.  The request only moves the checkpoint once all 
+     *  of its sub requests completed and only over the completed range which 
+     *  starts at the checkpoint. 
+     */
+    fbe_bool_t                      b_sub_request;              // !< this is one I/O of a concurrent rebuild request
+    fbe_u32_t                       sub_request_count;          // !< number of sub requests of the request
+    fbe_block_count_t               sub_request_blocks;         // !< blocks per sub request (the last may be smaller)
+    fbe_raid_group_rebuild_send_io_function_t send_io_function; // !< sends the I/O of each sub request
+    struct fbe_raid_group_rebuild_context_s *sub_request_context_p[FBE_RAID_GROUP_REBUILD_MAX_CONCURRENT_IOS];
+    fbe_lba_t                       rebuilt_lba;                // !< sub request: start of the range rebuilt
+    fbe_block_count_t               rebuilt_blocks;             // !< sub request: blocks rebuilt, 0 if none
+    fbe_raid_position_bitmask_t     rebuilt_bitmask;            // !< sub request: positions rebuilt
+    fbe_status_t                    sub_request_status;         // !< sub request: completion status
+    fbe_time_t                      start_time;                 // !< time the rebuild I/O was sent
+    fbe_u32_t                       service_time_ms;            // !< sub request: time the I/O took
 }
 fbe_raid_group_rebuild_context_t;
 
@@ -681,4 +718,14 @@ fbe_status_t fbe_raid_group_rebuild_peer_memory_udpate(fbe_raid_group_t *raid_gr
 
 fbe_status_t fbe_raid_group_rebuild_set_background_op_chunks(fbe_u32_t chunks_per_rebuild);
 
+fbe_status_t fbe_raid_group_rebuild_set_max_concurrent_ios(fbe_u32_t max_concurrent_ios);
+
+fbe_status_t fbe_raid_group_rebuild_set_catch_up_window(fbe_block_count_t catch_up_window_blocks);
+
+fbe_status_t fbe_raid_group_rebuild_send_concurrent_io_request(fbe_raid_group_t *raid_group_p, 
+                                                               fbe_packet_t *packet_p,
+                                                               fbe_u32_t sub_request_count,
+                                                               fbe_block_count_t sub_request_blocks,
+                                                               fbe_raid_group_rebuild_send_io_function_t send_io_function);
+
 #endif // FBE_RAID_GROUP_REBUILD_H
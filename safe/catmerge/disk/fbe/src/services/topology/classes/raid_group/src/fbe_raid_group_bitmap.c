@@ -1977,42 +1977,85 @@ fbe_status_t fbe_raid_group_update_verify_checkpoint(
     }
     else
     {
-        fbe_u32_t    ms_since_checkpoint;
-        fbe_time_t  last_checkpoint_time;
-        fbe_u32_t   peer_update_period_ms;
-
-        fbe_raid_group_get_last_checkpoint_time(raid_group_p, &last_checkpoint_time);
-        ms_since_checkpoint = fbe_get_elapsed_milliseconds(last_checkpoint_time);
-        fbe_raid_group_class_get_peer_update_checkpoint_interval_ms(&peer_update_period_ms);
-        if (ms_since_checkpoint > peer_update_period_ms)
-        {
-            /* Periodically we will set the checkpoint to the peer. 
-             * A set is needed since the peer might be out of date with us and an increment 
-             * will not suffice. 
-             */
-            status = fbe_base_config_metadata_nonpaged_force_set_checkpoint((fbe_base_config_t *)raid_group_p,
-                                                                            packet_p,
-                                                                            metadata_offset,
-                                                                            second_metadata_offset,
-                                                                            start_lba + block_count);
-            fbe_raid_group_update_last_checkpoint_time(raid_group_p);
-        }
-        else
-        {
-            /* Increment checkpoint locally without sending to peer in order to not 
-             * thrash the CMI. 
-             */
-            status = fbe_base_config_metadata_nonpaged_incr_checkpoint_no_peer((fbe_base_config_t *)raid_group_p,
-                                                                               packet_p,
-                                                                               metadata_offset,
-                                                                               second_metadata_offset,
-                                                                               start_lba,
-                                                                               block_count);
-        }
+        /* Only send the checkpoint to the peer once in a while so we do not thrash the CMI.
+         */
+        status = fbe_raid_group_batch_checkpoint(raid_group_p, packet_p,
+                                                 fbe_raid_group_is_checkpoint_peer_update_due(raid_group_p),
+                                                 metadata_offset,
+                                                 second_metadata_offset,
+                                                 start_lba,
+                                                 block_count);
     }
     return FBE_STATUS_MORE_PROCESSING_REQUIRED;
 }// End fbe_raid_group_update_verify_checkpoint
 
+/*!****************************************************************************
+ * fbe_raid_group_is_checkpoint_peer_update_due()
+ ******************************************************************************
+ * @brief
+ *   Determine if a background operation that batches its checkpoint by time
+ *   should also send the checkpoint to the peer.
+ *
+ * @param raid_group_p - pointer to the raid group
+ *
+ * @return fbe_bool_t - FBE_TRUE if the peer update interval has passed.
+ *
+ ******************************************************************************/
+fbe_bool_t fbe_raid_group_is_checkpoint_peer_update_due(fbe_raid_group_t *raid_group_p)
+{
+    fbe_time_t  last_checkpoint_time;
+    fbe_u32_t   peer_update_period_ms;
+
+    fbe_raid_group_get_last_checkpoint_time(raid_group_p, &last_checkpoint_time);
+    fbe_raid_group_class_get_peer_update_checkpoint_interval_ms(&peer_update_period_ms);
+    return (fbe_get_elapsed_milliseconds(last_checkpoint_time) > peer_update_period_ms);
+}
+/******************************************************************************
+ * end fbe_raid_group_is_checkpoint_peer_update_due()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * fbe_raid_group_batch_checkpoint()
+ ******************************************************************************
+ * @brief
+ *   Move a background operation checkpoint forward by block_count.  When
+ *   the peer is updated we also restart the peer update interval.
+ *
+ * @param raid_group_p - pointer to the raid group
+ * @param packet_p - packet to use for the nonpaged update
+ * @param b_update_peer - FBE_TRUE to also send the checkpoint to the peer
+ * @param metadata_offset - offset of the checkpoint in the nonpaged
+ * @param second_metadata_offset - offset of a second checkpoint or 0
+ * @param checkpoint - current checkpoint
+ * @param block_count - blocks to move the checkpoint by
+ *
+ * @return fbe_status_t
+ *
+ ******************************************************************************/
+fbe_status_t fbe_raid_group_batch_checkpoint(fbe_raid_group_t *raid_group_p,
+                                             fbe_packet_t *packet_p,
+                                             fbe_bool_t b_update_peer,
+                                             fbe_u64_t metadata_offset,
+                                             fbe_u64_t second_metadata_offset,
+                                             fbe_lba_t checkpoint,
+                                             fbe_block_count_t block_count)
+{
+    if (b_update_peer)
+    {
+        fbe_raid_group_update_last_checkpoint_time(raid_group_p);
+    }
+    return fbe_base_config_metadata_nonpaged_batch_checkpoint((fbe_base_config_t *)raid_group_p,
+                                                              packet_p,
+                                                              b_update_peer,
+                                                              metadata_offset,
+                                                              second_metadata_offset,
+                                                              checkpoint,
+                                                              block_count);
+}
+/******************************************************************************
+ * end fbe_raid_group_batch_checkpoint()
+ ******************************************************************************/
+
 /*!****************************************************************************
  * fbe_raid_group_ask_upstream_for_permission()
  ******************************************************************************
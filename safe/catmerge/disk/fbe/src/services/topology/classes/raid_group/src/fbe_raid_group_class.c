@@ -94,6 +94,8 @@ static fbe_status_t fbe_raid_group_class_get_extended_media_error_handling(fbe_p
 static fbe_status_t fbe_raid_group_class_set_extended_media_error_handling(fbe_packet_t * packet_p);
 static void fbe_raid_group_class_set_extended_media_error_handling_params(fbe_u32_t emeh_params);
 static fbe_status_t fbe_raid_group_class_set_chunks_per_rebuild(fbe_packet_t * packet_p);
+static fbe_status_t fbe_raid_group_class_set_max_concurrent_rebuild_ios(fbe_packet_t * packet_p);
+static fbe_status_t fbe_raid_group_class_set_rebuild_catch_up_window(fbe_packet_t * packet_p);
 
 /*!***************************************************************
  * fbe_raid_group_class_is_max_drive_blocks_configured()
@@ -352,6 +354,14 @@ fbe_raid_group_class_control_entry(fbe_packet_t * packet)
             status = fbe_raid_group_class_set_chunks_per_rebuild(packet);
             break;
 
+        case FBE_RAID_GROUP_CONTROL_CODE_CLASS_SET_MAX_CONCURRENT_REBUILD_IOS:
+            status = fbe_raid_group_class_set_max_concurrent_rebuild_ios(packet);
+            break;
+
+        case FBE_RAID_GROUP_CONTROL_CODE_CLASS_SET_REBUILD_CATCH_UP_WINDOW:
+            status = fbe_raid_group_class_set_rebuild_catch_up_window(packet);
+            break;
+
         default:
             fbe_transport_set_status(packet, FBE_STATUS_GENERIC_FAILURE, 0);
             status = fbe_transport_complete_packet(packet);
@@ -3566,6 +3576,125 @@ static fbe_status_t fbe_raid_group_class_set_chunks_per_rebuild(fbe_packet_t * p
  * end fbe_raid_group_class_set_chunks_per_rebuild()
  ******************************************************************************/
 
+/*!****************************************************************************
+ * fbe_raid_group_class_set_max_concurrent_rebuild_ios()
+ ******************************************************************************
+ * @brief
+ *  Set the maximum number of rebuild I/Os each raid group has in flight.
+ *
+ * @param packet_p - The packet that is arriving.
+ *
+ * @return fbe_status_t
+ *
+ ******************************************************************************/
+static fbe_status_t fbe_raid_group_class_set_max_concurrent_rebuild_ios(fbe_packet_t * packet_p)
+{
+    fbe_status_t                                            status = FBE_STATUS_OK;
+    fbe_payload_control_operation_t                        *control_operation_p = NULL;
+    fbe_payload_ex_t                                       *sep_payload_p = NULL;
+    fbe_raid_group_class_set_max_concurrent_rebuild_ios_t  *set_max_ios_p = NULL;
+    fbe_payload_control_buffer_length_t                     length = 0;
+
+    /* get the control operation of the packet. */
+    sep_payload_p = fbe_transport_get_payload_ex(packet_p);
+    control_operation_p = fbe_payload_ex_get_control_operation(sep_payload_p);  
+    fbe_payload_control_get_buffer(control_operation_p, &set_max_ios_p);
+    fbe_payload_control_get_buffer_length(control_operation_p, &length);
+
+    /* Validate the buffer and its length.
+     */
+    if ((set_max_ios_p == NULL) ||
+        (length != sizeof(*set_max_ios_p)))
+    {
+        fbe_topology_class_trace(FBE_CLASS_ID_RAID_GROUP, 
+                                 FBE_TRACE_LEVEL_WARNING, 
+                                 FBE_TRACE_MESSAGE_ID_INFO,
+                                 "raid group: %s line: %d bad buffer: %p length: 0x%x\n",
+                                 __FUNCTION__, __LINE__, set_max_ios_p, length);
+        fbe_payload_control_set_status(control_operation_p, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
+        fbe_transport_set_status(packet_p, FBE_STATUS_GENERIC_FAILURE, 0);
+        fbe_transport_complete_packet(packet_p);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    status = fbe_raid_group_rebuild_set_max_concurrent_ios(set_max_ios_p->max_concurrent_ios);
+    if (status != FBE_STATUS_OK)
+    {
+        fbe_payload_control_set_status(control_operation_p, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
+        fbe_transport_set_status(packet_p, FBE_STATUS_GENERIC_FAILURE, 0);
+        fbe_transport_complete_packet(packet_p);
+        return FBE_STATUS_GENERIC_FAILURE;
+    } 
+
+    fbe_payload_control_set_status(control_operation_p, FBE_PAYLOAD_CONTROL_STATUS_OK);
+    fbe_transport_set_status(packet_p, FBE_STATUS_OK, 0);
+    fbe_transport_complete_packet(packet_p);
+    return FBE_STATUS_OK;
+}
+/******************************************************************************
+ * end fbe_raid_group_class_set_max_concurrent_rebuild_ios()
+ ******************************************************************************/
+
+/*!****************************************************************************
+ * fbe_raid_group_class_set_rebuild_catch_up_window()
+ ******************************************************************************
+ * @brief
+ *  Set how many blocks a rebuild position can be behind another one and
+ *  still be rebuilt first to catch up to it.
+ *
+ * @param packet_p - The packet that is arriving.
+ *
+ * @return fbe_status_t
+ *
+ ******************************************************************************/
+static fbe_status_t fbe_raid_group_class_set_rebuild_catch_up_window(fbe_packet_t * packet_p)
+{
+    fbe_status_t                                        status = FBE_STATUS_OK;
+    fbe_payload_control_operation_t                    *control_operation_p = NULL;
+    fbe_payload_ex_t                                   *sep_payload_p = NULL;
+    fbe_raid_group_class_set_rebuild_catch_up_window_t *set_window_p = NULL;
+    fbe_payload_control_buffer_length_t                 length = 0;
+
+    /* get the control operation of the packet. */
+    sep_payload_p = fbe_transport_get_payload_ex(packet_p);
+    control_operation_p = fbe_payload_ex_get_control_operation(sep_payload_p);  
+    fbe_payload_control_get_buffer(control_operation_p, &set_window_p);
+    fbe_payload_control_get_buffer_length(control_operation_p, &length);
+
+    /* Validate the buffer and its length.
+     */
+    if ((set_window_p == NULL) ||
+        (length != sizeof(*set_window_p)))
+    {
+        fbe_topology_class_trace(FBE_CLASS_ID_RAID_GROUP, 
+                                 FBE_TRACE_LEVEL_WARNING, 
+                                 FBE_TRACE_MESSAGE_ID_INFO,
+                                 "raid group: %s line: %d bad buffer: %p length: 0x%x\n",
+                                 __FUNCTION__, __LINE__, set_window_p, length);
+        fbe_payload_control_set_status(control_operation_p, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
+        fbe_transport_set_status(packet_p, FBE_STATUS_GENERIC_FAILURE, 0);
+        fbe_transport_complete_packet(packet_p);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    status = fbe_raid_group_rebuild_set_catch_up_window(set_window_p->catch_up_window_blocks);
+    if (status != FBE_STATUS_OK)
+    {
+        fbe_payload_control_set_status(control_operation_p, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
+        fbe_transport_set_status(packet_p, FBE_STATUS_GENERIC_FAILURE, 0);
+        fbe_transport_complete_packet(packet_p);
+        return FBE_STATUS_GENERIC_FAILURE;
+    } 
+
+    fbe_payload_control_set_status(control_operation_p, FBE_PAYLOAD_CONTROL_STATUS_OK);
+    fbe_transport_set_status(packet_p, FBE_STATUS_OK, 0);
+    fbe_transport_complete_packet(packet_p);
+    return FBE_STATUS_OK;
+}
+/******************************************************************************
+ * end fbe_raid_group_class_set_rebuild_catch_up_window()
+ ******************************************************************************/
+
 
 /******************************
  * end fbe_raid_group_class.c
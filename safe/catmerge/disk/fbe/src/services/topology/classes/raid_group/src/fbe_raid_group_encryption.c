@@ -870,44 +870,26 @@ static fbe_status_t fbe_raid_group_incr_rekey_checkpoint(fbe_raid_group_t *raid_
 {
     fbe_status_t    status;
     fbe_u64_t       metadata_offset;
-    fbe_u32_t       ms_since_checkpoint;
-    fbe_time_t      last_checkpoint_time;
-    fbe_u32_t       peer_update_period_ms;
+    fbe_bool_t      b_update_peer;
     fbe_lba_t       exported_per_disk_capacity = 0;
 
     metadata_offset = (fbe_u64_t) (&((fbe_raid_group_nonpaged_metadata_t*)0)->encryption.rekey_checkpoint);
 
-    fbe_raid_group_get_last_checkpoint_time(raid_group_p, &last_checkpoint_time);
+    /* Periodically we will set the checkpoint to the peer, and always when the rekey finishes. 
+     * Otherwise the checkpoint is only incremented locally in order to not thrash the CMI. 
+     */
     exported_per_disk_capacity = fbe_raid_group_get_exported_disk_capacity(raid_group_p);
-    ms_since_checkpoint = fbe_get_elapsed_milliseconds(last_checkpoint_time);
-    fbe_raid_group_class_get_peer_update_checkpoint_interval_ms(&peer_update_period_ms);
-    if ((ms_since_checkpoint > peer_update_period_ms)             ||
-        ((start_lba + block_count) == exported_per_disk_capacity)    )
+    b_update_peer = (fbe_raid_group_is_checkpoint_peer_update_due(raid_group_p) ||
+                     ((start_lba + block_count) == exported_per_disk_capacity));
+    if (b_update_peer)
     {
-        /* Periodically we will set the checkpoint to the peer. 
-         * A set is needed since the peer might be out of date with us and an increment 
-         * will not suffice. 
-         */
-        status = fbe_base_config_metadata_nonpaged_force_set_checkpoint((fbe_base_config_t *)raid_group_p,
-                                                                        packet_p,
-                                                                        metadata_offset,
-                                                                        0,
-                                                                        start_lba + block_count);
-        fbe_raid_group_update_last_checkpoint_time(raid_group_p);
         fbe_raid_group_update_last_checkpoint_to_peer(raid_group_p, start_lba + block_count);
     }
-    else
-    {
-        /* Increment checkpoint locally without sending to peer in order to not 
-         * thrash the CMI. 
-         */
-        status = fbe_base_config_metadata_nonpaged_incr_checkpoint_no_peer((fbe_base_config_t *)raid_group_p,
-                                                                           packet_p,
-                                                                           metadata_offset,
-                                                                           0,
-                                                                           start_lba,
-                                                                           block_count);
-    }
+    status = fbe_raid_group_batch_checkpoint(raid_group_p, packet_p, b_update_peer,
+                                             metadata_offset,
+                                             0,
+                                             start_lba,
+                                             block_count);
         
     //  Check the status of the call and trace if error.  The called function is completing the packet on error
     //  so we can't complete it here.  The condition will remain set so we will try again.
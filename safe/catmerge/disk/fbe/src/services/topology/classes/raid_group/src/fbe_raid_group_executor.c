@@ -56,6 +56,7 @@
 #include "fbe_raid_group_bitmap.h"
 #include "fbe_raid_verify.h"
 #include "fbe_raid_group_needs_rebuild.h"
+#include "fbe_raid_group_read_ahead.h"
 #include "fbe_raid_library_proto.h"
 #include "fbe_traffic_trace.h"
 #include "EmcPAL_Misc.h"
@@ -214,6 +215,14 @@ fbe_status_t fbe_raid_group_block_transport_entry(fbe_transport_entry_context_t
             return FBE_STATUS_PENDING;
         }
 
+        /* Sequential reads may be completed from the read-ahead buffers, 
+         * writes drop the buffers they overlap. 
+         */
+        if (fbe_raid_group_read_ahead_handle_io(raid_group_p, packet_p, block_opcode, lba, blocks))
+        {
+            return FBE_STATUS_PENDING;
+        }
+
         /* Only read and write non-metadata operations use direct I/O.
          */
         if (((block_opcode == FBE_PAYLOAD_BLOCK_OPERATION_OPCODE_READ) || 
@@ -397,6 +397,7 @@ fbe_status_t fbe_raid_group_monitor_run_journal_verify_completion(fbe_packet_t *
     fbe_u64_t                           metadata_offset;
     fbe_scheduler_hook_status_t          hook_status = FBE_SCHED_STATUS_OK;
     fbe_status_t                        status;
+    fbe_bool_t                          b_update_peer;
      
     raid_group_p = (fbe_raid_group_t*)context;
     status = fbe_transport_get_status_code(packet_p);
@@ -446,15 +447,24 @@ fbe_status_t fbe_raid_group_monitor_run_journal_verify_completion(fbe_packet_t *
 
     }
 
-    /* Otherwise just increment the checkpoint */
+    /* Otherwise just increment the checkpoint.  Only send it to the peer once it has
+     * moved far enough since the last time we sent it.
+     */
     else
     {
-        fbe_base_config_metadata_nonpaged_incr_checkpoint((fbe_base_config_t *)raid_group_p,
-                                                          packet_p,
-                                                          metadata_offset,
-                                                          0, /* There is only (1) checkpoint for a verify */
-                                                          current_checkpoint,
-                                                          block_count);
+        raid_group_p->journal_verify_blocks_since_peer_update += block_count;
+        b_update_peer = fbe_base_config_checkpoint_is_peer_update_due(raid_group_p->journal_verify_blocks_since_peer_update);
+        if (b_update_peer)
+        {
+            raid_group_p->journal_verify_blocks_since_peer_update = 0;
+        }
+        fbe_base_config_metadata_nonpaged_batch_checkpoint((fbe_base_config_t *)raid_group_p,
+                                                           packet_p,
+                                                           b_update_peer,
+                                                           metadata_offset,
+                                                           0, /* There is only (1) checkpoint for a verify */
+                                                           current_checkpoint,
+                                                           block_count);
 
         return FBE_STATUS_MORE_PROCESSING_REQUIRED;
     }
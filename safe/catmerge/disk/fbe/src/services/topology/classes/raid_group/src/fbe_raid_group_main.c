@@ -28,6 +28,7 @@
 #include "fbe_base_config_private.h"
 #include "fbe_raid_group_object.h"
 #include "fbe_raid_group_bitmap.h"    
+#include "fbe_raid_group_read_ahead.h"
 #include "fbe/fbe_notification_interface.h"
 #include "fbe_notification.h"
 #include "fbe_raid_library.h"
@@ -323,6 +324,14 @@ fbe_raid_group_init(fbe_raid_group_t * const raid_group_p,
     /* Initialize the timestamp used to keep track of how long waiting for a RG to go broken */
     fbe_raid_group_set_check_rg_broken_timestamp(raid_group_p, 0);
 
+    /* Read-ahead state is allocated when the raid group activates.
+     */
+    raid_group_p->read_ahead_p = NULL;
+
+    /* The rebuild starts with a single I/O of the default size.
+     */
+    fbe_zero_memory(&raid_group_p->rebuild_tuning, sizeof(fbe_raid_group_rebuild_tuning_t));
+
     /*clear the list of degraded pvs we use to send notification to*/
     for (index = 0; index < FBE_RAID_GROUP_MAX_REBUILD_POSITIONS; index++)
     {
@@ -423,6 +432,7 @@ fbe_raid_group_destroy(fbe_object_handle_t object_handle)
     if (bg_op_p != NULL) {
         fbe_memory_native_release(bg_op_p);
     }
+    fbe_raid_group_read_ahead_destroy(raid_group_p);
     return status;
 }
 /* end fbe_raid_group_destroy */
@@ -46,6 +46,7 @@
 #include "fbe/fbe_event_log_api.h"                      //  for fbe_event_log_write
 #include "fbe/fbe_event_log_utils.h"                    //  for message codes
 #include "fbe_raid_group_expansion.h"
+#include "fbe_raid_group_read_ahead.h"
 
 /*!***************************************************************
  * fbe_raid_group_monitor_entry()
@@ -7641,6 +7642,10 @@ raid_group_peer_death_release_sl_function(fbe_base_object_t * base_object_p, fbe
      */
     fbe_raid_group_background_op_peer_died_cleanup(raid_group_p);
 
+    /* We are alone now, so read-ahead may be used.
+     */
+    fbe_raid_group_read_ahead_init(raid_group_p);
+
     fbe_metadata_element_clear_abort_monitor_ops(&((fbe_base_config_t *)raid_group_p)->metadata_element);
 
     /* clear the condition. */
@@ -7837,6 +7842,10 @@ fbe_raid_group_eval_rl_activate_cond_function(fbe_base_object_t * object, fbe_pa
     }
     
              
+    /* Read-ahead runs on the active side only, allocate it before we go ready.
+     */
+    fbe_raid_group_read_ahead_init(raid_group_p);
+
     /* When the activate eval is done, we need to set this local state so we know that
      * we perfomed the eval as active. The passive side needs this if it becomes active.
      */
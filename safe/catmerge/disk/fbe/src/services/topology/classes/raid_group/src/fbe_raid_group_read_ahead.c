@@ -0,0 +1,728 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2009-2014
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!**************************************************************************
+ * @file fbe_raid_group_read_ahead.c
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains the sequential stream detection and read-ahead of the
+ *  striper and parity raid groups.
+ *
+ *  Small host reads which follow each other back to back form a stream.
+ *  Once a stream is detected we read ahead of it into a few buffers of the
+ *  raid group, with ordinary reads sent to ourselves through the bouncer.
+ *  A later read which lies entirely within a filled buffer is copied from
+ *  the buffer and completed without drive I/O.
+ *
+ *  Every write (or other media modify) to the raid group drops the buffers
+ *  it overlaps, both when it arrives and when it completes, so a read-ahead
+ *  racing with the write is never used.
+ *
+ *  Read-ahead is single SP only.  The peer's writes are not seen here and
+ *  are not invalidated through the stripe locks or CMI, so reads are never
+ *  served from a buffer while the peer is alive.
+ *
+ *  The state and buffers are allocated once when the raid group activates
+ *  and released when it is destroyed, so the I/O path never allocates.  At
+ *  most FBE_RAID_GROUP_READ_AHEAD_MAX_POOLS raid groups hold buffers, when
+ *  memory is not available the raid group simply does not read ahead.
+ *
+ * @version
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "fbe_raid_group_read_ahead.h"
+#include "fbe_base_config_private.h"
+#include "fbe_raid_geometry.h"
+#include "fbe_transport_memory.h"
+#include "fbe_cmi.h"
+
+/*!*******************************************************************
+ * @var fbe_raid_group_read_ahead_pools
+ *********************************************************************
+ * @brief Number of raid groups currently holding read-ahead buffers.
+ *
+ *********************************************************************/
+static fbe_atomic_t fbe_raid_group_read_ahead_pools = 0;
+
+/*************************
+ *   FORWARD DECLARATIONS
+ *************************/
+static fbe_status_t fbe_raid_group_read_ahead_completion(fbe_packet_t *packet_p,
+                                                         fbe_packet_completion_context_t context);
+static fbe_status_t fbe_raid_group_read_ahead_write_completion(fbe_packet_t *packet_p,
+                                                               fbe_packet_completion_context_t context);
+
+/*!**************************************************************
+ * fbe_raid_group_read_ahead_is_own_packet()
+ ****************************************************************
+ * @brief
+ *  Determine if this is one of our own read-ahead reads.
+ *
+ * @param read_ahead_p - Read-ahead state.
+ * @param packet_p - Packet arriving at the raid group.
+ *
+ * @return fbe_bool_t
+ *
+ ****************************************************************/
+static fbe_bool_t fbe_raid_group_read_ahead_is_own_packet(fbe_raid_group_read_ahead_t *read_ahead_p,
+                                                          fbe_packet_t *packet_p)
+{
+    fbe_sg_element_t *sg_p = NULL;
+    fbe_u32_t index;
+
+    fbe_payload_ex_get_sg_list(fbe_transport_get_payload_ex(packet_p), &sg_p, NULL);
+    for (index = 0; index < FBE_RAID_GROUP_READ_AHEAD_MAX_BUFFERS; index++)
+    {
+        if (sg_p == &read_ahead_p->buffers[index].sg[0])
+        {
+            return FBE_TRUE;
+        }
+    }
+    return FBE_FALSE;
+}
+/******************************************
+ * end fbe_raid_group_read_ahead_is_own_packet()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_raid_group_read_ahead_invalidate()
+ ****************************************************************
+ * @brief
+ *  Drop every buffer overlapping a range that was written.  A
+ *  read-ahead still outstanding is marked stale and dropped when
+ *  it completes.
+ *
+ * @param raid_group_p - Raid group.
+ * @param lba - Start of the range written.
+ * @param blocks - Size of the range written.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void fbe_raid_group_read_ahead_invalidate(fbe_raid_group_t *raid_group_p,
+                                                 fbe_lba_t lba,
+                                                 fbe_block_count_t blocks)
+{
+    fbe_raid_group_read_ahead_t *read_ahead_p = raid_group_p->read_ahead_p;
+    fbe_raid_group_read_ahead_buffer_t *buffer_p = NULL;
+    fbe_raid_group_read_ahead_stream_t *stream_p = NULL;
+    fbe_u32_t index;
+
+    if (read_ahead_p == NULL)
+    {
+        return;
+    }
+
+    fbe_spinlock_lock(&read_ahead_p->lock);
+    for (index = 0; index < FBE_RAID_GROUP_READ_AHEAD_MAX_BUFFERS; index++)
+    {
+        buffer_p = &read_ahead_p->buffers[index];
+        if ((buffer_p->state == FBE_RAID_GROUP_READ_AHEAD_BUFFER_FREE) ||
+            (lba >= buffer_p->lba + buffer_p->blocks) ||
+            (lba + blocks <= buffer_p->lba))
+        {
+            continue;
+        }
+        if (buffer_p->state == FBE_RAID_GROUP_READ_AHEAD_BUFFER_READING)
+        {
+            buffer_p->b_stale = FBE_TRUE;
+        }
+        else
+        {
+            buffer_p->state = FBE_RAID_GROUP_READ_AHEAD_BUFFER_FREE;
+        }
+    }
+
+    /* Read the written part of a stream ahead again.
+     */
+    for (index = 0; index < FBE_RAID_GROUP_READ_AHEAD_MAX_STREAMS; index++)
+    {
+        stream_p = &read_ahead_p->streams[index];
+        if ((stream_p->next_lba != FBE_LBA_INVALID) &&
+            (lba < stream_p->read_ahead_lba) &&
+            (lba + blocks > stream_p->next_lba))
+        {
+            stream_p->read_ahead_lba = FBE_MAX(lba, stream_p->next_lba);
+        }
+    }
+    fbe_spinlock_unlock(&read_ahead_p->lock);
+    return;
+}
+/******************************************
+ * end fbe_raid_group_read_ahead_invalidate()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_raid_group_read_ahead_get_buffer()
+ ****************************************************************
+ * @brief
+ *  Find a buffer to read ahead into.  Free buffers are used first,
+ *  then filled buffers the stream already passed or nobody used.
+ *  The lock must be held.
+ *
+ * @param read_ahead_p - Read-ahead state.
+ * @param stream_p - Stream we read ahead for.
+ * @param current_time - Now.
+ *
+ * @return fbe_raid_group_read_ahead_buffer_t * - NULL if none.
+ *
+ ****************************************************************/
+static fbe_raid_group_read_ahead_buffer_t *
+fbe_raid_group_read_ahead_get_buffer(fbe_raid_group_read_ahead_t *read_ahead_p,
+                                     fbe_raid_group_read_ahead_stream_t *stream_p,
+                                     fbe_time_t current_time)
+{
+    fbe_raid_group_read_ahead_buffer_t *buffer_p = NULL;
+    fbe_raid_group_read_ahead_buffer_t *reuse_p = NULL;
+    fbe_u32_t index;
+
+    for (index = 0; index < FBE_RAID_GROUP_READ_AHEAD_MAX_BUFFERS; index++)
+    {
+        buffer_p = &read_ahead_p->buffers[index];
+        if (buffer_p->copy_count != 0)
+        {
+            continue;
+        }
+        if (buffer_p->state == FBE_RAID_GROUP_READ_AHEAD_BUFFER_FREE)
+        {
+            return buffer_p;
+        }
+        if ((buffer_p->state == FBE_RAID_GROUP_READ_AHEAD_BUFFER_VALID) &&
+            (((buffer_p->lba + buffer_p->blocks) <= stream_p->next_lba) ||
+             ((current_time - buffer_p->fill_time) > FBE_RAID_GROUP_READ_AHEAD_IDLE_MS)))
+        {
+            reuse_p = buffer_p;
+        }
+    }
+    return reuse_p;
+}
+/******************************************
+ * end fbe_raid_group_read_ahead_get_buffer()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_raid_group_read_ahead_send()
+ ****************************************************************
+ * @brief
+ *  Send a read-ahead read for a buffer to ourselves.  It goes
+ *  through the bouncer like any other read, so quiesce waits
+ *  for it.
+ *
+ * @param raid_group_p - Raid group.
+ * @param buffer_p - Buffer with the range to read.
+ * @param host_packet_p - Read of the stream, for the cpu and priority.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void fbe_raid_group_read_ahead_send(fbe_raid_group_t *raid_group_p,
+                                           fbe_raid_group_read_ahead_buffer_t *buffer_p,
+                                           fbe_packet_t *host_packet_p)
+{
+    fbe_raid_group_read_ahead_t *read_ahead_p = raid_group_p->read_ahead_p;
+    fbe_packet_t *packet_p = NULL;
+    fbe_payload_ex_t *payload_p = NULL;
+    fbe_payload_block_operation_t *block_operation_p = NULL;
+    fbe_cpu_id_t cpu_id;
+
+    packet_p = fbe_transport_allocate_packet();
+    if (packet_p == NULL)
+    {
+        fbe_spinlock_lock(&read_ahead_p->lock);
+        buffer_p->state = FBE_RAID_GROUP_READ_AHEAD_BUFFER_FREE;
+        read_ahead_p->reads_outstanding--;
+        fbe_spinlock_unlock(&read_ahead_p->lock);
+        return;
+    }
+    fbe_transport_initialize_sep_packet(packet_p);
+    payload_p = fbe_transport_get_payload_ex(packet_p);
+    block_operation_p = fbe_payload_ex_allocate_block_operation(payload_p);
+    fbe_payload_block_build_operation(block_operation_p,
+                                      FBE_PAYLOAD_BLOCK_OPERATION_OPCODE_READ,
+                                      buffer_p->lba,
+                                      buffer_p->blocks,
+                                      FBE_BE_BYTES_PER_BLOCK,
+                                      1,    /* optimum block size */
+                                      NULL);
+    fbe_sg_element_init(&buffer_p->sg[0], (fbe_u32_t)(buffer_p->blocks * FBE_BE_BYTES_PER_BLOCK), buffer_p->data_p);
+    fbe_sg_element_terminate(&buffer_p->sg[1]);
+    fbe_payload_ex_set_sg_list(payload_p, &buffer_p->sg[0], 1);
+
+    fbe_transport_get_cpu_id(host_packet_p, &cpu_id);
+    fbe_transport_set_cpu_id(packet_p, cpu_id);
+    fbe_transport_set_resource_priority(packet_p, fbe_transport_get_resource_priority(host_packet_p));
+
+    fbe_transport_set_completion_function(packet_p, fbe_raid_group_read_ahead_completion, raid_group_p);
+    fbe_payload_ex_increment_block_operation_level(payload_p);
+
+    fbe_raid_group_trace(raid_group_p, FBE_TRACE_LEVEL_INFO, FBE_RAID_GROUP_DEBUG_FLAG_IO_TRACING,
+                         "read ahead: pkt: %p lba: 0x%llx bl: 0x%llx\n",
+                         packet_p, (unsigned long long)buffer_p->lba, (unsigned long long)buffer_p->blocks);
+
+    fbe_base_config_bouncer_entry((fbe_base_config_t *)raid_group_p, packet_p);
+    return;
+}
+/******************************************
+ * end fbe_raid_group_read_ahead_send()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_raid_group_read_ahead_completion()
+ ****************************************************************
+ * @brief
+ *  A read-ahead read finished.  The buffer becomes usable unless
+ *  the read failed or a write overlapped it meanwhile.
+ *
+ * @param packet_p - Read-ahead packet.
+ * @param context - Raid group.
+ *
+ * @return FBE_STATUS_MORE_PROCESSING_REQUIRED - packet is freed.
+ *
+ ****************************************************************/
+static fbe_status_t fbe_raid_group_read_ahead_completion(fbe_packet_t *packet_p,
+                                                         fbe_packet_completion_context_t context)
+{
+    fbe_raid_group_t *raid_group_p = (fbe_raid_group_t *)context;
+    fbe_raid_group_read_ahead_t *read_ahead_p = raid_group_p->read_ahead_p;
+    fbe_raid_group_read_ahead_buffer_t *buffer_p = NULL;
+    fbe_payload_ex_t *payload_p = fbe_transport_get_payload_ex(packet_p);
+    fbe_payload_block_operation_t *block_operation_p = fbe_payload_ex_get_block_operation(payload_p);
+    fbe_payload_block_operation_status_t block_status;
+    fbe_sg_element_t *sg_p = NULL;
+    fbe_status_t status;
+    fbe_u32_t index;
+
+    status = fbe_transport_get_status_code(packet_p);
+    fbe_payload_block_get_status(block_operation_p, &block_status);
+    fbe_payload_ex_get_sg_list(payload_p, &sg_p, NULL);
+
+    fbe_spinlock_lock(&read_ahead_p->lock);
+    for (index = 0; index < FBE_RAID_GROUP_READ_AHEAD_MAX_BUFFERS; index++)
+    {
+        buffer_p = &read_ahead_p->buffers[index];
+        if (sg_p == &buffer_p->sg[0])
+        {
+            if ((status == FBE_STATUS_OK) &&
+                (block_status == FBE_PAYLOAD_BLOCK_OPERATION_STATUS_SUCCESS) &&
+                !buffer_p->b_stale)
+            {
+                buffer_p->state = FBE_RAID_GROUP_READ_AHEAD_BUFFER_VALID;
+                buffer_p->fill_time = fbe_get_time();
+            }
+            else
+            {
+                buffer_p->state = FBE_RAID_GROUP_READ_AHEAD_BUFFER_FREE;
+            }
+            break;
+        }
+    }
+    read_ahead_p->reads_outstanding--;
+    fbe_spinlock_unlock(&read_ahead_p->lock);
+
+    fbe_payload_ex_release_block_operation(payload_p, block_operation_p);
+    fbe_transport_release_packet(packet_p);
+    return FBE_STATUS_MORE_PROCESSING_REQUIRED;
+}
+/******************************************
+ * end fbe_raid_group_read_ahead_completion()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_raid_group_read_ahead_write_completion()
+ ****************************************************************
+ * @brief
+ *  A write finished, drop the buffers it overlaps.  This catches
+ *  read-aheads which read the range before the write got there.
+ *
+ * @param packet_p - Write packet.
+ * @param context - Raid group.
+ *
+ * @return FBE_STATUS_OK
+ *
+ ****************************************************************/
+static fbe_status_t fbe_raid_group_read_ahead_write_completion(fbe_packet_t *packet_p,
+                                                               fbe_packet_completion_context_t context)
+{
+    fbe_raid_group_t *raid_group_p = (fbe_raid_group_t *)context;
+    fbe_payload_ex_t *payload_p = fbe_transport_get_payload_ex(packet_p);
+    fbe_payload_block_operation_t *block_operation_p = fbe_payload_ex_get_block_operation(payload_p);
+    fbe_lba_t lba;
+    fbe_block_count_t blocks;
+
+    fbe_payload_block_get_lba(block_operation_p, &lba);
+    fbe_payload_block_get_block_count(block_operation_p, &blocks);
+    fbe_raid_group_read_ahead_invalidate(raid_group_p, lba, blocks);
+    return FBE_STATUS_OK;
+}
+/******************************************
+ * end fbe_raid_group_read_ahead_write_completion()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_raid_group_read_ahead_copy_to_sg()
+ ****************************************************************
+ * @brief
+ *  Copy data of a buffer into the sg list of a read.
+ *
+ * @param source_p - Data to copy.
+ * @param sg_p - Sg list of the read.
+ * @param bytes - Bytes to copy.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void fbe_raid_group_read_ahead_copy_to_sg(fbe_u8_t *source_p,
+                                                 fbe_sg_element_t *sg_p,
+                                                 fbe_u32_t bytes)
+{
+    fbe_u32_t copy_bytes;
+
+    while ((bytes > 0) && (sg_p->count != 0))
+    {
+        copy_bytes = FBE_MIN(bytes, sg_p->count);
+        fbe_copy_memory(sg_p->address, source_p, copy_bytes);
+        source_p += copy_bytes;
+        bytes -= copy_bytes;
+        sg_p++;
+    }
+    return;
+}
+/******************************************
+ * end fbe_raid_group_read_ahead_copy_to_sg()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_raid_group_read_ahead_handle_io()
+ ****************************************************************
+ * @brief
+ *  Look at a request arriving at the raid group.
+ *
+ *  Writes drop the buffers they overlap.  Reads update the stream
+ *  they belong to, start read-ahead for detected streams and are
+ *  completed from a buffer when it holds all of their data.
+ *  Reads are left alone while the peer is alive, see the file
+ *  header.
+ *
+ * @param raid_group_p - Raid group.
+ * @param packet_p - Arriving packet.
+ * @param opcode - Block opcode of the packet.
+ * @param lba - Start of the request.
+ * @param blocks - Size of the request.
+ *
+ * @return fbe_bool_t - FBE_TRUE if the read was completed here.
+ *
+ ****************************************************************/
+fbe_bool_t fbe_raid_group_read_ahead_handle_io(fbe_raid_group_t *raid_group_p,
+                                               fbe_packet_t *packet_p,
+                                               fbe_payload_block_operation_opcode_t opcode,
+                                               fbe_lba_t lba,
+                                               fbe_block_count_t blocks)
+{
+    fbe_raid_geometry_t *raid_geometry_p = fbe_raid_group_get_raid_geometry(raid_group_p);
+    fbe_raid_group_read_ahead_t *read_ahead_p = NULL;
+    fbe_raid_group_read_ahead_stream_t *stream_p = NULL;
+    fbe_raid_group_read_ahead_buffer_t *buffer_p = NULL;
+    fbe_raid_group_read_ahead_buffer_t *hit_p = NULL;
+    fbe_raid_group_read_ahead_buffer_t *send_p[FBE_RAID_GROUP_READ_AHEAD_DEPTH];
+    fbe_payload_ex_t *payload_p = NULL;
+    fbe_payload_block_operation_t *block_operation_p = NULL;
+    fbe_sg_element_t *sg_p = NULL;
+    fbe_time_t current_time;
+    fbe_lba_t capacity;
+    fbe_lba_t read_ahead_lba;
+    fbe_u32_t send_count = 0;
+    fbe_u32_t index;
+
+    if (((raid_geometry_p->class_id != FBE_CLASS_ID_STRIPER) &&
+         (raid_geometry_p->class_id != FBE_CLASS_ID_PARITY)) ||
+        !fbe_raid_geometry_is_user_io(raid_geometry_p, lba))
+    {
+        return FBE_FALSE;
+    }
+
+    if (opcode != FBE_PAYLOAD_BLOCK_OPERATION_OPCODE_READ)
+    {
+        if (fbe_payload_block_operation_opcode_is_media_modify(opcode))
+        {
+            fbe_raid_group_read_ahead_invalidate(raid_group_p, lba, blocks);
+            fbe_transport_set_completion_function(packet_p, fbe_raid_group_read_ahead_write_completion, raid_group_p);
+        }
+        return FBE_FALSE;
+    }
+
+    if ((blocks > FBE_RAID_GROUP_READ_AHEAD_MAX_IO_BLOCKS) ||
+        fbe_raid_group_is_debug_flag_set(raid_group_p, FBE_RAID_GROUP_DEBUG_FLAG_DISABLE_READ_AHEAD) ||
+        fbe_raid_group_io_rekeying(raid_group_p) ||
+        fbe_cmi_is_peer_alive())
+    {
+        return FBE_FALSE;
+    }
+
+    read_ahead_p = raid_group_p->read_ahead_p;
+    if ((read_ahead_p == NULL) ||
+        fbe_raid_group_read_ahead_is_own_packet(read_ahead_p, packet_p))
+    {
+        return FBE_FALSE;
+    }
+
+    current_time = fbe_get_time();
+    /* Never read ahead into the paged metadata.
+     */
+    fbe_raid_geometry_get_metadata_start_lba(raid_geometry_p, &capacity);
+
+    fbe_spinlock_lock(&read_ahead_p->lock);
+
+    /* Is all the data in a buffer?
+     */
+    for (index = 0; index < FBE_RAID_GROUP_READ_AHEAD_MAX_BUFFERS; index++)
+    {
+        buffer_p = &read_ahead_p->buffers[index];
+        if ((buffer_p->state == FBE_RAID_GROUP_READ_AHEAD_BUFFER_VALID) &&
+            (lba >= buffer_p->lba) &&
+            ((lba + blocks) <= (buffer_p->lba + buffer_p->blocks)) &&
+            ((current_time - buffer_p->fill_time) <= FBE_RAID_GROUP_READ_AHEAD_IDLE_MS))
+        {
+            hit_p = buffer_p;
+            hit_p->copy_count++;
+            read_ahead_p->hit_count++;
+            break;
+        }
+    }
+
+    /* Find the stream this read continues, or start a new one in place
+     * of the least recently used.
+     */
+    for (index = 0; index < FBE_RAID_GROUP_READ_AHEAD_MAX_STREAMS; index++)
+    {
+        if (read_ahead_p->streams[index].next_lba == lba)
+        {
+            stream_p = &read_ahead_p->streams[index];
+            stream_p->sequential_count++;
+            break;
+        }
+        if ((stream_p == NULL) ||
+            (read_ahead_p->streams[index].last_io_time < stream_p->last_io_time))
+        {
+            stream_p = &read_ahead_p->streams[index];
+        }
+    }
+    if (index == FBE_RAID_GROUP_READ_AHEAD_MAX_STREAMS)
+    {
+        stream_p->sequential_count = 1;
+        stream_p->read_ahead_lba = lba + blocks;
+    }
+    stream_p->next_lba = lba + blocks;
+    stream_p->last_io_time = current_time;
+    stream_p->read_ahead_lba = FBE_MAX(stream_p->read_ahead_lba, stream_p->next_lba);
+
+    /* Keep the stream read ahead by up to FBE_RAID_GROUP_READ_AHEAD_DEPTH buffers.
+     */
+    if (stream_p->sequential_count >= FBE_RAID_GROUP_READ_AHEAD_TRIGGER)
+    {
+        while ((send_count < FBE_RAID_GROUP_READ_AHEAD_DEPTH) &&
+               (stream_p->read_ahead_lba < capacity) &&
+               (stream_p->read_ahead_lba < (stream_p->next_lba +
+                                            (FBE_RAID_GROUP_READ_AHEAD_DEPTH * FBE_RAID_GROUP_READ_AHEAD_BUFFER_BLOCKS))))
+        {
+            buffer_p = fbe_raid_group_read_ahead_get_buffer(read_ahead_p, stream_p, current_time);
+            if (buffer_p == NULL)
+            {
+                break;
+            }
+            read_ahead_lba = stream_p->read_ahead_lba;
+            buffer_p->state = FBE_RAID_GROUP_READ_AHEAD_BUFFER_READING;
+            buffer_p->b_stale = FBE_FALSE;
+            buffer_p->lba = read_ahead_lba;
+            buffer_p->blocks = FBE_MIN(FBE_RAID_GROUP_READ_AHEAD_BUFFER_BLOCKS, capacity - read_ahead_lba);
+            stream_p->read_ahead_lba = read_ahead_lba + buffer_p->blocks;
+            read_ahead_p->reads_outstanding++;
+            read_ahead_p->read_ahead_count++;
+            send_p[send_count++] = buffer_p;
+        }
+    }
+    fbe_spinlock_unlock(&read_ahead_p->lock);
+
+    for (index = 0; index < send_count; index++)
+    {
+        fbe_raid_group_read_ahead_send(raid_group_p, send_p[index], packet_p);
+    }
+
+    if (hit_p == NULL)
+    {
+        return FBE_FALSE;
+    }
+
+    payload_p = fbe_transport_get_payload_ex(packet_p);
+    fbe_payload_ex_get_sg_list(payload_p, &sg_p, NULL);
+    fbe_raid_group_read_ahead_copy_to_sg(hit_p->data_p + ((lba - hit_p->lba) * FBE_BE_BYTES_PER_BLOCK),
+                                         sg_p,
+                                         (fbe_u32_t)(blocks * FBE_BE_BYTES_PER_BLOCK));
+
+    fbe_spinlock_lock(&read_ahead_p->lock);
+    hit_p->copy_count--;
+    fbe_spinlock_unlock(&read_ahead_p->lock);
+
+    block_operation_p = fbe_payload_ex_get_block_operation(payload_p);
+    fbe_payload_block_set_status(block_operation_p,
+                                 FBE_PAYLOAD_BLOCK_OPERATION_STATUS_SUCCESS,
+                                 FBE_PAYLOAD_BLOCK_OPERATION_QUALIFIER_NONE);
+    fbe_transport_set_status(packet_p, FBE_STATUS_OK, 0);
+    fbe_transport_complete_packet(packet_p);
+    return FBE_TRUE;
+}
+/******************************************
+ * end fbe_raid_group_read_ahead_handle_io()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_raid_group_read_ahead_init()
+ ****************************************************************
+ * @brief
+ *  Allocate the read-ahead state and buffers of a striper or
+ *  parity raid group.  Called when the raid group activates, it
+ *  does nothing when they are already allocated.
+ *
+ * @param raid_group_p - Raid group.
+ *
+ * @return None.  On failure the raid group does not read ahead.
+ *
+ ****************************************************************/
+void fbe_raid_group_read_ahead_init(fbe_raid_group_t *raid_group_p)
+{
+    fbe_raid_geometry_t *raid_geometry_p = fbe_raid_group_get_raid_geometry(raid_group_p);
+    fbe_raid_group_read_ahead_t *read_ahead_p = NULL;
+    fbe_u32_t buffer_bytes = FBE_RAID_GROUP_READ_AHEAD_BUFFER_BLOCKS * FBE_BE_BYTES_PER_BLOCK;
+    fbe_u8_t *data_p = NULL;
+    fbe_u32_t index;
+
+    if ((raid_group_p->read_ahead_p != NULL) ||
+        ((raid_geometry_p->class_id != FBE_CLASS_ID_STRIPER) &&
+         (raid_geometry_p->class_id != FBE_CLASS_ID_PARITY)))
+    {
+        return;
+    }
+
+    /* Back off when too many raid groups are reading ahead.
+     */
+    if (fbe_atomic_increment(&fbe_raid_group_read_ahead_pools) > FBE_RAID_GROUP_READ_AHEAD_MAX_POOLS)
+    {
+        fbe_atomic_decrement(&fbe_raid_group_read_ahead_pools);
+        return;
+    }
+
+    read_ahead_p = (fbe_raid_group_read_ahead_t *)fbe_memory_native_allocate(sizeof(fbe_raid_group_read_ahead_t));
+    data_p = (fbe_u8_t *)fbe_memory_native_allocate(buffer_bytes * FBE_RAID_GROUP_READ_AHEAD_MAX_BUFFERS);
+    if ((read_ahead_p == NULL) || (data_p == NULL))
+    {
+        if (read_ahead_p != NULL)
+        {
+            fbe_memory_native_release(read_ahead_p);
+        }
+        if (data_p != NULL)
+        {
+            fbe_memory_native_release(data_p);
+        }
+        fbe_atomic_decrement(&fbe_raid_group_read_ahead_pools);
+        fbe_raid_group_trace(raid_group_p, FBE_TRACE_LEVEL_INFO, FBE_RAID_GROUP_DEBUG_FLAG_NONE,
+                             "read ahead: no memory, read ahead disabled\n");
+        return;
+    }
+
+    fbe_zero_memory(read_ahead_p, sizeof(fbe_raid_group_read_ahead_t));
+    fbe_spinlock_init(&read_ahead_p->lock);
+    for (index = 0; index < FBE_RAID_GROUP_READ_AHEAD_MAX_STREAMS; index++)
+    {
+        read_ahead_p->streams[index].next_lba = FBE_LBA_INVALID;
+    }
+    for (index = 0; index < FBE_RAID_GROUP_READ_AHEAD_MAX_BUFFERS; index++)
+    {
+        read_ahead_p->buffers[index].state = FBE_RAID_GROUP_READ_AHEAD_BUFFER_FREE;
+        read_ahead_p->buffers[index].data_p = data_p + (index * buffer_bytes);
+    }
+
+    /* The I/O path only looks at the pointer once it is set.
+     */
+    fbe_raid_group_lock(raid_group_p);
+    raid_group_p->read_ahead_p = read_ahead_p;
+    fbe_raid_group_unlock(raid_group_p);
+    return;
+}
+/******************************************
+ * end fbe_raid_group_read_ahead_init()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_raid_group_read_ahead_destroy()
+ ****************************************************************
+ * @brief
+ *  Release the read-ahead state of a raid group being destroyed.
+ *  No read-ahead is outstanding since the raid group was drained.
+ *
+ * @param raid_group_p - Raid group.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void fbe_raid_group_read_ahead_destroy(fbe_raid_group_t *raid_group_p)
+{
+    fbe_raid_group_read_ahead_t *read_ahead_p = raid_group_p->read_ahead_p;
+
+    if (read_ahead_p == NULL)
+    {
+        return;
+    }
+    fbe_memory_native_release(read_ahead_p->buffers[0].data_p);
+    fbe_atomic_decrement(&fbe_raid_group_read_ahead_pools);
+    fbe_spinlock_destroy(&read_ahead_p->lock);
+    fbe_memory_native_release(read_ahead_p);
+    raid_group_p->read_ahead_p = NULL;
+    return;
+}
+/******************************************
+ * end fbe_raid_group_read_ahead_destroy()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_raid_group_read_ahead_get_stats()
+ ****************************************************************
+ * @brief
+ *  Return the read-ahead counters of a raid group.  A raid group
+ *  without read-ahead state returns zeros.
+ *
+ * @param raid_group_p - Raid group.
+ * @param stats_p - Counters to fill in.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void fbe_raid_group_read_ahead_get_stats(fbe_raid_group_t *raid_group_p,
+                                         fbe_raid_group_get_read_ahead_stats_t *stats_p)
+{
+    fbe_raid_group_read_ahead_t *read_ahead_p = raid_group_p->read_ahead_p;
+
+    fbe_zero_memory(stats_p, sizeof(*stats_p));
+    if (read_ahead_p == NULL)
+    {
+        return;
+    }
+    fbe_spinlock_lock(&read_ahead_p->lock);
+    stats_p->hit_count = read_ahead_p->hit_count;
+    stats_p->read_ahead_count = read_ahead_p->read_ahead_count;
+    fbe_spinlock_unlock(&read_ahead_p->lock);
+    return;
+}
+/******************************************
+ * end fbe_raid_group_read_ahead_get_stats()
+ ******************************************/
+
+/*************************
+ * end file fbe_raid_group_read_ahead.c
+ *************************/
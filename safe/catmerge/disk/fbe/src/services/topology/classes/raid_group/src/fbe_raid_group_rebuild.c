@@ -55,6 +55,35 @@ static fbe_status_t fbe_raid_group_rebuild_send_io_request_completion(
                                     fbe_packet_t*                   in_packet_p, 
                                     fbe_packet_completion_context_t in_context);
 
+//  Split a rebuild request into rebuild I/Os that are issued together
+static void fbe_raid_group_rebuild_get_tuning(
+                                    fbe_raid_group_t*               in_raid_group_p,
+                                    fbe_u32_t*                      out_queue_depth_p,
+                                    fbe_u32_t*                      out_op_chunks_p);
+
+static void fbe_raid_group_rebuild_update_tuning(
+                                    fbe_raid_group_t*               in_raid_group_p,
+                                    fbe_u32_t                       in_service_time_ms,
+                                    fbe_bool_t                      in_b_failed);
+
+static void fbe_raid_group_rebuild_get_sub_request_blocks(
+                                    fbe_raid_group_t*               in_raid_group_p,
+                                    fbe_raid_group_rebuild_context_t* in_rebuild_context_p,
+                                    fbe_u32_t*                      out_sub_request_count_p,
+                                    fbe_block_count_t*              out_sub_request_blocks_p);
+
+static void fbe_raid_group_rebuild_concurrent_io_allocation_completion(
+                                    fbe_memory_request_t*           in_memory_request_p,
+                                    fbe_memory_completion_context_t in_context);
+
+static fbe_status_t fbe_raid_group_rebuild_sub_request_completion(
+                                    fbe_packet_t*                   in_packet_p, 
+                                    fbe_packet_completion_context_t in_context);
+
+static fbe_status_t fbe_raid_group_rebuild_concurrent_io_completion(
+                                    fbe_packet_t*                   in_packet_p, 
+                                    fbe_packet_completion_context_t in_context);
+
 //  Completion function for update to paged metadata for an unbound area
 static fbe_status_t fbe_raid_group_clear_nr_control_operation_completion(
                                     fbe_packet_t*                   in_packet_p,
@@ -101,6 +130,8 @@ static fbe_status_t fbe_raid_group_get_raid10_rebuild_info_completion(fbe_packet
  ***************/
  
 static fbe_u32_t fbe_raid_group_rebuild_background_op_chunks = FBE_RAID_GROUP_REBUILD_BACKGROUND_OP_CHUNKS;
+static fbe_u32_t fbe_raid_group_rebuild_max_concurrent_ios = FBE_RAID_GROUP_REBUILD_MAX_CONCURRENT_IOS;
+static fbe_block_count_t fbe_raid_group_rebuild_catch_up_window_blocks = FBE_RAID_GROUP_REBUILD_CATCH_UP_WINDOW_BLOCKS;
 
 /*!****************************************************************************
  *  fbe_raid_group_get_rebuild_checkpoint()
@@ -418,6 +449,12 @@ fbe_bool_t fbe_raid_group_is_singly_degraded(fbe_raid_group_t *raid_group_p)
  *   - Otherwise, the disk needs to actually be rebuilt and the out_do_rebuild_pos_p
  *     parameter will be set with its value.
  *
+ *   Normally the disk(s) with the highest checkpoint are rebuilt first.  But
+ *   if the catch up window is set and another disk is at most that many blocks
+ *   behind, we rebuild the lower one first.  Once it catches up the checkpoints
+ *   are equal and both are rebuilt together, so the rest of the raid group is
+ *   read once for both instead of once for each.
+ *
  *   If the function does not find a disk/edge, it sets the output parameters to 
  *   FBE_RAID_INVALID_DISK_POSITION.  
  *   
@@ -428,8 +465,8 @@ fbe_bool_t fbe_raid_group_is_singly_degraded(fbe_raid_group_t *raid_group_p)
  * @param out_complete_rebuild_positions_p - Gets populated with position of the first disk 
  *                                        in the RG that needs to "complete a rebuild"; set
  *                                        to FBE_RAID_INVALID_DISK_POSITION if none found
- * @param out_rebuild_checkpoint_p      - Pointer to rebuild checkpoint that we have 
- *                                        determined is the highest checkpoint.
+ * @param out_rebuild_checkpoint_p      - Pointer to rebuild checkpoint of the positions
+ *                                        we have selected to rebuild.
  *
  * @return  fbe_status_t        
  *
@@ -463,6 +500,8 @@ fbe_status_t fbe_raid_group_rebuild_find_disk_needing_action(fbe_raid_group_t *i
     //fbe_u32_t                   highest_region = 0;
     fbe_bool_t                  b_need_reset_checkpoint;
     fbe_bool_t                  b_curr_need_reset_checkpoint;
+    fbe_lba_t                   lowest_checkpoint;              //  lowest user rebuild checkpoint found so far
+    fbe_raid_position_bitmask_t lowest_positions;               //  positions at the lowest checkpoint
 
     //  Initialize output parameters 
     *out_degraded_positions_p = 0;
@@ -482,6 +521,8 @@ fbe_status_t fbe_raid_group_rebuild_find_disk_needing_action(fbe_raid_group_t *i
 
     //  Initialize the highest checkpoint we have found for a disk that needs to be rebuilt 
     highest_checkpoint = FBE_LBA_INVALID;
+    lowest_checkpoint = FBE_LBA_INVALID;
+    lowest_positions = 0;
 
     //  Loop through all of the disks in the raid group   
     for (position_index = 0; position_index < width; position_index++)
@@ -581,6 +622,19 @@ fbe_status_t fbe_raid_group_rebuild_find_disk_needing_action(fbe_raid_group_t *i
         else
         {
             b_curr_need_reset_checkpoint = FBE_FALSE;
+
+            /* Remember the lowest user checkpoint in case it should catch up.
+             */
+            if ((lowest_checkpoint == FBE_LBA_INVALID) ||
+                (cur_checkpoint < lowest_checkpoint))
+            {
+                lowest_checkpoint = cur_checkpoint;
+                lowest_positions = (1 << position_index);
+            }
+            else if (cur_checkpoint == lowest_checkpoint)
+            {
+                lowest_positions |= (1 << position_index);
+            }
         }
         if (highest_checkpoint == FBE_LBA_INVALID)
         {
@@ -627,6 +681,25 @@ fbe_status_t fbe_raid_group_rebuild_find_disk_needing_action(fbe_raid_group_t *i
 
     } /* end for all positions in the raid group */
 
+    /* If a position is within the catch up window behind the highest, rebuild it first.
+     * When it reaches the higher checkpoint both positions are rebuilt by the 
+     * same requests, instead of reading every other disk again in a second pass. 
+     */
+    if ((fbe_raid_group_rebuild_catch_up_window_blocks != 0)  &&
+        (b_need_reset_checkpoint == FBE_FALSE)                &&
+        (highest_checkpoint != FBE_LBA_INVALID)               &&
+        (lowest_checkpoint < highest_checkpoint)              &&
+        ((highest_checkpoint - lowest_checkpoint) <= fbe_raid_group_rebuild_catch_up_window_blocks))
+    {
+        fbe_raid_group_trace(in_raid_group_p,
+                             FBE_TRACE_LEVEL_INFO, 
+                             FBE_RAID_GROUP_DEBUG_FLAG_REBUILD_TRACING,                               
+                             "rg: rebuild catch up pos_bm: 0x%x from 0x%llx to 0x%llx\n",
+                             lowest_positions, (unsigned long long)lowest_checkpoint, (unsigned long long)highest_checkpoint);
+        highest_checkpoint = lowest_checkpoint;
+        *out_positions_to_be_rebuilt_p = lowest_positions;
+    }
+
     /* If only `rebuild complete' is set update the highest checkpoint
      */
     if ((*out_complete_rebuild_positions_p != 0) &&
@@ -929,6 +1002,9 @@ fbe_status_t fbe_raid_group_get_rebuild_block_count(fbe_raid_group_t *raid_group
     fbe_raid_group_metadata_positions_t raid_group_metadata_positions;
     fbe_u16_t               data_disks;
     fbe_lba_t               start_lba;
+    fbe_u32_t               request_chunks;
+    fbe_u32_t               queue_depth;
+    fbe_u32_t               op_chunks;
 
     /* Get the number of data disks in this raid object and convert teh physical
      * rebuild_lba to a logical.
@@ -944,9 +1020,17 @@ fbe_status_t fbe_raid_group_get_rebuild_block_count(fbe_raid_group_t *raid_group
      */ 
     chunk_size = fbe_raid_group_get_chunk_size(raid_group_p);
 
-    /* Get our default `logical' block consumption for rebuild request.
+    /* Get our default `logical' block consumption for rebuild request.  A 
+     * rebuild of the user area covers all the rebuild I/Os which are issued 
+     * together. 
      */
-    logical_block_count = (fbe_block_count_t)((chunk_size * fbe_raid_group_rebuild_background_op_chunks) * data_disks);
+    request_chunks = fbe_raid_group_rebuild_background_op_chunks;
+    if (start_lba < raid_group_metadata_positions.exported_capacity)
+    {
+        fbe_raid_group_rebuild_get_tuning(raid_group_p, &queue_depth, &op_chunks);
+        request_chunks = queue_depth * op_chunks;
+    }
+    logical_block_count = (fbe_block_count_t)((chunk_size * request_chunks) * data_disks);
     end_lba = start_lba + logical_block_count - 1;
 
     /* We cannot span positions (i.e. cannot span the user -> metadata and
@@ -1011,12 +1095,44 @@ fbe_status_t fbe_raid_group_rebuild_initialize_rebuild_context(
 {
 
     fbe_block_count_t   block_count;    // number of physical blocks to rebuild
+    fbe_u32_t           width;
+    fbe_u32_t           position_index;
+    fbe_lba_t           checkpoint;
+    fbe_bool_t          b_rebuild_logging;
+    fbe_chunk_size_t    chunk_size;
 
     //  Get the chunk size, which is the number of blocks to rebuild  
     fbe_raid_group_get_rebuild_block_count(in_raid_group_p,
                                            in_rebuild_lba,
                                            &block_count);
 
+    //  If another position is rebuilding a little ahead of us, we are catching up to it.  Stop at its 
+    //  checkpoint so that the next request rebuilds both positions together.
+    if ((fbe_raid_group_rebuild_catch_up_window_blocks != 0) &&
+        (in_rebuild_lba < fbe_raid_group_get_exported_disk_capacity(in_raid_group_p)))
+    {
+        fbe_base_config_get_width((fbe_base_config_t*) in_raid_group_p, &width);
+        chunk_size = fbe_raid_group_get_chunk_size(in_raid_group_p);
+        for (position_index = 0; position_index < width; position_index++)
+        {
+            if ((1 << position_index) & in_positions_to_be_rebuilt)
+            {
+                continue;
+            }
+            fbe_raid_group_get_rb_logging(in_raid_group_p, position_index, &b_rebuild_logging); 
+            if (b_rebuild_logging == FBE_TRUE)
+            {
+                continue;
+            }
+            fbe_raid_group_get_rebuild_checkpoint(in_raid_group_p, position_index, &checkpoint); 
+            if ((checkpoint >= (in_rebuild_lba + chunk_size)) &&
+                (checkpoint < (in_rebuild_lba + block_count))    )
+            {
+                block_count = ((checkpoint - in_rebuild_lba) / chunk_size) * chunk_size;
+            }
+        }
+    }
+
     //  Set the rebuild data in the rebuild tracking structure 
     fbe_raid_group_rebuild_context_set_rebuild_start_lba(in_rebuild_context_p, in_rebuild_lba); 
     fbe_raid_group_rebuild_context_set_rebuild_block_count(in_rebuild_context_p, block_count);
@@ -1027,6 +1143,8 @@ fbe_status_t fbe_raid_group_rebuild_initialize_rebuild_context(
     fbe_raid_group_rebuild_context_set_update_checkpoint_bitmask(in_rebuild_context_p, 0);
     fbe_raid_group_rebuild_context_set_update_checkpoint_lba(in_rebuild_context_p, FBE_LBA_INVALID);
     fbe_raid_group_rebuild_context_set_update_checkpoint_blocks(in_rebuild_context_p, 0);
+    in_rebuild_context_p->b_sub_request = FBE_FALSE;
+    in_rebuild_context_p->sub_request_count = 0;
 
     fbe_raid_group_trace(in_raid_group_p,
                          FBE_TRACE_LEVEL_INFO, 
@@ -1408,6 +1526,8 @@ static fbe_status_t fbe_raid_group_rebuild_send_event_to_check_lba_completion(
     fbe_u32_t                           event_flags = 0;
     fbe_bool_t                          is_io_consumed;
     fbe_block_count_t                   io_block_count = FBE_LBA_INVALID;
+    fbe_u32_t                           sub_request_count;
+    fbe_block_count_t                   sub_request_blocks;
 
     //  Trace function entry 
     FBE_RAID_GROUP_TRACE_FUNC_ENTRY((fbe_raid_group_t*) in_context);
@@ -1582,6 +1702,21 @@ static fbe_status_t fbe_raid_group_rebuild_send_event_to_check_lba_completion(
 
     } /* end if switch on event_status*/
 
+    /* If the request covers more than one rebuild I/O, issue them together.
+     */
+    fbe_raid_group_rebuild_get_sub_request_blocks(raid_group_p, rebuild_context_p, &sub_request_count, &sub_request_blocks);
+    if (sub_request_count > 1)
+    {
+        status = fbe_raid_group_rebuild_send_concurrent_io_request(raid_group_p, packet_p, 
+                                                                   sub_request_count, sub_request_blocks,
+                                                                   fbe_raid_group_rebuild_send_io_request);
+        return status;
+    }
+
+    /* The service time of a single rebuild I/O also drives the tuning.
+     */
+    rebuild_context_p->start_time = fbe_get_time();
+
     // Send the rebuild I/O .  Its completion function will execute when it finishes. 
     status = fbe_raid_group_rebuild_send_io_request(raid_group_p, packet_p,
                                                     FBE_TRUE, /* We must break the context to release the event thread. */ 
@@ -1697,6 +1832,7 @@ static fbe_status_t fbe_raid_group_rebuild_send_io_request_completion(
     fbe_payload_ex_t*                      payload_p;                      //  pointer to sep payload
     fbe_payload_block_operation_t*          block_operation_p;              //  pointer to block operation
     fbe_payload_block_operation_status_t    block_status;                   //  block operation status 
+    fbe_raid_group_rebuild_context_t*       rebuild_context_p;              //  pointer to the rebuild context
 
 
     //  Cast the context to a pointer to a raid group object 
@@ -1732,12 +1868,609 @@ static fbe_status_t fbe_raid_group_rebuild_send_io_request_completion(
     //  Release the block operation
     fbe_payload_ex_release_block_operation(payload_p, block_operation_p);
 
+    /* A rebuild of the user area that was not split still tunes the next 
+     * requests.  The sub requests are accounted for once all have completed. 
+     */
+    fbe_raid_group_rebuild_get_rebuild_context(raid_group_p, in_packet_p, &rebuild_context_p);
+    if ((rebuild_context_p->b_sub_request == FBE_FALSE)                                               &&
+        (rebuild_context_p->start_lba < fbe_raid_group_get_exported_disk_capacity(raid_group_p))         )
+    {
+        fbe_raid_group_rebuild_update_tuning(raid_group_p, fbe_get_elapsed_milliseconds(rebuild_context_p->start_time),
+                                             (fbe_transport_get_status_code(in_packet_p) != FBE_STATUS_OK) ? FBE_TRUE : FBE_FALSE);
+    }
+
     //  Return status
     return packet_status;
 
 } // End fbe_raid_group_rebuild_send_io_request_completion
 
 
+/*!****************************************************************************
+ * fbe_raid_group_rebuild_get_tuning()
+ ******************************************************************************
+ * @brief
+ *   Get the number and size of the rebuild I/Os to issue together for the
+ *   next rebuild request of the user area.  A raid group starts with a
+ *   single I/O of the default size.
+ *
+ * @param in_raid_group_p       - pointer to the raid group
+ * @param out_queue_depth_p     - number of rebuild I/Os to issue together
+ * @param out_op_chunks_p       - number of chunks per rebuild I/O
+ *
+ * @return None
+ *
+ ******************************************************************************/
+static void fbe_raid_group_rebuild_get_tuning(
+                                    fbe_raid_group_t*               in_raid_group_p,
+                                    fbe_u32_t*                      out_queue_depth_p,
+                                    fbe_u32_t*                      out_op_chunks_p)
+{
+    fbe_raid_group_rebuild_tuning_t    *tuning_p = &in_raid_group_p->rebuild_tuning;
+    fbe_u32_t                           min_op_chunks;
+
+    min_op_chunks = FBE_MAX(fbe_raid_group_rebuild_background_op_chunks, 1);
+    if (tuning_p->queue_depth == 0)
+    {
+        tuning_p->queue_depth = 1;
+        tuning_p->op_chunks = min_op_chunks;
+    }
+
+    /* The class settings may have changed since the last request.
+     */
+    tuning_p->queue_depth = FBE_MIN(tuning_p->queue_depth, fbe_raid_group_rebuild_max_concurrent_ios);
+    tuning_p->op_chunks = FBE_MAX(tuning_p->op_chunks, min_op_chunks);
+    tuning_p->op_chunks = FBE_MIN(tuning_p->op_chunks, FBE_RAID_IOTS_MAX_CHUNKS);
+
+    *out_queue_depth_p = tuning_p->queue_depth;
+    *out_op_chunks_p = tuning_p->op_chunks;
+    return;
+
+} // End fbe_raid_group_rebuild_get_tuning()
+
+
+/*!****************************************************************************
+ * fbe_raid_group_rebuild_update_tuning()
+ ******************************************************************************
+ * @brief
+ *   Adjust the number and size of the rebuild I/Os after a rebuild request of
+ *   the user area completed.  The rebuild backs off one step when its I/Os
+ *   are slow, when one failed or when there is host I/O on the raid group.
+ *   It issues more I/Os, and then larger I/Os, while they complete quickly on
+ *   an otherwise idle raid group.
+ *
+ * @param in_raid_group_p       - pointer to the raid group
+ * @param in_service_time_ms    - longest service time of the request's I/Os
+ * @param in_b_failed           - FBE_TRUE if any of the I/Os failed
+ *
+ * @return None
+ *
+ ******************************************************************************/
+static void fbe_raid_group_rebuild_update_tuning(
+                                    fbe_raid_group_t*               in_raid_group_p,
+                                    fbe_u32_t                       in_service_time_ms,
+                                    fbe_bool_t                      in_b_failed)
+{
+    fbe_raid_group_rebuild_tuning_t    *tuning_p = &in_raid_group_p->rebuild_tuning;
+    fbe_u32_t                           host_io_count;
+    fbe_u32_t                           queue_depth;
+    fbe_u32_t                           op_chunks;
+    fbe_u32_t                           min_op_chunks;
+
+    fbe_raid_group_rebuild_get_tuning(in_raid_group_p, &queue_depth, &op_chunks);
+    min_op_chunks = FBE_MAX(fbe_raid_group_rebuild_background_op_chunks, 1);
+
+    /* Keep a moving average so that a single slow I/O does not throttle us.
+     */
+    if (tuning_p->avg_service_time_ms == 0)
+    {
+        tuning_p->avg_service_time_ms = in_service_time_ms;
+    }
+    else
+    {
+        tuning_p->avg_service_time_ms = ((tuning_p->avg_service_time_ms * 3) + in_service_time_ms) / 4;
+    }
+
+    /* All our rebuild I/Os are done, anything outstanding is host I/O.
+     */
+    fbe_block_transport_server_get_outstanding_io_count(&in_raid_group_p->base_config.block_transport_server, 
+                                                        &host_io_count);
+
+    if ((in_b_failed == FBE_TRUE)                                                        ||
+        (host_io_count != 0)                                                             ||
+        (tuning_p->avg_service_time_ms > FBE_RAID_GROUP_REBUILD_SLOW_IO_SERVICE_TIME)       )
+    {
+        /* Give up depth first, it costs the host the most.
+         */
+        if (queue_depth > 1)
+        {
+            queue_depth = queue_depth / 2;
+        }
+        else
+        {
+            op_chunks = FBE_MAX(op_chunks / 2, min_op_chunks);
+        }
+    }
+    else if (tuning_p->avg_service_time_ms < FBE_RAID_GROUP_REBUILD_FAST_IO_SERVICE_TIME)
+    {
+        if (queue_depth < fbe_raid_group_rebuild_max_concurrent_ios)
+        {
+            queue_depth++;
+        }
+        else
+        {
+            op_chunks = FBE_MIN(op_chunks * 2, FBE_RAID_IOTS_MAX_CHUNKS);
+        }
+    }
+
+    if ((queue_depth != tuning_p->queue_depth) ||
+        (op_chunks != tuning_p->op_chunks)        )
+    {
+        fbe_raid_group_trace(in_raid_group_p,
+                             FBE_TRACE_LEVEL_INFO,
+                             FBE_RAID_GROUP_DEBUG_FLAG_REBUILD_TRACING,
+                             "raid_group: rebuild tuning depth: %d -> %d chunks: %d -> %d avg: %d ms host ios: %d failed: %d\n",
+                             tuning_p->queue_depth, queue_depth, tuning_p->op_chunks, op_chunks,
+                             tuning_p->avg_service_time_ms, host_io_count, in_b_failed);
+    }
+    tuning_p->queue_depth = queue_depth;
+    tuning_p->op_chunks = op_chunks;
+    return;
+
+} // End fbe_raid_group_rebuild_update_tuning()
+
+
+/*!****************************************************************************
+ * fbe_raid_group_rebuild_get_sub_request_blocks()
+ ******************************************************************************
+ * @brief
+ *   Determine how a rebuild request is split into rebuild I/Os.  Only a
+ *   rebuild of the user area is split.
+ *
+ * @param in_raid_group_p           - pointer to the raid group
+ * @param in_rebuild_context_p      - rebuild context of the request
+ * @param out_sub_request_count_p   - number of rebuild I/Os, 1 if not split
+ * @param out_sub_request_blocks_p  - blocks per rebuild I/O (the last one 
+ *                                    may be smaller)
+ *
+ * @return None
+ *
+ ******************************************************************************/
+static void fbe_raid_group_rebuild_get_sub_request_blocks(
+                                    fbe_raid_group_t*               in_raid_group_p,
+                                    fbe_raid_group_rebuild_context_t* in_rebuild_context_p,
+                                    fbe_u32_t*                      out_sub_request_count_p,
+                                    fbe_block_count_t*              out_sub_request_blocks_p)
+{
+    fbe_u32_t           queue_depth;
+    fbe_u32_t           op_chunks;
+    fbe_chunk_size_t    chunk_size;
+    fbe_block_count_t   sub_request_blocks;
+    fbe_block_count_t   block_count = in_rebuild_context_p->block_count;
+
+    *out_sub_request_count_p = 1;
+    *out_sub_request_blocks_p = block_count;
+
+    fbe_raid_group_rebuild_get_tuning(in_raid_group_p, &queue_depth, &op_chunks);
+    chunk_size = fbe_raid_group_get_chunk_size(in_raid_group_p);
+    sub_request_blocks = (fbe_block_count_t)op_chunks * chunk_size;
+
+    if ((queue_depth == 1)                                                                          ||
+        (in_rebuild_context_p->start_lba >= fbe_raid_group_get_exported_disk_capacity(in_raid_group_p)) ||
+        (block_count <= sub_request_blocks)                                                            )
+    {
+        return;
+    }
+
+    /* Never issue more than the maximum, use larger I/Os instead.
+     */
+    if (((block_count + sub_request_blocks - 1) / sub_request_blocks) > FBE_RAID_GROUP_REBUILD_MAX_CONCURRENT_IOS)
+    {
+        sub_request_blocks = (block_count + FBE_RAID_GROUP_REBUILD_MAX_CONCURRENT_IOS - 1) / FBE_RAID_GROUP_REBUILD_MAX_CONCURRENT_IOS;
+        sub_request_blocks = ((sub_request_blocks + chunk_size - 1) / chunk_size) * chunk_size;
+    }
+
+    *out_sub_request_count_p = (fbe_u32_t)((block_count + sub_request_blocks - 1) / sub_request_blocks);
+    *out_sub_request_blocks_p = sub_request_blocks;
+    return;
+
+} // End fbe_raid_group_rebuild_get_sub_request_blocks()
+
+
+/*!****************************************************************************
+ * fbe_raid_group_rebuild_send_concurrent_io_request()
+ ******************************************************************************
+ * @brief
+ *   Issue the rebuild request as several rebuild I/Os at the same time.  We
+ *   allocate a sub packet with its own rebuild context for each I/O.  The
+ *   request's checkpoint is updated once all of them have completed.  The
+ *   virtual drive also uses this to copy several regions at once.
+ *
+ * @param in_raid_group_p       - pointer to a raid group object
+ * @param in_packet_p           - pointer to the monitor packet of the request
+ * @param in_sub_request_count  - number of rebuild I/Os to issue
+ * @param in_sub_request_blocks - blocks per rebuild I/O (the last one may be
+ *                                smaller)
+ * @param in_send_io_function   - sends the rebuild I/O of a sub request
+ *
+ * @return fbe_status_t
+ *
+ ******************************************************************************/
+fbe_status_t fbe_raid_group_rebuild_send_concurrent_io_request(
+                                    fbe_raid_group_t*               in_raid_group_p, 
+                                    fbe_packet_t*                   in_packet_p,
+                                    fbe_u32_t                       in_sub_request_count,
+                                    fbe_block_count_t               in_sub_request_blocks,
+                                    fbe_raid_group_rebuild_send_io_function_t in_send_io_function)
+{
+    fbe_status_t                                status;
+    fbe_raid_group_rebuild_context_t           *rebuild_context_p;
+    fbe_base_config_memory_allocation_chunks_t  mem_alloc_chunks = {0};
+
+    fbe_raid_group_rebuild_get_rebuild_context(in_raid_group_p, in_packet_p, &rebuild_context_p);
+    fbe_raid_group_rebuild_context_set_rebuild_state(rebuild_context_p, FBE_RAID_GROUP_REBUILD_STATE_REBUILD_IO);
+    rebuild_context_p->sub_request_count = 0;
+
+    /* The split must match the request, we track at most the maximum.
+     */
+    if ((in_sub_request_count == 0)                                                                           ||
+        (in_sub_request_count > FBE_RAID_GROUP_REBUILD_MAX_CONCURRENT_IOS)                                    ||
+        (in_sub_request_blocks == 0)                                                                          ||
+        (((rebuild_context_p->block_count + in_sub_request_blocks - 1) / in_sub_request_blocks) != in_sub_request_count))
+    {
+        fbe_base_object_trace((fbe_base_object_t *)in_raid_group_p,
+                              FBE_TRACE_LEVEL_ERROR,
+                              FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                              "raid_group: rebuild blks: 0x%llx bad split into %d ios of 0x%llx blks\n",
+                              (unsigned long long)rebuild_context_p->block_count, in_sub_request_count,
+                              (unsigned long long)in_sub_request_blocks);
+        fbe_transport_set_status(in_packet_p, FBE_STATUS_GENERIC_FAILURE, 0);        
+        fbe_transport_complete_packet(in_packet_p);
+        return FBE_STATUS_OK;
+    }
+    rebuild_context_p->sub_request_blocks = in_sub_request_blocks;
+    rebuild_context_p->send_io_function = in_send_io_function;
+
+    fbe_transport_set_completion_function(in_packet_p, fbe_raid_group_rebuild_concurrent_io_completion, 
+                                          (fbe_packet_completion_context_t) in_raid_group_p);
+
+    //  One sub packet and rebuild context per rebuild I/O
+    mem_alloc_chunks.buffer_count = in_sub_request_count;
+    mem_alloc_chunks.number_of_packets = in_sub_request_count;
+    mem_alloc_chunks.sg_element_count = 0;
+    mem_alloc_chunks.buffer_size = sizeof(fbe_raid_group_rebuild_context_t);
+    mem_alloc_chunks.alloc_pre_read_desc = FALSE; 
+
+    status = fbe_base_config_memory_allocate_chunks((fbe_base_config_t *) in_raid_group_p,
+                                                    in_packet_p,
+                                                    mem_alloc_chunks,
+                                                    fbe_raid_group_rebuild_concurrent_io_allocation_completion);
+    if (status != FBE_STATUS_OK)
+    {
+        fbe_base_object_trace((fbe_base_object_t *)in_raid_group_p,
+                              FBE_TRACE_LEVEL_WARNING,
+                              FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                              "raid_group: rebuild memory allocation for %d ios failed, status: 0x%x\n",
+                              in_sub_request_count, status);
+        fbe_transport_set_status(in_packet_p, FBE_STATUS_GENERIC_FAILURE, 0);        
+        fbe_transport_complete_packet(in_packet_p);
+        return FBE_STATUS_OK;
+    }
+
+    return FBE_STATUS_MORE_PROCESSING_REQUIRED;
+
+} // End fbe_raid_group_rebuild_send_concurrent_io_request()
+
+
+/*!****************************************************************************
+ * fbe_raid_group_rebuild_concurrent_io_allocation_completion()
+ ******************************************************************************
+ * @brief
+ *   The memory for the rebuild I/Os of a request was allocated.  Set up a sub
+ *   packet for each I/O and start all of them.
+ *
+ * @param in_memory_request_p   - memory request of the monitor packet
+ * @param in_context            - pointer to the raid group
+ *
+ * @return None
+ *
+ ******************************************************************************/
+static void fbe_raid_group_rebuild_concurrent_io_allocation_completion(
+                                    fbe_memory_request_t*           in_memory_request_p,
+                                    fbe_memory_completion_context_t in_context)
+{
+    fbe_status_t                                    status;
+    fbe_raid_group_t                               *raid_group_p = (fbe_raid_group_t *)in_context;
+    fbe_packet_t                                   *packet_p = NULL;
+    fbe_packet_t                                  **sub_packet_p = NULL;
+    fbe_u8_t                                      **buffer_p = NULL;
+    fbe_payload_ex_t                               *sub_payload_p = NULL;
+    fbe_payload_control_operation_t                *control_operation_p = NULL;
+    fbe_raid_group_rebuild_context_t               *rebuild_context_p = NULL;
+    fbe_raid_group_rebuild_context_t               *sub_context_p = NULL;
+    fbe_base_config_memory_alloc_chunks_address_t   mem_alloc_chunks_addr = {0};
+    fbe_sg_element_t                               *pre_read_sg_list_p = NULL;
+    fbe_payload_pre_read_descriptor_t              *pre_read_desc_p = NULL;
+    fbe_u32_t                                       sub_request_count;
+    fbe_block_count_t                               sub_request_blocks;
+    fbe_lba_t                                       end_lba;
+    fbe_u32_t                                       index;
+
+    packet_p = fbe_transport_memory_request_to_packet(in_memory_request_p);
+    fbe_raid_group_rebuild_get_rebuild_context(raid_group_p, packet_p, &rebuild_context_p);
+
+    if (fbe_memory_request_is_allocation_complete(in_memory_request_p) == FBE_FALSE)
+    {        
+        fbe_base_object_trace((fbe_base_object_t *)raid_group_p,
+                              FBE_TRACE_LEVEL_ERROR,
+                              FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,                                        
+                              "%s: Memory request: 0x%p state: %d failed.\n",
+                              __FUNCTION__, in_memory_request_p, in_memory_request_p->request_state);        
+        fbe_transport_set_status(packet_p, FBE_STATUS_INSUFFICIENT_RESOURCES, 0);        
+        fbe_transport_complete_packet(packet_p);
+        return;
+    }
+
+    sub_request_blocks = rebuild_context_p->sub_request_blocks;
+    sub_request_count = (fbe_u32_t)((rebuild_context_p->block_count + sub_request_blocks - 1) / sub_request_blocks);
+
+    mem_alloc_chunks_addr.buffer_size = sizeof(fbe_raid_group_rebuild_context_t);
+    mem_alloc_chunks_addr.number_of_packets = sub_request_count;
+    mem_alloc_chunks_addr.buffer_count = sub_request_count;
+    mem_alloc_chunks_addr.sg_element_count = 0;
+    mem_alloc_chunks_addr.sg_list_p = NULL;
+    mem_alloc_chunks_addr.assign_pre_read_desc = FALSE;
+    mem_alloc_chunks_addr.pre_read_sg_list_p = &pre_read_sg_list_p;
+    mem_alloc_chunks_addr.pre_read_desc_p = &pre_read_desc_p;
+    status = fbe_base_config_memory_assign_address_from_allocated_chunks((fbe_base_config_t *) raid_group_p,
+                                                                         in_memory_request_p,
+                                                                         &mem_alloc_chunks_addr);
+    if (status != FBE_STATUS_OK)
+    {
+        fbe_base_object_trace((fbe_base_object_t *)raid_group_p,
+                              FBE_TRACE_LEVEL_ERROR,
+                              FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                              "%s memory distribution failed, status:0x%x, ios:0x%x\n",
+                              __FUNCTION__, status, sub_request_count);
+        fbe_memory_free_request_entry(in_memory_request_p);
+        fbe_transport_set_status(packet_p, FBE_STATUS_GENERIC_FAILURE, 0);
+        fbe_transport_complete_packet(packet_p);
+        return;
+    }
+    sub_packet_p = mem_alloc_chunks_addr.packet_array_p;
+    buffer_p = mem_alloc_chunks_addr.buffer_array_p;
+
+    /* Each sub request gets a copy of the request's context for its range.
+     */
+    end_lba = rebuild_context_p->start_lba + rebuild_context_p->block_count;
+    for (index = 0; index < sub_request_count; index++)
+    {
+        sub_context_p = (fbe_raid_group_rebuild_context_t *)buffer_p[index];
+        fbe_copy_memory(sub_context_p, rebuild_context_p, sizeof(fbe_raid_group_rebuild_context_t));
+        sub_context_p->b_sub_request = FBE_TRUE;
+        sub_context_p->sub_request_count = 0;
+        sub_context_p->start_lba = rebuild_context_p->start_lba + (index * sub_request_blocks);
+        sub_context_p->block_count = FBE_MIN(sub_request_blocks, end_lba - sub_context_p->start_lba);
+        sub_context_p->rebuilt_lba = sub_context_p->start_lba;
+        sub_context_p->rebuilt_blocks = 0;
+        sub_context_p->rebuilt_bitmask = 0;
+        sub_context_p->sub_request_status = FBE_STATUS_GENERIC_FAILURE;
+        sub_context_p->service_time_ms = 0;
+        rebuild_context_p->sub_request_context_p[index] = sub_context_p;
+
+        fbe_transport_initialize_sep_packet(sub_packet_p[index]);
+        sub_payload_p = fbe_transport_get_payload_ex(sub_packet_p[index]);
+        control_operation_p = fbe_payload_ex_allocate_control_operation(sub_payload_p);
+        fbe_payload_control_build_operation(control_operation_p,
+                                            FBE_RAID_GROUP_CONTROL_CODE_REBUILD_OPERATION,
+                                            sub_context_p,
+                                            sizeof(fbe_raid_group_rebuild_context_t));
+        fbe_payload_ex_increment_control_operation_level(sub_payload_p);
+
+        fbe_transport_set_resource_priority(sub_packet_p[index], fbe_transport_get_resource_priority(packet_p));
+        fbe_transport_set_completion_function(sub_packet_p[index], fbe_raid_group_rebuild_sub_request_completion,
+                                              (fbe_packet_completion_context_t) raid_group_p);
+        fbe_transport_add_subpacket(packet_p, sub_packet_p[index]);
+    }
+    rebuild_context_p->sub_request_count = sub_request_count;
+    raid_group_p->rebuild_tuning.concurrent_request_count++;
+
+    /* Put the monitor packet on the usurper queue while the sub requests run.
+     */
+    fbe_transport_set_cancel_function(packet_p, fbe_base_object_packet_cancel_function, raid_group_p);
+    fbe_base_object_add_to_usurper_queue((fbe_base_object_t*)raid_group_p, packet_p);
+
+    fbe_raid_group_trace(raid_group_p,
+                         FBE_TRACE_LEVEL_INFO,
+                         FBE_RAID_GROUP_DEBUG_FLAG_REBUILD_TRACING,
+                         "raid_group: rebuild lba: 0x%llx blks: 0x%llx as %d ios of 0x%llx blks\n",
+                         (unsigned long long)rebuild_context_p->start_lba,
+                         (unsigned long long)rebuild_context_p->block_count,
+                         sub_request_count, (unsigned long long)sub_request_blocks);
+
+    for (index = 0; index < sub_request_count; index++)
+    {
+        sub_context_p = rebuild_context_p->sub_request_context_p[index];
+        sub_context_p->start_time = fbe_get_time();
+        rebuild_context_p->send_io_function(raid_group_p, sub_packet_p[index],
+                                            FBE_TRUE, /* Do not run the I/Os in the memory completion context. */
+                                            sub_context_p->start_lba,
+                                            sub_context_p->block_count);
+    }
+    return;
+
+} // End fbe_raid_group_rebuild_concurrent_io_allocation_completion()
+
+
+/*!****************************************************************************
+ * fbe_raid_group_rebuild_sub_request_completion()
+ ******************************************************************************
+ * @brief
+ *   A rebuild I/O of a concurrent rebuild request completed.  Save its status
+ *   and service time in its context.  When it is the last one, complete the
+ *   monitor packet of the request.
+ *
+ * @param in_packet_p           - the sub packet
+ * @param in_context            - pointer to the raid group
+ *
+ * @return fbe_status_t
+ *
+ ******************************************************************************/
+static fbe_status_t fbe_raid_group_rebuild_sub_request_completion(
+                                    fbe_packet_t*                   in_packet_p, 
+                                    fbe_packet_completion_context_t in_context)
+{
+    fbe_raid_group_t                   *raid_group_p = (fbe_raid_group_t *)in_context;
+    fbe_packet_t                       *master_packet_p = NULL;
+    fbe_payload_ex_t                   *payload_p = NULL;
+    fbe_payload_control_operation_t    *control_operation_p = NULL;
+    fbe_raid_group_rebuild_context_t   *sub_context_p = NULL;
+    fbe_bool_t                          is_empty;
+
+    master_packet_p = (fbe_packet_t *)fbe_transport_get_master_packet(in_packet_p);
+
+    payload_p = fbe_transport_get_payload_ex(in_packet_p);
+    control_operation_p = fbe_payload_ex_get_control_operation(payload_p);
+    fbe_payload_control_get_buffer(control_operation_p, &sub_context_p);
+
+    sub_context_p->sub_request_status = fbe_transport_get_status_code(in_packet_p);
+    sub_context_p->service_time_ms = fbe_get_elapsed_milliseconds(sub_context_p->start_time);
+
+    fbe_payload_ex_release_control_operation(payload_p, control_operation_p);
+
+    fbe_transport_remove_subpacket_is_queue_empty(in_packet_p, &is_empty);
+    if (is_empty)
+    {
+        fbe_transport_destroy_subpackets(master_packet_p);
+        fbe_base_object_remove_from_usurper_queue((fbe_base_object_t*)raid_group_p, master_packet_p);
+        fbe_transport_set_status(master_packet_p, FBE_STATUS_OK, 0);
+        fbe_transport_complete_packet(master_packet_p); 
+    }
+
+    return FBE_STATUS_MORE_PROCESSING_REQUIRED;
+
+} // End fbe_raid_group_rebuild_sub_request_completion()
+
+
+/*!****************************************************************************
+ * fbe_raid_group_rebuild_concurrent_io_completion()
+ ******************************************************************************
+ * @brief
+ *   All the rebuild I/Os of a concurrent rebuild request completed.  The
+ *   checkpoint is moved over the completed I/Os which follow each other from
+ *   the start of the request.  The first failed I/O, or the first gap, ends
+ *   the range.  Anything after it is rebuilt again by the next request (its
+ *   chunks are no longer marked and are quickly skipped).
+ *
+ * @param in_packet_p           - the monitor packet of the request
+ * @param in_context            - pointer to the raid group
+ *
+ * @return fbe_status_t
+ *
+ ******************************************************************************/
+static fbe_status_t fbe_raid_group_rebuild_concurrent_io_completion(
+                                    fbe_packet_t*                   in_packet_p, 
+                                    fbe_packet_completion_context_t in_context)
+{
+    fbe_raid_group_t                   *raid_group_p = (fbe_raid_group_t *)in_context;
+    fbe_raid_group_rebuild_context_t   *rebuild_context_p = NULL;
+    fbe_raid_group_rebuild_context_t   *sub_context_p = NULL;
+    fbe_memory_request_t               *memory_request_p = NULL;
+    fbe_status_t                        first_error_status = FBE_STATUS_OK;
+    fbe_bool_t                          b_contiguous = FBE_TRUE;
+    fbe_lba_t                           rebuilt_end_lba;
+    fbe_raid_position_bitmask_t         positions_rebuilt_mask;
+    fbe_u32_t                           max_service_time_ms = 0;
+    fbe_u32_t                           sub_request_count;
+    fbe_u32_t                           index;
+    fbe_status_t                        status;
+
+    fbe_raid_group_rebuild_get_rebuild_context(raid_group_p, in_packet_p, &rebuild_context_p);
+
+    /* If the sub requests could not be issued the status is already set.
+     */
+    sub_request_count = rebuild_context_p->sub_request_count;
+    if (sub_request_count == 0)
+    {
+        return FBE_STATUS_OK;
+    }
+
+    rebuilt_end_lba = rebuild_context_p->start_lba;
+    positions_rebuilt_mask = rebuild_context_p->rebuild_bitmask;
+    for (index = 0; index < sub_request_count; index++)
+    {
+        sub_context_p = rebuild_context_p->sub_request_context_p[index];
+        max_service_time_ms = FBE_MAX(max_service_time_ms, sub_context_p->service_time_ms);
+
+        if (sub_context_p->sub_request_status != FBE_STATUS_OK)
+        {
+            if (first_error_status == FBE_STATUS_OK)
+            {
+                first_error_status = sub_context_p->sub_request_status;
+            }
+            b_contiguous = FBE_FALSE;
+            continue;
+        }
+        if ((b_contiguous == FBE_FALSE)                         ||
+            (sub_context_p->rebuilt_blocks == 0)                ||
+            (sub_context_p->rebuilt_lba > rebuilt_end_lba)         )
+        {
+            b_contiguous = FBE_FALSE;
+            continue;
+        }
+
+        /* A sub request may have moved past its own range when there was
+         * nothing marked after it.
+         */
+        positions_rebuilt_mask &= sub_context_p->rebuilt_bitmask;
+        rebuilt_end_lba = FBE_MAX(rebuilt_end_lba, sub_context_p->rebuilt_lba + sub_context_p->rebuilt_blocks);
+    }
+
+    /* The sub contexts are in the memory we release now.
+     */
+    rebuild_context_p->sub_request_count = 0;
+    memory_request_p = fbe_transport_get_memory_request(in_packet_p);
+    fbe_memory_free_request_entry(memory_request_p);
+
+    /* Only the raid group rebuild is tuned.
+     */
+    if (rebuild_context_p->send_io_function == fbe_raid_group_rebuild_send_io_request)
+    {
+        fbe_raid_group_rebuild_update_tuning(raid_group_p, max_service_time_ms, 
+                                             (first_error_status != FBE_STATUS_OK) ? FBE_TRUE : FBE_FALSE);
+    }
+
+    fbe_raid_group_trace(raid_group_p,
+                         FBE_TRACE_LEVEL_INFO,
+                         FBE_RAID_GROUP_DEBUG_FLAG_REBUILD_TRACING,
+                         "raid_group: rebuild %d ios lba: 0x%llx blks: 0x%llx done to: 0x%llx mask: 0x%x max time: %d ms status: 0x%x\n",
+                         sub_request_count,
+                         (unsigned long long)rebuild_context_p->start_lba,
+                         (unsigned long long)rebuild_context_p->block_count,
+                         (unsigned long long)rebuilt_end_lba, positions_rebuilt_mask,
+                         max_service_time_ms, first_error_status);
+
+    if (rebuilt_end_lba == rebuild_context_p->start_lba)
+    {
+        fbe_base_object_trace((fbe_base_object_t*) raid_group_p, 
+                              FBE_TRACE_LEVEL_WARNING, FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED, 
+                              "%s rebuild lba: 0x%llx failed, status: 0x%x \n", __FUNCTION__, 
+                              (unsigned long long)rebuild_context_p->start_lba, first_error_status);
+        fbe_transport_set_status(in_packet_p, 
+                                 (first_error_status != FBE_STATUS_OK) ? first_error_status : FBE_STATUS_GENERIC_FAILURE, 0);
+        return FBE_STATUS_OK;
+    }
+
+    //  Update the checkpoint(s) and log LUN start/complete if needed 
+    status = fbe_raid_group_rebuild_perform_checkpoint_update_and_log(raid_group_p, 
+                                                                      in_packet_p, 
+                                                                      rebuild_context_p->start_lba, 
+                                                                      rebuilt_end_lba - rebuild_context_p->start_lba,
+                                                                      positions_rebuilt_mask);
+    return FBE_STATUS_MORE_PROCESSING_REQUIRED;
+
+} // End fbe_raid_group_rebuild_concurrent_io_completion()
+
+
 /*!****************************************************************************
  * fbe_raid_group_clear_nr_control_operation()
  ******************************************************************************
@@ -2222,6 +2955,21 @@ static fbe_status_t fbe_raid_group_rebuild_perform_checkpoint_update_and_log(
     fbe_raid_position_bitmask_t     cur_position_mask;          //  bitmask of the current disk's position
     fbe_raid_position_bitmask_t     checkpoint_change_bitmask;  //  bitmask of positions to change checkpoint for 
     fbe_status_t                    status;                     //  fbe status
+    fbe_raid_group_rebuild_context_t *rebuild_context_p;        //  rebuild context of the request
+
+    /* A sub request of a concurrent rebuild only records what it rebuilt.  The
+     * request moves the checkpoint once all its sub requests are done. 
+     */
+    fbe_raid_group_rebuild_get_rebuild_context(in_raid_group_p, in_packet_p, &rebuild_context_p);
+    if (rebuild_context_p->b_sub_request == FBE_TRUE)
+    {
+        rebuild_context_p->rebuilt_lba = in_start_lba;
+        rebuild_context_p->rebuilt_blocks = in_block_count;
+        rebuild_context_p->rebuilt_bitmask = in_positions_to_advance;
+        fbe_transport_set_status(in_packet_p, FBE_STATUS_OK, 0);
+        fbe_transport_complete_packet(in_packet_p);
+        return FBE_STATUS_MORE_PROCESSING_REQUIRED;
+    }
 
     //  Get the per-disk exported capacity of the RG, which is its ending LBA + 1
     exported_disk_capacity = fbe_raid_group_get_exported_disk_capacity(in_raid_group_p);
@@ -2399,9 +3147,7 @@ fbe_status_t fbe_raid_group_incr_rebuild_checkpoint(
     fbe_u32_t       rebuild_index = FBE_RAID_GROUP_INVALID_INDEX;
     fbe_u64_t       metadata_offset;
     fbe_u64_t       second_metadata_offset = 0;
-    fbe_u32_t       ms_since_checkpoint;
-    fbe_time_t      last_checkpoint_time;
-    fbe_u32_t       peer_update_period_ms;
+    fbe_bool_t      b_update_peer;
     fbe_lba_t       exported_per_disk_capacity = 0;
 
     /*  If there are 2 positions being changed, always start at rebuild checkpoint info entry 0.  Otherwise, 
@@ -2430,36 +3176,17 @@ fbe_status_t fbe_raid_group_incr_rebuild_checkpoint(
     }
 
 
-    fbe_raid_group_get_last_checkpoint_time(raid_group_p, &last_checkpoint_time);
+    /* Periodically we will set the checkpoint to the peer, and always when the rebuild finishes. 
+     * Otherwise the checkpoint is only incremented locally in order to not thrash the CMI. 
+     */
     exported_per_disk_capacity = fbe_raid_group_get_exported_disk_capacity(raid_group_p);
-    ms_since_checkpoint = fbe_get_elapsed_milliseconds(last_checkpoint_time);
-    fbe_raid_group_class_get_peer_update_checkpoint_interval_ms(&peer_update_period_ms);
-    if ((ms_since_checkpoint > peer_update_period_ms)             ||
-        ((start_lba + block_count) == exported_per_disk_capacity)    )
-    {
-        /* Periodically we will set the checkpoint to the peer. 
-         * A set is needed since the peer might be out of date with us and an increment 
-         * will not suffice. 
-         */
-        status = fbe_base_config_metadata_nonpaged_force_set_checkpoint((fbe_base_config_t *)raid_group_p,
-                                                                        packet_p,
-                                                                        metadata_offset,
-                                                                        second_metadata_offset,
-                                                                        start_lba + block_count);
-        fbe_raid_group_update_last_checkpoint_time(raid_group_p);
-    }
-    else
-    {
-        /* Increment checkpoint locally without sending to peer in order to not 
-         * thrash the CMI. 
-         */
-        status = fbe_base_config_metadata_nonpaged_incr_checkpoint_no_peer((fbe_base_config_t *)raid_group_p,
-                                                                           packet_p,
-                                                                           metadata_offset,
-                                                                           second_metadata_offset,
-                                                                           start_lba,
-                                                                           block_count);
-    }
+    b_update_peer = (fbe_raid_group_is_checkpoint_peer_update_due(raid_group_p) ||
+                     ((start_lba + block_count) == exported_per_disk_capacity));
+    status = fbe_raid_group_batch_checkpoint(raid_group_p, packet_p, b_update_peer,
+                                             metadata_offset,
+                                             second_metadata_offset,
+                                             start_lba,
+                                             block_count);
         
     //  Check the status of the call and trace if error.  The called function is completing the packet on error
     //  so we can't complete it here.  The condition will remain set so we will try again.
@@ -6898,6 +7625,66 @@ fbe_status_t fbe_raid_group_rebuild_set_background_op_chunks(fbe_u32_t chunks_pe
  * end fbe_raid_group_rebuild_set_background_op_chunks()
  *****************************************************************/
 
+/*!****************************************************************************
+ *  fbe_raid_group_rebuild_set_max_concurrent_ios()
+ ******************************************************************************
+ * @brief
+ *  Set the maximum number of rebuild I/Os a raid group has in flight.
+ *
+ * @param   max_concurrent_ios - 1 issues one rebuild I/O at a time
+ * 
+ * @return fbe_status_t
+ ******************************************************************************/
+fbe_status_t fbe_raid_group_rebuild_set_max_concurrent_ios(fbe_u32_t max_concurrent_ios)
+{
+    if ((max_concurrent_ios == 0) ||
+        (max_concurrent_ios > FBE_RAID_GROUP_REBUILD_MAX_CONCURRENT_IOS))
+    {
+        fbe_topology_class_trace(FBE_CLASS_ID_RAID_GROUP,
+                                 FBE_TRACE_LEVEL_WARNING, 
+                                 FBE_TRACE_MESSAGE_ID_INFO,
+                                 "%s concurrent rebuild ios: %d not between 1 and %d\n", 
+                                 __FUNCTION__, max_concurrent_ios, FBE_RAID_GROUP_REBUILD_MAX_CONCURRENT_IOS);
+        return FBE_STATUS_GENERIC_FAILURE;
+    } 
+
+    fbe_topology_class_trace(FBE_CLASS_ID_RAID_GROUP, 
+                             FBE_TRACE_LEVEL_INFO, 
+                             FBE_TRACE_MESSAGE_ID_INFO,
+                             "%s Setting concurrent rebuild ios to %d\n", 
+                             __FUNCTION__, max_concurrent_ios);
+    fbe_raid_group_rebuild_max_concurrent_ios = max_concurrent_ios; 
+    return FBE_STATUS_OK;
+}
+/*****************************************************************
+ * end fbe_raid_group_rebuild_set_max_concurrent_ios()
+ *****************************************************************/
+
+/*!****************************************************************************
+ *  fbe_raid_group_rebuild_set_catch_up_window()
+ ******************************************************************************
+ * @brief
+ *  Set how far behind another position a position can be and still be
+ *  rebuilt first, so that both are then rebuilt in one pass.
+ *
+ * @param   catch_up_window_blocks - physical blocks, 0 disables the catch up
+ * 
+ * @return fbe_status_t
+ ******************************************************************************/
+fbe_status_t fbe_raid_group_rebuild_set_catch_up_window(fbe_block_count_t catch_up_window_blocks)
+{
+    fbe_topology_class_trace(FBE_CLASS_ID_RAID_GROUP, 
+                             FBE_TRACE_LEVEL_INFO, 
+                             FBE_TRACE_MESSAGE_ID_INFO,
+                             "%s Setting rebuild catch up window to 0x%llx blocks\n", 
+                             __FUNCTION__, (unsigned long long)catch_up_window_blocks);
+    fbe_raid_group_rebuild_catch_up_window_blocks = catch_up_window_blocks; 
+    return FBE_STATUS_OK;
+}
+/*****************************************************************
+ * end fbe_raid_group_rebuild_set_catch_up_window()
+ *****************************************************************/
+
 /*******************************
  * end fbe_raid_group_rebuild.c
  *******************************/
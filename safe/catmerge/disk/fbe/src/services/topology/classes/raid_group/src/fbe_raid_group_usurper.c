@@ -35,6 +35,7 @@
 #include "fbe_raid_group_needs_rebuild.h"
 #include "fbe_private_space_layout.h"
 #include "fbe_raid_group_expansion.h"
+#include "fbe_raid_group_read_ahead.h"
 
 /*****************************************
  * LOCAL FUNCTION DEFINITIONS
@@ -153,6 +154,7 @@ static fbe_status_t fbe_raid_group_get_wear_level_subpacket_completion(fbe_packe
                                                                        fbe_packet_completion_context_t context);
 static fbe_status_t fbe_raid_group_usurper_get_wear_level(fbe_raid_group_t *raid_group_p, fbe_packet_t *packet_p);
 static fbe_status_t fbe_raid_group_usurper_set_lifecycle_timer_interval(fbe_raid_group_t *raid_group_p, fbe_packet_t *packet_p);
+static fbe_status_t fbe_raid_group_usurper_get_read_ahead_stats(fbe_raid_group_t *raid_group_p, fbe_packet_t *packet_p);
 
 /*!***************************************************************
  * fbe_raid_group_control_entry()
@@ -348,6 +350,9 @@ fbe_raid_group_control_entry(fbe_object_handle_t object_handle,
         case FBE_RAID_GROUP_CONTROL_CODE_SET_LIFECYCLE_TIMER:
             status = fbe_raid_group_usurper_set_lifecycle_timer_interval(raid_group_p, packet_p);
             break;
+        case FBE_RAID_GROUP_CONTROL_CODE_GET_READ_AHEAD_STATS:
+            status = fbe_raid_group_usurper_get_read_ahead_stats(raid_group_p, packet_p);
+            break;
         default:
             /* Allow the base config object to handle all other ioctls.
              */
@@ -1321,6 +1326,9 @@ fbe_raid_group_get_info(fbe_raid_group_t * raid_group_p, fbe_packet_t * packet_p
     get_info_p->b_is_event_q_empty = fbe_base_config_event_queue_is_empty_no_lock((fbe_base_config_t*)raid_group_p);
     
     get_info_p->rekey_checkpoint = fbe_raid_group_get_rekey_checkpoint(raid_group_p);
+    get_info_p->rebuild_concurrent_request_count = raid_group_p->rebuild_tuning.concurrent_request_count;
+    get_info_p->rebuild_queue_depth = raid_group_p->rebuild_tuning.queue_depth;
+    get_info_p->rebuild_op_chunks = raid_group_p->rebuild_tuning.op_chunks;
 
     fbe_base_config_get_encryption_mode((fbe_base_config_t*)raid_group_p, &get_info_p->encryption_mode);
     fbe_base_config_get_encryption_state((fbe_base_config_t*)raid_group_p, &get_info_p->encryption_state);
@@ -6967,6 +6975,52 @@ static fbe_status_t fbe_raid_group_usurper_set_lifecycle_timer_interval(fbe_raid
  * end fbe_raid_group_usurper_set_lifecycle_timer_interval()
  ******************************************************************************/
 
+/*!****************************************************************************
+ *          fbe_raid_group_usurper_get_read_ahead_stats()
+ ******************************************************************************
+ *
+ * @brief   This function returns the read-ahead counters of the raid group.
+ *
+ * @param   raid_group_p  - raid group object.
+ * @param   packet_p      - Pointer to the packet.
+ *
+ * @return  status       - status of the operation.
+ *
+ ******************************************************************************/
+static fbe_status_t fbe_raid_group_usurper_get_read_ahead_stats(fbe_raid_group_t *raid_group_p, fbe_packet_t *packet_p)
+{
+    fbe_status_t                                status;
+    fbe_raid_group_get_read_ahead_stats_t      *stats_p = NULL;
+    fbe_payload_control_operation_t            *control_operation_p = NULL;
+    fbe_payload_ex_t                           *sep_payload_p = NULL;
+
+    /* get the control operation of the packet. */
+    sep_payload_p = fbe_transport_get_payload_ex(packet_p);
+    control_operation_p = fbe_payload_ex_get_control_operation(sep_payload_p);
+
+    /* get the control buffer pointer from the packet payload. */
+    status = fbe_raid_group_usurper_get_control_buffer(raid_group_p,
+                                                       packet_p, 
+                                                       sizeof(*stats_p),
+                                                       (fbe_payload_control_buffer_t)&stats_p);
+    if (status != FBE_STATUS_OK) 
+    { 
+        fbe_transport_set_status(packet_p, status, 0);
+        fbe_transport_complete_packet(packet_p);
+        return status; 
+    }
+
+    fbe_raid_group_read_ahead_get_stats(raid_group_p, stats_p);
+
+    fbe_payload_control_set_status(control_operation_p, FBE_PAYLOAD_CONTROL_STATUS_OK);
+    fbe_transport_set_status(packet_p, FBE_STATUS_OK, 0);
+    fbe_transport_complete_packet(packet_p);
+    return FBE_STATUS_OK;
+}
+/******************************************************************************
+ * end fbe_raid_group_usurper_get_read_ahead_stats()
+ ******************************************************************************/
+
 /******************************
  * end fbe_raid_group_usurper.c
  ******************************/
@@ -1695,7 +1695,261 @@ fbe_status_t sas_physical_drive_cdb_build_format(fbe_payload_cdb_operation_t * c
 }
 
 
+/*!**************************************************************
+ * sas_physical_drive_cdb_init_templates()
+ ****************************************************************
+ * @brief
+ *  Build the read and write CDB templates of the drive for its
+ *  physical block size.  Called once the capacity is read, before
+ *  the drive takes I/O.
+ *
+ *  The conversion of client to physical blocks is kept as a shift,
+ *  so only client block sizes which divide the physical block size
+ *  by a power of two use the templates.
+ *
+ * @param sas_physical_drive - Drive.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void sas_physical_drive_cdb_init_templates(fbe_sas_physical_drive_t* sas_physical_drive)
+{
+    fbe_sas_physical_drive_cdb_templates_t *templates_p = &sas_physical_drive->cdb_templates;
+    fbe_sas_physical_drive_cdb_template_t *template_p = NULL;
+    fbe_block_size_t physical_block_size = sas_physical_drive->base_physical_drive.block_size;
+    fbe_u32_t client_blocks;
+    fbe_u32_t index;
+
+    fbe_zero_memory(templates_p, sizeof(fbe_sas_physical_drive_cdb_templates_t));
+    if ((physical_block_size < FBE_BE_BYTES_PER_BLOCK) ||
+        ((physical_block_size % FBE_BE_BYTES_PER_BLOCK) != 0))
+    {
+        /* Everything goes through sas_physical_drive_block_to_cdb_generic().
+         */
+        return;
+    }
+
+    client_blocks = physical_block_size / FBE_BE_BYTES_PER_BLOCK;
+    if ((client_blocks & (client_blocks - 1)) == 0)
+    {
+        templates_p->client_block_size = FBE_BE_BYTES_PER_BLOCK;
+        templates_p->client_blocks_mask = client_blocks - 1;
+        while ((1u << templates_p->client_blocks_shift) < client_blocks)
+        {
+            templates_p->client_blocks_shift++;
+        }
+    }
+
+    for (index = 0; index < FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_LAST; index++)
+    {
+        template_p = &templates_p->templates[index];
+        switch (index)
+        {
+            case FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_READ_10:
+                template_p->cdb[0] = FBE_SCSI_READ_10;
+                template_p->payload_cdb_flags = FBE_PAYLOAD_CDB_FLAGS_DATA_IN;
+                break;
+            case FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_READ_16:
+                template_p->cdb[0] = FBE_SCSI_READ_16;
+                template_p->payload_cdb_flags = FBE_PAYLOAD_CDB_FLAGS_DATA_IN;
+                break;
+            case FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_WRITE_10:
+                template_p->cdb[0] = FBE_SCSI_WRITE_10;
+                template_p->payload_cdb_flags = FBE_PAYLOAD_CDB_FLAGS_DATA_OUT;
+                break;
+            case FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_WRITE_16:
+                template_p->cdb[0] = FBE_SCSI_WRITE_16;
+                template_p->payload_cdb_flags = FBE_PAYLOAD_CDB_FLAGS_DATA_OUT;
+                break;
+        }
+        if ((index == FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_READ_10) ||
+            (index == FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_WRITE_10))
+        {
+            template_p->cdb_length = 10;
+            template_p->priority_byte = 1;
+        }
+        else
+        {
+            template_p->cdb_length = 16;
+            template_p->priority_byte = 15;
+        }
+    }
+
+    /* Set last, this is what the I/O path checks.
+     */
+    templates_p->physical_block_size = physical_block_size;
+    return;
+}
+/******************************************
+ * end sas_physical_drive_cdb_init_templates()
+ ******************************************/
+
+/*!**************************************************************
+ * sas_physical_drive_cdb_build_from_template()
+ ****************************************************************
+ * @brief
+ *  Build a read or write CDB from the templates of the drive.
+ *  The result is the same as from sas_physical_drive_block_to_cdb_generic().
+ *
+ * @param sas_physical_drive - Drive.
+ * @param block_operation - Block operation to convert.
+ * @param cdb_operation - CDB operation to fill in.
+ *
+ * @return fbe_bool_t - FBE_FALSE if the request needs the generic
+ *                      path (other opcode, block size or unaligned).
+ *
+ ****************************************************************/
+static __forceinline fbe_bool_t 
+sas_physical_drive_cdb_build_from_template(fbe_sas_physical_drive_t* sas_physical_drive,
+                                           fbe_payload_block_operation_t* block_operation,
+                                           fbe_payload_cdb_operation_t* cdb_operation)
+{
+    const fbe_sas_physical_drive_cdb_templates_t *templates_p = &sas_physical_drive->cdb_templates;
+    const fbe_sas_physical_drive_cdb_template_t *template_p = NULL;
+    fbe_payload_block_operation_opcode_t block_operation_opcode;
+    fbe_block_size_t block_size;
+    fbe_lba_t lba;
+    fbe_block_count_t block_count;
+    fbe_time_t timeout;
+    fbe_u8_t *cdb = cdb_operation->cdb;
+
+    fbe_payload_block_get_opcode(block_operation, &block_operation_opcode);
+    fbe_payload_block_get_block_size(block_operation, &block_size);
+    fbe_payload_block_get_lba(block_operation, &lba);
+    fbe_payload_block_get_block_count(block_operation, &block_count);
+
+    if ((block_size != templates_p->client_block_size) ||
+        (templates_p->physical_block_size != sas_physical_drive->base_physical_drive.block_size) ||
+        (((lba | block_count) & templates_p->client_blocks_mask) != 0))
+    {
+        return FBE_FALSE;
+    }
+
+    /* Like the generic path, the client lba picks 10 or 16 byte CDBs.
+     */
+    if (block_operation_opcode == FBE_PAYLOAD_BLOCK_OPERATION_OPCODE_READ)
+    {
+        template_p = &templates_p->templates[(lba < 0x00000000FFFFFFFF) ? FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_READ_10 :
+                                                                          FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_READ_16];
+    }
+    else if (block_operation_opcode == FBE_PAYLOAD_BLOCK_OPERATION_OPCODE_WRITE)
+    {
+        template_p = &templates_p->templates[(lba < 0x00000000FFFFFFFF) ? FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_WRITE_10 :
+                                                                          FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_WRITE_16];
+    }
+    else
+    {
+        return FBE_FALSE;
+    }
+
+    lba = lba >> templates_p->client_blocks_shift;
+    block_count = block_count >> templates_p->client_blocks_shift;
+
+    fbe_base_physical_drive_get_default_timeout((fbe_base_physical_drive_t *) sas_physical_drive, &timeout);
+
+#if ZERO_SENSE_BUFFER
+    fbe_zero_memory(cdb_operation->sense_info_buffer, FBE_PAYLOAD_CDB_SENSE_INFO_BUFFER_SIZE);
+#endif
+
+    fbe_payload_cdb_set_transfer_count(cdb_operation, (fbe_u32_t)(block_count * templates_p->physical_block_size));
+    cdb_operation->payload_cdb_flags = template_p->payload_cdb_flags;
+    cdb_operation->payload_cdb_task_attribute = FBE_PAYLOAD_CDB_TASK_ATTRIBUTE_SIMPLE;
+    cdb_operation->timeout = timeout;
+    cdb_operation->payload_sg_descriptor.repeat_count = 1;
+    cdb_operation->cdb_length = template_p->cdb_length;
+    fbe_copy_memory(cdb, template_p->cdb, template_p->cdb_length);
+
+    if (template_p->cdb_length == 10)
+    {
+        cdb[2] = (fbe_u8_t)((lba >> 24) & 0xFF); /* MSB */
+        cdb[3] = (fbe_u8_t)((lba >> 16) & 0xFF); 
+        cdb[4] = (fbe_u8_t)((lba >> 8) & 0xFF);
+        cdb[5] = (fbe_u8_t)(lba & 0xFF); /* LSB */
+        cdb[7] = (fbe_u8_t)((block_count >> 8) & 0xFF); /* MSB */
+        cdb[8] = (fbe_u8_t)(block_count & 0xFF); /* LSB */
+    }
+    else
+    {
+        cdb[2] = (fbe_u8_t)((lba >> 56) & 0xFF); /* MSB */
+        cdb[3] = (fbe_u8_t)((lba >> 48) & 0xFF); 
+        cdb[4] = (fbe_u8_t)((lba >> 40) & 0xFF);
+        cdb[5] = (fbe_u8_t)((lba >> 32) & 0xFF); 
+        cdb[6] = (fbe_u8_t)((lba >> 24) & 0xFF); 
+        cdb[7] = (fbe_u8_t)((lba >> 16) & 0xFF); 
+        cdb[8] = (fbe_u8_t)((lba >> 8) & 0xFF); 
+        cdb[9] = (fbe_u8_t)(lba & 0xFF); /* LSB */
+        cdb[10] = (fbe_u8_t)((block_count >> 24) & 0xFF); /* MSB */
+        cdb[11] = (fbe_u8_t)((block_count >> 16) & 0xFF); 
+        cdb[12] = (fbe_u8_t)((block_count >> 8) & 0xFF);
+        cdb[13] = (fbe_u8_t)(block_count & 0xFF); /* LSB */       
+    }
+
+    if (fbe_payload_block_is_flag_set(block_operation, FBE_PAYLOAD_BLOCK_OPERATION_FLAGS_FORCE_UNIT_ACCESS))
+    {
+        cdb[1] |= FBE_SCSI_FUA;
+    }
+
+    /*Enhanced Queuing*/
+    if (fbe_sas_physical_drive_is_enhanced_queuing_supported(sas_physical_drive) &&
+        (cdb_operation->payload_cdb_priority > FBE_PAYLOAD_CDB_PRIORITY_NORMAL))
+    {
+        /*Set low priority*/
+        cdb[template_p->priority_byte] |= FBE_SCSI_LOW_PRIORITY;
+    }
+
+    /* The generic path only passes unmapped reads on for READ 10.
+     */
+    if ((template_p == &templates_p->templates[FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_READ_10]) &&
+        fbe_payload_block_is_flag_set(block_operation, FBE_PAYLOAD_BLOCK_OPERATION_FLAGS_ALLOW_UNMAP_READ))
+    {
+        cdb_operation->payload_cdb_flags |= FBE_PAYLOAD_CDB_FLAGS_ALLOW_UNMAP_READ;
+    }
+
+    if (fbe_traffic_trace_is_enabled (KTRC_TPDO))
+    {
+        fbe_u16_t extra = fbe_traffic_trace_get_priority_from_cdb(cdb_operation->payload_cdb_priority);
+        fbe_sas_physical_drive_trace_rba(sas_physical_drive, cdb_operation, 
+                                         ((block_operation_opcode == FBE_PAYLOAD_BLOCK_OPERATION_OPCODE_READ) ? KT_TRAFFIC_READ_START : KT_TRAFFIC_WRITE_START) | extra);
+    }
+    return FBE_TRUE;
+}
+/******************************************
+ * end sas_physical_drive_cdb_build_from_template()
+ ******************************************/
+
+/*!**************************************************************
+ * sas_physical_drive_block_to_cdb()
+ ****************************************************************
+ * @brief
+ *  Convert a block operation to a CDB.  Reads and writes are built
+ *  from the templates of the drive, everything else goes through
+ *  sas_physical_drive_block_to_cdb_generic().
+ *
+ * @param sas_physical_drive - Drive.
+ * @param payload - Payload with the block operation.
+ * @param cdb_operation - CDB operation to fill in.
+ *
+ * @return fbe_status_t
+ *
+ ****************************************************************/
 fbe_status_t sas_physical_drive_block_to_cdb(fbe_sas_physical_drive_t * sas_physical_drive, 
+                                             fbe_payload_ex_t* payload, 
+                                             fbe_payload_cdb_operation_t * cdb_operation)
+{
+    if (sas_physical_drive_cdb_build_from_template(sas_physical_drive, 
+                                                   fbe_payload_ex_get_block_operation(payload), 
+                                                   cdb_operation))
+    {
+        return FBE_STATUS_OK;
+    }
+    return sas_physical_drive_block_to_cdb_generic(sas_physical_drive, payload, cdb_operation);
+}
+/******************************************
+ * end sas_physical_drive_block_to_cdb()
+ ******************************************/
+
+/* Convert any block operation to a CDB, building every field from scratch. */
+fbe_status_t sas_physical_drive_block_to_cdb_generic(fbe_sas_physical_drive_t * sas_physical_drive, 
 											 fbe_payload_ex_t* payload, 
 											 fbe_payload_cdb_operation_t * cdb_operation)
 {
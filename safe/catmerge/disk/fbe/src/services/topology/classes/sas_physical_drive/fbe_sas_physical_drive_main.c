@@ -115,6 +115,9 @@ fbe_sas_physical_drive_init(fbe_sas_physical_drive_t * sas_physical_drive)
 
     sas_physical_drive->sas_drive_info.sanitize_status = FBE_DRIVE_SANITIZE_STATUS_OK;
     sas_physical_drive->sas_drive_info.sanitize_percent = FBE_DRIVE_MAX_SANITIZATION_PERCENT;
+
+    /* CDB templates are built once we know the block size */
+    fbe_zero_memory(&sas_physical_drive->cdb_templates, sizeof(fbe_sas_physical_drive_cdb_templates_t));
     
 
     /* Initialize virtual functions.  Subclasses can override these. */
@@ -107,6 +107,7 @@ fbe_sas_physical_drive_process_read_capacity_10(fbe_sas_physical_drive_t * sas_p
     }
 
     fbe_base_physical_drive_set_capacity((fbe_base_physical_drive_t *) sas_physical_drive, block_count, block_size);
+    sas_physical_drive_cdb_init_templates(sas_physical_drive);
 
     return FBE_SAS_DRIVE_STATUS_OK;
 }
@@ -152,6 +153,7 @@ fbe_sas_physical_drive_process_read_capacity_16(fbe_sas_physical_drive_t * sas_p
     }
 
     fbe_base_physical_drive_set_capacity((fbe_base_physical_drive_t *)sas_physical_drive, block_count, block_size);
+    sas_physical_drive_cdb_init_templates(sas_physical_drive);
 
     return FBE_SAS_DRIVE_STATUS_OK;
 }
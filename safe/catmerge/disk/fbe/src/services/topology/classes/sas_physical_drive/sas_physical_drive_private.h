@@ -148,6 +148,50 @@ typedef enum fbe_sas_drive_status_e{
     FBE_SAS_DRIVE_STATUS_LAST
 }fbe_sas_drive_status_t;
 
+/*!*******************************************************************
+ * @enum fbe_sas_physical_drive_cdb_template_index_t
+ *********************************************************************
+ * @brief Read and write CDBs we keep a precomputed template for.
+ *
+ *********************************************************************/
+typedef enum fbe_sas_physical_drive_cdb_template_index_e{
+    FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_READ_10 = 0,
+    FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_READ_16,
+    FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_WRITE_10,
+    FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_WRITE_16,
+
+    FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_LAST
+}fbe_sas_physical_drive_cdb_template_index_t;
+
+/*!*******************************************************************
+ * @struct fbe_sas_physical_drive_cdb_template_t
+ *********************************************************************
+ * @brief Everything of a read or write CDB which does not depend on
+ *        the request.  Only the lba, length and flags get patched in.
+ *
+ *********************************************************************/
+typedef struct fbe_sas_physical_drive_cdb_template_s{
+    fbe_u8_t                cdb[FBE_PAYLOAD_CDB_CDB_SIZE];
+    fbe_u8_t                cdb_length;
+    fbe_u8_t                priority_byte;  /* CDB byte holding the low priority bit. */
+    fbe_payload_cdb_flags_t payload_cdb_flags;
+}fbe_sas_physical_drive_cdb_template_t;
+
+/*!*******************************************************************
+ * @struct fbe_sas_physical_drive_cdb_templates_t
+ *********************************************************************
+ * @brief Per drive CDB templates and the block size conversion of
+ *        client to physical blocks.  Built when the capacity of the
+ *        drive is read.
+ *
+ *********************************************************************/
+typedef struct fbe_sas_physical_drive_cdb_templates_s{
+    fbe_block_size_t    physical_block_size;    /* 0 until the templates are built. */
+    fbe_block_size_t    client_block_size;      /* 0 if the conversion cannot use a shift. */
+    fbe_u32_t           client_blocks_mask;     /* Client blocks per physical block - 1. */
+    fbe_u32_t           client_blocks_shift;    /* log2 of client blocks per physical block. */
+    fbe_sas_physical_drive_cdb_template_t templates[FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_LAST];
+}fbe_sas_physical_drive_cdb_templates_t;
 
 typedef struct fbe_sas_physical_drive_s{
     fbe_base_physical_drive_t   base_physical_drive;
@@ -161,6 +205,9 @@ typedef struct fbe_sas_physical_drive_s{
     fbe_ssp_edge_t ssp_edge;
 
     fbe_sas_physical_drive_info_block_t  sas_drive_info;
+
+    /* Precomputed read and write CDBs */
+    fbe_sas_physical_drive_cdb_templates_t cdb_templates;
     
     // virtual functions
     fbe_sas_drive_status_t (*get_vendor_table)(struct fbe_sas_physical_drive_s * sas_physical_drive, fbe_drive_vendor_id_t drive_vendor_id, fbe_vendor_page_t ** table_ptr, fbe_u16_t * num_table_entries); 
@@ -340,6 +387,10 @@ fbe_status_t sas_physical_drive_convert_block_to_cdb_return_error(fbe_sas_physic
 fbe_status_t sas_physical_drive_block_to_cdb(fbe_sas_physical_drive_t* sas_physical_drive, 
 											 fbe_payload_ex_t* payload, 
 											 fbe_payload_cdb_operation_t* cdb_operation);
+fbe_status_t sas_physical_drive_block_to_cdb_generic(fbe_sas_physical_drive_t* sas_physical_drive, 
+                                                     fbe_payload_ex_t* payload, 
+                                                     fbe_payload_cdb_operation_t* cdb_operation);
+void sas_physical_drive_cdb_init_templates(fbe_sas_physical_drive_t* sas_physical_drive);
 
 
 fbe_status_t fbe_sas_physical_drive_fill_dc_info(fbe_sas_physical_drive_t * sas_physical_drive, fbe_payload_cdb_operation_t * payload_cdb_operation,
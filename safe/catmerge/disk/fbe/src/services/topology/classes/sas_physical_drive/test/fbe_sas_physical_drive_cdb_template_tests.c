@@ -0,0 +1,379 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2014
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!**************************************************************************
+ * @file fbe_sas_physical_drive_cdb_template_tests.c
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains the unit test for the read and write CDB templates
+ *  of the sas physical drive.
+ *
+ ***************************************************************************/
+#include "sas_physical_drive_private.h"
+#include "fbe_sas_physical_drive_test.h"
+#include "fbe/fbe_time.h"
+#include <stdlib.h>
+
+/*!*******************************************************************
+ * @def FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_TEST_ITERATIONS
+ *********************************************************************
+ * @brief CDBs built for each timing.
+ *********************************************************************/
+#define FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_TEST_ITERATIONS 1000000
+
+/*!*******************************************************************
+ * @def FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_TEST_TIMEOUT
+ *********************************************************************
+ * @brief Default timeout of the test drive.
+ *********************************************************************/
+#define FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_TEST_TIMEOUT 18000
+
+/*!*******************************************************************
+ * @def FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_TEST_FILL
+ *********************************************************************
+ * @brief Written over the CDB before each build, so fields the two
+ *        paths leave alone compare as well.
+ *********************************************************************/
+#define FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_TEST_FILL 0xA5
+
+/* fbe_sas_physical_drive_cdb_template_test */
+char * fbe_sas_physical_drive_cdb_template_short_desc = "Compare CDBs built from the templates with the generic build";
+char * fbe_sas_physical_drive_cdb_template_long_desc =
+    "Builds the CDB of every opcode, physical block size, lba range, flag and priority\n"
+    "both with the per drive templates and with the generic build and checks that the\n"
+    "CDB operations are identical.\n"
+    "Reports the cost of building read and write CDBs both ways.\n";
+
+static fbe_block_size_t fbe_sas_physical_drive_cdb_template_test_block_sizes[] =
+{
+    FBE_BE_BYTES_PER_BLOCK, FBE_4K_BYTES_PER_BLOCK,
+};
+static fbe_payload_block_operation_opcode_t fbe_sas_physical_drive_cdb_template_test_opcodes[] =
+{
+    FBE_PAYLOAD_BLOCK_OPERATION_OPCODE_READ,
+    FBE_PAYLOAD_BLOCK_OPERATION_OPCODE_WRITE,
+    FBE_PAYLOAD_BLOCK_OPERATION_OPCODE_VERIFY,
+    FBE_PAYLOAD_BLOCK_OPERATION_OPCODE_WRITE_VERIFY,
+};
+static fbe_lba_t fbe_sas_physical_drive_cdb_template_test_lbas[] =
+{
+    0, 0x8, 0x12340, 0xFFFFFF00, 0xFFFFFFF8, 0x100000000, 0x123456789A0,
+};
+static fbe_block_count_t fbe_sas_physical_drive_cdb_template_test_blocks[] =
+{
+    0x8, 0x80, 0x800,
+};
+static fbe_payload_block_operation_flags_t fbe_sas_physical_drive_cdb_template_test_flags[] =
+{
+    FBE_PAYLOAD_BLOCK_OPERATION_FLAGS_NONE,
+    FBE_PAYLOAD_BLOCK_OPERATION_FLAGS_FORCE_UNIT_ACCESS,
+    FBE_PAYLOAD_BLOCK_OPERATION_FLAGS_ALLOW_UNMAP_READ,
+};
+static fbe_payload_cdb_priority_t fbe_sas_physical_drive_cdb_template_test_priorities[] =
+{
+    FBE_PAYLOAD_CDB_PRIORITY_NORMAL, FBE_PAYLOAD_CDB_PRIORITY_LOW,
+};
+
+#define FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_TEST_COUNT(m_array) (sizeof(m_array) / sizeof(m_array[0]))
+
+/*!**************************************************************
+ * fbe_sas_physical_drive_cdb_template_test_create_drive()
+ ****************************************************************
+ * @brief
+ *  Create a drive object with just what the CDB build uses.
+ *
+ * @param block_size - Physical block size of the drive.
+ * @param b_enhanced_queuing - Drive supports enhanced queuing.
+ *
+ * @return fbe_sas_physical_drive_t *
+ *
+ ****************************************************************/
+static fbe_sas_physical_drive_t *fbe_sas_physical_drive_cdb_template_test_create_drive(fbe_block_size_t block_size,
+                                                                                      fbe_bool_t b_enhanced_queuing)
+{
+    fbe_sas_physical_drive_t *sas_physical_drive_p = malloc(sizeof(fbe_sas_physical_drive_t));
+
+    MUT_ASSERT_NOT_NULL(sas_physical_drive_p);
+    fbe_zero_memory(sas_physical_drive_p, sizeof(fbe_sas_physical_drive_t));
+    fbe_base_physical_drive_set_block_size((fbe_base_physical_drive_t *)sas_physical_drive_p, block_size);
+    fbe_base_physical_drive_set_default_timeout((fbe_base_physical_drive_t *)sas_physical_drive_p,
+                                                FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_TEST_TIMEOUT);
+    fbe_base_physical_drive_set_enhanced_queuing_supported((fbe_base_physical_drive_t *)sas_physical_drive_p,
+                                                           b_enhanced_queuing);
+    sas_physical_drive_cdb_init_templates(sas_physical_drive_p);
+    return sas_physical_drive_p;
+}
+/******************************************
+ * end fbe_sas_physical_drive_cdb_template_test_create_drive()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_sas_physical_drive_cdb_template_test_init_packet()
+ ****************************************************************
+ * @brief
+ *  Set up a packet with a block operation and a CDB operation
+ *  the way the I/O path of the drive does.
+ *
+ * @param packet_p - Packet to set up.
+ * @param opcode - Block opcode.
+ * @param lba - Client lba.
+ * @param blocks - Client blocks.
+ * @param flags - Block operation flags.
+ * @param priority - CDB priority.
+ *
+ * @return fbe_payload_cdb_operation_t *
+ *
+ ****************************************************************/
+static fbe_payload_cdb_operation_t *
+fbe_sas_physical_drive_cdb_template_test_init_packet(fbe_packet_t *packet_p,
+                                                     fbe_payload_block_operation_opcode_t opcode,
+                                                     fbe_lba_t lba,
+                                                     fbe_block_count_t blocks,
+                                                     fbe_payload_block_operation_flags_t flags,
+                                                     fbe_payload_cdb_priority_t priority)
+{
+    fbe_payload_ex_t *payload_p = NULL;
+    fbe_payload_block_operation_t *block_operation_p = NULL;
+    fbe_payload_cdb_operation_t *cdb_operation_p = NULL;
+
+    fbe_transport_initialize_packet(packet_p);
+    payload_p = fbe_transport_get_payload_ex(packet_p);
+    block_operation_p = fbe_payload_ex_allocate_block_operation(payload_p);
+    MUT_ASSERT_NOT_NULL(block_operation_p);
+    fbe_payload_block_build_operation(block_operation_p, opcode, lba, blocks,
+                                      FBE_BE_BYTES_PER_BLOCK, 1, NULL);
+    if (flags != FBE_PAYLOAD_BLOCK_OPERATION_FLAGS_NONE)
+    {
+        fbe_payload_block_set_flag(block_operation_p, flags);
+    }
+    fbe_payload_ex_increment_block_operation_level(payload_p);
+
+    cdb_operation_p = fbe_payload_ex_allocate_cdb_operation(payload_p);
+    MUT_ASSERT_NOT_NULL(cdb_operation_p);
+    cdb_operation_p->payload_cdb_priority = priority;
+    return cdb_operation_p;
+}
+/******************************************
+ * end fbe_sas_physical_drive_cdb_template_test_init_packet()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_sas_physical_drive_cdb_template_test_fill()
+ ****************************************************************
+ * @brief
+ *  Overwrite every field the CDB build sets.
+ *
+ * @param cdb_operation_p - CDB operation.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void fbe_sas_physical_drive_cdb_template_test_fill(fbe_payload_cdb_operation_t *cdb_operation_p)
+{
+    fbe_set_memory(cdb_operation_p->cdb, FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_TEST_FILL, FBE_PAYLOAD_CDB_CDB_SIZE);
+    cdb_operation_p->cdb_length = FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_TEST_FILL;
+    cdb_operation_p->payload_cdb_task_attribute = FBE_PAYLOAD_CDB_TASK_ATTRIBUTE_INVALID;
+    cdb_operation_p->payload_cdb_flags = FBE_PAYLOAD_CDB_FLAGS_NO_DATA_TRANSFER;
+    cdb_operation_p->timeout = 0;
+    cdb_operation_p->payload_sg_descriptor.repeat_count = 0;
+    cdb_operation_p->transfer_count = 0xFFFFFFFF;
+    return;
+}
+/******************************************
+ * end fbe_sas_physical_drive_cdb_template_test_fill()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_sas_physical_drive_cdb_template_test_compare()
+ ****************************************************************
+ * @brief
+ *  Build one CDB both ways and make sure the results match.
+ *
+ * @param sas_physical_drive_p - Drive.
+ * @param packet_p - Packet set up with the request.
+ * @param cdb_operation_p - CDB operation of the packet.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static void fbe_sas_physical_drive_cdb_template_test_compare(fbe_sas_physical_drive_t *sas_physical_drive_p,
+                                                             fbe_packet_t *packet_p,
+                                                             fbe_payload_cdb_operation_t *cdb_operation_p)
+{
+    fbe_payload_ex_t *payload_p = fbe_transport_get_payload_ex(packet_p);
+    fbe_payload_cdb_operation_t expected;
+    fbe_status_t template_status;
+    fbe_status_t generic_status;
+
+    fbe_sas_physical_drive_cdb_template_test_fill(cdb_operation_p);
+    generic_status = sas_physical_drive_block_to_cdb_generic(sas_physical_drive_p, payload_p, cdb_operation_p);
+    expected = *cdb_operation_p;
+
+    fbe_sas_physical_drive_cdb_template_test_fill(cdb_operation_p);
+    template_status = sas_physical_drive_block_to_cdb(sas_physical_drive_p, payload_p, cdb_operation_p);
+
+    MUT_ASSERT_INT_EQUAL(template_status, generic_status);
+    MUT_ASSERT_INT_EQUAL(memcmp(cdb_operation_p->cdb, expected.cdb, FBE_PAYLOAD_CDB_CDB_SIZE), 0);
+    MUT_ASSERT_INT_EQUAL(cdb_operation_p->cdb_length, expected.cdb_length);
+    MUT_ASSERT_INT_EQUAL(cdb_operation_p->payload_cdb_task_attribute, expected.payload_cdb_task_attribute);
+    MUT_ASSERT_INT_EQUAL(cdb_operation_p->payload_cdb_flags, expected.payload_cdb_flags);
+    MUT_ASSERT_UINT64_EQUAL(cdb_operation_p->timeout, expected.timeout);
+    MUT_ASSERT_INT_EQUAL(cdb_operation_p->payload_sg_descriptor.repeat_count, expected.payload_sg_descriptor.repeat_count);
+    MUT_ASSERT_INT_EQUAL(cdb_operation_p->transfer_count, expected.transfer_count);
+    return;
+}
+/******************************************
+ * end fbe_sas_physical_drive_cdb_template_test_compare()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_sas_physical_drive_cdb_template_test_time()
+ ****************************************************************
+ * @brief
+ *  Time building a read or write CDB one way.
+ *
+ * @param sas_physical_drive_p - Drive.
+ * @param opcode - Read or write.
+ * @param b_template - FBE_TRUE to use the templates.
+ *
+ * @return fbe_u32_t - nsec per CDB.
+ *
+ ****************************************************************/
+static fbe_u32_t fbe_sas_physical_drive_cdb_template_test_time(fbe_sas_physical_drive_t *sas_physical_drive_p,
+                                                               fbe_payload_block_operation_opcode_t opcode,
+                                                               fbe_bool_t b_template)
+{
+    fbe_packet_t *packet_p = malloc(sizeof(fbe_packet_t));
+    fbe_payload_ex_t *payload_p = NULL;
+    fbe_payload_block_operation_t *block_operation_p = NULL;
+    fbe_payload_cdb_operation_t *cdb_operation_p = NULL;
+    fbe_u32_t iteration;
+    fbe_time_t start_time;
+    fbe_u32_t elapsed_us;
+
+    MUT_ASSERT_NOT_NULL(packet_p);
+    cdb_operation_p = fbe_sas_physical_drive_cdb_template_test_init_packet(packet_p, opcode, 0, 0x10,
+                                                                           FBE_PAYLOAD_BLOCK_OPERATION_FLAGS_NONE,
+                                                                           FBE_PAYLOAD_CDB_PRIORITY_NORMAL);
+    payload_p = fbe_transport_get_payload_ex(packet_p);
+    block_operation_p = fbe_payload_ex_get_block_operation(payload_p);
+
+    start_time = fbe_get_time_in_us();
+    for (iteration = 0; iteration < FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_TEST_ITERATIONS; iteration++)
+    {
+        block_operation_p->lba = ((fbe_lba_t)iteration * 0x10) & 0x3FFFFFFF;
+        if (b_template)
+        {
+            sas_physical_drive_block_to_cdb(sas_physical_drive_p, payload_p, cdb_operation_p);
+        }
+        else
+        {
+            sas_physical_drive_block_to_cdb_generic(sas_physical_drive_p, payload_p, cdb_operation_p);
+        }
+    }
+    elapsed_us = fbe_get_elapsed_microseconds(start_time);
+
+    free(packet_p);
+    return (fbe_u32_t)(((fbe_u64_t)elapsed_us * 1000) / FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_TEST_ITERATIONS);
+}
+/******************************************
+ * end fbe_sas_physical_drive_cdb_template_test_time()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_sas_physical_drive_cdb_template_test()
+ ****************************************************************
+ * @brief
+ *  Check that the templates build the same CDBs as the generic
+ *  path and report what they save.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void fbe_sas_physical_drive_cdb_template_test(void)
+{
+    fbe_sas_physical_drive_t *sas_physical_drive_p = NULL;
+    fbe_packet_t *packet_p = malloc(sizeof(fbe_packet_t));
+    fbe_payload_cdb_operation_t *cdb_operation_p = NULL;
+    fbe_u32_t size_index, queuing, opcode_index, lba_index, blocks_index, flags_index, priority_index;
+    fbe_u32_t cases = 0;
+    fbe_u32_t generic_nsec;
+    fbe_u32_t template_nsec;
+
+    MUT_ASSERT_NOT_NULL(packet_p);
+
+    for (size_index = 0; size_index < FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_TEST_COUNT(fbe_sas_physical_drive_cdb_template_test_block_sizes); size_index++)
+    {
+        for (queuing = 0; queuing < 2; queuing++)
+        {
+            sas_physical_drive_p = fbe_sas_physical_drive_cdb_template_test_create_drive(fbe_sas_physical_drive_cdb_template_test_block_sizes[size_index],
+                                                                                         (queuing != 0));
+            MUT_ASSERT_INT_EQUAL(sas_physical_drive_p->cdb_templates.physical_block_size,
+                                 fbe_sas_physical_drive_cdb_template_test_block_sizes[size_index]);
+            MUT_ASSERT_INT_EQUAL(sas_physical_drive_p->cdb_templates.client_block_size, FBE_BE_BYTES_PER_BLOCK);
+
+            for (opcode_index = 0; opcode_index < FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_TEST_COUNT(fbe_sas_physical_drive_cdb_template_test_opcodes); opcode_index++)
+            for (lba_index = 0; lba_index < FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_TEST_COUNT(fbe_sas_physical_drive_cdb_template_test_lbas); lba_index++)
+            for (blocks_index = 0; blocks_index < FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_TEST_COUNT(fbe_sas_physical_drive_cdb_template_test_blocks); blocks_index++)
+            for (flags_index = 0; flags_index < FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_TEST_COUNT(fbe_sas_physical_drive_cdb_template_test_flags); flags_index++)
+            for (priority_index = 0; priority_index < FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_TEST_COUNT(fbe_sas_physical_drive_cdb_template_test_priorities); priority_index++)
+            {
+                cdb_operation_p = fbe_sas_physical_drive_cdb_template_test_init_packet(packet_p,
+                                                                                       fbe_sas_physical_drive_cdb_template_test_opcodes[opcode_index],
+                                                                                       fbe_sas_physical_drive_cdb_template_test_lbas[lba_index],
+                                                                                       fbe_sas_physical_drive_cdb_template_test_blocks[blocks_index],
+                                                                                       fbe_sas_physical_drive_cdb_template_test_flags[flags_index],
+                                                                                       fbe_sas_physical_drive_cdb_template_test_priorities[priority_index]);
+                fbe_sas_physical_drive_cdb_template_test_compare(sas_physical_drive_p, packet_p, cdb_operation_p);
+                cases++;
+            }
+
+            /* Unaligned reads of a 4K drive take the generic path with the bitbucket.
+             */
+            cdb_operation_p = fbe_sas_physical_drive_cdb_template_test_init_packet(packet_p,
+                                                                                   FBE_PAYLOAD_BLOCK_OPERATION_OPCODE_READ,
+                                                                                   0x13, 0x7,
+                                                                                   FBE_PAYLOAD_BLOCK_OPERATION_FLAGS_NONE,
+                                                                                   FBE_PAYLOAD_CDB_PRIORITY_NORMAL);
+            fbe_sas_physical_drive_cdb_template_test_compare(sas_physical_drive_p, packet_p, cdb_operation_p);
+            cases++;
+            free(sas_physical_drive_p);
+        }
+    }
+    mut_printf(MUT_LOG_TEST_STATUS, "cdb template: %u CDBs identical to the generic build", cases);
+
+    for (size_index = 0; size_index < FBE_SAS_PHYSICAL_DRIVE_CDB_TEMPLATE_TEST_COUNT(fbe_sas_physical_drive_cdb_template_test_block_sizes); size_index++)
+    {
+        sas_physical_drive_p = fbe_sas_physical_drive_cdb_template_test_create_drive(fbe_sas_physical_drive_cdb_template_test_block_sizes[size_index],
+                                                                                     FBE_TRUE);
+        for (opcode_index = 0; opcode_index < 2; opcode_index++)
+        {
+            generic_nsec = fbe_sas_physical_drive_cdb_template_test_time(sas_physical_drive_p,
+                                                                         fbe_sas_physical_drive_cdb_template_test_opcodes[opcode_index],
+                                                                         FBE_FALSE);
+            template_nsec = fbe_sas_physical_drive_cdb_template_test_time(sas_physical_drive_p,
+                                                                          fbe_sas_physical_drive_cdb_template_test_opcodes[opcode_index],
+                                                                          FBE_TRUE);
+            mut_printf(MUT_LOG_TEST_STATUS, "cdb template: block size %4u %s: generic %u nsec, template %u nsec per CDB",
+                       fbe_sas_physical_drive_cdb_template_test_block_sizes[size_index],
+                       (opcode_index == 0) ? "read " : "write",
+                       generic_nsec, template_nsec);
+        }
+        free(sas_physical_drive_p);
+    }
+    free(packet_p);
+    return;
+}
+/******************************************
+ * end fbe_sas_physical_drive_cdb_template_test()
+ ******************************************/
+
+/*******************************
+ * end fbe_sas_physical_drive_cdb_template_tests.c
+ *******************************/
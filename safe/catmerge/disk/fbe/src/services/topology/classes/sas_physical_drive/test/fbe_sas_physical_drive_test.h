@@ -0,0 +1,10 @@
+#ifndef FBE_SAS_PHYSICAL_DRIVE_TEST_H
+#define FBE_SAS_PHYSICAL_DRIVE_TEST_H
+
+#include "mut.h"
+
+extern char * fbe_sas_physical_drive_cdb_template_short_desc;
+extern char * fbe_sas_physical_drive_cdb_template_long_desc;
+void fbe_sas_physical_drive_cdb_template_test(void);
+
+#endif
@@ -0,0 +1,62 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2014
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!**************************************************************************
+ * @file fbe_sas_physical_drive_test_main.c
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains the unit test for the sas physical drive.
+ * 
+ * @ingroup sas_physical_drive_unit_test_files
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "sas_physical_drive_private.h"
+#include "fbe_sas_physical_drive_test.h"
+#include "fbe/fbe_emcutil_shell_include.h"
+
+/*!***************************************************************
+ * main()
+ ****************************************************************
+ * @brief
+ *  This function is the main routine for the test.  
+ *  Test suite is created here and tests are added to the suite.
+ *  Suite is then excuted.
+ *
+ * @param  - argc, argv.
+ *
+ * @return - None 
+ *
+ ****************************************************************/
+int __cdecl main (int argc , char **argv)
+{
+    mut_testsuite_t *sas_physical_drive_test_suite;     /* pointer to testsuite structure */
+
+    #include "fbe/fbe_emcutil_shell_maincode.h"
+
+    mut_init(argc, argv);                               /* before proceeding we need to initialize MUT infrastructure */
+
+    sas_physical_drive_test_suite = MUT_CREATE_TESTSUITE("sas_physical_drive_test_suite")  /* testsuite is created */
+    MUT_ADD_TEST_WITH_DESCRIPTION(sas_physical_drive_test_suite, 
+                                  fbe_sas_physical_drive_cdb_template_test, 
+                                  NULL,
+                                  NULL,
+                                  fbe_sas_physical_drive_cdb_template_short_desc, 
+                                  fbe_sas_physical_drive_cdb_template_long_desc)
+
+    MUT_RUN_TESTSUITE(sas_physical_drive_test_suite)
+}
+/**************************************************************
+ * end main()
+ **************************************************************/
+
+/*******************************
+ * end fbe_sas_physical_drive_test_main.c
+ *******************************/
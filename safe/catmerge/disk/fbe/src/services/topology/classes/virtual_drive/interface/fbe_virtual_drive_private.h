@@ -48,6 +48,12 @@
 #define FBE_VIRTUAL_DRIVE_COPY_CPUS_PER_SECOND      500
 #define FBE_VIRTUAL_DRIVE_COPY_MBYTES_CONSUMPTION     8
 
+/*! @def FBE_VIRTUAL_DRIVE_COPY_DEFAULT_REGIONS
+ *  @brief Number of regions of FBE_VIRTUAL_DRIVE_COPY_MBYTES_CONSUMPTION each 
+ *         that a copy request of the user area copies at the same time.
+ */
+#define FBE_VIRTUAL_DRIVE_COPY_DEFAULT_REGIONS      FBE_RAID_GROUP_REBUILD_MAX_CONCURRENT_IOS
+
 /******************************
  * STRUCTURE DEFINITIONS.
  ******************************/
@@ -1170,6 +1176,8 @@ fbe_status_t fbe_virtual_drive_send_request_to_mark_consumed(fbe_virtual_drive_t
 
 void fbe_virtual_drive_set_unused_as_spare_flag(fbe_bool_t flag);
 
+fbe_status_t fbe_virtual_drive_copy_set_concurrent_regions(fbe_u32_t concurrent_regions);
+
 fbe_status_t fbe_virtual_drive_logging_log_all_copies_complete(fbe_virtual_drive_t *virtual_drive_p,
                                                                fbe_packet_t *in_packet_p, 
                                                                fbe_u32_t in_position);
@@ -49,6 +49,7 @@ static fbe_status_t fbe_virtual_drive_class_set_raid_group_debug_flags(fbe_packe
 static fbe_status_t fbe_virtual_drive_class_get_debug_flags(fbe_packet_t * packet_p);
 static fbe_status_t fbe_virtual_drive_class_set_debug_flags(fbe_packet_t * packet_p);
 static fbe_status_t fbe_virtual_drive_class_get_performance_tier(fbe_packet_t *packet_p);
+static fbe_status_t fbe_virtual_drive_class_set_copy_concurrent_regions(fbe_packet_t *packet_p);
 
 /*!***************************************************************
  * fbe_virtual_drive_class_control_entry()
@@ -112,6 +113,9 @@ fbe_virtual_drive_class_control_entry(fbe_packet_t * packet)
         case FBE_VIRTUAL_DRIVE_CONTROL_CODE_CLASS_GET_PERFORMANCE_TIER:
             status = fbe_virtual_drive_class_get_performance_tier(packet);
             break;
+        case FBE_VIRTUAL_DRIVE_CONTROL_CODE_CLASS_SET_COPY_CONCURRENT_REGIONS:
+            status = fbe_virtual_drive_class_set_copy_concurrent_regions(packet);
+            break;
         default:
             fbe_transport_set_status(packet, FBE_STATUS_GENERIC_FAILURE, 0);
             status = fbe_transport_complete_packet(packet);
@@ -1131,6 +1135,65 @@ static fbe_status_t fbe_virtual_drive_class_get_performance_tier(fbe_packet_t *p
  * end fbe_virtual_drive_class_get_performance_tier()
  ******************************************************************************/
 
+/*!****************************************************************************
+ *          fbe_virtual_drive_class_set_copy_concurrent_regions()
+ ****************************************************************************** 
+ * 
+ * @brief   Set the number of regions each copy request of the virtual drives
+ *          copies at the same time.
+ *
+ * @param   packet_p - The packet that is arriving.
+ *
+ * @return  fbe_status_t - Return status of the operation.
+ * 
+ ******************************************************************************/
+static fbe_status_t fbe_virtual_drive_class_set_copy_concurrent_regions(fbe_packet_t *packet_p)
+{
+    fbe_status_t                                                    status;
+    fbe_virtual_drive_control_class_set_copy_concurrent_regions_t  *set_regions_p = NULL;
+    fbe_payload_ex_t                                               *sep_payload = NULL;
+    fbe_payload_control_operation_t                                *control_operation = NULL; 
+    fbe_u32_t                                                       length = 0;
+
+    sep_payload = fbe_transport_get_payload_ex(packet_p);
+    control_operation = fbe_payload_ex_get_control_operation(sep_payload);  
+
+    fbe_payload_control_get_buffer(control_operation, &set_regions_p);
+    if (set_regions_p == NULL)
+    {
+        fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
+        fbe_transport_set_status(packet_p, FBE_STATUS_GENERIC_FAILURE, 0);
+        fbe_transport_complete_packet(packet_p);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    fbe_payload_control_get_buffer_length (control_operation, &length);
+    if (length != sizeof(fbe_virtual_drive_control_class_set_copy_concurrent_regions_t))
+    {
+        fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
+        fbe_transport_set_status(packet_p, FBE_STATUS_GENERIC_FAILURE, 0);
+        fbe_transport_complete_packet(packet_p);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    status = fbe_virtual_drive_copy_set_concurrent_regions(set_regions_p->concurrent_regions);
+    if (status != FBE_STATUS_OK)
+    {
+        fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
+        fbe_transport_set_status(packet_p, FBE_STATUS_OK, 0);
+        fbe_transport_complete_packet(packet_p);
+        return status;
+    }
+
+    fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_OK);
+    fbe_transport_set_status(packet_p, FBE_STATUS_OK, 0);
+    fbe_transport_complete_packet(packet_p);
+    return FBE_STATUS_OK;
+}
+/******************************************************************************
+ * end fbe_virtual_drive_class_set_copy_concurrent_regions()
+ ******************************************************************************/
+
 
 /*******************************
  * end fbe_virtual_drive_class.c
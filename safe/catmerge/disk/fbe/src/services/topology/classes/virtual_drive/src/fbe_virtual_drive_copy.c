@@ -40,6 +40,22 @@ static fbe_status_t fbe_virtual_drive_copy_send_event_to_check_lba_completion(
                                         fbe_event_t*                    in_event_p,
                                         fbe_event_completion_context_t  in_context);
 
+static fbe_block_count_t fbe_virtual_drive_copy_get_region_blocks(fbe_virtual_drive_t *virtual_drive_p);
+
+static fbe_status_t fbe_virtual_drive_copy_send_region_io_request(fbe_raid_group_t *raid_group_p,
+                                                                  fbe_packet_t *packet_p,
+                                                                  fbe_bool_t b_queue_to_block_transport,
+                                                                  fbe_lba_t start_lba,
+                                                                  fbe_block_count_t block_count);
+
+/*****************************************
+ * LOCAL GLOBALS
+ *****************************************/
+
+/*! @brief Number of regions a copy request of the user area copies at once.
+ */
+static fbe_u32_t fbe_virtual_drive_copy_concurrent_regions = FBE_VIRTUAL_DRIVE_COPY_DEFAULT_REGIONS;
+
 
 /*!****************************************************************************
  *          fbe_virtual_drive_get_copy_block_count()
@@ -89,9 +105,14 @@ static fbe_status_t fbe_virtual_drive_get_copy_block_count(fbe_virtual_drive_t *
      */ 
     chunk_size = fbe_raid_group_get_chunk_size((fbe_raid_group_t *)virtual_drive_p);
 
-    /* Get our default `logical' block consumption for rebuild request.
+    /* Get our default `logical' block consumption for rebuild request.  A 
+     * copy of the user area covers all the regions which are copied at once.
      */
     logical_block_count = (FBE_VIRTUAL_DRIVE_COPY_MBYTES_CONSUMPTION * (1024 * 1024)) / FBE_BYTES_PER_BLOCK;
+    if (start_lba < raid_group_metadata_positions.exported_capacity)
+    {
+        logical_block_count *= fbe_virtual_drive_copy_concurrent_regions;
+    }
     end_lba = start_lba + logical_block_count - 1;
 
     /* We cannot span positions (i.e. cannot span the user -> metadata and
@@ -174,6 +195,8 @@ fbe_status_t fbe_virtual_drive_copy_initialize_rebuild_context(fbe_virtual_drive
     fbe_raid_group_rebuild_context_set_update_checkpoint_bitmask(in_rebuild_context_p, 0);
     fbe_raid_group_rebuild_context_set_update_checkpoint_lba(in_rebuild_context_p, FBE_LBA_INVALID);
     fbe_raid_group_rebuild_context_set_update_checkpoint_blocks(in_rebuild_context_p, 0);
+    in_rebuild_context_p->b_sub_request = FBE_FALSE;
+    in_rebuild_context_p->sub_request_count = 0;
 
     //  Return success
     return FBE_STATUS_OK;
@@ -588,6 +611,8 @@ static fbe_status_t fbe_virtual_drive_copy_send_event_to_check_lba_completion(
     fbe_chunk_size_t                    chunk_size;
     fbe_lba_t                           exported_capacity;
     fbe_virtual_drive_flags_t           vd_flags;
+    fbe_block_count_t                   region_blocks;
+    fbe_u32_t                           region_count;
 
     //  Cast the context to a pointer to a virtual drive object 
     virtual_drive_p = (fbe_virtual_drive_t *)in_context;
@@ -810,6 +835,22 @@ static fbe_status_t fbe_virtual_drive_copy_send_event_to_check_lba_completion(
                                  FBE_RAID_GROUP_SUBSTATE_REBUILD_SEND, 
                                  rebuild_context_p->start_lba, &hook_status);
 
+    /* Copy the regions of a large request of the user area at the same time.
+     * The checkpoint only moves over the regions copied in order from the 
+     * start, so after a failover the copy resumes at the first region that 
+     * did not complete. 
+     */
+    region_blocks = fbe_virtual_drive_copy_get_region_blocks(virtual_drive_p);
+    if ((rebuild_context_p->start_lba < exported_capacity) &&
+        (rebuild_context_p->block_count > region_blocks)      )
+    {
+        region_count = (fbe_u32_t)((rebuild_context_p->block_count + region_blocks - 1) / region_blocks);
+        status = fbe_raid_group_rebuild_send_concurrent_io_request((fbe_raid_group_t *)virtual_drive_p, packet_p,
+                                                                   region_count, region_blocks,
+                                                                   fbe_virtual_drive_copy_send_region_io_request);
+        return status;
+    }
+
     /* Send the rebuild I/O .  Its completion function will execute when it 
      * finishes.
      */ 
@@ -3476,6 +3517,101 @@ fbe_status_t fbe_virtual_drive_copy_failed_set_rebuild_checkpoint_to_end_marker(
  * end fbe_virtual_drive_copy_failed_set_rebuild_checkpoint_to_end_marker()
  *************************************************************************************/
 
+/*!****************************************************************************
+ *          fbe_virtual_drive_copy_get_region_blocks()
+ ******************************************************************************
+ *
+ * @brief   Return the number of `physical' blocks in one copy region.  The
+ *          region is FBE_VIRTUAL_DRIVE_COPY_MBYTES_CONSUMPTION rounded up to
+ *          a multiple of the chunk size.
+ *
+ * @param   virtual_drive_p - Pointer to virtual drive object
+ * 
+ * @return  fbe_block_count_t
+ *
+ ******************************************************************************/
+static fbe_block_count_t fbe_virtual_drive_copy_get_region_blocks(fbe_virtual_drive_t *virtual_drive_p)
+{
+    fbe_chunk_size_t    chunk_size;
+    fbe_block_count_t   region_blocks;
+
+    chunk_size = fbe_raid_group_get_chunk_size((fbe_raid_group_t *)virtual_drive_p);
+    region_blocks = (FBE_VIRTUAL_DRIVE_COPY_MBYTES_CONSUMPTION * (1024 * 1024)) / FBE_BYTES_PER_BLOCK;
+    region_blocks = ((region_blocks + chunk_size - 1) / chunk_size) * chunk_size;
+    return region_blocks;
+}
+/**********************************************
+ * end fbe_virtual_drive_copy_get_region_blocks()
+ **********************************************/
+
+/*!****************************************************************************
+ *          fbe_virtual_drive_copy_send_region_io_request()
+ ******************************************************************************
+ *
+ * @brief   Send the copy I/O of one region of a concurrent copy request.  The
+ *          region completes through the virtual drive rebuild completion so
+ *          that media errors are handled as for any copy I/O.
+ *
+ * @param   raid_group_p - Pointer to the virtual drive object
+ * @param   packet_p - Pointer to the sub packet of the region
+ * @param   b_queue_to_block_transport - FBE_TRUE must break context
+ * @param   start_lba - Start of the region
+ * @param   block_count - Blocks in the region
+ * 
+ * @return  fbe_status_t
+ *
+ ******************************************************************************/
+static fbe_status_t fbe_virtual_drive_copy_send_region_io_request(fbe_raid_group_t *raid_group_p,
+                                                                  fbe_packet_t *packet_p,
+                                                                  fbe_bool_t b_queue_to_block_transport,
+                                                                  fbe_lba_t start_lba,
+                                                                  fbe_block_count_t block_count)
+{
+    return fbe_virtual_drive_copy_send_io_request((fbe_virtual_drive_t *)raid_group_p, packet_p,
+                                                  b_queue_to_block_transport,
+                                                  start_lba, block_count);
+}
+/**********************************************
+ * end fbe_virtual_drive_copy_send_region_io_request()
+ **********************************************/
+
+/*!****************************************************************************
+ *          fbe_virtual_drive_copy_set_concurrent_regions()
+ ******************************************************************************
+ *
+ * @brief   Set the number of regions a copy request of the user area copies
+ *          at the same time.  Fewer regions reduce the impact on host I/O.
+ *
+ * @param   concurrent_regions - 1 copies one region at a time
+ * 
+ * @return  fbe_status_t
+ *
+ ******************************************************************************/
+fbe_status_t fbe_virtual_drive_copy_set_concurrent_regions(fbe_u32_t concurrent_regions)
+{
+    if ((concurrent_regions == 0)                                       ||
+        (concurrent_regions > FBE_RAID_GROUP_REBUILD_MAX_CONCURRENT_IOS)   )
+    {
+        fbe_topology_class_trace(FBE_CLASS_ID_VIRTUAL_DRIVE,
+                                 FBE_TRACE_LEVEL_WARNING, 
+                                 FBE_TRACE_MESSAGE_ID_INFO,
+                                 "%s concurrent copy regions: %d not between 1 and %d\n", 
+                                 __FUNCTION__, concurrent_regions, FBE_RAID_GROUP_REBUILD_MAX_CONCURRENT_IOS);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    fbe_topology_class_trace(FBE_CLASS_ID_VIRTUAL_DRIVE, 
+                             FBE_TRACE_LEVEL_INFO, 
+                             FBE_TRACE_MESSAGE_ID_INFO,
+                             "%s Setting concurrent copy regions to %d\n", 
+                             __FUNCTION__, concurrent_regions);
+    fbe_virtual_drive_copy_concurrent_regions = concurrent_regions;
+    return FBE_STATUS_OK;
+}
+/**********************************************
+ * end fbe_virtual_drive_copy_set_concurrent_regions()
+ **********************************************/
+
 
 /************************************
  * end file fbe_virtual_drive_copy.c
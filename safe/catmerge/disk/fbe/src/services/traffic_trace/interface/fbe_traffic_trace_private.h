@@ -17,7 +17,21 @@
  *   4/15/2010:  Created. Swati Fursule
  *
  ***************************************************************************/
+#include "fbe/fbe_traffic_trace_interface.h"
 
+/*!*******************************************************************
+ * @def FBE_TRAFFIC_TRACE_RING_RECORDS
+ *********************************************************************
+ * @brief Number of binary records kept.  Must be a power of 2.
+ *
+ *********************************************************************/
+#define FBE_TRAFFIC_TRACE_RING_RECORDS      16384
+
+/* fbe_traffic_trace_filter.c */
+void fbe_traffic_trace_filter_init(void);
+void fbe_traffic_trace_filter_destroy(void);
+fbe_status_t fbe_traffic_trace_filter_set(fbe_traffic_trace_filter_t *filter_p);
+fbe_status_t fbe_traffic_trace_filter_get_records(fbe_traffic_trace_get_records_t *get_records_p);
 
 /*************************
  * end file fbe_traffic_trace_private.h
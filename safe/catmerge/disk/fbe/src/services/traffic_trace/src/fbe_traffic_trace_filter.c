@@ -0,0 +1,591 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2014
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!*************************************************************************
+ * @file fbe_traffic_trace_filter.c
+ ***************************************************************************
+ *
+ * @brief
+ *  This file contains the RBA trace filters.  Turning on RBA tracing for a
+ *  class traces every I/O of every object of the class, which is too much
+ *  to leave on while a problem is reproduced.  A filter limits the records
+ *  of a class to one target, an lba range and some opcodes, samples one in
+ *  N I/Os and can keep only the completions slower than a threshold.  The
+ *  records that pass can also be saved as compact binary records in a ring
+ *  that is read with the GET_RECORDS control code, instead of being
+ *  formatted to the ktrace buffer.
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "fbe/fbe_winddk.h"
+#include "fbe/fbe_types.h"
+#include "fbe/fbe_time.h"
+#include "fbe/fbe_memory.h"
+#include "fbe/fbe_atomic.h"
+#include "fbe/fbe_traffic_trace_interface.h"
+#include "fbe_traffic_trace.h"
+#include "fbe_traffic_trace_private.h"
+#include "ktrace_structs.h"
+
+/*!*******************************************************************
+ * @def FBE_TRAFFIC_TRACE_LATENCY_SLOTS
+ *********************************************************************
+ * @brief Number of start times kept to compute the latency of the
+ *        completions.  Must be a power of 2.
+ *
+ *********************************************************************/
+#define FBE_TRAFFIC_TRACE_LATENCY_SLOTS     1024
+
+/*!*******************************************************************
+ * @def FBE_TRAFFIC_TRACE_LATENCY_LOCKS
+ *********************************************************************
+ * @brief Number of locks protecting the start times, so that the cores
+ *        do not all serialize on one lock.  Must be a power of 2.
+ *
+ *********************************************************************/
+#define FBE_TRAFFIC_TRACE_LATENCY_LOCKS     16
+
+/*!*******************************************************************
+ * @struct fbe_traffic_trace_latency_slot_t
+ *********************************************************************
+ * @brief Start time of an I/O that has not completed yet.
+ *
+ *********************************************************************/
+typedef struct fbe_traffic_trace_latency_slot_s
+{
+    fbe_u64_t key;          /*!< Hash of the I/O, 0 when the slot is free. */
+    fbe_time_t start_us;
+}
+fbe_traffic_trace_latency_slot_t;
+
+/*!*******************************************************************
+ * @struct fbe_traffic_trace_filter_info_t
+ *********************************************************************
+ * @brief State of the RBA trace filters.
+ *
+ *********************************************************************/
+typedef struct fbe_traffic_trace_filter_info_s
+{
+    fbe_spinlock_t lock;    /*!< Serializes filter updates and the ring allocation. */
+    fbe_traffic_trace_filter_t filters[FBE_TRAFFIC_TRACE_CLASS_LAST];
+    fbe_atomic_t filter_generations[FBE_TRAFFIC_TRACE_CLASS_LAST]; /*!< Odd while the filter is written. */
+    fbe_traffic_trace_record_t *ring_p;
+    fbe_atomic_t next_sequence;
+    fbe_spinlock_t latency_locks[FBE_TRAFFIC_TRACE_LATENCY_LOCKS];
+    fbe_traffic_trace_latency_slot_t latency_slots[FBE_TRAFFIC_TRACE_LATENCY_SLOTS];
+}
+fbe_traffic_trace_filter_info_t;
+
+static fbe_traffic_trace_filter_info_t fbe_traffic_trace_filter_info;
+
+/*!*******************************************************************
+ * @var fbe_traffic_trace_filter_flags
+ *********************************************************************
+ * @brief KTRC flags of the classes that have a filter.  These classes
+ *        are traced even when RBA tracing is off for them.
+ *
+ *********************************************************************/
+fbe_u32_t fbe_traffic_trace_filter_flags = 0;
+
+/*!*******************************************************************
+ * @var fbe_traffic_trace_filter_class_flags
+ *********************************************************************
+ * @brief KTRC flag of each trace class.
+ *
+ *********************************************************************/
+static const fbe_u32_t fbe_traffic_trace_filter_class_flags[FBE_TRAFFIC_TRACE_CLASS_LAST] =
+{
+    0,                  /* FBE_TRAFFIC_TRACE_CLASS_INAVLID */
+    KTRC_TFBE_LUN,      /* FBE_TRAFFIC_TRACE_CLASS_LUN */
+    KTRC_TFBE_RG,       /* FBE_TRAFFIC_TRACE_CLASS_RG */
+    KTRC_TFBE_RG_FRU,   /* FBE_TRAFFIC_TRACE_CLASS_RG_FRU */
+    KTRC_TVD,           /* FBE_TRAFFIC_TRACE_CLASS_VD */
+    KTRC_TPVD,          /* FBE_TRAFFIC_TRACE_CLASS_PVD */
+    KTRC_TPDO,          /* FBE_TRAFFIC_TRACE_CLASS_PD */
+};
+
+/*!**************************************************************
+ * fbe_traffic_trace_filter_init()
+ ****************************************************************
+ * @brief
+ *  Initialize the filters, none of the classes is filtered.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void fbe_traffic_trace_filter_init(void)
+{
+    fbe_u32_t index;
+
+    fbe_zero_memory(&fbe_traffic_trace_filter_info, sizeof(fbe_traffic_trace_filter_info));
+    fbe_spinlock_init(&fbe_traffic_trace_filter_info.lock);
+    for (index = 0; index < FBE_TRAFFIC_TRACE_LATENCY_LOCKS; index++)
+    {
+        fbe_spinlock_init(&fbe_traffic_trace_filter_info.latency_locks[index]);
+    }
+    fbe_traffic_trace_filter_flags = 0;
+    return;
+}
+/******************************************
+ * end fbe_traffic_trace_filter_init()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_traffic_trace_filter_destroy()
+ ****************************************************************
+ * @brief
+ *  Remove the filters and release the binary records.
+ *
+ * @param None.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+void fbe_traffic_trace_filter_destroy(void)
+{
+    fbe_u32_t index;
+
+    fbe_traffic_trace_filter_flags = 0;
+    if (fbe_traffic_trace_filter_info.ring_p != NULL)
+    {
+        fbe_memory_native_release(fbe_traffic_trace_filter_info.ring_p);
+        fbe_traffic_trace_filter_info.ring_p = NULL;
+    }
+    for (index = 0; index < FBE_TRAFFIC_TRACE_LATENCY_LOCKS; index++)
+    {
+        fbe_spinlock_destroy(&fbe_traffic_trace_filter_info.latency_locks[index]);
+    }
+    fbe_spinlock_destroy(&fbe_traffic_trace_filter_info.lock);
+    return;
+}
+/******************************************
+ * end fbe_traffic_trace_filter_destroy()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_traffic_trace_filter_set()
+ ****************************************************************
+ * @brief
+ *  Set or remove the filter of one class.  The binary records are
+ *  allocated the first time a filter asks for them and are kept
+ *  until the service is destroyed, since a trace point may be
+ *  writing to them at any time.
+ *
+ * @param filter_p - The new filter.
+ *
+ * @return fbe_status_t
+ *
+ ****************************************************************/
+fbe_status_t fbe_traffic_trace_filter_set(fbe_traffic_trace_filter_t *filter_p)
+{
+    fbe_traffic_trace_record_t *ring_p = NULL;
+    fbe_u32_t class_flag;
+
+    if ((filter_p->trace_class <= FBE_TRAFFIC_TRACE_CLASS_INAVLID) ||
+        (filter_p->trace_class >= FBE_TRAFFIC_TRACE_CLASS_LAST))
+    {
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+    class_flag = fbe_traffic_trace_filter_class_flags[filter_p->trace_class];
+
+    if (filter_p->b_enabled && filter_p->b_binary &&
+        (fbe_traffic_trace_filter_info.ring_p == NULL))
+    {
+        ring_p = (fbe_traffic_trace_record_t *)fbe_memory_native_allocate(sizeof(fbe_traffic_trace_record_t) *
+                                                                          FBE_TRAFFIC_TRACE_RING_RECORDS);
+        if (ring_p == NULL)
+        {
+            return FBE_STATUS_INSUFFICIENT_RESOURCES;
+        }
+        /* The sequence of a record is only valid once it is written, so
+         * mark every record as not written yet.
+         */
+        fbe_set_memory(ring_p, 0xFF, sizeof(fbe_traffic_trace_record_t) * FBE_TRAFFIC_TRACE_RING_RECORDS);
+    }
+
+    fbe_spinlock_lock(&fbe_traffic_trace_filter_info.lock);
+    if (ring_p != NULL)
+    {
+        if (fbe_traffic_trace_filter_info.ring_p == NULL)
+        {
+            fbe_traffic_trace_filter_info.ring_p = ring_p;
+            ring_p = NULL;
+        }
+    }
+
+    /* The trace points copy the filter without the lock.  The generation
+     * is odd while the filter is written, so that they retry instead of
+     * using a half written filter.
+     */
+    fbe_atomic_increment(&fbe_traffic_trace_filter_info.filter_generations[filter_p->trace_class]);
+    fbe_traffic_trace_filter_info.filters[filter_p->trace_class] = *filter_p;
+    fbe_atomic_increment(&fbe_traffic_trace_filter_info.filter_generations[filter_p->trace_class]);
+    if (filter_p->b_enabled)
+    {
+        fbe_traffic_trace_filter_flags |= class_flag;
+    }
+    else
+    {
+        fbe_traffic_trace_filter_flags &= ~class_flag;
+    }
+    fbe_spinlock_unlock(&fbe_traffic_trace_filter_info.lock);
+
+    /* Someone else allocated the ring first.
+     */
+    if (ring_p != NULL)
+    {
+        fbe_memory_native_release(ring_p);
+    }
+    return FBE_STATUS_OK;
+}
+/******************************************
+ * end fbe_traffic_trace_filter_set()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_traffic_trace_filter_get_records()
+ ****************************************************************
+ * @brief
+ *  Copy the binary records starting at the sequence the caller
+ *  asks for.  The records that were overwritten before they were
+ *  read are skipped and counted as lost.  A record is checked
+ *  before and after it is copied, since a trace point may start
+ *  writing it again while it is copied.
+ *
+ * @param get_records_p - The request and the records returned.
+ *
+ * @return fbe_status_t
+ *
+ ****************************************************************/
+fbe_status_t fbe_traffic_trace_filter_get_records(fbe_traffic_trace_get_records_t *get_records_p)
+{
+    fbe_traffic_trace_record_t *ring_p = fbe_traffic_trace_filter_info.ring_p;
+    fbe_u64_t sequence = get_records_p->next_sequence;
+    fbe_u64_t end_sequence = (fbe_u64_t)fbe_traffic_trace_filter_info.next_sequence;
+    fbe_traffic_trace_record_t *record_p = NULL;
+    fbe_u64_t record_sequence;
+
+    get_records_p->num_records = 0;
+    get_records_p->lost_records = 0;
+
+    if (ring_p == NULL)
+    {
+        get_records_p->next_sequence = 0;
+        return FBE_STATUS_OK;
+    }
+
+    if (sequence > end_sequence)
+    {
+        /* The caller only wants the records saved from now on.
+         */
+        sequence = end_sequence;
+    }
+    if ((end_sequence - sequence) > FBE_TRAFFIC_TRACE_RING_RECORDS)
+    {
+        get_records_p->lost_records = (fbe_u32_t)FBE_MIN(end_sequence - sequence - FBE_TRAFFIC_TRACE_RING_RECORDS,
+                                                         FBE_U32_MAX);
+        sequence = end_sequence - FBE_TRAFFIC_TRACE_RING_RECORDS;
+    }
+
+    while ((sequence < end_sequence) &&
+           (get_records_p->num_records < FBE_TRAFFIC_TRACE_GET_RECORDS_MAX))
+    {
+        record_p = &ring_p[sequence & (FBE_TRAFFIC_TRACE_RING_RECORDS - 1)];
+
+        /* A record not written yet has the sequence of the previous lap
+         * or FBE_U64_MAX, stop there and get it on the next call.
+         */
+        record_sequence = (fbe_u64_t)fbe_atomic_add((fbe_atomic_t *)&record_p->sequence, 0);
+        if (record_sequence != sequence)
+        {
+            break;
+        }
+        get_records_p->records[get_records_p->num_records] = *record_p;
+
+        /* The writer of the next lap changed the record while we copied
+         * it, the copy is torn and the record is lost.
+         */
+        record_sequence = (fbe_u64_t)fbe_atomic_add((fbe_atomic_t *)&record_p->sequence, 0);
+        if (record_sequence != sequence)
+        {
+            if (get_records_p->lost_records < FBE_U32_MAX)
+            {
+                get_records_p->lost_records++;
+            }
+            sequence++;
+            continue;
+        }
+        get_records_p->records[get_records_p->num_records].sequence = sequence;
+        get_records_p->num_records++;
+        sequence++;
+    }
+    get_records_p->next_sequence = sequence;
+    return FBE_STATUS_OK;
+}
+/******************************************
+ * end fbe_traffic_trace_filter_get_records()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_traffic_trace_filter_copy()
+ ****************************************************************
+ * @brief
+ *  Copy the filter of a class without taking the lock.  The copy
+ *  is retried while fbe_traffic_trace_filter_set() writes it.
+ *
+ * @param trace_class - Class of the filter.
+ * @param filter_p - Copy of the filter.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static __forceinline void fbe_traffic_trace_filter_copy(fbe_traffic_trace_rba_set_class_t trace_class,
+                                                        fbe_traffic_trace_filter_t *filter_p)
+{
+    fbe_atomic_t *generation_p = &fbe_traffic_trace_filter_info.filter_generations[trace_class];
+    fbe_atomic_t generation;
+
+    do
+    {
+        generation = fbe_atomic_add(generation_p, 0);
+        if (generation & 1)
+        {
+            continue;
+        }
+        *filter_p = fbe_traffic_trace_filter_info.filters[trace_class];
+    }
+    while ((generation & 1) || (fbe_atomic_add(generation_p, 0) != generation));
+    return;
+}
+/******************************************
+ * end fbe_traffic_trace_filter_copy()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_traffic_trace_filter_hash()
+ ****************************************************************
+ * @brief
+ *  Hash an I/O so that its start and its completion get the same
+ *  sampling decision and the same latency slot.
+ *
+ * @param trace_class - Class tracing the I/O.
+ * @param target - Number of the object.
+ * @param lba - Start of the I/O.
+ * @param blocks - Size of the I/O.
+ *
+ * @return The hash, never 0.
+ *
+ ****************************************************************/
+static __forceinline fbe_u64_t fbe_traffic_trace_filter_hash(fbe_traffic_trace_rba_set_class_t trace_class,
+                                                             fbe_u32_t target,
+                                                             fbe_lba_t lba,
+                                                             fbe_block_count_t blocks)
+{
+    fbe_u64_t key;
+
+    key = lba ^ ((fbe_u64_t)blocks << 40) ^ ((fbe_u64_t)target << 20) ^ (fbe_u64_t)trace_class;
+    key *= 0x9E3779B97F4A7C15ULL;
+    key ^= (key >> 29);
+    return (key == 0) ? 1 : key;
+}
+/******************************************
+ * end fbe_traffic_trace_filter_hash()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_traffic_trace_filter_latency()
+ ****************************************************************
+ * @brief
+ *  Save the start time of an I/O, or find the start time of a
+ *  completing I/O and return its latency.  When two outstanding
+ *  I/Os share a slot the older one loses its start time and its
+ *  completion reports no latency.
+ *
+ * @param key - Hash of the I/O.
+ * @param b_start - FBE_TRUE for the start of the I/O.
+ * @param now_us - Time of the trace point.
+ *
+ * @return Latency in microseconds, 0 if unknown.
+ *
+ ****************************************************************/
+static fbe_u32_t fbe_traffic_trace_filter_latency(fbe_u64_t key,
+                                                  fbe_bool_t b_start,
+                                                  fbe_time_t now_us)
+{
+    fbe_u32_t slot = (fbe_u32_t)(key & (FBE_TRAFFIC_TRACE_LATENCY_SLOTS - 1));
+    fbe_spinlock_t *lock_p = &fbe_traffic_trace_filter_info.latency_locks[slot & (FBE_TRAFFIC_TRACE_LATENCY_LOCKS - 1)];
+    fbe_traffic_trace_latency_slot_t *slot_p = &fbe_traffic_trace_filter_info.latency_slots[slot];
+    fbe_u32_t latency_us = 0;
+
+    fbe_spinlock_lock(lock_p);
+    if (b_start)
+    {
+        slot_p->key = key;
+        slot_p->start_us = now_us;
+    }
+    else if (slot_p->key == key)
+    {
+        latency_us = (fbe_u32_t)FBE_MIN(now_us - slot_p->start_us, FBE_U32_MAX);
+        slot_p->key = 0;
+    }
+    fbe_spinlock_unlock(lock_p);
+    return latency_us;
+}
+/******************************************
+ * end fbe_traffic_trace_filter_latency()
+ ******************************************/
+
+/*!**************************************************************
+ * fbe_traffic_trace_filter_record()
+ ****************************************************************
+ * @brief
+ *  Apply the filter of a class to one RBA trace point.  Classes
+ *  without a filter are not changed.
+ *
+ * @param trace_class - Class tracing the I/O.
+ * @param target - Number the class traces, see fbe_traffic_trace_filter_t.
+ * @param lba - Start of the I/O.
+ * @param blocks - Size of the I/O.
+ * @param op_code - KT_TRAFFIC_* op with the priority bits.
+ * @param info - Class specific information of the record.
+ *
+ * @return FBE_TRUE if the caller should still log its ktrace record.
+ *
+ ****************************************************************/
+fbe_bool_t fbe_traffic_trace_filter_record(fbe_traffic_trace_rba_set_class_t trace_class,
+                                           fbe_u32_t target,
+                                           fbe_lba_t lba,
+                                           fbe_block_count_t blocks,
+                                           fbe_u16_t op_code,
+                                           fbe_u64_t info)
+{
+    fbe_traffic_trace_filter_t filter;
+    fbe_traffic_trace_filter_t *filter_p = &filter;
+    fbe_traffic_trace_record_t *ring_p = NULL;
+    fbe_traffic_trace_record_t *record_p = NULL;
+    fbe_bool_t b_start = ((op_code & KT_DONE) == 0);
+    fbe_u32_t op_bit;
+    fbe_u64_t key;
+    fbe_u64_t sequence;
+    fbe_time_t now_us;
+    fbe_u32_t latency_us = 0;
+
+    if ((trace_class >= FBE_TRAFFIC_TRACE_CLASS_LAST) ||
+        ((fbe_traffic_trace_filter_flags & fbe_traffic_trace_filter_class_flags[trace_class]) == 0))
+    {
+        return FBE_TRUE;
+    }
+    fbe_traffic_trace_filter_copy(trace_class, filter_p);
+    if (!filter_p->b_enabled)
+    {
+        return FBE_TRUE;
+    }
+
+    if ((filter_p->target != FBE_U32_MAX) &&
+        (filter_p->target != target))
+    {
+        return FBE_FALSE;
+    }
+    if ((lba + blocks <= filter_p->start_lba) ||
+        ((filter_p->end_lba != FBE_LBA_INVALID) && (lba > filter_p->end_lba)))
+    {
+        return FBE_FALSE;
+    }
+    if (filter_p->op_mask != 0)
+    {
+        switch (op_code & (KT_WRITE | KT_ZERO | KT_MOVE))
+        {
+            case KT_READ:
+                op_bit = FBE_TRAFFIC_TRACE_FILTER_OP_READ;
+                break;
+            case KT_WRITE:
+                op_bit = FBE_TRAFFIC_TRACE_FILTER_OP_WRITE;
+                break;
+            case KT_ZERO:
+                op_bit = FBE_TRAFFIC_TRACE_FILTER_OP_ZERO;
+                break;
+            default:
+                op_bit = FBE_TRAFFIC_TRACE_FILTER_OP_OTHER;
+                break;
+        }
+        if ((filter_p->op_mask & op_bit) == 0)
+        {
+            return FBE_FALSE;
+        }
+    }
+
+    key = fbe_traffic_trace_filter_hash(trace_class, target, lba, blocks);
+    if ((filter_p->sample_rate > 1) &&
+        (((key >> 32) % filter_p->sample_rate) != 0))
+    {
+        return FBE_FALSE;
+    }
+
+    /* Only the threshold and the binary records use the latency, the
+     * ktrace records have their own time stamps.
+     */
+    if ((filter_p->latency_threshold_us == 0) && !filter_p->b_binary)
+    {
+        return FBE_TRUE;
+    }
+    now_us = fbe_get_time_in_us();
+    latency_us = fbe_traffic_trace_filter_latency(key, b_start, now_us);
+    if (filter_p->latency_threshold_us != 0)
+    {
+        /* We only know if an I/O is slow when it completes.  The
+         * completion record has the latency to find its start.
+         */
+        if (b_start || (latency_us < filter_p->latency_threshold_us))
+        {
+            return FBE_FALSE;
+        }
+    }
+
+    if (!filter_p->b_binary)
+    {
+        return FBE_TRUE;
+    }
+    ring_p = fbe_traffic_trace_filter_info.ring_p;
+    if (ring_p == NULL)
+    {
+        return FBE_FALSE;
+    }
+
+    sequence = (fbe_u64_t)fbe_atomic_increment(&fbe_traffic_trace_filter_info.next_sequence) - 1;
+    record_p = &ring_p[sequence & (FBE_TRAFFIC_TRACE_RING_RECORDS - 1)];
+
+    /* Tell a reader copying the previous lap of this record that its
+     * copy may be torn.
+     */
+    fbe_atomic_exchange((fbe_atomic_t *)&record_p->sequence, (fbe_atomic_t)FBE_U64_MAX);
+    record_p->time_us = now_us;
+    record_p->lba = lba;
+    record_p->info = info;
+    record_p->target = target;
+    record_p->blocks = (fbe_u32_t)FBE_MIN(blocks, FBE_U32_MAX);
+    record_p->latency_us = latency_us;
+    record_p->op_code = op_code;
+    record_p->trace_class = (fbe_u8_t)trace_class;
+    record_p->reserved = 0;
+
+    /* The sequence goes last, it tells the reader the record is complete.
+     * The interlocked exchange orders it after the other fields.
+     */
+    fbe_atomic_exchange((fbe_atomic_t *)&record_p->sequence, (fbe_atomic_t)sequence);
+    return FBE_FALSE;
+}
+/******************************************
+ * end fbe_traffic_trace_filter_record()
+ ******************************************/
+
+/*************************
+ * end file fbe_traffic_trace_filter.c
+ *************************/
@@ -255,6 +255,113 @@ fbe_traffic_trace_control_disable(fbe_packet_t * packet)
     return FBE_STATUS_OK;
 }
 
+/*!***************************************************************************
+ *          fbe_traffic_trace_control_set_filter()
+ *****************************************************************************
+ *
+ * @brief   Set or clear the RBA trace filter of one class.
+ *  
+ * @param   packet
+ *
+ * @return  fbe_status_t
+ *
+ *****************************************************************************/
+static fbe_status_t
+fbe_traffic_trace_control_set_filter(fbe_packet_t * packet)
+{
+    fbe_payload_ex_t * payload;
+    fbe_payload_control_operation_t * control_operation;
+    fbe_traffic_trace_filter_t * filter_p = NULL;
+    fbe_payload_control_buffer_length_t buffer_length;
+    fbe_status_t status;
+
+    payload = fbe_transport_get_payload_ex(packet);
+    control_operation = fbe_payload_ex_get_control_operation(payload);
+
+    status = fbe_payload_control_get_buffer(control_operation, &filter_p);
+    buffer_length = 0;
+    fbe_payload_control_get_buffer_length(control_operation, &buffer_length); 
+    if ((status != FBE_STATUS_OK) || (filter_p == NULL) ||
+        (buffer_length != sizeof(fbe_traffic_trace_filter_t))) {
+        fbe_base_service_trace((fbe_base_service_t*)&traffic_trace_service,
+                FBE_TRACE_LEVEL_ERROR,
+                FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                "%s, bad control buffer length: %d\n", __FUNCTION__, buffer_length);
+        fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
+        fbe_transport_set_status(packet, FBE_STATUS_OK, 0);
+        fbe_transport_complete_packet(packet);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    status = fbe_traffic_trace_filter_set(filter_p);
+    if (status != FBE_STATUS_OK) {
+        fbe_base_service_trace((fbe_base_service_t*)&traffic_trace_service,
+                FBE_TRACE_LEVEL_ERROR,
+                FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                "%s, set filter of class %d failed, status: 0x%x\n", __FUNCTION__, filter_p->trace_class, status);
+        fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
+    }
+    else {
+        fbe_base_service_trace((fbe_base_service_t*)&traffic_trace_service,
+                FBE_TRACE_LEVEL_INFO,
+                FBE_TRACE_MESSAGE_ID_INFO,
+                "traffic trace filter class: %d en: %d bin: %d target: 0x%x lba: 0x%llx-0x%llx ops: 0x%x lat: %d sample: %d\n",
+                filter_p->trace_class, filter_p->b_enabled, filter_p->b_binary, filter_p->target,
+                (unsigned long long)filter_p->start_lba, (unsigned long long)filter_p->end_lba,
+                filter_p->op_mask, filter_p->latency_threshold_us, filter_p->sample_rate);
+        fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_OK);
+    }
+    fbe_transport_set_status(packet, FBE_STATUS_OK, 0);
+    fbe_transport_complete_packet(packet);
+    return FBE_STATUS_OK;
+}
+
+/*!***************************************************************************
+ *          fbe_traffic_trace_control_get_records()
+ *****************************************************************************
+ *
+ * @brief   Return the binary RBA trace records after the sequence the
+ *          caller asks for.
+ *  
+ * @param   packet
+ *
+ * @return  fbe_status_t
+ *
+ *****************************************************************************/
+static fbe_status_t
+fbe_traffic_trace_control_get_records(fbe_packet_t * packet)
+{
+    fbe_payload_ex_t * payload;
+    fbe_payload_control_operation_t * control_operation;
+    fbe_traffic_trace_get_records_t * get_records_p = NULL;
+    fbe_payload_control_buffer_length_t buffer_length;
+    fbe_status_t status;
+
+    payload = fbe_transport_get_payload_ex(packet);
+    control_operation = fbe_payload_ex_get_control_operation(payload);
+
+    status = fbe_payload_control_get_buffer(control_operation, &get_records_p);
+    buffer_length = 0;
+    fbe_payload_control_get_buffer_length(control_operation, &buffer_length); 
+    if ((status != FBE_STATUS_OK) || (get_records_p == NULL) ||
+        (buffer_length != sizeof(fbe_traffic_trace_get_records_t))) {
+        fbe_base_service_trace((fbe_base_service_t*)&traffic_trace_service,
+                FBE_TRACE_LEVEL_ERROR,
+                FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+                "%s, bad control buffer length: %d\n", __FUNCTION__, buffer_length);
+        fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_FAILURE);
+        fbe_transport_set_status(packet, FBE_STATUS_OK, 0);
+        fbe_transport_complete_packet(packet);
+        return FBE_STATUS_GENERIC_FAILURE;
+    }
+
+    fbe_traffic_trace_filter_get_records(get_records_p);
+    fbe_payload_control_set_status(control_operation, FBE_PAYLOAD_CONTROL_STATUS_OK);
+    fbe_transport_set_status(packet, FBE_STATUS_OK, 0);
+    fbe_transport_complete_packet(packet);
+    return FBE_STATUS_OK;
+}
+
 /*!***************************************************************************
  *          fbe_traffic_trace_control_entry()
  *****************************************************************************
@@ -303,6 +410,12 @@ fbe_traffic_trace_control_entry(fbe_packet_t * packet)
         case FBE_TRAFFIC_TRACE_CONTROL_CODE_DISABLE_RBA_TRACE:
             status = fbe_traffic_trace_control_disable(packet);
             break;
+        case FBE_TRAFFIC_TRACE_CONTROL_CODE_SET_FILTER:
+            status = fbe_traffic_trace_control_set_filter(packet);
+            break;
+        case FBE_TRAFFIC_TRACE_CONTROL_CODE_GET_RECORDS:
+            status = fbe_traffic_trace_control_get_records(packet);
+            break;
         default:
             fbe_base_service_trace((fbe_base_service_t*)&traffic_trace_service,
                                    FBE_TRACE_LEVEL_ERROR,
@@ -338,6 +451,8 @@ fbe_status_t fbe_traffic_trace_init(void)
                                      fbe_trace_get_default_trace_level());
     fbe_base_service_init(&traffic_trace_service.base_service);
 
+    fbe_traffic_trace_filter_init();
+
     /* RBA uses the traffic trace get a pointer to the "traffic" trace
        info buffer if we are the first place to initialize it. It may
        have been initialized somewhere else and would thus not be NULL. */
@@ -363,6 +478,8 @@ fbe_status_t fbe_traffic_trace_init(void)
 fbe_status_t 
 fbe_traffic_trace_destroy(void)
 {
+    fbe_traffic_trace_filter_destroy();
+
     /* Must destroy the fbe ktrace also */
     fbe_ktrace_destroy();
     return FBE_STATUS_OK;
@@ -512,6 +629,7 @@ fbe_status_t fbe_traffic_trace_block_operation(fbe_class_id_t class_id,
 {
     fbe_status_t status = FBE_STATUS_OK;
     fbe_u32_t    traffic = KT_LUN_TRAFFIC;
+    fbe_traffic_trace_rba_set_class_t trace_class = FBE_TRAFFIC_TRACE_CLASS_INAVLID;
     fbe_char_t   target_string[50] = {'\0'};
     fbe_char_t   opcode_string[15] = {'\0'};
     fbe_u64_t    op_code = 0;
@@ -529,18 +647,22 @@ fbe_status_t fbe_traffic_trace_block_operation(fbe_class_id_t class_id,
         (class_id <= FBE_CLASS_ID_RAID_LAST) )
     {
         traffic = KT_FBE_RG_FRU_TRAFFIC;
+        trace_class = FBE_TRAFFIC_TRACE_CLASS_RG_FRU;
         strcpy(target_string, "RG FRU");
     }else if (class_id == FBE_CLASS_ID_LUN)
     {
         traffic = KT_FBE_LUN_TRAFFIC;
+        trace_class = FBE_TRAFFIC_TRACE_CLASS_LUN;
         strcpy(target_string, "LUN");
     }else if (class_id == FBE_CLASS_ID_VIRTUAL_DRIVE)
     {
         traffic = KT_FBE_VD_TRAFFIC;
+        trace_class = FBE_TRAFFIC_TRACE_CLASS_VD;
         strcpy(target_string, "VD");
     }else if(class_id == FBE_CLASS_ID_PROVISION_DRIVE)
     {
         traffic = KT_FBE_PVD_TRAFFIC;
+        trace_class = FBE_TRAFFIC_TRACE_CLASS_PVD;
         strcpy(target_string, "PVD");
     }
     if (b_start)
@@ -587,6 +709,14 @@ fbe_status_t fbe_traffic_trace_block_operation(fbe_class_id_t class_id,
         }
     }
     op_code |= priority;
+
+    /* A filter of this class may drop the record or save it in binary.
+     */
+    if (!fbe_traffic_trace_filter_record(trace_class, target, block_op_p->lba, block_op_p->block_count,
+                                         (fbe_u16_t)op_code, obj_info))
+    {
+        return status;
+    }
 #if defined(UMODE_ENV) || defined(SIMMODE_ENV)
     /* In user mode, this trace is displayed on console window. commneting it out temporarily
        modified to trace by two lines to fix KTRACE_STRING_TOO_LONG_ERROR*/
@@ -665,6 +795,7 @@ fbe_status_t fbe_traffic_trace_block_opcode(fbe_class_id_t class_id,
 {
     fbe_status_t status = FBE_STATUS_OK;
     fbe_u32_t    traffic = KT_LUN_TRAFFIC;
+    fbe_traffic_trace_rba_set_class_t trace_class = FBE_TRAFFIC_TRACE_CLASS_INAVLID;
     fbe_char_t   target_string[50] = {'\0'};
     fbe_char_t   opcode_string[15] = {'\0'};
     fbe_u16_t    op_code;
@@ -673,18 +804,22 @@ fbe_status_t fbe_traffic_trace_block_opcode(fbe_class_id_t class_id,
         (class_id <= FBE_CLASS_ID_RAID_LAST) )
     {
         traffic = KT_FBE_RG_TRAFFIC;
+        trace_class = FBE_TRAFFIC_TRACE_CLASS_RG;
         strcpy(target_string, "RG");
     }else if (class_id == FBE_CLASS_ID_LUN)
     {
         traffic = KT_FBE_LUN_TRAFFIC;
+        trace_class = FBE_TRAFFIC_TRACE_CLASS_LUN;
         strcpy(target_string, "LUN");
     }else if (class_id == FBE_CLASS_ID_VIRTUAL_DRIVE)
     {
         traffic = KT_FBE_VD_TRAFFIC;
+        trace_class = FBE_TRAFFIC_TRACE_CLASS_VD;
         strcpy(target_string, "VD");
     }else if(class_id == FBE_CLASS_ID_PROVISION_DRIVE)
     {
         traffic = KT_FBE_PVD_TRAFFIC;
+        trace_class = FBE_TRAFFIC_TRACE_CLASS_PVD;
         strcpy(target_string, "PVD");
     }
     if (b_start)
@@ -732,6 +867,13 @@ fbe_status_t fbe_traffic_trace_block_opcode(fbe_class_id_t class_id,
     }
     op_code |= priority;
 
+    /* A filter of this class may drop the record or save it in binary.
+     */
+    if (!fbe_traffic_trace_filter_record(trace_class, target, lba, block_count, op_code, obj_info))
+    {
+        return status;
+    }
+
 #if defined(UMODE_ENV) || defined(SIMMODE_ENV)
     /* In user mode, this trace is displayed on console window. commneting it out temporarily
        modified to trace by two lines to fix KTRACE_STRING_TOO_LONG_ERROR*/
@@ -0,0 +1,334 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2014
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/*!*************************************************************************
+ * @file fbe_traffic_trace_test_main.c
+ ***************************************************************************
+ *
+ * @brief
+ *  Unit tests of the RBA trace filters and of their binary records.
+ *
+ ***************************************************************************/
+
+/*************************
+ *   INCLUDE FILES
+ *************************/
+#include "fbe/fbe_winddk.h"
+#include "fbe/fbe_types.h"
+#include "mut.h"
+#include "fbe_traffic_trace.h"
+#include "fbe_traffic_trace_private.h"
+#include "fbe/fbe_emcutil_shell_include.h"
+
+static fbe_traffic_trace_get_records_t traffic_trace_test_records;
+
+/*!**************************************************************
+ * traffic_trace_test_setup()
+ ****************************************************************
+ * @brief
+ *  Start every test without filters.
+ *
+ ****************************************************************/
+static void traffic_trace_test_setup(void)
+{
+    fbe_traffic_trace_filter_init();
+    return;
+}
+
+/*!**************************************************************
+ * traffic_trace_test_teardown()
+ ****************************************************************
+ * @brief
+ *  Remove the filters and the binary records.
+ *
+ ****************************************************************/
+static void traffic_trace_test_teardown(void)
+{
+    fbe_traffic_trace_filter_destroy();
+    return;
+}
+
+/*!**************************************************************
+ * traffic_trace_test_init_filter()
+ ****************************************************************
+ * @brief
+ *  Fill in a filter that matches every I/O of a class.
+ *
+ ****************************************************************/
+static void traffic_trace_test_init_filter(fbe_traffic_trace_filter_t *filter_p,
+                                           fbe_traffic_trace_rba_set_class_t trace_class,
+                                           fbe_bool_t b_binary)
+{
+    fbe_zero_memory(filter_p, sizeof(*filter_p));
+    filter_p->trace_class = trace_class;
+    filter_p->b_enabled = FBE_TRUE;
+    filter_p->b_binary = b_binary;
+    filter_p->target = FBE_U32_MAX;
+    filter_p->start_lba = 0;
+    filter_p->end_lba = FBE_LBA_INVALID;
+    return;
+}
+
+/*!**************************************************************
+ * traffic_trace_test_no_filter()
+ ****************************************************************
+ * @brief
+ *  A class without a filter keeps its ktrace records.
+ *
+ ****************************************************************/
+static void traffic_trace_test_no_filter(void)
+{
+    fbe_bool_t b_trace;
+
+    b_trace = fbe_traffic_trace_filter_record(FBE_TRAFFIC_TRACE_CLASS_LUN, 1, 0, 8, KT_READ, 0);
+    MUT_ASSERT_INT_EQUAL(FBE_TRUE, b_trace);
+
+    traffic_trace_test_records.next_sequence = 0;
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, fbe_traffic_trace_filter_get_records(&traffic_trace_test_records));
+    MUT_ASSERT_INT_EQUAL(0, traffic_trace_test_records.num_records);
+    return;
+}
+
+/*!**************************************************************
+ * traffic_trace_test_bad_class()
+ ****************************************************************
+ * @brief
+ *  A filter of an unknown class is refused.
+ *
+ ****************************************************************/
+static void traffic_trace_test_bad_class(void)
+{
+    fbe_traffic_trace_filter_t filter;
+
+    traffic_trace_test_init_filter(&filter, FBE_TRAFFIC_TRACE_CLASS_INAVLID, FBE_FALSE);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_GENERIC_FAILURE, fbe_traffic_trace_filter_set(&filter));
+    traffic_trace_test_init_filter(&filter, FBE_TRAFFIC_TRACE_CLASS_LAST, FBE_FALSE);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_GENERIC_FAILURE, fbe_traffic_trace_filter_set(&filter));
+    return;
+}
+
+/*!**************************************************************
+ * traffic_trace_test_match()
+ ****************************************************************
+ * @brief
+ *  Only the I/Os of the target, lba range and opcodes of the
+ *  filter are saved, and the other classes are not changed.
+ *
+ ****************************************************************/
+static void traffic_trace_test_match(void)
+{
+    fbe_traffic_trace_filter_t filter;
+    fbe_traffic_trace_record_t *record_p = NULL;
+
+    traffic_trace_test_init_filter(&filter, FBE_TRAFFIC_TRACE_CLASS_LUN, FBE_TRUE);
+    filter.target = 5;
+    filter.start_lba = 100;
+    filter.end_lba = 199;
+    filter.op_mask = FBE_TRAFFIC_TRACE_FILTER_OP_READ;
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, fbe_traffic_trace_filter_set(&filter));
+
+    /* Binary records replace the ktrace records of the class.
+     */
+    MUT_ASSERT_INT_EQUAL(FBE_FALSE, fbe_traffic_trace_filter_record(FBE_TRAFFIC_TRACE_CLASS_LUN, 5, 150, 8, KT_READ, 0x1234));
+    MUT_ASSERT_INT_EQUAL(FBE_FALSE, fbe_traffic_trace_filter_record(FBE_TRAFFIC_TRACE_CLASS_LUN, 6, 150, 8, KT_READ, 0));
+    MUT_ASSERT_INT_EQUAL(FBE_FALSE, fbe_traffic_trace_filter_record(FBE_TRAFFIC_TRACE_CLASS_LUN, 5, 300, 8, KT_READ, 0));
+    MUT_ASSERT_INT_EQUAL(FBE_FALSE, fbe_traffic_trace_filter_record(FBE_TRAFFIC_TRACE_CLASS_LUN, 5, 0, 100, KT_READ, 0));
+    MUT_ASSERT_INT_EQUAL(FBE_FALSE, fbe_traffic_trace_filter_record(FBE_TRAFFIC_TRACE_CLASS_LUN, 5, 150, 8, KT_WRITE, 0));
+    MUT_ASSERT_INT_EQUAL(FBE_TRUE, fbe_traffic_trace_filter_record(FBE_TRAFFIC_TRACE_CLASS_RG, 5, 150, 8, KT_READ, 0));
+
+    traffic_trace_test_records.next_sequence = 0;
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, fbe_traffic_trace_filter_get_records(&traffic_trace_test_records));
+    MUT_ASSERT_INT_EQUAL(1, traffic_trace_test_records.num_records);
+    MUT_ASSERT_INT_EQUAL(0, traffic_trace_test_records.lost_records);
+    MUT_ASSERT_UINT64_EQUAL(1, traffic_trace_test_records.next_sequence);
+
+    record_p = &traffic_trace_test_records.records[0];
+    MUT_ASSERT_UINT64_EQUAL(0, record_p->sequence);
+    MUT_ASSERT_UINT64_EQUAL(150, record_p->lba);
+    MUT_ASSERT_UINT64_EQUAL(0x1234, record_p->info);
+    MUT_ASSERT_INT_EQUAL(5, record_p->target);
+    MUT_ASSERT_INT_EQUAL(8, record_p->blocks);
+    MUT_ASSERT_INT_EQUAL(KT_READ, record_p->op_code);
+    MUT_ASSERT_INT_EQUAL(FBE_TRAFFIC_TRACE_CLASS_LUN, record_p->trace_class);
+
+    /* Nothing new after the last sequence returned.
+     */
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, fbe_traffic_trace_filter_get_records(&traffic_trace_test_records));
+    MUT_ASSERT_INT_EQUAL(0, traffic_trace_test_records.num_records);
+    MUT_ASSERT_UINT64_EQUAL(1, traffic_trace_test_records.next_sequence);
+    return;
+}
+
+/*!**************************************************************
+ * traffic_trace_test_ktrace()
+ ****************************************************************
+ * @brief
+ *  A filter without binary records keeps the ktrace records of
+ *  the I/Os that match it.
+ *
+ ****************************************************************/
+static void traffic_trace_test_ktrace(void)
+{
+    fbe_traffic_trace_filter_t filter;
+
+    traffic_trace_test_init_filter(&filter, FBE_TRAFFIC_TRACE_CLASS_PVD, FBE_FALSE);
+    filter.target = 7;
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, fbe_traffic_trace_filter_set(&filter));
+
+    MUT_ASSERT_INT_EQUAL(FBE_TRUE, fbe_traffic_trace_filter_record(FBE_TRAFFIC_TRACE_CLASS_PVD, 7, 0, 1, KT_WRITE, 0));
+    MUT_ASSERT_INT_EQUAL(FBE_TRUE, fbe_traffic_trace_filter_record(FBE_TRAFFIC_TRACE_CLASS_PVD, 7, 0, 1, KT_WRITE | KT_DONE, 0));
+    MUT_ASSERT_INT_EQUAL(FBE_FALSE, fbe_traffic_trace_filter_record(FBE_TRAFFIC_TRACE_CLASS_PVD, 8, 0, 1, KT_WRITE, 0));
+
+    traffic_trace_test_records.next_sequence = 0;
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, fbe_traffic_trace_filter_get_records(&traffic_trace_test_records));
+    MUT_ASSERT_INT_EQUAL(0, traffic_trace_test_records.num_records);
+    return;
+}
+
+/*!**************************************************************
+ * traffic_trace_test_disable()
+ ****************************************************************
+ * @brief
+ *  Removing a filter gives the class its ktrace records back.
+ *
+ ****************************************************************/
+static void traffic_trace_test_disable(void)
+{
+    fbe_traffic_trace_filter_t filter;
+
+    traffic_trace_test_init_filter(&filter, FBE_TRAFFIC_TRACE_CLASS_VD, FBE_FALSE);
+    filter.target = 3;
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, fbe_traffic_trace_filter_set(&filter));
+    MUT_ASSERT_INT_EQUAL(FBE_FALSE, fbe_traffic_trace_filter_record(FBE_TRAFFIC_TRACE_CLASS_VD, 4, 0, 1, KT_READ, 0));
+
+    filter.b_enabled = FBE_FALSE;
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, fbe_traffic_trace_filter_set(&filter));
+    MUT_ASSERT_INT_EQUAL(FBE_TRUE, fbe_traffic_trace_filter_record(FBE_TRAFFIC_TRACE_CLASS_VD, 4, 0, 1, KT_READ, 0));
+    return;
+}
+
+/*!**************************************************************
+ * traffic_trace_test_latency()
+ ****************************************************************
+ * @brief
+ *  With a latency threshold the starts are dropped and only the
+ *  completions at least that slow are saved.  The threshold is
+ *  too high for any completion here, which keeps the test
+ *  independent of the timing.
+ *
+ ****************************************************************/
+static void traffic_trace_test_latency(void)
+{
+    fbe_traffic_trace_filter_t filter;
+
+    traffic_trace_test_init_filter(&filter, FBE_TRAFFIC_TRACE_CLASS_RG, FBE_TRUE);
+    filter.latency_threshold_us = FBE_U32_MAX;
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, fbe_traffic_trace_filter_set(&filter));
+
+    MUT_ASSERT_INT_EQUAL(FBE_FALSE, fbe_traffic_trace_filter_record(FBE_TRAFFIC_TRACE_CLASS_RG, 1, 64, 64, KT_READ, 0));
+    MUT_ASSERT_INT_EQUAL(FBE_FALSE, fbe_traffic_trace_filter_record(FBE_TRAFFIC_TRACE_CLASS_RG, 1, 64, 64, KT_READ | KT_DONE, 0));
+
+    traffic_trace_test_records.next_sequence = 0;
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, fbe_traffic_trace_filter_get_records(&traffic_trace_test_records));
+    MUT_ASSERT_INT_EQUAL(0, traffic_trace_test_records.num_records);
+    return;
+}
+
+/*!**************************************************************
+ * traffic_trace_test_sample()
+ ****************************************************************
+ * @brief
+ *  The start and the completion of an I/O get the same sampling
+ *  decision, and sampling drops some of the I/Os.
+ *
+ ****************************************************************/
+static void traffic_trace_test_sample(void)
+{
+    fbe_traffic_trace_filter_t filter;
+    fbe_lba_t lba;
+    fbe_bool_t b_start_traced;
+    fbe_bool_t b_done_traced;
+    fbe_u32_t traced = 0;
+
+    traffic_trace_test_init_filter(&filter, FBE_TRAFFIC_TRACE_CLASS_PD, FBE_FALSE);
+    filter.sample_rate = 4;
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, fbe_traffic_trace_filter_set(&filter));
+
+    for (lba = 0; lba < 1000; lba++)
+    {
+        b_start_traced = fbe_traffic_trace_filter_record(FBE_TRAFFIC_TRACE_CLASS_PD, 2, lba, 1, KT_READ, 0);
+        b_done_traced = fbe_traffic_trace_filter_record(FBE_TRAFFIC_TRACE_CLASS_PD, 2, lba, 1, KT_READ | KT_DONE, 0);
+        MUT_ASSERT_INT_EQUAL(b_start_traced, b_done_traced);
+        if (b_start_traced)
+        {
+            traced++;
+        }
+    }
+    MUT_ASSERT_INT_NOT_EQUAL(0, traced);
+    MUT_ASSERT_TRUE(traced < 1000);
+    return;
+}
+
+/*!**************************************************************
+ * traffic_trace_test_lost_records()
+ ****************************************************************
+ * @brief
+ *  The records overwritten before they are read are counted as
+ *  lost and the reader continues with the oldest record kept.
+ *
+ ****************************************************************/
+static void traffic_trace_test_lost_records(void)
+{
+    fbe_traffic_trace_filter_t filter;
+    fbe_u32_t index;
+
+    traffic_trace_test_init_filter(&filter, FBE_TRAFFIC_TRACE_CLASS_LUN, FBE_TRUE);
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, fbe_traffic_trace_filter_set(&filter));
+
+    for (index = 0; index < FBE_TRAFFIC_TRACE_RING_RECORDS + 10; index++)
+    {
+        fbe_traffic_trace_filter_record(FBE_TRAFFIC_TRACE_CLASS_LUN, 1, index, 1, KT_READ, 0);
+    }
+
+    traffic_trace_test_records.next_sequence = 0;
+    MUT_ASSERT_INT_EQUAL(FBE_STATUS_OK, fbe_traffic_trace_filter_get_records(&traffic_trace_test_records));
+    MUT_ASSERT_INT_EQUAL(10, traffic_trace_test_records.lost_records);
+    MUT_ASSERT_INT_EQUAL(FBE_TRAFFIC_TRACE_GET_RECORDS_MAX, traffic_trace_test_records.num_records);
+    for (index = 0; index < traffic_trace_test_records.num_records; index++)
+    {
+        MUT_ASSERT_UINT64_EQUAL(10 + index, traffic_trace_test_records.records[index].sequence);
+        MUT_ASSERT_UINT64_EQUAL(10 + index, traffic_trace_test_records.records[index].lba);
+    }
+    MUT_ASSERT_UINT64_EQUAL(10 + FBE_TRAFFIC_TRACE_GET_RECORDS_MAX, traffic_trace_test_records.next_sequence);
+    return;
+}
+
+int __cdecl main (int argc , char ** argv)
+{
+    mut_testsuite_t *trafficTraceSuite;
+
+#include "fbe/fbe_emcutil_shell_maincode.h"
+
+    mut_init(argc, argv);
+
+    trafficTraceSuite = MUT_CREATE_TESTSUITE("trafficTraceSuite")
+    MUT_ADD_TEST(trafficTraceSuite, traffic_trace_test_no_filter, traffic_trace_test_setup, traffic_trace_test_teardown);
+    MUT_ADD_TEST(trafficTraceSuite, traffic_trace_test_bad_class, traffic_trace_test_setup, traffic_trace_test_teardown);
+    MUT_ADD_TEST(trafficTraceSuite, traffic_trace_test_match, traffic_trace_test_setup, traffic_trace_test_teardown);
+    MUT_ADD_TEST(trafficTraceSuite, traffic_trace_test_ktrace, traffic_trace_test_setup, traffic_trace_test_teardown);
+    MUT_ADD_TEST(trafficTraceSuite, traffic_trace_test_disable, traffic_trace_test_setup, traffic_trace_test_teardown);
+    MUT_ADD_TEST(trafficTraceSuite, traffic_trace_test_latency, traffic_trace_test_setup, traffic_trace_test_teardown);
+    MUT_ADD_TEST(trafficTraceSuite, traffic_trace_test_sample, traffic_trace_test_setup, traffic_trace_test_teardown);
+    MUT_ADD_TEST(trafficTraceSuite, traffic_trace_test_lost_records, traffic_trace_test_setup, traffic_trace_test_teardown);
+
+    MUT_RUN_TESTSUITE(trafficTraceSuite);
+
+    exit(0);
+}
+
+/*************************
+ * end file fbe_traffic_trace_test_main.c
+ *************************/
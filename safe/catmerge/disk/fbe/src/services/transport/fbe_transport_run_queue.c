@@ -38,9 +38,64 @@ static fbe_atomic_t transport_run_queue_io_counter[2] = {0, 0}; /* NUMA Megatron
 /* Forward declaration */ 
 static void transport_run_queue_thread_func(void * context);
 
-static fbe_u32_t transport_run_batch_size = 12;
+static fbe_u32_t transport_run_batch_size = 12; /* 0 disables batching and load balancing */
 static fbe_u32_t transport_run_batch_watermark = 8;
 static fbe_bool_t transport_run_batch_enable[2] = {0, 0}; /* Per CPU socket */
+static fbe_transport_run_queue_batch_mode_t transport_run_batch_mode = FBE_TRANSPORT_RUN_QUEUE_BATCH_MODE_ADAPTIVE;
+
+/* Adaptive batching.
+ * Each core keeps a smoothed queue depth and a smoothed callback cost and derives from them 
+ * the number of requests it pulls per pass and the depth below which it steals from its neighbours.
+ * A batch is sized to fill TRANSPORT_RUN_QUEUE_BATCH_BUDGET_NS of work, but never beyond the usual depth,
+ * so lightly loaded cores keep small batches (and remain good stealing targets) while
+ * cheap callbacks on deep queues are drained with fewer lock round trips.
+ * The smoothed values are kept as sums of the last 2^TRANSPORT_RUN_QUEUE_EWMA_SHIFT samples and are only
+ * updated by the owning thread.
+ * A single pass of cheap callbacks usually takes less than one tick of fbe_get_time_in_us(), 
+ * so the cost is not sampled per pass. The pass times and callback counts are accumulated and a cost sample
+ * is taken every TRANSPORT_RUN_QUEUE_COST_SAMPLE_COUNT callbacks. Over that many callbacks the tick 
+ * truncation averages out instead of reading as a zero cost.
+ */
+#define TRANSPORT_RUN_QUEUE_BATCH_MIN       4
+#define TRANSPORT_RUN_QUEUE_BATCH_MAX       (FBE_TRANSPORT_RUN_QUEUE_HIST_DEPTH_SIZE - 1)
+#define TRANSPORT_RUN_QUEUE_BATCH_BUDGET_NS 50000 /* 50 usec */
+#define TRANSPORT_RUN_QUEUE_EWMA_SHIFT      3
+#define TRANSPORT_RUN_QUEUE_MAX_COST_NS     0x0FFFFFFF
+#define TRANSPORT_RUN_QUEUE_COST_SAMPLE_COUNT 256
+
+static fbe_u32_t transport_run_queue_batch_size[FBE_CPU_ID_MAX];
+static fbe_u32_t transport_run_queue_batch_watermark[FBE_CPU_ID_MAX];
+static fbe_u64_t transport_run_queue_depth_sum[FBE_CPU_ID_MAX];
+static fbe_u64_t transport_run_queue_cost_sum[FBE_CPU_ID_MAX];
+static fbe_u64_t transport_run_queue_cost_time[FBE_CPU_ID_MAX];
+static fbe_u32_t transport_run_queue_cost_count[FBE_CPU_ID_MAX];
+
+/* Run queue wait time. 
+ * head_time is the time the oldest request was queued, 0 when the queue is empty.
+ * Protected by the multicore queue lock.
+ */
+static fbe_time_t transport_run_queue_head_time[FBE_CPU_ID_MAX];
+static fbe_u64_t transport_run_queue_wait_time[FBE_CPU_ID_MAX];
+static fbe_u64_t transport_run_queue_wait_count[FBE_CPU_ID_MAX];
+static fbe_u32_t transport_run_queue_max_wait[FBE_CPU_ID_MAX];
+
+static __forceinline fbe_u32_t 
+transport_run_queue_get_batch_size(fbe_cpu_id_t cpu)
+{
+	if(transport_run_batch_mode == FBE_TRANSPORT_RUN_QUEUE_BATCH_MODE_ADAPTIVE){
+		return transport_run_queue_batch_size[cpu];
+	}
+	return transport_run_batch_size;
+}
+
+static __forceinline fbe_u32_t 
+transport_run_queue_get_batch_watermark(fbe_cpu_id_t cpu)
+{
+	if(transport_run_batch_mode == FBE_TRANSPORT_RUN_QUEUE_BATCH_MODE_ADAPTIVE){
+		return transport_run_queue_batch_watermark[cpu];
+	}
+	return transport_run_batch_watermark;
+}
 
 void
 transport_run_queue_trace(fbe_trace_level_t trace_level,
@@ -139,6 +194,17 @@ fbe_transport_run_queue_init(void)
 		for(j = 0; j < FBE_TRANSPORT_RUN_QUEUE_HIST_DEPTH_SIZE; j++){
 			transport_run_queue_hist_depth[i][j] = 0;
 		}
+		transport_run_queue_batch_size[i] = transport_run_batch_size;
+		transport_run_queue_batch_watermark[i] = transport_run_batch_watermark;
+		transport_run_queue_depth_sum[i] = 0;
+		/* Start from the cost that gives the fixed batch size until the first sample is taken */
+		transport_run_queue_cost_sum[i] = (TRANSPORT_RUN_QUEUE_BATCH_BUDGET_NS / FBE_MAX(transport_run_batch_size, 1)) << TRANSPORT_RUN_QUEUE_EWMA_SHIFT;
+		transport_run_queue_cost_time[i] = 0;
+		transport_run_queue_cost_count[i] = 0;
+		transport_run_queue_head_time[i] = 0;
+		transport_run_queue_wait_time[i] = 0;
+		transport_run_queue_wait_count[i] = 0;
+		transport_run_queue_max_wait[i] = 0;
 		transport_run_queue_thread_flag[i] = TRANSPORT_RUN_QUEUE_THREAD_RUN;
 		fbe_thread_init(&transport_run_queue_thread_handle[i], "fbe_trans_runq", transport_run_queue_thread_func, (void*)(fbe_ptrhld_t)i);
 	}
@@ -193,6 +259,9 @@ fbe_transport_run_queue_push_queue_element(fbe_queue_element_t *queue_element, f
         fbe_multicore_queue_lock(&transport_run_multicore_queue, cpu_id);
         fbe_multicore_queue_push(&transport_run_multicore_queue, queue_element, cpu_id);
         fbe_rendezvous_event_set(&transport_run_queue_event[cpu_id]);
+        if(transport_run_queue_counter[cpu_id] == 0){ /* This request is the head of the queue */
+            transport_run_queue_head_time[cpu_id] = fbe_get_time_in_us();
+        }
         transport_run_queue_counter[cpu_id]++;
         fbe_multicore_queue_unlock(&transport_run_multicore_queue, cpu_id);
     }
@@ -244,11 +313,11 @@ transport_run_queue_get_load_from_other_core(fbe_cpu_id_t thread_number, fbe_u32
 	fbe_cpu_id_t cpu = thread_number;
 	fbe_u64_t counter;
 	fbe_queue_element_t * queue_element = NULL;
-	fbe_u32_t batch_size = transport_run_batch_size;
+	fbe_u32_t batch_size = transport_run_queue_get_batch_size(thread_number);
 	
 	/* If we woke up and there is nothing on our queue.*/
 	if(queue_depth == 0){ 
-		batch_size = transport_run_batch_size * 2; /* Let's boost the help to others */
+		batch_size *= 2; /* Let's boost the help to others */
 	}
 
 	counter = 0;
@@ -256,7 +325,7 @@ transport_run_queue_get_load_from_other_core(fbe_cpu_id_t thread_number, fbe_u32
 	/* Find busy CPU on that socket */
 	if(thread_number > 7){ /* 8 - 15 */
 		for(i = 8; i < FBE_MIN(16, transport_run_queue_cpu_count); i++){
-			if((transport_run_queue_counter[i] > transport_run_batch_size) && /* This core has some staff to do */
+			if((transport_run_queue_counter[i] > transport_run_queue_get_batch_size(i)) && /* This core has some staff to do */
 				(counter < transport_run_queue_counter[i])){ /* Find the busiest one */
 				counter = transport_run_queue_counter[i];
 				cpu = i;
@@ -264,7 +333,7 @@ transport_run_queue_get_load_from_other_core(fbe_cpu_id_t thread_number, fbe_u32
 		}
 	} else { /* 0 - 7 */
 		for(i = 0; i < FBE_MIN(8, transport_run_queue_cpu_count); i++){
-			if((transport_run_queue_counter[i] > transport_run_batch_size) && /* This core has some staff to do */
+			if((transport_run_queue_counter[i] > transport_run_queue_get_batch_size(i)) && /* This core has some staff to do */
 				(counter < transport_run_queue_counter[i])){ /* Find the busiest one */
 				counter = transport_run_queue_counter[i];
 				cpu = i;
@@ -283,6 +352,8 @@ transport_run_queue_get_load_from_other_core(fbe_cpu_id_t thread_number, fbe_u32
 				break;
 			}
 		}
+		/* The oldest requests are gone, whatever is left has been waiting at most since now */
+		transport_run_queue_head_time[cpu] = (transport_run_queue_counter[cpu] != 0) ? fbe_get_time_in_us() : 0;
 		fbe_multicore_queue_unlock(&transport_run_multicore_queue, cpu);					
 	} 
 }
@@ -293,12 +364,13 @@ transport_run_queue_delegate_load_to_other_core(fbe_cpu_id_t thread_number)
 	fbe_cpu_id_t i;
 	fbe_cpu_id_t cpu;
 	fbe_u64_t counter;
+	fbe_u32_t batch_size = transport_run_queue_get_batch_size(thread_number);
 
-	counter = transport_run_batch_size;
+	counter = batch_size;
 	/* Find idle CPU on that socket */
 	if(thread_number > 7){ /* 8 - 15 */
 		for(i = 8; i < FBE_MIN(16, transport_run_queue_cpu_count); i++){
-			if((transport_run_queue_counter[i] < transport_run_batch_watermark) && /* This core has some power */
+			if((transport_run_queue_counter[i] < transport_run_queue_get_batch_watermark(i)) && /* This core has some power */
 				(counter > transport_run_queue_counter[i])){ /* Find the idle one */
 				counter = transport_run_queue_counter[i];
 				cpu = i;
@@ -306,7 +378,7 @@ transport_run_queue_delegate_load_to_other_core(fbe_cpu_id_t thread_number)
 		}
 	} else { /* 0 - 7 */
 		for(i = 0; i < FBE_MIN(8, transport_run_queue_cpu_count); i++){
-			if((transport_run_queue_counter[i] < transport_run_batch_watermark) && /* This core has some power */
+			if((transport_run_queue_counter[i] < transport_run_queue_get_batch_watermark(i)) && /* This core has some power */
 				(counter > transport_run_queue_counter[i])){ /* Find the idle one */
 				counter = transport_run_queue_counter[i];
 				cpu = i;
@@ -314,7 +386,7 @@ transport_run_queue_delegate_load_to_other_core(fbe_cpu_id_t thread_number)
 		}
 	}
 	/* Wake up the idle core core */
-	if(counter < transport_run_batch_size){
+	if(counter < batch_size){
 		fbe_rendezvous_event_set(&transport_run_queue_event[cpu]);
 	} else { /* All cores are busy */
 		if(thread_number > 7){
@@ -325,6 +397,67 @@ transport_run_queue_delegate_load_to_other_core(fbe_cpu_id_t thread_number)
 	}
 }
 
+/*!**************************************************************
+ * transport_run_queue_adapt_batch()
+ ****************************************************************
+ * @brief
+ *  Fold the last pass of the run queue thread into the smoothed
+ *  queue depth of the core, accumulate its time and callback count
+ *  toward the next cost sample and recompute the adaptive batch 
+ *  size and stealing watermark.
+ *  Only called by the thread that owns the core.
+ *
+ * @param thread_number - core of the run queue thread.
+ * @param pending - queue depth seen at the start of the pass.
+ * @param processed - number of callbacks executed.
+ * @param elapsed_us - time spent executing them.
+ *
+ * @return None.
+ *
+ ****************************************************************/
+static __forceinline void 
+transport_run_queue_adapt_batch(fbe_cpu_id_t thread_number, fbe_u64_t pending, fbe_u32_t processed, fbe_time_t elapsed_us)
+{
+	fbe_u64_t cost_ns;
+	fbe_u64_t depth;
+	fbe_u64_t batch_size;
+
+	transport_run_queue_depth_sum[thread_number] -= transport_run_queue_depth_sum[thread_number] >> TRANSPORT_RUN_QUEUE_EWMA_SHIFT;
+	transport_run_queue_depth_sum[thread_number] += pending;
+
+	transport_run_queue_cost_time[thread_number] += elapsed_us;
+	transport_run_queue_cost_count[thread_number] += processed;
+	if(transport_run_queue_cost_count[thread_number] >= TRANSPORT_RUN_QUEUE_COST_SAMPLE_COUNT){
+		cost_ns = (transport_run_queue_cost_time[thread_number] * 1000) / transport_run_queue_cost_count[thread_number];
+		if(cost_ns > TRANSPORT_RUN_QUEUE_MAX_COST_NS){
+			cost_ns = TRANSPORT_RUN_QUEUE_MAX_COST_NS;
+		}
+		transport_run_queue_cost_sum[thread_number] -= transport_run_queue_cost_sum[thread_number] >> TRANSPORT_RUN_QUEUE_EWMA_SHIFT;
+		transport_run_queue_cost_sum[thread_number] += cost_ns;
+		transport_run_queue_cost_time[thread_number] = 0;
+		transport_run_queue_cost_count[thread_number] = 0;
+	}
+
+	depth = transport_run_queue_depth_sum[thread_number] >> TRANSPORT_RUN_QUEUE_EWMA_SHIFT;
+	cost_ns = transport_run_queue_cost_sum[thread_number] >> TRANSPORT_RUN_QUEUE_EWMA_SHIFT;
+
+	/* Fill the time budget, there is no point to go beyond the usual depth */
+	batch_size = (cost_ns != 0) ? (TRANSPORT_RUN_QUEUE_BATCH_BUDGET_NS / cost_ns) : TRANSPORT_RUN_QUEUE_BATCH_MAX;
+	if(batch_size > depth){
+		batch_size = depth;
+	}
+	if(batch_size < TRANSPORT_RUN_QUEUE_BATCH_MIN){
+		batch_size = TRANSPORT_RUN_QUEUE_BATCH_MIN;
+	}
+	if(batch_size > TRANSPORT_RUN_QUEUE_BATCH_MAX){
+		batch_size = TRANSPORT_RUN_QUEUE_BATCH_MAX;
+	}
+
+	transport_run_queue_batch_size[thread_number] = (fbe_u32_t)batch_size;
+	/* Same 2/3 ratio as the fixed 12/8 setting */
+	transport_run_queue_batch_watermark[thread_number] = (fbe_u32_t)((batch_size * 2) / 3);
+}
+
 static void 
 transport_run_queue_thread_func(void * context)
 {
@@ -334,6 +467,11 @@ transport_run_queue_thread_func(void * context)
 	fbe_queue_element_t * queue_element = NULL;
 	fbe_u32_t queue_depth;
 	fbe_bool_t batch_enabled;
+	fbe_u32_t batch_size;
+	fbe_u64_t pending;
+	fbe_u32_t processed;
+	fbe_time_t start_time;
+	fbe_time_t wait_time;
 
 	thread_number = (fbe_cpu_id_t)(csx_ptrhld_t)context;
 
@@ -350,9 +488,22 @@ transport_run_queue_thread_func(void * context)
 		fbe_rendezvous_event_wait(&transport_run_queue_event[thread_number], 1000); /* Wake up every sec. */
 		if(transport_run_queue_thread_flag[thread_number] == TRANSPORT_RUN_QUEUE_THREAD_RUN) {
 			
+			batch_size = transport_run_queue_get_batch_size(thread_number);
+
 			fbe_multicore_queue_lock(&transport_run_multicore_queue, thread_number);
 			//fbe_rendezvous_event_clear(&transport_run_queue_event[thread_number]);
 			queue_depth = 0;
+			pending = transport_run_queue_counter[thread_number];
+			start_time = fbe_get_time_in_us();
+			if(transport_run_queue_head_time[thread_number] != 0){
+				wait_time = (start_time > transport_run_queue_head_time[thread_number]) ? 
+									(start_time - transport_run_queue_head_time[thread_number]) : 0;
+				transport_run_queue_wait_time[thread_number] += wait_time;
+				transport_run_queue_wait_count[thread_number]++;
+				if(wait_time > transport_run_queue_max_wait[thread_number]){
+					transport_run_queue_max_wait[thread_number] = (fbe_u32_t)FBE_MIN(wait_time, FBE_U32_MAX);
+				}
+			}
 			while(queue_element = fbe_multicore_queue_pop(&transport_run_multicore_queue, thread_number)){
 				fbe_queue_push(&tmp_queue, queue_element);
                 if (transport_run_queue_counter[thread_number] == 0){
@@ -363,7 +514,7 @@ transport_run_queue_thread_func(void * context)
 				transport_run_queue_counter[thread_number]--;
 				queue_depth++;
 
-				if((transport_run_batch_size != 0 ) && (queue_depth >= transport_run_batch_size)){
+				if((transport_run_batch_size != 0 ) && (queue_depth >= batch_size)){
 					break;
 				}
 			}
@@ -372,6 +523,9 @@ transport_run_queue_thread_func(void * context)
 				fbe_rendezvous_event_clear(&transport_run_queue_event[thread_number]);
 			}
 
+			/* Whatever is left has been waiting at most since now */
+			transport_run_queue_head_time[thread_number] = (transport_run_queue_counter[thread_number] != 0) ? start_time : 0;
+
 			transport_run_queue_current_depth[thread_number] = queue_depth;
 			if(queue_depth > transport_run_queue_max_depth[thread_number]){
 				transport_run_queue_max_depth[thread_number] = queue_depth;
@@ -385,7 +539,7 @@ transport_run_queue_thread_func(void * context)
 			fbe_multicore_queue_unlock(&transport_run_multicore_queue, thread_number);
 
 			/* Check if we busy or not */
-			if((transport_run_batch_size != 0) && (queue_depth <= transport_run_batch_watermark)){ /* We can do something */
+			if((transport_run_batch_size != 0) && (queue_depth <= transport_run_queue_get_batch_watermark(thread_number))){ /* We can do something */
 				if(thread_number > 7){
 					transport_run_batch_enable[1] = FBE_TRUE; /* Not all cores are busy */
 				} else {
@@ -406,8 +560,14 @@ transport_run_queue_thread_func(void * context)
 			}
 
 			/* The actual processing */
+			processed = 0;
 			while(queue_element = fbe_queue_pop(&tmp_queue)){
                 transport_run_queue_perform_callback(queue_element, thread_number);
+				processed++;
+			}
+
+			if(processed != 0){
+				transport_run_queue_adapt_batch(thread_number, pending, processed, fbe_get_time_in_us() - start_time);
 			}
 		} else {
 			break;
@@ -509,6 +669,12 @@ fbe_transport_run_queue_get_stats(void * in_stats)
 		for(j = 0; j < FBE_TRANSPORT_RUN_QUEUE_HIST_DEPTH_SIZE; j++){
 			stats->core_stat[i].runq_stats.transport_run_queue_hist_depth[j] = transport_run_queue_hist_depth[i][j];
 		}
+		stats->core_stat[i].runq_stats.transport_run_queue_batch_size = transport_run_queue_get_batch_size(i);
+		stats->core_stat[i].runq_stats.transport_run_queue_batch_watermark = transport_run_queue_get_batch_watermark(i);
+		stats->core_stat[i].runq_stats.transport_run_queue_callback_cost_ns = (fbe_u32_t)(transport_run_queue_cost_sum[i] >> TRANSPORT_RUN_QUEUE_EWMA_SHIFT);
+		stats->core_stat[i].runq_stats.transport_run_queue_max_wait_us = transport_run_queue_max_wait[i];
+		stats->core_stat[i].runq_stats.transport_run_queue_wait_time_us = transport_run_queue_wait_time[i];
+		stats->core_stat[i].runq_stats.transport_run_queue_wait_count = transport_run_queue_wait_count[i];
 		fbe_multicore_queue_unlock(&transport_run_multicore_queue, i);
 	}
 
@@ -528,11 +694,40 @@ fbe_transport_run_queue_clear_stats(void)
 		for(j = 0; j < FBE_TRANSPORT_RUN_QUEUE_HIST_DEPTH_SIZE; j++){
 			transport_run_queue_hist_depth[i][j] = 0;
 		}
+		transport_run_queue_wait_time[i] = 0;
+		transport_run_queue_wait_count[i] = 0;
+		transport_run_queue_max_wait[i] = 0;
 		fbe_multicore_queue_unlock(&transport_run_multicore_queue, i);
 	}
 	return FBE_STATUS_OK;
 }
 
+fbe_status_t
+fbe_transport_run_queue_set_batch_mode(fbe_transport_run_queue_batch_mode_t batch_mode)
+{
+	if((batch_mode != FBE_TRANSPORT_RUN_QUEUE_BATCH_MODE_FIXED) && 
+		(batch_mode != FBE_TRANSPORT_RUN_QUEUE_BATCH_MODE_ADAPTIVE)){
+		transport_run_queue_trace(FBE_TRACE_LEVEL_ERROR, 
+						FBE_TRACE_MESSAGE_ID_FUNCTION_FAILED,
+						"%s Invalid batch mode %d\n", __FUNCTION__, batch_mode);
+		return FBE_STATUS_GENERIC_FAILURE;
+	}
+
+	transport_run_batch_mode = batch_mode;
+
+	transport_run_queue_trace(FBE_TRACE_LEVEL_INFO, 
+					FBE_TRACE_MESSAGE_ID_INFO,
+					"%s batch mode %s\n", __FUNCTION__, 
+					(batch_mode == FBE_TRANSPORT_RUN_QUEUE_BATCH_MODE_ADAPTIVE) ? "adaptive" : "fixed");
+	return FBE_STATUS_OK;
+}
+
+fbe_transport_run_queue_batch_mode_t
+fbe_transport_run_queue_get_batch_mode(void)
+{
+	return transport_run_batch_mode;
+}
+
 fbe_status_t fbe_transport_run_queue_push_packet(fbe_packet_t * packet, fbe_transport_rq_method_t rq_method)
 {
 	fbe_cpu_id_t cpu_id;
@@ -278,6 +278,7 @@ typedef struct fbe_api_base_config_get_metadata_statistics_s{
 	fbe_u64_t			local_collision_count;
 	fbe_u64_t			peer_collision_count;
 	fbe_u64_t			cmi_message_count;
+	fbe_u64_t			nonpaged_write_count;
 }fbe_api_base_config_get_metadata_statistics_t;
 
 fbe_status_t FBE_API_CALL fbe_api_base_config_get_metadata_statistics(fbe_object_id_t object_id, 
@@ -86,6 +86,7 @@ fbe_status_t FBE_API_CALL fbe_api_bvd_interface_enable_async_io_compl(void);
 fbe_status_t FBE_API_CALL fbe_api_bvd_interface_disable_async_io_compl(void);
 fbe_status_t FBE_API_CALL fbe_api_bvd_interface_set_rq_method(fbe_transport_rq_method_t rq_method);
 fbe_status_t FBE_API_CALL fbe_api_bvd_interface_set_alert_time(fbe_u32_t alert_time);
+fbe_status_t FBE_API_CALL fbe_api_bvd_interface_set_run_queue_batch_mode(fbe_transport_run_queue_batch_mode_t batch_mode);
 
 fbe_status_t FBE_API_CALL fbe_api_bvd_interface_enable_group_priority(fbe_bool_t apply_to_pp);
 fbe_status_t FBE_API_CALL fbe_api_bvd_interface_disable_group_priority(fbe_bool_t apply_to_pp);
@@ -37,6 +37,7 @@
 #include "fbe/fbe_api_common_interface.h"
 #include "fbe/fbe_api_common_job_notification.h"
 #include "fbe/fbe_job_service_interface.h"
+#include "fbe/fbe_traffic_trace_interface.h"
 #include "fbe/fbe_notification_lib.h"
 #ifdef C4_INTEGRATED
 #include "fbe/fbe_enclosure.h"
@@ -470,6 +471,10 @@ fbe_status_t FBE_API_CALL fbe_api_traffic_trace_enable(fbe_u32_t object_tag,
                                                         fbe_package_id_t package_id);
 fbe_status_t FBE_API_CALL fbe_api_traffic_trace_disable(fbe_u32_t object_tag,
                                                         fbe_package_id_t package_id);
+fbe_status_t FBE_API_CALL fbe_api_traffic_trace_set_filter(fbe_traffic_trace_filter_t *filter_p,
+                                                            fbe_package_id_t package_id);
+fbe_status_t FBE_API_CALL fbe_api_traffic_trace_get_records(fbe_traffic_trace_get_records_t *get_records_p,
+                                                            fbe_package_id_t package_id);
 
 fbe_status_t FBE_API_CALL fbe_api_common_package_entry_initialized (fbe_package_id_t package_id, fbe_bool_t *initialized);
 
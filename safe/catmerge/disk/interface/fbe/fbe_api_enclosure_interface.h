@@ -307,6 +307,8 @@ fbe_status_t FBE_API_CALL fbe_api_enclosure_get_disk_parent_object_id(fbe_u32_t
                                                                       
 fbe_status_t FBE_API_CALL fbe_api_enclosure_get_ssc_count(fbe_object_id_t objectId,
                                                           fbe_u8_t * pSscCount);
+fbe_status_t FBE_API_CALL fbe_api_enclosure_status_page_stats(fbe_object_id_t object_id,
+                                                              fbe_enclosure_mgmt_status_page_stats_t *stats);
                                                           
 fbe_status_t FBE_API_CALL fbe_api_enclosure_get_ssc_info(fbe_object_id_t objectId,
                                                          fbe_ssc_info_t * pSscInfo);
@@ -633,6 +633,15 @@ fbe_api_job_service_delete_debug_hook(fbe_object_id_t object_id,
                                       fbe_job_debug_hook_state_phase_t hook_phase,
                                       fbe_job_debug_hook_action_t hook_action);
 
+fbe_status_t FBE_API_CALL 
+fbe_api_job_service_set_pipeline_mode(fbe_bool_t b_enabled);
+fbe_status_t FBE_API_CALL 
+fbe_api_job_service_get_pipeline_info(fbe_job_service_pipeline_info_t *pipeline_info_p);
+fbe_status_t FBE_API_CALL 
+fbe_api_job_service_set_spare_index_verify(fbe_bool_t b_enabled);
+fbe_status_t FBE_API_CALL 
+fbe_api_job_service_get_spare_index_info(fbe_job_service_spare_index_info_t *spare_index_info_p);
+
 fbe_status_t FBE_API_CALL 
 fbe_api_job_service_validate_database(fbe_api_job_service_validate_database_t *validate_database_p);
 
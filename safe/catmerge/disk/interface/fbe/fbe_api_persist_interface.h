@@ -140,6 +140,7 @@ fbe_status_t FBE_API_CALL fbe_api_persist_read_single_entry(fbe_persist_entry_id
 															fbe_persist_completion_context_t completion_context);
 
 fbe_status_t FBE_API_CALL fbe_api_persist_get_layout_info(fbe_persist_control_get_layout_info_t *get_info);
+fbe_status_t FBE_API_CALL fbe_api_persist_get_stats(fbe_persist_control_get_stats_t *get_stats);
 
 fbe_status_t FBE_API_CALL fbe_api_persist_write_entry_with_auto_entry_id_on_top(fbe_persist_transaction_handle_t transaction_handle,
 																				fbe_persist_sector_type_t target_sector,
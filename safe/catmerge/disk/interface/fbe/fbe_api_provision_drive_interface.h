@@ -563,6 +563,9 @@ fbe_status_t FBE_API_CALL fbe_api_provision_drive_get_ssd_statistics(fbe_object_
 fbe_status_t FBE_API_CALL fbe_api_provision_drive_get_ssd_block_limits(fbe_object_id_t pvd_object_id,
                                                                        fbe_api_provision_drive_get_ssd_block_limits_t * get_block_limits_p);
 fbe_status_t FBE_API_CALL fbe_api_provision_drive_set_wear_leveling_timer(fbe_u64_t wear_leveling_timer_sec);
+fbe_status_t FBE_API_CALL fbe_api_provision_drive_set_zod_batch_enabled(fbe_bool_t b_enabled);
+fbe_status_t FBE_API_CALL fbe_api_provision_drive_get_zod_batch_info(fbe_object_id_t object_id, fbe_provision_drive_get_zod_batch_info_t *get_info);
+fbe_status_t FBE_API_CALL fbe_api_provision_drive_set_verify_invalidate_batch_enabled(fbe_bool_t b_enabled);
 
 /*! @} */ /* end of group fbe_api_provision_drive_interface */
 
@@ -266,6 +266,9 @@ typedef struct fbe_api_raid_group_get_info_s
 
     fbe_u32_t background_op_seconds; /*! Total seconds Background op is running for. */
     fbe_lba_t rekey_checkpoint; /*! Current rekey checkpoint. */
+    fbe_u32_t rebuild_concurrent_request_count; /*! Rebuild requests issued as concurrent I/Os. */
+    fbe_u32_t rebuild_queue_depth; /*! Rebuild I/Os currently issued together. */
+    fbe_u32_t rebuild_op_chunks; /*! Chunks currently in each rebuild I/O. */
 }
 fbe_api_raid_group_get_info_t;
 
@@ -655,6 +658,10 @@ fbe_status_t FBE_API_CALL fbe_api_raid_group_set_raid_group_debug_state(fbe_obje
 
 
 fbe_status_t FBE_API_CALL fbe_api_raid_group_set_chunks_per_rebuild(fbe_u32_t num_chunks_per_rebuild);
+fbe_status_t FBE_API_CALL fbe_api_raid_group_set_max_concurrent_rebuild_ios(fbe_u32_t max_concurrent_ios);
+fbe_status_t FBE_API_CALL fbe_api_raid_group_set_rebuild_catch_up_window(fbe_block_count_t catch_up_window_blocks);
+fbe_status_t FBE_API_CALL fbe_api_raid_group_get_read_ahead_stats(fbe_object_id_t rg_object_id,
+                                                                  fbe_raid_group_get_read_ahead_stats_t *stats_p);
 /*! @} */ /* end of group fbe_api_raid_group_interface */
 
 
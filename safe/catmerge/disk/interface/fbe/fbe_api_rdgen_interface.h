@@ -188,6 +188,25 @@ typedef struct fbe_api_rdgen_get_stats_s
 }
 fbe_api_rdgen_get_stats_t;
 
+/*!*******************************************************************
+ * @struct fbe_api_rdgen_latency_percentiles_t
+ *********************************************************************
+ * @brief Percentiles computed from an rdgen latency histogram.
+ *        All times are in microseconds and are the upper bound of
+ *        the histogram bucket the percentile falls into.
+ *
+ *********************************************************************/
+typedef struct fbe_api_rdgen_latency_percentiles_s
+{
+    fbe_u64_t count; /*!< Number of samples. */
+    fbe_u64_t p50_usec;
+    fbe_u64_t p90_usec;
+    fbe_u64_t p99_usec;
+    fbe_u64_t p99_9_usec;
+    fbe_u64_t max_usec;
+}
+fbe_api_rdgen_latency_percentiles_t;
+
 typedef fbe_u64_t fbe_api_rdgen_handle_t;
 
 /*!*******************************************************************
@@ -594,6 +613,12 @@ fbe_status_t fbe_api_rdgen_get_stats(fbe_api_rdgen_get_stats_t *info_p,
 fbe_status_t fbe_api_rdgen_get_complete_stats(fbe_rdgen_control_get_stats_t *info_p,
                                               fbe_rdgen_filter_t *filter_p);
 fbe_status_t fbe_api_rdgen_reset_stats(void);
+fbe_status_t fbe_api_rdgen_get_latency_histogram(fbe_rdgen_control_get_latency_histogram_t *histogram_p,
+                                                fbe_rdgen_filter_t *filter_p);
+fbe_u64_t fbe_api_rdgen_latency_histogram_get_percentile(fbe_rdgen_latency_histogram_t *histogram_p,
+                                                         fbe_u32_t percentile_x100);
+void fbe_api_rdgen_latency_histogram_get_percentiles(fbe_rdgen_latency_histogram_t *histogram_p,
+                                                     fbe_api_rdgen_latency_percentiles_t *percentiles_p);
 void fbe_api_rdgen_get_operation_string(fbe_rdgen_operation_t operation,
                                         const fbe_char_t **operation_string_p);
 fbe_status_t fbe_api_rdgen_set_trace_level(fbe_u32_t trace_level);
@@ -759,6 +784,16 @@ fbe_status_t fbe_api_rdgen_set_svc_options(fbe_rdgen_svc_options_t *options_p);
 
 fbe_status_t fbe_api_rdgen_set_msec_delay(fbe_rdgen_io_specification_t *io_spec_p,
                                           fbe_u32_t msec_delay);
+fbe_status_t fbe_api_rdgen_io_specification_set_arrival_rate(fbe_rdgen_io_specification_t *io_spec_p,
+                                                             fbe_rdgen_arrival_mode_t arrival_mode,
+                                                             fbe_u32_t arrival_iops);
+fbe_status_t fbe_api_rdgen_filter_init_for_playback_trace(fbe_rdgen_filter_t *filter_p,
+                                                          fbe_char_t *file_name_p,
+                                                          fbe_object_id_t object_id,
+                                                          fbe_package_id_t package_id);
+fbe_status_t fbe_api_rdgen_io_specification_set_playback_trace(fbe_rdgen_io_specification_t *io_spec_p,
+                                                               fbe_rdgen_playback_format_t format,
+                                                               fbe_u32_t time_scale_percent);
 /*! @} */ /* end of group fbe_api_rdgen_interface */
 
 //----------------------------------------------------------------
@@ -251,6 +251,8 @@ fbe_status_t fbe_api_terminator_set_simulated_drive_server_port(fbe_u16_t server
 fbe_status_t fbe_api_terminator_drive_set_state(fbe_terminator_api_device_handle_t device_handle,terminator_sas_drive_state_t  drive_state);
 fbe_status_t fbe_api_terminator_sas_drive_get_default_page_info(fbe_sas_drive_type_t drive_type, fbe_terminator_sas_drive_type_default_info_t *default_info);
 fbe_status_t fbe_api_terminator_sas_drive_set_default_page_info(fbe_sas_drive_type_t drive_type, const fbe_terminator_sas_drive_type_default_info_t *default_info);
+fbe_status_t fbe_api_terminator_drive_get_latency_model(fbe_sas_drive_type_t drive_type, fbe_terminator_drive_latency_model_t *model_p);
+fbe_status_t fbe_api_terminator_drive_set_latency_model(fbe_sas_drive_type_t drive_type, const fbe_terminator_drive_latency_model_t *model_p);
 fbe_status_t fbe_api_terminator_sas_drive_set_default_field(fbe_sas_drive_type_t drive_type, fbe_terminator_drive_default_field_t field, const fbe_u8_t *inq_data, fbe_u32_t inq_size);
 fbe_status_t fbe_api_terminator_drive_set_log_page_31_data(fbe_api_terminator_device_handle_t drive_handle,
                                                            fbe_u8_t * log_page_31,
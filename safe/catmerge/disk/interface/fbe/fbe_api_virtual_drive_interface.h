@@ -185,6 +185,7 @@ fbe_api_virtual_drive_set_unused_drive_as_spare_flag(fbe_object_id_t vd_object_i
                                                      fbe_bool_t  set_unsued_drive_as_spare_flag);
 fbe_status_t FBE_API_CALL fbe_api_virtual_drive_get_permanent_spare_trigger_time(fbe_api_virtual_drive_permanent_spare_trigger_time_t * spare_config_info);
 fbe_status_t FBE_API_CALL fbe_api_virtual_drive_class_set_unused_as_spare_flag(fbe_bool_t enable);
+fbe_status_t FBE_API_CALL fbe_api_virtual_drive_class_set_copy_concurrent_regions(fbe_u32_t concurrent_regions);
 
 
 fbe_status_t FBE_API_CALL
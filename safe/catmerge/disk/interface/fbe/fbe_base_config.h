@@ -687,6 +687,7 @@ typedef struct fbe_base_config_control_get_metadata_statistics_s{
     fbe_u64_t           local_collision_count;
     fbe_u64_t           peer_collision_count;
     fbe_u64_t           cmi_message_count;
+    fbe_u64_t           nonpaged_write_count;
 }fbe_base_config_control_get_metadata_statistics_t;
 
 
@@ -74,6 +74,8 @@ typedef enum fbe_bvd_interface_control_code_e{
     FBE_BVD_INTERFACE_CONTROL_CODE_SHUTDOWN,
 
     FBE_BVD_INTERFACE_CONTROL_CODE_UNEXPORT_LUN,
+
+    FBE_BVD_INTERFACE_CONTROL_CODE_SET_RUN_QUEUE_BATCH_MODE,
     /* Insert new control codes above*/
     FBE_BVD_INTERFACE_CONTROL_CODE_LAST
 }fbe_bvd_interface_control_code_t;
@@ -346,6 +346,7 @@ typedef enum
     FBE_BASE_ENCLOSURE_CONTROL_CODE_GET_SLOT_PRESENT,
     FBE_BASE_ENCLOSURE_CONTROL_CODE_GET_BATTERY_BACKED_INFO,
     FBE_BASE_ENCLOSURE_CONTROL_CODE_SET_ENCLOSURE_FAILED,
+    FBE_BASE_ENCLOSURE_CONTROL_CODE_STATUS_PAGE_STATS,
 
     FBE_BASE_ENCLOSURE_CONTROL_CODE_LAST
 }fbe_base_enclosure_control_code_t;
@@ -1678,6 +1679,26 @@ typedef struct fbe_enclosure_mgmt_get_shutdown_info_s{
     fbe_u8_t                        shutdownReason;
 } fbe_enclosure_mgmt_get_shutdown_info_t;
 
+// FBE_BASE_ENCLOSURE_CONTROL_CODE_STATUS_PAGE_STATS
+/*!********************************************************************* 
+ * @struct fbe_enclosure_mgmt_status_page_stats_t
+ *  
+ * @brief 
+ *   Get the status page processing statistics of the enclosure,
+ *   optionally turning incremental processing on or off and
+ *   clearing the statistics afterwards.
+ **********************************************************************/
+typedef struct fbe_enclosure_mgmt_status_page_stats_s{
+    fbe_bool_t  setIncremental;     // INPUT - apply incremental below
+    fbe_bool_t  clearStats;         // INPUT - clear the statistics once returned
+    fbe_bool_t  incremental;        // INPUT/OUTPUT - only changed element groups are decoded
+    fbe_u32_t   pagesProcessed;     // OUTPUT
+    fbe_u32_t   fullDecodes;        // OUTPUT - pages decoded completely
+    fbe_u64_t   groupsDecoded;      // OUTPUT
+    fbe_u64_t   groupsSkipped;      // OUTPUT - unchanged since the previous page
+    fbe_u64_t   processTimeUs;      // OUTPUT - time spent processing the pages
+} fbe_enclosure_mgmt_status_page_stats_t;
+
 // FBE_BASE_ENCLOSURE_CONTROL_CODE_GET_OVERTEMP_INFO
 /*!********************************************************************* 
  * @struct fbe_enclosure_mgmt_get_overtemp_info_t
@@ -5,8 +5,9 @@
 #include "fbe_queue.h"
 #include "fbe_winddk.h"
 
+/* Entries are cache line aligned so that cores do not share the lines of their heads and locks */
 typedef struct fbe_multicore_queue_entry_s {
-	fbe_queue_head_t head; /* One head per core */
+	FBE_ALIGN(64)fbe_queue_head_t head; /* One head per core */
 	fbe_spinlock_t   lock;	/* One lock per core */
 }fbe_multicore_queue_entry_t;
 
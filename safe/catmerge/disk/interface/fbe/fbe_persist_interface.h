@@ -58,6 +58,7 @@ typedef enum fbe_persist_control_code_e {
     FBE_PERSIST_CONTROL_CODE_HOOK, /*set/unset hook in persist service*/
     FBE_PERSIST_CONTROL_CODE_GET_ENTRY_INFO,
     FBE_PERSIST_CONTROL_CODE_VALIDATE_ENTRY,
+    FBE_PERSIST_CONTROL_CODE_GET_STATS,
     FBE_PERSIST_CONTROL_CODE_LAST
 } fbe_persist_control_code_t;
 
@@ -196,6 +197,15 @@ typedef struct fbe_persist_control_delete_single_entry_s {
 	fbe_persist_completion_context_t completion_context;
 } fbe_persist_control_delete_single_entry_t;
 
+/* FBE_PERSIST_CONTROL_CODE_GET_STATS */
+typedef struct fbe_persist_control_get_stats_s {
+    fbe_u64_t journal_commits;      /*out, journal write + commit cycles, each may hold several single entry requests*/
+    fbe_u64_t entry_write_ios;      /*out, live data region writes issued by commits and journal replay*/
+    fbe_u64_t entries_written;      /*out, entries covered by entry_write_ios*/
+    fbe_u64_t single_entry_requests;/*out, write/modify/delete single entry requests received*/
+    fbe_u64_t group_commits;        /*out, commits that merged more than one single entry request*/
+} fbe_persist_control_get_stats_t;
+
 /*FBE_PERSIST_CONTROL_CODE_GET_REQUEIRED_LUN_SIZE*/
 typedef struct fbe_persist_control_get_required_lun_size_s {
 	fbe_lba_t total_block_needed;/*out*/
@@ -280,6 +280,15 @@ typedef enum
     /* Control code to set the wear leveling timer */
     FBE_PROVISION_DRIVE_CONTROL_CODE_SET_CLASS_WEAR_LEVELING_TIMER,
 
+    /* Control code to enable or disable batching of zero on demand paged updates */
+    FBE_PROVISION_DRIVE_CONTROL_CODE_SET_CLASS_ZOD_BATCH_ENABLED,
+
+    /* Control code that gets the zero on demand paged update batching counters */
+    FBE_PROVISION_DRIVE_CONTROL_CODE_GET_ZOD_BATCH_INFO,
+
+    /* Control code to enable or disable batching of verify invalidate checkpoint peer updates */
+    FBE_PROVISION_DRIVE_CONTROL_CODE_SET_CLASS_VERIFY_INVALIDATE_BATCH_ENABLED,
+
     /* Insert new control codes here. */
     FBE_PROVISION_DRIVE_CONTROL_CODE_LAST
 }
@@ -458,6 +467,9 @@ typedef struct fbe_provision_drive_get_verify_status_s
     fbe_lba_t                       exported_capacity;  // exported capacity
     fbe_u8_t                        precentage_completed; //precentage of disk that was already 
                                                           //verified in current pass 
+    fbe_u32_t                       sniff_reschedule_ms;  // current delay between sniff verifies
+    fbe_u64_t                       sniff_busy_cycles;    // sniff cycles run at the busy delay
+    fbe_u64_t                       sniff_idle_cycles;    // sniff cycles run sooner while the host was idle
 
 } fbe_provision_drive_get_verify_status_t;
 
@@ -948,6 +960,13 @@ typedef struct fbe_provision_drive_get_paged_cache_info_s {
     fbe_u32_t           hit_count;
 }fbe_provision_drive_get_paged_cache_info_t;
 
+/* FBE_PROVISION_DRIVE_CONTROL_CODE_GET_ZOD_BATCH_INFO */
+typedef struct fbe_provision_drive_get_zod_batch_info_s {
+    fbe_bool_t          b_enabled;          /* Batching is enabled for the class. */
+    fbe_u64_t           update_count;       /* Batched paged updates issued. */
+    fbe_u64_t           batched_count;      /* Writes that joined another write's update. */
+}fbe_provision_drive_get_zod_batch_info_t;
+
 /*!**********************************************************************
  * @enum fbe_provision_drive_swap_pending_reason_e
  *  
@@ -455,6 +455,18 @@ typedef enum
      */
     FBE_RAID_GROUP_CONTROL_CODE_SET_LIFECYCLE_TIMER,
 
+    /*! Set the maximum number of rebuild I/Os in flight per raid group
+     */
+    FBE_RAID_GROUP_CONTROL_CODE_CLASS_SET_MAX_CONCURRENT_REBUILD_IOS,
+
+    /*! Set how far behind a rebuild position can be and still catch up
+     */
+    FBE_RAID_GROUP_CONTROL_CODE_CLASS_SET_REBUILD_CATCH_UP_WINDOW,
+
+    /*! Gets the read-ahead counters of the raid group
+     */
+    FBE_RAID_GROUP_CONTROL_CODE_GET_READ_AHEAD_STATS,
+
     /* Insert new control codes here.
      */
     FBE_RAID_GROUP_CONTROL_CODE_LAST
@@ -614,12 +626,14 @@ typedef enum fbe_raid_group_debug_flags_e
      *  were injected by an object below raid.
      */
     FBE_RAID_LIBRARY_DEBUG_FLAG_DISABLE_SEND_CRC_ERR_TO_PDO =   0x00800000,
-    FBE_RAID_GROUP_DEBUG_FLAG_UNUSED2                         = 0x01000000,
+    /*! Do not read ahead of sequential read streams.
+     */
+    FBE_RAID_GROUP_DEBUG_FLAG_DISABLE_READ_AHEAD              = 0x01000000,
     FBE_RAID_GROUP_DEBUG_FLAG_UNUSED3                         = 0x02000000,
     FBE_RAID_GROUP_DEBUG_FLAG_UNUSED4                         = 0x04000000,
     FBE_RAID_GROUP_DEBUG_FLAG_UNUSED5                         = 0x08000000,
     FBE_RAID_GROUP_DEBUG_FLAG_UNUSED_MASK                     = (FBE_RAID_GROUP_DEBUG_FLAG_RESERVED_IGNORE_SET |
-                                                                 FBE_RAID_GROUP_DEBUG_FLAG_UNUSED2 | FBE_RAID_GROUP_DEBUG_FLAG_UNUSED3 |
+                                                                 FBE_RAID_GROUP_DEBUG_FLAG_UNUSED3 |
                                                                  FBE_RAID_GROUP_DEBUG_FLAG_UNUSED4 | FBE_RAID_GROUP_DEBUG_FLAG_UNUSED5   ),
 
     /*! @note The following flags change behavior.  Don't set them unless
@@ -680,7 +694,7 @@ typedef enum fbe_raid_group_debug_flags_e
     "FBE_RAID_GROUP_DEBUG_FLAG_EXTENDED_MEDIA_ERROR_HANDLING",\
     "FBE_RAID_GROUP_DEBUG_FLAG_RESERVED_IGNORE_SET",\
     "FBE_RAID_GROUP_DEBUG_FLAG_UNUSED1",\
-    "FBE_RAID_GROUP_DEBUG_FLAG_UNUSED2",\
+    "FBE_RAID_GROUP_DEBUG_FLAG_DISABLE_READ_AHEAD",\
     "FBE_RAID_GROUP_DEBUG_FLAG_UNUSED3",\
     "FBE_RAID_GROUP_DEBUG_FLAG_UNUSED4",\
     "FBE_RAID_GROUP_DEBUG_FLAG_UNUSED5",\
@@ -1086,6 +1100,10 @@ typedef struct fbe_raid_group_get_info_s
 
     fbe_base_config_encryption_mode_t encryption_mode;
     fbe_base_config_encryption_state_t encryption_state;
+
+    fbe_u32_t rebuild_concurrent_request_count; /*! Rebuild requests issued as concurrent I/Os. */
+    fbe_u32_t rebuild_queue_depth; /*! Rebuild I/Os currently issued together. */
+    fbe_u32_t rebuild_op_chunks; /*! Chunks currently in each rebuild I/O. */
 }
 fbe_raid_group_get_info_t;
 #endif /* #ifndef UEFI_ENV */
@@ -2225,6 +2243,45 @@ typedef struct fbe_raid_group_class_set_chunks_per_rebuild_s
 }
 fbe_raid_group_class_set_chunks_per_rebuild_t;
 
+/*!*******************************************************************
+ * @struct fbe_raid_group_class_set_max_concurrent_rebuild_ios_t
+ *********************************************************************
+ * @brief   Maximum number of rebuild I/Os in flight per raid group
+ *
+ *********************************************************************/
+typedef struct fbe_raid_group_class_set_max_concurrent_rebuild_ios_s 
+{
+    fbe_u32_t max_concurrent_ios; /*!< 1 issues one rebuild I/O at a time. */
+}
+fbe_raid_group_class_set_max_concurrent_rebuild_ios_t;
+
+/*!*******************************************************************
+ * @struct fbe_raid_group_class_set_rebuild_catch_up_window_t
+ *********************************************************************
+ * @brief   Blocks a rebuild position can be behind another one and
+ *          still be rebuilt first to catch up to it
+ *
+ *********************************************************************/
+typedef struct fbe_raid_group_class_set_rebuild_catch_up_window_s 
+{
+    fbe_block_count_t catch_up_window_blocks; /*!< 0 disables the catch up. */
+}
+fbe_raid_group_class_set_rebuild_catch_up_window_t;
+
+/*!*******************************************************************
+ * @struct fbe_raid_group_get_read_ahead_stats_t
+ *********************************************************************
+ * @brief   This structure is used with the following control codes: 
+ *          o   FBE_RAID_GROUP_CONTROL_CODE_GET_READ_AHEAD_STATS
+ *
+ *********************************************************************/
+typedef struct fbe_raid_group_get_read_ahead_stats_s 
+{
+    fbe_u64_t hit_count;        /*!< Reads completed from a read-ahead buffer. */
+    fbe_u64_t read_ahead_count; /*!< Read-ahead reads issued. */
+}
+fbe_raid_group_get_read_ahead_stats_t;
+
 void fbe_raid_group_class_get_queue_depth(fbe_object_id_t object_id,
                                           fbe_u32_t width,
                                           fbe_u32_t *queue_depth_p);
@@ -373,6 +373,12 @@ typedef struct fbe_raid_iots_s
      */
     fbe_block_count_t host_start_offset;
 
+    /*! Number of contiguous memory runs in the host sg list, once adjacent 
+     *  elements are merged.  Counted once per request for the sg list below.
+     */
+    fbe_u32_t host_sg_fragments;
+    fbe_sg_element_t *host_sg_fragments_sg_p;
+
     fbe_u32_t journal_slot_id;
 
     /*! This flag will indicate whether the NP lock has been acquired or not.
@@ -82,6 +82,7 @@ typedef enum fbe_rdgen_control_code_e {
 	FBE_RDGEN_CONTROL_CODE_DISABLE_SYSTEM_THREADS,
 	FBE_RDGEN_CONTROL_CODE_UNLOCK,
 	FBE_RDGEN_CONTROL_CODE_SET_SVC_OPTIONS,
+    FBE_RDGEN_CONTROL_CODE_GET_LATENCY_HISTOGRAM,
 
     FBE_RDGEN_SERVICE_CONTROL_CODE_LAST
 } fbe_rdgen_control_code_t;
@@ -281,6 +282,38 @@ typedef enum fbe_rdgen_affinity_e
 }
 fbe_rdgen_affinity_t;
 
+/*!*******************************************************************
+ * @enum fbe_rdgen_arrival_mode_t
+ *********************************************************************
+ * @brief
+ *  Describes when a thread issues its next I/O.
+ *********************************************************************/
+typedef enum fbe_rdgen_arrival_mode_e
+{
+    FBE_RDGEN_ARRIVAL_MODE_CLOSED_LOOP = 0, /*!< Next I/O as soon as the last one completes. */
+    FBE_RDGEN_ARRIVAL_MODE_FIXED_RATE, /*!< I/Os arrive at fixed intervals of arrival_iops. */
+    FBE_RDGEN_ARRIVAL_MODE_POISSON, /*!< I/Os arrive with exponential gaps averaging arrival_iops. */
+    FBE_RDGEN_ARRIVAL_MODE_LAST
+}
+fbe_rdgen_arrival_mode_t;
+
+/*!*******************************************************************
+ * @enum fbe_rdgen_playback_format_t
+ *********************************************************************
+ * @brief
+ *  Format of the file named in the filter for a playback.
+ *  The text trace formats describe I/O to a single device, so the
+ *  filter's object_id and package_id select the object to replay to.
+ *********************************************************************/
+typedef enum fbe_rdgen_playback_format_e
+{
+    FBE_RDGEN_PLAYBACK_FORMAT_RDGEN = 0, /*!< rdgen root file plus one binary record file per object. */
+    FBE_RDGEN_PLAYBACK_FORMAT_BLKPARSE, /*!< Text output of blkparse, the D (issue) events are replayed. */
+    FBE_RDGEN_PLAYBACK_FORMAT_SNIA_CSV, /*!< SNIA IOTTA style csv: time,host,disk,type,offset,size[,...]. */
+    FBE_RDGEN_PLAYBACK_FORMAT_LAST
+}
+fbe_rdgen_playback_format_t;
+
 /*!*******************************************************************
  * @enum fbe_rdgen_sp_id_t
  *********************************************************************
@@ -345,6 +378,8 @@ enum fbe_rdgen_extra_options_e
          *  their own enum.  
          */
     FBE_RDGEN_EXTRA_OPTIONS_RANDOM_DELAY   = 0x00000001,   /*!< Use Random delays */
+    FBE_RDGEN_EXTRA_OPTIONS_PLAYBACK_SCALE_LBA = 0x00000002, /*!< Scale trace lbas onto the capacity instead of wrapping. */
+    FBE_RDGEN_EXTRA_OPTIONS_PLAYBACK_NO_TIMING = 0x00000004, /*!< Ignore trace time stamps, issue as fast as threads allow. */
     FBE_RDGEN_EXTRA_OPTIONS_NEXT           = 0x80000000,   /*!< Next available flag value */
 
 };
@@ -719,6 +754,20 @@ typedef struct fbe_rdgen_io_specification_s
      */
     fbe_rdgen_sp_id_t originating_sp_id;
     fbe_sg_element_t *sg_p; /*!< Caller supplied sg for read buffer.*/
+
+    /*! When not closed loop, I/Os are issued on a schedule of arrival_iops 
+     *  per object, split evenly across the threads. 
+     *  Latency is then measured from the scheduled arrival time. 
+     */
+    fbe_rdgen_arrival_mode_t arrival_mode;
+    fbe_u32_t arrival_iops; /*!< Target I/Os per second for the object. */
+
+    /*! Playback only.  Text traces are replayed at their recorded times 
+     *  stretched by playback_time_scale_percent, so 50 replays twice as fast 
+     *  and 200 half as fast.  0 is the same as 100. 
+     */
+    fbe_rdgen_playback_format_t playback_format;
+    fbe_u32_t playback_time_scale_percent;
 }
 fbe_rdgen_io_specification_t;
 
@@ -1002,6 +1051,94 @@ typedef struct fbe_rdgen_control_get_stats_s
 }
 fbe_rdgen_control_get_stats_t;
 
+/*!*******************************************************************
+ * @def FBE_RDGEN_LATENCY_HISTOGRAM_SUB_BUCKET_BITS
+ *********************************************************************
+ * @brief Number of bits of linear resolution within each power of two.
+ *        With 3 bits each power of two is split into 8 sub buckets,
+ *        so any bucket is at most 12.5% wide.
+ *
+ *********************************************************************/
+#define FBE_RDGEN_LATENCY_HISTOGRAM_SUB_BUCKET_BITS 3
+#define FBE_RDGEN_LATENCY_HISTOGRAM_SUB_BUCKETS (1 << FBE_RDGEN_LATENCY_HISTOGRAM_SUB_BUCKET_BITS)
+
+/*!*******************************************************************
+ * @def FBE_RDGEN_LATENCY_HISTOGRAM_MAX_USEC_BITS
+ *********************************************************************
+ * @brief Largest latency we track exactly is 2^32 - 1 microseconds.
+ *        Anything larger lands in the last bucket.
+ *
+ *********************************************************************/
+#define FBE_RDGEN_LATENCY_HISTOGRAM_MAX_USEC_BITS 32
+
+/*!*******************************************************************
+ * @def FBE_RDGEN_LATENCY_HISTOGRAM_BUCKETS
+ *********************************************************************
+ * @brief Values below FBE_RDGEN_LATENCY_HISTOGRAM_SUB_BUCKETS each get
+ *        their own bucket, every power of two above that gets
+ *        FBE_RDGEN_LATENCY_HISTOGRAM_SUB_BUCKETS linear buckets.
+ *
+ *********************************************************************/
+#define FBE_RDGEN_LATENCY_HISTOGRAM_BUCKETS \
+    (FBE_RDGEN_LATENCY_HISTOGRAM_SUB_BUCKETS + \
+     ((FBE_RDGEN_LATENCY_HISTOGRAM_MAX_USEC_BITS - FBE_RDGEN_LATENCY_HISTOGRAM_SUB_BUCKET_BITS) * \
+      FBE_RDGEN_LATENCY_HISTOGRAM_SUB_BUCKETS))
+
+/*!*******************************************************************
+ * @enum fbe_rdgen_latency_type_t
+ *********************************************************************
+ * @brief Kinds of requests we keep separate latency histograms for.
+ *
+ *********************************************************************/
+typedef enum fbe_rdgen_latency_type_e
+{
+    FBE_RDGEN_LATENCY_TYPE_READ = 0,
+    FBE_RDGEN_LATENCY_TYPE_WRITE,
+    FBE_RDGEN_LATENCY_TYPE_LAST,
+}
+fbe_rdgen_latency_type_t;
+
+/*!*******************************************************************
+ * @struct fbe_rdgen_latency_histogram_t
+ *********************************************************************
+ * @brief Log-linear histogram of response times in microseconds.
+ *        Each rdgen thread owns one per latency type and is the only
+ *        writer, so it is updated on completion without any locks.
+ *
+ *********************************************************************/
+typedef struct fbe_rdgen_latency_histogram_s
+{
+    fbe_u64_t total_count; /*!< Number of samples in the histogram. */
+    fbe_u64_t max_usec; /*!< Largest single sample seen. */
+    fbe_u32_t buckets[FBE_RDGEN_LATENCY_HISTOGRAM_BUCKETS]; /*!< Sample counts per bucket. */
+}
+fbe_rdgen_latency_histogram_t;
+
+/*!*******************************************************************
+ * @struct fbe_rdgen_control_get_latency_histogram_t
+ *********************************************************************
+ * @brief
+ *  Returns the merged latency histograms.
+ *  Goes with FBE_RDGEN_CONTROL_CODE_GET_LATENCY_HISTOGRAM.
+ *********************************************************************/
+typedef struct fbe_rdgen_control_get_latency_histogram_s
+{
+    /*! Input filter for which requests to merge the in process histograms for.
+     */
+    fbe_rdgen_filter_t filter;
+
+    fbe_u32_t threads; /*!< Number of threads merged into in_process. */
+
+    /*! Merged histograms of the active threads that match the filter.
+     */
+    fbe_rdgen_latency_histogram_t in_process[FBE_RDGEN_LATENCY_TYPE_LAST];
+
+    /*! Merged histograms of all threads that finished since the last reset.
+     */
+    fbe_rdgen_latency_histogram_t historical[FBE_RDGEN_LATENCY_TYPE_LAST];
+}
+fbe_rdgen_control_get_latency_histogram_t;
+
 typedef fbe_u64_t fbe_rdgen_handle_t;
 
 /*!*******************************************************************
@@ -1359,6 +1496,100 @@ static __forceinline void fbe_rdgen_specification_get_core(fbe_rdgen_io_specific
     *core_p = spec_p->core;
 }
 
+/*!**************************************************************
+ * fbe_rdgen_latency_histogram_get_bucket()
+ ****************************************************************
+ * @brief
+ *  Map a response time onto its log-linear histogram bucket.
+ *  The top bits of the value select the power of two, the next
+ *  FBE_RDGEN_LATENCY_HISTOGRAM_SUB_BUCKET_BITS bits select the
+ *  linear sub bucket within it.
+ *
+ * @param usec - Response time in microseconds.
+ *
+ * @return Bucket index.
+ *
+ ****************************************************************/
+static __forceinline fbe_u32_t fbe_rdgen_latency_histogram_get_bucket(fbe_u64_t usec)
+{
+    fbe_u32_t msb = FBE_RDGEN_LATENCY_HISTOGRAM_SUB_BUCKET_BITS;
+    fbe_u32_t shift;
+
+    if (usec < FBE_RDGEN_LATENCY_HISTOGRAM_SUB_BUCKETS)
+    {
+        return (fbe_u32_t)usec;
+    }
+    if (usec > FBE_U32_MAX)
+    {
+        return FBE_RDGEN_LATENCY_HISTOGRAM_BUCKETS - 1;
+    }
+    while ((usec >> (msb + 1)) != 0)
+    {
+        msb++;
+    }
+    shift = msb - FBE_RDGEN_LATENCY_HISTOGRAM_SUB_BUCKET_BITS;
+    return (FBE_RDGEN_LATENCY_HISTOGRAM_SUB_BUCKETS * (shift + 1)) +
+           (fbe_u32_t)((usec >> shift) - FBE_RDGEN_LATENCY_HISTOGRAM_SUB_BUCKETS);
+}
+
+/*!**************************************************************
+ * fbe_rdgen_latency_histogram_get_bucket_max_usec()
+ ****************************************************************
+ * @brief
+ *  Return the largest response time that maps onto a bucket.
+ *
+ * @param bucket - Bucket index.
+ *
+ * @return Upper bound of the bucket in microseconds.
+ *
+ ****************************************************************/
+static __forceinline fbe_u64_t fbe_rdgen_latency_histogram_get_bucket_max_usec(fbe_u32_t bucket)
+{
+    fbe_u32_t shift;
+    fbe_u64_t sub;
+
+    if (bucket < FBE_RDGEN_LATENCY_HISTOGRAM_SUB_BUCKETS)
+    {
+        return bucket;
+    }
+    shift = (bucket / FBE_RDGEN_LATENCY_HISTOGRAM_SUB_BUCKETS) - 1;
+    sub = FBE_RDGEN_LATENCY_HISTOGRAM_SUB_BUCKETS + (bucket % FBE_RDGEN_LATENCY_HISTOGRAM_SUB_BUCKETS);
+    return ((sub + 1) << shift) - 1;
+}
+
+static __forceinline void fbe_rdgen_latency_histogram_add_sample(fbe_rdgen_latency_histogram_t *histogram_p,
+                                                                 fbe_u64_t usec)
+{
+    histogram_p->buckets[fbe_rdgen_latency_histogram_get_bucket(usec)]++;
+    histogram_p->total_count++;
+    if (usec > histogram_p->max_usec)
+    {
+        histogram_p->max_usec = usec;
+    }
+    return;
+}
+
+static __forceinline void fbe_rdgen_latency_histogram_merge(fbe_rdgen_latency_histogram_t *dest_p,
+                                                            fbe_rdgen_latency_histogram_t *src_p)
+{
+    fbe_u32_t bucket;
+
+    if (src_p->total_count == 0)
+    {
+        return;
+    }
+    for (bucket = 0; bucket < FBE_RDGEN_LATENCY_HISTOGRAM_BUCKETS; bucket++)
+    {
+        dest_p->buckets[bucket] += src_p->buckets[bucket];
+    }
+    dest_p->total_count += src_p->total_count;
+    if (src_p->max_usec > dest_p->max_usec)
+    {
+        dest_p->max_usec = src_p->max_usec;
+    }
+    return;
+}
+
 fbe_status_t fbe_rdgen_peer_init(void);
 fbe_status_t fbe_rdgen_peer_destroy(void);
 
@@ -243,6 +243,29 @@ typedef enum fbe_sas_drive_type_s{
     FBE_SAS_DRIVE_LAST
 }fbe_sas_drive_type_t;
 
+/* Service time model the simulated disk applies to the media I/O of a drive type */
+typedef enum fbe_terminator_drive_latency_model_type_e{
+    FBE_TERMINATOR_DRIVE_LATENCY_MODEL_NONE,  /* complete as soon as the data is moved (default) */
+    FBE_TERMINATOR_DRIVE_LATENCY_MODEL_HDD,   /* seek + rotational latency + media transfer */
+    FBE_TERMINATOR_DRIVE_LATENCY_MODEL_FLASH, /* fixed cost per I/O + media transfer */
+}fbe_terminator_drive_latency_model_type_t;
+
+/* Most I/Os a simulated drive services concurrently */
+#define FBE_TERMINATOR_DRIVE_LATENCY_MAX_QUEUE_DEPTH 32
+
+typedef struct fbe_terminator_drive_latency_model_s{
+    fbe_terminator_drive_latency_model_type_t model_type;
+    fbe_u32_t track_to_track_seek_us; /* HDD: seek to a nearby lba */
+    fbe_u32_t full_stroke_seek_us;    /* HDD: seek across the whole capacity */
+    fbe_u32_t rpm;                    /* HDD: a non sequential access waits half a revolution */
+    fbe_u32_t read_us;                /* FLASH: fixed cost of a read */
+    fbe_u32_t write_us;               /* FLASH: fixed cost of a write */
+    fbe_u32_t per_kb_us;              /* media transfer cost for each KB */
+    fbe_u32_t queue_depth;            /* I/Os serviced concurrently, 0 is treated as 1 */
+    fbe_u32_t max_outstanding;        /* I/Os accepted before TASK SET FULL, 0 for no limit */
+    fbe_u32_t bandwidth_mb_per_sec;   /* throughput cap shared by all I/Os, 0 for no cap */
+}fbe_terminator_drive_latency_model_t;
+
 /* For sake of testing we took below FC drives
    need to update with actual FC drives */
 typedef enum fbe_fc_drive_type_s{
@@ -603,6 +626,8 @@ fbe_status_t fbe_terminator_api_drive_set_state (fbe_terminator_api_device_handl
 fbe_status_t fbe_terminator_api_drive_get_default_page_info(fbe_sas_drive_type_t drive_type, fbe_terminator_sas_drive_type_default_info_t *default_info_p);
 fbe_status_t fbe_terminator_api_drive_set_default_page_info(fbe_sas_drive_type_t drive_type, const fbe_terminator_sas_drive_type_default_info_t *default_info_p);
 fbe_status_t fbe_terminator_api_sas_drive_set_default_field(fbe_sas_drive_type_t drive_type, fbe_terminator_drive_default_field_t field, fbe_u8_t *data, fbe_u32_t size);
+fbe_status_t fbe_terminator_api_drive_get_latency_model(fbe_sas_drive_type_t drive_type, fbe_terminator_drive_latency_model_t *model_p);
+fbe_status_t fbe_terminator_api_drive_set_latency_model(fbe_sas_drive_type_t drive_type, const fbe_terminator_drive_latency_model_t *model_p);
 fbe_status_t fbe_terminator_api_set_drive_product_id(fbe_terminator_api_device_handle_t drive_handle, const fbe_u8_t * product_id);
 fbe_status_t fbe_terminator_api_get_drive_product_id(fbe_terminator_api_device_handle_t drive_handle, fbe_u8_t * product_id);
 /*Device_common api*/
@@ -151,6 +151,8 @@ typedef enum fbe_terminator_control_code_e
     FBE_TERMINATOR_CONTROL_CODE_PORT_ADDRESS,
     FBE_TERMINATOR_CONTROL_CODE_SET_LOG_PAGE_31,
     FBE_TERMINATOR_CONTROL_CODE_GET_LOG_PAGE_31,
+    FBE_TERMINATOR_CONTROL_CODE_DRIVE_GET_LATENCY_MODEL,
+    FBE_TERMINATOR_CONTROL_CODE_DRIVE_SET_LATENCY_MODEL,
     FBE_TERMINATOR_CONTROL_CODE_LAST
 } fbe_terminator_control_code_t;
 
@@ -698,6 +700,12 @@ typedef struct fbe_terminator_drive_type_default_page_info_ioctl_s
     fbe_terminator_sas_drive_type_default_info_t default_info;
 }fbe_terminator_drive_type_default_page_info_ioctl_t;
 
+typedef struct fbe_terminator_drive_latency_model_ioctl_s
+{
+    fbe_sas_drive_type_t drive_type;
+    fbe_terminator_drive_latency_model_t model;
+}fbe_terminator_drive_latency_model_ioctl_t;
+
 typedef struct fbe_terminator_drive_default_ioctl_s
 {
     fbe_sas_drive_type_t drive_type;
@@ -1,6 +1,7 @@
 #ifndef FBE_TRAFFIC_TRACE_INTERFACE_H
 #define FBE_TRAFFIC_TRACE_INTERFACE_H
 
+#include "fbe/fbe_types.h"
 #include "fbe/fbe_service.h"
 //#include "fbe/fbe_winddk.h"
 
@@ -15,6 +16,8 @@ typedef enum fbe_traffic_trace_control_code_e {
     FBE_TRAFFIC_TRACE_CONTROL_CODE_INVALID = FBE_SERVICE_CONTROL_CODE_INVALID_DEF(FBE_SERVICE_ID_TRAFFIC_TRACE),
     FBE_TRAFFIC_TRACE_CONTROL_CODE_ENABLE_RBA_TRACE, /*! Enable RBA tracing. */
     FBE_TRAFFIC_TRACE_CONTROL_CODE_DISABLE_RBA_TRACE, /*! Disable RBA tracing. */
+    FBE_TRAFFIC_TRACE_CONTROL_CODE_SET_FILTER, /*! Set or clear the RBA trace filter of a class. */
+    FBE_TRAFFIC_TRACE_CONTROL_CODE_GET_RECORDS, /*! Read the binary RBA trace records. */
     FBE_TRAFFIC_TRACE_CONTROL_CODE_LAST
 } fbe_traffic_trace_control_code_t;
 
@@ -36,6 +39,88 @@ typedef enum fbe_traffic_trace_rba_set_class_e {
     FBE_TRAFFIC_TRACE_CLASS_LAST
 } fbe_traffic_trace_rba_set_class_t;
 
+/*!************************************************************
+* @def FBE_TRAFFIC_TRACE_FILTER_OP_*
+*
+* @brief 
+*    Bits of the filter opcode mask.  A mask of 0 matches all ops.
+*
+***************************************************************/
+#define FBE_TRAFFIC_TRACE_FILTER_OP_READ    0x1
+#define FBE_TRAFFIC_TRACE_FILTER_OP_WRITE   0x2
+#define FBE_TRAFFIC_TRACE_FILTER_OP_ZERO    0x4
+#define FBE_TRAFFIC_TRACE_FILTER_OP_OTHER   0x8
+
+/*!************************************************************
+* @struct fbe_traffic_trace_filter_t
+*
+* @brief 
+*    Selects the RBA records traced for one class.  While a class has
+*    a filter it is traced even if RBA tracing is not enabled for it.
+*
+*    The target is the number the class already traces: the LUN number
+*    for LUNs, the raid group number for RG and RG FRU, and the object
+*    id for VD, PVD and PD.
+*
+***************************************************************/
+typedef struct fbe_traffic_trace_filter_s {
+    fbe_traffic_trace_rba_set_class_t trace_class;
+    fbe_bool_t b_enabled;           /*!< FBE_FALSE removes the filter of this class. */
+    fbe_bool_t b_binary;            /*!< Save binary records instead of the ktrace records. */
+    fbe_u32_t target;               /*!< FBE_U32_MAX to match any target. */
+    fbe_lba_t start_lba;            /*!< First lba to match. */
+    fbe_lba_t end_lba;              /*!< Last lba to match, FBE_LBA_INVALID for no limit. */
+    fbe_u32_t op_mask;              /*!< FBE_TRAFFIC_TRACE_FILTER_OP_*, 0 to match all. */
+    fbe_u32_t latency_threshold_us; /*!< Only trace completions at least this slow. */
+    fbe_u32_t sample_rate;          /*!< Trace one in this many I/Os, 0 or 1 for all. */
+} fbe_traffic_trace_filter_t;
+
+/*!************************************************************
+* @struct fbe_traffic_trace_record_t
+*
+* @brief 
+*    Compact binary RBA record.  A completion that had its start seen
+*    carries the latency in latency_us, otherwise latency_us is 0.
+*
+***************************************************************/
+typedef struct fbe_traffic_trace_record_s {
+    fbe_u64_t sequence;     /*!< Increases by one for every record saved. */
+    fbe_u64_t time_us;      /*!< fbe_get_time_in_us() of the trace point. */
+    fbe_lba_t lba;
+    fbe_u64_t info;         /*!< The class specific info of the ktrace record. */
+    fbe_u32_t target;
+    fbe_u32_t blocks;
+    fbe_u32_t latency_us;
+    fbe_u16_t op_code;      /*!< KT_TRAFFIC_* op with the KT_FBE_PRIORITY_* bits. */
+    fbe_u8_t  trace_class;  /*!< fbe_traffic_trace_rba_set_class_t */
+    fbe_u8_t  reserved;
+} fbe_traffic_trace_record_t;
+
+/*!************************************************************
+* @def FBE_TRAFFIC_TRACE_GET_RECORDS_MAX
+*
+* @brief 
+*    Number of records returned by one GET_RECORDS request.
+*
+***************************************************************/
+#define FBE_TRAFFIC_TRACE_GET_RECORDS_MAX 64
+
+/*!************************************************************
+* @struct fbe_traffic_trace_get_records_t
+*
+* @brief 
+*    Buffer of FBE_TRAFFIC_TRACE_CONTROL_CODE_GET_RECORDS.  The caller
+*    passes the sequence it wants next and gets back the sequence to
+*    ask for on the following call.  Pass 0 to read all the records
+*    still in the ring, FBE_U64_MAX to skip them.
+*
+***************************************************************/
+typedef struct fbe_traffic_trace_get_records_s {
+    fbe_u64_t next_sequence;    /*!< In: first sequence wanted. Out: sequence to ask next. */
+    fbe_u32_t num_records;      /*!< Out: records returned. */
+    fbe_u32_t lost_records;     /*!< Out: records overwritten before they were read. */
+    fbe_traffic_trace_record_t records[FBE_TRAFFIC_TRACE_GET_RECORDS_MAX];
+} fbe_traffic_trace_get_records_t;
 
 void  fbe_traffic_trace_enable(fbe_traffic_trace_rba_set_class_t tag);
 void  fbe_traffic_trace_disable(fbe_traffic_trace_rba_set_class_t tag);
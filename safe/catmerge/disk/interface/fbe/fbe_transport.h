@@ -665,6 +665,18 @@ fbe_status_t fbe_transport_unlock(fbe_packet_t * packet);
 fbe_status_t fbe_transport_run_queue_get_stats(void *stats);
 fbe_status_t fbe_transport_run_queue_clear_stats(void);
 
+/* How the run queue threads size their batches.
+ * FIXED uses the global batch size and watermark,
+ * ADAPTIVE derives them per core from the measured queue depth and callback cost.
+ */
+typedef enum fbe_transport_run_queue_batch_mode_e{
+    FBE_TRANSPORT_RUN_QUEUE_BATCH_MODE_FIXED,
+    FBE_TRANSPORT_RUN_QUEUE_BATCH_MODE_ADAPTIVE,
+}fbe_transport_run_queue_batch_mode_t;
+
+fbe_status_t fbe_transport_run_queue_set_batch_mode(fbe_transport_run_queue_batch_mode_t batch_mode);
+fbe_transport_run_queue_batch_mode_t fbe_transport_run_queue_get_batch_mode(void);
+
 fbe_status_t fbe_transport_record_callback_with_action(fbe_packet_t * packet,
                                                        fbe_packet_completion_function_t completion_function,
                                                        stack_tracker_action action);
@@ -697,8 +709,19 @@ typedef struct fbe_transport_run_queue_stats_s{
     fbe_u32_t transport_run_queue_current_depth;
     fbe_u32_t transport_run_queue_max_depth;
     fbe_u64_t transport_run_queue_hist_depth[FBE_TRANSPORT_RUN_QUEUE_HIST_DEPTH_SIZE];
+    fbe_u32_t transport_run_queue_batch_size;       /* batch size currently used by the core */
+    fbe_u32_t transport_run_queue_batch_watermark;  /* depth below which the core steals work */
+    fbe_u32_t transport_run_queue_callback_cost_ns; /* smoothed cost of one callback */
+    fbe_u32_t transport_run_queue_max_wait_us;      /* longest time a request waited on the queue */
+    fbe_u64_t transport_run_queue_wait_time_us;     /* total wait of the requests at the head of a batch */
+    fbe_u64_t transport_run_queue_wait_count;       /* number of wait samples */
 }fbe_transport_run_queue_stats_t;
 
+/* FBE_BVD_INTERFACE_CONTROL_CODE_SET_RUN_QUEUE_BATCH_MODE */
+typedef struct fbe_transport_run_queue_set_batch_mode_s{
+    fbe_transport_run_queue_batch_mode_t batch_mode;
+}fbe_transport_run_queue_set_batch_mode_t;
+
 static __forceinline fbe_status_t 
 fbe_transport_memory_request_set_io_master(fbe_memory_request_t * memory_request, fbe_packet_t * packet)
 {
@@ -231,6 +231,11 @@ typedef enum
      */
     FBE_VIRTUAL_DRIVE_CONTROL_CODE_CLASS_GET_PERFORMANCE_TIER,
 
+    /*! This is sent to the class to set the number of regions a copy 
+     *  request copies at the same time.
+     */
+    FBE_VIRTUAL_DRIVE_CONTROL_CODE_CLASS_SET_COPY_CONCURRENT_REGIONS,
+
     FBE_VIRTUAL_DRIVE_CONTROL_CODE_LAST
 }
 fbe_virtual_drive_control_code_t;
@@ -540,6 +545,11 @@ typedef struct fbe_virtual_drive_control_get_performance_tier_s {
     fbe_performance_tier_number_t performance_tier[FBE_DRIVE_TYPE_LAST]; /*! Output with peformance tier for each drive type */
 }fbe_virtual_drive_control_get_performance_tier_t;
 
+/*FBE_VIRTUAL_DRIVE_CONTROL_CODE_CLASS_SET_COPY_CONCURRENT_REGIONS*/
+typedef struct fbe_virtual_drive_control_class_set_copy_concurrent_regions_s {
+    fbe_u32_t   concurrent_regions; /*! Number of copy regions in flight (1 to disable concurrent copy) */
+}fbe_virtual_drive_control_class_set_copy_concurrent_regions_t;
+
 #endif /* FBE_VIRTUAL_DRIVE_H */
 
 /*******************************
@@ -60,6 +60,46 @@ public:
     mut_isolated_option();
 };
 
+class mut_parallel_option : public Int_option {
+public:
+    mut_parallel_option():Int_option("-parallel"," <n>",2, true, "execute isolated tests in n concurrent processes", true, 1) {set_dnf(true);}
+
+    int get_workers(); // mut_options.cpp
+};
+
+class mut_parallel_port_base_option : public Int_option {
+public:
+    mut_parallel_port_base_option():Int_option("-parallel_port_base"," <port>",2, true, "pass -port_base <port> + worker * stride to each parallel test process") {set_dnf(true);}
+};
+
+class mut_parallel_port_stride_option : public Int_option {
+public:
+    mut_parallel_port_stride_option():Int_option("-parallel_port_stride"," <n>",2, true, "ports reserved for each parallel worker", true, 100) {set_dnf(true);}
+};
+
+class mut_worker_option : public Int_option {
+public:
+    mut_worker_option():Int_option("-mut_worker"," <n>",2, false, "hidden cli giving the parallel worker of an isolated test process") {set_dnf(true);}
+};
+
+class mut_shard_option : public String_option {
+    int index;
+    int count;
+    bool parsed;
+
+    void parse(); // mut_options.cpp
+public:
+    mut_shard_option():String_option("-shard"," i/n",2, true, "execute only shard i (0 based) of n, selected by a hash of the test name"),
+        index(0), count(1), parsed(false) {set_dnf(true);}
+
+    bool selects(const char *suite_name, const char *test_id); // mut_options.cpp
+};
+
+class mut_slowest_option : public Int_option {
+public:
+    mut_slowest_option():Int_option("-slowest"," <n>",2, true, "number of slowest tests reported after a parallel run", true, 10) {set_dnf(true);}
+};
+
 class mut_logdir_option : public String_option{
 public:
     mut_logdir_option(); // mut_log_options.cpp
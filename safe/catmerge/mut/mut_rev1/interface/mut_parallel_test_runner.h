@@ -0,0 +1,68 @@
+/***************************************************************************
+ *                                mut_parallel_test_runner.h
+ ***************************************************************************
+ *
+ * DESCRIPTION: MUT parallel test runner definition
+ *      Executes the tests of a suite in isolated processes, several at
+ *      a time, and reports the slowest tests once the suite is done.
+ *
+ * FUNCTIONS:
+ *
+ * NOTES:
+ *
+ * HISTORY:
+ *
+ **************************************************************************/
+#ifndef __MUTPARALLELTESTRUNNER__
+#define __MUTPARALLELTESTRUNNER__
+
+#include "EmcPAL.h"
+#include "EmcPAL_DriverShell.h"
+#include "EmcPAL_Misc.h"
+#include "mut_abstract_test_runner.h"
+#include <vector>
+using namespace std;
+
+class Mut_test_control;
+class Mut_testsuite;
+class Mut_test_entry;
+
+class Mut_parallel_test_runner: public Mut_abstract_test_runner {
+public:
+    Mut_parallel_test_runner(Mut_test_control *mut_control,
+                             Mut_testsuite *current_suite);
+    ~Mut_parallel_test_runner();
+    const char *getName();
+
+    void setTestStatus(enum Mut_test_status_e status);
+    Mut_test_entry *getTest(); // returns the most recently dispatched test
+
+    void run();
+
+    UINT_32 getFailures();     // number of tests that did not pass
+
+private:
+
+    struct worker_s {
+        Mut_parallel_test_runner *runner;
+        int                       index;
+        EMCPAL_THREAD             thread;
+    };
+
+    static void workerStart(void *context);
+    void workerRun(int worker);
+
+    bool nextTest(UINT_32 *position);
+    void testFinished(UINT_32 position, unsigned long duration);
+    void reportTiming(int workers, unsigned long elapsed);
+
+    Mut_test_control        *mControl;
+    Mut_testsuite           *mSuite;
+    vector<Mut_test_entry *> mTests;      // tests in suite order
+    vector<unsigned long>    mDuration;   // msec each test took, by position in mTests
+    UINT_32                  mNext;       // position of the next test to dispatch
+    UINT_32                  mFailures;
+    bool                     mStop;       // set on the first failure, no more tests are dispatched
+    EMCPAL_MUTEX             mMutex;      // protects the fields above and serializes test reporting
+};
+#endif
@@ -22,7 +22,8 @@ class Mut_process_test_runner: public Mut_abstract_test_runner {
 public:
     Mut_process_test_runner(Mut_test_control *mut_control,
                             Mut_testsuite *current_suite,
-                            Mut_test_entry *current_test);
+                            Mut_test_entry *current_test,
+                            int worker = -1);
     const char *getName();
 
     void setTestStatus(enum Mut_test_status_e status);
@@ -34,10 +35,12 @@ private:
 
     char *constructCmdLine();
     bool optionOnExcludeList(Program_Option *option);
+    bool logTestStatus();
 
     Mut_test_control    *mControl;
     Mut_testsuite       *mSuite;
     Mut_test_entry      *mTest;
     bool                mRecursing;
+    int                 mWorker;     // parallel worker running the test, -1 when run serially
 };
 
@@ -111,6 +111,12 @@ public:
     mut_info_option info_mode;
     mut_isolate_option isolate_mode;
     mut_isolated_option isolated_mode;
+    mut_parallel_option parallel;
+    mut_parallel_port_base_option parallel_port_base;
+    mut_parallel_port_stride_option parallel_port_stride;
+    mut_worker_option worker;
+    mut_shard_option shard;
+    mut_slowest_option slowest;
     mut_run_tests_option run_tests;
     mut_run_testsuites_option run_testsuites;
     mut_timeout_option timeout;
@@ -50,7 +50,7 @@ class Mut_test_control;
 
 class Mut_test_listener: public Mut_abstract_log_listener {
 public:
-    Mut_test_listener(Mut_test_control *control);
+    Mut_test_listener(Mut_test_control *control, int worker = 0);
     virtual ~Mut_test_listener();
 
     enum Mut_test_status_e getTestStatus();
@@ -72,6 +72,8 @@ private:
     static void threadStart(EMCPAL_TIMER_CONTEXT context);
 
     Mut_test_control    *mControl;
+    char                mName[64];        // shared memory names, unique per parallel worker
+    char                mClientName[64];
     shmem_segment       *mSegment;
     shmem_service       *mService;    // Data Service & Consumer thread waits on this services lock
     shmem_service       *mClientLock; // producers wait on mClientLock
@@ -49,6 +49,7 @@ using namespace std;
 #include "mut_log.h"
 #include "mut_config_manager.h"
 #include "mut_options.h"
+#include "mut_parallel_test_runner.h"
 #include "CrashHelper.h"
 #include "simulation/ArrayDirector.h"
 #include "simulation/PersistentCMMMemory.h"
@@ -376,7 +377,9 @@ MUT_API void mut_add_class(Mut_testsuite *suite,
 
     // run_tests has a comma separated list of numbers or names or both
     // need to make sure current test is on that list 
+    // and, when -shard was given, that the test hashes into this host's shard
     if (mut_str_in_list(mut_control->run_tests.get(), test_id, Mut_test_entry::get_global_test_counter()) &&  
+          mut_control->shard.selects(suite->get_name(), test_id) &&
           (mut_control->get_start() == -1 || Mut_test_entry::get_global_test_counter() >= mut_control->get_start() && 
            Mut_test_entry::get_global_test_counter() <= mut_control->get_end()))
     {
@@ -519,6 +522,22 @@ static int mut_run_testsuite_once(Mut_testsuite *current_suite, int index)
     
 
         continue_testing = true;
+        if (mut_control->parallel.isSet() && !mut_control->isolated_mode.isSet() &&
+            current_suite->test_list->size() != 1)
+        {
+            /* 
+             * Execute the isolated tests several at a time.  A failure does
+             * not exit the program here, so return it as the suite status.
+             */
+            Mut_parallel_test_runner *parallel_runner = new Mut_parallel_test_runner(mut_control, current_suite);
+            mut_control->current_test_runner = parallel_runner;
+            parallel_runner->run();
+            exit_status = (parallel_runner->getFailures() != 0) ? 1 : 0;
+            mut_control->current_test_runner = NULL;
+            delete parallel_runner;
+
+            continue_testing = false;
+        }
         while(current_test != current_suite->test_list->get_list_end() && continue_testing)
         {
             if(mut_vetoable_progress_notification(MUT_TEST_START, current_suite, *current_test))
@@ -24,6 +24,8 @@
 
 #include "simulation/arguments.h"
 
+#include <ctype.h>
+
 class Arguments;
 
 mut_help_option::mut_help_option():Program_Option("-help","", 1, true,"this message"){
@@ -98,3 +100,71 @@ mut_isolated_option::mut_isolated_option()
 		set(*optionValue);
 	}	
 }
+
+int mut_parallel_option::get_workers()
+{
+    int workers = get();
+
+    if (workers < 1)
+    {
+        MUT_INTERNAL_ERROR(("Number of parallel workers must be 1 or larger ( %d)", workers))
+    }
+    return workers;
+}
+
+// parse 'i/n' where i is the 0 based shard this host executes out of n
+void mut_shard_option::parse()
+{
+    char *value = get();
+    char *ptr;
+
+    parsed = true;
+    if (value == NULL || *value == '\0')
+    {
+        return;
+    }
+
+    ptr = strchr(value, '/');
+    if (ptr == NULL || !isdigit(*value) || !isdigit(*(ptr + 1)))
+    {
+        MUT_INTERNAL_ERROR(("Shard must be specified as i/n ( %s)", value))
+    }
+    index = atoi(value);
+    count = atoi(ptr + 1);
+
+    if (count < 1 || index >= count)
+    {
+        MUT_INTERNAL_ERROR(("Shard index must be smaller than shard count ( %s)", value))
+    }
+}
+
+/*
+ * Tests are assigned to a shard by an FNV-1a hash of "suite.test", so the
+ * assignment is the same on every host and does not move when unrelated
+ * tests are added or removed.
+ */
+bool mut_shard_option::selects(const char *suite_name, const char *test_id)
+{
+    UINT_32 hash = 2166136261u;
+    const char *ptr;
+
+    if (!parsed)
+    {
+        parse();
+    }
+    if (count == 1)
+    {
+        return true;
+    }
+
+    for (ptr = suite_name; *ptr != '\0'; ptr++)
+    {
+        hash = (hash ^ (unsigned char)*ptr) * 16777619u;
+    }
+    hash = (hash ^ (unsigned char)'.') * 16777619u;
+    for (ptr = test_id; *ptr != '\0'; ptr++)
+    {
+        hash = (hash ^ (unsigned char)*ptr) * 16777619u;
+    }
+    return (int)(hash % (UINT_32)count) == index;
+}
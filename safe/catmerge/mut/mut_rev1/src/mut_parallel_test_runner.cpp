@@ -0,0 +1,182 @@
+/***************************************************************************
+ * Copyright (C) EMC Corporation 2015
+ * All rights reserved.
+ * Licensed material -- property of EMC Corporation
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                mut_parallel_test_runner.cpp
+ ***************************************************************************
+ *
+ * DESCRIPTION: MUT parallel test runner implementation
+ *
+ * FUNCTIONS:
+ *
+ * NOTES:
+ *      Each worker thread takes the next test of the suite and runs it
+ *      through a Mut_process_test_runner, so a test still executes alone in
+ *      its own process exactly as with -isolate.  Workers are numbered, and
+ *      the number is passed to the test process so that it uses its own
+ *      listener mailbox and, with -parallel_port_base, its own ports.
+ *
+ *      As with -isolate, the first failing test stops the run: tests that
+ *      were not dispatched yet are reported as not executed.
+ *
+ * HISTORY:
+ *
+ **************************************************************************/
+
+# include "mut_parallel_test_runner.h"
+# include "mut_process_test_runner.h"
+
+# include "mut_test_control.h"
+# include "mut_testsuite.h"
+# include "mut_test_entry.h"
+# include "mut_sdk.h"
+
+# include <algorithm>
+
+Mut_parallel_test_runner::Mut_parallel_test_runner(Mut_test_control *control,
+                                                   Mut_testsuite *suite)
+: mControl(control), mSuite(suite), mNext(0), mFailures(0), mStop(false) {
+
+    vector<Mut_test_entry *>::iterator current_test = suite->test_list->get_list_begin();
+
+    while(current_test != suite->test_list->get_list_end()) {
+        mTests.push_back(*current_test);
+        current_test++;
+    }
+    mDuration.assign(mTests.size(), 0);
+
+    EmcpalMutexCreate(EmcpalDriverGetCurrentClientObject(), &mMutex, "mutParallelMutex");
+}
+
+Mut_parallel_test_runner::~Mut_parallel_test_runner() {
+    EmcpalMutexDestroy(&mMutex);
+}
+
+const char *Mut_parallel_test_runner::getName() {
+    return mSuite->get_name();
+}
+
+Mut_test_entry *Mut_parallel_test_runner::getTest() {
+    return mTests[(mNext == 0) ? 0 : mNext - 1];
+}
+
+void Mut_parallel_test_runner::setTestStatus(enum Mut_test_status_e status) {
+    getTest()->set_status(status);
+}
+
+UINT_32 Mut_parallel_test_runner::getFailures() {
+    return mFailures;
+}
+
+bool Mut_parallel_test_runner::nextTest(UINT_32 *position) {
+    bool found = false;
+
+    EmcpalMutexLock(&mMutex);
+    if(!mStop && mNext < mTests.size()) {
+        *position = mNext++;
+        mControl->mut_log->mut_report_test_started(mSuite, mTests[*position]);
+        found = true;
+    }
+    EmcpalMutexUnlock(&mMutex);
+
+    return found;
+}
+
+void Mut_parallel_test_runner::testFinished(UINT_32 position, unsigned long duration) {
+    Mut_test_entry *test = mTests[position];
+
+    EmcpalMutexLock(&mMutex);
+    mDuration[position] = duration;
+    if(test->get_status() != MUT_TEST_PASSED) {
+        mFailures++;
+        mStop = true;
+    }
+    mControl->mut_log->mut_report_test_finished(mSuite, test, test->get_status_str());
+    EmcpalMutexUnlock(&mMutex);
+}
+
+void Mut_parallel_test_runner::workerRun(int worker) {
+    UINT_32 position;
+
+    while(nextTest(&position)) {
+        Mut_process_test_runner *runner = new Mut_process_test_runner(mControl, mSuite, mTests[position], worker);
+        unsigned long start = mut_tickcount_get();
+
+        runner->run();
+        delete runner;
+
+        testFinished(position, mut_tickcount_get() - start);
+    }
+}
+
+void Mut_parallel_test_runner::workerStart(void *context) {
+    struct worker_s *worker = (struct worker_s *)context;
+    worker->runner->workerRun(worker->index);
+}
+
+void Mut_parallel_test_runner::run() {
+    int workers = mControl->parallel.get_workers();
+    struct worker_s *worker;
+    unsigned long start = mut_tickcount_get();
+    UINT_32 position;
+    int index;
+
+    if((UINT_32)workers > mTests.size()) {
+        workers = (int)mTests.size();
+    }
+
+    mut_printf(MUT_LOG_TEST_STATUS, "Running %d tests of %s on %d parallel workers",
+               (int)mTests.size(), mSuite->get_name(), workers);
+
+    worker = new struct worker_s[workers];
+    for(index = 0; index < workers; index++) {
+        worker[index].runner = this;
+        worker[index].index = index;
+        EmcpalThreadCreate(EmcpalDriverGetCurrentClientObject(), &worker[index].thread, "mutParallelWorker",
+                           &Mut_parallel_test_runner::workerStart, (void *)&worker[index]);
+    }
+    for(index = 0; index < workers; index++) {
+        EmcpalThreadWait(&worker[index].thread);
+        EmcpalThreadDestroy(&worker[index].thread);
+    }
+    delete[] worker;
+
+    // Anything not dispatched because of a failure was not executed
+    for(position = mNext; position < mTests.size(); position++) {
+        mControl->mut_log->mut_report_test_notexecuted(mSuite, mTests[position]);
+    }
+
+    reportTiming(workers, mut_tickcount_get() - start);
+}
+
+static bool mut_parallel_slower(const pair<unsigned long, UINT_32> &a, const pair<unsigned long, UINT_32> &b) {
+    return a.first > b.first;
+}
+
+void Mut_parallel_test_runner::reportTiming(int workers, unsigned long elapsed) {
+    vector<pair<unsigned long, UINT_32> > ranking;
+    unsigned long total = 0;
+    UINT_32 position;
+    UINT_32 index;
+
+    for(position = 0; position < mNext; position++) {
+        ranking.push_back(make_pair(mDuration[position], position));
+        total += mDuration[position];
+    }
+    sort(ranking.begin(), ranking.end(), mut_parallel_slower);
+
+    mut_printf(MUT_LOG_TEST_STATUS, "%s: %u tests, %u failed, %lu.%03lu sec elapsed, %lu.%03lu sec of tests on %d workers",
+               mSuite->get_name(), mNext, mFailures,
+               elapsed / 1000, elapsed % 1000, total / 1000, total % 1000, workers);
+
+    for(index = 0; index < ranking.size() && (int)index < mControl->slowest.get(); index++) {
+        Mut_test_entry *test = mTests[ranking[index].second];
+
+        mut_printf(MUT_LOG_TEST_STATUS, "  slowest %2u: %6lu.%03lu sec (%d) %s.%s",
+                   index + 1, ranking[index].first / 1000, ranking[index].first % 1000,
+                   test->get_test_index(), mSuite->get_name(), test->get_test_id());
+    }
+}
@@ -29,8 +29,9 @@
 
 Mut_process_test_runner::Mut_process_test_runner(Mut_test_control *control,
                                                 Mut_testsuite *suite,
-                                                Mut_test_entry *test)
-: mControl(control), mSuite(suite), mTest(test), mRecursing(false) {}
+                                                Mut_test_entry *test,
+                                                int worker)
+: mControl(control), mSuite(suite), mTest(test), mRecursing(false), mWorker(worker) {}
 
 
 const char *Mut_process_test_runner::getName() {
@@ -71,16 +72,47 @@ bool Mut_process_test_runner::optionOnExcludeList(Program_Option *option) {
         && option != &mControl->mut_log->text
         && option != &mControl->mut_log->xml
 		&& option != Master_IcId_option::getCliSingleton()) {
+		// A parallel worker replaces the user's port base with its own
+		if(mWorker >= 0 && mControl->parallel_port_base.isSet()
+           && strcmp(option->get_name(), "-port_base") == 0) {
+			return true;
+		}
 		return false;
 	}
 	return true;
 }
 
+bool Mut_process_test_runner::logTestStatus() {
+    // a parallel worker leaves start/finish reporting to the parallel runner
+    return mWorker < 0;
+}
+
 char *Mut_process_test_runner::constructCmdLine() {
     Options *options =  Options::factory();
     options->registerOption(&mControl->isolated_mode);
-    options->registerOption(new MutProcess_option(mTest->get_test_index()));
+    MutProcess_option *testOption = new MutProcess_option(mTest->get_test_index());
+    options->registerOption(testOption);
     options->registerOption(Master_IcId_option::getCliSingleton());
+
+    if(mWorker >= 0) {
+        /*
+         * A parallel worker always runs exactly one test per process, and
+         * tells the process which worker it belongs to so that the test
+         * listener mailbox in shared memory is not shared with other workers.
+         * When -parallel_port_base is given, each worker also gets its own
+         * range of ports so that simulated SPs of different workers don't collide.
+         */
+        Int_option *workerOption = new Int_option("-mut_worker", "", 2, false, "", false);
+        workerOption->_set(mWorker);
+        testOption->_set(mTest->get_test_index());
+        options->registerOption(workerOption);
+
+        if(mControl->parallel_port_base.isSet()) {
+            Int_option *portOption = new Int_option("-port_base", "", 2, false, "", false);
+            portOption->_set(mControl->parallel_port_base.get() + (mWorker * mControl->parallel_port_stride.get()));
+            options->registerOption(portOption);
+        }
+    }
 	
     
     /* 
@@ -126,7 +158,7 @@ void Mut_process_test_runner::setTestStatus(enum Mut_test_status_e status) {
     mRecursing = true;
 
     mTest->set_status(status);
-    if(mTest->statusFailed()) {
+    if(mTest->statusFailed() && mWorker < 0) {
         mut_process_test_failure();
     }
     
@@ -135,13 +167,15 @@ void Mut_process_test_runner::setTestStatus(enum Mut_test_status_e status) {
 
 void Mut_process_test_runner::run() {
 
-    Mut_test_listener *listener = new Mut_test_listener(mControl);
+    Mut_test_listener *listener = new Mut_test_listener(mControl, (mWorker < 0) ? 0 : mWorker);
     listener->start();
 
 	// Default to 'unknown' test status
     setTestStatus(MUT_TEST_RESULT_UKNOWN);
 
-    mControl->mut_log->mut_report_test_started(mSuite, mTest);
+    if(logTestStatus()) {
+        mControl->mut_log->mut_report_test_started(mSuite, mTest);
+    }
 
     SpId_option* spidOpt = (SpId_option*) Options::get_option("-SP");
     if(spidOpt) {
@@ -213,6 +247,8 @@ void Mut_process_test_runner::run() {
     /*
      * report status for this test
      */
-    mControl->mut_log->mut_report_test_finished(mSuite, mTest, mTest->get_status_str());
+    if(logTestStatus()) {
+        mControl->mut_log->mut_report_test_finished(mSuite, mTest, mTest->get_status_str());
+    }
 
 }
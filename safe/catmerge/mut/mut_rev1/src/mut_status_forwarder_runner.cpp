@@ -30,7 +30,7 @@ Mut_status_forwarder_runner::Mut_status_forwarder_runner(Mut_test_control *mut_c
                                 Mut_testsuite *current_suite,
                                 Mut_test_entry *current_test)
 : Mut_thread_test_runner(mut_control, current_suite, current_test), 
-  mTestListener(new Mut_test_listener(mut_control)), mControl(mut_control), mTest(current_test) {
+  mTestListener(new Mut_test_listener(mut_control, mut_control->worker.get())), mControl(mut_control), mTest(current_test) {
     mControl->mut_log->registerListener(mTestListener);
 }
 Mut_status_forwarder_runner::~Mut_status_forwarder_runner() {
@@ -27,11 +27,25 @@ extern void mut_strip_terminators(char* buf);
 static char *mtl_name = "Mut_test_listener";
 static char *mtl_client_name = "Mut_test_client_lock";
 
-Mut_test_listener::Mut_test_listener(Mut_test_control *control)
+/*
+ * Parallel workers each talk to their own isolated test process, so
+ * every worker other than 0 gets its own mailbox in shared memory.
+ */
+static char *mtl_worker_name(char *buffer, const char *name, int worker) {
+    if(worker == 0) {
+        strcpy(buffer, name);
+    }
+    else {
+        sprintf(buffer, "%s_%d", name, worker);
+    }
+    return buffer;
+}
+
+Mut_test_listener::Mut_test_listener(Mut_test_control *control, int worker)
 : mControl(control), mListenerRunning(FALSE),
-  mSegment(new shmem_segment(mtl_name, sizeof(mtl_data_t))),
-  mService(new shmem_service(mSegment, mtl_name, sizeof(mtl_data_t))),
-  mClientLock(new shmem_service(mSegment, mtl_client_name)),
+  mSegment(new shmem_segment(mtl_worker_name(mName, mtl_name, worker), sizeof(mtl_data_t))),
+  mService(new shmem_service(mSegment, mName, sizeof(mtl_data_t))),
+  mClientLock(new shmem_service(mSegment, mtl_worker_name(mClientName, mtl_client_name, worker))),
   mTestData((mtl_data_t *)mService->get_base()) {
 
   csx_p_memzero(&mTestThread_handle, sizeof(mTestThread_handle));